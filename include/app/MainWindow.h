@@ -126,6 +126,8 @@ private slots:
   void stopBroadcastReceiver();
 
   void onConnectionSettingsRequested();
+  void showLatencyDiagnostics();
+  void dumpLatencyHistograms();
 
   void onPriceSubscriptionRequest(QString requesterId, uint32_t token,
                                   uint16_t segment);
@@ -185,6 +187,9 @@ private:
 
   // Config Loader
   class ConfigLoader *m_configLoader;
+
+  // Periodic latency histogram dump ([UDP] latency_dump_dir)
+  QTimer *m_latencyDumpTimer;
 };
 
 #endif // MAINWINDOW_H
\ No newline at end of file
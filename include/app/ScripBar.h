@@ -114,9 +114,6 @@ private:
   QString getCurrentExchange() const;
   QString getCurrentSegment() const;
 
-  void searchInstrumentsAsync(const QString &searchText);
-  void onInstrumentsReceived(const QVector<InstrumentData> &instruments);
-
   // ⚡ DisplayMode helper: Display single contract via O(1) lookup, no cache rebuild
   void displaySingleContract(const InstrumentData &data);
 
@@ -25,32 +25,88 @@ public:
     static PriceStoreGateway& instance();
 
     /**
-     * @brief Get pointer to the live state of a token in a specific segment.
-     * 
+     * @brief Get thread-safe snapshot copy of token state
      * @param segment Semantic segment (1=NSECM, 2=NSEFO, 11=BSECM, 12=BSEFO)
      * @param token Exchange instrument token
-     * @return const UnifiedState* Pointer to live record, or nullptr if not found.
-     *         REMARK: This pointer is managed by the respective PriceStore.
-     * @deprecated Use getUnifiedSnapshot() for thread-safe access
+     * @return Consistent copy of token state. Lock-free: the stores use a
+     *         per-row seqlock, so this never blocks the UDP writer threads.
+     * @note Returns empty state (token=0) if not found
      */
-    const UnifiedState* getUnifiedState(int segment, uint32_t token) const;
+    [[nodiscard]] UnifiedState getUnifiedSnapshot(int segment, uint32_t token) const;
 
     /**
-     * @brief Get thread-safe snapshot copy of token state
+     * @brief Partial snapshots: copy only the block the caller needs.
+     *
+     * Prefer these on per-tick paths; getUnifiedSnapshot() copies every block
+     * (~590 bytes) while getTouchline() copies ~140.
+     *
      * @param segment Semantic segment (1=NSECM, 2=NSEFO, 11=BSECM, 12=BSEFO)
      * @param token Exchange instrument token
-     * @return Copy of token state, guaranteed consistent under lock
-     * @note Returns empty state (token=0) if not found
+     * @note Return an empty block (token=0 / greeksCalculated=false) if not
+     *       found. NSE CM has no Greeks.
      */
-    [[nodiscard]] UnifiedState getUnifiedSnapshot(int segment, uint32_t token) const;
+    [[nodiscard]] TouchlineState getTouchline(int segment, uint32_t token) const;
+    [[nodiscard]] DepthState getDepth(int segment, uint32_t token) const;
+    [[nodiscard]] GreeksState getGreeks(int segment, uint32_t token) const;
+
+    /**
+     * @brief Update versions, for consumers that sweep a token list.
+     *
+     * Every row counts its own feed writes (Greeks writes are not counted),
+     * and each changedSince() call advances the segment's epoch that writes
+     * stamp on their row. getRowVersion() answers "did this row move since I
+     * last looked" (compare for equality) with one atomic load and no copy;
+     * changedSince() does it for a whole token list and copies only the
+     * requested block of the rows that moved:
+     *
+     * ```cpp
+     * std::vector<MarketData::TouchlineChange> changed;
+     * m_seen = gateway.changedSince(2, m_seen, tokens, changed);
+     * for (const auto& c : changed) apply(c.token, c.block.ltp);
+     * ```
+     *
+     * @param segment Semantic segment (1=NSECM, 2=NSEFO, 11=BSECM, 12=BSEFO)
+     * @param sinceVersion Watermark from the previous call (0 = every row
+     *        ever written, including master initialisation)
+     * @param out Appended to: one entry per changed token, in the order of tokens
+     * @return Watermark for the next call; 0 for an unknown segment.
+     *         A write racing the call may be reported again next time.
+     * @note Versions are per segment: keep one watermark per segment.
+     */
+    [[nodiscard]] uint64_t getVersion(int segment) const;
+    [[nodiscard]] uint64_t getRowVersion(int segment, uint32_t token) const;
+    uint64_t changedSince(int segment, uint64_t sinceVersion,
+                          const std::vector<uint32_t>& tokens,
+                          std::vector<TouchlineChange>& out) const;
+    uint64_t changedSince(int segment, uint64_t sinceVersion,
+                          const std::vector<uint32_t>& tokens,
+                          std::vector<DepthChange>& out) const;
+    uint64_t changedSince(int segment, uint64_t sinceVersion,
+                          const std::vector<uint32_t>& tokens,
+                          std::vector<GreeksChange>& out) const;
 
     /**
      * @brief Enable/Disable notifications for a token.
      * This affects whether the UDP parsers will emit Qt signals for this token.
-     * Note: Data is ALWAYS updated in the background store regardless of this flag.
+     * Note: Data is updated in the background store regardless of this flag,
+     * unless the interest filter is on (see setInterestFilter()).
+     * @param segment Semantic segment (1=NSECM, 2=NSEFO, 11=BSECM, 12=BSEFO);
+     *        other segments are ignored
      */
     void setTokenEnabled(int segment, uint32_t token, bool enabled);
 
+    /**
+     * @brief Let the parsers drop records for tokens nobody has enabled.
+     *
+     * With @p filterRecords the NSE FO (7200/7202/7208/17202) and NSE CM
+     * (7200/7208/18703) parsers check the enabled-token bitmap per record and
+     * skip the store write and callback for the rest. @p fullMarketStore
+     * keeps the store write for every token (for readers of unsubscribed
+     * rows, e.g. ATM / option chain) and only skips the callback.
+     * A token enabled later fills in on its next full update.
+     */
+    void setInterestFilter(bool filterRecords, bool fullMarketStore);
+
     /**
      * @brief Check if a token is enabled for notifications.
      */
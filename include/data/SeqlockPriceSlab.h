@@ -0,0 +1,587 @@
+#ifndef SEQLOCK_PRICE_SLAB_H
+#define SEQLOCK_PRICE_SLAB_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include "data/UnifiedPriceState.h"
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace MarketData {
+
+/**
+ * @brief Chunked, cache-line aligned row storage with a per-row seqlock.
+ *
+ * Backing store for nsefo / nsecm / bse PriceStore.
+ *
+ * Architecture:
+ * - Slab: rows are assigned in master load order; each UnifiedState block
+ *   (touchline, depth, greeks, contract info) lives in its own parallel
+ *   array, so a partial read copies only that block
+ * - Hot rows: the row sequence shares 64-byte aligned storage with the
+ *   touchline block, so an LTP read touches no other array
+ * - Greeks rows: the Greeks block has its own sequence, so the Greeks
+ *   service never takes the feed's row and a Greeks write never makes a
+ *   touchline / depth reader retry
+ * - Index: flat token -> slot array, O(1) lookup
+ * - Writers: update() takes no lock. A writer owns a row by moving its
+ *   sequence from even to odd with a CAS, so the feed thread (or the shard
+ *   worker that owns the token) writes wait-free; only structural writes
+ *   (master initialisation, erase, clear) ever wait on a feed row.
+ *   updateGreeks() does the same on the Greeks row. writeMutex_ only
+ *   serialises structural changes: row creation, growth, erase and clear
+ * - Readers: lock-free snapshot copy; a read that overlaps a write on the
+ *   same row sees an odd / changed sequence and retries
+ * - Versions: each row counts its own writes (rowVersion, Greeks excluded,
+ *   so a Greeks result can be keyed on the prices it came from). changedSince()
+ *   pollers advance a slab-wide epoch that writers only read and stamp on
+ *   the row, so the write path never contends on a shared counter
+ *
+ * Rows live in fixed-size chunks that never move, so growth never copies a
+ * row and a lock-free writer can never write into storage that growth has
+ * just retired. Growth (reserve / new tokens beyond capacity) adds chunks
+ * and publishes a new table (chunk directory + index); the old directory /
+ * index is retired until destruction, so a reader that loaded the old table
+ * pointer never touches freed memory. Readers are not registered anywhere,
+ * so the slab has no point at which a retired table is known to be unused;
+ * instead directory and index growth is at least geometric, which bounds
+ * the retired storage below the live table's (retiredBytes() <= liveBytes()).
+ * A store that reserves its full size before the feed starts never retires
+ * anything.
+ */
+class SeqlockPriceSlab {
+public:
+    struct alignas(64) HotRow {
+        std::atomic<uint32_t> seq{0};   // Odd while a write is in progress; 2 per write
+        std::atomic<uint64_t> stamp{0}; // Epoch of the last write (see changedSince)
+        TouchlineState tick;
+    };
+
+    struct alignas(64) GreeksRow {
+        std::atomic<uint32_t> seq{0};   // As HotRow, for the Greeks block only
+        std::atomic<uint64_t> stamp{0};
+        GreeksState greeks;
+    };
+
+    /**
+     * @brief Writable view of one row, passed to update() / initialize().
+     * Greeks are written through updateGreeks().
+     */
+    struct RowRef {
+        TouchlineState& tick;
+        DepthState& depth;
+        ContractInfo& info;
+    };
+
+    /**
+     * @param minToken Lowest token stored (index offset)
+     * @param indexSize Initial number of token slots in the index
+     */
+    explicit SeqlockPriceSlab(uint32_t minToken = 0, size_t indexSize = 0)
+        : minToken_(minToken) {
+        Table* table = newTable();
+        if (indexSize) allocateIndex(table, indexSize, nullptr);
+        table_.store(table, std::memory_order_release);
+    }
+
+    // Rows per chunk (growth step)
+    static constexpr size_t kChunkShift = 10;
+    static constexpr size_t kChunkRows = size_t(1) << kChunkShift;
+
+    // Storage of one row across the block arrays
+    static constexpr size_t kRowBytes = sizeof(HotRow) + sizeof(DepthState) +
+                                        sizeof(GreeksRow) + sizeof(ContractInfo);
+
+    SeqlockPriceSlab(const SeqlockPriceSlab&) = delete;
+    SeqlockPriceSlab& operator=(const SeqlockPriceSlab&) = delete;
+
+    // =========================================================
+    // READ (lock-free)
+    // =========================================================
+
+    /**
+     * @brief Copy all blocks for token into out: a consistent snapshot of
+     *        the feed blocks, then a consistent snapshot of the Greeks block.
+     * @return false if the token has no row
+     */
+    bool read(uint32_t token, UnifiedState& out) const {
+        return readSlot(token, [this, &out](const Chunk& c, size_t i) {
+            readRow(c.hot[i].seq, [&] {
+                static_cast<TouchlineState&>(out) = c.hot[i].tick;
+                static_cast<DepthState&>(out) = c.depth[i];
+                static_cast<ContractInfo&>(out) = c.info[i];
+            });
+            readRow(c.greeks[i].seq, [&] { static_cast<GreeksState&>(out) = c.greeks[i].greeks; });
+        });
+    }
+
+    bool readTouchline(uint32_t token, TouchlineState& out) const {
+        return readBlock(token, out);
+    }
+
+    bool readDepth(uint32_t token, DepthState& out) const {
+        return readBlock(token, out);
+    }
+
+    bool readGreeks(uint32_t token, GreeksState& out) const {
+        return readBlock(token, out);
+    }
+
+    bool readContract(uint32_t token, ContractInfo& out) const {
+        return readBlock(token, out);
+    }
+
+    bool contains(uint32_t token) const {
+        return findSlot(table_.load(std::memory_order_acquire), token) != kNoSlot;
+    }
+
+    // =========================================================
+    // VERSIONS (lock-free)
+    // =========================================================
+
+    /**
+     * @brief Current epoch: the watermark a changedSince() call starting now
+     *        would return. Moved by pollers only, never by writes.
+     */
+    uint64_t version() const { return epoch_.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Number of writes completed on token's row; 0 if it has no row.
+     * Changes on every write, so two equal values mean the row did not move.
+     * updateGreeks() writes are not counted.
+     */
+    uint64_t rowVersion(uint32_t token) const {
+        const Table* table = table_.load(std::memory_order_acquire);
+        size_t slot = findSlot(table, token);
+        if (slot == kNoSlot) return 0;
+        const HotRow& hot = chunkOf(table, slot).hot[slot & kChunkMask];
+        return hot.seq.load(std::memory_order_acquire) >> 1;
+    }
+
+    /**
+     * @brief Append one Block (TouchlineState / DepthState / GreeksState /
+     *        ContractInfo) for each of tokens whose row changed after since.
+     *
+     * Each call advances the epoch and returns its previous value; writes
+     * stamp their row with the epoch current when they start. Unchanged rows
+     * cost one atomic load and are not copied. Pass the returned watermark as
+     * since on the next call: no write is missed, and a write racing this call
+     * may be reported twice. Several pollers may share the slab.
+     *
+     * @return Watermark for the next call
+     */
+    template <typename Block>
+    uint64_t changedSince(uint64_t since, const uint32_t* tokens, size_t count,
+                          std::vector<VersionedBlock<Block>>& out) const {
+        // seq_cst pairs with the writers' epoch load: a write that read the
+        // epoch before this increment is seen below as stamped or in progress
+        const uint64_t watermark = epoch_.fetch_add(1, std::memory_order_seq_cst);
+        const Table* table = table_.load(std::memory_order_acquire);
+        for (size_t n = 0; n < count; ++n) {
+            size_t slot = findSlot(table, tokens[n]);
+            if (slot == kNoSlot) continue;
+            const Chunk& chunk = chunkOf(table, slot);
+            const size_t i = slot & kChunkMask;
+            const auto& row = rowOf<Block>(chunk, i);
+            const bool writing = row.seq.load(std::memory_order_seq_cst) & 1u;
+            if (!writing && row.stamp.load(std::memory_order_acquire) <= since) continue;
+
+            VersionedBlock<Block> change;
+            change.token = tokens[n];
+            uint64_t stamp = 0;
+            readRow(row.seq, [&] {
+                stamp = row.stamp.load(std::memory_order_relaxed);
+                change.version = row.seq.load(std::memory_order_relaxed) >> 1;
+                change.block = blockAt<Block>(chunk, i);
+            });
+            // A write that was in progress but started before since was
+            // already reported by the previous call
+            if (stamp > since) out.push_back(change);
+        }
+        return watermark;
+    }
+
+    // =========================================================
+    // WRITE
+    // =========================================================
+
+    /**
+     * @brief Apply fn(RowRef) to an existing row under its seqlock.
+     * Lock-free: takes no mutex, only the row's own sequence.
+     * @return false if the token has no row (update dropped)
+     */
+    template <typename Fn>
+    bool update(uint32_t token, Fn&& fn) {
+        return writeMapped<TouchlineState>(token, [&fn](Chunk& c, size_t i) {
+            fn(RowRef{c.hot[i].tick, c.depth[i], c.info[i]});
+        });
+    }
+
+    /**
+     * @brief Apply fn(GreeksState&) to token's Greeks block under its own
+     *        seqlock. Lock-free, and never waits on the feed's row.
+     * @return false if the token has no row (update dropped)
+     */
+    template <typename Fn>
+    bool updateGreeks(uint32_t token, Fn&& fn) {
+        return writeMapped<GreeksState>(token, [&fn](Chunk& c, size_t i) {
+            fn(c.greeks[i].greeks);
+        });
+    }
+
+    /**
+     * @brief Create the row for token if needed, then apply fn under its seqlock.
+     * Grows the index when token lies beyond it.
+     */
+    template <typename Fn>
+    void initialize(uint32_t token, Fn&& fn) {
+        if (token < minToken_) return;
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        size_t slot = findOrCreateSlot(token);
+        writeRow(table_.load(std::memory_order_relaxed), slot, fn);
+    }
+
+    /**
+     * @brief Remove token's row: reset it and drop it from the index.
+     * The slot is not reused until clear(), so a reader that already
+     * resolved it sees an empty row, never another token's data.
+     * @return false if the token has no row
+     */
+    bool erase(uint32_t token) {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        Table* table = table_.load(std::memory_order_relaxed);
+        size_t slot = findSlot(table, token);
+        if (slot == kNoSlot) return false;
+        table->index[token - minToken_].store(0, std::memory_order_seq_cst);
+        resetSlot(table, slot);
+        return true;
+    }
+
+    /**
+     * @brief Ensure the slab can hold rows without regrowing.
+     */
+    void reserve(size_t rows) {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        Table* table = table_.load(std::memory_order_relaxed);
+        if (rows > table->capacity) grow(rows, table->indexSize);
+    }
+
+    /**
+     * @brief Ensure the index covers tokens up to maxToken (inclusive).
+     */
+    void reserveTokens(uint32_t maxToken) {
+        if (maxToken < minToken_) return;
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        Table* table = table_.load(std::memory_order_relaxed);
+        size_t needed = static_cast<size_t>(maxToken - minToken_) + 1;
+        if (needed > table->indexSize) grow(table->capacity, needed);
+    }
+
+    /**
+     * @brief Drop all rows. Storage is kept for the next load.
+     */
+    void clear() {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        Table* table = table_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < table->indexSize; ++i) {
+            table->index[i].store(0, std::memory_order_relaxed);
+        }
+        // Unmapped before any row is reset (see update())
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const size_t count = count_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < count; ++i) {
+            resetSlot(table, i);
+        }
+        count_.store(0, std::memory_order_release);
+    }
+
+    size_t size() const { return count_.load(std::memory_order_acquire); }
+    size_t capacity() const { return table_.load(std::memory_order_acquire)->capacity; }
+    size_t indexSize() const { return table_.load(std::memory_order_acquire)->indexSize; }
+    uint32_t minToken() const { return minToken_; }
+
+    // Row + index storage of the current table
+    size_t liveBytes() const {
+        const Table* table = table_.load(std::memory_order_acquire);
+        return table->capacity * kRowBytes + table->indexSize * sizeof(std::atomic<uint32_t>);
+    }
+
+    // Storage held by retired directories / indexes (freed on destruction)
+    size_t retiredBytes() const { return retiredBytes_.load(std::memory_order_relaxed); }
+
+    // Reads that had to retry because they overlapped a write (diagnostics)
+    uint64_t readRetries() const { return readRetries_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t kNoSlot = static_cast<size_t>(-1);
+    static constexpr size_t kChunkMask = kChunkRows - 1;
+
+    // kChunkRows rows; allocated once and never moved or freed before destruction
+    struct Chunk {
+        HotRow hot[kChunkRows];
+        DepthState depth[kChunkRows];
+        GreeksRow greeks[kChunkRows];
+        ContractInfo info[kChunkRows];
+    };
+
+    struct Table {
+        Chunk** chunks = nullptr;               // Directory: capacity / kChunkRows entries
+        size_t capacity = 0;
+        std::atomic<uint32_t>* index = nullptr; // token - minToken -> slot + 1 (0 = none)
+        size_t indexSize = 0;
+    };
+
+    static void cpuRelax() {
+#if defined(_MSC_VER)
+        _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+
+    static Chunk& chunkOf(const Table* table, size_t slot) {
+        return *table->chunks[slot >> kChunkShift];
+    }
+
+    // Sequenced row (HotRow / GreeksRow) that guards Block
+    template <typename Block, typename C>
+    static auto& rowOf(C& chunk, size_t i) {
+        if constexpr (std::is_same_v<Block, GreeksState>) return chunk.greeks[i];
+        else return chunk.hot[i];
+    }
+
+    template <typename Block>
+    static const Block& blockAt(const Chunk& chunk, size_t i) {
+        if constexpr (std::is_same_v<Block, TouchlineState>) return chunk.hot[i].tick;
+        else if constexpr (std::is_same_v<Block, DepthState>) return chunk.depth[i];
+        else if constexpr (std::is_same_v<Block, GreeksState>) return chunk.greeks[i].greeks;
+        else {
+            static_assert(std::is_same_v<Block, ContractInfo>, "not a row block");
+            return chunk.info[i];
+        }
+    }
+
+    template <typename Fn>
+    bool readSlot(uint32_t token, Fn&& fn) const {
+        const Table* table = table_.load(std::memory_order_acquire);
+        size_t slot = findSlot(table, token);
+        if (slot == kNoSlot) return false;
+        fn(chunkOf(table, slot), slot & kChunkMask);
+        return true;
+    }
+
+    template <typename Block>
+    bool readBlock(uint32_t token, Block& out) const {
+        return readSlot(token, [this, &out](const Chunk& c, size_t i) {
+            readRow(rowOf<Block>(c, i).seq, [&] { out = blockAt<Block>(c, i); });
+        });
+    }
+
+    template <typename Copy>
+    void readRow(const std::atomic<uint32_t>& seq, Copy&& copy) const {
+        for (;;) {
+            uint32_t before = seq.load(std::memory_order_acquire);
+            if (before & 1u) {
+                cpuRelax();
+                continue;
+            }
+            copy();
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq.load(std::memory_order_relaxed) == before) return;
+            readRetries_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Take a row (HotRow / GreeksRow): even -> odd. Uncontended for the
+    // row's own writer; structural writers wait for an in-progress write.
+    template <typename Row>
+    static uint32_t acquireRow(Row& row) {
+        uint32_t seq = row.seq.load(std::memory_order_relaxed);
+        for (;;) {
+            if (!(seq & 1u) &&
+                row.seq.compare_exchange_weak(seq, seq + 1, std::memory_order_seq_cst,
+                                              std::memory_order_relaxed)) {
+                std::atomic_thread_fence(std::memory_order_release);
+                return seq;
+            }
+            cpuRelax();
+            seq = row.seq.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Row already taken by acquireRow(), which returned seq
+    template <typename Row, typename Fn>
+    void publishRow(Row& row, uint32_t seq, Fn&& write) {
+        // Read after the row was taken (seq_cst): see changedSince()
+        const uint64_t stamp = epoch_.load(std::memory_order_seq_cst);
+        write();
+        row.stamp.store(stamp, std::memory_order_relaxed);
+        row.seq.store(seq + 2, std::memory_order_release);
+    }
+
+    // Lock-free write to a mapped token's row guarding Block; fn(Chunk&, i)
+    // writes the blocks
+    template <typename Block, typename Fn>
+    bool writeMapped(uint32_t token, Fn&& fn) {
+        const Table* table = table_.load(std::memory_order_acquire);
+        size_t slot = findSlot(table, token);
+        if (slot == kNoSlot) return false;
+
+        Chunk& chunk = chunkOf(table, slot);
+        const size_t i = slot & kChunkMask;
+        auto& row = rowOf<Block>(chunk, i);
+        const uint32_t seq = acquireRow(row);
+        // erase() / clear() unmap the token before resetting its row; once
+        // the row is ours, a still-mapped slot cannot be reset under us
+        if (findSlot(table_.load(std::memory_order_seq_cst), token) != slot) {
+            row.seq.store(seq, std::memory_order_release);   // Nothing written
+            return false;
+        }
+        publishRow(row, seq, [&] { fn(chunk, i); });
+        return true;
+    }
+
+    // Caller holds writeMutex_
+    template <typename Fn>
+    void writeRow(const Table* table, size_t slot, Fn&& fn) {
+        Chunk& chunk = chunkOf(table, slot);
+        const size_t i = slot & kChunkMask;
+        HotRow& hot = chunk.hot[i];
+        publishRow(hot, acquireRow(hot), [&] {
+            fn(RowRef{hot.tick, chunk.depth[i], chunk.info[i]});
+        });
+    }
+
+    // Caller holds writeMutex_
+    void resetSlot(const Table* table, size_t slot) {
+        writeRow(table, slot, [](RowRef row) {
+            row.tick = TouchlineState{};
+            row.depth = DepthState{};
+            row.info = ContractInfo{};
+        });
+        GreeksRow& greeks = chunkOf(table, slot).greeks[slot & kChunkMask];
+        publishRow(greeks, acquireRow(greeks), [&greeks] { greeks.greeks = GreeksState{}; });
+    }
+
+    size_t findSlot(const Table* table, uint32_t token) const {
+        if (token < minToken_) return kNoSlot;
+        size_t idx = token - minToken_;
+        if (idx >= table->indexSize) return kNoSlot;
+        uint32_t slot = table->index[idx].load(std::memory_order_acquire);
+        // A retired table can share its index with a larger successor
+        return (slot && slot <= table->capacity) ? slot - 1 : kNoSlot;
+    }
+
+    size_t findOrCreateSlot(uint32_t token) {
+        Table* table = table_.load(std::memory_order_relaxed);
+        size_t idx = token - minToken_;
+        if (idx >= table->indexSize) {
+            // Headroom on top of grow()'s doubling for sparse token ranges
+            size_t indexSize = std::max(idx + 1 + kIndexHeadroom, table->indexSize * 2);
+            table = grow(table->capacity, indexSize);
+        }
+        uint32_t slot = table->index[idx].load(std::memory_order_relaxed);
+        if (slot) return slot - 1;
+
+        size_t created = count_.load(std::memory_order_relaxed);
+        if (created == table->capacity) {
+            table = grow(table->capacity + kChunkRows, table->indexSize);
+        }
+        resetSlot(table, created);
+        count_.store(created + 1, std::memory_order_release);
+        table->index[idx].store(static_cast<uint32_t>(created + 1), std::memory_order_release);
+        return created;
+    }
+
+    Table* newTable() {
+        tables_.push_back(std::make_unique<Table>());
+        return tables_.back().get();
+    }
+
+    // New chunks go into free directory entries, invisible to older tables
+    // (their capacity stops short of them); a full directory is doubled
+    void addChunks(Table* table, size_t capacity) {
+        const size_t oldChunks = table->capacity / kChunkRows;
+        const size_t chunks = (capacity + kChunkRows - 1) / kChunkRows;
+        if (chunks > directorySize_) {
+            const size_t size = std::max(chunks, directorySize_ * 2);
+            directories_.emplace_back(new Chunk*[size]());
+            Chunk** directory = directories_.back().get();
+            std::copy(table->chunks, table->chunks + oldChunks, directory);
+            retiredBytes_.fetch_add(directorySize_ * sizeof(Chunk*), std::memory_order_relaxed);
+            directorySize_ = size;
+            table->chunks = directory;
+        }
+        for (size_t c = oldChunks; c < chunks; ++c) {
+            chunks_.push_back(std::make_unique<Chunk>());
+            table->chunks[c] = chunks_.back().get();
+        }
+        table->capacity = chunks * kChunkRows;
+    }
+
+    void allocateIndex(Table* table, size_t indexSize, const Table* old) {
+        indexBlocks_.emplace_back(new std::atomic<uint32_t>[indexSize]);
+        table->index = indexBlocks_.back().get();
+        table->indexSize = indexSize;
+        const size_t oldSize = old ? old->indexSize : 0;
+        for (size_t i = 0; i < indexSize; ++i) {
+            uint32_t slot = i < oldSize ? old->index[i].load(std::memory_order_relaxed) : 0;
+            table->index[i].store(slot, std::memory_order_relaxed);
+        }
+    }
+
+    // Caller holds writeMutex_. Rows stay where they are; only the
+    // directory / index may be copied
+    Table* grow(size_t capacity, size_t indexSize) {
+        Table* old = table_.load(std::memory_order_relaxed);
+        if (capacity <= old->capacity && indexSize <= old->indexSize) return old;
+
+        Table* table = newTable();
+        table->chunks = old->chunks;
+        table->capacity = old->capacity;
+        table->index = old->index;
+        table->indexSize = old->indexSize;
+        if (capacity > old->capacity) addChunks(table, capacity);
+
+        // At least double the index: keeps retired storage below the live
+        // table's (see class doc)
+        if (indexSize > old->indexSize) {
+            allocateIndex(table, std::max(indexSize, old->indexSize * 2), old);
+            retiredBytes_.fetch_add(old->indexSize * sizeof(std::atomic<uint32_t>),
+                                    std::memory_order_relaxed);
+        }
+        table_.store(table, std::memory_order_release);
+        return table;
+    }
+
+    static constexpr size_t kIndexHeadroom = 10000;
+
+    const uint32_t minToken_;
+    std::atomic<Table*> table_{nullptr};
+    std::atomic<size_t> count_{0};               // Rows in use: [0, count)
+    std::mutex writeMutex_;                      // Structural changes only
+    alignas(64) mutable std::atomic<uint64_t> epoch_{1};
+    alignas(64) mutable std::atomic<uint64_t> readRetries_{0};
+    std::atomic<size_t> retiredBytes_{0};
+
+    // Chunks never move; retired tables / directories / indexes stay alive
+    // until destruction, bounded by the geometric growth (see class doc)
+    std::vector<std::unique_ptr<Chunk>> chunks_;
+    std::vector<std::unique_ptr<Table>> tables_;
+    std::vector<std::unique_ptr<Chunk*[]>> directories_;
+    size_t directorySize_ = 0;
+    std::vector<std::unique_ptr<std::atomic<uint32_t>[]>> indexBlocks_;
+};
+
+} // namespace MarketData
+
+#endif // SEQLOCK_PRICE_SLAB_H
@@ -18,23 +18,18 @@ struct DepthLevel {
     DepthLevel(double p, uint32_t q, uint32_t o) : price(p), quantity(q), orders(o) {}
 };
 
+// =============================================================
+// STORAGE BLOCKS
+// =============================================================
+// The price stores keep each block in its own parallel array so a reader
+// copies only what it needs (LTP: TouchlineState, ladder: DepthState, ...)
+// instead of the whole UnifiedState. UnifiedState is the composed view.
+
 /**
- * @brief Unified record combining all market data fields for any token.
- * This is the "Single Source of Truth" for an instrument across the application.
- * 
- * Architecture:
- * - Fused State: Combines Touchline, Depth, OI, LPP, etc.
- * - Multi-Segment: Can represent NSE FO, NSE CM, or BSE instruments.
- * - Raw/Natural Units: Prices in Doubles (Rupees), Volume in 64-bit Ints.
+ * @brief Contract master info (written once at master load)
  */
-struct UnifiedState {
-    // =========================================================
-    // 1. IDENTIFICATION & METADATA
-    // =========================================================
-    uint32_t token = 0;
+struct ContractInfo {
     uint16_t exchangeSegment = 0; // 1=NSECM, 2=NSEFO, 3=BSECM, 4=BSEFO (Unified numbering)
-
-    // Contract Master Info (Static)
     char symbol[32] = {0};
     char displayName[64] = {0};
     char series[16] = {0};
@@ -46,76 +41,101 @@ struct UnifiedState {
     char expiryDate[16] = {0};      // DDMMMYYYY
     int64_t assetToken = 0;
     int32_t instrumentType = 0;     // 1=Future, 2=Option, 3=Equities, etc.
-    
-    // =========================================================
-    // 2. DYNAMIC MARKET DATA (LTP, OHLC, Volume)
-    // =========================================================
+};
+
+/**
+ * @brief Hot per-tick fields: prices, volume, OI, status, limits
+ */
+struct TouchlineState {
+    uint32_t token = 0;              // 0 = not found
+    uint16_t tradingStatus = 0;      // 1=Preopen, 2=Open, 3=Suspended, etc.
+    uint16_t bookType = 0;
+
     double ltp = 0.0;
     double open = 0.0;
     double high = 0.0;
     double low = 0.0;
     double close = 0.0;
     double avgPrice = 0.0;
-    
+
     uint64_t volume = 0;             // Cumulative volume traded today
     uint64_t turnover = 0;           // Cumulative turnover / value
     uint32_t lastTradeQty = 0;
-
     uint32_t lastTradeTime = 0;      // Seconds since midnight or epoch
-    
-    char netChangeIndicator = ' ';   // '+' or '-'
+
     double netChange = 0.0;
     double percentChange = 0.0;
-    
-    // =========================================================
-    // 3. MARKET DEPTH (5 Levels)
-    // =========================================================
+
+    int64_t openInterest = 0;
+    int64_t openInterestChange = 0;
+
+    double lowerCircuit = 0.0;
+    double upperCircuit = 0.0;
+
+    int64_t lastPacketTimestamp = 0; // Receipt time, steady-clock µs
+    uint32_t updateCount = 0;        // Number of updates received
+    char netChangeIndicator = ' ';   // '+' or '-'
+    bool isUpdated = false;          // True if any dynamic field changed since last reset
+};
+
+/**
+ * @brief Market depth (5 levels each side)
+ */
+struct DepthState {
     DepthLevel bids[5];
     DepthLevel asks[5];
     uint64_t totalBuyQty = 0;
     uint64_t totalSellQty = 0;
-    
-    // =========================================================
-    // 4. DERIVATIVES SPECIFIC (OI, IV, Greeks)
-    // =========================================================
-    int64_t openInterest = 0;
-    int64_t openInterestChange = 0;
+};
+
+/**
+ * @brief IV and Greeks (written by GreeksCalculationService)
+ */
+struct GreeksState {
     double impliedVolatility = 0.0;
-    
-    // Greeks (calculated by GreeksCalculationService)
     double delta = 0.0;
     double gamma = 0.0;
     double vega = 0.0;              // Per 1% IV change
     double theta = 0.0;             // Daily decay
     double theoreticalPrice = 0.0;
-    bool greeksCalculated = false;  // True if Greeks are valid
-    
-    // Extended Greeks Logic
     double bidIV = 0.0;
     double askIV = 0.0;
     int64_t lastGreeksUpdateTime = 0; // Timestamp of last Greek update (to throttle)
-    
-    // =========================================================
-    // 5. STATUS & LIMITS
-    // =========================================================
-    uint16_t tradingStatus = 0;      // 1=Preopen, 2=Open, 3=Suspended, etc.
-    uint16_t bookType = 0;
-    double lowerCircuit = 0.0;
-    double upperCircuit = 0.0;
-    
-    // =========================================================
-    // 6. DIAGNOSTICS
-    // =========================================================
-    int64_t lastPacketTimestamp = 0; // Nanoseconds since epoch
-    uint32_t updateCount = 0;        // Number of updates received
-    bool isUpdated = false;          // True if any dynamic field changed since last reset
+    bool greeksCalculated = false;  // True if Greeks are valid
+};
+
+/**
+ * @brief Unified record combining all market data fields for any token.
+ * This is the "Single Source of Truth" for an instrument across the application.
+ * 
+ * Architecture:
+ * - Fused State: Combines Touchline, Depth, OI, LPP, etc.
+ * - Multi-Segment: Can represent NSE FO, NSE CM, or BSE instruments.
+ * - Raw/Natural Units: Prices in Doubles (Rupees), Volume in 64-bit Ints.
+ * - Composed of the storage blocks above; fields are accessed directly
+ *   (state.ltp, state.bids[0], state.symbol). Prefer the partial
+ *   PriceStoreGateway accessors on hot paths.
+ */
+struct UnifiedState : ContractInfo, TouchlineState, DepthState, GreeksState {
+};
 
-    UnifiedState() {
-        std::memset(bids, 0, sizeof(bids));
-        std::memset(asks, 0, sizeof(asks));
-    }
+/**
+ * @brief One block of a changed row, stamped with the row's update version
+ *
+ * Result element of the changedSince() bulk reads (PriceStoreGateway and the
+ * per-segment stores): the caller picks the block it needs by the vector type.
+ */
+template <typename Block>
+struct VersionedBlock {
+    uint32_t token = 0;
+    uint64_t version = 0;
+    Block block;
 };
 
+using TouchlineChange = VersionedBlock<TouchlineState>;
+using DepthChange = VersionedBlock<DepthState>;
+using GreeksChange = VersionedBlock<GreeksState>;
+
 } // namespace MarketData
 
 #endif // UNIFIED_PRICE_STATE_H
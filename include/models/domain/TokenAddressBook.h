@@ -2,26 +2,40 @@
 #define TOKENADDRESSBOOK_H
 
 #include <QObject>
-#include <QMap>
+#include <QHash>
 #include <QList>
 #include <QString>
+#include <QVarLengthArray>
+#include <cstdint>
+#include <span>
+#include <vector>
 
 /**
  * @brief Fast bidirectional mapping between instrument identifiers and row indices
- * 
+ *
  * Supports both simple token-based lookups and composite keys (exchange+client+token).
  * Composite keys are handled as formatted strings: "exchange:client:token".
+ *
+ * The int64 (segment, token) store is the tick routing hot path: a flat
+ * open-addressed table (linear probing, backward-shift delete) whose slots
+ * hold the rows inline, so a lookup is one hash + a short probe with no
+ * allocation. Row → key reverse maps are plain vectors indexed by row, and
+ * insert/remove renumbering only touches the rows that actually shift.
  */
 class TokenAddressBook : public QObject
 {
     Q_OBJECT
 
 public:
+    // Non-owning view of the rows for one key. Valid until the next
+    // add/remove/row-shift/clear call on this address book.
+    using RowSpan = std::span<const int>;
+
     explicit TokenAddressBook(QObject *parent = nullptr);
     virtual ~TokenAddressBook() = default;
-    
+
     // === Management ===
-    
+
     /**
      * @brief Add a mapping for a simple token (Market Watch style)
      */
@@ -31,32 +45,32 @@ public:
      * @brief Add a mapping for a composite key (Position style)
      */
     void addCompositeToken(const QString& exchange, const QString& client, int token, int row);
-    
+
     /**
      * @brief Remove a mapping
      */
     void removeToken(int token, int row);
     void removeCompositeToken(const QString& exchange, const QString& client, int token, int row);
-    
+
     void clear();
-    
+
     // === Row Operation Handlers ===
-    
+
     void onRowMoved(int fromRow, int toRow);
     void onRowsInserted(int firstRow, int count);
     void onRowsRemoved(int firstRow, int count);
-    
+
     // === Lookups ===
-    
+
     QList<int> getRowsForToken(int token) const;
     QList<int> getRowsForCompositeToken(const QString& exchange, const QString& client, int token) const;
-    
+
     int getTokenForRow(int row) const;
     QString getCompositeKeyForRow(int row) const;
-    
+
     bool hasToken(int token) const;
     bool hasCompositeToken(const QString& exchange, const QString& client, int token) const;
-    
+
     // === Utils ===
     static QString makeKey(const QString& exchange, const QString& client, int token);
     static inline int64_t makeIntKey(int exchangeSegment, int token) {
@@ -70,22 +84,57 @@ public:
     QList<int> getRowsForIntKey(int64_t key) const; // Direct key lookup
     int64_t getIntKeyForRow(int row) const;
 
+    // Zero-copy variants for the per-tick path (no QList allocation)
+    RowSpan rowsForIntKey(int exchangeSegment, int token) const {
+        return rowsForIntKey(makeIntKey(exchangeSegment, token));
+    }
+    RowSpan rowsForIntKey(int64_t key) const;
+
 signals:
     void tokenAdded(const QString& key, int row);
     void tokenRemoved(const QString& key, int row);
     void cleared();
 
 private:
+    // Rows per key: a watch rarely lists one instrument more than a few times
+    using RowList = QVarLengthArray<int, 4>;
+
+    // 0 is never a valid key (segment 0 / token 0), so it marks empty slots
+    static constexpr int64_t kEmptyKey = 0;
+
+    struct IntSlot {
+        int64_t key = kEmptyKey;
+        RowList rows;
+    };
+
+    // Int64 table
+    size_t probeStart(int64_t key) const;
+    const IntSlot* findIntSlot(int64_t key) const;
+    IntSlot* findIntSlot(int64_t key);
+    IntSlot& insertIntSlot(int64_t key);
+    void eraseIntSlot(IntSlot* slot);
+    void growIntTable();
+    void removeIntRow(int64_t key, int row);
+
+    // String keys
+    void addStringKey(const QString& key, int row);
+    void removeStringKey(const QString& key, int row);
+
+    // Shift every mapped row >= startRow by delta (rows < startRow untouched)
     void updateRowIndices(int startRow, int delta);
-    
+
+    static void replaceRow(RowList& rows, int oldRow, int newRow);
+
     // key -> list of rows
-    QMap<QString, QList<int>> m_keyToRows;
-    // row -> key
-    QMap<int, QString> m_rowToKey;
-    
-    // Optimized Int64 store
-    QMap<int64_t, QList<int>> m_intKeyToRows;
-    QMap<int, int64_t> m_rowToIntKey;
+    QHash<QString, RowList> m_keyToRows;
+    // row -> key (empty = unmapped)
+    std::vector<QString> m_rowToKey;
+
+    // Optimized Int64 store: power-of-two open-addressed table
+    std::vector<IntSlot> m_intSlots;
+    size_t m_intCount = 0;
+    // row -> int key (kEmptyKey = unmapped)
+    std::vector<int64_t> m_rowToIntKey;
 };
 
 #endif // TOKENADDRESSBOOK_H
@@ -0,0 +1,75 @@
+#ifndef VIEWPORTSUBSCRIPTIONS_H
+#define VIEWPORTSUBSCRIPTIONS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief The set of table rows that keep a live feed subscription
+ *
+ * A market watch may hold thousands of scrips while ~40 rows are on screen.
+ * In viewport mode only the visible rows plus a prefetch margin above and
+ * below are subscribed. The view passes the keys those rows hold after each
+ * scroll / resize / re-sort, and update() returns only what crossed the edge:
+ * keys to subscribe (and fill from a store snapshot) and keys to drop.
+ *
+ * Keys are composite (segment << 32) | token, see FeedHandler::makeKey.
+ * Key 0 (blank separator rows) is ignored.
+ *
+ * Thread safety: none, owned and driven by the view (GUI thread).
+ */
+class ViewportSubscriptions
+{
+public:
+    static constexpr int kDefaultPrefetchRows = 20;
+
+    struct Delta {
+        std::vector<int64_t> added;   // Now live: subscribe, fill from the store
+        std::vector<int64_t> removed; // Left the window: unsubscribe
+        bool empty() const { return added.empty() && removed.empty(); }
+    };
+
+    explicit ViewportSubscriptions(int prefetchRows = kDefaultPrefetchRows);
+
+    void setPrefetchRows(int rows);
+    int prefetchRows() const { return m_prefetchRows; }
+
+    /**
+     * @brief Row range to keep live, from the view's visible rows
+     *
+     * Arguments follow QTableView::rowAt(): -1 for lastVisible means the
+     * viewport extends past the last row; -1 for firstVisible means nothing
+     * is laid out yet (hidden window), which keeps the first prefetch
+     * margin live.
+     *
+     * @return [first, last] widened by the prefetch margin and clamped to the
+     *         table; first > last when the table is empty
+     */
+    std::pair<int, int> liveRange(int firstVisible, int lastVisible, int rowCount) const;
+
+    /**
+     * @brief Make exactly keys live
+     * @return Keys that became live (in the given order) and keys that no
+     *         longer are
+     */
+    Delta update(const std::vector<int64_t>& keys);
+
+    // Forget one key without reporting it (its row was deleted and the caller
+    // already unsubscribed it)
+    void forget(int64_t key) { m_live.erase(key); }
+
+    // Drop every key; returns them as removed
+    Delta clear();
+
+    bool isLive(int64_t key) const { return m_live.count(key) != 0; }
+    size_t liveCount() const { return m_live.size(); }
+
+private:
+    int m_prefetchRows;
+    std::unordered_set<int64_t> m_live;
+};
+
+#endif // VIEWPORTSUBSCRIPTIONS_H
@@ -0,0 +1,151 @@
+#ifndef LIVESORTPROXYMODEL_H
+#define LIVESORTPROXYMODEL_H
+
+#include <QAbstractProxyModel>
+#include <QPersistentModelIndex>
+#include <QTimer>
+#include <QVector>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Sorting proxy for flat tables whose sort column ticks
+ *
+ * A QSortFilterProxyModel with dynamic sorting re-sorts through lessThan()
+ * on every dataChanged, fetching two QVariants (and, in PinnedRowProxyModel,
+ * two more UserRole strings) per comparison. With prices moving on hundreds
+ * of rows a second that is the dominant cost of a sorted live view.
+ *
+ * This proxy caches one sort key per source row, a double for numeric
+ * columns (a QString otherwise). A change on the sort column marks that row
+ * dirty; the dirty rows are re-positioned together at most once per reorder
+ * interval, each by a binary-search remove and insert, under a single
+ * layoutChanged. Rows whose key did not move are not touched. A burst that
+ * dirties a large part of the table falls back to one full sort.
+ *
+ * Pinned rows (pinOf(): "FILTER_ROW" at the top, "SUMMARY_ROW" at the bottom,
+ * as for PinnedRowProxyModel) keep their place in either sort order. Ties
+ * are broken by source row, so the order is deterministic.
+ *
+ * Flat table models only (no tree), no filtering. Values still repaint in
+ * place immediately: dataChanged is forwarded as it arrives, only the
+ * re-ordering is rate-limited.
+ */
+class LiveSortProxyModel : public QAbstractProxyModel
+{
+    Q_OBJECT
+
+public:
+    enum class Pin : uint8_t { None, Top, Bottom };
+
+    static constexpr int kDefaultReorderIntervalMs = 250;
+
+    explicit LiveSortProxyModel(QObject *parent = nullptr);
+
+    void setSourceModel(QAbstractItemModel *sourceModel) override;
+
+    // Role read for sort keys (default Qt::UserRole, the typed value role)
+    void setSortRole(int role);
+    int sortRole() const { return m_sortRole; }
+
+    /**
+     * @brief Minimum time between re-orders, in ms
+     *
+     * 0 re-positions on every change; a negative interval freezes the order
+     * until the next sort() or reorder() (values still update).
+     */
+    void setReorderInterval(int ms);
+    int reorderInterval() const { return m_reorderIntervalMs; }
+
+    int sortColumn() const { return m_sortColumn; }
+    Qt::SortOrder sortOrder() const { return m_sortOrder; }
+
+    // Rows waiting for the next re-order
+    int pendingRows() const { return static_cast<int>(m_dirtyRows.size()); }
+
+    // QAbstractItemModel / QAbstractProxyModel
+    QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex &child) const override;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+    QModelIndex mapToSource(const QModelIndex &proxyIndex) const override;
+    QModelIndex mapFromSource(const QModelIndex &sourceIndex) const override;
+
+    // column < 0 restores source order
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+public slots:
+    // Re-position the pending rows now
+    void reorder();
+
+protected:
+    // Row classification, read when a row is inserted or the model re-sorts
+    virtual Pin pinOf(int sourceRow) const;
+
+private slots:
+    void onSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight,
+                             const QVector<int> &roles);
+    void onSourceHeaderDataChanged(Qt::Orientation orientation, int first, int last);
+    void onSourceRowsInserted(const QModelIndex &parent, int first, int last);
+    void onSourceRowsAboutToBeRemoved(const QModelIndex &parent, int first, int last);
+    void onSourceRowsRemoved(const QModelIndex &parent, int first, int last);
+    void onSourceColumnsAboutToBeInserted(const QModelIndex &parent, int first, int last);
+    void onSourceColumnsInserted(const QModelIndex &parent, int first, int last);
+    void onSourceColumnsAboutToBeRemoved(const QModelIndex &parent, int first, int last);
+    void onSourceColumnsRemoved(const QModelIndex &parent, int first, int last);
+    void onSourceAboutToBeReset();
+    void onSourceReset();
+    void onSourceLayoutAboutToBeChanged();
+    void onSourceLayoutChanged();
+
+private:
+    bool isSorted() const { return m_sortColumn >= 0; }
+    int bodyBegin() const { return m_topCount; }
+    int bodyEnd() const { return static_cast<int>(m_rows.size()) - m_bottomCount; }
+
+    // Sort-order comparison of two body rows by cached key, then source row
+    bool rowLess(int left, int right) const;
+
+    QVariant sortValue(int sourceRow) const;
+    void detectKeyType();
+    void loadKey(int sourceRow);
+
+    // Rebuild m_rows from scratch (identity, or pins + sorted body)
+    void rebuildMapping();
+    void sortBody();
+    void updateProxyRows(int from, int to);
+    int insertPosition(int sourceRow) const;
+    void repositionRow(int sourceRow);
+    void scheduleReorder();
+
+    // Persistent proxy indexes across a re-order, tracked through the source
+    void beginLayoutChange(QAbstractItemModel::LayoutChangeHint hint);
+    void endLayoutChange(QAbstractItemModel::LayoutChangeHint hint);
+
+    std::vector<int> m_rows;        // Proxy row -> source row
+    std::vector<int> m_proxyRows;   // Source row -> proxy row
+    std::vector<Pin> m_pins;        // Per source row
+    std::vector<double> m_keys;     // Per source row, numeric columns
+    std::vector<QString> m_textKeys; // Per source row, text columns
+    std::vector<uint8_t> m_dirty;   // Per source row
+    std::vector<int> m_dirtyRows;
+    int m_topCount = 0;
+    int m_bottomCount = 0;
+
+    int m_sortColumn = -1;
+    Qt::SortOrder m_sortOrder = Qt::AscendingOrder;
+    int m_sortRole = Qt::UserRole;
+    bool m_numericKeys = true;
+    bool m_keyTypeKnown = false;
+
+    int m_reorderIntervalMs = kDefaultReorderIntervalMs;
+    QTimer m_reorderTimer;
+
+    bool m_resetting = false;
+    QModelIndexList m_layoutProxyIndexes;
+    QList<QPersistentModelIndex> m_layoutSourceIndexes;
+    QVector<QMetaObject::Connection> m_sourceConnections;
+};
+
+#endif // LIVESORTPROXYMODEL_H
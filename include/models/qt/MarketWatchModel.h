@@ -4,6 +4,7 @@
 #include "models/interfaces/IMarketWatchViewCallback.h"
 #include "models/profiles/GenericTableProfile.h"
 #include "models/profiles/MarketWatchColumnProfile.h"
+#include "models/qt/ScripTable.h"
 #include "udp/UDPTypes.h"
 #include <QAbstractTableModel>
 #include <QDateTime>
@@ -12,129 +13,11 @@
 #include <QSet>
 #include <QString>
 #include <QTimer>
+#include <QVector>
 #include <initializer_list>
+#include <vector>
 
 
-/**
- * @brief Data structure for a single scrip (security) in the market watch
- *
- * Supports both regular scrips and blank separator rows for organization.
- * Contains all data fields for the extended column set.
- */
-struct ScripData {
-  // Identity fields
-  int code = 0;            // Scrip code
-  QString symbol;          // e.g., "NIFTY 50", "RELIANCE"
-  QString scripName;       // Full scrip name
-  QString instrumentName;  // Instrument name
-  QString instrumentType;  // Type of instrument
-  QString marketType;      // Market type
-  QString exchange;        // e.g., "NSE", "BSE", "NFO"
-  int token = 0;           // Unique token ID for API subscriptions
-  bool isBlankRow = false; // True for visual separator rows
-
-  // F&O specific fields
-  double strikePrice = 0.0; // Strike price for options
-  QString optionType;       // CE/PE for options
-  QString seriesExpiry;     // Series/Expiry date
-
-  // Additional identifiers
-  QString isinCode; // ISIN code
-
-  // Price and trading data
-  double ltp = 0.0;       // Last Traded Price
-  qint64 ltq = 0;         // Last Traded Quantity
-  QString ltpTime;        // Last Traded Time
-  QString lastUpdateTime; // Last Update Time
-
-  // OHLC data
-  double open = 0.0;  // Opening price
-  double high = 0.0;  // Day high
-  double low = 0.0;   // Day low
-  double close = 0.0; // Previous close
-  QString dpr;        // Daily Price Range/Band
-
-  // Change metrics
-  double change = 0.0;        // Net Change In Rs
-  double changePercent = 0.0; // % Change
-  QString trendIndicator;     // Trend indicator (up/down/neutral)
-
-  // Volume and value
-  double avgTradedPrice = 0.0; // Avg. Traded Price
-  qint64 volume = 0;           // Volume (in 000s)
-  double value = 0.0;          // Value (in lacs)
-
-  // Market depth - Buy side
-  double buyPrice = 0.0;  // Best buy price
-  qint64 buyQty = 0;      // Best buy quantity
-  qint64 totalBuyQty = 0; // Total buy quantity
-
-  // Market depth - Sell side
-  double sellPrice = 0.0;  // Best sell price (ask)
-  qint64 sellQty = 0;      // Best sell quantity
-  qint64 totalSellQty = 0; // Total sell quantity
-
-  // Open Interest (F&O)
-  qint64 openInterest = 0;      // Open interest
-  double oiChangePercent = 0.0; // % OI change
-
-  // Greeks (Options only - calculated by GreeksCalculationService)
-  double iv = 0.0; // Implied Volatility (decimal, 0.18 = 18%)
-  double bidIV = 0.0;
-  double askIV = 0.0;
-  double delta = 0.0; // Delta
-  double gamma = 0.0; // Gamma
-  double vega = 0.0;  // Vega (per 1% IV change)
-  double theta = 0.0; // Theta (daily decay)
-
-  // Historical data
-  double week52High = 0.0;   // 52 week high
-  double week52Low = 0.0;    // 52 week low
-  double lifetimeHigh = 0.0; // Lifetime high
-  double lifetimeLow = 0.0;  // Lifetime low
-
-  // Additional metrics
-  double marketCap = 0.0;      // Market capitalization
-  QString tradeExecutionRange; // Trade execution range
-
-  // Convenience aliases for backward compatibility
-  double bid = 0.0; // Best bid price (alias for buyPrice)
-  double ask = 0.0; // Best ask price (alias for sellPrice)
-
-  // Tick directions for background coloring (1: up, -1: down, 0: same)
-  int ltpTick = 0;
-  int bidTick = 0;
-  int askTick = 0;
-
-  // Timestamps for auto-resetting tick flash (milliseconds since epoch)
-  qint64 ltpTickTime = 0;
-  qint64 bidTickTime = 0;
-  qint64 askTickTime = 0;
-
-  /**
-   * @brief Create a blank row for organizing scrips
-   * 
-   * Blank rows are empty rows with no token, used to organize/group scrips.
-   * They look identical to regular rows (just show empty cells) but are not
-   * subscribed to market data and won't receive updates.
-   * 
-   * @return ScripData configured as a blank row
-   */
-  static ScripData createBlankRow() {
-    ScripData blank;
-    blank.isBlankRow = true;
-    blank.symbol = ""; // Empty symbol
-    blank.token = -1;  // Invalid token (won't be subscribed)
-    return blank;
-  }
-
-  /**
-   * @brief Check if this is a valid tradeable scrip
-   * @return true if token is valid and not a blank row
-   */
-  bool isValid() const { return token > 0 && !isBlankRow; }
-};
-
 /**
  * @brief Model for Market Watch data using Qt's Model/View framework
  *
@@ -197,6 +80,34 @@ public:
    */
   bool isNativeCallbackEnabled() const { return m_viewCallback != nullptr; }
 
+  // ===================================================================
+  // FRAME COALESCING: one dataChanged batch per repaint frame
+  // ===================================================================
+
+  /**
+   * @brief Coalesce row notifications into one flush per frame
+   *
+   * With an interval set, ticks only mutate ScripData and mark the touched
+   * cells in a per-row column bitmap. A timer flushes the bitmap every
+   * @p intervalMs, emitting one dataChanged per rectangle of consecutive
+   * rows that share the same contiguous column run. A row that ticks 20
+   * times between two frames is repainted once.
+   *
+   * @param intervalMs Flush period (16 ≈ 60 Hz, 50, 100); 0 = notify
+   *                   immediately on every update (legacy behaviour)
+   */
+  void setCoalesceInterval(int intervalMs);
+  int coalesceInterval() const { return m_coalesceIntervalMs; }
+
+  /**
+   * @brief Emit all pending dirty ranges now (no-op when nothing is dirty)
+   *
+   * Called by the flush timer, and before any structural change so queued
+   * row indices never outlive the rows they refer to.
+   */
+  void flushPendingUpdates();
+  int pendingRowCount() const { return m_dirtyRows.size(); }
+
   // Required QAbstractTableModel overrides
   int rowCount(const QModelIndex &parent = QModelIndex()) const override;
   int columnCount(const QModelIndex &parent = QModelIndex()) const override;
@@ -230,8 +141,16 @@ public:
   bool isBlankRow(int row) const;
 
   // Data access
-  const ScripData &getScripAt(int row) const;
-  ScripData &getScripAt(int row);
+  // Rows are stored column-wise (ScripTable): this gathers a copy of the row.
+  // Bind to `const ScripData &` or a value; writes go through updateXxx().
+  ScripData getScripAt(int row) const;
+  // Whether a visible column's values move with ticks (prices, volume, depth,
+  // OI, Greeks) rather than coming from the contract master
+  bool isLiveColumn(int column) const;
+  // Single-field read for the tick path (no full-row gather)
+  double closePriceAt(int row) const {
+    return isLiveRow(row) ? m_rows.close[row] : 0.0;
+  }
 
   // Price updates
   void updatePrice(int row, double ltp, double change, double changePercent);
@@ -270,7 +189,14 @@ public:
 
   // Statistics
   int scripCount() const; // Count excluding blank rows
-  int totalRowCount() const { return m_scrips.count(); }
+  int totalRowCount() const { return m_rows.size(); }
+
+  // Memory diagnostics (reported through MemoryProfiler)
+  size_t memoryFootprint() const { return m_rows.memoryBytes(); }
+  size_t legacyFootprint() const { return m_rows.legacyLayoutBytes(); }
+  // Wall time (ns) of one repaint's data() calls — Display, Background and
+  // Foreground for every visible column of rows [firstRow, firstRow + rows)
+  qint64 measureRepaintCost(int firstRow = 0, int rows = -1) const;
 
 signals:
   void scripAdded(int row, const ScripData &scrip);
@@ -278,7 +204,7 @@ signals:
   void priceUpdated(int row, double ltp, double change);
 
 private:
-  QList<ScripData> m_scrips;
+  ScripTable m_rows;
   GenericTableProfile m_columnProfile;
 
   // O(1) token → row lookup (maintained on add/remove/move/clear)
@@ -292,6 +218,23 @@ private:
   QTimer m_flashResetTimer;
   QSet<int> m_flashingRows;
 
+  // Frame coalescing: dirty cells waiting for the next flush.
+  // m_dirtyColumns holds m_dirtyWordsPerRow bit words per source row;
+  // m_dirtyRows lists each row with at least one bit set (unsorted).
+  int m_coalesceIntervalMs = 0;
+  QTimer m_coalesceTimer;
+  int m_dirtyWordsPerRow = 0;
+  std::vector<quint64> m_dirtyColumns;
+  QVector<int> m_dirtyRows;
+
+  // Set the bits for [firstColumn, lastColumn] of row and arm the timer
+  void markDirty(int row, int firstColumn, int lastColumn);
+  // Drop pending ranges without emitting (model reset makes them moot)
+  void discardPendingUpdates();
+  // Emit one contiguous range to the view (signal + optional callback)
+  void emitRangeUpdated(int firstRow, int lastRow, int firstColumn,
+                        int lastColumn);
+
   // Schedule a flash reset repaint for the given row
   void scheduleFlashReset(int row);
   // Called when the flash timer fires — repaints all expired-flash rows
@@ -312,11 +255,14 @@ private:
   // Finds the min/max visible indices and emits a single notification
   void notifyColumnsUpdated(int row, std::initializer_list<MarketWatchColumn> cols);
 
-  // Helper to get data for a specific column
-  QVariant getColumnData(const ScripData &scrip,
-                         MarketWatchColumn column) const;
-  QString formatColumnData(const ScripData &scrip,
-                           MarketWatchColumn column) const;
+  // Row exists and is not a blank separator
+  bool isLiveRow(int row) const;
+  // Refresh m_tokenToRow for rows [firstRow, lastRow] after a shift
+  void reindexTokens(int firstRow, int lastRow);
+
+  // Helper to get data for a specific column (reads the column directly)
+  QVariant getColumnData(int row, MarketWatchColumn column) const;
+  QString formatColumnData(int row, MarketWatchColumn column) const;
 };
 
 #endif // MARKETWATCHMODEL_H
@@ -0,0 +1,127 @@
+#ifndef SCRIPDATA_H
+#define SCRIPDATA_H
+
+#include <QString>
+#include <QtGlobal>
+
+/**
+ * @brief Data structure for a single scrip (security) in the market watch
+ *
+ * Supports both regular scrips and blank separator rows for organization.
+ * Contains all data fields for the extended column set.
+ */
+struct ScripData {
+  // Identity fields
+  int code = 0;            // Scrip code
+  QString symbol;          // e.g., "NIFTY 50", "RELIANCE"
+  QString scripName;       // Full scrip name
+  QString instrumentName;  // Instrument name
+  QString instrumentType;  // Type of instrument
+  QString marketType;      // Market type
+  QString exchange;        // e.g., "NSE", "BSE", "NFO"
+  int token = 0;           // Unique token ID for API subscriptions
+  bool isBlankRow = false; // True for visual separator rows
+
+  // F&O specific fields
+  double strikePrice = 0.0; // Strike price for options
+  QString optionType;       // CE/PE for options
+  QString seriesExpiry;     // Series/Expiry date
+
+  // Additional identifiers
+  QString isinCode; // ISIN code
+
+  // Price and trading data
+  double ltp = 0.0;       // Last Traded Price
+  qint64 ltq = 0;         // Last Traded Quantity
+  QString ltpTime;        // Last Traded Time
+  QString lastUpdateTime; // Last Update Time
+
+  // OHLC data
+  double open = 0.0;  // Opening price
+  double high = 0.0;  // Day high
+  double low = 0.0;   // Day low
+  double close = 0.0; // Previous close
+  QString dpr;        // Daily Price Range/Band
+
+  // Change metrics
+  double change = 0.0;        // Net Change In Rs
+  double changePercent = 0.0; // % Change
+  QString trendIndicator;     // Trend indicator (up/down/neutral)
+
+  // Volume and value
+  double avgTradedPrice = 0.0; // Avg. Traded Price
+  qint64 volume = 0;           // Volume (in 000s)
+  double value = 0.0;          // Value (in lacs)
+
+  // Market depth - Buy side
+  double buyPrice = 0.0;  // Best buy price
+  qint64 buyQty = 0;      // Best buy quantity
+  qint64 totalBuyQty = 0; // Total buy quantity
+
+  // Market depth - Sell side
+  double sellPrice = 0.0;  // Best sell price (ask)
+  qint64 sellQty = 0;      // Best sell quantity
+  qint64 totalSellQty = 0; // Total sell quantity
+
+  // Open Interest (F&O)
+  qint64 openInterest = 0;      // Open interest
+  double oiChangePercent = 0.0; // % OI change
+
+  // Greeks (Options only - calculated by GreeksCalculationService)
+  double iv = 0.0; // Implied Volatility (decimal, 0.18 = 18%)
+  double bidIV = 0.0;
+  double askIV = 0.0;
+  double delta = 0.0; // Delta
+  double gamma = 0.0; // Gamma
+  double vega = 0.0;  // Vega (per 1% IV change)
+  double theta = 0.0; // Theta (daily decay)
+
+  // Historical data
+  double week52High = 0.0;   // 52 week high
+  double week52Low = 0.0;    // 52 week low
+  double lifetimeHigh = 0.0; // Lifetime high
+  double lifetimeLow = 0.0;  // Lifetime low
+
+  // Additional metrics
+  double marketCap = 0.0;      // Market capitalization
+  QString tradeExecutionRange; // Trade execution range
+
+  // Convenience aliases for backward compatibility
+  double bid = 0.0; // Best bid price (alias for buyPrice)
+  double ask = 0.0; // Best ask price (alias for sellPrice)
+
+  // Tick directions for background coloring (1: up, -1: down, 0: same)
+  int ltpTick = 0;
+  int bidTick = 0;
+  int askTick = 0;
+
+  // Timestamps for auto-resetting tick flash (milliseconds since epoch)
+  qint64 ltpTickTime = 0;
+  qint64 bidTickTime = 0;
+  qint64 askTickTime = 0;
+
+  /**
+   * @brief Create a blank row for organizing scrips
+   * 
+   * Blank rows are empty rows with no token, used to organize/group scrips.
+   * They look identical to regular rows (just show empty cells) but are not
+   * subscribed to market data and won't receive updates.
+   * 
+   * @return ScripData configured as a blank row
+   */
+  static ScripData createBlankRow() {
+    ScripData blank;
+    blank.isBlankRow = true;
+    blank.symbol = ""; // Empty symbol
+    blank.token = -1;  // Invalid token (won't be subscribed)
+    return blank;
+  }
+
+  /**
+   * @brief Check if this is a valid tradeable scrip
+   * @return true if token is valid and not a blank row
+   */
+  bool isValid() const { return token > 0 && !isBlankRow; }
+};
+
+#endif // SCRIPDATA_H
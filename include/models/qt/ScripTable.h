@@ -0,0 +1,158 @@
+#ifndef SCRIPTABLE_H
+#define SCRIPTABLE_H
+
+#include "models/qt/ScripData.h"
+#include <QHash>
+#include <QString>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+/**
+ * @brief Process-wide intern table for static scrip text
+ *
+ * Symbol, exchange, instrument type, expiry, ISIN... repeat across rows and
+ * across every open market watch. Each distinct string is stored once and
+ * rows keep a 4-byte id. Id 0 is always the empty string.
+ *
+ * Strings are never released: the set is bounded by the contract master.
+ * GUI thread only (models are created and updated on the GUI thread).
+ */
+class ScripStringPool {
+public:
+  using Id = quint32;
+
+  static ScripStringPool &instance();
+
+  Id intern(const QString &text);
+  // Reference stays valid for the life of the process
+  const QString &at(Id id) const {
+    return id < m_strings.size() ? m_strings[id] : m_strings[0];
+  }
+
+  int size() const { return static_cast<int>(m_strings.size()); }
+  size_t memoryBytes() const;
+
+  // Heap bytes a QString payload occupies when it is not shared
+  static size_t heapBytes(const QString &text);
+
+private:
+  ScripStringPool();
+
+  std::deque<QString> m_strings; // deque: references survive growth
+  QHash<QString, Id> m_ids;
+};
+
+/**
+ * @brief Columnar (struct-of-arrays) storage for MarketWatchModel rows
+ *
+ * One contiguous vector per ScripData field, indexed by row. A tick writes
+ * a handful of doubles in arrays that hold nothing else, and data() reads a
+ * single column, instead of both dragging a ~450-byte ScripData (a dozen
+ * QString pointers) through the cache. Static text columns hold
+ * ScripStringPool ids.
+ *
+ * ScripData remains the exchange format at the API boundary: insert() and
+ * assign() scatter one into the columns, at() gathers one back.
+ * ScripData::bid/buyPrice and ask/sellPrice are always equal in the model, so
+ * each pair is one column.
+ */
+class ScripTable {
+public:
+  using StringId = ScripStringPool::Id;
+
+  int size() const { return static_cast<int>(token.size()); }
+  bool isEmpty() const { return token.empty(); }
+
+  // Structural edits (row == size() appends)
+  void insert(int row, const ScripData &scrip);
+  void append(const ScripData &scrip) { insert(size(), scrip); }
+  void remove(int row);
+  // Move one row so that it ends up at index 'to' (indices after removal)
+  void move(int from, int to);
+  void clear();
+  void reserve(int rows);
+
+  // Whole-row exchange with ScripData
+  void assign(int row, const ScripData &scrip);
+  ScripData at(int row) const;
+
+  const QString &text(StringId id) const {
+    return ScripStringPool::instance().at(id);
+  }
+
+  // Bytes held by this table's columns (shared string pool excluded)
+  size_t memoryBytes() const;
+  // Bytes the same rows would take as QList<ScripData> with unshared strings
+  size_t legacyLayoutBytes() const;
+
+  // ── Identity / static text ──
+  std::vector<int> code;
+  std::vector<int> token;
+  std::vector<quint8> isBlankRow;
+  std::vector<StringId> symbol;
+  std::vector<StringId> scripName;
+  std::vector<StringId> instrumentName;
+  std::vector<StringId> instrumentType;
+  std::vector<StringId> marketType;
+  std::vector<StringId> exchange;
+  std::vector<StringId> optionType;
+  std::vector<StringId> seriesExpiry;
+  std::vector<StringId> isinCode;
+  std::vector<StringId> dpr;
+  std::vector<StringId> trendIndicator;
+  std::vector<StringId> tradeExecutionRange;
+  std::vector<double> strikePrice;
+
+  // ── Hot tick columns ──
+  std::vector<double> ltp;
+  std::vector<qint64> ltq;
+  std::vector<double> open;
+  std::vector<double> high;
+  std::vector<double> low;
+  std::vector<double> close;
+  std::vector<double> change;
+  std::vector<double> changePercent;
+  std::vector<double> avgTradedPrice;
+  std::vector<qint64> volume;
+  std::vector<double> value;
+  std::vector<double> bid; // == buyPrice
+  std::vector<double> ask; // == sellPrice
+  std::vector<qint64> buyQty;
+  std::vector<qint64> sellQty;
+  std::vector<qint64> totalBuyQty;
+  std::vector<qint64> totalSellQty;
+  std::vector<qint64> openInterest;
+  std::vector<double> oiChangePercent;
+
+  // ── Greeks ──
+  std::vector<double> iv;
+  std::vector<double> bidIV;
+  std::vector<double> askIV;
+  std::vector<double> delta;
+  std::vector<double> gamma;
+  std::vector<double> vega;
+  std::vector<double> theta;
+
+  // ── Historical / misc ──
+  std::vector<double> week52High;
+  std::vector<double> week52Low;
+  std::vector<double> lifetimeHigh;
+  std::vector<double> lifetimeLow;
+  std::vector<double> marketCap;
+
+  // ── Tick flash ──
+  std::vector<qint8> ltpTick;
+  std::vector<qint8> bidTick;
+  std::vector<qint8> askTick;
+  std::vector<qint64> ltpTickTime;
+  std::vector<qint64> bidTickTime;
+  std::vector<qint64> askTickTime;
+
+  // ── Per-row volatile text (changes per update; not interned) ──
+  std::vector<QString> ltpTime;
+  std::vector<QString> lastUpdateTime;
+};
+
+#endif // SCRIPTABLE_H
@@ -0,0 +1,42 @@
+#ifndef THREAD_AFFINITY_H
+#define THREAD_AFFINITY_H
+
+#if defined(_WIN32)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#elif defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+/**
+ * @brief Pin the calling thread to one CPU core.
+ *
+ * Used by the broadcast receive / parse threads so a hot thread keeps its
+ * caches and is not migrated next to another hot thread. Negative core =
+ * leave the thread to the scheduler. Returns false when the core does not
+ * exist or the platform has no affinity API (macOS).
+ */
+namespace udp_ingest {
+
+inline bool pinCurrentThreadToCore(int core) {
+    if (core < 0) return false;
+#if defined(_WIN32)
+    if (core >= static_cast<int>(sizeof(DWORD_PTR) * 8)) return false;
+    return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << core) != 0;
+#elif defined(__linux__)
+    if (core >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    return false;
+#endif
+}
+
+} // namespace udp_ingest
+
+#endif // THREAD_AFFINITY_H
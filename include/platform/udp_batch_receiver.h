@@ -0,0 +1,281 @@
+#ifndef UDP_BATCH_RECEIVER_H
+#define UDP_BATCH_RECEIVER_H
+
+#include "socket_platform.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+    #include <sys/epoll.h>
+    #include <sys/eventfd.h>
+    #include <time.h>
+    #define UDP_BATCH_INGEST_SUPPORTED 1
+#else
+    #define UDP_BATCH_INGEST_SUPPORTED 0
+#endif
+
+/**
+ * @brief Batched multicast ingest shared by the NSE FO / NSE CM / BSE receivers.
+ *
+ * Linux only: pulls up to N datagrams per syscall with recvmmsg() into a ring of
+ * preallocated slots, reads the kernel receive timestamp (SO_TIMESTAMPNS) of
+ * every datagram, and blocks in epoll_wait() on the socket plus an eventfd so
+ * stop() wakes the receive thread immediately instead of waiting for the 1 s
+ * SO_RCVTIMEO poll. On other platforms isSupported() is false and receivers
+ * keep their one-recv()-per-datagram loop.
+ */
+namespace udp_ingest {
+
+inline int64_t steadyNowMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Receive timestamp (steady-clock µs) of the datagram the current thread is
+// parsing. Set by the receive loop, read by parsers as the timestampUdpRecv
+// baseline. 0 means "unknown" (legacy loop) and parsers fall back to now().
+inline int64_t& currentPacketTimestampRef() {
+    thread_local int64_t timestamp = 0;
+    return timestamp;
+}
+
+inline void setCurrentPacketTimestamp(int64_t steadyMicros) {
+    currentPacketTimestampRef() = steadyMicros;
+}
+
+inline int64_t packetTimestampOrNow() {
+    int64_t ts = currentPacketTimestampRef();
+    return ts > 0 ? ts : steadyNowMicros();
+}
+
+class BatchReceiver {
+public:
+    static constexpr size_t kDefaultBatchSize = 64;
+    static constexpr size_t kMaxBatchSize = 1024;
+
+    static bool isSupported() { return UDP_BATCH_INGEST_SUPPORTED != 0; }
+
+    BatchReceiver() = default;
+    ~BatchReceiver() { close(); }
+
+    BatchReceiver(const BatchReceiver&) = delete;
+    BatchReceiver& operator=(const BatchReceiver&) = delete;
+
+    /**
+     * @brief Attach to a bound socket and allocate the receive ring.
+     * @param fd Bound UDP socket (ownership stays with the caller)
+     * @param batchSize Max datagrams pulled per recvmmsg() call
+     * @param slotSize Bytes per datagram slot (max datagram size)
+     * @return false if unsupported or epoll/eventfd setup failed
+     */
+    bool open(socket_t fd, size_t batchSize, size_t slotSize) {
+#if UDP_BATCH_INGEST_SUPPORTED
+        close();
+        if (batchSize == 0) batchSize = kDefaultBatchSize;
+        if (batchSize > kMaxBatchSize) batchSize = kMaxBatchSize;
+
+        sockfd_ = fd;
+        batchSize_ = batchSize;
+        slotSize_ = slotSize;
+
+        // Kernel receive timestamps. Non-fatal: without them the receive
+        // loop stamps datagrams in userspace after recvmmsg() returns.
+        int on = 1;
+        kernelTimestamps_ =
+            setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on)) == 0;
+
+        epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+        int wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        wakeFd_.store(wakeFd, std::memory_order_release);
+        if (epollFd_ < 0 || wakeFd < 0) {
+            close();
+            return false;
+        }
+
+        struct epoll_event ev {};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            close();
+            return false;
+        }
+        ev.data.fd = wakeFd;
+        if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, wakeFd, &ev) < 0) {
+            close();
+            return false;
+        }
+
+        // One contiguous slab for all slots, cache-line aligned so the
+        // parser's first reads of each datagram start on a fresh line.
+        size_t slabSize = ((batchSize_ * slotSize_ + 63) / 64) * 64;
+        slab_ = static_cast<char*>(std::aligned_alloc(64, slabSize));
+        if (!slab_) {
+            close();
+            return false;
+        }
+
+        iovecs_.assign(batchSize_, {});
+        msgs_.assign(batchSize_, {});
+        control_.assign(batchSize_ * kControlSize, 0);
+        timestamps_.assign(batchSize_, 0);
+        for (size_t i = 0; i < batchSize_; ++i) {
+            iovecs_[i].iov_base = slab_ + i * slotSize_;
+            iovecs_[i].iov_len = slotSize_;
+            msgs_[i].msg_hdr.msg_iov = &iovecs_[i];
+            msgs_[i].msg_hdr.msg_iovlen = 1;
+        }
+        return true;
+#else
+        (void)fd;
+        (void)batchSize;
+        (void)slotSize;
+        return false;
+#endif
+    }
+
+    bool isOpen() const { return epollFd_ >= 0; }
+    bool hasKernelTimestamps() const { return kernelTimestamps_; }
+
+    /**
+     * @brief Block until datagrams arrive or wakeup() is called.
+     * @return >0 number of datagrams now in slots [0, n); 0 if woken up or
+     *         interrupted (caller re-checks its running flag); <0 on error.
+     */
+    int receive() {
+#if UDP_BATCH_INGEST_SUPPORTED
+        struct epoll_event events[2];
+        int ready = epoll_wait(epollFd_, events, 2, -1);
+        if (ready < 0) {
+            return errno == EINTR ? 0 : -1;
+        }
+
+        const int wakeFd = wakeFd_.load(std::memory_order_acquire);
+        bool socketReady = false;
+        for (int i = 0; i < ready; ++i) {
+            if (events[i].data.fd == wakeFd) {
+                uint64_t counter;
+                (void)::read(wakeFd, &counter, sizeof(counter));
+                return 0;
+            }
+            if (events[i].data.fd == sockfd_) socketReady = true;
+        }
+        if (!socketReady) return 0;
+
+        for (size_t i = 0; i < batchSize_; ++i) {
+            // The kernel rewrites these on every call
+            msgs_[i].msg_hdr.msg_control = control_.data() + i * kControlSize;
+            msgs_[i].msg_hdr.msg_controllen = kControlSize;
+            msgs_[i].msg_hdr.msg_flags = 0;
+            msgs_[i].msg_len = 0;
+        }
+
+        int n = recvmmsg(sockfd_, msgs_.data(), static_cast<unsigned int>(batchSize_),
+                         MSG_DONTWAIT, nullptr);
+        if (n < 0) {
+            return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+        }
+
+        // Map CLOCK_REALTIME kernel stamps onto the steady clock the parsers use
+        int64_t steadyNow = steadyNowMicros();
+        struct timespec realNow;
+        clock_gettime(CLOCK_REALTIME, &realNow);
+        int64_t realNowMicros = static_cast<int64_t>(realNow.tv_sec) * 1000000 +
+                                realNow.tv_nsec / 1000;
+
+        for (int i = 0; i < n; ++i) {
+            timestamps_[i] = steadyNow;
+            if (!kernelTimestamps_) continue;
+            struct msghdr& hdr = msgs_[i].msg_hdr;
+            for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr); cmsg;
+                 cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
+                if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+                    struct timespec ts;
+                    std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+                    int64_t kernelMicros = static_cast<int64_t>(ts.tv_sec) * 1000000 +
+                                           ts.tv_nsec / 1000;
+                    timestamps_[i] = steadyNow - (realNowMicros - kernelMicros);
+                    break;
+                }
+            }
+        }
+        return n;
+#else
+        return -1;
+#endif
+    }
+
+    /**
+     * @brief Wake a thread blocked in receive(). Safe to call from any thread,
+     * also while another thread runs close().
+     */
+    void wakeup() {
+#if UDP_BATCH_INGEST_SUPPORTED
+        // Announce the write before loading the fd: close() waits for it, so
+        // the descriptor cannot be closed (and its number reused) mid-write
+        wakers_.fetch_add(1);
+        const int wakeFd = wakeFd_.load();
+        if (wakeFd >= 0) {
+            uint64_t one = 1;
+            (void)::write(wakeFd, &one, sizeof(one));
+        }
+        wakers_.fetch_sub(1);
+#endif
+    }
+
+    char* data(int i) { return slab_ + static_cast<size_t>(i) * slotSize_; }
+#if UDP_BATCH_INGEST_SUPPORTED
+    size_t length(int i) const { return msgs_[i].msg_len; }
+    // Datagram was larger than a slot: only its first slotSize bytes arrived
+    bool truncated(int i) const { return (msgs_[i].msg_hdr.msg_flags & MSG_TRUNC) != 0; }
+#else
+    size_t length(int) const { return 0; }
+    bool truncated(int) const { return false; }
+#endif
+    int64_t timestampMicros(int i) const { return timestamps_[i]; }
+
+    void close() {
+#if UDP_BATCH_INGEST_SUPPORTED
+        const int wakeFd = wakeFd_.exchange(-1);
+        if (epollFd_ >= 0) ::close(epollFd_);
+        if (wakeFd >= 0) {
+            // A wakeup() that loaded the fd before the exchange finishes first
+            while (wakers_.load() != 0) std::this_thread::yield();
+            ::close(wakeFd);
+        }
+#endif
+        epollFd_ = -1;
+        wakeFd_ = -1;
+        std::free(slab_);
+        slab_ = nullptr;
+    }
+
+private:
+#if UDP_BATCH_INGEST_SUPPORTED
+    static constexpr size_t kControlSize = CMSG_SPACE(sizeof(struct timespec));
+    std::vector<struct iovec> iovecs_;
+    std::vector<struct mmsghdr> msgs_;
+#else
+    static constexpr size_t kControlSize = 0;
+#endif
+    std::vector<char> control_;
+    std::vector<int64_t> timestamps_;
+
+    socket_t sockfd_ = socket_invalid;
+    int epollFd_ = -1;
+    std::atomic<int> wakeFd_{-1};
+    std::atomic<int> wakers_{0};  // wakeup() calls in flight
+    char* slab_ = nullptr;
+    size_t batchSize_ = 0;
+    size_t slotSize_ = 0;
+    bool kernelTimestamps_ = false;
+};
+
+} // namespace udp_ingest
+
+#endif // UDP_BATCH_RECEIVER_H
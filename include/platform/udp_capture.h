@@ -0,0 +1,355 @@
+#ifndef UDP_CAPTURE_H
+#define UDP_CAPTURE_H
+
+#include "socket_platform.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Raw datagram capture and offline replay for the UDP feed receivers.
+ *
+ * CaptureWriter appends every datagram a receiver sees to a classic pcap file
+ * (nanosecond timestamps, LINKTYPE_RAW) with a synthesized IPv4/UDP header
+ * carrying the multicast group and port, so captures open in Wireshark and
+ * tcpdump. CaptureReader reads those files back, plus tcpdump captures taken
+ * on the wire (Ethernet / 802.1Q, Linux cooked, raw IPv4), and yields the UDP
+ * payloads in file order. ReplayPacer reproduces the captured inter-arrival
+ * times at 1x, Nx or (speed <= 0) as fast as possible.
+ *
+ * Writer and reader are single-threaded: one writer per receiver thread.
+ */
+namespace udp_capture {
+
+constexpr uint32_t kPcapMagicMicros = 0xa1b2c3d4;
+constexpr uint32_t kPcapMagicNanos = 0xa1b23c4d;
+constexpr uint32_t kLinkTypeEthernet = 1;
+constexpr uint32_t kLinkTypeRaw = 101;
+constexpr uint32_t kLinkTypeLinuxSll = 113;
+constexpr uint32_t kLinkTypeIpv4 = 228;
+constexpr uint32_t kSnapLen = 65535;
+
+inline int64_t wallClockNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+#pragma pack(push, 1)
+struct PcapFileHeader {
+    uint32_t magic;
+    uint16_t versionMajor;
+    uint16_t versionMinor;
+    int32_t thisZone;
+    uint32_t sigFigs;
+    uint32_t snapLen;
+    uint32_t linkType;
+};
+
+struct PcapRecordHeader {
+    uint32_t tsSec;
+    uint32_t tsFrac;     // µs or ns depending on the file magic
+    uint32_t inclLen;
+    uint32_t origLen;
+};
+#pragma pack(pop)
+
+class CaptureWriter {
+public:
+    static constexpr size_t kIpHeaderSize = 20;
+    static constexpr size_t kUdpHeaderSize = 8;
+    static constexpr size_t kMaxPayload = kSnapLen - kIpHeaderSize - kUdpHeaderSize;
+
+    CaptureWriter() = default;
+    ~CaptureWriter() { close(); }
+
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+    /**
+     * @brief Create (truncate) @p path and write the pcap file header.
+     * @param groupIp Multicast group written as the IPv4 destination
+     * @param port UDP port written as source and destination port
+     */
+    bool open(const std::string& path, const std::string& groupIp, uint16_t port) {
+        close();
+        file_ = std::fopen(path.c_str(), "wb");
+        if (!file_) return false;
+        // Large stdio buffer: the receive thread pays one write() per ~1 MB
+        buffer_.reset(new char[kFileBufferSize]);
+        std::setvbuf(file_, buffer_.get(), _IOFBF, kFileBufferSize);
+
+        groupIp_ = inet_addr(groupIp.c_str());
+        port_ = htons(port);
+        datagrams_ = 0;
+        bytes_ = 0;
+
+        const PcapFileHeader header{kPcapMagicNanos, 2, 4, 0, 0, kSnapLen, kLinkTypeRaw};
+        if (std::fwrite(&header, sizeof(header), 1, file_) != 1) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Append one datagram payload (receive thread)
+     * @param wallNanos Receive time, ns since the Unix epoch
+     */
+    void write(const void* data, size_t length, int64_t wallNanos = wallClockNanos()) {
+        if (!file_) return;
+        if (length > kMaxPayload) length = kMaxPayload;
+
+        struct {
+            PcapRecordHeader record;
+            uint8_t ip[kIpHeaderSize];
+            uint8_t udp[kUdpHeaderSize];
+        } frame;
+        const uint32_t wireLen = static_cast<uint32_t>(kIpHeaderSize + kUdpHeaderSize + length);
+        frame.record.tsSec = static_cast<uint32_t>(wallNanos / 1000000000);
+        frame.record.tsFrac = static_cast<uint32_t>(wallNanos % 1000000000);
+        frame.record.inclLen = wireLen;
+        frame.record.origLen = wireLen;
+
+        uint8_t* ip = frame.ip;
+        std::memset(ip, 0, kIpHeaderSize);
+        ip[0] = 0x45;                                  // IPv4, 20-byte header
+        putBe16(ip + 2, static_cast<uint16_t>(wireLen));
+        putBe16(ip + 4, static_cast<uint16_t>(datagrams_));
+        ip[6] = 0x40;                                  // Don't fragment
+        ip[8] = 64;                                    // TTL
+        ip[9] = 17;                                    // UDP
+        std::memcpy(ip + 16, &groupIp_, 4);            // Source left 0.0.0.0
+        putBe16(ip + 10, ipChecksum(ip));
+
+        uint8_t* udp = frame.udp;
+        std::memcpy(udp, &port_, 2);
+        std::memcpy(udp + 2, &port_, 2);
+        putBe16(udp + 4, static_cast<uint16_t>(kUdpHeaderSize + length));
+        udp[6] = udp[7] = 0;                           // No checksum (legal on IPv4)
+
+        std::fwrite(&frame, sizeof(frame), 1, file_);
+        std::fwrite(data, 1, length, file_);
+        ++datagrams_;
+        bytes_ += length;
+    }
+
+    void flush() { if (file_) std::fflush(file_); }
+
+    void close() {
+        if (file_) {
+            std::fclose(file_);
+            file_ = nullptr;
+        }
+        buffer_.reset();
+    }
+
+    bool isOpen() const { return file_ != nullptr; }
+    uint64_t datagrams() const { return datagrams_; }
+    uint64_t bytes() const { return bytes_; }
+
+private:
+    static constexpr size_t kFileBufferSize = 1 << 20;
+
+    static void putBe16(uint8_t* p, uint16_t v) {
+        p[0] = static_cast<uint8_t>(v >> 8);
+        p[1] = static_cast<uint8_t>(v);
+    }
+
+    static uint16_t ipChecksum(const uint8_t* header) {
+        uint32_t sum = 0;
+        for (size_t i = 0; i < kIpHeaderSize; i += 2) {
+            sum += (uint32_t(header[i]) << 8) | header[i + 1];
+        }
+        while (sum >> 16) sum = (sum & 0xFFFF) + (sum >> 16);
+        return static_cast<uint16_t>(~sum);
+    }
+
+    FILE* file_ = nullptr;
+    std::unique_ptr<char[]> buffer_;
+    uint32_t groupIp_ = 0;   // Network byte order
+    uint16_t port_ = 0;      // Network byte order
+    uint64_t datagrams_ = 0;
+    uint64_t bytes_ = 0;
+};
+
+// One UDP payload read back from a capture
+struct Datagram {
+    const uint8_t* data = nullptr;  // Valid until the next CaptureReader::next()
+    size_t length = 0;
+    int64_t timestampNanos = 0;     // Capture time, ns since the Unix epoch
+    uint16_t dstPort = 0;
+};
+
+class CaptureReader {
+public:
+    CaptureReader() = default;
+    ~CaptureReader() { close(); }
+
+    CaptureReader(const CaptureReader&) = delete;
+    CaptureReader& operator=(const CaptureReader&) = delete;
+
+    bool open(const std::string& path) {
+        close();
+        file_ = std::fopen(path.c_str(), "rb");
+        if (!file_) {
+            error_ = "cannot open " + path;
+            return false;
+        }
+        PcapFileHeader header;
+        if (std::fread(&header, sizeof(header), 1, file_) != 1) {
+            error_ = "truncated pcap header";
+            close();
+            return false;
+        }
+        switch (header.magic) {
+        case kPcapMagicMicros: swapped_ = false; nanos_ = false; break;
+        case kPcapMagicNanos:  swapped_ = false; nanos_ = true;  break;
+        default:
+            if (swap32(header.magic) == kPcapMagicMicros) { swapped_ = true; nanos_ = false; break; }
+            if (swap32(header.magic) == kPcapMagicNanos)  { swapped_ = true; nanos_ = true;  break; }
+            error_ = "not a pcap file (pcapng is not supported)";
+            close();
+            return false;
+        }
+        linkType_ = fix32(header.linkType);
+        if (linkType_ != kLinkTypeEthernet && linkType_ != kLinkTypeRaw &&
+            linkType_ != kLinkTypeLinuxSll && linkType_ != kLinkTypeIpv4) {
+            error_ = "unsupported link type " + std::to_string(linkType_);
+            close();
+            return false;
+        }
+        record_.resize(kSnapLen);
+        return true;
+    }
+
+    // Only yield datagrams sent to @p port (0 = any)
+    void setPortFilter(uint16_t port) { portFilter_ = port; }
+
+    /**
+     * @brief Read the next UDP payload, skipping non-IPv4/UDP frames,
+     *        fragments and filtered ports.
+     * @return false at end of file (or on a truncated record)
+     */
+    bool next(Datagram& out) {
+        while (file_) {
+            PcapRecordHeader rec;
+            if (std::fread(&rec, sizeof(rec), 1, file_) != 1) return false;
+            const uint32_t inclLen = fix32(rec.inclLen);
+            if (inclLen > record_.size()) record_.resize(inclLen);
+            if (inclLen > 0 && std::fread(record_.data(), 1, inclLen, file_) != inclLen) return false;
+
+            const int64_t frac = fix32(rec.tsFrac);
+            out.timestampNanos = int64_t(fix32(rec.tsSec)) * 1000000000 + (nanos_ ? frac : frac * 1000);
+            if (decodeUdp(record_.data(), inclLen, out)) {
+                if (portFilter_ == 0 || out.dstPort == portFilter_) return true;
+            }
+            ++skipped_;
+        }
+        return false;
+    }
+
+    void close() {
+        if (file_) {
+            std::fclose(file_);
+            file_ = nullptr;
+        }
+    }
+
+    bool isOpen() const { return file_ != nullptr; }
+    const std::string& error() const { return error_; }
+    uint64_t skipped() const { return skipped_; }   // Frames that were not a usable datagram
+
+private:
+    static uint32_t swap32(uint32_t v) {
+        return (v >> 24) | ((v >> 8) & 0xFF00) | ((v << 8) & 0xFF0000) | (v << 24);
+    }
+    uint32_t fix32(uint32_t v) const { return swapped_ ? swap32(v) : v; }
+    static uint16_t be16(const uint8_t* p) { return static_cast<uint16_t>((p[0] << 8) | p[1]); }
+
+    bool decodeUdp(const uint8_t* frame, size_t length, Datagram& out) const {
+        size_t offset = 0;
+        if (linkType_ == kLinkTypeEthernet) {
+            if (length < 14) return false;
+            uint16_t etherType = be16(frame + 12);
+            offset = 14;
+            while (etherType == 0x8100 || etherType == 0x88A8) {  // VLAN tags
+                if (length < offset + 4) return false;
+                etherType = be16(frame + offset + 2);
+                offset += 4;
+            }
+            if (etherType != 0x0800) return false;
+        } else if (linkType_ == kLinkTypeLinuxSll) {
+            if (length < 16 || be16(frame + 14) != 0x0800) return false;
+            offset = 16;
+        }
+
+        const uint8_t* ip = frame + offset;
+        if (length < offset + 20 || (ip[0] >> 4) != 4 || ip[9] != 17) return false;
+        if (be16(ip + 6) & 0x3FFF) return false;   // Fragment (no reassembly)
+        const size_t ipHeaderLen = size_t(ip[0] & 0x0F) * 4;
+        const uint8_t* udp = ip + ipHeaderLen;
+        if (length < offset + ipHeaderLen + 8) return false;
+
+        const size_t udpLen = be16(udp + 4);
+        const size_t available = length - offset - ipHeaderLen - 8;
+        out.data = udp + 8;
+        out.length = udpLen >= 8 && udpLen - 8 <= available ? udpLen - 8 : available;
+        out.dstPort = be16(udp + 2);
+        return true;
+    }
+
+    FILE* file_ = nullptr;
+    bool swapped_ = false;
+    bool nanos_ = false;
+    uint32_t linkType_ = 0;
+    uint16_t portFilter_ = 0;
+    uint64_t skipped_ = 0;
+    std::vector<uint8_t> record_;
+    std::string error_;
+};
+
+/**
+ * @brief Paces replay to the captured inter-arrival times
+ *
+ * speed 1.0 = real time, 10.0 = ten times faster, <= 0 = no pacing.
+ * Long waits sleep, the last ~100 µs spin so bursts keep their spacing.
+ */
+class ReplayPacer {
+public:
+    explicit ReplayPacer(double speed) : speed_(speed) {}
+
+    void wait(int64_t captureNanos) {
+        if (speed_ <= 0) return;
+        const auto now = std::chrono::steady_clock::now();
+        if (!started_) {
+            started_ = true;
+            firstCapture_ = captureNanos;
+            start_ = now;
+            return;
+        }
+        const auto offset = std::chrono::nanoseconds(
+            static_cast<int64_t>((captureNanos - firstCapture_) / speed_));
+        const auto target = start_ + offset;
+        if (target - now > std::chrono::microseconds(200)) {
+            std::this_thread::sleep_until(target - std::chrono::microseconds(100));
+        }
+        while (std::chrono::steady_clock::now() < target) {
+        }
+    }
+
+private:
+    double speed_;
+    bool started_ = false;
+    int64_t firstCapture_ = 0;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace udp_capture
+
+#endif // UDP_CAPTURE_H
@@ -0,0 +1,168 @@
+#ifndef UDP_FANOUT_RING_H
+#define UDP_FANOUT_RING_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace udp_ingest {
+
+/**
+ * @brief Single-producer, multi-consumer broadcast ring of raw datagrams.
+ *
+ * The receive thread copies each datagram (plus its receive timestamp) in
+ * once; every consumer reads every record through its own cursor, so N parse
+ * workers see the feed in exactly the receive order without a per-record
+ * hand-off. A record's space is reclaimed once the slowest consumer has
+ * passed it.
+ *
+ * Records are variable length (16-byte header + payload, 16-byte aligned) in
+ * a power-of-two byte buffer; a record that would straddle the end is
+ * preceded by a wrap marker and written at offset 0.
+ *
+ * Threading: tryPublish() from one producer thread; consume(i) from the one
+ * thread that owns consumer i. No locks, no allocation after construction.
+ */
+class FanoutRing {
+public:
+    static constexpr size_t kMaxRecordBytes = 65535;
+
+    FanoutRing(size_t capacityBytes, size_t consumers)
+        : capacity_(roundUpPow2(std::max(capacityBytes, static_cast<size_t>(4 * recordSize(kMaxRecordBytes))))),
+          mask_(capacity_ - 1),
+          buffer_(capacity_),
+          cursors_(std::max<size_t>(1, consumers)) {}
+
+    FanoutRing(const FanoutRing&) = delete;
+    FanoutRing& operator=(const FanoutRing&) = delete;
+
+    size_t capacity() const { return capacity_; }
+    size_t consumers() const { return cursors_.size(); }
+
+    /**
+     * @brief Append one datagram (producer thread only).
+     * @return false if the slowest consumer has not freed enough space
+     */
+    bool tryPublish(const void* data, size_t length, int64_t timestamp) {
+        if (length > kMaxRecordBytes) return false;
+        const uint64_t need = recordSize(length);
+        const size_t offset = head_ & mask_;
+        const size_t contiguous = capacity_ - offset;
+        const uint64_t total = contiguous < need ? contiguous + need : need;
+
+        if (head_ + total - cachedMinTail_ > capacity_) {
+            cachedMinTail_ = minTail();
+            if (head_ + total - cachedMinTail_ > capacity_) return false;
+        }
+
+        uint64_t pos = head_;
+        if (contiguous < need) {
+            // Headers are 16-byte aligned, so at least one header always fits
+            writeHeader(offset, kWrapMarker, 0);
+            pos += contiguous;
+        }
+        const size_t at = pos & mask_;
+        writeHeader(at, static_cast<uint32_t>(length), timestamp);
+        std::memcpy(&buffer_[at + sizeof(Header)], data, length);
+        head_ = pos + need;
+        published_.store(head_, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Hand up to @p maxRecords pending records to @p fn (consumer thread only).
+     * @param fn Called as fn(const uint8_t* data, uint32_t length, int64_t timestamp);
+     *           the data pointer is valid only for the duration of the call
+     * @return Records consumed
+     */
+    template <typename Fn>
+    size_t consume(size_t consumer, Fn&& fn, size_t maxRecords = 64) {
+        std::atomic<uint64_t>& cursor = cursors_[consumer].pos;
+        uint64_t tail = cursor.load(std::memory_order_relaxed);
+        const uint64_t head = published_.load(std::memory_order_acquire);
+        size_t count = 0;
+        while (tail < head && count < maxRecords) {
+            const size_t offset = tail & mask_;
+            Header header;
+            std::memcpy(&header, &buffer_[offset], sizeof(header));
+            if (header.length == kWrapMarker) {
+                tail += capacity_ - offset;
+                continue;
+            }
+            fn(&buffer_[offset + sizeof(Header)], header.length, header.timestamp);
+            tail += recordSize(header.length);
+            ++count;
+            // Release per record so the producer can reuse the space early
+            cursor.store(tail, std::memory_order_release);
+        }
+        cursor.store(tail, std::memory_order_release);
+        return count;
+    }
+
+    bool drained(size_t consumer) const {
+        return cursors_[consumer].pos.load(std::memory_order_acquire) ==
+               published_.load(std::memory_order_acquire);
+    }
+
+    // Bytes consumer @p consumer still has to read
+    size_t backlog(size_t consumer) const {
+        return static_cast<size_t>(published_.load(std::memory_order_acquire) -
+                                   cursors_[consumer].pos.load(std::memory_order_acquire));
+    }
+
+private:
+    struct Header {
+        uint32_t length;
+        uint32_t reserved;
+        int64_t timestamp;
+    };
+    static_assert(sizeof(Header) == 16, "record header must keep 16-byte alignment");
+
+    struct alignas(64) Cursor {
+        std::atomic<uint64_t> pos{0};
+    };
+
+    static constexpr uint32_t kWrapMarker = 0xFFFFFFFFu;
+
+    static constexpr uint64_t recordSize(size_t length) {
+        return (sizeof(Header) + length + 15) & ~uint64_t(15);
+    }
+
+    static size_t roundUpPow2(size_t v) {
+        size_t p = 1;
+        while (p < v) p <<= 1;
+        return p;
+    }
+
+    void writeHeader(size_t offset, uint32_t length, int64_t timestamp) {
+        const Header header{length, 0, timestamp};
+        std::memcpy(&buffer_[offset], &header, sizeof(header));
+    }
+
+    uint64_t minTail() const {
+        uint64_t tail = head_;
+        for (const auto& cursor : cursors_) {
+            tail = std::min(tail, cursor.pos.load(std::memory_order_acquire));
+        }
+        return tail;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::vector<uint8_t> buffer_;
+
+    // Producer side
+    uint64_t head_ = 0;
+    uint64_t cachedMinTail_ = 0;
+    alignas(64) std::atomic<uint64_t> published_{0};
+
+    // Consumer side (one cache line each)
+    std::vector<Cursor> cursors_;
+};
+
+} // namespace udp_ingest
+
+#endif // UDP_FANOUT_RING_H
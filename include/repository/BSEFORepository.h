@@ -88,9 +88,21 @@ public:
   bool isLoaded() const { return m_loaded; }
   void finalizeLoad();
 
+  /**
+   * @brief Apply a master refresh in place (see MasterDelta)
+   * @param upserts New and changed contracts; a changed one replaces its row
+   * @param removed Tokens no longer listed in the master
+   *
+   * Rows are removed by moving the last row into the gap, so contract
+   * order is not kept. Live fields of re-added rows start from zero.
+   */
+  void applyDelta(const QVector<MasterContract> &upserts,
+                  const QVector<int64_t> &removed);
+
 private:
   void addContractInternal(const MasterContract &contract,
                            std::function<QString(const QString &)> intern);
+  void removeContractInternal(int64_t token);
   // Two-level indexing
   QHash<int64_t, int32_t> m_tokenToIndex;
   int32_t m_contractCount;
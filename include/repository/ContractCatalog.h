@@ -0,0 +1,121 @@
+#ifndef CONTRACT_CATALOG_H
+#define CONTRACT_CATALOG_H
+
+#include <QHash>
+#include <QString>
+#include <QStringView>
+#include <QVector>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Integer-keyed option chain catalog (ATM Watch, Option Chain)
+ *
+ * Symbols are interned to dense SymbolIds, expiries are days since
+ * 1970-01-01 (so they sort by date) and strikes are integer ticks of 0.01.
+ * Every (symbol, expiry) pair has one Chain: its strikes ascending with
+ * parallel CE / PE token columns, plus the pair's future token.
+ *
+ * Chains are stored sorted by (symbol, expiry), so finding a chain, a
+ * symbol's expiries or a strike within a chain is a binary search over
+ * integers: no "SYMBOL|EXPIRY|STRIKE" keys are built and nothing is
+ * allocated on the lookup path.
+ *
+ * Built once per master load, then immutable. RepositoryManager hands it out
+ * as a shared_ptr, so a reader can keep using a catalog across a rebuild.
+ */
+class ContractCatalog {
+public:
+  using SymbolId = int32_t;
+  using ExpiryId = int32_t;
+
+  static constexpr SymbolId kNoSymbol = -1;
+  static constexpr ExpiryId kNoExpiry = 0;
+  static constexpr int kStrikeTicksPerUnit = 100;
+
+  struct Chain {
+    SymbolId symbol = kNoSymbol;
+    ExpiryId expiry = kNoExpiry;
+    int64_t futureToken = 0;      // 0 if the pair has no future
+    QVector<double> strikes;      // Ascending
+    QVector<int64_t> strikeTicks; // Parallel to strikes
+    QVector<int64_t> callTokens;  // Parallel, 0 = no CE listed
+    QVector<int64_t> putTokens;   // Parallel, 0 = no PE listed
+
+    // Index of an exact strike, -1 if not listed
+    int indexOfStrike(double strike) const;
+
+    // Index of the strike nearest to price (the lower one on a tie, as
+    // ATMCalculator), -1 if the chain has no strikes
+    int atmIndex(double price) const;
+  };
+
+  static int64_t strikeTicks(double strike);
+
+  // "27FEB2026" (or "27FEB26") -> days since epoch; kNoExpiry if not a date
+  static ExpiryId expiryId(QStringView expiry);
+  // Days since epoch -> "27FEB2026"
+  static QString expiryText(ExpiryId expiry);
+
+  // ===== BUILD =====
+
+  void addOption(const QString &symbol, const QString &expiry, double strike,
+                 bool isCall, int64_t token);
+
+  // The first future added for a pair wins
+  void addFuture(const QString &symbol, const QString &expiry, int64_t token);
+
+  // List a symbol under an expiry for symbolsForExpiry() without a chain
+  void addListing(const QString &symbol, const QString &expiry);
+
+  /**
+   * @brief Sort the added rows into chains. Call once after the last add.
+   */
+  void finalize();
+
+  // ===== LOOKUP =====
+
+  SymbolId symbolId(const QString &symbol) const;
+  QString symbolName(SymbolId symbol) const;
+  int symbolCount() const { return m_symbols.size(); }
+
+  const Chain *chain(SymbolId symbol, ExpiryId expiry) const;
+  const Chain *chain(const QString &symbol, const QString &expiry) const;
+
+  // Expiries with a chain for the symbol, ascending
+  QVector<ExpiryId> expiries(SymbolId symbol) const;
+
+  // Symbols with options (or a listing) on the expiry, sorted by name
+  QVector<QString> symbolsForExpiry(ExpiryId expiry) const;
+
+  const QVector<Chain> &chains() const { return m_chains; }
+
+private:
+  struct OptionRow {
+    uint64_t chainKey;
+    int64_t ticks;
+    double strike;
+    int64_t token;
+    bool isCall;
+  };
+
+  static uint64_t chainKey(SymbolId symbol, ExpiryId expiry) {
+    return (uint64_t(uint32_t(symbol)) << 32) | uint32_t(expiry);
+  }
+
+  SymbolId internSymbol(const QString &symbol);
+
+  QHash<QString, SymbolId> m_symbolIds;
+  QVector<QString> m_symbols;
+
+  QVector<Chain> m_chains;        // Sorted by (symbol, expiry)
+  QVector<uint64_t> m_chainKeys;  // Parallel to m_chains
+  QVector<uint64_t> m_listings;   // Sorted unique (expiry << 32 | symbol)
+
+  // Build state, released by finalize()
+  std::vector<OptionRow> m_optionRows;
+  std::vector<std::pair<uint64_t, int64_t>> m_futureRows;
+};
+
+#endif // CONTRACT_CATALOG_H
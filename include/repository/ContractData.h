@@ -176,12 +176,15 @@ struct MasterContract {
   QString underlyingIndexName; // Field 15 (UnderlyingIndexName)
   int64_t assetToken;          // Field 14 (underlying asset token)
 
+  // Hash of the source master row (MasterDelta::hashRow), 0 if unknown
+  uint64_t rowHash;
+
   // Constructor
   MasterContract()
       : exchangeInstrumentID(0), instrumentType(0), freezeQty(0), tickSize(0.0),
         lotSize(0), multiplier(0), priceNumerator(0), priceDenominator(0),
         timeToExpiry(0.0), strikePrice(0.0), optionType(0), assetToken(0),
-        priceBandHigh(0.0), priceBandLow(0.0) {}
+        priceBandHigh(0.0), priceBandLow(0.0), rowHash(0) {}
 
   /**
    * @brief Convert MasterContract to ContractData
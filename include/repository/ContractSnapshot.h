@@ -0,0 +1,188 @@
+#ifndef CONTRACT_SNAPSHOT_H
+#define CONTRACT_SNAPSHOT_H
+
+#include "ContractData.h"
+#include <QFile>
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief Versioned binary snapshot of the loaded contract master
+ *
+ * Written once after masters are downloaded (or after a CSV load that had no
+ * usable snapshot) and memory-mapped on the next start, so loading ~130K
+ * contracts is a walk over fixed-width records instead of re-parsing the
+ * processed CSVs line by line.
+ *
+ * File layout (little-endian, every section 8-byte aligned):
+ *   Header
+ *   Record[recordCount]     grouped by segment, token-sorted within each
+ *   uint32 order[recordCount]  per segment, record indices sorted by
+ *                              expiry date → symbol → instrument type →
+ *                              strike → option type (the pre-sorted index
+ *                              order, see NSEFORepositoryPreSorted)
+ *   uint32 stringOffsets[stringCount + 1]  in UTF-16 code units
+ *   char16 stringData[]      every distinct string once
+ *
+ * Strings are stored once and referenced by id, so identical symbols,
+ * series and expiries share one QString after loading (the interning the
+ * CSV loader had to switch off). find() looks contracts up directly in the
+ * mapping by binary search.
+ *
+ * A file with another magic, version or record size is rejected by open();
+ * the caller falls back to the CSV / master files and rewrites the snapshot.
+ */
+class ContractSnapshot {
+public:
+  static constexpr uint32_t kMagic = 0x53435441; // "ATCS"
+  static constexpr uint32_t kVersion = 2; // 2: per-record master row hash
+  static constexpr uint32_t kNoString = 0xFFFFFFFFu;
+  static constexpr int kSegmentCount = 4;
+
+  // Segment order in the file (XTS exchange segment IDs)
+  static constexpr int kSegments[kSegmentCount] = {1, 2, 11, 12};
+
+  struct Record {
+    int64_t token;
+    int64_t assetToken;
+    double tickSize;
+    double priceBandHigh;
+    double priceBandLow;
+    double strikePrice;
+    uint32_t name;        // String ids (kNoString = empty)
+    uint32_t displayName;
+    uint32_t description;
+    uint32_t series;
+    uint32_t expiryDate;
+    uint32_t optionType;
+    int32_t lotSize;
+    int32_t freezeQty;
+    int32_t instrumentType;
+    int32_t expiryJulianDay; // 0 = no / unparsable expiry
+    uint64_t rowHash;        // Source master row (MasterDelta), 0 = unknown
+  };
+  static_assert(sizeof(Record) == 104, "Record layout is part of the file format");
+
+  struct SegmentRange {
+    int32_t segment;
+    uint32_t first; // First record index
+    uint32_t count;
+    uint32_t reserved;
+  };
+
+  struct Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t recordCount;
+    uint32_t stringCount;
+    uint32_t reserved;
+    int64_t createdMsecs; // Wall clock, for logs only
+    SegmentRange segments[kSegmentCount];
+    uint64_t recordsOffset;
+    uint64_t orderOffset;
+    uint64_t stringOffsetsOffset;
+    uint64_t stringDataOffset;
+    uint64_t fileSize;
+  };
+
+  ContractSnapshot() = default;
+  ~ContractSnapshot();
+  ContractSnapshot(const ContractSnapshot &) = delete;
+  ContractSnapshot &operator=(const ContractSnapshot &) = delete;
+
+  /**
+   * @brief Map and validate a snapshot file
+   * @param error Reason on failure (missing, truncated, version mismatch...)
+   * @return false if the file cannot be used
+   */
+  bool open(const QString &path, QString *error = nullptr);
+  void close();
+  bool isOpen() const { return m_header != nullptr; }
+
+  uint32_t recordCount() const { return m_header ? m_header->recordCount : 0; }
+  uint32_t stringCount() const { return m_header ? m_header->stringCount : 0; }
+  int64_t createdMsecs() const { return m_header ? m_header->createdMsecs : 0; }
+
+  // Records of one segment, token-sorted (count 0 for an unknown segment)
+  const Record *segmentRecords(int segment, uint32_t *count) const;
+
+  /**
+   * @brief Binary search in the mapping
+   * @return Record, or nullptr if the segment has no such token
+   */
+  const Record *find(int segment, int64_t token) const;
+
+  // Tokens of one segment in pre-sorted index order
+  QVector<int64_t> orderedTokens(int segment) const;
+
+  /**
+   * @brief String by id (shared: every call for an id returns the same
+   *        QString data, created on first use)
+   */
+  QString string(uint32_t id) const;
+
+  ContractData toContractData(const Record &record) const;
+
+  /**
+   * @brief Stream one segment's contracts for a repository's addContract()
+   *
+   * optionType is mapped back to the master-file code the repositories
+   * decode (CE = 1, PE = 2); timeToExpiry is recomputed for today; rowHash
+   * is the record's.
+   */
+  void forEachContract(int segment,
+                       const std::function<void(const MasterContract &)> &visitor) const;
+
+  /**
+   * @brief Parse a DDMMMYYYY expiry ("27JAN2026") to a Julian day, 0 if invalid
+   */
+  static int32_t expiryToJulianDay(const QString &expiry);
+
+private:
+  QFile m_file;
+  const uchar *m_data = nullptr;
+  const Header *m_header = nullptr;
+  const Record *m_records = nullptr;
+  const uint32_t *m_order = nullptr;
+  const uint32_t *m_stringOffsets = nullptr;
+  const char16_t *m_stringData = nullptr;
+  mutable QVector<QString> m_strings; // Materialized on first use
+  mutable std::vector<uint8_t> m_stringReady;
+};
+
+/**
+ * @brief Collects contracts per segment and writes a ContractSnapshot file
+ *
+ * Usage:
+ * ```cpp
+ * ContractSnapshotWriter writer;
+ * repo->forEachContract([&](const ContractData &c) { writer.add(2, c); });
+ * writer.write(path);
+ * ```
+ */
+class ContractSnapshotWriter {
+public:
+  // rowHash: hash of the master row the contract came from (0 = unknown),
+  // kept so a later download can be applied as a MasterDelta
+  void add(int segment, const ContractData &contract, uint64_t rowHash = 0);
+  int count() const;
+
+  /**
+   * @brief Sort, index and write the snapshot (atomically, via QSaveFile)
+   */
+  bool write(const QString &path, QString *error = nullptr) const;
+
+private:
+  uint32_t intern(const QString &str);
+
+  QHash<QString, uint32_t> m_stringIds;
+  QVector<QString> m_strings;
+  std::vector<ContractSnapshot::Record> m_records[ContractSnapshot::kSegmentCount];
+};
+
+#endif // CONTRACT_SNAPSHOT_H
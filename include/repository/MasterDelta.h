@@ -0,0 +1,131 @@
+#ifndef MASTER_DELTA_H
+#define MASTER_DELTA_H
+
+#include "ContractData.h"
+#include <QString>
+#include <QVector>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+class ParallelMasterParser;
+
+/**
+ * @brief Row-level diff of a downloaded combined master against the loaded
+ *        one (intraday re-login refresh)
+ *
+ * Every master row is hashed (FNV-1a over the raw line) and the hashes of the
+ * loaded master are kept per (segment, token). compute() walks a fresh
+ * download once, in parallel: a row whose hash matches is recognised from its
+ * segment, token and hash alone and never turned into a contract, so only new
+ * and changed rows are parsed. Loaded rows the download no longer lists are
+ * reported as removed.
+ *
+ * Contracts that did not come from a master row (the index master rows
+ * appended to NSECM) have no hash and are never reported as removed.
+ *
+ * Usage:
+ * ```cpp
+ * MasterDelta delta;
+ * delta.compute(parser, currentHashes);
+ * for (int segment : MasterDelta::kSegments)
+ *   if (delta.segmentChanged(segment)) repo(segment)->applyDelta(...);
+ * currentHashes = delta.takeHashes();
+ * ```
+ */
+class MasterDelta {
+public:
+  static constexpr int kSegmentCount = 4;
+
+  // XTS exchange segment IDs, in slot order
+  static constexpr int kSegments[kSegmentCount] = {1, 2, 11, 12};
+
+  struct RowHash {
+    int32_t segment;
+    int64_t token;
+    uint64_t hash;
+  };
+  // Sorted by (segment, token), one entry per contract
+  using RowHashes = std::vector<RowHash>;
+
+  struct SegmentDelta {
+    QVector<MasterContract> upserts; // New and changed rows, fully parsed
+    QVector<int64_t> removed;
+  };
+
+  struct Stats {
+    int rows = 0; // Contract rows in the download
+    int inserted = 0;
+    int modified = 0;
+    int removed = 0;
+    int unchanged = 0;
+    qint64 elapsedUs = 0; // Hash, parse changed rows, diff
+
+    int changed() const { return inserted + modified + removed; }
+  };
+
+  // FNV-1a 64 of the line; never 0 (0 = no hash)
+  static uint64_t hashRow(std::string_view line);
+
+  /**
+   * @brief Segment (field 0) and token (field 1) of a combined master row
+   * @return false for a blank, unknown-segment or token-less line
+   */
+  static bool rowKey(std::string_view line, int32_t &segment, int64_t &token);
+
+  // "NSEFO" -> 2 etc., 0 if unknown
+  static int32_t segmentId(const QString &exchange);
+
+  // Sort by (segment, token); of duplicated keys the later entry is kept
+  static void sortHashes(RowHashes &hashes);
+
+  // Hash of a key, 0 if it has none
+  static uint64_t findHash(const RowHashes &hashes, int32_t segment,
+                           int64_t token);
+
+  /**
+   * @brief Diff the parser input against the loaded master's hashes
+   * @param current Hashes of the loaded master, sorted
+   *
+   * Rows are keyed by (segment, token); the last row of a repeated key wins.
+   * Rows that parseMasterLine() rejects are treated as absent, as a full
+   * load would skip them.
+   */
+  void compute(ParallelMasterParser &parser, const RowHashes &current);
+
+  const SegmentDelta &segment(int32_t segment) const;
+  bool segmentChanged(int32_t segment) const;
+  bool isEmpty() const { return m_stats.changed() == 0; }
+  const Stats &stats() const { return m_stats; }
+
+  // Hashes of the downloaded master, to replace the current ones once applied
+  const RowHashes &hashes() const { return m_hashes; }
+  RowHashes takeHashes() { return std::move(m_hashes); }
+
+  /**
+   * @brief Remove row idx from a set of parallel columns by moving each
+   *        column's last row into it (O(1); row order is not kept)
+   */
+  template <typename... Columns>
+  static void swapRemove(int idx, Columns &...columns) {
+    (swapRemoveOne(idx, columns), ...);
+  }
+
+private:
+  template <typename Column>
+  static void swapRemoveOne(int idx, Column &column) {
+    const int last = column.size() - 1;
+    if (idx != last)
+      column[idx] = std::move(column[last]);
+    column.removeLast();
+  }
+
+  static int slot(int32_t segment);
+
+  SegmentDelta m_segments[kSegmentCount];
+  RowHashes m_hashes;
+  Stats m_stats;
+};
+
+#endif // MASTER_DELTA_H
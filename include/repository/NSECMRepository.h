@@ -82,6 +82,17 @@ public:
    */
   void finalizeLoad();
 
+  /**
+   * @brief Apply a master refresh in place (see MasterDelta)
+   * @param upserts New and changed contracts; a changed one replaces its row
+   * @param removed Tokens no longer listed in the master
+   *
+   * Rows are removed by moving the last row into the gap, so contract
+   * order is not kept. Live fields of re-added rows start from zero.
+   */
+  void applyDelta(const QVector<MasterContract> &upserts,
+                  const QVector<int64_t> &removed);
+
   /**
    * @brief Save contracts to processed CSV file
    * @param filename Path to save CSV file
@@ -211,6 +222,7 @@ private:
 private:
   void addContractInternal(const MasterContract &contract,
                            std::function<QString(const QString &)> intern);
+  void removeContractInternal(int64_t token);
 
   // Level 1: Token → Index mapping
   QHash<int64_t, int32_t> m_tokenToIndex;
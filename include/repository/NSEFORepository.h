@@ -4,6 +4,7 @@
 #include "ContractData.h"
 #include <QHash>
 #include <QReadWriteLock>
+#include <QSet>
 #include <QString>
 #include <QVector>
 #include <functional>
@@ -85,6 +86,16 @@ public:
    */
   virtual void finalizeLoad();
 
+  /**
+   * @brief Apply a master refresh in place (see MasterDelta)
+   * @param upserts New and changed contracts; a changed one replaces its slot
+   * @param removed Tokens no longer listed in the master
+   *
+   * Ends with finalizeLoad(), so derived indexes are rebuilt.
+   */
+  void applyDelta(const QVector<MasterContract> &upserts,
+                  const QVector<int64_t> &removed);
+
   /**
    * @brief Save contracts to processed CSV file
    * @param filename Path to save CSV file
@@ -232,6 +243,19 @@ private:
    */
   void allocateArrays();
 
+  /**
+   * @brief Clear a contract's slot / spread entry
+   * @param symbol If set, receives the removed regular contract's symbol
+   * @return false if the token was not loaded
+   */
+  bool removeContract(int64_t token, QString *symbol = nullptr);
+
+  /**
+   * @brief Drop symbol map entries with no regular contract left
+   * @param symbols Symbols whose contracts were removed
+   */
+  void dropEmptySymbols(QSet<QString> symbols);
+
   // ===== DATA STORAGE =====
 
   // Validity bitmap (tracks which array slots are filled)
@@ -42,6 +42,16 @@ public:
   bool loadFromContracts(const QVector<MasterContract> &contracts) override;
   void finalizeLoad() override;
 
+  /**
+   * @brief Supply the index order for the next finalizeLoad()
+   * @param orderedTokens Every token, already in index sort order (see
+   *        ContractSnapshot::orderedTokens())
+   *
+   * The next buildIndexes() appends tokens in this order and skips the
+   * comparison sorts; the order is consumed by that call.
+   */
+  void setContractOrder(const QVector<int64_t> &orderedTokens);
+
   // Optimized filtering methods
   QVector<ContractData>
   getContractsBySeries(const QString &series) const override;
@@ -81,6 +91,8 @@ protected:
   virtual void buildIndexes();
 
 private:
+  QVector<int64_t> m_presetOrder; // Consumed by the next buildIndexes()
+
   // Helper to sort token arrays by multi-level key (with date conversion)
   void sortIndexArrays();
 };
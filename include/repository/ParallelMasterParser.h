@@ -0,0 +1,271 @@
+#ifndef PARALLEL_MASTER_PARSER_H
+#define PARALLEL_MASTER_PARSER_H
+
+#include "ContractData.h"
+#include <QByteArray>
+#include <QDate>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QString>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Concurrent interning pool shared by parser threads
+ *
+ * Keys are views into the parser input (the mapped file or download
+ * buffer), which outlives the pool, so the input itself serves as the
+ * arena and nothing is copied to look a key up. A hit costs one hash and a
+ * ref-count increment; a miss builds the value once with make(). Keys are
+ * spread over 16 mutex-guarded shards so threads rarely contend on the
+ * common symbols, series and expiries.
+ */
+template <typename Value> class ConcurrentInternPool {
+public:
+  template <typename Make> Value intern(std::string_view key, Make &&make) {
+    Shard &shard = m_shards[std::hash<std::string_view>{}(key) % kShards];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.values.find(key);
+    if (it == shard.values.end())
+      it = shard.values.emplace(key, make(key)).first;
+    return it->second;
+  }
+
+  int size() const {
+    size_t total = 0;
+    for (const Shard &shard : m_shards) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      total += shard.values.size();
+    }
+    return static_cast<int>(total);
+  }
+
+private:
+  static constexpr size_t kShards = 16;
+  struct Shard {
+    mutable std::mutex mutex;
+    std::unordered_map<std::string_view, Value> values;
+  };
+  std::array<Shard, kShards> m_shards;
+};
+
+/**
+ * @brief Parallel, zero-copy parser for master contract files
+ *
+ * Maps the file (or takes the downloaded buffer), splits it into
+ * newline-aligned chunks and parses every chunk on its own thread. Lines and
+ * fields are std::string_view slices of the input and numbers are read with
+ * std::from_chars, so the only allocations are the QStrings that end up in
+ * the repositories, and low-cardinality fields (symbol, series, expiry...)
+ * are shared through ConcurrentInternPool.
+ *
+ * Used for the downloaded combined master (parseMasterLine(), same field
+ * rules as MasterFileParser) and for the processed CSVs (each repository
+ * supplies its own line function to parseLines()).
+ *
+ * Usage:
+ * ```cpp
+ * ParallelMasterParser parser;
+ * if (!parser.open(path)) return false;
+ * auto chunks = parser.parseLines<Row>(
+ *     [](std::string_view line, std::vector<Row> &out) { ... }, 1);
+ * qDebug() << parser.lastStats().megabytesPerSecond() << "MB/s";
+ * ```
+ */
+class ParallelMasterParser {
+public:
+  struct Stats {
+    qint64 bytes = 0;
+    int lines = 0; // Non-empty lines handed to the line function
+    int threads = 0;
+    qint64 elapsedUs = 0;
+
+    double megabytesPerSecond() const {
+      return elapsedUs > 0 ? (bytes / (1024.0 * 1024.0)) / (elapsedUs / 1e6) : 0.0;
+    }
+  };
+
+  // Interned expiry: DDMMMYYYY text, date and time to expiry, built once per
+  // distinct raw expiry
+  struct Expiry {
+    QString text;
+    QDate date;
+    double timeToExpiry = 0.0;
+  };
+
+  struct Pools {
+    ConcurrentInternPool<QString> strings;
+    ConcurrentInternPool<Expiry> expiries;
+    QDate today = QDate::currentDate();
+  };
+
+  ParallelMasterParser();
+  ~ParallelMasterParser();
+  ParallelMasterParser(const ParallelMasterParser &) = delete;
+  ParallelMasterParser &operator=(const ParallelMasterParser &) = delete;
+
+  /**
+   * @brief Memory-map a file as the parser input
+   */
+  bool open(const QString &path, QString *error = nullptr);
+
+  /**
+   * @brief Use an in-memory buffer (e.g. a fresh download) as the input
+   */
+  void setData(const QByteArray &data);
+
+  void close();
+  std::string_view data() const { return m_data; }
+
+  // Default: hardware threads, at most 8 (the files are a few tens of MB)
+  static int defaultThreadCount();
+
+  void setThreadCount(int threads) { m_threadCount = threads > 0 ? threads : 1; }
+  int threadCount() const { return m_threadCount; }
+
+  // Below this a chunk costs more in thread start-up than it saves
+  static constexpr size_t kMinChunkBytes = 256 * 1024;
+  void setMinChunkBytes(size_t bytes) { m_minChunkBytes = bytes > 0 ? bytes : 1; }
+
+  /**
+   * @brief Parse every non-empty line on up to threadCount() threads
+   * @param lineFn void(std::string_view line, std::vector<Row> &out), called
+   *        concurrently for different chunks; must only touch shared state
+   *        that is thread-safe (the interning pools)
+   * @param skipLines Leading lines to skip (CSV header)
+   * @return One vector per chunk, in file order
+   *
+   * Lines have their trailing '\r' removed.
+   */
+  template <typename Row, typename LineFn>
+  std::vector<std::vector<Row>> parseLines(LineFn lineFn, int skipLines = 0);
+
+  const Stats &lastStats() const { return m_stats; }
+
+  // ===== LINE / FIELD HELPERS =====
+
+  /**
+   * @brief Split data into at most chunkCount pieces, each ending after a
+   *        newline (the last one at the end of data)
+   */
+  static std::vector<std::string_view> splitChunks(std::string_view data,
+                                                   int chunkCount);
+
+  /**
+   * @brief Split a line on delimiter into at most maxFields views
+   * @return Number of fields (fields past maxFields are not split off)
+   */
+  static int splitFields(std::string_view line, char delimiter,
+                         std::string_view *fields, int maxFields);
+
+  // Strip surrounding blanks, then one pair of surrounding quotes
+  static std::string_view trimField(std::string_view field);
+
+  // std::from_chars on the trimmed field; false (out = 0) if not a number
+  static bool toInt64(std::string_view field, int64_t &out);
+  static bool toInt32(std::string_view field, int32_t &out);
+  static bool toDouble(std::string_view field, double &out);
+
+  static int64_t int64Field(std::string_view field);
+  static int32_t int32Field(std::string_view field);
+  static double doubleField(std::string_view field);
+
+  static QString text(std::string_view field);
+  static QString internedText(std::string_view field, Pools &pools);
+
+  /**
+   * @brief Convert a master expiry (ISO "2026-01-27T14:30:00" or
+   *        "20260127") to DDMMMYYYY, date and time to expiry, once per
+   *        distinct value
+   *
+   * Anything else is kept as is with an invalid date.
+   */
+  static Expiry expiry(std::string_view field, Pools &pools);
+
+  /**
+   * @brief Parse one line of the combined master ("NSEFO|..." etc.)
+   * @return false for a blank, unknown-segment or malformed line
+   *
+   * Field rules match MasterFileParser::parseLine().
+   */
+  static bool parseMasterLine(std::string_view line, MasterContract &contract,
+                              Pools &pools);
+
+private:
+  QFile m_file;
+  uchar *m_mapped = nullptr;
+  QByteArray m_buffer;
+  std::string_view m_data;
+  int m_threadCount;
+  size_t m_minChunkBytes = kMinChunkBytes;
+  Stats m_stats;
+};
+
+template <typename Row, typename LineFn>
+std::vector<std::vector<Row>>
+ParallelMasterParser::parseLines(LineFn lineFn, int skipLines) {
+  QElapsedTimer timer;
+  timer.start();
+
+  std::string_view body = m_data;
+  for (int i = 0; i < skipLines && !body.empty(); ++i) {
+    const size_t newline = body.find('\n');
+    body = newline == std::string_view::npos ? std::string_view()
+                                             : body.substr(newline + 1);
+  }
+
+  const int chunkCount = static_cast<int>(std::min<size_t>(
+      static_cast<size_t>(m_threadCount), body.size() / m_minChunkBytes + 1));
+  const std::vector<std::string_view> chunks = splitChunks(body, chunkCount);
+  std::vector<std::vector<Row>> results(chunks.size());
+  std::vector<int> lineCounts(chunks.size(), 0);
+
+  auto parseChunk = [&](size_t index) {
+    const std::string_view chunk = chunks[index];
+    std::vector<Row> &out = results[index];
+    out.reserve(chunk.size() / 128);
+    int lines = 0;
+    size_t pos = 0;
+    while (pos < chunk.size()) {
+      size_t end = chunk.find('\n', pos);
+      if (end == std::string_view::npos)
+        end = chunk.size();
+      std::string_view line = chunk.substr(pos, end - pos);
+      if (!line.empty() && line.back() == '\r')
+        line.remove_suffix(1);
+      if (!line.empty()) {
+        lineFn(line, out);
+        ++lines;
+      }
+      pos = end + 1;
+    }
+    lineCounts[index] = lines;
+  };
+
+  // Chunk 0 on the calling thread
+  std::vector<std::thread> workers;
+  workers.reserve(chunks.size());
+  for (size_t i = 1; i < chunks.size(); ++i)
+    workers.emplace_back(parseChunk, i);
+  if (!chunks.empty())
+    parseChunk(0);
+  for (std::thread &worker : workers)
+    worker.join();
+
+  m_stats = Stats();
+  m_stats.bytes = static_cast<qint64>(m_data.size());
+  m_stats.threads = static_cast<int>(chunks.size());
+  for (int count : lineCounts)
+    m_stats.lines += count;
+  m_stats.elapsedUs = timer.nsecsElapsed() / 1000;
+  return results;
+}
+
+#endif // PARALLEL_MASTER_PARSER_H
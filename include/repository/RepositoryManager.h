@@ -3,9 +3,13 @@
 
 #include "BSECMRepository.h"
 #include "BSEFORepository.h"
+#include "ContractCatalog.h"
 #include "ContractData.h"
+#include "MasterDelta.h"
 #include "NSECMRepository.h"
 #include "NSEFORepository.h"
+#include "search/InstrumentSearchIndex.h"
+#include <QDate>
 #include <QHash>
 #include <QMap>
 #include <QObject>
@@ -13,9 +17,12 @@
 #include <QSet>
 #include <QString>
 #include <QVector>
+#include <atomic>
 #include <memory>
 #include <shared_mutex>
 
+class ParallelMasterParser;
+
 // Forward declare price stores
 namespace nsefo {
 class PriceStore;
@@ -151,6 +158,24 @@ public:
    */
   bool loadFromMemory(const QString &csvData);
 
+  /**
+   * @brief Refresh the loaded masters from a fresh download by applying only
+   *        the rows that changed (see MasterDelta)
+   * @param csvData Downloaded combined master
+   * @param stats Optional: row counts and timings of the refresh
+   * @return false if no delta can be applied: nothing loaded, no row hashes
+   *         for the loaded master, or hashes from another day (time to
+   *         expiry is per day). The caller then does a full loadFromMemory().
+   *
+   * Inserted, removed and modified contracts are applied to the
+   * repositories and the price-store metadata; price rows of unchanged
+   * contracts, and so live data and subscriptions, are left alone. The ATM
+   * catalog and search index are rebuilt from the repositories afterwards,
+   * the catalog only when NSE FO or BSE FO changed.
+   */
+  bool refreshFromMemory(const QString &csvData,
+                         MasterDelta::Stats *stats = nullptr);
+
   /**
    * @brief Save processed CSVs for faster loading
    * @param mastersPath Path to Masters directory
@@ -158,6 +183,36 @@ public:
    */
   bool saveProcessedCSVs(const QString &mastersPath = "Masters");
 
+  // ===== BINARY SNAPSHOT =====
+
+  /**
+   * @brief Path of the memory-mapped contract snapshot
+   * @return <mastersPath>/processed_csv/contract_master.bin
+   */
+  static QString snapshotPath(const QString &mastersPath);
+
+  /**
+   * @brief Populate all four repositories from the binary snapshot
+   * @return false if the snapshot is missing, older than the downloaded
+   *         master files, or fails validation (caller falls back to CSV)
+   *
+   * See ContractSnapshot. loadAll() tries this before the CSV loaders.
+   */
+  bool loadFromSnapshot(const QString &mastersPath);
+
+  /**
+   * @brief Write the loaded repositories to the binary snapshot
+   *
+   * Called by saveProcessedCSVs(), and after a CSV load that found no
+   * usable snapshot.
+   */
+  bool saveSnapshot(const QString &mastersPath);
+
+  /**
+   * @brief True if the last loadAll() was served by the snapshot
+   */
+  bool loadedFromSnapshot() const { return m_loadedFromSnapshot; }
+
   /**
    * @brief Initialize distributed price stores with contract master tokens
    *
@@ -187,6 +242,13 @@ public:
 
   /**
    * @brief Global multi-token search across all segments
+   *
+   * Served from the inverted index built at master load (see
+   * InstrumentSearchIndex): every query word prefix-matches a word of the
+   * symbol, display name, description, token / scrip code, expiry or strike;
+   * strike and CE/PE from SearchTokenizer are pinned. Results are ranked
+   * (exact scrip code, exact symbol, then cash before F&O, nearest expiry).
+   *
    * @param searchText Complex query (e.g., "nifty 26000 ce 27feb")
    * @param exchangeFilter Optional: "NSE", "BSE", or empty for All
    * @param segmentFilter Optional: "CM", "FO", or empty for All
@@ -199,6 +261,25 @@ public:
                                            const QString &expiryFilter = "",
                                            int maxResults = 50) const;
 
+  /**
+   * @brief Incremental global search for a type-ahead box
+   *
+   * Same results as searchScripsGlobal(), but a query that extends the
+   * session's previous one only re-checks that query's matches (see
+   * InstrumentSearchIndex::Session). Safe to call off the GUI thread;
+   * ScripSearchSession wraps it with cancellation and result delivery.
+   *
+   * @param session Candidate cache of one search box (not shared)
+   * @param cancelled Polled while matching; when set, returns empty
+   */
+  QVector<ContractData> searchScripsGlobal(InstrumentSearchIndex::Session *session,
+                                           const QString &searchText,
+                                           const QString &exchangeFilter,
+                                           const QString &segmentFilter,
+                                           const QString &expiryFilter,
+                                           int maxResults,
+                                           const std::atomic_bool *cancelled = nullptr) const;
+
   /**
    * @brief Get all scrips for a segment and series
    * @param exchange Exchange name ("NSE" or "BSE")
@@ -310,7 +391,16 @@ public:
   QString getNearestExpiry(const QVector<QString> &expiryList) const;
   QVector<QString> getExpiriesForSymbol(const QString &symbol) const;
 
-  // ATM Watch Optimization: O(1) lookups for strikes and tokens
+  /**
+   * @brief Integer-keyed NSE FO option chains (see ContractCatalog)
+   *
+   * Take it once per calculation pass and do every symbol / expiry / strike
+   * lookup on it; a master reload publishes a new catalog and leaves the one
+   * held here intact. Never null.
+   */
+  std::shared_ptr<const ContractCatalog> contractCatalog() const;
+
+  // ATM Watch Optimization: lookups for strikes and tokens (ContractCatalog)
   const QVector<double> &getStrikesForSymbolExpiry(const QString &symbol,
                                                    const QString &expiry) const;
   QPair<int64_t, int64_t> getTokensForStrike(const QString &symbol,
@@ -495,21 +585,42 @@ private:
    * Strategy:
    * 1. Iterates through all NSE FO contracts once during startup (in
    * finalizeLoad()).
-   * 2. Populates m_symbolExpiryStrikes: Map of (Symbol|Expiry) -> sorted unique
-   * strikes.
-   * 3. Populates m_strikeToTokens: Map of (Symbol|Expiry|Strike) -> (CallToken,
-   * PutToken).
-   * 4. Populates m_symbolExpiryFutureToken: Map of (Symbol|Expiry) -> Future
-   * Token.
-   * 5. Populates m_symbolToAssetToken: Map of Symbol -> Cash Asset Token.
+   * 2. Builds m_catalog (ContractCatalog): per (Symbol, Expiry) chain of
+   * sorted strikes with parallel CE / PE tokens and the future token, keyed by
+   * interned symbol id and expiry day.
+   * 3. Lists BSE FO option symbols under their expiries in the catalog.
+   * 4. Populates m_symbolToAssetToken: Map of Symbol -> Cash Asset Token.
    *
-   * This pre-computation moves the O(N) filtering cost to startup, enabling
-   * O(1) lookups for real-time ATM Watch calculations and UI rendering. This
-   * keeps the runtime loops extremamente lightweight (sub-microsecond lookups)
-   * even with 100K+ contracts.
+   * This pre-computation moves the O(N) filtering cost to startup; runtime
+   * lookups for ATM Watch and Option Chain are integer binary searches with
+   * no key strings built, even with 100K+ contracts.
    */
   void buildExpiryCache();
 
+  /**
+   * @brief Rebuild the global search index from the loaded repositories
+   */
+  void buildSearchIndex();
+  QVector<ContractData>
+  resolveSearchHits(const QVector<InstrumentSearchIndex::Hit> &hits) const;
+
+  // loadAll() phases 2-5 from processed CSVs / master files
+  bool loadSegmentsFromFiles(const QString &mastersDir);
+
+  // Row hashes for contracts loaded by loadSegmentsFromFiles(), taken from
+  // the combined master the processed CSVs were written from
+  void loadRowHashesFromMaster(const QString &mastersDir);
+
+  // Parse a combined master in parallel and fill all four repositories
+  bool loadCombinedMaster(ParallelMasterParser &parser);
+
+  // refreshFromMemory(): repositories, price stores, then derived caches
+  void applyMasterDelta(const MasterDelta &delta);
+
+  // One price store row: master metadata in, or the row dropped
+  void initializeStoreToken(int exchangeSegmentID, const ContractData &contract);
+  void removeStoreToken(int exchangeSegmentID, int64_t token);
+
   // Singleton instance
   static RepositoryManager *s_instance;
 
@@ -520,13 +631,17 @@ private:
   std::unique_ptr<BSECMRepository> m_bsecm;
 
   bool m_loaded;
+  bool m_loadedFromSnapshot = false;
+
+  // Hashes of the master rows the repositories were loaded from, and the
+  // day they were loaded on (see refreshFromMemory)
+  MasterDelta::RowHashes m_rowHashes;
+  QDate m_rowHashesDate;
 
   // ===== EXPIRY CACHE (ATM Watch Optimization) =====
   // Pre-processed data for fast option symbol and expiry lookups
   // Built once during master load, used by ATM Watch for instant rendering
 
-  QHash<QString, QVector<QString>>
-      m_expiryToSymbols; // "30JAN26" -> ["NIFTY", "BANKNIFTY", ...]
   QHash<QString, QString> m_symbolToCurrentExpiry; // "NIFTY" -> "30JAN26"
   QSet<QString> m_optionSymbols; // {"NIFTY", "BANKNIFTY", "RELIANCE", ...}
   // Cache for sorted expiries to avoid re-sorting on every access
@@ -535,24 +650,23 @@ private:
   // Temporary storage for index contracts before merging
   QVector<ContractData> m_indexContracts;
 
-  // ATM Watch Optimization: Pre-built strike and token caches
-  // Key: "SYMBOL|EXPIRY" -> sorted list of strikes
-  QHash<QString, QVector<double>> m_symbolExpiryStrikes;
-  // Key: "SYMBOL|EXPIRY|STRIKE" -> (CE token, PE token)
-  QHash<QString, QPair<int64_t, int64_t>> m_strikeToTokens;
+  // ATM Watch Optimization: NSE FO chains (strikes, CE/PE and future tokens)
+  // and the expiry -> option symbols listing. Replaced, never mutated.
+  std::shared_ptr<const ContractCatalog> m_catalog;
   // Symbol -> asset token (for cash price lookup)
   QHash<QString, int64_t> m_symbolToAssetToken;
   // Index Name -> Token (Loaded from nse_cm_index_master.csv)
   QHash<QString, qint64> m_indexNameTokenMap;
   // Reverse: Token -> Index Name (for fast XTS tick -> IndexTick conversion)
   QHash<uint32_t, QString> m_indexTokenNameMap;
-  // Key: "SYMBOL|EXPIRY" -> future token (for future price lookup when cash not
-  // available)
-  QHash<QString, int64_t> m_symbolExpiryFutureToken;
   // Key: Future Token -> Symbol (Reverse mapping)
   QHash<int64_t, QString> m_futureTokenToSymbol;
   // Mutex for reader-writer locking of key caches
   mutable std::shared_mutex m_expiryCacheMutex;
+
+  // ===== SEARCH INDEX =====
+  InstrumentSearchIndex m_searchIndex;
+  mutable std::shared_mutex m_searchIndexMutex;
 };
 
 #endif // REPOSITORY_MANAGER_H
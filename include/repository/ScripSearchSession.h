@@ -0,0 +1,99 @@
+#ifndef SCRIP_SEARCH_SESSION_H
+#define SCRIP_SEARCH_SESSION_H
+
+#include "ContractData.h"
+#include "search/InstrumentSearchIndex.h"
+#include <QFutureWatcher>
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <memory>
+
+/**
+ * @brief Type-ahead search state for one search box
+ *
+ * Call search() on every keystroke. Queries run on the global thread pool
+ * through RepositoryManager::searchScripsGlobal(session, ...), so the GUI
+ * thread never waits on the index while it is busy with ticks; the result is
+ * delivered back on the session's thread through resultsReady().
+ *
+ * The session keeps the match set of its last query, so typing on
+ * ("NIFTY 2" -> "NIFTY 24" -> "NIFTY 245") narrows that set instead of
+ * searching the whole index again.
+ *
+ * At most one query runs at a time. A new keystroke cancels the running
+ * query and replaces any queued one; only the latest query's results are
+ * emitted.
+ *
+ * Usage:
+ * @code
+ * m_search = new ScripSearchSession(this);
+ * connect(m_search, &ScripSearchSession::resultsReady, this, &X::showResults);
+ * connect(edit, &QLineEdit::textChanged, [this](const QString &text) {
+ *   m_search->search(text, "", "", "", 100);
+ * });
+ * @endcode
+ */
+class ScripSearchSession : public QObject {
+  Q_OBJECT
+
+public:
+  explicit ScripSearchSession(QObject *parent = nullptr);
+  ~ScripSearchSession() override;
+
+  /**
+   * @brief Start (or queue) a query; supersedes every earlier one
+   * @return Generation of this query, as passed to resultsReady()
+   */
+  quint64 search(const QString &text, const QString &exchangeFilter = "",
+                 const QString &segmentFilter = "",
+                 const QString &expiryFilter = "", int maxResults = 50);
+
+  /**
+   * @brief Drop the running and queued queries without emitting
+   */
+  void cancel();
+
+  bool isBusy() const { return m_watcher.isRunning(); }
+  quint64 generation() const { return m_generation; }
+
+signals:
+  /**
+   * @brief Results of the latest query (never of a superseded one)
+   */
+  void resultsReady(quint64 generation, const QString &text,
+                    const QVector<ContractData> &results);
+
+private slots:
+  void onQueryFinished();
+
+private:
+  struct Query {
+    quint64 generation = 0;
+    QString text;
+    QString exchangeFilter;
+    QString segmentFilter;
+    QString expiryFilter;
+    int maxResults = 50;
+  };
+
+  struct Result {
+    quint64 generation = 0;
+    QString text;
+    QVector<ContractData> contracts;
+  };
+
+  void start(const Query &query);
+
+  // Only touched by the running query
+  InstrumentSearchIndex::Session m_session;
+
+  QFutureWatcher<Result> m_watcher;
+  std::shared_ptr<std::atomic_bool> m_cancelled;
+  Query m_pending;
+  bool m_hasPending = false;
+  quint64 m_generation = 0;
+};
+
+#endif // SCRIP_SEARCH_SESSION_H
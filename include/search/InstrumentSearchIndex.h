@@ -0,0 +1,199 @@
+#pragma once
+
+#include "repository/ContractData.h"
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+/**
+ * @brief Inverted index over the contract universe for type-ahead search
+ *
+ * Built once per master load, queried on every keystroke. Every contract is a
+ * document; its terms are the uppercased words of symbol, display name and
+ * description, the token and BSE scrip code, the expiry (27FEB2026, FEB2026,
+ * 27, FEB, 2026, 26), the strike ("23000.00") and CE/PE.
+ *
+ * Terms are kept in one sorted dictionary, so every term sharing a prefix
+ * occupies a contiguous id range (a flattened prefix trie). A query word
+ * matches a document when one of the document's term ids falls in the
+ * word's range, i.e. a prefix match on any word of any field. Strike and
+ * expiry also have sorted numeric side indexes for the fields that
+ * SearchTokenizer::parse() pins.
+ *
+ * Documents are numbered in rank order (segment in add order, then symbol,
+ * expiry, strike, option type), so scanning candidates by id yields
+ * results already ranked and can stop at maxResults. Exact scrip code and
+ * exact symbol matches are returned ahead of the rest.
+ *
+ * A Session keeps the full match set of the previous query, so a query
+ * that only extends it ("NIFTY 2" -> "NIFTY 24") is answered by re-checking
+ * that set instead of the whole index.
+ *
+ * Not thread-safe for build; search() is const and can run concurrently.
+ */
+class InstrumentSearchIndex {
+public:
+    struct Hit {
+        int exchangeSegment = 0;
+        int64_t token = 0;
+    };
+
+    // Bits for the segment mask passed to search()
+    enum SegmentMask {
+        NSECM = 1 << 0,
+        NSEFO = 1 << 1,
+        BSECM = 1 << 2,
+        BSEFO = 1 << 3,
+        AllSegments = NSECM | NSEFO | BSECM | BSEFO
+    };
+    static int segmentBit(int exchangeSegment);
+
+    /**
+     * @brief Mask for a UI exchange / segment filter
+     *
+     * Empty or "ALL" means both; "STOCK(S)" is CM, "OPTIONS" / "FUTURES" FO.
+     */
+    static int segmentMask(const QString &exchangeFilter, const QString &segmentFilter);
+
+    /**
+     * @brief Match set of the last query of a type-ahead box
+     *
+     * Opaque to callers. Owned by one box and used by one thread at a time;
+     * it stays valid across index rebuilds (a rebuilt index starts afresh).
+     */
+    class Session {
+    public:
+        void reset();
+        bool isValid() const { return m_valid; }
+        int candidateCount() const { return m_matches.size(); }
+        // Whether the last search was answered from the previous match set
+        bool wasRefined() const { return m_refined; }
+
+    private:
+        friend class InstrumentSearchIndex;
+        quint64 m_indexId = 0;
+        bool m_valid = false;
+        bool m_refined = false;
+        bool m_hadCode = false;      // Matches may include exact code hits
+        int m_segmentMask = 0;
+        QString m_expiryFilter;
+        double m_strike = 0.0;
+        int m_optionType = 0;
+        int m_expiryFrom = 0;
+        int m_expiryTo = 0;
+        QStringList m_tokens;
+        QVector<bool> m_wordTokens;  // Per token, whether it had to match a term
+        QVector<int> m_matches;      // Every matching doc id, ascending
+    };
+
+    // Larger match sets are not kept; the next keystroke searches afresh
+    static constexpr int kMaxSessionMatches = 20000;
+
+    void clear();
+
+    /**
+     * @brief Add a contract; segments added first rank first
+     */
+    void add(int exchangeSegment, const ContractData &contract);
+
+    /**
+     * @brief Sort documents into rank order and build dictionary, postings and
+     *        side indexes. Call once after the last add().
+     */
+    void finalize();
+
+    bool isEmpty() const { return m_docs.isEmpty(); }
+    int size() const { return m_docs.size(); }
+    int termCount() const { return m_terms.size(); }
+
+    /**
+     * @brief Ranked top-K search
+     * @param text Free-form query ("nifty 26000 ce 27feb", "reliance", "500325")
+     * @param segmentMask SegmentMask bits to search
+     * @param expiryFilter Exact DDMMMYYYY expiry, or empty
+     * @param maxResults K
+     */
+    QVector<Hit> search(const QString &text, int segmentMask = AllSegments,
+                        const QString &expiryFilter = QString(),
+                        int maxResults = 50) const;
+
+    /**
+     * @brief Incremental search for a type-ahead box
+     *
+     * Same results as search(). When the query extends the session's last
+     * one (same filters, every earlier token a prefix of the token typed at
+     * its position, no pinned field loosened) only the previous match set is
+     * re-checked; otherwise the full match set is gathered from the index.
+     *
+     * @param session Updated with this query's match set
+     * @param cancelled Polled while matching; when set, returns empty and
+     *        leaves the session untouched
+     */
+    QVector<Hit> search(Session *session, const QString &text,
+                        int segmentMask = AllSegments,
+                        const QString &expiryFilter = QString(), int maxResults = 50,
+                        const std::atomic_bool *cancelled = nullptr) const;
+
+    // Words a field is split into (uppercased, on blanks and - _ / , ( ))
+    static QStringList words(const QString &field);
+
+private:
+    struct Doc {
+        int64_t token = 0;
+        double strike = 0.0;
+        int expiryDay = 0;      // Julian day, 0 if none
+        int nameTerm = -1;      // Term id of the full symbol
+        int expiryId = -1;      // Index into m_expiries
+        int termBegin = 0;      // Range in m_docTerms
+        int termEnd = 0;
+        int8_t segment = 0;     // Exchange segment id
+        int8_t optionType = 0;  // 3 = CE, 4 = PE
+        int8_t group = 0;       // Add order of the segment (rank)
+    };
+
+    struct TermRange {
+        int begin = 0;
+        int end = 0;
+        bool isEmpty() const { return begin >= end; }
+    };
+
+    struct Plan;
+
+    void makePlan(const QString &text, int segmentMask, const QString &expiryFilter,
+                  Plan *plan) const;
+    TermRange prefixRange(const QString &prefix) const;
+    int exactTerm(const QString &term) const;
+    int postingCount(const TermRange &range) const;
+    bool docHasTerm(const Doc &doc, const TermRange &range) const;
+    bool matches(const Doc &doc, const Plan &plan) const;
+    bool isCodeDoc(const Doc &doc, const Plan &plan) const;
+    bool candidates(const Plan &plan, QVector<quint64> *bitmap) const;
+    bool refines(const Session &session, const Plan &plan) const;
+    bool gather(const Plan &plan, const std::atomic_bool *cancelled, QVector<int> *docs) const;
+    QVector<Hit> rank(const Plan &plan, const QVector<int> &docs, int maxResults) const;
+
+    static int expiryDay(const QString &expiry);
+
+    int internTerm(const QString &term);
+
+    // Build state, released by finalize()
+    QHash<QString, int> m_termIds;
+    QHash<QString, int> m_expiryIds;
+    QVector<int> m_groupOfSegment;
+
+    quint64 m_id = 0;                // Distinct per finalize(), for sessions
+    QVector<Doc> m_docs;
+    QStringList m_terms;             // Sorted (after finalize)
+    QVector<int> m_docTerms;         // Per doc, its term ids
+    QVector<int> m_postingOffsets;   // Per term, range in m_postings
+    QVector<int> m_postings;         // Doc ids, ascending per term
+    QStringList m_expiries;          // Distinct DDMMMYYYY strings
+
+    // Numeric side indexes, sorted by value then doc id
+    QVector<std::pair<double, int>> m_strikeIndex;
+    QVector<std::pair<int, int>> m_expiryIndex;
+};
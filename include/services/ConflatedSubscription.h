@@ -0,0 +1,100 @@
+#ifndef CONFLATEDSUBSCRIPTION_H
+#define CONFLATEDSUBSCRIPTION_H
+
+#include <QObject>
+#include <QTimer>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "services/FeedDispatcher.h"
+
+/**
+ * @brief Latest-value subscription over a token set, delivered in batches
+ *
+ * For views that only ever show the current state (positions, ATM watch):
+ * instead of one callback per tick, ticks for the watched keys are folded
+ * into a "latest tick per key" table on the publishing thread, and a timer
+ * on the owner's thread hands over the changed keys at most maxRateHz times
+ * per second:
+ *
+ * - one callback per interval, only if something changed
+ * - the batch holds each changed key once, with its most recent tick
+ *   (of the subscribed update types), in first-changed order
+ * - keys that did not tick since the last batch are not in it
+ *
+ * The object lives on (and calls back on) the thread of its parent. Deleting
+ * it, or removing a key, stops delivery for it; pending values of a removed
+ * key are dropped.
+ *
+ * Thread safety: the key set and rate are owner-thread only; ticks may
+ * arrive on any thread.
+ */
+class ConflatedSubscription : public QObject {
+    Q_OBJECT
+
+public:
+    using BatchCallback = std::function<void(const std::vector<UDP::MarketTick>&)>;
+    // Called once per newly added key (FeedHandler: enable it at the feed sources)
+    using KeyRegistrar = std::function<void(int64_t key)>;
+
+    /**
+     * @param maxRateHz Upper bound on callbacks per second (clamped to 1..1000)
+     * @param typeMask FeedDispatcher::UpdateMask bits that count as a change
+     */
+    ConflatedSubscription(FeedDispatcher& dispatcher, int maxRateHz,
+                          BatchCallback callback,
+                          uint32_t typeMask = FeedDispatcher::AllUpdates,
+                          KeyRegistrar registrar = {}, QObject* parent = nullptr);
+    ~ConflatedSubscription() override;
+
+    // ========== Key set (composite keys, see FeedHandler::makeKey) ==========
+
+    void setKeys(const std::vector<int64_t>& keys);
+    void addKey(int64_t key);
+    void removeKey(int64_t key);
+    void clearKeys();
+    bool containsKey(int64_t key) const { return m_subscriptions.count(key) != 0; }
+    size_t keyCount() const { return m_subscriptions.size(); }
+
+    // ========== Rate ==========
+
+    void setMaxRate(int maxRateHz);
+    int intervalMs() const { return m_timer.interval(); }
+
+    /**
+     * @brief Deliver whatever is pending now (no callback if nothing is)
+     * Also what the timer calls each interval.
+     */
+    void flush();
+
+    // ========== Monitoring ==========
+
+    uint64_t ticksReceived() const { return m_state->ticks.load(std::memory_order_relaxed); }
+    uint64_t batchesDelivered() const { return m_batches; }
+
+private:
+    // Shared with the per-key dispatcher callbacks (publishing thread)
+    struct State {
+        std::mutex mutex;
+        std::unordered_map<int64_t, size_t> slot; // key → index in latest
+        std::vector<UDP::MarketTick> latest;
+        std::atomic<uint64_t> ticks{0};
+    };
+
+    void updateTimer();
+
+    FeedDispatcher& m_dispatcher;
+    BatchCallback m_callback;
+    uint32_t m_typeMask;
+    KeyRegistrar m_registrar;
+    std::shared_ptr<State> m_state;
+    std::unordered_map<int64_t, FeedDispatcher::Subscription> m_subscriptions;
+    QTimer m_timer;
+    uint64_t m_batches = 0;
+};
+
+#endif // CONFLATEDSUBSCRIPTION_H
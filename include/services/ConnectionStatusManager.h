@@ -89,6 +89,12 @@ struct ConnectionInfo {
     double          packetsPerSec  = 0; // Rolling average (1-second window)
     double          latencyMs      = 0; // Estimated latency (if measurable)
 
+    // NSE broadcast bcSeqNo accounting (UDP_NSEFO / UDP_NSECM only)
+    uint64_t        seqGaps        = 0; // Holes detected across all streams
+    uint64_t        seqLost        = 0; // Skipped messages that never arrived
+    uint64_t        seqMaxGap      = 0; // Largest single hole
+    uint64_t        seqOutOfOrder  = 0; // Late arrivals (incl. hole fills)
+
     // Derived convenience
     bool isConnected() const { return state == ConnectionState::Connected; }
     bool isUDP()       const {
@@ -0,0 +1,206 @@
+#ifndef FEEDDISPATCHER_H
+#define FEEDDISPATCHER_H
+
+#include <QObject>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "udp/UDPTypes.h"
+
+/**
+ * @brief Native tick fan-out: (segment, token) → plain callbacks
+ *
+ * Replaces one TokenPublisher QObject + one Qt connection per subscription.
+ * Each key maps to a flat vector of subscribers; publish() looks the key up
+ * once, filters by update-type mask and calls each callback:
+ *
+ * - context == nullptr: called on the publishing (IO/parse) thread.
+ * - context on the publishing thread: called directly.
+ * - context on another thread: queued to that thread's event loop, the
+ *   same hop Qt::AutoConnection made. Dropped if the subscription is gone
+ *   by the time it runs, or if the context object was destroyed.
+ *
+ * Subscriber lists are copy-on-write and published through atomic
+ * shared_ptrs, one per hash bucket of keys: publish() takes no lock, so any
+ * number of publisher threads (shard workers, FeedHandler) fan out in
+ * parallel. subscribe / unsubscribe serialise on a writer-only mutex, copy
+ * one bucket and swap it in.
+ *
+ * No lock is held while a callback runs, so callbacks may subscribe or
+ * unsubscribe freely, including their own subscription. Once unsubscribe
+ * returns, no new call or post for that subscription is started: publishers
+ * count themselves in flight before checking the subscription is active,
+ * and unsubscribe clears the flag, then waits out the calls already running
+ * on other threads (a queued call already in the receiver's event loop is
+ * discarded when it runs). So do not unsubscribe while holding a lock that
+ * the subscription's callback takes. Called from inside a callback,
+ * unsubscribe only stops new calls: waiting there could cycle with a
+ * callback on another publisher thread that is unsubscribing in turn.
+ *
+ * Thread safety: every method may be called from any thread.
+ */
+class FeedDispatcher {
+public:
+    using TickCallback = std::function<void(const UDP::MarketTick&)>;
+
+    // Update-type filter bits (one per UDP::UpdateType)
+    enum UpdateMask : uint32_t {
+        TradeUpdates       = 1u << static_cast<int>(UDP::UpdateType::TRADE_TICK),
+        DepthUpdates       = 1u << static_cast<int>(UDP::UpdateType::DEPTH_UPDATE),
+        TouchlineUpdates   = 1u << static_cast<int>(UDP::UpdateType::TOUCHLINE),
+        MarketWatchUpdates = 1u << static_cast<int>(UDP::UpdateType::MARKET_WATCH),
+        OiUpdates          = 1u << static_cast<int>(UDP::UpdateType::OI_CHANGE),
+        SnapshotUpdates    = 1u << static_cast<int>(UDP::UpdateType::FULL_SNAPSHOT),
+        CircuitUpdates     = 1u << static_cast<int>(UDP::UpdateType::CIRCUIT_LIMIT),
+        OtherUpdates       = 1u << 31, // UNKNOWN and future types
+        AllUpdates         = 0xFFFFFFFFu
+    };
+
+    static uint32_t maskFor(UDP::UpdateType type) {
+        const int bit = static_cast<int>(type);
+        return bit < 31 ? (1u << bit) : OtherUpdates;
+    }
+
+private:
+    struct Subscriber {
+        int64_t key = 0;
+        QObject* context = nullptr;
+        TickCallback callback;
+        uint32_t typeMask = AllUpdates;
+        std::atomic<bool> active{true};
+        // Publishers between their 'active' check and the end of the call /
+        // post; deactivate() waits for it to drain
+        std::atomic<uint32_t> inFlight{0};
+    };
+    using SubscriberPtr = std::shared_ptr<Subscriber>;
+    using SubscriberList = std::vector<SubscriberPtr>;
+    using ListPtr = std::shared_ptr<const SubscriberList>;
+
+    // Keys hashing to one bucket, with their (never empty) lists
+    using Bucket = std::vector<std::pair<int64_t, ListPtr>>;
+    using BucketPtr = std::shared_ptr<const Bucket>;
+
+public:
+    /**
+     * @brief RAII subscription handle (move-only)
+     *
+     * Unsubscribes when destroyed or reset(). release() detaches the handle
+     * and leaves the subscription to unsubscribe(key, context) /
+     * unsubscribeAll(context).
+     */
+    class Subscription {
+    public:
+        Subscription() = default;
+        ~Subscription() { reset(); }
+        Subscription(Subscription&& other) noexcept
+            : m_dispatcher(other.m_dispatcher), m_sub(std::move(other.m_sub)) {
+            other.m_dispatcher = nullptr;
+        }
+        Subscription& operator=(Subscription&& other) noexcept {
+            if (this != &other) {
+                reset();
+                m_dispatcher = other.m_dispatcher;
+                m_sub = std::move(other.m_sub);
+                other.m_dispatcher = nullptr;
+            }
+            return *this;
+        }
+        Subscription(const Subscription&) = delete;
+        Subscription& operator=(const Subscription&) = delete;
+
+        bool isActive() const { return m_sub && m_sub->active.load(std::memory_order_acquire); }
+        void reset();
+        void release() { m_dispatcher = nullptr; m_sub.reset(); }
+
+    private:
+        friend class FeedDispatcher;
+        Subscription(FeedDispatcher* dispatcher, SubscriberPtr sub)
+            : m_dispatcher(dispatcher), m_sub(std::move(sub)) {}
+
+        FeedDispatcher* m_dispatcher = nullptr;
+        SubscriberPtr m_sub;
+    };
+
+    // Key for subscribeAll(): matches every tick (no real instrument is 0:0)
+    static constexpr int64_t kAllTokens = 0;
+
+    FeedDispatcher();
+    FeedDispatcher(const FeedDispatcher&) = delete;
+    FeedDispatcher& operator=(const FeedDispatcher&) = delete;
+
+    /**
+     * @brief Subscribe a callback to one composite key
+     * @param key (segment << 32) | token, see FeedHandler::makeKey
+     * @param context Thread/lifetime anchor (nullptr = publishing thread)
+     * @param typeMask UpdateMask bits this subscriber wants
+     */
+    [[nodiscard]] Subscription subscribe(int64_t key, QObject* context,
+                                         TickCallback callback,
+                                         uint32_t typeMask = AllUpdates);
+
+    // Every tick of the given types, whatever the token
+    [[nodiscard]] Subscription subscribeAll(QObject* context, TickCallback callback,
+                                            uint32_t typeMask) {
+        return subscribe(kAllTokens, context, std::move(callback), typeMask);
+    }
+
+    // Drop every subscription of context on key / on all keys
+    void unsubscribe(int64_t key, const QObject* context);
+    void unsubscribeAll(const QObject* context);
+
+    /**
+     * @brief Snapshot of the subscribers one key would reach
+     *
+     * Lets the caller skip work (copying/stamping the tick) when nobody
+     * listens, without a second lookup.
+     */
+    class Route {
+    public:
+        bool empty() const { return !m_subscribers && !m_allTokens; }
+        // @return Number of subscribers called or queued
+        size_t deliver(const UDP::MarketTick& tick) const;
+
+    private:
+        friend class FeedDispatcher;
+        ListPtr m_subscribers;
+        ListPtr m_allTokens;
+    };
+
+    Route route(int64_t key) const;
+
+    // route(key of tick).deliver(tick)
+    size_t publish(const UDP::MarketTick& tick);
+
+    // Whether any subscriber would see a tick for key (excludes subscribeAll)
+    bool hasSubscribers(int64_t key) const;
+    size_t subscriberCount() const;
+
+private:
+    static constexpr size_t kBuckets = 1024;
+
+    static size_t bucketOf(int64_t key) {
+        return static_cast<size_t>(key ^ (key >> 32)) & (kBuckets - 1);
+    }
+
+    ListPtr find(int64_t key) const;
+    // Caller holds m_mutex. Replace key's list (nullptr = drop the key)
+    void store(int64_t key, ListPtr list);
+    // Caller holds m_mutex. Move subscribers matching pred out of key's list
+    template <typename Pred>
+    void strip(int64_t key, const ListPtr& list, Pred&& pred, SubscriberList& removed);
+
+    void remove(const SubscriberPtr& sub);
+    static void deactivate(const SubscriberPtr& sub);
+    static void deliver(const SubscriberPtr& sub, const UDP::MarketTick& tick);
+
+    std::mutex m_mutex;                                 // Writers only
+    std::unique_ptr<std::atomic<BucketPtr>[]> m_buckets; // kBuckets
+    std::atomic<ListPtr> m_allTokens;                   // subscribeAll() subscribers
+    std::atomic<size_t> m_count{0};
+};
+
+#endif // FEEDDISPATCHER_H
@@ -7,51 +7,41 @@
 #include <vector>
 #include <mutex>
 #include <memory>
+#include <type_traits>
+#include <unordered_set>
 #include "api/xts/XTSTypes.h"
+#include "services/ConflatedSubscription.h"
+#include "services/FeedDispatcher.h"
 #include "udp/UDPTypes.h"
 
-/**
- * @brief Helper object that emits signals for a specific token
- */
-class TokenPublisher : public QObject {
-    Q_OBJECT
-public:
-    explicit TokenPublisher(int64_t compositeKey, QObject* parent = nullptr) 
-        : QObject(parent), m_compositeKey(compositeKey) {}
-    void publish(const UDP::MarketTick& tick) { emit udpTickUpdated(tick); }
-    int64_t compositeKey() const { return m_compositeKey; }
-
-signals:
-    void udpTickUpdated(const UDP::MarketTick& tick);  // New UDP-specific
-
-private:
-    int64_t m_compositeKey;
-};
-
 /**
  * @brief Centralized feed handler for real-time market data distribution
  * 
  * Implements publisher-subscriber pattern with direct callbacks for minimal latency.
  * Uses composite key (exchangeSegment, token) to handle multi-exchange environments.
- * 
- * Performance:
- * - Subscribe: ~500ns (add to hash map)
- * - Unsubscribe: ~800ns (remove from map)
- * - Publish (1 subscriber): ~70ns (hash lookup + callback)
- * - Publish (10 subscribers): ~250ns (10 parallel callbacks)
+ * Fan-out goes through a FeedDispatcher (flat per-key callback lists, no
+ * per-token QObject and no Qt signal on the tick path).
  * 
  * Thread Safety:
- * - Callbacks execute on publisher thread (IO thread)
- * - Use QMetaObject::invokeMethod for UI thread marshalling if needed
- * - std::mutex protects subscription map
+ * - Callbacks run on the receiver's thread: directly when the tick is
+ *   published there, otherwise queued to its event loop (as AutoConnection)
+ * - subscribeCallback(..., nullptr, ...) runs on the publisher thread (IO thread)
+ * - Receivers are unsubscribed automatically when destroyed
  * 
  * Usage:
  * ```cpp
  * // Subscribe to token updates (exchange-aware)
  * FeedHandler::instance().subscribe(2, 49508, this, &MyWindow::onTickUpdate);
  * 
- * // Legacy subscribe (assumes exchangeSegment from context)
- * FeedHandler::instance().subscribe(49508, this, &MyWindow::onTickUpdate);
+ * // Native subscription: RAII handle, only trade ticks
+ * m_sub = FeedHandler::instance().subscribeCallback(
+ *     2, 49508, this, [this](const UDP::MarketTick& t) { onTrade(t); },
+ *     FeedDispatcher::TradeUpdates);
+ *
+ * // Latest-value view: at most 4 batches/s, only the keys that changed
+ * auto* conflated = FeedHandler::instance().subscribeConflated(
+ *     this, {FeedHandler::makeKey(2, 49508)}, 4,
+ *     [this](const std::vector<UDP::MarketTick>& changed) { onBatch(changed); });
  * ```
  */
 class FeedHandler : public QObject {
@@ -82,14 +72,15 @@ public:
      */
     template<typename Receiver, typename Slot>
     void subscribe(int exchangeSegment, int token, Receiver* receiver, Slot slot) {
-        int64_t key = makeKey(exchangeSegment, token);
-        std::lock_guard<std::mutex> lock(m_mutex);
-        TokenPublisher* pub = getOrCreatePublisher(key);
-        connect(pub, &TokenPublisher::udpTickUpdated, receiver, slot);
-        
-        // Notify UDP service to enable filtering for this token
-        registerTokenWithUdpService(token, exchangeSegment);
-        emit subscriptionCountChanged(token, 1);
+        FeedDispatcher::TickCallback callback;
+        if constexpr (std::is_member_function_pointer_v<Slot>) {
+            callback = [receiver, slot](const UDP::MarketTick& tick) { (receiver->*slot)(tick); };
+        } else {
+            callback = [slot](const UDP::MarketTick& tick) { slot(tick); };
+        }
+        watchReceiver(receiver);
+        // Lives until unsubscribe()/unsubscribeAll() or the receiver's destruction
+        subscribeCallback(exchangeSegment, token, receiver, std::move(callback)).release();
     }
     
     template<typename Receiver, typename Slot>
@@ -101,13 +92,49 @@ public:
      * @brief Subscribe without callback (just to ensure data is cached in price store)
      */
     void subscribe(int exchangeSegment, int token) {
-        int64_t key = makeKey(exchangeSegment, token);
-        std::lock_guard<std::mutex> lock(m_mutex);
-        getOrCreatePublisher(key);
-        registerTokenWithUdpService(token, exchangeSegment);
-        emit subscriptionCountChanged(token, 1);
+        registerKey(exchangeSegment, token);
     }
 
+    /**
+     * @brief Subscribe a plain callback (native path)
+     * @param context Thread the callback runs on (nullptr = publisher thread).
+     *        The caller keeps the handle; dropping it unsubscribes.
+     * @param typeMask FeedDispatcher::UpdateMask bits to receive
+     */
+    [[nodiscard]] FeedDispatcher::Subscription subscribeCallback(
+        int exchangeSegment, int token, QObject* context,
+        FeedDispatcher::TickCallback callback,
+        uint32_t typeMask = FeedDispatcher::AllUpdates) {
+        registerKey(exchangeSegment, token);
+        return m_dispatcher.subscribe(makeKey(exchangeSegment, token), context,
+                                      std::move(callback), typeMask);
+    }
+
+    /**
+     * @brief Every tick of the given update types, whatever the token
+     * (replaces the old depth/trade/touchline/marketWatch broadcast signals)
+     */
+    [[nodiscard]] FeedDispatcher::Subscription subscribeAllTokens(
+        QObject* context, FeedDispatcher::TickCallback callback, uint32_t typeMask) {
+        return m_dispatcher.subscribeAll(context, std::move(callback), typeMask);
+    }
+
+    /**
+     * @brief Conflated (latest-value) subscription for slow-changing views
+     * @param context Owner: the callback runs on its thread and the
+     *        subscription is deleted with it (or delete it to unsubscribe)
+     * @param keys Composite keys (makeKey); more can be added later
+     * @param maxRateHz At most this many callbacks per second
+     * @param callback Receives only the keys that changed, latest tick each
+     * @param typeMask FeedDispatcher::UpdateMask bits that count as a change
+     */
+    ConflatedSubscription* subscribeConflated(
+        QObject* context, const std::vector<int64_t>& keys, int maxRateHz,
+        ConflatedSubscription::BatchCallback callback,
+        uint32_t typeMask = FeedDispatcher::AllUpdates);
+
+    FeedDispatcher& dispatcher() { return m_dispatcher; }
+
     /**
      * @brief Unsubscribe with exchange segment
      */
@@ -130,7 +157,7 @@ public:
     void onUdpTickReceived(const UDP::MarketTick& tick);
 
     /**
-     * @brief Get number of active publishers (monitoring)
+     * @brief Get number of subscribed (segment, token) keys (monitoring)
      */
     size_t totalSubscriptions() const;
 
@@ -151,15 +178,6 @@ public:
 signals:
     void subscriptionCountChanged(int token, size_t count);
     
-    /**
-     * @brief Type-specific UDP tick signals for granular UI optimization
-     * These allow UI components to subscribe only to relevant event types
-     */
-    void depthUpdateReceived(const UDP::MarketTick& tick);      // Order book depth only (7208)
-    void tradeUpdateReceived(const UDP::MarketTick& tick);      // LTP, volume, OI changes (7202, 17202)
-    void touchlineUpdateReceived(const UDP::MarketTick& tick);  // BBO + basic stats (7200)
-    void marketWatchReceived(const UDP::MarketTick& tick);      // Comprehensive data (7201, 17201)
-    
     /**
      * @brief Request price subscription from new PriceCache (zero-copy)
      * Emitted by subscribers (MarketWatch, OptionChain) to request subscription
@@ -180,10 +198,16 @@ private:
 
     void registerTokenWithUdpService(uint32_t token, int segment);
 
-    TokenPublisher* getOrCreatePublisher(int64_t compositeKey);
+    // Record the key as active and enable it at the feed sources
+    void registerKey(int exchangeSegment, int token);
+    // Drop a receiver's subscriptions when it is destroyed (once per receiver)
+    void watchReceiver(QObject* receiver);
+
+    FeedDispatcher m_dispatcher;
 
-    // CompositeKey -> Publisher
-    std::unordered_map<int64_t, TokenPublisher*> m_publishers;
+    // Keys ever subscribed (kept after unsubscribe, as the feed filters are)
+    std::unordered_set<int64_t> m_activeKeys;
+    std::unordered_set<const QObject*> m_watchedReceivers;
     mutable std::mutex m_mutex;
 };
 
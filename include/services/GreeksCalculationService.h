@@ -323,6 +323,13 @@ private:
         int64_t lastTradeTimestamp = 0;  // Last time Option Price (LTP) changed
         double lastPrice = 0.0;
         double lastUnderlyingPrice = 0.0;
+
+        // Price store row versions behind the result (0 = not tracked):
+        // the illiquid sweep skips entries whose rows have not moved
+        uint64_t optionVersion = 0;
+        int underlyingSegment = 0;
+        uint32_t underlyingToken = 0;
+        uint64_t underlyingVersion = 0;
     };
     
     GreeksConfig m_config;
@@ -2,13 +2,16 @@
 #define UDPBROADCASTSERVICE_H
 
 #include <QObject>
+#include <array>
 #include <memory>
 #include <atomic>
 #include <string>
 #include <vector>
 #include <thread>
+#include <unordered_map>
 #include <unordered_set>
 #include <shared_mutex>
+#include <mutex>
 
 // Exchange-specific headers
 #include "multicast_receiver.h"        // NSE FO
@@ -18,6 +21,9 @@
 #include "api/xts/XTSTypes.h"
 #include "udp/UDPTypes.h"
 #include "core/ExchangeSegment.h"
+#include "utils/SpscRing.h"
+
+class QTimer;
 
 /**
  * @brief DEPRECATED — Use ::ExchangeSegment from "core/ExchangeSegment.h" directly.
@@ -49,6 +55,36 @@ public:
         bool enableNSECM = true;
         bool enableBSEFO = true;
         bool enableBSECM = true;
+
+        // Linux recvmmsg() ingest: datagrams pulled per syscall, with kernel
+        // receive timestamps. Ignored (plain recv()) on other platforms.
+        bool batchedIngest = false;
+        int ingestBatchSize = 64;
+
+        // Receiver threads hand MarketTicks to the GUI thread through one
+        // SPSC ring per segment; a timer drains them every pumpIntervalMs,
+        // keeping only the latest tick per token. false = publish on the
+        // receiver thread (FeedHandler call + queued udpTickReceived).
+        bool mainThreadPump = true;
+        int pumpIntervalMs = 16;        // ~one 60 Hz frame
+        int tickRingCapacity = 8192;    // Ticks per segment ring
+
+        // Non-empty: every raw datagram is appended to
+        // <captureDir>/<SEGMENT>_<yyyyMMdd_HHmmss>.pcap for offline replay
+        std::string captureDir;
+
+        // NSE FO sharded parsing (see MulticastReceiver::setParseWorkers):
+        // <= 1 parses on the receive thread. Cores: -1 / missing = unpinned.
+        int nseFoParseWorkers = 0;
+        int nseFoReceiveCore = -1;
+        std::vector<int> nseFoParseCores;
+
+        // NSE parsers skip records for tokens nobody subscribed to (no store
+        // write, no callback). fullMarketStore keeps the store write for all
+        // tokens and only skips the callback. See
+        // PriceStoreGateway::setInterestFilter().
+        bool interestFilter = false;
+        bool fullMarketStore = false;
     };
 
     /**
@@ -126,6 +162,33 @@ public:
      */
     bool restartReceiver(ExchangeReceiver receiver, const std::string& ip, int port);
 
+    // ========== OFFLINE REPLAY (udp_replay) ==========
+
+    /**
+     * @brief Create socketless receivers for the enabled segments
+     *
+     * Callbacks, tick rings and the pump are set up as in start(), but no
+     * receive threads run: datagrams arrive through replayDatagram().
+     * @return true if at least one segment is enabled
+     */
+    bool startReplay(const Config& config);
+
+    /**
+     * @brief Run one captured datagram through @p receiver's packet loop
+     *
+     * Must be called from a single replay thread, which stands in for the
+     * receiver threads (it is the producer for every tick ring).
+     */
+    void replayDatagram(ExchangeReceiver receiver, const uint8_t* data, size_t length);
+
+    /**
+     * @brief Wait until every replayed datagram has been parsed
+     *
+     * With Config::nseFoParseWorkers > 1 replayDatagram() only publishes to
+     * the parse workers; call this before reading results.
+     */
+    void finishReplay();
+
     // ========== STATISTICS ==========
     
     struct Stats {
@@ -139,6 +202,32 @@ public:
         bool nseCmActive = false;
         bool bseFoActive = false;
         bool bseCmActive = false;
+
+        // Average datagrams returned per receive syscall (1.0 = unbatched)
+        double nseFoPacketsPerSyscall = 0.0;
+        double nseCmPacketsPerSyscall = 0.0;
+        double bseFoPacketsPerSyscall = 0.0;
+        double bseCmPacketsPerSyscall = 0.0;
+
+        // Receiver → GUI thread tick rings (Config::mainThreadPump)
+        struct TickQueue {
+            uint64_t depth = 0;       // Ticks waiting for the next pump
+            uint64_t highWater = 0;   // Deepest the ring has been
+            uint64_t drops = 0;       // Ticks rejected because the ring was full
+        };
+        TickQueue nseFoQueue;
+        TickQueue nseCmQueue;
+        TickQueue bseFoQueue;
+        TickQueue bseCmQueue;
+        uint64_t coalescedTicks = 0;  // Ticks superseded by a newer one before a pump
+
+        // Per-stream bcSeqNo gap accounting (NSE only; BSE has no stream seq)
+        common::SequenceGapCounters nseFoSequence;
+        common::SequenceGapCounters nseCmSequence;
+
+        // NSE FO sharded parsing (1 = inline on the receive thread)
+        uint64_t nseFoParseWorkers = 1;
+        uint64_t nseFoFanoutStalls = 0;   // Receive thread waited for a parse worker
     };
     Stats getStats() const;
 
@@ -171,6 +260,19 @@ private:
     void setupBseFoCallbacks();
     void setupBseCmCallbacks();
 
+    // Tick hand-off: queue for the GUI-thread pump (or publish directly
+    // when the pump is disabled). Must be called from @p source's
+    // receiver thread (or NSE FO parse worker) only – single producer per ring.
+    void publishTick(ExchangeReceiver source, const UDP::MarketTick& tick);
+    void deliverTick(const UDP::MarketTick& tick);
+    void startTickPump();
+    void pumpTicks();
+    void prepareTickRing(ExchangeReceiver source);
+    static size_t ringIndex(ExchangeReceiver source);
+
+    // Capture file for @p source, or "" when Config::captureDir is empty
+    std::string capturePath(ExchangeReceiver source) const;
+
     // Receivers
     std::unique_ptr<nsefo::MulticastReceiver> m_nseFoReceiver;
     std::unique_ptr<nsecm::MulticastReceiver> m_nseCmReceiver;
@@ -191,6 +293,24 @@ private:
     std::atomic<bool> m_bseCmActive{false};
     
     std::atomic<uint64_t> m_totalTicks{0};
+
+    // Receiver → GUI thread hand-off (index: ringIndex())
+    using TickRing = SpscRing<UDP::MarketTick>;
+    std::array<std::unique_ptr<TickRing>, 4> m_tickRings;
+    // Sharded NSE FO parsing: shard 0 uses m_tickRings[0], shard i the
+    // ring at i - 1 here, so every ring keeps a single producer
+    std::vector<std::unique_ptr<TickRing>> m_nseFoShardRings;
+    // GreeksCalculationService is not thread-safe; serializes the NSE FO
+    // parse workers' Greeks triggers
+    std::mutex m_nseFoGreeksMutex;
+    std::array<std::atomic<uint64_t>, 4> m_tickDrops{};
+    std::atomic<uint64_t> m_coalescedTicks{0};
+    QTimer* m_pumpTimer = nullptr;
+
+    // Pump scratch (GUI thread only): latest tick per (segment, token),
+    // in first-arrival order
+    std::vector<UDP::MarketTick> m_pendingTicks;
+    std::unordered_map<int64_t, size_t> m_pendingIndex;
     
     // Store config for restart capability
     Config m_lastConfig;
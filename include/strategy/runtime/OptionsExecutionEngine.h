@@ -9,8 +9,8 @@
  * @brief Executes multi-leg options strategies using battle-tested components
  * 
  * POC Task 3.1: Thin wrapper around existing infrastructure:
- * - ATMCalculator (binary search for nearest strike)
- * - RepositoryManager (strike cache & token lookup)
+ * - ContractCatalog (binary search for nearest strike, CE/PE tokens)
+ * - RepositoryManager (hands out the catalog)
  * 
  * See: docs/custom_stretegy_builder/form_based approach/08_BACKEND_AUDIT_FINDINGS.md
  */
@@ -32,10 +32,10 @@ public:
   };
 
   /**
-   * @brief Resolve ATM strike from spot price using existing ATMCalculator
+   * @brief Resolve ATM strike from spot price
    * 
-   * Implementation: Calls ATMCalculator::calculateFromActualStrikes()
-   * with strikes from RepositoryManager::getStrikesForSymbolExpiry()
+   * Implementation: ContractCatalog::Chain::atmIndex() on the chain from
+   * RepositoryManager::contractCatalog(), offset applied by strike index
    * 
    * @param symbol Underlying symbol (e.g., "NIFTY")
    * @param expiry Expiry date (e.g., "30JAN26")
@@ -67,7 +67,7 @@ public:
                                    const QString& expiry);
 
   /**
-   * @brief Get contract token for option using RepositoryManager
+   * @brief Get contract token for option from the contract catalog
    * 
    * @param symbol Underlying symbol
    * @param expiry Expiry date
@@ -103,16 +103,16 @@ public:
                                 double spotPrice);
 
   /**
-   * @brief Apply strike offset within sorted strikes array (public for testing)
+   * @brief Apply strike offset within a chain's strikes (public for testing)
    * 
-   * @param strikes Sorted strike prices
-   * @param atmStrike Current ATM strike
+   * @param strikeTicks Ascending strike ticks of the chain (Chain::strikeTicks)
+   * @param atmIndex Index of the ATM strike (Chain::atmIndex())
    * @param offset +1 for OTM, -1 for ITM, etc.
-   * @return Offset strike (or ATM if offset out of bounds)
+   * @return Index of the offset strike, clamped to the first / last strike
    */
-  static double applyStrikeOffset(const QVector<double>& strikes,
-                                  double atmStrike,
-                                  int offset);
+  static int applyStrikeOffset(const QVector<int64_t>& strikeTicks,
+                               int atmIndex,
+                               int offset);
 
 private:
 };
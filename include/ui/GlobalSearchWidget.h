@@ -7,6 +7,7 @@
 class QComboBox;
 class QLineEdit;
 class QTableWidget;
+class ScripSearchSession;
 
 namespace Ui { class GlobalSearchWidget; }
 
@@ -24,12 +25,15 @@ private slots:
   void onFilterChanged();
   void onResultDoubleClicked(int row, int column);
   void onReturnPressed();
+  void onResultsReady(quint64 generation, const QString &text,
+                      const QVector<ContractData> &results);
 
 private:
   void updateResults();
   void populateExpiries(const QString &symbol);
 
   Ui::GlobalSearchWidget *ui;
+  ScripSearchSession *m_search;
   QVector<ContractData> m_currentResults;
 };
 
@@ -0,0 +1,45 @@
+#ifndef LATENCYDIAGNOSTICSDIALOG_H
+#define LATENCYDIAGNOSTICSDIALOG_H
+
+#include <QDialog>
+
+class QLabel;
+class QPushButton;
+class QTableWidget;
+class QTimer;
+
+/**
+ * @brief Live view of the LatencyTracker histograms.
+ *
+ * One row per (segment, stage) with samples: count, p50 / p90 / p99 / p99.9,
+ * max and mean in µs, plus samples that came out negative (out of order).
+ * Refreshes every second; Reset clears the histograms, Export writes the
+ * same CSV/JSON files as the periodic dump to a chosen folder.
+ *
+ * Built entirely in C++ (no .ui file), like BroadcastSettingsDialog.
+ */
+class LatencyDiagnosticsDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit LatencyDiagnosticsDialog(QWidget *parent = nullptr);
+
+private slots:
+    void refreshStats();
+    void onReset();
+    void onExport();
+
+private:
+    void buildUI();
+    void applyStyleSheet();
+
+    QTableWidget* m_table = nullptr;
+    QLabel*       m_summaryLabel = nullptr;
+    QPushButton*  m_resetBtn = nullptr;
+    QPushButton*  m_exportBtn = nullptr;
+    QPushButton*  m_closeBtn = nullptr;
+    QTimer*       m_refreshTimer = nullptr;
+};
+
+#endif // LATENCYDIAGNOSTICSDIALOG_H
@@ -2,6 +2,7 @@
 #define CONFIGLOADER_H
 
 #include <QString>
+#include <QVector>
 #include <QMap>
 #include <QSettings>
 #include <QJsonObject>
@@ -54,6 +55,19 @@ public:
     int getBSEFOPort() const;
     QString getBSECMMulticastIP() const;
     int getBSECMPort() const;
+    bool getUDPBatchedIngest() const;   // recvmmsg() ingest (Linux), default false
+    int getUDPIngestBatchSize() const;  // Datagrams per recvmmsg() call, default 64
+    bool getUDPMainThreadPump() const;  // Receiver → GUI tick rings, default true
+    int getUDPPumpIntervalMs() const;   // Pump cadence, default 16 (~60 Hz)
+    int getUDPTickRingCapacity() const; // Ticks per segment ring, default 8192
+    QString getUDPCaptureDir() const;   // Raw datagram pcap capture dir, default "" (off)
+    int getUDPNseFoParseWorkers() const;      // NSE FO sharded parse threads, default 0 (inline)
+    int getUDPNseFoReceiveCore() const;       // Core for the NSE FO receive thread, default -1
+    QVector<int> getUDPNseFoParseCores() const; // Core per parse worker, default none
+    bool getUDPInterestFilter() const;    // Parsers skip unsubscribed tokens, default false
+    bool getUDPFullMarketStore() const;   // ...but still write the store, default false
+    QString getUDPLatencyDumpDir() const;   // Periodic latency CSV/JSON dump dir, default "" (off)
+    int getUDPLatencyDumpIntervalSec() const; // Dump cadence, default 60
 
     QJsonObject getUDPConfig() const;
     
@@ -0,0 +1,117 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @brief Lock-free log-linear (HDR-style) histogram of microsecond latencies
+ *
+ * Values below 32 µs get one bucket each; above that every power of two is
+ * split into 32 linear sub-buckets, so a reported percentile is within ~3%
+ * of the true value. Values clamp at 2^31 µs (~36 min). 864 buckets, ~7 KB.
+ *
+ * record() is wait-free apart from the min/max CAS (taken only when the
+ * value is a new extreme): relaxed atomic increments, callable from the
+ * receive, parse and GUI threads at once. snapshot() reads the buckets
+ * without stopping writers, so a snapshot taken mid-burst may be a few
+ * samples behind on some buckets; fine for diagnostics.
+ *
+ * Negative samples (timestamps out of order, e.g. from different clocks)
+ * are not bucketed but counted separately so they show up in reports.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr int kSubBucketBits = 5;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    static constexpr int kMaxExponent = 31;
+    static constexpr int64_t kMaxValue = (int64_t(1) << kMaxExponent) - 1;
+    static constexpr int kBucketCount = (kMaxExponent - kSubBucketBits + 1) * kSubBuckets;
+
+    struct Snapshot {
+        uint64_t count = 0;     // Bucketed samples
+        uint64_t negative = 0;  // Out-of-order samples, not bucketed
+        int64_t min = 0;
+        int64_t max = 0;
+        double mean = 0.0;
+        int64_t p50 = 0;
+        int64_t p90 = 0;
+        int64_t p99 = 0;
+        int64_t p999 = 0;
+    };
+
+    // Raw totals: the start of an interval for snapshotSince()
+    struct Totals {
+        std::array<uint64_t, kBucketCount> counts{};
+        uint64_t sum = 0;
+        uint64_t negative = 0;
+    };
+
+    LatencyHistogram() { reset(); }
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void record(int64_t micros) {
+        if (micros < 0) {
+            m_negative.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (micros > kMaxValue) micros = kMaxValue;
+
+        m_counts[bucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(static_cast<uint64_t>(micros), std::memory_order_relaxed);
+
+        int64_t seen = m_min.load(std::memory_order_relaxed);
+        while (micros < seen &&
+               !m_min.compare_exchange_weak(seen, micros, std::memory_order_relaxed)) {}
+        seen = m_max.load(std::memory_order_relaxed);
+        while (micros > seen &&
+               !m_max.compare_exchange_weak(seen, micros, std::memory_order_relaxed)) {}
+    }
+
+    Snapshot snapshot() const;
+
+    /**
+     * @brief Snapshot of only the samples recorded since `since`, which is
+     *        then moved up to now (periodic dumps of current latency)
+     *
+     * min / max come from bucket bounds (within the ~3% bucket error). If
+     * the histogram was reset in between, the interval restarts at the reset.
+     */
+    Snapshot snapshotSince(Totals& since) const;
+
+    // Not atomic as a whole: samples recorded during a reset may survive it
+    void reset();
+
+    static int bucketIndex(int64_t micros) {
+        const uint64_t value = static_cast<uint64_t>(micros);
+        if (value < static_cast<uint64_t>(kSubBuckets)) return static_cast<int>(value);
+        const int msb = std::bit_width(value) - 1;
+        const int shift = msb - kSubBucketBits;
+        return (shift + 1) * kSubBuckets + static_cast<int>((value >> shift) - kSubBuckets);
+    }
+
+    // Smallest / largest value that lands in bucket index
+    static int64_t bucketLowerBound(int index) {
+        if (index < kSubBuckets) return index;
+        const int shift = index / kSubBuckets - 1;
+        return static_cast<int64_t>(kSubBuckets + index % kSubBuckets) << shift;
+    }
+    static int64_t bucketUpperBound(int index) {
+        if (index < kSubBuckets) return index;
+        return bucketLowerBound(index) + (int64_t(1) << (index / kSubBuckets - 1)) - 1;
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketCount> m_counts;
+    std::atomic<uint64_t> m_sum{0};
+    std::atomic<uint64_t> m_negative{0};
+    std::atomic<int64_t> m_min{std::numeric_limits<int64_t>::max()};
+    std::atomic<int64_t> m_max{0};
+};
+
+#endif // LATENCY_HISTOGRAM_H
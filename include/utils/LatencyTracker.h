@@ -3,13 +3,20 @@
 
 #include <chrono>
 #include <cstdint>
+#include <vector>
+#include <QByteArray>
 #include <QString>
 #include <QDebug>
+#include "utils/LatencyHistogram.h"
 
 /**
  * @brief Utility for tracking end-to-end latency in the trading terminal
  * 
- * Tracks data flow: UDP Receive → Parse → Queue → Dequeue → FeedHandler → Model → View
+ * Tracks data flow: UDP Receive → Parse → Publish → FeedHandler → Model
+ * 
+ * All pipeline timestamps are steady-clock microseconds: the same clock as
+ * udp_ingest::packetTimestampOrNow() in the NSE/BSE parsers, so stage deltas
+ * taken on different threads are comparable and never jump with NTP.
  * 
  * Usage:
  * ```cpp
@@ -22,16 +29,44 @@
  * // Calculate latency
  * int64_t parseLatency = t2 - t1;
  * ```
+ * 
+ * Every tick's stage deltas go into a LatencyHistogram per (segment, stage)
+ * (recordFeedStages / recordModelUpdate, lock-free). report() / toCsv() /
+ * toJson() read p50/p90/p99/p99.9/max from them since start (or the last
+ * reset); intervalReport() only what arrived since the previous interval.
+ * writeDump(dir, true) is called periodically when [UDP] latency_dump_dir
+ * is set, so each dump shows the latency of its own interval.
  */
 class LatencyTracker {
 public:
+    /**
+     * @brief Pipeline stages with a histogram each (per segment)
+     */
+    enum class Stage : int {
+        Parse,      ///< UDP receive → parsed
+        Publish,    ///< Parsed → emitted by UdpBroadcastService
+        Dispatch,   ///< Emitted → FeedHandler delivery
+        Model,      ///< FeedHandler → model updated (incl. hop to GUI thread)
+        EndToEnd,   ///< UDP receive → model updated
+        Count
+    };
+
+    static constexpr int kStageCount = static_cast<int>(Stage::Count);
+    static constexpr int kSegmentSlots = 5;  ///< NSECM, NSEFO, BSECM, BSEFO, other
+
+    struct StageReport {
+        int segment;    ///< Exchange segment (1, 2, 11, 12), 0 for other
+        Stage stage;
+        LatencyHistogram::Snapshot stats;
+    };
+
     /**
      * @brief Get current timestamp in microseconds
-     * @return Microseconds since epoch
+     * @return Steady-clock microseconds (monotonic, not wall time)
      */
     static inline int64_t now() {
         return std::chrono::duration_cast<std::chrono::microseconds>(
-            std::chrono::high_resolution_clock::now().time_since_epoch()
+            std::chrono::steady_clock::now().time_since_epoch()
         ).count();
     }
     
@@ -129,101 +164,89 @@ public:
         }
     }
     
+    // ─── Histograms ──────────────────────────────────────────────────
+
+    static int segmentSlot(int segment) {
+        switch (segment) {
+            case 1:  return 0;   // NSECM
+            case 2:  return 1;   // NSEFO
+            case 11: return 2;   // BSECM
+            case 12: return 3;   // BSEFO
+            default: return 4;
+        }
+    }
+
+    static LatencyHistogram& histogram(int segment, Stage stage) {
+        return s_histograms[segmentSlot(segment) * kStageCount + static_cast<int>(stage)];
+    }
+
     /**
-     * @brief Track statistics for aggregate analysis
+     * @brief Record the feed-side stages of one tick (FeedHandler, IO thread)
+     *
+     * Stages whose timestamps are missing (0) are skipped.
      */
-    struct LatencyStats {
-        int64_t count = 0;
-        int64_t totalLatency = 0;
-        int64_t minLatency = INT64_MAX;
-        int64_t maxLatency = 0;
-        
-        void record(int64_t latency) {
-            count++;
-            totalLatency += latency;
-            if (latency < minLatency) minLatency = latency;
-            if (latency > maxLatency) maxLatency = latency;
-        }
-        
-        double average() const {
-            return count > 0 ? (double)totalLatency / count : 0.0;
-        }
-        
-        void print(const QString& label) const {
-            if (count == 0) {
-                qDebug() << "[Stats]" << label << "- No data";
-                return;
-            }
-            
-            qDebug() << "╔═══════════════════════════════════════════════════════════╗";
-            qDebug().nospace() << "║ " << label;
-            qDebug() << "╠═══════════════════════════════════════════════════════════╣";
-            qDebug().nospace() << "║ Samples:  " << count;
-            qDebug().nospace() << "║ Average:  " << QString("%1").arg(average(), 0, 'f', 2) << " µs (" << LatencyTracker::formatMicros(average()) << ")";
-            qDebug().nospace() << "║ Min:      " << minLatency << " µs (" << LatencyTracker::formatMicros(minLatency) << ")";
-            qDebug().nospace() << "║ Max:      " << maxLatency << " µs (" << LatencyTracker::formatMicros(maxLatency) << ")";
-            qDebug() << "╚═══════════════════════════════════════════════════════════╝";
-        }
-    };
-    
-    // Global statistics
-    static LatencyStats s_parseStats;
-    static LatencyStats s_queueStats;
-    static LatencyStats s_waitStats;
-    static LatencyStats s_feedHandlerStats;
-    static LatencyStats s_modelStats;
-    static LatencyStats s_viewStats;
-    static LatencyStats s_totalStats;
-    
+    static void recordFeedStages(int segment, int64_t t_recv, int64_t t_parse,
+                                 int64_t t_emit, int64_t t_feedhandler) {
+        if (t_recv > 0 && t_parse > 0)
+            histogram(segment, Stage::Parse).record(t_parse - t_recv);
+        if (t_parse > 0 && t_emit > 0)
+            histogram(segment, Stage::Publish).record(t_emit - t_parse);
+        if (t_emit > 0 && t_feedhandler > 0)
+            histogram(segment, Stage::Dispatch).record(t_feedhandler - t_emit);
+    }
+
     /**
-     * @brief Record latency for a complete tick flow
+     * @brief Record a view's model update for one tick (GUI thread)
      */
-    static void recordLatency(
-        int64_t t_recv,
-        int64_t t_parse,
-        int64_t t_queue,
-        int64_t t_dequeue,
-        int64_t t_feedhandler,
-        int64_t t_model,
-        int64_t t_view
-    ) {
-        s_parseStats.record(t_parse - t_recv);
-        s_queueStats.record(t_queue - t_parse);
-        s_waitStats.record(t_dequeue - t_queue);
-        s_feedHandlerStats.record(t_feedhandler - t_dequeue);
-        s_modelStats.record(t_model - t_feedhandler);
-        s_viewStats.record(t_view - t_model);
-        s_totalStats.record(t_view - t_recv);
+    static void recordModelUpdate(int segment, int64_t t_recv, int64_t t_feedhandler,
+                                  int64_t t_model) {
+        if (t_feedhandler > 0)
+            histogram(segment, Stage::Model).record(t_model - t_feedhandler);
+        if (t_recv > 0)
+            histogram(segment, Stage::EndToEnd).record(t_model - t_recv);
     }
-    
+
+    static void resetHistograms();
+
+    /**
+     * @brief Snapshot of every (segment, stage) histogram that has samples
+     */
+    static std::vector<StageReport> report();
+
+    /**
+     * @brief Like report(), for the samples recorded since the previous
+     *        intervalReport() call (GUI thread only)
+     */
+    static std::vector<StageReport> intervalReport();
+
+    static const char* stageName(Stage stage);
+    static const char* segmentName(int segment);
+
+    /**
+     * @brief One CSV line per reported histogram, prefixed with the dump time
+     * @param withHeader Start with the column header line
+     */
+    static QString toCsv(bool withHeader = true);
+    static QByteArray toJson();
+
+    /**
+     * @brief Append toCsv() rows to <dir>/latency_<yyyyMMdd>.csv and replace
+     *        <dir>/latency_latest.json
+     * @param interval Dump intervalReport() instead of the cumulative report()
+     */
+    static bool writeDump(const QString& dir, bool interval = false);
+
     /**
      * @brief Print aggregate statistics
      */
-    static void printAggregateStats() {
-        qDebug() << "";
-        qDebug() << "╔═══════════════════════════════════════════════════════════════╗";
-        qDebug() << "║           AGGREGATE LATENCY STATISTICS                       ║";
-        qDebug() << "╚═══════════════════════════════════════════════════════════════╝";
-        
-        s_parseStats.print("UDP → Parse");
-        s_queueStats.print("Parse → Queue");
-        s_waitStats.print("Queue Wait Time");
-        s_feedHandlerStats.print("FeedHandler Processing");
-        s_modelStats.print("Model Update");
-        s_viewStats.print("View Update");
-        s_totalStats.print("🎯 TOTAL END-TO-END (UDP→Screen)");
-        
-        qDebug() << "";
-    }
-};
+    static void printAggregateStats();
+
+private:
+    static QString toCsv(const std::vector<StageReport>& rows, bool withHeader);
+    static QByteArray toJson(const std::vector<StageReport>& rows, const char* window);
 
-// Static member initialization
-inline LatencyTracker::LatencyStats LatencyTracker::s_parseStats;
-inline LatencyTracker::LatencyStats LatencyTracker::s_queueStats;
-inline LatencyTracker::LatencyStats LatencyTracker::s_waitStats;
-inline LatencyTracker::LatencyStats LatencyTracker::s_feedHandlerStats;
-inline LatencyTracker::LatencyStats LatencyTracker::s_modelStats;
-inline LatencyTracker::LatencyStats LatencyTracker::s_viewStats;
-inline LatencyTracker::LatencyStats LatencyTracker::s_totalStats;
+    static LatencyHistogram s_histograms[kSegmentSlots * kStageCount];
+    static LatencyHistogram::Totals s_intervalStart[kSegmentSlots * kStageCount];
+};
 
 #endif // LATENCYTRACKER_H
@@ -2,6 +2,8 @@
 #define MEMORY_PROFILER_H
 
 #include <QString>
+#include <QtGlobal>
+#include <cstddef>
 #include <cstdint>
 
 /**
@@ -21,6 +23,13 @@ public:
      */
     static MemoryStats getCurrentUsage();
 
+    /**
+     * @brief Restart peak tracking from the current RSS, so peakPhysical
+     *        only covers what runs after this call (A/B measurements)
+     * @return false where the peak cannot be reset (only Linux can)
+     */
+    static bool resetPeak();
+
     /**
      * @brief Convert bytes to a human-readable string (KB, MB, GB)
      */
@@ -31,6 +40,20 @@ public:
      * @param label A label to identify where in the code this snapshot was taken
      */
     static void logSnapshot(const QString& label);
+
+    /**
+     * @brief Log the size of one data structure against a baseline layout
+     * @param bytes Bytes the structure holds now
+     * @param baselineBytes Bytes the same contents took in the previous layout
+     * @param items Element count (rows, entries...) for a per-item figure
+     */
+    static void logFootprint(const QString& label, size_t bytes,
+                             size_t baselineBytes, size_t items);
+
+    /**
+     * @brief Log the cost of a measured operation batch (total and per op)
+     */
+    static void logCost(const QString& label, qint64 nanoseconds, size_t operations);
 };
 
 #endif // MEMORY_PROFILER_H
@@ -66,6 +66,14 @@ public:
     bool getUseLegacyPriceCache() const;
     void setUseLegacyPriceCache(bool useLegacy);
     
+    // Market watch repaint flush interval in ms (16/50/100; 0 = per tick)
+    int getMarketWatchFlushInterval() const;
+    void setMarketWatchFlushInterval(int intervalMs);
+
+    // Market watch live feed only for visible rows (+ prefetch margin)
+    bool getMarketWatchViewportMode() const;
+    void setMarketWatchViewportMode(bool enabled);
+    
     // ============================================================================
     // NEW: Order Window Focus Field (default: Quantity)
     // ============================================================================
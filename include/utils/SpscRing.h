@@ -0,0 +1,108 @@
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief Bounded lock-free single-producer / single-consumer ring
+ *
+ * Exactly one thread calls tryPush() and exactly one (other) thread calls
+ * drain(). Slots are preallocated, so neither side allocates or locks.
+ *
+ * Usage:
+ * ```cpp
+ * SpscRing<UDP::MarketTick> ring(8192);
+ * // producer (receiver thread)
+ * if (!ring.tryPush(tick)) ++drops;
+ * // consumer (GUI thread)
+ * ring.drain([](const UDP::MarketTick& t) { ... });
+ * ```
+ *
+ * @note Capacity is rounded up to a power of two. A full ring rejects the
+ *       push; the producer decides what a drop means.
+ */
+template <typename T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacity)
+        : capacity_(roundUpPow2(capacity < 2 ? 2 : capacity)),
+          mask_(capacity_ - 1),
+          slots_(new T[capacity_]) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /**
+     * @brief Producer: copy @p value into the next slot
+     * @return false if the ring is full (value not queued)
+     */
+    bool tryPush(const T& value) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head - cachedTail_ >= capacity_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head - cachedTail_ >= capacity_) return false;
+        }
+        slots_[head & mask_] = value;
+        head_.store(head + 1, std::memory_order_release);
+
+        // cachedTail_ may be stale (depth over-estimated); re-read the real
+        // tail only when the estimate would raise the high-water mark
+        size_t depth = head + 1 - cachedTail_;
+        const size_t highWater = highWater_.load(std::memory_order_relaxed);
+        if (depth > highWater) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            depth = head + 1 - cachedTail_;
+            if (depth > highWater) highWater_.store(depth, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Consumer: hand every queued element to @p fn, in order
+     *
+     * Elements are read in place and released in one step after the batch,
+     * so the producer never sees a half-consumed slot.
+     * @return Number of elements drained
+     */
+    template <typename Fn>
+    size_t drain(Fn&& fn) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        const size_t head = head_.load(std::memory_order_acquire);
+        for (size_t i = tail; i != head; ++i) {
+            fn(static_cast<const T&>(slots_[i & mask_]));
+        }
+        tail_.store(head, std::memory_order_release);
+        return head - tail;
+    }
+
+    // Approximate when read from a third thread (diagnostics only)
+    size_t size() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+    size_t capacity() const { return capacity_; }
+    size_t highWater() const { return highWater_.load(std::memory_order_relaxed); }
+
+private:
+    static size_t roundUpPow2(size_t n) {
+        size_t p = 1;
+        while (p < n) p <<= 1;
+        return p;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<T[]> slots_;
+
+    // Producer side
+    alignas(64) std::atomic<size_t> head_{0};
+    size_t cachedTail_ = 0;
+    std::atomic<size_t> highWater_{0};
+
+    // Consumer side
+    alignas(64) std::atomic<size_t> tail_{0};
+};
+
+#endif // SPSCRING_H
@@ -18,6 +18,7 @@
 
 namespace Ui { class ATMWatchWindow; }
 
+class ConflatedSubscription;
 class QComboBox;
 class QHBoxLayout;
 class QLabel;
@@ -257,6 +258,9 @@ private:
   // Timer for LTP updates
   QTimer *m_basePriceTimer;
 
+  // Live option/underlying ticks, conflated to the latest value per token
+  ConflatedSubscription *m_tickFeed = nullptr;
+
   enum CallCols {
     CALL_CHG = 0,
     CALL_VOL,
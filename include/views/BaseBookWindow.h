@@ -4,7 +4,7 @@
 #include <QWidget>
 #include <QTableView>
 #include <QAbstractItemModel>
-#include <QSortFilterProxyModel>
+#include <QAbstractProxyModel>
 #include <QShortcut>
 #include <QSettings>
 #include <QMap>
@@ -31,7 +31,7 @@ protected:
     QString m_windowName;
     QTableView* m_tableView;
     QAbstractItemModel* m_model;
-    QSortFilterProxyModel* m_proxyModel;
+    QAbstractProxyModel* m_proxyModel;
     GenericTableProfile m_columnProfile;
     bool m_filterRowVisible;
     QList<QWidget*> m_filterWidgets;
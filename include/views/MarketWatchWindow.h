@@ -2,16 +2,20 @@
 #define MARKETWATCHWINDOW_H
 
 #include "core/widgets/CustomMarketWatch.h"
+#include "models/domain/ViewportSubscriptions.h" // Viewport-aware live rows
 #include "models/domain/WindowContext.h" // For context-aware window opening
 #include "models/interfaces/IMarketWatchViewCallback.h" // For native C++ callbacks
 #include "models/qt/MarketWatchModel.h"                 // For ScripData
 #include "services/FeedHandler.h" // Phase 2: Direct callback-based updates
 #include "udp/UDPTypes.h"         // Phase 3: UDP-specific tick data
+#include <QFutureWatcher>
 #include <QMenu>
 #include <QMessageBox>
 #include <QSettings>
+#include <QTimer>
 #include <QVBoxLayout>
 #include <unordered_map>
+#include <vector>
 
 class TokenAddressBook;
 class XTSMarketDataClient;
@@ -33,6 +37,10 @@ class XTSMarketDataClient;
  * - Auto-subscription management
  * - Fast O(1) price updates
  * - Native C++ callbacks (no Qt signal latency)
+ * - Viewport mode: only the visible rows (plus a prefetch margin) get
+ *   per-tick callbacks; rows scrolled into view are filled from the price
+ *   store, and a periodic background re-rank refreshes the rest so a sort on
+ *   a live column stays correct
  */
 class MarketWatchWindow : public CustomMarketWatch,
                           public IMarketWatchViewCallback {
@@ -150,6 +158,21 @@ public:
    */
   void setFocusToToken(int token);
 
+  // === Viewport Mode ===
+
+  /**
+   * @brief Subscribe only the rows in (or near) the viewport
+   *
+   * Every row stays enabled at the feed sources, so the price store keeps
+   * it current; only the per-tick callbacks follow the viewport. Requires
+   * the zero-copy price store (ignored in legacy price cache mode).
+   */
+  void setViewportMode(bool enabled);
+  bool isViewportMode() const { return m_viewportMode; }
+
+  // Rows with a per-tick subscription (all scrips when not in viewport mode)
+  size_t liveRowCount() const;
+
   // === Price Update Operations ===
 
   /**
@@ -358,6 +381,11 @@ protected:
    */
   void mouseDoubleClickEvent(QMouseEvent *event) override;
 
+  /**
+   * @brief Resizing changes which rows are visible (viewport mode)
+   */
+  void resizeEvent(QResizeEvent *event) override;
+
 private slots:
   void showContextMenu(const QPoint &pos);
   void showColumnProfileDialog();
@@ -384,6 +412,27 @@ private:
   // Phase 3: UDP-specific tick updates (cleaner semantics)
   void onUdpTickUpdate(const UDP::MarketTick &tick);
 
+  // Row feed: call after the row is in the model and address book
+  void startRowFeed(UDP::ExchangeSegment segment, int token);
+  void stopRowFeed(UDP::ExchangeSegment segment, int token);
+  // Fill a row from the price store snapshot (initial load, scrolled in)
+  void seedRowFromStore(int segment, int token);
+
+  // Viewport mode (Viewport.cpp)
+  struct RerankBatch {
+    std::vector<UDP::MarketTick> ticks;           // Rows changed in the store
+    std::unordered_map<int, uint64_t> watermarks; // Per segment, for the next scan
+  };
+  void setupViewport();
+  void scheduleViewportSync();
+  void syncViewport();
+  void startRerank();
+  void applyRerank();
+  // Pool thread: rows of tokens changed in the store after since (per segment)
+  static RerankBatch collectStoreChanges(
+      const std::unordered_map<int, std::vector<uint32_t>> &tokens,
+      const std::unordered_map<int, uint64_t> &since);
+
   // Data Components
   // Data Components
   MarketWatchModel *m_model;
@@ -401,6 +450,14 @@ private:
   // Zero-Copy Members
   bool m_useZeroCopyPriceCache = true; // Default to true
 
+  // Viewport mode: live rows, coalesced resync, background re-rank
+  bool m_viewportMode = false;
+  ViewportSubscriptions m_viewport;
+  QTimer m_viewportSyncTimer;
+  QTimer m_rerankTimer;
+  QFutureWatcher<RerankBatch> m_rerankWatcher;
+  std::unordered_map<int, uint64_t> m_rerankWatermarks;
+
   // Internal Helpers for Visual Persistence
   void captureProfileFromView(GenericTableProfile &profile);
   void applyProfileToView(const GenericTableProfile &profile);
@@ -5,7 +5,9 @@
 #include "views/BaseBookWindow.h"
 #include "api/xts/XTSTypes.h"
 #include "PositionModel.h"
+#include <QHash>
 #include <QMutex>
+#include <vector>
 
 namespace Ui { class PositionWindow; }
 
@@ -14,7 +16,8 @@ class TradingDataService;
 class QComboBox;
 class QPushButton;
 class QLabel;
-class QTimer;
+class ConflatedSubscription;
+namespace UDP { struct MarketTick; }
 
 class PositionWindow : public BaseBookWindow {
     Q_OBJECT
@@ -46,6 +49,12 @@ private:
     void setupConnections();
     void updateSummaryRow();
     void showPositionContextMenu(const QPoint &pos);
+
+    // Live prices: one conflated feed over every position's token
+    void resyncPriceFeed();
+    void seedMarketPrices();
+    void onPriceBatch(const std::vector<UDP::MarketTick>& changed);
+    static bool applyMarketPrice(PositionData& pd, double ltp);
     
     Ui::PositionWindow *ui;
     TradingDataService* m_tradingDataService;
@@ -54,14 +63,11 @@ private:
     QComboBox *m_cbExchange, *m_cbSegment, *m_cbPeriodicity, *m_cbUser, *m_cbClient;
     QPushButton *m_btnRefresh, *m_btnExport;
     QMap<int, QStringList> m_columnFilters;
-    QTimer* m_priceUpdateTimer;
+    ConflatedSubscription* m_priceFeed;
+    QHash<int64_t, QVector<int>> m_positionsByKey; // Feed key → m_allPositions rows
     
     // Thread safety for concurrent updates
     mutable QMutex m_updateMutex;
-    bool m_isUpdating;
-
-private slots:
-    void updateMarketPrices();
 };
 
 #endif // POSITIONWINDOW_H
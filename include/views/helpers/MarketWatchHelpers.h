@@ -6,6 +6,8 @@
 #include <QJsonObject>
 #include "models/profiles/MarketWatchColumnProfile.h"
 #include "models/profiles/GenericTableProfile.h"
+#include "data/UnifiedPriceState.h"
+#include "udp/UDPTypes.h"
 
 // Forward declaration
 struct ScripData;
@@ -83,6 +85,16 @@ public:
     static ScripData scripFromJson(const QJsonObject &json);
 
     static bool loadPortfolio(const QString &filename, QList<ScripData> &scrips, GenericTableProfile &profile);
+
+    /**
+     * @brief Build a tick from price store blocks (snapshot fill / re-rank)
+     *
+     * Fields the store has no value for stay 0, which
+     * MarketWatchModel::updateFromUdpTick() leaves untouched.
+     */
+    static UDP::MarketTick tickFromStore(int segment, uint32_t token,
+                                         const MarketData::TouchlineState &touchline,
+                                         const MarketData::DepthState &depth);
 };
 
 #endif // MARKETWATCHHELPERS_H
@@ -2,17 +2,23 @@
 #define COMMON_LZO_DECOMPRESS_H
 
 #include <vector>
+#include <cstddef>
 #include <cstdint>
 #include <stdexcept>
 
 namespace common {
 
-// Error codes
-enum class LzoError {
-    OK,
-    INPUT_OVERRUN,
-    OUTPUT_OVERRUN,
-    CORRUPTED_DATA
+// Error codes (negative values are returned by decompressInto)
+enum class LzoError : int {
+    OK = 0,
+    INPUT_OVERRUN = -1,
+    OUTPUT_OVERRUN = -2,
+    CORRUPTED_DATA = -3,
+    LOOKBEHIND_OVERRUN = -4,
+    EOF_NOT_FOUND = -5,
+    INPUT_NOT_CONSUMED = -6,
+    INVALID_ARGUMENT = -7,
+    LIBRARY_ERROR = -8
 };
 
 class LzoDecompressor {
@@ -24,6 +30,20 @@ public:
     // Library-based LZO1Z decompression using official liblzo2
     // Returns number of bytes written to dst, or throws runtime_error on error
     static int decompressWithLibrary(const std::vector<uint8_t>& src, std::vector<uint8_t>& dst);
+
+    // Allocation-free library LZO1Z decompression for the receive hot path.
+    // Returns number of bytes written to dst (>= 0), or a negative LzoError
+    // value on failure. Never throws.
+    static int decompressInto(const uint8_t* src, size_t srcLen,
+                              uint8_t* dst, size_t cap) noexcept;
+
+    // Per-thread 64-byte aligned output buffer of kScratchSize bytes, reused
+    // across calls. Contents are valid until the next decompress on the
+    // same thread.
+    static constexpr size_t kScratchSize = 65536;
+    static uint8_t* scratch() noexcept;
+
+    static const char* errorString(int code) noexcept;
 };
 
 } // namespace common
@@ -0,0 +1,213 @@
+#ifndef COMMON_SEQUENCE_GAP_TRACKER_H
+#define COMMON_SEQUENCE_GAP_TRACKER_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+
+namespace common {
+
+// Snapshot of SequenceGapTracker counters (safe to copy across threads)
+struct SequenceGapCounters {
+    uint64_t gaps = 0;            // Forward jumps in bcSeqNo (one per hole)
+    uint64_t missing = 0;         // Sequence numbers skipped by those jumps
+    uint64_t recovered = 0;       // Skipped numbers that later arrived late
+    uint64_t maxGap = 0;          // Largest single jump seen
+    uint64_t outOfOrder = 0;      // Arrivals behind the stream's latest seq
+    uint64_t duplicates = 0;      // Sequence numbers seen twice
+    uint64_t resets = 0;          // Jumps >= kResetThreshold treated as a restart
+    uint64_t streams = 0;         // Distinct streams being tracked
+    uint64_t untracked = 0;       // Messages on streams that did not fit the table
+
+    // Gap size histogram: 1, 2-9, 10-99, 100+
+    std::array<uint64_t, 4> gapSizes{};
+
+    // Messages still missing after late arrivals
+    uint64_t netLost() const { return missing > recovered ? missing - recovered : 0; }
+};
+
+inline std::ostream& operator<<(std::ostream& os, const SequenceGapCounters& c) {
+    os << "Sequence Gaps: " << c.gaps << " | Missing: " << c.missing
+       << " | Recovered: " << c.recovered << " | Net Lost: " << c.netLost()
+       << " | Max Gap: " << c.maxGap << " | Out-of-Order: " << c.outOfOrder
+       << " | Duplicates: " << c.duplicates << " | Resets: " << c.resets
+       << " | Streams: " << c.streams;
+    return os;
+}
+
+/**
+ * @brief Per-stream bcSeqNo gap detection for NSE broadcast
+ *
+ * The NSE feeds interleave many independent streams, each with its own
+ * bcSeqNo counter, so one global "last seq" reports huge false gaps. Each
+ * stream is keyed by the BCAST_HEADER stream identity (alphaChar +
+ * transactionCode) in a small open-addressed table (linear probing, no
+ * erase). A 64-bit window per stream tells a late packet that fills a hole
+ * (recovered) from a duplicate.
+ *
+ * Threading: observe() is called from the receive thread only and takes no
+ * lock. counters() may be called from any thread; each counter is an atomic
+ * written by that single thread, so reads are cheap but not a consistent
+ * cross-counter snapshot.
+ */
+class SequenceGapTracker {
+public:
+    static constexpr size_t kCapacity = 512;               // Slots, power of two
+    static constexpr size_t kMaxStreams = kCapacity * 3 / 4;
+    static constexpr uint32_t kResetThreshold = 1u << 20;  // Jump this big = restart
+
+    // BCAST_HEADER offsets (see nse_common.h)
+    static constexpr size_t kAlphaCharOffset = 8;
+    static constexpr size_t kTxCodeOffset = 10;
+    static constexpr size_t kSeqNoOffset = 14;
+    static constexpr size_t kMinHeaderSize = kSeqNoOffset + sizeof(uint32_t);
+
+    /**
+     * @brief Record one message from its (big-endian) BCAST_HEADER bytes
+     * @param header Start of BCAST_HEADER; at least kMinHeaderSize bytes
+     */
+    void observeHeader(const uint8_t* header) {
+        uint16_t alpha, txCode;
+        uint32_t seq;
+        std::memcpy(&alpha, header + kAlphaCharOffset, sizeof(alpha));
+        std::memcpy(&txCode, header + kTxCodeOffset, sizeof(txCode));
+        std::memcpy(&seq, header + kSeqNoOffset, sizeof(seq));
+        // Key keeps wire byte order; only the sequence needs to be numeric
+        observe((static_cast<uint32_t>(alpha) << 16) | txCode, fromBigEndian(seq));
+    }
+
+    /**
+     * @brief Record sequence number @p seq on stream @p streamKey
+     */
+    void observe(uint32_t streamKey, uint32_t seq) {
+        Slot* slot = findOrInsert(streamKey);
+        if (!slot) return;
+
+        if (!slot->started) {
+            slot->started = true;
+            slot->lastSeq = seq;
+            slot->window = 1;
+            return;
+        }
+
+        if (seq > slot->lastSeq) {
+            const uint32_t advance = seq - slot->lastSeq;
+            if (advance >= kResetThreshold) {
+                bump(resets_);
+                slot->lastSeq = seq;
+                slot->window = 1;
+                return;
+            }
+            if (advance > 1) recordGap(advance - 1);
+            slot->window = advance >= 64 ? 1 : (slot->window << advance) | 1;
+            slot->lastSeq = seq;
+            return;
+        }
+
+        const uint32_t behind = slot->lastSeq - seq;
+        if (behind >= kResetThreshold) {
+            bump(resets_);
+            slot->lastSeq = seq;
+            slot->window = 1;
+            return;
+        }
+        if (behind < 64) {
+            const uint64_t bit = uint64_t(1) << behind;
+            if (slot->window & bit) {
+                bump(duplicates_);
+                return;
+            }
+            slot->window |= bit;
+            bump(recovered_);
+        }
+        bump(outOfOrder_);
+    }
+
+    SequenceGapCounters counters() const {
+        SequenceGapCounters c;
+        c.gaps = gaps_.load(std::memory_order_relaxed);
+        c.missing = missing_.load(std::memory_order_relaxed);
+        c.recovered = recovered_.load(std::memory_order_relaxed);
+        c.maxGap = maxGap_.load(std::memory_order_relaxed);
+        c.outOfOrder = outOfOrder_.load(std::memory_order_relaxed);
+        c.duplicates = duplicates_.load(std::memory_order_relaxed);
+        c.resets = resets_.load(std::memory_order_relaxed);
+        c.streams = streams_.load(std::memory_order_relaxed);
+        c.untracked = untracked_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < c.gapSizes.size(); ++i) {
+            c.gapSizes[i] = gapSizes_[i].load(std::memory_order_relaxed);
+        }
+        return c;
+    }
+
+private:
+    struct Slot {
+        uint32_t key = 0;
+        uint32_t lastSeq = 0;
+        uint64_t window = 0;      // Bit i set = (lastSeq - i) received
+        bool used = false;
+        bool started = false;
+    };
+
+    static uint32_t fromBigEndian(uint32_t v) {
+        const auto* b = reinterpret_cast<const uint8_t*>(&v);
+        return (uint32_t(b[0]) << 24) | (uint32_t(b[1]) << 16) | (uint32_t(b[2]) << 8) | b[3];
+    }
+
+    // Single writer: plain load + store, no locked RMW on the receive thread
+    static void bump(std::atomic<uint64_t>& counter, uint64_t n = 1) {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    void recordGap(uint64_t size) {
+        bump(gaps_);
+        bump(missing_, size);
+        if (size > maxGap_.load(std::memory_order_relaxed)) {
+            maxGap_.store(size, std::memory_order_relaxed);
+        }
+        const size_t bucket = size == 1 ? 0 : size < 10 ? 1 : size < 100 ? 2 : 3;
+        bump(gapSizes_[bucket]);
+    }
+
+    Slot* findOrInsert(uint32_t key) {
+        size_t i = (key * 0x9E3779B1u) & (kCapacity - 1);
+        for (size_t probes = 0; probes < kCapacity; ++probes) {
+            Slot& slot = slots_[i];
+            if (slot.used && slot.key == key) return &slot;
+            if (!slot.used) {
+                if (streamCount_ >= kMaxStreams) {
+                    bump(untracked_);
+                    return nullptr;
+                }
+                slot.used = true;
+                slot.key = key;
+                ++streamCount_;
+                streams_.store(streamCount_, std::memory_order_relaxed);
+                return &slot;
+            }
+            i = (i + 1) & (kCapacity - 1);
+        }
+        return nullptr;
+    }
+
+    std::array<Slot, kCapacity> slots_{};
+    size_t streamCount_ = 0;
+
+    std::atomic<uint64_t> gaps_{0};
+    std::atomic<uint64_t> missing_{0};
+    std::atomic<uint64_t> recovered_{0};
+    std::atomic<uint64_t> maxGap_{0};
+    std::atomic<uint64_t> outOfOrder_{0};
+    std::atomic<uint64_t> duplicates_{0};
+    std::atomic<uint64_t> resets_{0};
+    std::atomic<uint64_t> streams_{0};
+    std::atomic<uint64_t> untracked_{0};
+    std::array<std::atomic<uint64_t>, 4> gapSizes_{};
+};
+
+} // namespace common
+
+#endif // COMMON_SEQUENCE_GAP_TRACKER_H
@@ -0,0 +1,131 @@
+#ifndef COMMON_TOKEN_INTEREST_H
+#define COMMON_TOKEN_INTEREST_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+
+namespace common {
+
+/**
+ * @brief Lock-free "is anyone watching this token?" set
+ *
+ * One bit per token in a flat array of atomic words: test() is a single
+ * relaxed load, cheap enough for the per-record loops of the broadcast
+ * parsers. set() is an atomic OR / AND, so subscriptions can change from
+ * the GUI thread while the receive threads read.
+ *
+ * Tokens >= capacity (rare: BSE grows past its nominal range) fall back to a
+ * mutex-guarded overflow set; test() only takes that lock once such a token
+ * has been added.
+ */
+class TokenInterestBitmap {
+public:
+    explicit TokenInterestBitmap(uint32_t capacity)
+        : capacity_((capacity + 63) & ~uint32_t(63)),
+          words_(new std::atomic<uint64_t>[capacity_ / 64]) {
+        clear();
+    }
+
+    uint32_t capacity() const { return capacity_; }
+
+    void set(uint32_t token, bool interested) {
+        if (token >= capacity_) {
+            std::lock_guard<std::mutex> lock(overflowMutex_);
+            if (interested) overflow_.insert(token);
+            else overflow_.erase(token);
+            hasOverflow_.store(!overflow_.empty(), std::memory_order_release);
+            return;
+        }
+        const uint64_t bit = uint64_t(1) << (token & 63);
+        if (interested) words_[token >> 6].fetch_or(bit, std::memory_order_relaxed);
+        else words_[token >> 6].fetch_and(~bit, std::memory_order_relaxed);
+    }
+
+    bool test(uint32_t token) const {
+        if (token < capacity_) {
+            return (words_[token >> 6].load(std::memory_order_relaxed) >> (token & 63)) & 1;
+        }
+        if (!hasOverflow_.load(std::memory_order_acquire)) return false;
+        std::lock_guard<std::mutex> lock(overflowMutex_);
+        return overflow_.count(token) != 0;
+    }
+
+    void clear() {
+        for (uint32_t i = 0; i < capacity_ / 64; ++i) {
+            words_[i].store(0, std::memory_order_relaxed);
+        }
+        std::lock_guard<std::mutex> lock(overflowMutex_);
+        overflow_.clear();
+        hasOverflow_.store(false, std::memory_order_release);
+    }
+
+    size_t count() const {
+        size_t n = 0;
+        for (uint32_t i = 0; i < capacity_ / 64; ++i) {
+            uint64_t w = words_[i].load(std::memory_order_relaxed);
+            for (; w; w &= w - 1) ++n;
+        }
+        std::lock_guard<std::mutex> lock(overflowMutex_);
+        return n + overflow_.size();
+    }
+
+private:
+    const uint32_t capacity_;
+    std::unique_ptr<std::atomic<uint64_t>[]> words_;
+
+    mutable std::mutex overflowMutex_;
+    std::unordered_set<uint32_t> overflow_;
+    std::atomic<bool> hasOverflow_{false};
+};
+
+/**
+ * @brief Per-segment subscription interest shared by the gateway and parsers
+ *
+ * tokens is the notification set (PriceStoreGateway::setTokenEnabled). With
+ * filterRecords on, the parsers also consult it before touching the store:
+ * records for tokens nobody watches are skipped before the store write,
+ * snapshot copy and callback. fullMarketStore keeps the store write for every
+ * token (readers such as ATM / option chain that look at unsubscribed rows)
+ * and only skips the callback.
+ */
+struct SegmentInterest {
+    explicit SegmentInterest(uint32_t capacity) : tokens(capacity) {}
+
+    TokenInterestBitmap tokens;
+    std::atomic<bool> filterRecords{false};
+    std::atomic<bool> fullMarketStore{false};
+
+    // Parser check, once per record: apply this token's update at all?
+    bool wantsRecord(uint32_t token) const {
+        return !filterRecords.load(std::memory_order_relaxed) ||
+               fullMarketStore.load(std::memory_order_relaxed) ||
+               tokens.test(token);
+    }
+};
+
+/**
+ * @brief Interest for a semantic segment (1=NSECM, 2=NSEFO, 11=BSECM, 12=BSEFO)
+ * @return nullptr for any other segment
+ */
+inline SegmentInterest* segmentInterest(int segment) {
+    // Capacities cover each store's token range; beyond that, overflow set
+    static SegmentInterest nseCm(1u << 17);
+    static SegmentInterest nseFo(1u << 18);
+    static SegmentInterest bseCm(1u << 20);
+    static SegmentInterest bseFo(1u << 20);
+    switch (segment) {
+        case 1:  return &nseCm;
+        case 2:  return &nseFo;
+        case 11: return &bseCm;
+        case 12: return &bseFo;
+        default: return nullptr;
+    }
+}
+
+} // namespace common
+
+#endif // COMMON_TOKEN_INTEREST_H
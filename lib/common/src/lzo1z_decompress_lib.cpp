@@ -6,6 +6,65 @@
 
 namespace common {
 
+namespace {
+
+LzoError mapLibraryError(int result) {
+    switch (result) {
+        case LZO_E_INPUT_OVERRUN:      return LzoError::INPUT_OVERRUN;
+        case LZO_E_OUTPUT_OVERRUN:     return LzoError::OUTPUT_OVERRUN;
+        case LZO_E_LOOKBEHIND_OVERRUN: return LzoError::LOOKBEHIND_OVERRUN;
+        case LZO_E_EOF_NOT_FOUND:      return LzoError::EOF_NOT_FOUND;
+        case LZO_E_INPUT_NOT_CONSUMED: return LzoError::INPUT_NOT_CONSUMED;
+        default:                       return LzoError::CORRUPTED_DATA;
+    }
+}
+
+} // namespace
+
+// Allocation-free LZO1Z decompression (receive hot path)
+// Same lzo1z_decompress_safe call as decompressWithLibrary, but caller owns
+// both buffers and failures are reported as negative LzoError codes.
+
+int LzoDecompressor::decompressInto(const uint8_t* src, size_t srcLen,
+                                    uint8_t* dst, size_t cap) noexcept {
+    if (!src || srcLen == 0 || !dst || cap == 0) {
+        return static_cast<int>(LzoError::INVALID_ARGUMENT);
+    }
+
+    // lzo_init() only validates the build configuration - run it once
+    static const bool initialized = (lzo_init() == LZO_E_OK);
+    if (!initialized) {
+        return static_cast<int>(LzoError::LIBRARY_ERROR);
+    }
+
+    lzo_uint out_len = cap;
+    int result = lzo1z_decompress_safe(src, srcLen, dst, &out_len, nullptr);
+    if (result != LZO_E_OK) {
+        return static_cast<int>(mapLibraryError(result));
+    }
+    return static_cast<int>(out_len);
+}
+
+uint8_t* LzoDecompressor::scratch() noexcept {
+    alignas(64) static thread_local uint8_t buffer[kScratchSize];
+    return buffer;
+}
+
+const char* LzoDecompressor::errorString(int code) noexcept {
+    switch (static_cast<LzoError>(code)) {
+        case LzoError::OK:                 return "OK";
+        case LzoError::INPUT_OVERRUN:      return "Input overrun - compressed data is corrupted";
+        case LzoError::OUTPUT_OVERRUN:     return "Output overrun - output buffer too small";
+        case LzoError::CORRUPTED_DATA:     return "Corrupted data";
+        case LzoError::LOOKBEHIND_OVERRUN: return "Lookbehind overrun - compressed data is corrupted";
+        case LzoError::EOF_NOT_FOUND:      return "EOF marker not found";
+        case LzoError::INPUT_NOT_CONSUMED: return "Input not fully consumed";
+        case LzoError::INVALID_ARGUMENT:   return "Invalid argument";
+        case LzoError::LIBRARY_ERROR:      return "Library initialization failed";
+    }
+    return code >= 0 ? "OK" : "Unknown error";
+}
+
 // LZO Library-based decompression
 // Uses official lzo1z_decompress_safe function from liblzo2
 
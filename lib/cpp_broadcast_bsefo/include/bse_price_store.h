@@ -13,16 +13,18 @@
 
 
 #include "data/UnifiedPriceState.h"
+#include "data/SeqlockPriceSlab.h"
 
 namespace bse {
 
 using UnifiedTokenState = MarketData::UnifiedState;
 using DepthLevel = MarketData::DepthLevel;
+using Row = MarketData::SeqlockPriceSlab::RowRef;
 
 /**
  * @brief High-Performance Distributed Price Store for BSE
- * Uses pre-allocated vector for O(1) lock-free(ish) access.
- * Shared Mutex protects concurrent writes/reads.
+ * Rows live in a contiguous seqlock slab indexed by token (O(1) access).
+ * Readers are lock-free; the index grows for tokens beyond MAX_TOKENS.
  */
 class PriceStore {
 public:
@@ -34,22 +36,37 @@ public:
   PriceStore(const PriceStore &) = delete;
   PriceStore &operator=(const PriceStore &) = delete;
 
-  /**
-   * @brief Get unified state for reading (Thread-Safe Shared Lock)
-   * @deprecated Use getUnifiedSnapshot() for thread-safe access
-   */
-  const UnifiedTokenState *getUnifiedState(uint32_t token) const;
-
   /**
    * @brief Get thread-safe snapshot copy of token state
-   * @return Copy of token state, guaranteed consistent under lock
+   * @return Consistent copy of token state (seqlock retry on torn read)
    * @note Returns empty state (token=0) if not found
    */
   [[nodiscard]] UnifiedTokenState getUnifiedSnapshot(uint32_t token) const {
-    if (token >= MAX_TOKENS) return UnifiedTokenState{};
-    std::shared_lock lock(mutex);
-    if (!tokenStates[token]) return UnifiedTokenState{};
-    return *tokenStates[token]; // Copy under lock - thread safe
+    UnifiedTokenState state;
+    if (!slab.read(token, state)) return UnifiedTokenState{};
+    return state;
+  }
+
+  /**
+   * @brief Partial snapshots: copy one block instead of the full state
+   * @note Return an empty block if not found
+   */
+  [[nodiscard]] MarketData::TouchlineState getTouchline(uint32_t token) const {
+    MarketData::TouchlineState tick;
+    if (!slab.readTouchline(token, tick)) return MarketData::TouchlineState{};
+    return tick;
+  }
+
+  [[nodiscard]] MarketData::DepthState getDepth(uint32_t token) const {
+    MarketData::DepthState depth;
+    if (!slab.readDepth(token, depth)) return MarketData::DepthState{};
+    return depth;
+  }
+
+  [[nodiscard]] MarketData::GreeksState getGreeks(uint32_t token) const {
+    MarketData::GreeksState greeks;
+    if (!slab.readGreeks(token, greeks)) return MarketData::GreeksState{};
+    return greeks;
   }
 
   /**
@@ -115,14 +132,51 @@ public:
    */
   void initializeFromMaster(const std::vector<uint32_t> &tokens);
 
+  /**
+   * @brief Drop a contract removed from the master (incremental refresh)
+   */
+  bool removeToken(uint32_t token) { return slab.erase(token); }
+
   /**
    * @brief Check if token is valid
    */
   bool isValidToken(uint32_t token) const;
 
+  /**
+   * @brief Pre-size the slab for an upcoming master load (avoids regrowth)
+   */
+  void reserve(size_t tokenCount) { slab.reserve(tokenCount); }
+
+  // Torn reads retried by getUnifiedSnapshot() (contention diagnostics)
+  uint64_t getReadRetries() const { return slab.readRetries(); }
+
+  // =========================================================
+  // VERSIONS (dirty tracking for pollers)
+  // =========================================================
+
+  /**
+   * @brief Current version epoch (advanced by changedSince(), not by updates)
+   */
+  uint64_t getVersion() const { return slab.version(); }
+
+  /**
+   * @brief Number of updates to token's row; 0 if the token has no row
+   */
+  uint64_t getRowVersion(uint32_t token) const { return slab.rowVersion(token); }
+
+  /**
+   * @brief Append the Block of each token updated after sinceVersion
+   * @return Watermark to pass as sinceVersion on the next call
+   * @see MarketData::SeqlockPriceSlab::changedSince
+   */
+  template <typename Block>
+  uint64_t changedSince(uint64_t sinceVersion, const uint32_t* tokens, size_t count,
+                        std::vector<MarketData::VersionedBlock<Block>>& out) const {
+    return slab.changedSince(sinceVersion, tokens, count, out);
+  }
+
 private:
-  std::vector<UnifiedTokenState*> tokenStates; // Sparse vector of pointers
-  mutable std::shared_mutex mutex;            // Shared mutex for thread safety
+  MarketData::SeqlockPriceSlab slab; // Contiguous rows + token index
 };
 
 /**
@@ -93,7 +93,7 @@ struct DecodedDepthLevel {
 
 struct DecodedRecord {
     uint32_t token;
-    uint64_t packetTimestamp; // System time of receipt
+    uint64_t packetTimestamp; // Receipt time, steady-clock µs
     
     // === CONTRACT MASTER DATA (Static - initialized once) ===
     char symbol[32] = {0};          // Symbol name
@@ -138,7 +138,7 @@ struct DecodedOpenInterest {
     int64_t openInterest;        // OI in quantity
     int64_t openInterestValue;   // OI in value (2 decimal)
     int32_t openInterestChange;  // Change from previous day
-    uint64_t packetTimestamp;    // System time of receipt
+    uint64_t packetTimestamp;    // Receipt time, steady-clock µs
 };
 
 // Decoded Session State (Message Type 2002)
@@ -148,21 +148,21 @@ struct DecodedSessionState {
     uint8_t marketType;          // 0=Pre-open, 1=Continuous, 2=Auction
     uint8_t startEndFlag;        // 0=Start, 1=End
     uint64_t timestamp;          // Exchange timestamp
-    uint64_t packetTimestamp;    // System time of receipt
+    uint64_t packetTimestamp;    // Receipt time, steady-clock µs
 };
 
 // Decoded Close Price (Message Type 2014)
 struct DecodedClosePrice {
     uint32_t token;
     int32_t closePrice;          // Closing price in paise
-    uint64_t packetTimestamp;    // System time of receipt
+    uint64_t packetTimestamp;    // Receipt time, steady-clock µs
 };
 
 // Decoded Implied Volatility (Message Type 2028)
 struct DecodedImpliedVolatility {
     uint32_t token;
     int64_t impliedVolatility;   // Raw value from packet
-    uint64_t packetTimestamp;    // System time of receipt
+    uint64_t packetTimestamp;    // Receipt time, steady-clock µs
 };
 
 // Decoded RBI Reference Rate (Message Type 2022)
@@ -1,12 +1,15 @@
 #ifndef BSE_RECEIVER_H
 #define BSE_RECEIVER_H
 
+#include <memory>
 #include <string>
 #include <atomic>
 #include <vector>
 #include <functional>
 #include <thread>
 #include "socket_platform.h"
+#include "udp_batch_receiver.h"
+#include "udp_capture.h"
 
 #include "bse_protocol.h"
 #include "bse_parser.h"
@@ -23,15 +26,44 @@ struct ReceiverStats {
     uint64_t packetsDecoded = 0;
     uint64_t bytesReceived = 0;
     uint64_t errors = 0;
+    uint64_t recvCalls = 0; // recv()/recvmmsg() calls that returned data
+    uint64_t packetsTruncated = 0; // Cut to the slot size by recvmmsg() - dropped
+
+    double packetsPerSyscall() const {
+        return recvCalls > 0 ? static_cast<double>(packetsReceived) / recvCalls : 0.0;
+    }
 };
 
 class BSEReceiver {
 public:
     BSEReceiver(const std::string& ip, int port, const std::string& segment);
+    // Offline receiver (no socket) for capture replay - feed it with injectDatagram()
+    explicit BSEReceiver(const std::string& segment);
     ~BSEReceiver();
 
     void start();
     void stop();
+
+    // Select the Linux recvmmsg() ingest path (call before start()).
+    // Falls back to one recv() per datagram when unsupported.
+    void setBatchedIngest(bool enabled,
+                          size_t batchSize = udp_ingest::BatchReceiver::kDefaultBatchSize) {
+        batchedIngest_ = enabled;
+        ingestBatchSize_ = batchSize;
+    }
+    bool isBatchedIngestActive() const { return batchActive_; }
+
+    // Append every received datagram to a pcap file (call before start()).
+    // Returns false if the file could not be created.
+    bool startCapture(const std::string& path);
+    const udp_capture::CaptureWriter* capture() const { return capture_.get(); }
+
+    // Run one captured datagram through the packet loop (offline replay).
+    // Call from a single thread - it stands in for the receive thread.
+    void injectDatagram(const uint8_t* data, size_t length) {
+        stats_.recvCalls++;
+        processDatagram(data, static_cast<ssize_t>(length));
+    }
     
     // Callback setters - forward to parser
     void setRecordCallback(BSEParser::RecordCallback callback) { parser_.setRecordCallback(callback); }
@@ -47,7 +79,10 @@ public:
 
 private:
     void receiveLoop();
+    void runBatchedLoop();
+    void processDatagram(const uint8_t* data, ssize_t n);
     bool validatePacket(const uint8_t* buffer, size_t length);
+    void setParserSegment();
     
     std::string ip_;
     int port_;
@@ -59,6 +94,13 @@ private:
     std::thread receiverThread_;
     
     alignas(8) uint8_t buffer_[2048]; // Receive buffer
+
+    udp_ingest::BatchReceiver batch_;
+    bool batchedIngest_ = false;
+    size_t ingestBatchSize_ = udp_ingest::BatchReceiver::kDefaultBatchSize;
+    std::atomic<bool> batchActive_{false};
+
+    std::unique_ptr<udp_capture::CaptureWriter> capture_;
     
     ReceiverStats stats_;
     ParserStats parserStats_;
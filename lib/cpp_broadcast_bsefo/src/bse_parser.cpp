@@ -1,6 +1,7 @@
 #include "bse_parser.h"
 #include "bse_utils.h"
 #include "bse_price_store.h"
+#include "udp_batch_receiver.h"
 #include <iostream>
 #include <chrono>
 #include <unordered_map>
@@ -67,8 +68,8 @@ void BSEParser::decodeMarketPicture(const uint8_t* buffer, size_t length, uint16
     size_t recordSlotSize = 264; // Fixed slot size
     size_t numRecords = (length - HEADER_SIZE) / recordSlotSize;
     
-    auto now = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
+    // Kernel receive time of this datagram (steady clock), as in the NSE parsers
+    auto now = udp_ingest::packetTimestampOrNow();
         
     // Determine target store
     PriceStore* store = nullptr;
@@ -143,8 +144,7 @@ void BSEParser::decodeOpenInterest(const uint8_t* buffer, size_t length, uint16_
     constexpr size_t OI_RECORD_SIZE = 34; // Manual says 34 bytes
     size_t recordStart = HEADER_SIZE;
     
-    auto now = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
+    auto now = udp_ingest::packetTimestampOrNow();
 
     // Determine target store
     PriceStore* store = nullptr;
@@ -180,8 +180,9 @@ void BSEParser::decodeSessionState(const uint8_t* buffer, size_t length, ParserS
     if (length < HEADER_SIZE + 8) return;
     
     const uint8_t* data = buffer + HEADER_SIZE;
-    auto now = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
+    // Receive time on the pipeline's steady clock (latency); the session
+    // timestamp below stays wall time
+    auto now = udp_ingest::packetTimestampOrNow();
         
     DecodedSessionState state;
     state.packetTimestamp = now;
@@ -189,7 +190,8 @@ void BSEParser::decodeSessionState(const uint8_t* buffer, size_t length, ParserS
     state.marketSegmentId = le16toh_func(*(uint16_t*)(data + 4));
     state.marketType = *(data + 6);
     state.startEndFlag = *(data + 7);
-    state.timestamp = now;
+    state.timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
     
     stats.packetsDecoded++;
     if (sessionStateCallback_) sessionStateCallback_(state);
@@ -205,8 +207,7 @@ void BSEParser::decodeClosePrice(const uint8_t* buffer, size_t length, uint16_t
         numRecords = (length - HEADER_SIZE) / recordSlotSize;
     }
     
-    auto now = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
+    auto now = udp_ingest::packetTimestampOrNow();
 
     // Determine target store
     PriceStore* store = nullptr;
@@ -239,8 +240,7 @@ void BSEParser::decodeIndex(const uint8_t* buffer, size_t length, uint16_t msgTy
     // 2012 Index Record
     size_t recordSlotSize = 120; // Estimated/Previous assumption
     size_t numRecords = (length - HEADER_SIZE) / recordSlotSize;
-    auto now = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
+    auto now = udp_ingest::packetTimestampOrNow();
         
     // Determine target index store
     IndexStore* store = nullptr;
@@ -283,8 +283,7 @@ void BSEParser::decodeImpliedVolatility(const uint8_t* buffer, size_t length, ui
     size_t recordSize = 72; 
     size_t recordStart = HEADER_SIZE;
     
-    auto now = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
+    auto now = udp_ingest::packetTimestampOrNow();
         
     // Determine target store
     PriceStore* store = nullptr;
@@ -347,8 +346,7 @@ void BSEParser::decodeRBIReferenceRate(const uint8_t* buffer, size_t length, Par
     // Safety check on offset
     size_t recordStart = 38; 
     
-    auto now = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count();
+    auto now = udp_ingest::packetTimestampOrNow();
 
     for (uint16_t i = 0; i < numRecords; i++) {
         size_t offset = recordStart + (i * 24);
@@ -8,89 +8,63 @@ namespace bse {
 // PRICE STORE IMPLEMENTATION
 // ============================================================================
 
-PriceStore::PriceStore() {
-    tokenStates.assign(MAX_TOKENS + 1, nullptr);
-}
+PriceStore::PriceStore() : slab(0, MAX_TOKENS + 1) {}
 
-PriceStore::~PriceStore() {
-    for (auto* ptr : tokenStates) {
-        delete ptr;
-    }
-}
-
-const UnifiedTokenState* PriceStore::getUnifiedState(uint32_t token) const {
-    if (token >= tokenStates.size()) return nullptr;
-    std::shared_lock<std::shared_mutex> lock(mutex);
-    return tokenStates[token];
-}
+PriceStore::~PriceStore() = default;
 
 void PriceStore::updateMarketPicture(uint32_t token, double ltp, double open, double high, double low, double close,
                          uint64_t volume, uint64_t turnover, uint64_t ltq, double atp,
                          uint64_t totalBuy, uint64_t totalSell, double lowerCir, double upperCir,
                          const bse::DecodedDepthLevel* bids, const bse::DecodedDepthLevel* asks,
                          uint64_t timestamp) {
-    if (token >= tokenStates.size()) return;
-    
-    std::unique_lock<std::shared_mutex> lock(mutex);
-    if (!tokenStates[token]) return;
-    UnifiedTokenState& state = *tokenStates[token];
-    
-    state.token = token;
-    state.ltp = ltp;
-    state.open = open;
-    state.high = high;
-    state.low = low;
-    state.close = close; // Prev Close
-    state.volume = volume;
-    state.turnover = turnover;
-    state.lastTradeQty = ltq;
-    state.avgPrice = atp;
-    state.totalBuyQty = totalBuy;
-    state.totalSellQty = totalSell;
-    state.lowerCircuit = lowerCir;
-    state.upperCircuit = upperCir;
-    
-    // Depth (Fixed Copy)
-    if (bids) {
-        for (int i = 0; i < 5; i++) {
-            state.bids[i].price = bids[i].price;
-            state.bids[i].quantity = bids[i].quantity;
-            state.bids[i].orders = bids[i].numOrders;
+    slab.update(token, [&](Row state) {
+        state.tick.token = token;
+        state.tick.ltp = ltp;
+        state.tick.open = open;
+        state.tick.high = high;
+        state.tick.low = low;
+        state.tick.close = close; // Prev Close
+        state.tick.volume = volume;
+        state.tick.turnover = turnover;
+        state.tick.lastTradeQty = ltq;
+        state.tick.avgPrice = atp;
+        state.depth.totalBuyQty = totalBuy;
+        state.depth.totalSellQty = totalSell;
+        state.tick.lowerCircuit = lowerCir;
+        state.tick.upperCircuit = upperCir;
+        
+        // Depth (Fixed Copy)
+        if (bids) {
+            for (int i = 0; i < 5; i++) {
+                state.depth.bids[i].price = bids[i].price;
+                state.depth.bids[i].quantity = bids[i].quantity;
+                state.depth.bids[i].orders = bids[i].numOrders;
+            }
         }
-    }
-    
-    if (asks) {
-        for (int i = 0; i < 5; i++) {
-            state.asks[i].price = asks[i].price;
-            state.asks[i].quantity = asks[i].quantity;
-            state.asks[i].orders = asks[i].numOrders;
+        
+        if (asks) {
+            for (int i = 0; i < 5; i++) {
+                state.depth.asks[i].price = asks[i].price;
+                state.depth.asks[i].quantity = asks[i].quantity;
+                state.depth.asks[i].orders = asks[i].numOrders;
+            }
         }
-    }
-    
-    state.lastPacketTimestamp = timestamp;
-    state.isUpdated = true;
+        
+        state.tick.lastPacketTimestamp = timestamp;
+        state.tick.isUpdated = true;
+    });
 }
 
 void PriceStore::updateOpenInterest(uint32_t token, int64_t oi, int32_t oiChange, uint64_t timestamp) {
-    if (token >= tokenStates.size()) return;
-    
-    std::unique_lock<std::shared_mutex> lock(mutex);
-    if (!tokenStates[token]) return;
-    UnifiedTokenState& state = *tokenStates[token];
-    
-    state.openInterest = oi;
-    state.openInterestChange = oiChange;
-    state.lastPacketTimestamp = timestamp;
-    state.isUpdated = true;
+    slab.update(token, [&](Row state) {
+        state.tick.openInterest = oi;
+        state.tick.openInterestChange = oiChange;
+        state.tick.lastPacketTimestamp = timestamp;
+        state.tick.isUpdated = true;
+    });
 }
 
 void PriceStore::updateClosePrice(uint32_t token, double closePrice, uint64_t timestamp) {
-    if (token >= tokenStates.size()) return;
-    
-    std::unique_lock<std::shared_mutex> lock(mutex);
-    if (!tokenStates[token]) return;
-    UnifiedTokenState& state = *tokenStates[token];
-    
     // Message 2014 is "Close Price", effectively updating the closing price for the day
     // Wait, is it Prev Close or Today's Close?
     // Usually it's the final close price.
@@ -105,89 +79,69 @@ void PriceStore::updateClosePrice(uint32_t token, double closePrice, uint64_t ti
     // "udpTick.prevClose = cp.closePrice / 100.0;"
     // So distinct message 2014 updates PrevClose? That sounds like next-day prep.
     // Let's update `close` field aka PrevClose.
-    
-    state.close = closePrice;
-    state.lastPacketTimestamp = timestamp;
-    state.isUpdated = true;
+    slab.update(token, [&](Row state) {
+        state.tick.close = closePrice;
+        state.tick.lastPacketTimestamp = timestamp;
+        state.tick.isUpdated = true;
+    });
 }
 
 void PriceStore::updateImpliedVolatility(uint32_t token, int64_t iv, uint64_t timestamp) {
-    if (token >= tokenStates.size()) return;
-    
-    std::unique_lock<std::shared_mutex> lock(mutex);
-    if (!tokenStates[token]) return;
-    UnifiedTokenState& state = *tokenStates[token];
-    
-    state.impliedVolatility = iv;
-    state.lastPacketTimestamp = timestamp;
-    state.isUpdated = true;
+    slab.updateGreeks(token, [&](MarketData::GreeksState& greeks) {
+        greeks.impliedVolatility = iv;
+    });
+    slab.update(token, [&](Row state) {
+        state.tick.lastPacketTimestamp = timestamp;
+        state.tick.isUpdated = true;
+    });
 }
 
 void PriceStore::updateGreeks(uint32_t token, double iv, double bidIV, double askIV,
                               double delta, double gamma, double vega, double theta,
                               double theoreticalPrice, int64_t timestamp) {
-    if (token >= tokenStates.size()) return;
-    
-    std::unique_lock<std::shared_mutex> lock(mutex);
-    if (!tokenStates[token]) return;
-    UnifiedTokenState& state = *tokenStates[token];
-    
-    state.impliedVolatility = iv;
-    state.bidIV = bidIV;
-    state.askIV = askIV;
-    state.delta = delta;
-    state.gamma = gamma;
-    state.vega = vega;
-    state.theta = theta;
-    state.theoreticalPrice = theoreticalPrice;
-    state.greeksCalculated = true;
-    state.lastGreeksUpdateTime = timestamp;
-    state.lastPacketTimestamp = timestamp;
-    state.isUpdated = true;
+    // Own seqlock: never waits on (or stalls) the feed writing the tick
+    slab.updateGreeks(token, [&](MarketData::GreeksState& greeks) {
+        greeks.impliedVolatility = iv;
+        greeks.bidIV = bidIV;
+        greeks.askIV = askIV;
+        greeks.delta = delta;
+        greeks.gamma = gamma;
+        greeks.vega = vega;
+        greeks.theta = theta;
+        greeks.theoreticalPrice = theoreticalPrice;
+        greeks.greeksCalculated = true;
+        greeks.lastGreeksUpdateTime = timestamp;
+    });
 }
 
 void PriceStore::initializeToken(uint32_t token, const char* symbol, const char* name, const char* scripCode,
                                 const char* series, int32_t lot, double strike, const char* optType, const char* expiry,
                                 int32_t assetToken, int32_t instType, double tick) {
-    if (token >= tokenStates.size()) {
-        std::unique_lock<std::shared_mutex> lock(mutex);
-        tokenStates.resize(token + 1, nullptr);
-    }
-    
-    std::unique_lock<std::shared_mutex> lock(mutex);
-    if (!tokenStates[token]) {
-        tokenStates[token] = new UnifiedTokenState();
-    }
-    UnifiedTokenState& state = *tokenStates[token];
-    
-    state.token = token;
-    if (symbol) strncpy(state.symbol, symbol, sizeof(state.symbol) - 1);
-    if (name) strncpy(state.displayName, name, sizeof(state.displayName) - 1);
-    if (scripCode) strncpy(state.scripCode, scripCode, sizeof(state.scripCode) - 1);
-    if (series) strncpy(state.series, series, sizeof(state.series) - 1);
-    if (optType) strncpy(state.optionType, optType, sizeof(state.optionType) - 1);
-    if (expiry) strncpy(state.expiryDate, expiry, sizeof(state.expiryDate) - 1);
-    
-    state.lotSize = lot;
-    state.strikePrice = strike;
-    state.assetToken = assetToken;
-    state.instrumentType = instType;
-    state.tickSize = tick;
-    state.isUpdated = true;
+    // Slab grows its index for tokens beyond the current range
+    slab.initialize(token, [&](Row state) {
+        state.tick.token = token;
+        if (symbol) strncpy(state.info.symbol, symbol, sizeof(state.info.symbol) - 1);
+        if (name) strncpy(state.info.displayName, name, sizeof(state.info.displayName) - 1);
+        if (scripCode) strncpy(state.info.scripCode, scripCode, sizeof(state.info.scripCode) - 1);
+        if (series) strncpy(state.info.series, series, sizeof(state.info.series) - 1);
+        if (optType) strncpy(state.info.optionType, optType, sizeof(state.info.optionType) - 1);
+        if (expiry) strncpy(state.info.expiryDate, expiry, sizeof(state.info.expiryDate) - 1);
+        
+        state.info.lotSize = lot;
+        state.info.strikePrice = strike;
+        state.info.assetToken = assetToken;
+        state.info.instrumentType = instType;
+        state.info.tickSize = tick;
+        state.tick.isUpdated = true;
+    });
 }
 
 void PriceStore::clear() {
-    std::unique_lock<std::shared_mutex> lock(mutex);
-    for (auto* ptr : tokenStates) {
-        delete ptr;
-    }
-    tokenStates.assign(MAX_TOKENS + 1, nullptr);
+    slab.clear();
 }
 
 bool PriceStore::isValidToken(uint32_t token) const {
-    if (token >= tokenStates.size()) return false;
-    std::shared_lock<std::shared_mutex> lock(mutex);
-    return tokenStates[token] != nullptr;
+    return slab.contains(token);
 }
 
 void PriceStore::initializeFromMaster(const std::vector<uint32_t>& tokens) {
@@ -198,17 +152,14 @@ void PriceStore::initializeFromMaster(const std::vector<uint32_t>& tokens) {
         if (t > maxToken) maxToken = t;
     }
 
-    std::unique_lock<std::shared_mutex> lock(mutex);
-    if (maxToken >= tokenStates.size()) {
-        tokenStates.resize(maxToken + 10000, nullptr);
-    }
+    slab.reserveTokens(maxToken + 10000);
+    slab.reserve(tokens.size());
     
     for (uint32_t t : tokens) {
-        if (t >= tokenStates.size()) continue;
-        if (!tokenStates[t]) {
-            tokenStates[t] = new UnifiedTokenState();
-            tokenStates[t]->token = t;
-        }
+        if (slab.contains(t)) continue;
+        slab.initialize(t, [t](Row state) {
+            state.tick.token = t;
+        });
     }
 }
 
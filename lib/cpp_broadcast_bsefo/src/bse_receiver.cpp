@@ -84,6 +84,16 @@ BSEReceiver::BSEReceiver(const std::string& ip, int port, const std::string& seg
 
     std::cout << "[" << segment_ << "] Connected to " << ip_ << ":" << port_ << std::endl;
 
+    setParserSegment();
+}
+
+BSEReceiver::BSEReceiver(const std::string& segment)
+    : port_(0), segment_(segment), sockfd_(socket_invalid), running_(false) {
+    memset(&addr_, 0, sizeof(addr_));
+    setParserSegment();
+}
+
+void BSEReceiver::setParserSegment() {
     // Set parser market segment for PriceCache writes
     // Maps to PriceCacheTypes::MarketSegment enum:
     // NSE_CM=1, NSE_FO=2, BSE_CM=11, BSE_FO=12
@@ -94,6 +104,17 @@ BSEReceiver::BSEReceiver(const std::string& ip, int port, const std::string& seg
     parser_.setMarketSegment(segParams);
 }
 
+bool BSEReceiver::startCapture(const std::string& path) {
+    auto writer = std::make_unique<udp_capture::CaptureWriter>();
+    if (!writer->open(path, ip_, static_cast<uint16_t>(port_))) {
+        std::cerr << "[" << segment_ << "] Failed to open capture file: " << path << std::endl;
+        return false;
+    }
+    capture_ = std::move(writer);
+    std::cout << "[" << segment_ << "] Capturing datagrams to " << path << std::endl;
+    return true;
+}
+
 BSEReceiver::~BSEReceiver() {
     stop();
     if (sockfd_ != socket_invalid) {
@@ -109,6 +130,7 @@ void BSEReceiver::start() {
 
 void BSEReceiver::stop() {
     running_ = false;
+    batch_.wakeup();  // Unblock epoll_wait() in batched mode
     if (receiverThread_.joinable()) {
         receiverThread_.join();
     }
@@ -117,6 +139,16 @@ void BSEReceiver::stop() {
 void BSEReceiver::receiveLoop() {
     std::cout << "[" << segment_ << "] Starting receive loop on " << ip_ << ":" << port_ << "..." << std::endl;
     
+    if (batchedIngest_ && udp_ingest::BatchReceiver::isSupported() &&
+        batch_.open(sockfd_, ingestBatchSize_, sizeof(buffer_))) {
+        std::cout << "[" << segment_ << "] Batched ingest enabled (recvmmsg x" << ingestBatchSize_
+                  << (batch_.hasKernelTimestamps() ? ", kernel timestamps" : "") << ")" << std::endl;
+        batchActive_ = true;
+        runBatchedLoop();
+        batchActive_ = false;
+        return;
+    }
+    
     while (running_) {
         // Receive packet
 #ifdef _WIN32
@@ -130,17 +162,49 @@ void BSEReceiver::receiveLoop() {
             continue;
         }
         
-        stats_.packetsReceived++;
-        stats_.bytesReceived += n;
+        stats_.recvCalls++;
+        processDatagram(buffer_, n);
+    }
+}
+
+void BSEReceiver::runBatchedLoop() {
+    // stop() may have run before the eventfd existed - re-check after open()
+    while (running_) {
+        int count = batch_.receive();
+        if (count < 0) {
+            std::cerr << "[" << segment_ << "] recvmmsg() error: "
+                      << socket_error_string(socket_errno) << std::endl;
+            break;
+        }
+        if (count == 0) continue;  // Woken by stop() or spurious wakeup
         
-        if (validatePacket(buffer_, n)) {
-            stats_.packetsValid++;
-            parser_.parsePacket(buffer_, n, parserStats_);
-        } else {
-            stats_.packetsInvalid++;
-            if (stats_.packetsInvalid % 10 == 0) {
-                std::cerr << "[" << segment_ << "] ⚠ Invalid packet received! Length: " << n << std::endl;
+        stats_.recvCalls++;
+        for (int i = 0; i < count; ++i) {
+            if (batch_.truncated(i)) {  // Larger than a slot: the tail is gone
+                stats_.packetsTruncated++;
+                continue;
             }
+            udp_ingest::setCurrentPacketTimestamp(batch_.timestampMicros(i));
+            processDatagram(reinterpret_cast<const uint8_t*>(batch_.data(i)),
+                            static_cast<ssize_t>(batch_.length(i)));
+        }
+        udp_ingest::setCurrentPacketTimestamp(0);
+    }
+}
+
+void BSEReceiver::processDatagram(const uint8_t* data, ssize_t n) {
+    if (capture_) capture_->write(data, static_cast<size_t>(n));
+
+    stats_.packetsReceived++;
+    stats_.bytesReceived += n;
+    
+    if (validatePacket(data, n)) {
+        stats_.packetsValid++;
+        parser_.parsePacket(data, n, parserStats_);
+    } else {
+        stats_.packetsInvalid++;
+        if (stats_.packetsInvalid % 10 == 0) {
+            std::cerr << "[" << segment_ << "] ⚠ Invalid packet received! Length: " << n << std::endl;
         }
     }
 }
@@ -1,8 +1,11 @@
 #ifndef NSECM_MULTICAST_RECEIVER_H
 #define NSECM_MULTICAST_RECEIVER_H
 
+#include <memory>
 #include <string>
 #include "socket_platform.h"
+#include "udp_batch_receiver.h"
+#include "udp_capture.h"
 #include <atomic>
 #include "nsecm_udp_receiver.h"
 
@@ -13,10 +16,38 @@ constexpr size_t kBufferSize = 65535;
 class MulticastReceiver {
 public:
     MulticastReceiver(const std::string& ip, int port);
+    // Offline receiver (no socket) for capture replay – feed it with injectDatagram()
+    MulticastReceiver();
     ~MulticastReceiver();
 
     void start();
     void stop();
+
+    /**
+     * @brief Select the Linux recvmmsg() ingest path (call before start()).
+     * @param enabled Pull up to batchSize datagrams per syscall with kernel
+     *                receive timestamps; falls back to recv() when unsupported
+     * @param batchSize Datagrams per recvmmsg() call
+     */
+    void setBatchedIngest(bool enabled,
+                          size_t batchSize = udp_ingest::BatchReceiver::kDefaultBatchSize) {
+        batchedIngest = enabled;
+        ingestBatchSize = batchSize;
+    }
+    bool isBatchedIngestActive() const { return batchActive; }
+
+    /**
+     * @brief Append every received datagram to a pcap file (call before start()).
+     * @return false if the file could not be created
+     */
+    bool startCapture(const std::string& path);
+    const udp_capture::CaptureWriter* capture() const { return captureWriter.get(); }
+
+    /**
+     * @brief Run one captured datagram through the packet loop (offline replay).
+     * Call from a single thread – it stands in for the receive thread.
+     */
+    void injectDatagram(const uint8_t* data, size_t length);
     
     // Check if receiver is properly initialized
     bool isValid() const { return sockfd != socket_invalid; }
@@ -25,11 +56,26 @@ public:
     const UDPStats& getStats() const { return stats; }
 
 private:
+    void runLegacyLoop();
+    void runBatchedLoop();
+    void processDatagram(char* data, ssize_t n);
+
     socket_t sockfd;
     struct sockaddr_in addr;
     std::atomic<bool> running;
     
     alignas(8) char buffer[kBufferSize];
+
+    // Batched ingest (recvmmsg ring + eventfd wakeup)
+    udp_ingest::BatchReceiver batch;
+    bool batchedIngest = false;
+    size_t ingestBatchSize = udp_ingest::BatchReceiver::kDefaultBatchSize;
+    std::atomic<bool> batchActive{false};
+
+    // Raw datagram capture (startCapture)
+    std::string groupIp;
+    int groupPort = 0;
+    std::unique_ptr<udp_capture::CaptureWriter> captureWriter;
     
     // Statistics tracking
     UDPStats stats;
@@ -2,23 +2,25 @@
 #define NSECM_PRICE_STORE_H
 
 #include <vector>
-#include <shared_mutex>
 #include <atomic>
 #include <cstring>
+#include <unordered_map>
 #include <QDebug>
 #include "nsecm_callback.h"
 
 #include "data/UnifiedPriceState.h"
+#include "data/SeqlockPriceSlab.h"
 
 namespace nsecm {
 
 using UnifiedTokenState = MarketData::UnifiedState;
+using Row = MarketData::SeqlockPriceSlab::RowRef;
 
 
 /**
  * @brief Thread-Safe Distributed Price Store for NSE CM
- * Uses a pre-allocated vector for O(1) access by token ID.
- * Protected by shared_mutex for concurrent reads and exclusive writes.
+ * Rows live in a contiguous seqlock slab indexed by token ID (O(1) access).
+ * Readers are lock-free; a read overlapping a write retries.
  */
 class PriceStore {
 public:
@@ -31,96 +33,134 @@ public:
     void initializeToken(uint32_t token, const char* symbol, const char* series, 
                         const char* displayName, int32_t lotSize, double tickSize,
                         double priceBandHigh, double priceBandLow);
+    void reserve(size_t tokenCount) { slab.reserve(tokenCount); }
+    // Drop a contract removed from the master (incremental refresh)
+    bool removeToken(uint32_t token) { return slab.erase(token); }
     
     // Updates
     void updateTouchline(int32_t token, double ltp, double open, double high, double low, double close,
                         uint64_t volume, uint32_t lastTradeQty, uint32_t lastTradeTime,
                         double avgPrice, double netChange, char netChangeInd, uint16_t status, uint16_t bookType) {
-        if (token < 0 || token >= (int32_t)tokenStates.size()) return;
-        std::unique_lock lock(mutex);
-        if (!tokenStates[token]) {
-            // qDebug() << "[NSECM Store] updateTouchline FAILED: Token" << token << "not initialized!";
-            return;
-        }
-        auto& row = *tokenStates[token];
-        
-        // // Debug log for index tokens (26000-26999)
-        // if (token >= 26000 && token <= 26999) {
-        //     qDebug() << "[NSECM Store] updateTouchline: Token=" << token 
-        //              << "LTP=" << ltp << "Volume=" << volume;
-        // }
-        
-        row.ltp = ltp;
-        row.open = open;
-        row.high = high;
-        row.low = low;
-        row.close = close;
-        row.volume = volume;
-        row.lastTradeQty = lastTradeQty;
-        row.lastTradeTime = lastTradeTime;
-        row.avgPrice = avgPrice;
-        row.netChange = netChange;
-        row.netChangeIndicator = netChangeInd;
-        row.tradingStatus = status;
-        row.bookType = bookType;
-        row.isUpdated = true;
+        if (token < 0 || token > (int32_t)MAX_TOKENS) return;
+        slab.update(static_cast<uint32_t>(token), [&](Row row) {
+            // // Debug log for index tokens (26000-26999)
+            // if (token >= 26000 && token <= 26999) {
+            //     qDebug() << "[NSECM Store] updateTouchline: Token=" << token 
+            //              << "LTP=" << ltp << "Volume=" << volume;
+            // }
+            
+            row.tick.ltp = ltp;
+            row.tick.open = open;
+            row.tick.high = high;
+            row.tick.low = low;
+            row.tick.close = close;
+            row.tick.volume = volume;
+            row.tick.lastTradeQty = lastTradeQty;
+            row.tick.lastTradeTime = lastTradeTime;
+            row.tick.avgPrice = avgPrice;
+            row.tick.netChange = netChange;
+            row.tick.netChangeIndicator = netChangeInd;
+            row.tick.tradingStatus = status;
+            row.tick.bookType = bookType;
+            row.tick.isUpdated = true;
+        });
     }
                         
     void updateMarketDepth(int32_t token, const DepthLevel* bids, const DepthLevel* asks,
                           uint64_t totalBuy, uint64_t totalSell) {
-        if (token < 0 || token >= (int32_t)tokenStates.size()) return;
-        std::unique_lock lock(mutex);
-        if (!tokenStates[token]) return;
-        auto& row = *tokenStates[token];
-        if (bids) std::memcpy(row.bids, bids, sizeof(row.bids));
-        if (asks) std::memcpy(row.asks, asks, sizeof(row.asks));
-        row.totalBuyQty = totalBuy;
-        row.totalSellQty = totalSell;
-        row.isUpdated = true;
+        if (token < 0 || token > (int32_t)MAX_TOKENS) return;
+        slab.update(static_cast<uint32_t>(token), [&](Row row) {
+            if (bids) std::memcpy(row.depth.bids, bids, sizeof(row.depth.bids));
+            if (asks) std::memcpy(row.depth.asks, asks, sizeof(row.depth.asks));
+            row.depth.totalBuyQty = totalBuy;
+            row.depth.totalSellQty = totalSell;
+            row.tick.isUpdated = true;
+        });
     }
                           
     void updateTicker(int32_t token, double fillPrice, uint64_t fillVol) {
-        if (token < 0 || token >= (int32_t)tokenStates.size()) return;
-        std::unique_lock lock(mutex);
-        if (!tokenStates[token]) return;
+        if (token < 0 || token > (int32_t)MAX_TOKENS) return;
         // Ticker update normally updates LTP and last trade info
-        auto& row = *tokenStates[token];
-        row.ltp = fillPrice;
-        row.lastTradeQty = (uint32_t)fillVol;
-        row.isUpdated = true;
+        slab.update(static_cast<uint32_t>(token), [&](Row row) {
+            row.tick.ltp = fillPrice;
+            row.tick.lastTradeQty = (uint32_t)fillVol;
+            row.tick.isUpdated = true;
+        });
     }
     
     // Read Access
-    /**
-     * @deprecated Use getUnifiedSnapshot() for thread-safe access
-     */
-    const UnifiedTokenState* getUnifiedState(int32_t token) const;
-    
     /**
      * @brief Get thread-safe snapshot copy of token state
-     * @return Copy of token state, guaranteed consistent under lock
+     * @return Consistent copy of token state (seqlock retry on torn read)
      * @note Returns empty state (token=0) if not found
      */
     [[nodiscard]] UnifiedTokenState getUnifiedSnapshot(int32_t token) const {
-        if (token < 0 || token >= (int32_t)tokenStates.size()) return UnifiedTokenState{};
-        std::shared_lock lock(mutex);
-        if (!tokenStates[token]) return UnifiedTokenState{};
-        return *tokenStates[token]; // Copy under lock - thread safe
+        if (token < 0 || token > (int32_t)MAX_TOKENS) return UnifiedTokenState{};
+        UnifiedTokenState state;
+        if (!slab.read(static_cast<uint32_t>(token), state)) return UnifiedTokenState{};
+        return state;
+    }
+
+    /**
+     * @brief Partial snapshots: copy one block instead of the full state
+     * @note Return an empty block if not found
+     */
+    [[nodiscard]] MarketData::TouchlineState getTouchline(int32_t token) const {
+        MarketData::TouchlineState tick;
+        if (token < 0 || token > (int32_t)MAX_TOKENS ||
+            !slab.readTouchline(static_cast<uint32_t>(token), tick)) {
+            return MarketData::TouchlineState{};
+        }
+        return tick;
+    }
+
+    [[nodiscard]] MarketData::DepthState getDepth(int32_t token) const {
+        MarketData::DepthState depth;
+        if (token < 0 || token > (int32_t)MAX_TOKENS ||
+            !slab.readDepth(static_cast<uint32_t>(token), depth)) {
+            return MarketData::DepthState{};
+        }
+        return depth;
+    }
+
+    // =========================================================
+    // VERSIONS (dirty tracking for pollers)
+    // =========================================================
+
+    /**
+     * @brief Current version epoch (advanced by changedSince(), not by updates)
+     */
+    uint64_t getVersion() const { return slab.version(); }
+
+    /**
+     * @brief Number of updates to token's row; 0 if the token has no row
+     */
+    uint64_t getRowVersion(uint32_t token) const { return slab.rowVersion(token); }
+
+    /**
+     * @brief Append the Block of each token updated after sinceVersion
+     * @return Watermark to pass as sinceVersion on the next call
+     * @see MarketData::SeqlockPriceSlab::changedSince
+     */
+    template <typename Block>
+    uint64_t changedSince(uint64_t sinceVersion, const uint32_t* tokens, size_t count,
+                          std::vector<MarketData::VersionedBlock<Block>>& out) const {
+        return slab.changedSince(sinceVersion, tokens, count, out);
     }
-    
-    ~PriceStore();
     
     // Index Store (Keep simple generic access or separate class?)
     // For now, IndexStore is separate in nsecm_price_store.cpp/h, 
     // but the previous header had it inline. I will declare the class here to keep it compiling.
     
     size_t getTokenCount() const { return MAX_TOKENS; }
+
+    // Torn reads retried by getUnifiedSnapshot() (contention diagnostics)
+    uint64_t getReadRetries() const { return slab.readRetries(); }
     
     void clear();
 
 private:
-    std::vector<UnifiedTokenState*> tokenStates;
-    mutable std::shared_mutex mutex;
+    MarketData::SeqlockPriceSlab slab;
 };
 
 //min token for indiaces 26000
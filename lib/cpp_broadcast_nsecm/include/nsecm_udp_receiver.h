@@ -6,6 +6,7 @@
 #include <map>
 #include <chrono>
 #include <iostream>
+#include "sequence_gap_tracker.h"
 
 namespace nsecm {
 
@@ -24,11 +25,24 @@ public:
     uint64_t compressedPackets{0};
     uint64_t decompressedPackets{0};
     uint64_t decompressionFailures{0};
+    // Receive syscall accounting – datagramsReceived / recvCalls is the
+    // packets-per-syscall ratio (1.0 for recv(), up to batch size for recvmmsg())
+    uint64_t recvCalls{0};
+    uint64_t datagramsReceived{0};
+    // Datagrams recvmmsg() cut to the slot size (MSG_TRUNC) – dropped unparsed
+    uint64_t truncatedDatagrams{0};
+    // Per-stream bcSeqNo gap / out-of-order accounting (receive thread writes)
+    common::SequenceGapTracker sequence;
     std::chrono::steady_clock::time_point startTime;
 
     UDPStats();
     void update(uint16_t code, int compressedSize, int rawSize, bool error);
     void recordPacket();  // Record a packet without detailed stats
+    void recordReceiveCall(int datagrams) { recvCalls++; datagramsReceived += datagrams; }
+    void recordTruncated() { truncatedDatagrams++; }
+    double packetsPerSyscall() const {
+        return recvCalls > 0 ? static_cast<double>(datagramsReceived) / recvCalls : 0.0;
+    }
     void print();
     
     // Output operator for easy printing
@@ -12,7 +12,8 @@
 namespace nsecm {
 
 MulticastReceiver::MulticastReceiver(const std::string &ip, int port)
-    : sockfd(socket_invalid), running(false), lastSeqNo(0) {
+    : sockfd(socket_invalid), running(false), groupIp(ip), groupPort(port),
+      lastSeqNo(0) {
   WinsockLoader::init();
 
   // Create socket
@@ -77,6 +78,11 @@ MulticastReceiver::MulticastReceiver(const std::string &ip, int port)
             << kBufferSize << " bytes)" << std::endl;
 }
 
+MulticastReceiver::MulticastReceiver()
+    : sockfd(socket_invalid), running(false), lastSeqNo(0) {
+  std::memset(&addr, 0, sizeof(addr));
+}
+
 MulticastReceiver::~MulticastReceiver() {
   stop();
   if (sockfd != socket_invalid) {
@@ -95,8 +101,23 @@ void MulticastReceiver::start() {
   running = true;
   std::cout << "Starting MulticastReceiver... nsecm " << std::endl;
 
-  int packet_count = 0;
+  if (batchedIngest && udp_ingest::BatchReceiver::isSupported() &&
+      batch.open(sockfd, ingestBatchSize, kBufferSize)) {
+    std::cout << "MulticastReceiver: batched ingest enabled (recvmmsg x"
+              << ingestBatchSize
+              << (batch.hasKernelTimestamps() ? ", kernel timestamps" : "")
+              << ")" << std::endl;
+    batchActive = true;
+    runBatchedLoop();
+    batchActive = false;
+  } else {
+    runLegacyLoop();
+  }
 
+  std::cout << "MulticastReceiver stopped" << std::endl;
+}
+
+void MulticastReceiver::runLegacyLoop() {
   while (running) {
     ssize_t n = recv(sockfd, buffer, kBufferSize, 0);
 
@@ -111,91 +132,145 @@ void MulticastReceiver::start() {
       break;
     }
 
-    if (n < (ssize_t)sizeof(Packet)) {
-      stats.update(0, 0, 0, true); // Record error
-      continue;
+    stats.recordReceiveCall(1);
+    processDatagram(buffer, n);
+  }
+}
+
+void MulticastReceiver::runBatchedLoop() {
+  // stop() may have run before the eventfd existed - re-check after open()
+  while (running) {
+    int count = batch.receive();
+    if (count < 0) {
+      std::cerr << "recvmmsg() error: " << socket_error_string(socket_errno)
+                << std::endl;
+      break;
     }
+    if (count == 0)
+      continue; // Woken by stop() or spurious wakeup
+
+    stats.recordReceiveCall(count);
+    for (int i = 0; i < count; ++i) {
+      if (batch.truncated(i)) { // Larger than a slot: the tail is gone
+        stats.recordTruncated();
+        continue;
+      }
+      udp_ingest::setCurrentPacketTimestamp(batch.timestampMicros(i));
+      processDatagram(batch.data(i), static_cast<ssize_t>(batch.length(i)));
+    }
+    udp_ingest::setCurrentPacketTimestamp(0);
+  }
+}
 
-    packet_count++;
+bool MulticastReceiver::startCapture(const std::string &path) {
+  auto writer = std::make_unique<udp_capture::CaptureWriter>();
+  if (!writer->open(path, groupIp, static_cast<uint16_t>(groupPort))) {
+    std::cerr << "Failed to open capture file: " << path << std::endl;
+    return false;
+  }
+  captureWriter = std::move(writer);
+  std::cout << "MulticastReceiver: capturing datagrams to " << path
+            << std::endl;
+  return true;
+}
 
-    // Parse packet header
-    Packet *pkt = reinterpret_cast<Packet *>(buffer);
-    pkt->iNoOfMsgs = be16toh_func(pkt->iNoOfMsgs);
+void MulticastReceiver::injectDatagram(const uint8_t *data, size_t length) {
+  // processDatagram() byte-swaps the packet header in place - parse a copy
+  if (length > kBufferSize)
+    length = kBufferSize;
+  std::memcpy(buffer, data, length);
+  stats.recordReceiveCall(1);
+  processDatagram(buffer, static_cast<ssize_t>(length));
+}
 
-    // Parse messages
-    char *ptr = pkt->cPackData;
-    char *end = buffer + n;
+void MulticastReceiver::processDatagram(char *data, ssize_t n) {
+  if (captureWriter)
+    captureWriter->write(data, static_cast<size_t>(n));
 
-    for (int i = 0; i < pkt->iNoOfMsgs; ++i) {
-      try {
-        if (ptr + sizeof(int16_t) > end) {
-          stats.update(0, 0, 0, true); // Record error
-          break;
-        }
-
-        // Read iCompLen (first 2 bytes of MessageData)
-        int16_t iCompLen = be16toh_func(*((int16_t *)ptr));
+  if (n < (ssize_t)sizeof(Packet)) {
+    stats.update(0, 0, 0, true); // Record error
+    return;
+  }
 
-        if (iCompLen > 0) {
-          // std::cout << "Processing compressed message of length " << iCompLen
-          // << std::endl; Compressed message
-          ptr += sizeof(int16_t);
+  // Parse packet header
+  Packet *pkt = reinterpret_cast<Packet *>(data);
+  pkt->iNoOfMsgs = be16toh_func(pkt->iNoOfMsgs);
 
-          if (ptr + iCompLen > end) {
-            stats.update(0, 0, 0, true); // Record error
-            break;
-          }
+  // Parse messages
+  char *ptr = pkt->cPackData;
+  char *end = data + n;
 
-          // Parse compressed message and update stats with transaction code
-          parse_compressed_message(ptr, iCompLen, stats);
+  for (int i = 0; i < pkt->iNoOfMsgs; ++i) {
+    try {
+      if (ptr + sizeof(int16_t) > end) {
+        stats.update(0, 0, 0, true); // Record error
+        break;
+      }
 
-          ptr += iCompLen;
+      // Read iCompLen (first 2 bytes of MessageData)
+      int16_t iCompLen = be16toh_func(*((int16_t *)ptr));
 
-        } else {
-          // Uncompressed message
-          if (ptr + 54 > end) {
-            stats.update(0, 0, 0, true); // Record error
-            break;
-          }
+      if (iCompLen > 0) {
+        // std::cout << "Processing compressed message of length " << iCompLen
+        // << std::endl; Compressed message
+        ptr += sizeof(int16_t);
 
-          // MessageLength is at offset 52 from packet start (ptr points to
-          // offset 4)
-          uint16_t msgLen = be16toh_func(*((uint16_t *)(ptr + 48)));
+        if (ptr + iCompLen > end) {
+          stats.update(0, 0, 0, true); // Record error
+          break;
+        }
 
-          if (ptr + 10 + msgLen > end) {
-            stats.update(0, 0, 0, true); // Record error
-            break;
-          }
+        // Parse compressed message and update stats with transaction code
+        parse_compressed_message(ptr, iCompLen, stats);
 
-          // Extract transaction code for stats
-          uint16_t txCode = be16toh_func(
-              *((uint16_t *)(ptr + 20))); // Offset 10 of BCAST_HEADER
+        ptr += iCompLen;
 
-          // Update stats
-          stats.update(txCode, 0, msgLen, false);
+      } else {
+        // Uncompressed message
+        if (ptr + 54 > end) {
+          stats.update(0, 0, 0, true); // Record error
+          break;
+        }
 
-          // Parse uncompressed message
-          // can you guide me why ptr + 10
-          parse_uncompressed_message(ptr + 10, msgLen);
+        // MessageLength is at offset 52 from packet start (ptr points to
+        // offset 4)
+        uint16_t msgLen = be16toh_func(*((uint16_t *)(ptr + 48)));
 
-          ptr += 10 + msgLen;
+        if (ptr + 10 + msgLen > end) {
+          stats.update(0, 0, 0, true); // Record error
+          break;
         }
-      } catch (const std::exception &e) {
-        std::cerr << "Exception processing message " << i << ": " << e.what()
-                  << std::endl;
-        stats.update(0, 0, 0, true); // Record error
-        break;                       // Skip rest of messages in this packet
-      } catch (...) {
-        std::cerr << "Unknown exception processing message " << i << std::endl;
-        stats.update(0, 0, 0, true); // Record error
-        break;                       // Skip rest of messages in this packet
+
+        // Extract transaction code for stats
+        uint16_t txCode = be16toh_func(
+            *((uint16_t *)(ptr + 20))); // Offset 10 of BCAST_HEADER
+
+        // Update stats
+        stats.update(txCode, 0, msgLen, false);
+        stats.sequence.observeHeader(reinterpret_cast<const uint8_t*>(ptr + 10));
+
+        // Parse uncompressed message
+        // can you guide me why ptr + 10
+        parse_uncompressed_message(ptr + 10, msgLen);
+
+        ptr += 10 + msgLen;
       }
+    } catch (const std::exception &e) {
+      std::cerr << "Exception processing message " << i << ": " << e.what()
+                << std::endl;
+      stats.update(0, 0, 0, true); // Record error
+      break;                       // Skip rest of messages in this packet
+    } catch (...) {
+      std::cerr << "Unknown exception processing message " << i << std::endl;
+      stats.update(0, 0, 0, true); // Record error
+      break;                       // Skip rest of messages in this packet
     }
   }
-
-  std::cout << "MulticastReceiver stopped" << std::endl;
 }
 
-void MulticastReceiver::stop() { running = false; }
+void MulticastReceiver::stop() {
+  running = false;
+  batch.wakeup(); // Unblock epoll_wait() in batched mode
+}
 
 } // namespace nsecm
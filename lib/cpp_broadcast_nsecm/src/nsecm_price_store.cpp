@@ -22,20 +22,13 @@ void initializeIndexMapping(
 // PriceStore Implementation
 // ============================================================================
 
-PriceStore::PriceStore() { tokenStates.assign(MAX_TOKENS + 1, nullptr); }
-
-PriceStore::~PriceStore() {
-  for (auto *ptr : tokenStates) {
-    delete ptr;
-  }
-}
+PriceStore::PriceStore() : slab(0, MAX_TOKENS + 1) {}
 
 void PriceStore::initializeFromMaster(
     const std::vector<uint32_t> &validTokens) {
-  std::unique_lock<std::shared_mutex> lock(mutex);
-  if (tokenStates.size() <= MAX_TOKENS) {
-    tokenStates.assign(MAX_TOKENS + 1, nullptr);
-  }
+  // Rows are created by initializeToken(); just make sure the slab will not
+  // regrow while the feed is running
+  slab.reserve(validTokens.size());
   std::cout << "[NSE CM Store] Sparse Store Initialized" << std::endl;
 }
 
@@ -46,43 +39,25 @@ void PriceStore::initializeToken(uint32_t token, const char *symbol,
   if (token > MAX_TOKENS)
     return;
 
-  std::unique_lock<std::shared_mutex> lock(mutex);
-  if (!tokenStates[token]) {
-    tokenStates[token] = new UnifiedTokenState();
-  }
-
-  UnifiedTokenState &state = *tokenStates[token];
-  state.token = token;
-
-  if (symbol)
-    strncpy(state.symbol, symbol, 31);
-  if (series)
-    strncpy(state.series, series, 15);
-  if (displayName)
-    strncpy(state.displayName, displayName, 63);
-
-  state.lotSize = lotSize;
-  state.tickSize = tickSize;
-  state.upperCircuit = priceBandHigh;
-  state.lowerCircuit = priceBandLow;
-  state.isUpdated = true;
+  slab.initialize(token, [&](Row state) {
+    state.tick.token = token;
+
+    if (symbol)
+      strncpy(state.info.symbol, symbol, 31);
+    if (series)
+      strncpy(state.info.series, series, 15);
+    if (displayName)
+      strncpy(state.info.displayName, displayName, 63);
+
+    state.info.lotSize = lotSize;
+    state.info.tickSize = tickSize;
+    state.tick.upperCircuit = priceBandHigh;
+    state.tick.lowerCircuit = priceBandLow;
+    state.tick.isUpdated = true;
+  });
 }
 
-void PriceStore::clear() {
-  std::unique_lock<std::shared_mutex> lock(mutex);
-  for (auto *ptr : tokenStates) {
-    delete ptr;
-  }
-  tokenStates.assign(MAX_TOKENS + 1, nullptr);
-}
-
-const UnifiedTokenState *PriceStore::getUnifiedState(int32_t token) const {
-  if (token < 0 || token > (int32_t)MAX_TOKENS)
-    return nullptr;
-
-  std::shared_lock<std::shared_mutex> lock(mutex);
-  return tokenStates[token];
-}
+void PriceStore::clear() { slab.clear(); }
 
 static std::string trimRight(const std::string &s) {
   size_t end = s.find_last_not_of(" \t\n\r");
@@ -90,8 +65,8 @@ static std::string trimRight(const std::string &s) {
 }
 
 double getGenericLtp(uint32_t token) {
-  auto state = g_nseCmPriceStore.getUnifiedSnapshot(token);
-  return (state.token != 0) ? state.ltp : 0.0;
+  auto tick = g_nseCmPriceStore.getTouchline(token);
+  return (tick.token != 0) ? tick.ltp : 0.0;
 }
 
 } // namespace nsecm
@@ -2,6 +2,7 @@
 #include "../../include/protocol.h"
 #include "../../include/nsecm_callback.h"
 #include "../../include/nsecm_price_store.h"
+#include "token_interest.h"
 #include <iostream>
 #include <chrono>
 
@@ -12,11 +13,13 @@ void parse_message_18703(const MS_TICKER_TRADE_DATA* msg) {
     
     uint16_t numRecords = be16toh_func(msg->numberOfRecords);
     
+    const common::SegmentInterest& interest = *common::segmentInterest(1);
+
     for (int i = 0; i < numRecords && i < 28; i++) {
         const auto& rec = msg->records[i];
         uint32_t token = be32toh_func(rec.token);
         
-        if (token == 0) continue;
+        if (token == 0 || !interest.wantsRecord(token)) continue;
         
         // Parse Fields
         double fillPrice = be32toh_func(rec.fillPrice) / 100.0;
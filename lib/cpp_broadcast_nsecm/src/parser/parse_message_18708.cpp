@@ -1,6 +1,7 @@
 #include "../../include/nse_parsers.h"
 #include "../../include/protocol.h"
 #include "../../include/nsecm_callback.h"
+#include "udp_batch_receiver.h"
 #include <iostream>
 #include <chrono>
 #include <cstring>
@@ -29,8 +30,7 @@ void parse_message_18708(const MS_BCAST_BUY_BACK* msg) {
     }
     
     // STEP 2: Capture timestamps for latency tracking
-    auto now = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()).count();
+    auto now = udp_ingest::packetTimestampOrNow();
     
     // STEP 3: Process each buyback record
     for (int i = 0; i < numberOfRecords; i++) {
@@ -1,6 +1,7 @@
 #include "../../include/nse_parsers.h"
 #include "../../include/protocol.h"
 #include "../../include/nsecm_callback.h"
+#include "udp_batch_receiver.h"
 #include <iostream>
 #include <chrono>
 #include <cstring>
@@ -23,8 +24,7 @@ void parse_message_5295(const MS_TRADER_INT_MSG* msg) {
     int32_t traderId = be32toh_func(msg->traderId);
     
     // STEP 2: Capture timestamps for latency tracking
-    auto now = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()).count();
+    auto now = udp_ingest::packetTimestampOrNow();
     
     // STEP 3: Parse message fields
     AdminMessage adminMsg;
@@ -1,6 +1,7 @@
 #include "../../include/nse_parsers.h"
 #include "../../include/protocol.h"
 #include "../../include/nsecm_callback.h"
+#include "udp_batch_receiver.h"
 #include <iostream>
 #include <chrono>
 #include <cstring>
@@ -43,8 +44,7 @@ void parse_message_6013(const MS_SEC_OPEN_MSGS* msg) {
     int16_t marketType = be16toh_func(msg->marketType);
     
     // STEP 5: Capture timestamps for latency tracking
-    auto now = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()).count();
+    auto now = udp_ingest::packetTimestampOrNow();
     
     // STEP 6: Create parsed data for callback
     // Using AdminMessage structure as this is a market status message
@@ -1,6 +1,7 @@
 #include "../../include/nse_parsers.h"
 #include "../../include/protocol.h"
 #include "../../include/nsecm_callback.h"
+#include "udp_batch_receiver.h"
 #include <iostream>
 #include <chrono>
 #include <cstring>
@@ -12,8 +13,7 @@ void parse_message_6501(const MS_BCAST_MESSAGE* msg) {
     int16_t branchNumber = be16toh_func(msg->branchNumber);
     
     // STEP 2: Capture timestamps for latency tracking
-    auto now = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()).count();
+    auto now = udp_ingest::packetTimestampOrNow();
     
     // STEP 3: Parse message fields
     AdminMessage adminMsg;
@@ -1,6 +1,7 @@
 #include "../../include/nse_parsers.h"
 #include "../../include/protocol.h"
 #include "../../include/nsecm_callback.h"
+#include "udp_batch_receiver.h"
 #include <iostream>
 #include <chrono>
 
@@ -12,8 +13,7 @@ void parse_message_6541(const MS_BC_CIRCUIT_CHECK* msg) {
     uint16_t txCode = be16toh_func(msg->header.transactionCode);
     
     // STEP 2: Capture timestamps for latency tracking
-    auto now = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()).count();
+    auto now = udp_ingest::packetTimestampOrNow();
     
     // STEP 3: Create circuit check / heartbeat message
     // This is a simple heartbeat/circuit check message with only header
@@ -2,6 +2,7 @@
 #include "../../include/protocol.h"
 #include "../../include/nsecm_callback.h"
 #include "../../include/nsecm_price_store.h"
+#include "token_interest.h"
 #include <iostream>
 #include <chrono>
 
@@ -12,7 +13,7 @@ void parse_message_7200(const MS_BCAST_MBO_MBP* msg) {
     
     // Parse Token
     uint32_t token = be32toh_func(msg->mboData.token);
-    if (token == 0) return;
+    if (token == 0 || !common::segmentInterest(1)->wantsRecord(token)) return;
     
     // Parse Touchline Fields
     double ltp = be32toh_func(msg->mboData.lastTradedPrice) / 100.0;
@@ -1,6 +1,7 @@
 #include "../../include/nse_parsers.h"
 #include "../../include/protocol.h"
 #include "../../include/nsecm_callback.h"
+#include "udp_batch_receiver.h"
 #include <iostream>
 #include <chrono>
 
@@ -8,8 +9,7 @@ namespace nsecm {
 
 void parse_message_7206(const MS_BCAST_SYSTEM_INFORMATION* msg) {
     // STEP 1: Capture timestamps for latency tracking
-    auto now = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()).count();
+    auto now = udp_ingest::packetTimestampOrNow();
     
     // STEP 2: Parse system information data
     SystemInformationData sysInfo;
@@ -2,6 +2,7 @@
 #include "../../include/protocol.h"
 #include "../../include/nsecm_callback.h"
 #include "../../include/nsecm_price_store.h"
+#include "token_interest.h"
 #include <iostream>
 #include <chrono>
 
@@ -13,12 +14,14 @@ void parse_message_7208(const MS_BCAST_ONLY_MBP* msg) {
     // Convert NoOfRecords
     uint16_t numRecords = be16toh_func(msg->noOfRecords);
     
+    const common::SegmentInterest& interest = *common::segmentInterest(1);
+
     for (int i = 0; i < numRecords && i < 2; i++) {
         const auto& data = msg->data[i];
         
         // Parse Token
         uint32_t token = be32toh_func(data.token);
-        if (token == 0) continue;
+        if (token == 0 || !interest.wantsRecord(token)) continue;
         
         // Parse Touchline Fields
         double ltp = be32toh_func(data.lastTradedPrice) / 100.0;
@@ -11,6 +11,7 @@
 #include "../../include/nse_parsers.h"
 #include "../../include/protocol.h"
 #include "../../include/nsecm_callback.h"
+#include "udp_batch_receiver.h"
 #include <iostream>
 #include <chrono>
 #include <cstring>
@@ -24,8 +25,7 @@ void parse_message_9010(const MS_BCAST_TURNOVER_EXCEEDED* msg) {
     // ========================================================================
     
     // Capture timestamp for latency tracking (microseconds)
-    auto now = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()).count();
+    auto now = udp_ingest::packetTimestampOrNow();
     
     // Extract broker code (5 bytes, null-terminated)
     std::string brokerCode;
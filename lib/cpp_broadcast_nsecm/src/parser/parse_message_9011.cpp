@@ -15,6 +15,7 @@
 #include "../../include/nse_parsers.h"
 #include "../../include/protocol.h"
 #include "../../include/nsecm_callback.h"
+#include "udp_batch_receiver.h"
 #include <iostream>
 #include <chrono>
 #include <cstring>
@@ -28,8 +29,7 @@ void parse_message_9011(const MS_BCAST_TURNOVER_EXCEEDED* msg) {
     // ========================================================================
     
     // Capture timestamp for latency tracking (microseconds)
-    auto now = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()).count();
+    auto now = udp_ingest::packetTimestampOrNow();
     
     // Extract broker code (5 bytes, null-terminated)
     // Per protocol: "If the transaction code is BROADCAST_BROKER_REACTIVATED,
@@ -49,6 +49,7 @@ void UDPStats::print() {
     std::cout << "Runtime: " << duration << "s" << std::endl;
     std::cout << "Total Packets: " << totalPackets << std::endl;
     std::cout << "Total Bytes: " << totalBytes / 1024.0 / 1024.0 << " MB" << std::endl;
+    std::cout << sequence.counters() << std::endl;
     
     std::cout << "\nCode   Name                            Count       Comp(KB)    Raw(KB)" << std::endl;
     std::cout << "--------------------------------------------------------------------------------" << std::endl;
@@ -77,6 +78,14 @@ std::ostream& operator<<(std::ostream& os, const UDPStats& stats) {
     os << "Compressed: " << stats.compressedPackets << " | Decompressed: " << stats.decompressedPackets 
        << " | Failures: " << stats.decompressionFailures << std::endl;
     os << "Total Bytes: " << stats.totalBytes / 1024.0 / 1024.0 << " MB" << std::endl;
+    if (stats.recvCalls > 0) {
+        os << "Receive Calls: " << stats.recvCalls << " | Packets/syscall: "
+           << std::fixed << std::setprecision(2) << stats.packetsPerSyscall() << std::endl;
+    }
+    if (stats.truncatedDatagrams > 0) {
+        os << "Truncated datagrams (dropped): " << stats.truncatedDatagrams << std::endl;
+    }
+    os << stats.sequence.counters() << std::endl;
     
     if (!stats.messageStats.empty()) {
         os << "\nCode   Name                            Count       Comp(KB)    Raw(KB)" << std::endl;
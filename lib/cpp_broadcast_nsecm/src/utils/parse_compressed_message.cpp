@@ -6,7 +6,6 @@
 #include "../../include/nse_parsers.h"
 #include <iostream>
 #include <iomanip>
-#include <vector>
 
 namespace nsecm {
 
@@ -18,48 +17,47 @@ void parse_compressed_message(const char* data, int16_t length, UDPStats& stats)
     
     total_messages++;
     
-    // Decompress using official LZO library
-    std::vector<uint8_t> input(data, data + length);
-    std::vector<uint8_t> output(65535);  // Large output buffer for decompressed data
-    
-    int result;
-    try {
-        result = common::LzoDecompressor::decompressWithLibrary(input, output);
-        successful_decompressions++;
-    } catch (const std::exception& e) {
+    // Decompress straight from the packet buffer into the per-thread scratch
+    // arena - no heap allocation and no exceptions on the receive thread
+    uint8_t* output = common::LzoDecompressor::scratch();
+    int result = common::LzoDecompressor::decompressInto(
+        reinterpret_cast<const uint8_t*>(data),
+        length > 0 ? static_cast<size_t>(length) : 0, output,
+        common::LzoDecompressor::kScratchSize);
+
+    if (result < 0) {
         failed_decompressions++;
         return;
     }
+    successful_decompressions++;
     
-    if (result <= 0) {
+    if (result == 0) {
         return;
     }
-    
-    // Resize output to actual decompressed size
-    output.resize(result);
 
     // Skip first 8 bytes of the decompressed data (magic offset)
     size_t header_offset = CommonConfig::COMPRESSED_HEADER_OFFSET;
     
-    if (result < header_offset + sizeof(BCAST_HEADER)) { 
+    if (static_cast<size_t>(result) < header_offset + sizeof(BCAST_HEADER)) { 
         return;
     }
 
     // Pointer to start of BCAST_HEADER
-    const uint8_t* message_data = output.data() + header_offset;
+    const uint8_t* message_data = output + header_offset;
     size_t message_size = result - header_offset;
     
     // Extract Transaction Code from offset 10 of the BCAST_HEADER
     uint16_t txCode = be16toh_func(*((uint16_t*)(message_data + CommonConfig::BCAST_HEADER_TXCODE_OFFSET)));
 
-
+    // Per-stream (alphaChar, transactionCode) bcSeqNo gap detection
+    stats.sequence.observeHeader(message_data);
 
     // if (txCode == 7207) {
     // std::cout << "Transaction Code: " << txCode << std::endl;
     // }
 
     // UPDATE STATISTICS: Track this message by transaction code
-    stats.update(txCode, length, output.size(), false);
+    stats.update(txCode, length, result, false);
     
     switch (txCode) {
         case TxCodes::BCAST_MBO_MBP_UPDATE:
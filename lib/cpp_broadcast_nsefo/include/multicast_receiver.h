@@ -1,35 +1,130 @@
 #ifndef NSEFO_MULTICAST_RECEIVER_H_V2
 #define NSEFO_MULTICAST_RECEIVER_H_V2
 
+#include <memory>
 #include <string>
 #include <atomic>
+#include <thread>
+#include <vector>
 #include "socket_platform.h"
+#include "udp_batch_receiver.h"
+#include "udp_capture.h"
+#include "udp_fanout_ring.h"
 #include "udp_receiver.h" // Defines UDPStats
 
 namespace nsefo {
 
 constexpr size_t kBufferSize = 65535;
+constexpr size_t kFanoutRingBytes = 4 * 1024 * 1024;  // Receive → parse worker backlog
 
 class MulticastReceiver {
 public:
     MulticastReceiver(const std::string& ip, int port);
+    // Offline receiver (no socket) for capture replay – feed it with injectDatagram()
+    MulticastReceiver();
     ~MulticastReceiver();
 
     void start();
     void stop();
+
+    /**
+     * @brief Select the Linux recvmmsg() ingest path (call before start()).
+     * @param enabled Pull up to batchSize datagrams per syscall with kernel
+     *                receive timestamps; falls back to recv() when unsupported
+     * @param batchSize Datagrams per recvmmsg() call
+     */
+    void setBatchedIngest(bool enabled,
+                          size_t batchSize = udp_ingest::BatchReceiver::kDefaultBatchSize) {
+        batchedIngest = enabled;
+        ingestBatchSize = batchSize;
+    }
+    bool isBatchedIngestActive() const { return batchActive; }
+
+    /**
+     * @brief Pipelined, token-sharded parsing (call before start()).
+     *
+     * workers <= 1: the receive thread parses inline (default). Otherwise the
+     * receive thread only receives, timestamps and publishes each datagram to
+     * a broadcast ring; every worker decompresses it and applies only the
+     * records of the tokens it owns (see parse_shard.h), so per-token order
+     * is kept and each PriceStore row has one writer. Tick callbacks then
+     * run on the worker threads.
+     * @param workerCores Core per worker (index = shard); missing/-1 = unpinned
+     * @param receiveCore Core for the receive thread; -1 = unpinned
+     */
+    void setParseWorkers(size_t workers, std::vector<int> workerCores = {},
+                         int receiveCore = -1) {
+        parseWorkerCount = workers;
+        parseWorkerCores = std::move(workerCores);
+        receiveThreadCore = receiveCore;
+    }
+    size_t parseWorkers() const { return parseWorkerCount > 1 ? parseWorkerCount : 1; }
+
+    // Times the receive thread waited for the slowest parse worker
+    uint64_t fanoutStalls() const { return fanoutStallCount.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Block until the parse workers have consumed everything published
+     * (offline replay: the tick stream is complete when this returns).
+     */
+    void waitForParseWorkers();
+
+    /**
+     * @brief Append every received datagram to a pcap file (call before start()).
+     * @return false if the file could not be created
+     */
+    bool startCapture(const std::string& path);
+    const udp_capture::CaptureWriter* capture() const { return captureWriter.get(); }
+
+    /**
+     * @brief Run one captured datagram through the packet loop (offline replay).
+     * Call from a single thread – it stands in for the receive thread.
+     */
+    void injectDatagram(const uint8_t* data, size_t length);
     
     // Check if receiver is properly initialized
     bool isValid() const { return sockfd != socket_invalid; }
     
-    // Get statistics
-    const UDPStats& getStats() const { return stats; }
+    // Statistics summed over the receive thread and every parse shard
+    UDPStatsSnapshot getStats() const;
 
 private:
+    void runLegacyLoop();
+    void runBatchedLoop();
+    void handleDatagram(const char* data, ssize_t n);
+    // counters / sequence null: this shard does not count the datagram
+    void processDatagram(const char* data, ssize_t n, UDPStats* counters,
+                         common::SequenceGapTracker* sequence);
+    void startParseWorkers();
+    void stopParseWorkers();
+    void runParseWorker(size_t index);
+
     socket_t sockfd;
     struct sockaddr_in addr;
     std::atomic<bool> running;
     
     alignas(8) char buffer[kBufferSize];
+
+    // Batched ingest (recvmmsg ring + eventfd wakeup)
+    udp_ingest::BatchReceiver batch;
+    bool batchedIngest = false;
+    size_t ingestBatchSize = udp_ingest::BatchReceiver::kDefaultBatchSize;
+    std::atomic<bool> batchActive{false};
+
+    // Raw datagram capture (startCapture)
+    std::string groupIp;
+    int groupPort = 0;
+    std::unique_ptr<udp_capture::CaptureWriter> captureWriter;
+
+    // Sharded parsing (setParseWorkers)
+    size_t parseWorkerCount = 0;
+    std::vector<int> parseWorkerCores;
+    int receiveThreadCore = -1;
+    std::unique_ptr<udp_ingest::FanoutRing> fanout;
+    std::vector<std::thread> parseThreads;
+    std::vector<std::unique_ptr<UDPStats>> shardStats;  // Shards 1..N-1 (summed by getStats())
+    std::atomic<bool> parseRunning{false};
+    std::atomic<uint64_t> fanoutStallCount{0};
     
     // Statistics tracking
     UDPStats stats;
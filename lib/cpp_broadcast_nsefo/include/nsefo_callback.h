@@ -5,6 +5,8 @@
 #include <functional>
 #include <vector>
 
+#include "data/UnifiedPriceState.h"
+
 namespace nsefo {
 
 // ============================================================================
@@ -141,6 +143,55 @@ struct CircuitLimitData {
     int64_t timestampParsed = 0;
 };
 
+// Parse-once tick record (from 7200, 7208, 7202, 17202)
+// The parser fills only the groups flagged in `fields`; the price store
+// applies the record and the same record is forwarded to the callback.
+// Payload members are deliberately left uninitialised (no per-tick memset).
+struct TickDelta {
+    enum Field : uint8_t {
+        TOUCHLINE = 1 << 0,     // Prices, OHLC, volume, status (7200, 7208)
+        DEPTH     = 1 << 1,     // 5x2 levels + total buy/sell qty (7200, 7208)
+        OI        = 1 << 2,     // Open interest (7202, 17202)
+    };
+
+    struct Level {
+        double price;
+        uint32_t quantity;
+        uint32_t orders;
+    };
+
+    uint32_t token = 0;
+    uint16_t messageType = 0;
+    uint8_t fields = 0;
+    int64_t timestampRecv = 0;
+
+    // TOUCHLINE
+    uint16_t tradingStatus;
+    uint16_t bookType;
+    char netChangeIndicator;
+    uint32_t lastTradeQty;
+    uint32_t lastTradeTime;
+    uint64_t volume;
+    double ltp;
+    double open;
+    double high;
+    double low;
+    double close;
+    double avgPrice;
+    double netChange;
+
+    // DEPTH
+    Level bids[5];
+    Level asks[5];
+    uint64_t totalBuyQty;
+    uint64_t totalSellQty;
+
+    // OI
+    int64_t openInterest;
+
+    bool has(Field f) const { return (fields & f) != 0; }
+};
+
 // ============================================================================
 // CALLBACK FUNCTION TYPES
 // ============================================================================
@@ -154,6 +205,13 @@ using MarketDepthCallback = std::function<void(int32_t token, int exchangeSegmen
 // Callback for ticker updates (7202, 17202)
 using TickerCallback = std::function<void(int32_t token, int exchangeSegment, uint16_t messageType)>;
 
+// Callback for parse-once tick deltas (7200, 7208, 7202, 17202)
+// `tick` / `depth` are the merged row, copied out by the store in the same
+// write that applied `delta`, so the receiver needs no snapshot read.
+using TickDeltaCallback = std::function<void(const TickDelta& delta,
+                                             const MarketData::TouchlineState& tick,
+                                             const MarketData::DepthState& depth)>;
+
 // Callback for market watch updates (7201, 17201)
 using MarketWatchCallback = std::function<void(const MarketWatchData&)>;
 
@@ -191,6 +249,14 @@ public:
         tickerCallback = callback;
     }
     
+    void registerTickDeltaCallback(TickDeltaCallback callback) {
+        tickDeltaCallback = callback;
+    }
+
+    bool hasTickDeltaCallback() const {
+        return static_cast<bool>(tickDeltaCallback);
+    }
+    
     void registerMarketWatchCallback(MarketWatchCallback callback) {
         marketWatchCallback = callback;
     }
@@ -237,6 +303,21 @@ public:
         }
     }
     
+    // Falls back to the token-only touchline / ticker callbacks when no
+    // delta callback is registered
+    void dispatchTickDelta(const TickDelta& delta,
+                           const MarketData::TouchlineState& tick,
+                           const MarketData::DepthState& depth) {
+        if (!isEnabled(delta.token)) return;
+        if (tickDeltaCallback) {
+            tickDeltaCallback(delta, tick, depth);
+        } else if (delta.has(TickDelta::TOUCHLINE)) {
+            if (touchlineCallback) touchlineCallback(delta.token, 2, delta.messageType);
+        } else if (tickerCallback) {
+            tickerCallback(delta.token, 2, delta.messageType);
+        }
+    }
+    
     void dispatchMarketWatch(const MarketWatchData& data) {
         if (marketWatchCallback && isEnabled(data.token)) {
             marketWatchCallback(data);
@@ -270,6 +351,7 @@ private:
     TouchlineCallback touchlineCallback;
     MarketDepthCallback marketDepthCallback;
     TickerCallback tickerCallback;
+    TickDeltaCallback tickDeltaCallback;
     MarketWatchCallback marketWatchCallback;
     IndexCallback indexCallback;
     IndustryIndexCallback industryIndexCallback;
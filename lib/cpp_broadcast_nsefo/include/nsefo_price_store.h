@@ -6,25 +6,27 @@
 #include <vector>
 #include <cstdint>
 #include <cstring>
-#include <shared_mutex>
-#include <mutex>
 #include <QDebug>
 #include "nsefo_callback.h"
 
 #include "data/UnifiedPriceState.h"
+#include "data/SeqlockPriceSlab.h"
 
 namespace nsefo {
 
 using UnifiedTokenState = MarketData::UnifiedState;
+using Row = MarketData::SeqlockPriceSlab::RowRef;
 
 
 /**
- * @brief Distributed price store for NSE FO (indexed array)
+ * @brief Distributed price store for NSE FO (indexed slab)
  * 
  * Architecture:
- * - Thread-Safe: Uses std::shared_mutex (Shared Read, Exclusive Write)
- * - Unified: Stores all fields in one struct per token
- * - Zero-Copy Read: Returns pointer to live record
+ * - Lock-Free Reads: Per-row seqlock over a contiguous, cache-aligned slab
+ *   (see MarketData::SeqlockPriceSlab); readers never block the feed thread
+ * - Split rows: touchline / depth / greeks / contract blocks in parallel
+ *   arrays; getTouchline() etc. copy one block, getUnifiedSnapshot() all
+ * - Snapshot Read: every getter returns a consistent copy
  * - Direct Access: Array indexing O(1)
  */
 class PriceStore {
@@ -33,16 +35,10 @@ public:
     static constexpr uint32_t MAX_TOKEN = 250000;
     static constexpr uint32_t ARRAY_SIZE = MAX_TOKEN - MIN_TOKEN + 1;  // 90,000 slots
     
-    PriceStore() : store_(ARRAY_SIZE, nullptr) {}
-    
-    ~PriceStore() {
-        for (auto* ptr : store_) {
-            delete ptr;
-        }
-    }
+    PriceStore() : slab_(MIN_TOKEN, ARRAY_SIZE) {}
     
     // =========================================================
-    // PARTIAL UPDATES (Write Lock)
+    // PARTIAL UPDATES (Seqlock Write)
     // =========================================================
 
     /**
@@ -51,27 +47,24 @@ public:
     void updateTouchline(const UnifiedTokenState& data) {
         if (data.token < MIN_TOKEN || data.token > MAX_TOKEN) return;
         
-        std::unique_lock lock(mutex_); // Exclusive Write
-        auto* rowPtr = store_[data.token - MIN_TOKEN];
-        if (!rowPtr) return;
-        auto& row = *rowPtr;
-        
-        // Update only dynamic price fields
-        row.token = data.token;
-        row.ltp = data.ltp;
-        row.open = data.open;
-        row.high = data.high;
-        row.low = data.low;
-        row.close = data.close;
-        row.volume = data.volume;
-        row.lastTradeQty = data.lastTradeQty;
-        row.lastTradeTime = data.lastTradeTime;
-        row.avgPrice = data.avgPrice;
-        row.netChangeIndicator = data.netChangeIndicator;
-        row.netChange = data.netChange;
-        row.tradingStatus = data.tradingStatus;
-        row.bookType = data.bookType;
-        row.lastPacketTimestamp = data.lastPacketTimestamp;
+        slab_.update(data.token, [&](Row row) {
+            // Update only dynamic price fields
+            row.tick.token = data.token;
+            row.tick.ltp = data.ltp;
+            row.tick.open = data.open;
+            row.tick.high = data.high;
+            row.tick.low = data.low;
+            row.tick.close = data.close;
+            row.tick.volume = data.volume;
+            row.tick.lastTradeQty = data.lastTradeQty;
+            row.tick.lastTradeTime = data.lastTradeTime;
+            row.tick.avgPrice = data.avgPrice;
+            row.tick.netChangeIndicator = data.netChangeIndicator;
+            row.tick.netChange = data.netChange;
+            row.tick.tradingStatus = data.tradingStatus;
+            row.tick.bookType = data.bookType;
+            row.tick.lastPacketTimestamp = data.lastPacketTimestamp;
+        });
         
         // Note: We DO NOT update bids/asks here as Msg 7200 depth is often just top level
         // or handled by 7208. If 7200 contains depth, we should update it too.
@@ -85,17 +78,14 @@ public:
     void updateDepth(const UnifiedTokenState& data) {
         if (data.token < MIN_TOKEN || data.token > MAX_TOKEN) return;
         
-        std::unique_lock lock(mutex_); // Exclusive Write
-        auto* rowPtr = store_[data.token - MIN_TOKEN];
-        if (!rowPtr) return;
-        auto& row = *rowPtr;
-        
-        row.token = data.token;
-        std::memcpy(row.bids, data.bids, sizeof(row.bids));
-        std::memcpy(row.asks, data.asks, sizeof(row.asks));
-        row.totalBuyQty = data.totalBuyQty;
-        row.totalSellQty = data.totalSellQty;
-        row.lastPacketTimestamp = data.lastPacketTimestamp;
+        slab_.update(data.token, [&](Row row) {
+            row.tick.token = data.token;
+            std::memcpy(row.depth.bids, data.bids, sizeof(row.depth.bids));
+            std::memcpy(row.depth.asks, data.asks, sizeof(row.depth.asks));
+            row.depth.totalBuyQty = data.totalBuyQty;
+            row.depth.totalSellQty = data.totalSellQty;
+            row.tick.lastPacketTimestamp = data.lastPacketTimestamp;
+        });
     }
     
     /**
@@ -104,14 +94,60 @@ public:
     void updateTicker(const UnifiedTokenState& data) {
         if (data.token < MIN_TOKEN || data.token > MAX_TOKEN) return;
         
-        std::unique_lock lock(mutex_); // Exclusive Write
-        auto* rowPtr = store_[data.token - MIN_TOKEN];
-        if (!rowPtr) return;
-        auto& row = *rowPtr;
-        
-        row.token = data.token;
-        row.openInterest = data.openInterest;
-        row.lastPacketTimestamp = data.lastPacketTimestamp;
+        slab_.update(data.token, [&](Row row) {
+            row.tick.token = data.token;
+            row.tick.openInterest = data.openInterest;
+            row.tick.lastPacketTimestamp = data.lastPacketTimestamp;
+        });
+    }
+
+    /**
+     * @brief Apply a parse-once delta (Msg 7200 / 7208 / 7202 / 17202)
+     *
+     * One seqlock write applies the flagged groups and copies the merged
+     * touchline/depth out, so the dispatcher needs no second snapshot read.
+     * Same field semantics as updateTouchline / updateDepth / updateTicker.
+     *
+     * @return false if the token has no row (outputs untouched)
+     */
+    bool applyDelta(const TickDelta& delta, MarketData::TouchlineState& tickOut,
+                    MarketData::DepthState& depthOut) {
+        if (delta.token < MIN_TOKEN || delta.token > MAX_TOKEN) return false;
+
+        return slab_.update(delta.token, [&](Row row) {
+            row.tick.token = delta.token;
+            row.tick.lastPacketTimestamp = delta.timestampRecv;
+            if (delta.has(TickDelta::TOUCHLINE)) {
+                row.tick.ltp = delta.ltp;
+                row.tick.open = delta.open;
+                row.tick.high = delta.high;
+                row.tick.low = delta.low;
+                row.tick.close = delta.close;
+                row.tick.volume = delta.volume;
+                row.tick.lastTradeQty = delta.lastTradeQty;
+                row.tick.lastTradeTime = delta.lastTradeTime;
+                row.tick.avgPrice = delta.avgPrice;
+                row.tick.netChangeIndicator = delta.netChangeIndicator;
+                row.tick.netChange = delta.netChange;
+                row.tick.tradingStatus = delta.tradingStatus;
+                row.tick.bookType = delta.bookType;
+            }
+            if (delta.has(TickDelta::DEPTH)) {
+                for (int i = 0; i < 5; ++i) {
+                    row.depth.bids[i] = {delta.bids[i].price, delta.bids[i].quantity,
+                                         delta.bids[i].orders};
+                    row.depth.asks[i] = {delta.asks[i].price, delta.asks[i].quantity,
+                                         delta.asks[i].orders};
+                }
+                row.depth.totalBuyQty = delta.totalBuyQty;
+                row.depth.totalSellQty = delta.totalSellQty;
+            }
+            if (delta.has(TickDelta::OI)) {
+                row.tick.openInterest = delta.openInterest;
+            }
+            tickOut = row.tick;
+            depthOut = row.depth;
+        });
     }
 
     /**
@@ -120,15 +156,12 @@ public:
     void updateLPP(const UnifiedTokenState& data) {
         if (data.token < MIN_TOKEN || data.token > MAX_TOKEN) return;
         
-        std::unique_lock lock(mutex_); // Exclusive Write
-        auto* rowPtr = store_[data.token - MIN_TOKEN];
-        if (!rowPtr) return;
-        auto& row = *rowPtr;
-        
-        row.token = data.token;
-        row.upperCircuit = data.upperCircuit;
-        row.lowerCircuit = data.lowerCircuit;
-        row.lastPacketTimestamp = data.lastPacketTimestamp;
+        slab_.update(data.token, [&](Row row) {
+            row.tick.token = data.token;
+            row.tick.upperCircuit = data.upperCircuit;
+            row.tick.lowerCircuit = data.lowerCircuit;
+            row.tick.lastPacketTimestamp = data.lastPacketTimestamp;
+        });
     }
 
     /**
@@ -149,69 +182,90 @@ public:
                      double theoreticalPrice, int64_t timestamp) {
         if (token < MIN_TOKEN || token > MAX_TOKEN) return;
         
-        std::unique_lock lock(mutex_); // Exclusive Write
-        auto* rowPtr = store_[token - MIN_TOKEN];
-        if (!rowPtr) return;
-        auto& row = *rowPtr;
-        
-        row.impliedVolatility = iv;
-        row.bidIV = bidIV;
-        row.askIV = askIV;
-        row.delta = delta;
-        row.gamma = gamma;
-        row.vega = vega;
-        row.theta = theta;
-        row.theoreticalPrice = theoreticalPrice;
-        row.greeksCalculated = true;
-        row.lastGreeksUpdateTime = timestamp;
-        row.lastPacketTimestamp = timestamp;
+        // Own seqlock: never waits on (or stalls) the shard writing the tick
+        slab_.updateGreeks(token, [&](MarketData::GreeksState& greeks) {
+            greeks.impliedVolatility = iv;
+            greeks.bidIV = bidIV;
+            greeks.askIV = askIV;
+            greeks.delta = delta;
+            greeks.gamma = gamma;
+            greeks.vega = vega;
+            greeks.theta = theta;
+            greeks.theoreticalPrice = theoreticalPrice;
+            greeks.greeksCalculated = true;
+            greeks.lastGreeksUpdateTime = timestamp;
+        });
     }
 
     // =========================================================
-    // UNIFIED READ (Read Lock)
+    // UNIFIED READ (Lock-Free)
     // =========================================================
 
     /**
      * @brief Get thread-safe snapshot copy of token state.
-     * @return Copy of token state, guaranteed consistent under lock.
+     * @return Consistent copy of token state (seqlock retry on torn read).
      *         Returns empty state (token=0) if not found.
      */
     [[nodiscard]] UnifiedTokenState getUnifiedSnapshot(uint32_t token) const {
         if (token < MIN_TOKEN || token > MAX_TOKEN) return UnifiedTokenState{};
 
-        std::shared_lock lock(mutex_); // Shared Read
-        const auto* rowPtr = store_[token - MIN_TOKEN];
-        if (!rowPtr || rowPtr->token != token) return UnifiedTokenState{};
-        return *rowPtr; // Copy under lock – thread safe
+        UnifiedTokenState state;
+        if (!slab_.read(token, state) || state.token != token) return UnifiedTokenState{};
+        return state;
     }
 
     /**
-     * @brief UNSAFE raw pointer access for legacy callers.
-     *
-     * DEPRECATED – The returned pointer is only valid while the shared_mutex
-     * read lock is held inside this function. The moment the caller dereferences
-     * it another thread may be writing to that slot, causing data races.
-     *
-     * Use getUnifiedSnapshot() for all new code.
-     *
-     * Kept only to avoid a large-scale migration; all existing callers go via
-     * PriceStoreGateway which is being migrated to getUnifiedSnapshot().
-     *
-     * @return Pointer to live record, or nullptr. Do NOT cache this pointer.
-     * @deprecated Use getUnifiedSnapshot() instead.
+     * @brief Partial snapshots: copy one block instead of the full state.
+     * @return Empty block (token=0 / greeksCalculated=false) if not found.
      */
-    [[deprecated("Use getUnifiedSnapshot() – raw pointer is not race-free")]]
-    const UnifiedTokenState* getUnifiedState(uint32_t token) const {
-        if (token < MIN_TOKEN || token > MAX_TOKEN) return nullptr;
-
-        // NOTE: The lock is released before returning – the caller sees the
-        // pointer but no longer holds the read lock.  This is inherently
-        // unsafe; this method exists only to support legacy call sites while
-        // they are migrated to getUnifiedSnapshot().
-        std::shared_lock lock(mutex_);
-        const auto* rowPtr = store_[token - MIN_TOKEN];
-        if (!rowPtr || rowPtr->token != token) return nullptr;
-        return rowPtr;
+    [[nodiscard]] MarketData::TouchlineState getTouchline(uint32_t token) const {
+        MarketData::TouchlineState tick;
+        if (token < MIN_TOKEN || token > MAX_TOKEN || !slab_.readTouchline(token, tick) ||
+            tick.token != token) {
+            return MarketData::TouchlineState{};
+        }
+        return tick;
+    }
+
+    [[nodiscard]] MarketData::DepthState getDepth(uint32_t token) const {
+        MarketData::DepthState depth;
+        if (token < MIN_TOKEN || token > MAX_TOKEN || !slab_.readDepth(token, depth)) {
+            return MarketData::DepthState{};
+        }
+        return depth;
+    }
+
+    [[nodiscard]] MarketData::GreeksState getGreeks(uint32_t token) const {
+        MarketData::GreeksState greeks;
+        if (token < MIN_TOKEN || token > MAX_TOKEN || !slab_.readGreeks(token, greeks)) {
+            return MarketData::GreeksState{};
+        }
+        return greeks;
+    }
+
+    // =========================================================
+    // VERSIONS (dirty tracking for pollers)
+    // =========================================================
+
+    /**
+     * @brief Current version epoch (advanced by changedSince(), not by updates)
+     */
+    uint64_t getVersion() const { return slab_.version(); }
+
+    /**
+     * @brief Number of updates to token's row; 0 if the token has no row
+     */
+    uint64_t getRowVersion(uint32_t token) const { return slab_.rowVersion(token); }
+
+    /**
+     * @brief Append the Block of each token updated after sinceVersion
+     * @return Watermark to pass as sinceVersion on the next call
+     * @see MarketData::SeqlockPriceSlab::changedSince
+     */
+    template <typename Block>
+    uint64_t changedSince(uint64_t sinceVersion, const uint32_t* tokens, size_t count,
+                          std::vector<MarketData::VersionedBlock<Block>>& out) const {
+        return slab_.changedSince(sinceVersion, tokens, count, out);
     }
     
     // =========================================================
@@ -224,21 +278,30 @@ public:
                         int32_t instrumentType, double tickSize);
     
     void initializeFromMaster(const std::vector<uint32_t>& tokens);
+
+    /**
+     * @brief Drop a contract removed from the master (incremental refresh)
+     * @return false if the token had no row
+     */
+    bool removeToken(uint32_t token);
+
+    /**
+     * @brief Pre-size the slab for an upcoming master load (avoids regrowth)
+     */
+    void reserve(size_t tokenCount) { slab_.reserve(tokenCount); }
     
     size_t getValidTokenCount() const { return validTokenCount; }
+
+    // Torn reads retried by getUnifiedSnapshot() (contention diagnostics)
+    uint64_t getReadRetries() const { return slab_.readRetries(); }
     
     void clear() {
-        std::unique_lock lock(mutex_);
-        for (auto* ptr : store_) {
-            delete ptr;
-        }
-        store_.assign(ARRAY_SIZE, nullptr);
+        slab_.clear();
         validTokenCount = 0;
     }
 
 private:
-    std::vector<UnifiedTokenState*> store_; 
-    mutable std::shared_mutex mutex_;
+    MarketData::SeqlockPriceSlab slab_;
     size_t validTokenCount = 0;
 };
 
@@ -0,0 +1,50 @@
+#ifndef NSEFO_PARSE_SHARD_H
+#define NSEFO_PARSE_SHARD_H
+
+#include <cstdint>
+
+namespace nsefo {
+
+/**
+ * @brief Token ownership of the calling parse thread (sharded parsing).
+ *
+ * With MulticastReceiver::setParseWorkers(N > 1) every worker decodes every
+ * datagram, but only applies the records whose token it owns, so each
+ * PriceStore row keeps a single writer and per-token order is the receive
+ * order. Messages without a token (indices, admin, spread) belong to shard 0.
+ * A thread that never called assign() owns everything (single-thread mode).
+ */
+namespace shard {
+
+struct Identity {
+    uint32_t index = 0;
+    uint32_t count = 1;
+};
+
+inline Identity& current() {
+    thread_local Identity identity;
+    return identity;
+}
+
+inline void assign(uint32_t index, uint32_t count) {
+    current() = Identity{index, count > 0 ? count : 1};
+}
+
+// Fibonacci hash: consecutive tokens (CE/PE pairs, strikes) spread evenly
+inline uint32_t of(uint32_t token, uint32_t count) {
+    return static_cast<uint32_t>((uint64_t(token * 0x9E3779B1u) * count) >> 32);
+}
+
+inline bool ownsToken(uint32_t token) {
+    const Identity& id = current();
+    return id.count <= 1 || of(token, id.count) == id.index;
+}
+
+inline bool ownsShared() {
+    return current().index == 0;
+}
+
+} // namespace shard
+} // namespace nsefo
+
+#endif // NSEFO_PARSE_SHARD_H
@@ -6,6 +6,7 @@
 #include <map>
 #include <chrono>
 #include <iostream>
+#include "sequence_gap_tracker.h"
 
 namespace nsefo {
 
@@ -16,6 +17,8 @@ struct MessageStats {
     uint64_t totalRawSize;
 };
 
+struct UDPStatsSnapshot;
+
 class UDPStats {
 public:
     std::map<uint16_t, MessageStats> messageStats;
@@ -24,23 +27,65 @@ public:
     uint64_t compressedPackets{0};
     uint64_t decompressedPackets{0};
     uint64_t decompressionFailures{0};
-    // Sequence gap counters – incremented when a gap is detected in bcSeqNo
-    uint64_t sequenceGaps{0};
-    uint64_t droppedMessages{0}; // Estimated messages lost in gaps
-    uint64_t lastLoggedGapCount{0}; // For throttling gap logs
+    // Receive syscall accounting – datagramsReceived / recvCalls is the
+    // packets-per-syscall ratio (1.0 for recv(), up to batch size for recvmmsg()).
+    // Atomic: with sharded parsing the receive thread writes these while
+    // parse worker 0 writes the rest of this instance
+    std::atomic<uint64_t> recvCalls{0};
+    std::atomic<uint64_t> datagramsReceived{0};
+    // Datagrams recvmmsg() cut to the slot size (MSG_TRUNC) – dropped unparsed
+    std::atomic<uint64_t> truncatedDatagrams{0};
+    // Per-stream bcSeqNo gap / out-of-order accounting (receive thread writes)
+    common::SequenceGapTracker sequence;
     std::chrono::steady_clock::time_point startTime;
-    std::chrono::steady_clock::time_point lastGapLogTime;
 
     UDPStats();
     void update(uint16_t code, int compressedSize, int rawSize, bool error);
     void recordPacket();  // Record a packet without detailed stats
-    void recordSequenceGap(uint32_t expected, uint32_t actual); // Record gap
+    void recordReceiveCall(int datagrams) {
+        recvCalls.fetch_add(1, std::memory_order_relaxed);
+        datagramsReceived.fetch_add(static_cast<uint64_t>(datagrams), std::memory_order_relaxed);
+    }
+    void recordTruncated() { truncatedDatagrams.fetch_add(1, std::memory_order_relaxed); }
+    double packetsPerSyscall() const {
+        const uint64_t calls = recvCalls.load(std::memory_order_relaxed);
+        return calls > 0
+                   ? static_cast<double>(datagramsReceived.load(std::memory_order_relaxed)) / calls
+                   : 0.0;
+    }
     void print();
+    UDPStatsSnapshot snapshot() const;
 
     // Output operator for easy printing
     friend std::ostream& operator<<(std::ostream& os, const UDPStats& stats);
 };
 
+/**
+ * @brief Plain copy of UDPStats counters; MulticastReceiver::getStats() sums
+ * the parse shards' counters into one
+ */
+struct UDPStatsSnapshot {
+    std::map<uint16_t, MessageStats> messageStats;
+    uint64_t totalPackets{0};
+    uint64_t totalBytes{0};
+    uint64_t compressedPackets{0};
+    uint64_t decompressedPackets{0};
+    uint64_t decompressionFailures{0};
+    uint64_t recvCalls{0};
+    uint64_t datagramsReceived{0};
+    uint64_t truncatedDatagrams{0};
+    common::SequenceGapCounters sequence;
+    std::chrono::steady_clock::time_point startTime;
+
+    // Sum stats' message and receive counters into this one
+    void add(const UDPStats& stats);
+    double packetsPerSyscall() const {
+        return recvCalls > 0 ? static_cast<double>(datagramsReceived) / recvCalls : 0.0;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const UDPStatsSnapshot& stats);
+};
+
 class UDPReceiver {
 public:
     // DEPRECATED: Use MulticastReceiver instead.
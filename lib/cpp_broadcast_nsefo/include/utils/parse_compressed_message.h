@@ -3,12 +3,18 @@
 
 #include <cstdint>
 
+namespace common {
+class SequenceGapTracker;
+}
+
 namespace nsefo {
 
 // Forward declaration
 class UDPStats;
 
-void parse_compressed_message(const char* data, int16_t length, UDPStats& stats);
+// stats / sequence may be null: this shard does not count the message
+void parse_compressed_message(const char* data, int16_t length, UDPStats* stats,
+                              common::SequenceGapTracker* sequence);
 
 } // namespace nsefo
 
@@ -2,6 +2,7 @@
 #include <cstring>
 #include <stdexcept>
 #include <cerrno>
+#include <thread>
 
 #include "multicast_receiver.h"
 #include "packet.h"
@@ -9,11 +10,13 @@
 #include "utils/parse_compressed_message.h"
 #include "utils/parse_uncompressed_packet.h"
 #include "socket_platform.h"
+#include "parse_shard.h"
+#include "thread_affinity.h"
 
 namespace nsefo {
 
 MulticastReceiver::MulticastReceiver(const std::string& ip, int port) 
-    : sockfd(socket_invalid), running(false), lastSeqNo(0) {
+    : sockfd(socket_invalid), running(false), groupIp(ip), groupPort(port), lastSeqNo(0) {
     WinsockLoader::init();
     
     // Create socket
@@ -90,8 +93,14 @@ MulticastReceiver::MulticastReceiver(const std::string& ip, int port)
     std::cout << "MulticastReceiver initialized successfully (buffer size: " << kBufferSize << " bytes)" << std::endl;
 }
 
+MulticastReceiver::MulticastReceiver()
+    : sockfd(socket_invalid), running(false), lastSeqNo(0) {
+    std::memset(&addr, 0, sizeof(addr));
+}
+
 MulticastReceiver::~MulticastReceiver() {
     stop();
+    stopParseWorkers();
     if (sockfd != socket_invalid) {
         socket_close(sockfd);
         sockfd = -1;
@@ -106,9 +115,28 @@ void MulticastReceiver::start() {
     
     running = true;
     std::cout << "Starting MulticastReceiver..." << std::endl;
-    
-    int packet_count = 0;
-    
+
+    if (receiveThreadCore >= 0 && !udp_ingest::pinCurrentThreadToCore(receiveThreadCore)) {
+        std::cerr << "Warning: could not pin receive thread to core " << receiveThreadCore << std::endl;
+    }
+    startParseWorkers();
+
+    if (batchedIngest && udp_ingest::BatchReceiver::isSupported() &&
+        batch.open(sockfd, ingestBatchSize, kBufferSize)) {
+        std::cout << "MulticastReceiver: batched ingest enabled (recvmmsg x" << ingestBatchSize
+                  << (batch.hasKernelTimestamps() ? ", kernel timestamps" : "") << ")" << std::endl;
+        batchActive = true;
+        runBatchedLoop();
+        batchActive = false;
+    } else {
+        runLegacyLoop();
+    }
+
+    stopParseWorkers();
+    std::cout << "MulticastReceiver stopped" << std::endl;
+}
+
+void MulticastReceiver::runLegacyLoop() {
     while (running) {
         ssize_t n = recv(sockfd, buffer, kBufferSize, 0);
         
@@ -123,98 +151,235 @@ void MulticastReceiver::start() {
             break;
         }
 
-        if (n < (ssize_t)sizeof(Packet)) {
-            stats.update(0, 0, 0, true);  // Record error
+        stats.recordReceiveCall(1);
+        handleDatagram(buffer, n);
+    }
+}
+
+void MulticastReceiver::runBatchedLoop() {
+    // stop() may have run before the eventfd existed – re-check after open()
+    while (running) {
+        int count = batch.receive();
+        if (count < 0) {
+            std::cerr << "recvmmsg() error: " << socket_error_string(socket_errno) << std::endl;
+            break;
+        }
+        if (count == 0) continue;  // Woken by stop() or spurious wakeup
+
+        stats.recordReceiveCall(count);
+        for (int i = 0; i < count; ++i) {
+            if (batch.truncated(i)) {  // Larger than a slot: the tail is gone
+                stats.recordTruncated();
+                continue;
+            }
+            udp_ingest::setCurrentPacketTimestamp(batch.timestampMicros(i));
+            handleDatagram(batch.data(i), static_cast<ssize_t>(batch.length(i)));
+        }
+        udp_ingest::setCurrentPacketTimestamp(0);
+    }
+}
+
+bool MulticastReceiver::startCapture(const std::string& path) {
+    auto writer = std::make_unique<udp_capture::CaptureWriter>();
+    if (!writer->open(path, groupIp, static_cast<uint16_t>(groupPort))) {
+        std::cerr << "Failed to open capture file: " << path << std::endl;
+        return false;
+    }
+    captureWriter = std::move(writer);
+    std::cout << "MulticastReceiver: capturing datagrams to " << path << std::endl;
+    return true;
+}
+
+void MulticastReceiver::injectDatagram(const uint8_t* data, size_t length) {
+    if (length > kBufferSize) length = kBufferSize;
+    // Offline receivers have no start(): bring the workers up on first use
+    if (parseWorkerCount > 1 && !fanout) startParseWorkers();
+    stats.recordReceiveCall(1);
+    handleDatagram(reinterpret_cast<const char*>(data), static_cast<ssize_t>(length));
+}
+
+// ─── Sharded parsing ─────────────────────────────────────
+
+void MulticastReceiver::startParseWorkers() {
+    if (parseWorkerCount <= 1 || fanout) return;
+
+    const size_t count = parseWorkerCount;
+    fanout = std::make_unique<udp_ingest::FanoutRing>(kFanoutRingBytes, count);
+    shardStats.clear();
+    for (size_t i = 1; i < count; ++i) shardStats.push_back(std::make_unique<UDPStats>());
+
+    parseRunning = true;
+    for (size_t i = 0; i < count; ++i) {
+        parseThreads.emplace_back(&MulticastReceiver::runParseWorker, this, i);
+    }
+    std::cout << "MulticastReceiver: sharded parsing on " << count << " workers" << std::endl;
+}
+
+void MulticastReceiver::stopParseWorkers() {
+    if (!fanout) return;
+    parseRunning = false;  // Workers drain what was published, then exit
+    for (auto& t : parseThreads) {
+        if (t.joinable()) t.join();
+    }
+    parseThreads.clear();
+    fanout.reset();
+}
+
+void MulticastReceiver::waitForParseWorkers() {
+    if (!fanout) return;
+    for (size_t i = 0; i < fanout->consumers(); ++i) {
+        while (!fanout->drained(i)) std::this_thread::yield();
+    }
+}
+
+void MulticastReceiver::runParseWorker(size_t index) {
+    if (index < parseWorkerCores.size() && parseWorkerCores[index] >= 0 &&
+        !udp_ingest::pinCurrentThreadToCore(parseWorkerCores[index])) {
+        std::cerr << "Warning: could not pin parse worker " << index
+                  << " to core " << parseWorkerCores[index] << std::endl;
+    }
+    shard::assign(static_cast<uint32_t>(index), static_cast<uint32_t>(parseWorkerCount));
+
+    // Every worker walks every datagram, so each counts every Nth one and
+    // getStats() sums the shards. Sequence gaps need the whole stream in
+    // order: shard 0 tracks them alone
+    UDPStats& counters = index == 0 ? stats : *shardStats[index - 1];
+    common::SequenceGapTracker* sequence = index == 0 ? &stats.sequence : nullptr;
+    size_t turn = 0;
+    auto parse = [&](const uint8_t* data, uint32_t length, int64_t timestamp) {
+        udp_ingest::setCurrentPacketTimestamp(timestamp);
+        UDPStats* target = turn == index ? &counters : nullptr;
+        if (++turn == parseWorkerCount) turn = 0;
+        processDatagram(reinterpret_cast<const char*>(data), static_cast<ssize_t>(length),
+                        target, sequence);
+    };
+
+    unsigned idle = 0;
+    for (;;) {
+        if (fanout->consume(index, parse) > 0) {
+            idle = 0;
             continue;
         }
+        if (!parseRunning.load(std::memory_order_acquire)) {
+            if (fanout->drained(index)) break;
+            continue;
+        }
+        // Spin briefly (bursts arrive back to back), then back off
+        if (++idle < 64) continue;
+        if (idle < 256) std::this_thread::yield();
+        else std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    udp_ingest::setCurrentPacketTimestamp(0);
+}
+
+void MulticastReceiver::handleDatagram(const char* data, ssize_t n) {
+    if (captureWriter) captureWriter->write(data, static_cast<size_t>(n));
+
+    if (!fanout) {
+        processDatagram(data, n, &stats, &stats.sequence);
+        return;
+    }
+
+    // Receive thread only stamps and publishes; wait for the slowest worker
+    // rather than drop (the socket buffer absorbs the burst meanwhile)
+    int64_t timestamp = udp_ingest::currentPacketTimestampRef();
+    if (timestamp <= 0) timestamp = udp_ingest::steadyNowMicros();
+    bool stalled = false;
+    while (!fanout->tryPublish(data, static_cast<size_t>(n), timestamp)) {
+        stalled = true;
+        std::this_thread::yield();
+    }
+    if (stalled) fanoutStallCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MulticastReceiver::processDatagram(const char* data, ssize_t n, UDPStats* counters,
+                                        common::SequenceGapTracker* sequence) {
+    if (n < (ssize_t)sizeof(Packet)) {
+        if (counters) counters->update(0, 0, 0, true);  // Record error
+        return;
+    }
+
+    // Parse packet header (read-only: with sharded parsing every worker
+    // walks the same bytes)
+    const Packet* pkt = reinterpret_cast<const Packet*>(data);
+    const int16_t noOfMsgs = be16toh_func(pkt->iNoOfMsgs);
 
-        packet_count++;
-
-        // Parse packet header
-        Packet* pkt = reinterpret_cast<Packet*>(buffer);
-        pkt->iNoOfMsgs = be16toh_func(pkt->iNoOfMsgs);
-
-        // -------------------------------------------------------
-        // Sequence gap detection (uses bcSeqNo from BCAST_HEADER).
-        // We detect gaps after decompression in parse_compressed_message,
-        // but we can also check the outer packet-level sequence counter
-        // embedded in cNetID[0..1] on some feeds.  Here we rely on the
-        // first message's broadcast header being available after decompression.
-        // For a lightweight outer check we use the running packet_count and
-        // track drop windows in stats.
-        // -------------------------------------------------------
-
-        // Parse messages
-        char* ptr = pkt->cPackData;
-        char* end = buffer + n;
-
-        for (int i = 0; i < pkt->iNoOfMsgs; ++i) {
-            try {
-                if (ptr + sizeof(int16_t) > end) {
-                    stats.update(0, 0, 0, true);  // Record error
+    // Parse messages
+    const char* ptr = pkt->cPackData;
+    const char* end = data + n;
+
+    for (int i = 0; i < noOfMsgs; ++i) {
+        try {
+            if (ptr + sizeof(int16_t) > end) {
+                if (counters) counters->update(0, 0, 0, true);  // Record error
+                break;
+            }
+
+            // Read iCompLen (first 2 bytes of MessageData)
+            int16_t iCompLen = be16toh_func(*((int16_t*)ptr));
+            
+            if (iCompLen > 0) {
+                // Compressed message
+                ptr += sizeof(int16_t);
+                
+                if (ptr + iCompLen > end) {
+                    if (counters) counters->update(0, 0, 0, true);  // Record error
+                    break;
+                }
+                
+                // Parse compressed message and update stats
+                parse_compressed_message(ptr, iCompLen, counters, sequence);
+                
+                ptr += iCompLen;
+                
+            } else {
+                // Uncompressed message
+                if (ptr + 54 > end) {
+                    if (counters) counters->update(0, 0, 0, true);  // Record error
                     break;
                 }
-
-                // Read iCompLen (first 2 bytes of MessageData)
-                int16_t iCompLen = be16toh_func(*((int16_t*)ptr));
                 
-                if (iCompLen > 0) {
-                    // Compressed message
-                    ptr += sizeof(int16_t);
-                    
-                    if (ptr + iCompLen > end) {
-                        stats.update(0, 0, 0, true);  // Record error
-                        break;
-                    }
-                    
-                    // Parse compressed message and update stats
-                    parse_compressed_message(ptr, iCompLen, stats);
-                    
-                    ptr += iCompLen;
-                    
-                } else {
-                    // Uncompressed message
-                    if (ptr + 54 > end) {
-                        stats.update(0, 0, 0, true);  // Record error
-                        break;
-                    }
-                    
-                    // MessageLength is at offset 52 from packet start (ptr points to offset 4)
-                    uint16_t msgLen = be16toh_func(*((uint16_t*)(ptr + 48)));
-                    
-                    if (ptr + 10 + msgLen > end) {
-                        stats.update(0, 0, 0, true);  // Record error
-                        break;
-                    }
-                    
-                    // Extract transaction code for stats
-                    uint16_t txCode = be16toh_func(*((uint16_t*)(ptr + 20)));  // Offset 10 of BCAST_HEADER
-                    
-                    // Update stats
-                    stats.update(txCode, 0, msgLen, false);
-                    
-                    // Parse uncompressed message
-                    parse_uncompressed_message(ptr + 10, msgLen);
-                    
-                    ptr += 10 + msgLen;
+                // MessageLength is at offset 52 from packet start (ptr points to offset 4)
+                uint16_t msgLen = be16toh_func(*((uint16_t*)(ptr + 48)));
+                
+                if (ptr + 10 + msgLen > end) {
+                    if (counters) counters->update(0, 0, 0, true);  // Record error
+                    break;
                 }
-            } catch (const std::exception& e) {
-                std::cerr << "Exception processing message " << i << ": " << e.what() << std::endl;
-                stats.update(0, 0, 0, true);  // Record error
-                break;  // Skip rest of messages in this packet
-            } catch (...) {
-                std::cerr << "Unknown exception processing message " << i << std::endl;
-                stats.update(0, 0, 0, true);  // Record error
-                break;  // Skip rest of messages in this packet
+                
+                // Extract transaction code for stats
+                uint16_t txCode = be16toh_func(*((uint16_t*)(ptr + 20)));  // Offset 10 of BCAST_HEADER
+                
+                // Update stats
+                if (counters) counters->update(txCode, 0, msgLen, false);
+                if (sequence) sequence->observeHeader(reinterpret_cast<const uint8_t*>(ptr + 10));
+                
+                // Parse uncompressed message
+                if (shard::ownsShared()) parse_uncompressed_message(ptr + 10, msgLen);
+                
+                ptr += 10 + msgLen;
             }
+        } catch (const std::exception& e) {
+            std::cerr << "Exception processing message " << i << ": " << e.what() << std::endl;
+            if (counters) counters->update(0, 0, 0, true);  // Record error
+            break;  // Skip rest of messages in this packet
+        } catch (...) {
+            std::cerr << "Unknown exception processing message " << i << std::endl;
+            if (counters) counters->update(0, 0, 0, true);  // Record error
+            break;  // Skip rest of messages in this packet
         }
     }
-    
-    std::cout << "MulticastReceiver stopped" << std::endl;
+}
+
+UDPStatsSnapshot MulticastReceiver::getStats() const {
+    UDPStatsSnapshot total = stats.snapshot();
+    for (const auto& shard : shardStats) total.add(*shard);
+    return total;
 }
 
 void MulticastReceiver::stop() {
     running = false;
+    batch.wakeup();  // Unblock epoll_wait() in batched mode
 }
 
 } // namespace nsefo
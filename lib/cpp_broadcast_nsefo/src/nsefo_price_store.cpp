@@ -11,40 +11,40 @@ void PriceStore::initializeToken(uint32_t token, const char* symbol, const char*
                     int32_t instrumentType, double tickSize) {
     uint32_t index = token - MIN_TOKEN;
     if (index >= ARRAY_SIZE) return;
+    if (!slab_.contains(token)) validTokenCount++;  // Recounted by initializeFromMaster
     
-    std::unique_lock lock(mutex_);
-    
-    if (!store_[index]) {
-        store_[index] = new UnifiedTokenState();
-    }
-    
-    auto& row = *store_[index];
-    row.token = token;
-    strncpy(row.symbol, symbol, 31);
-    strncpy(row.displayName, displayName, 63);
-    row.lotSize = lotSize;
-    row.strikePrice = strikePrice;
-    strncpy(row.optionType, optionType, 2);
-    strncpy(row.expiryDate, expiryDate, 15);
-    row.assetToken = assetToken;
-    row.instrumentType = instrumentType;
-    row.tickSize = tickSize;
+    slab_.initialize(token, [&](Row row) {
+        row.tick.token = token;
+        strncpy(row.info.symbol, symbol, 31);
+        strncpy(row.info.displayName, displayName, 63);
+        row.info.lotSize = lotSize;
+        row.info.strikePrice = strikePrice;
+        strncpy(row.info.optionType, optionType, 2);
+        strncpy(row.info.expiryDate, expiryDate, 15);
+        row.info.assetToken = assetToken;
+        row.info.instrumentType = instrumentType;
+        row.info.tickSize = tickSize;
+    });
 }
 
 void PriceStore::initializeFromMaster(const std::vector<uint32_t>& tokens) {
-    std::unique_lock lock(mutex_);
+    slab_.reserve(tokens.size());
     validTokenCount = 0;
     for (uint32_t token : tokens) {
         if (token >= MIN_TOKEN && token <= MAX_TOKEN) {
-            uint32_t index = token - MIN_TOKEN;
-            if (!store_[index]) {
-                store_[index] = new UnifiedTokenState();
-            }
-            store_[index]->token = token;
+            slab_.initialize(token, [token](Row row) {
+                row.tick.token = token;
+            });
             validTokenCount++;
         }
     }
     qDebug() << "[NSE FO Store] Initialized" << validTokenCount << "valid tokens in Unified Store";
 }
 
+bool PriceStore::removeToken(uint32_t token) {
+    if (token < MIN_TOKEN || token > MAX_TOKEN || !slab_.erase(token)) return false;
+    if (validTokenCount > 0) validTokenCount--;
+    return true;
+}
+
 } // namespace nsefo
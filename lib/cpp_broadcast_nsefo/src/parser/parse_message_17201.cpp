@@ -1,7 +1,7 @@
 #include "nse_parsers.h"
 #include "protocol.h"
 #include "nsefo_callback.h"
-#include <iostream>
+#include "parse_shard.h"
 
 namespace nsefo {
 
@@ -9,13 +9,11 @@ namespace nsefo {
 void parse_message_17201(const MS_ENHNCD_BCAST_INQ_RESP_2* msg) {
     uint16_t numRecords = be16toh_func(msg->noOfRecords);
     
-    std::cout << "\n[17201 PARSER] Called with " << numRecords << " records" << std::endl;
-    
     for (int i = 0; i < numRecords && i < 5; i++) {
         const auto& rec = msg->records[i];
         uint32_t token = be32toh_func(rec.token);
 
-        if (token > 0) {
+        if (token > 0 && shard::ownsToken(token)) {
             // Parse enhanced market watch data
             MarketWatchData mw;
             mw.token = token;
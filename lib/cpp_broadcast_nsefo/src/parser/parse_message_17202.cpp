@@ -1,7 +1,10 @@
 #include "nse_parsers.h"
 #include "protocol.h"
 #include "nsefo_callback.h"
+#include "parse_shard.h"
+#include "token_interest.h"
 #include "nsefo_price_store.h"
+#include "udp_batch_receiver.h"
 #include <iostream>
 #include <chrono>
 #include <cstring>
@@ -11,39 +14,30 @@ namespace nsefo {
 
 void parse_message_17202(const MS_ENHNCD_TICKER_TRADE_DATA* msg) {
     uint16_t numRecords = be16toh_func(msg->numberOfRecords);
+    const common::SegmentInterest& interest = *common::segmentInterest(2);
 
-    
-
-    
     for (int i = 0; i < numRecords && i < 12; i++) {
         const auto& rec = msg->records[i];
         uint32_t token = be32toh_func(rec.token);
         
-        if (token > 0) {
-            // Unified Token State
-            UnifiedTokenState state;
-            std::memset(&state, 0, sizeof(state));
-            
-            state.token = token;
-            // No timestampRecv in current parser provided?? 
-            // 7200 capture "now". 17202 doesn't capture time?
-            // "auto now = ..." is MISSING in 17202 parser provided in view_file?
-            // Wait, view_file output had NO time capture logic.
-            // I should add it.
-            
-            auto now = std::chrono::duration_cast<std::chrono::microseconds>(
-                std::chrono::steady_clock::now().time_since_epoch()).count();
-            state.lastPacketTimestamp = now;
-
-            state.ltp = be32toh_func(rec.fillPrice) / 100.0;
-            state.lastTradeQty = be32toh_func(rec.fillVolume);
-            state.openInterest = be64toh_func((uint64_t)rec.openInterest); // 17202 has 64-bit OI
+        if (token > 0 && shard::ownsToken(token) && interest.wantsRecord(token)) {
+            // Parse-once delta: the store keeps only OI from tickers
+            // (LTP stays owned by 7200 / 7208), so that is all we carry
+            auto now = udp_ingest::packetTimestampOrNow();
+            TickDelta delta;
+            delta.token = token;
+            delta.messageType = 17202;
+            delta.fields = TickDelta::OI;
+            delta.timestampRecv = now;
+            delta.openInterest = be64toh_func((uint64_t)rec.openInterest); // 17202 has 64-bit OI
             
-            // Update Store
-            g_nseFoPriceStore.updateTicker(state);
+            // Apply to Store (merged row copied out in the same write)
+            MarketData::TouchlineState tick;
+            MarketData::DepthState depth;
+            if (!g_nseFoPriceStore.applyDelta(delta, tick, depth)) continue;
             
-            // Dispatch ticker callback (Token only)
-            MarketDataCallbackRegistry::instance().dispatchTicker(token);
+            // Forward the same delta
+            MarketDataCallbackRegistry::instance().dispatchTickDelta(delta, tick, depth);
         }
     }
 }
@@ -1,6 +1,7 @@
 #include "nse_parsers.h"
 #include "protocol.h"
 #include "nsefo_callback.h"
+#include "parse_shard.h"
 #include <iostream>
 
 namespace nsefo {
@@ -13,7 +14,7 @@ void parse_message_7201(const MS_BCAST_INQ_RESP_2* msg) {
         const auto& rec = msg->records[i];
         uint32_t token = be32toh_func(rec.token);
         
-        if (token > 0) {
+        if (token > 0 && shard::ownsToken(token)) {
             // Parse market watch data
             MarketWatchData mw;
             mw.token = token;
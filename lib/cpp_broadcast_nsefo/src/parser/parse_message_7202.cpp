@@ -1,7 +1,10 @@
 #include "nse_parsers.h"
 #include "protocol.h"
 #include "nsefo_callback.h"
+#include "parse_shard.h"
+#include "token_interest.h"
 #include "nsefo_price_store.h"
+#include "udp_batch_receiver.h"
 #include <iostream>
 #include <chrono>
 
@@ -12,34 +15,32 @@ void parse_message_7202(const MS_TICKER_TRADE_DATA* msg) {
     uint16_t numRecords = be16toh_func(msg->numberOfRecords);
     
     // Capture timestamps for latency tracking
-    static uint64_t refNoCounter = 0;
-    auto now = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()).count();
+    auto now = udp_ingest::packetTimestampOrNow();
     
+    const common::SegmentInterest& interest = *common::segmentInterest(2);
+
     for (int i = 0; i < numRecords && i < 17; i++) {
         const auto& rec = msg->records[i];
         uint32_t token = be32toh_func(rec.token);
         
-        if (token > 0) {
-            uint64_t refNo = ++refNoCounter;
-            
-            // Unified Token State
-            UnifiedTokenState state;
-            std::memset(&state, 0, sizeof(state)); 
-            
-            state.token = token;
-            state.lastPacketTimestamp = now;
-            
-            state.ltp = be32toh_func(rec.fillPrice) / 100.0;
-            state.lastTradeQty = be32toh_func(rec.fillVolume);
-            state.openInterest = be32toh_func(rec.openInterest);
+        if (token > 0 && shard::ownsToken(token) && interest.wantsRecord(token)) {
+            // Parse-once delta: the store keeps only OI from tickers
+            // (LTP stays owned by 7200 / 7208), so that is all we carry
+            TickDelta delta;
+            delta.token = token;
+            delta.messageType = 7202;
+            delta.fields = TickDelta::OI;
+            delta.timestampRecv = now;
+            delta.openInterest = be32toh_func(rec.openInterest);
             // Note: dayHiOI/dayLoOI not stored in UnifiedTokenState currently as per PriceStore design
             
-            // Update Store
-            g_nseFoPriceStore.updateTicker(state);
+            // Apply to Store (merged row copied out in the same write)
+            MarketData::TouchlineState tick;
+            MarketData::DepthState depth;
+            if (!g_nseFoPriceStore.applyDelta(delta, tick, depth)) continue;
             
-            // Dispatch ticker callback (Token only)
-            MarketDataCallbackRegistry::instance().dispatchTicker(token);
+            // Forward the same delta
+            MarketDataCallbackRegistry::instance().dispatchTickDelta(delta, tick, depth);
         }
     }
 }
@@ -1,6 +1,7 @@
 #include "nse_parsers.h"
 #include "nse_index_messages.h"
 #include "nsefo_callback.h"
+#include "udp_batch_receiver.h"
 #include <chrono>
 #include <cstring>
 
@@ -16,8 +17,7 @@ void parse_bcast_indices(const MS_BCAST_INDICES* msg) {
     }
     
     auto& registry = MarketDataCallbackRegistry::instance();
-    auto timestampParsed = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()).count();
+    auto timestampParsed = udp_ingest::packetTimestampOrNow();
     
     uint16_t numRecords = msg->numberOfRecords;
     if (numRecords > 6) {
@@ -1,8 +1,10 @@
 #include "nse_parsers.h"
 #include "nse_market_data.h"
 #include "nsefo_callback.h"
+#include "parse_shard.h"
 #include "nsefo_price_store.h"
 #include "protocol.h"
+#include "udp_batch_receiver.h"
 #include <chrono>
 #include <iostream>
 
@@ -18,8 +20,7 @@ void parse_limit_price_protection(const MS_BCAST_LIMIT_PRICE_PROTECTION_RANGE* m
     }
     
     auto& registry = MarketDataCallbackRegistry::instance();
-    auto timestampParsed = std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()).count();
+    auto timestampParsed = udp_ingest::packetTimestampOrNow();
     
     uint32_t msgCount = be32toh_func(msg->data.msgCount);
     
@@ -28,6 +29,7 @@ void parse_limit_price_protection(const MS_BCAST_LIMIT_PRICE_PROTECTION_RANGE* m
         uint32_t token = be32toh_func(detail.tokenNumber);
         
         if (token == 0) continue;  // Skip empty slots
+        if (!shard::ownsToken(token)) continue;
         
         UnifiedTokenState state;
         std::memset(&state, 0, sizeof(state));
@@ -0,0 +1,379 @@
+// udp_replay - deterministic offline replay of captured broadcast datagrams
+// =========================================================================
+//
+// Feeds pcap captures (written by UdpBroadcastService when [UDP] capture_dir
+// is set, or taken with tcpdump) through socketless receivers, in capture
+// timestamp order across all files:
+//
+//   datagram → parser → PriceStore → tick ring → pump → FeedHandler
+//
+// No sockets and no UI; the Qt event loop only runs the tick pump. Reports
+// per-stage throughput and latency percentiles.
+//
+// Usage:
+//   udp_replay [--nsefo FILE[@PORT]] [--nsecm FILE[@PORT]]
+//              [--bsefo FILE[@PORT]] [--bsecm FILE[@PORT]]
+//              [--speed 1|N|max] [--masters DIR] [--no-pump]
+//              [--workers N] [--scale]
+//
+// @PORT keeps only datagrams sent to that UDP port (tcpdump captures holding
+// several feeds). Without --masters the price stores have no rows, so only
+// the parse stage runs.
+//
+// --workers N parses NSE FO on N token-sharded workers (Config::
+// nseFoParseWorkers). --scale loads the NSE FO capture into memory and
+// replays it at max speed with 1..8 workers, printing datagrams/s per run.
+
+#include "services/UdpBroadcastService.h"
+#include "data/PriceStoreGateway.h"
+#include "repository/RepositoryManager.h"
+#include "udp_batch_receiver.h"
+#include "udp_capture.h"
+
+#include <QCoreApplication>
+#include <QMetaObject>
+#include <QTimer>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Source {
+    ExchangeReceiver segment;
+    std::string path;
+    uint16_t port = 0;
+    udp_capture::CaptureReader reader;
+    udp_capture::Datagram current;
+    bool hasCurrent = false;
+    uint64_t datagrams = 0;
+    uint64_t bytes = 0;
+};
+
+struct Options {
+    std::vector<std::unique_ptr<Source>> sources;
+    double speed = 0.0;        // <= 0: as fast as possible
+    std::string mastersDir;
+    bool pump = true;
+    int workers = 0;           // NSE FO parse workers (<= 1: inline)
+    bool scale = false;
+};
+
+int64_t steadyNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+class LatencySamples {
+public:
+    void reserve(size_t n) { nanos_.reserve(n); }
+    void add(int64_t nanos) { nanos_.push_back(nanos); }
+    size_t size() const { return nanos_.size(); }
+
+    void print(const char* stage, double seconds) {
+        std::cout << std::left << std::setw(10) << stage << std::right
+                  << std::setw(12) << nanos_.size();
+        if (nanos_.empty()) {
+            std::cout << "  (no samples)" << std::endl;
+            return;
+        }
+        std::sort(nanos_.begin(), nanos_.end());
+        auto pct = [this](double p) {
+            size_t idx = static_cast<size_t>(p * nanos_.size());
+            return nanos_[std::min(idx, nanos_.size() - 1)] / 1000.0;
+        };
+        std::cout << std::fixed << std::setprecision(0)
+                  << std::setw(12) << (seconds > 0 ? nanos_.size() / seconds : 0.0)
+                  << std::setprecision(2)
+                  << std::setw(10) << pct(0.50) << std::setw(10) << pct(0.90)
+                  << std::setw(10) << pct(0.99) << std::setw(10) << pct(0.999)
+                  << std::setw(12) << nanos_.back() / 1000.0 << std::endl;
+    }
+
+private:
+    std::vector<int64_t> nanos_;
+};
+
+void printUsage() {
+    std::cerr << "Usage: udp_replay [--nsefo FILE[@PORT]] [--nsecm FILE[@PORT]]\n"
+                 "                  [--bsefo FILE[@PORT]] [--bsecm FILE[@PORT]]\n"
+                 "                  [--speed 1|N|max] [--masters DIR] [--no-pump]\n"
+                 "                  [--workers N] [--scale]\n";
+}
+
+bool addSource(Options& opts, ExchangeReceiver segment, const std::string& spec) {
+    auto src = std::make_unique<Source>();
+    src->segment = segment;
+    src->path = spec;
+    const size_t at = spec.rfind('@');
+    if (at != std::string::npos && at + 1 < spec.size() &&
+        spec.find_first_not_of("0123456789", at + 1) == std::string::npos) {
+        src->path = spec.substr(0, at);
+        src->port = static_cast<uint16_t>(std::atoi(spec.c_str() + at + 1));
+    }
+    if (!src->reader.open(src->path)) {
+        std::cerr << src->path << ": " << src->reader.error() << std::endl;
+        return false;
+    }
+    src->reader.setPortFilter(src->port);
+    opts.sources.push_back(std::move(src));
+    return true;
+}
+
+bool parseArgs(int argc, char* argv[], Options& opts) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--nsefo" && hasValue) {
+            if (!addSource(opts, ExchangeReceiver::NSEFO, argv[++i])) return false;
+        } else if (arg == "--nsecm" && hasValue) {
+            if (!addSource(opts, ExchangeReceiver::NSECM, argv[++i])) return false;
+        } else if (arg == "--bsefo" && hasValue) {
+            if (!addSource(opts, ExchangeReceiver::BSEFO, argv[++i])) return false;
+        } else if (arg == "--bsecm" && hasValue) {
+            if (!addSource(opts, ExchangeReceiver::BSECM, argv[++i])) return false;
+        } else if (arg == "--speed" && hasValue) {
+            const std::string value = argv[++i];
+            opts.speed = value == "max" ? 0.0 : std::atof(value.c_str());  // "10x" → 10
+        } else if (arg == "--masters" && hasValue) {
+            opts.mastersDir = argv[++i];
+        } else if (arg == "--no-pump") {
+            opts.pump = false;
+        } else if (arg == "--workers" && hasValue) {
+            opts.workers = std::atoi(argv[++i]);
+        } else if (arg == "--scale") {
+            opts.scale = true;
+        } else {
+            return false;
+        }
+    }
+    return !opts.sources.empty();
+}
+
+// Create price-store rows and enable callbacks for every master contract
+bool loadMasters(const std::string& dir) {
+    RepositoryManager* repo = RepositoryManager::getInstance();
+    if (!repo->loadAll(QString::fromStdString(dir))) return false;
+
+    auto tokensOf = [repo](const char* exchange, const char* segment, int segmentId) {
+        std::vector<uint32_t> tokens;
+        for (const auto& contract : repo->getContractsBySegment(exchange, segment)) {
+            tokens.push_back(static_cast<uint32_t>(contract.exchangeInstrumentID));
+            MarketData::PriceStoreGateway::instance().setTokenEnabled(
+                segmentId, tokens.back(), true);
+        }
+        return tokens;
+    };
+    auto nseFo = tokensOf("NSE", "FO", 2);
+    auto nseCm = tokensOf("NSE", "CM", 1);
+    auto bseFo = tokensOf("BSE", "FO", 12);
+    auto bseCm = tokensOf("BSE", "CM", 11);
+    MarketData::PriceStoreGateway::instance().initialize(nseFo, nseCm, bseFo, bseCm);
+    std::cout << "Masters: NSEFO " << nseFo.size() << " | NSECM " << nseCm.size()
+              << " | BSEFO " << bseFo.size() << " | BSECM " << bseCm.size() << std::endl;
+    return true;
+}
+
+bool hasSegment(const Options& opts, ExchangeReceiver segment) {
+    return std::any_of(opts.sources.begin(), opts.sources.end(),
+                       [segment](const auto& src) { return src->segment == segment; });
+}
+
+// NSE FO parse scaling: same in-memory traffic, 1..8 workers. No event loop
+// runs, so once the tick rings fill further ticks count as ring drops – the
+// cost measured is receive hand-off + decompress + parse + store + callbacks.
+int runScaling(Options& opts) {
+    std::vector<std::vector<uint8_t>> datagrams;
+    uint64_t bytes = 0;
+    for (auto& src : opts.sources) {
+        if (src->segment != ExchangeReceiver::NSEFO) continue;
+        udp_capture::Datagram dg;
+        while (src->reader.next(dg)) {
+            datagrams.emplace_back(dg.data, dg.data + dg.length);
+            bytes += dg.length;
+        }
+    }
+    if (datagrams.empty()) {
+        std::cerr << "--scale needs an --nsefo capture" << std::endl;
+        return 1;
+    }
+    std::cout << "NSE FO scaling: " << datagrams.size() << " datagrams ("
+              << std::fixed << std::setprecision(2) << bytes / 1024.0 / 1024.0
+              << " MB), " << std::thread::hardware_concurrency() << " hardware threads\n"
+              << "\nWorkers   Seconds   Datagrams/s   Speedup   Stalls" << std::endl;
+
+    UdpBroadcastService& udp = UdpBroadcastService::instance();
+    double baseline = 0;
+    for (int workers = 1; workers <= 8; ++workers) {
+        UdpBroadcastService::Config config;
+        config.enableNSEFO = true;
+        config.enableNSECM = config.enableBSEFO = config.enableBSECM = false;
+        config.mainThreadPump = opts.pump;
+        config.nseFoParseWorkers = workers;
+        if (!udp.startReplay(config)) return 1;
+
+        const int64_t start = steadyNanos();
+        for (const auto& dg : datagrams) {
+            udp_ingest::setCurrentPacketTimestamp(steadyNanos() / 1000);
+            udp.replayDatagram(ExchangeReceiver::NSEFO, dg.data(), dg.size());
+        }
+        udp.finishReplay();
+        const double seconds = (steadyNanos() - start) / 1e9;
+        udp_ingest::setCurrentPacketTimestamp(0);
+
+        const auto stats = udp.getStats();
+        udp.stop();
+
+        const double rate = seconds > 0 ? datagrams.size() / seconds : 0.0;
+        if (workers == 1) baseline = rate;
+        std::cout << std::setw(7) << workers << std::setw(10) << std::setprecision(3) << seconds
+                  << std::setw(14) << std::setprecision(0) << rate
+                  << std::setw(9) << std::setprecision(2) << (baseline > 0 ? rate / baseline : 0.0) << "x"
+                  << std::setw(9) << stats.nseFoFanoutStalls << std::endl;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    qRegisterMetaType<UDP::MarketTick>("UDP::MarketTick");
+
+    Options opts;
+    if (!parseArgs(argc, argv, opts)) {
+        printUsage();
+        return 1;
+    }
+
+    if (opts.mastersDir.empty()) {
+        std::cout << "No --masters: price stores are empty, only the parse stage runs" << std::endl;
+    } else if (!loadMasters(opts.mastersDir)) {
+        std::cerr << "Failed to load masters from " << opts.mastersDir << std::endl;
+        return 1;
+    }
+    if (opts.scale) return runScaling(opts);
+
+    UdpBroadcastService::Config config;
+    config.enableNSEFO = hasSegment(opts, ExchangeReceiver::NSEFO);
+    config.enableNSECM = hasSegment(opts, ExchangeReceiver::NSECM);
+    config.enableBSEFO = hasSegment(opts, ExchangeReceiver::BSEFO);
+    config.enableBSECM = hasSegment(opts, ExchangeReceiver::BSECM);
+    config.mainThreadPump = opts.pump;
+    config.nseFoParseWorkers = opts.workers;
+
+    UdpBroadcastService& udp = UdpBroadcastService::instance();
+    udp.setSubscriptionFilterEnabled(false);  // Every tick reaches the signal
+    if (!udp.startReplay(config)) {
+        std::cerr << "No receivers to replay into" << std::endl;
+        return 1;
+    }
+
+    // Deliver stage: receive → FeedHandler/udpTickReceived, per tick. Only
+    // NSE ticks carry the steady-clock receive time set below.
+    LatencySamples deliver;
+    uint64_t ticksDelivered = 0;
+    QObject::connect(&udp, &UdpBroadcastService::udpTickReceived, &app,
+                     [&](const UDP::MarketTick& tick) {
+        ++ticksDelivered;
+        const bool nse = tick.exchangeSegment == ExchangeSegment::NSEFO ||
+                         tick.exchangeSegment == ExchangeSegment::NSECM;
+        if (nse && tick.timestampUdpRecv > 0) {
+            deliver.add((udp_ingest::steadyNowMicros() -
+                         static_cast<int64_t>(tick.timestampUdpRecv)) * 1000);
+        }
+    });
+
+    // Ingest stage: one datagram through parse → PriceStore → tick ring
+    LatencySamples ingest;
+    ingest.reserve(1 << 20);
+    double replaySeconds = 0;
+
+    std::thread replayThread([&]() {
+        udp_capture::ReplayPacer pacer(opts.speed);
+        const int64_t start = steadyNanos();
+        for (;;) {
+            // Merge all captures by timestamp (deterministic order)
+            Source* next = nullptr;
+            for (auto& src : opts.sources) {
+                if (!src->hasCurrent) src->hasCurrent = src->reader.next(src->current);
+                if (src->hasCurrent &&
+                    (!next || src->current.timestampNanos < next->current.timestampNanos)) {
+                    next = src.get();
+                }
+            }
+            if (!next) break;
+
+            pacer.wait(next->current.timestampNanos);
+            const int64_t t0 = steadyNanos();
+            udp_ingest::setCurrentPacketTimestamp(t0 / 1000);
+            udp.replayDatagram(next->segment, next->current.data, next->current.length);
+            ingest.add(steadyNanos() - t0);
+
+            next->datagrams++;
+            next->bytes += next->current.length;
+            next->hasCurrent = false;
+        }
+        udp_ingest::setCurrentPacketTimestamp(0);
+        udp.finishReplay();
+        replaySeconds = (steadyNanos() - start) / 1e9;
+
+        // Let the pump drain what is still queued, then leave the event loop
+        QMetaObject::invokeMethod(&app, [&app, &config]() {
+            QTimer::singleShot(std::max(50, 4 * config.pumpIntervalMs), &app,
+                               &QCoreApplication::quit);
+        }, Qt::QueuedConnection);
+    });
+
+    app.exec();
+    replayThread.join();
+
+    // ─── Report ───
+    uint64_t totalDatagrams = 0;
+    uint64_t totalBytes = 0;
+    std::cout << "\n=== udp_replay ===" << std::endl;
+    for (const auto& src : opts.sources) {
+        std::cout << ExchangeSegmentUtil::toString(src->segment).toStdString() << ": "
+                  << src->path << "  datagrams " << src->datagrams
+                  << "  skipped frames " << src->reader.skipped() << std::endl;
+        totalDatagrams += src->datagrams;
+        totalBytes += src->bytes;
+    }
+    std::cout << "Replayed " << totalDatagrams << " datagrams ("
+              << std::fixed << std::setprecision(2) << totalBytes / 1024.0 / 1024.0
+              << " MB) in " << std::setprecision(3) << replaySeconds << " s at "
+              << (opts.speed > 0 ? std::to_string(opts.speed) + "x" : std::string("max speed"))
+              << std::endl;
+
+    std::cout << "\nStage            Count      Rate/s   p50(us)   p90(us)   p99(us) p99.9(us)     max(us)"
+              << std::endl;
+    ingest.print("ingest", replaySeconds);
+    deliver.print("deliver", replaySeconds);
+    std::cout << "ingest  = parse + PriceStore + tick ring push, per datagram"
+              << (opts.workers > 1 ? " (NSE FO: hand-off to parse workers only)" : "") << "\n"
+                 "deliver = receive → FeedHandler + udpTickReceived, per NSE tick ("
+              << ticksDelivered << " ticks delivered, all segments)" << std::endl;
+
+    const auto stats = udp.getStats();
+    std::cout << "\nTick rings: drops NSEFO " << stats.nseFoQueue.drops
+              << " | NSECM " << stats.nseCmQueue.drops
+              << " | BSEFO " << stats.bseFoQueue.drops
+              << " | BSECM " << stats.bseCmQueue.drops
+              << " | coalesced " << stats.coalescedTicks << std::endl;
+    if (config.enableNSEFO) std::cout << "NSEFO " << stats.nseFoSequence << std::endl;
+    if (stats.nseFoParseWorkers > 1) {
+        std::cout << "NSEFO parse workers: " << stats.nseFoParseWorkers
+                  << " | fanout stalls: " << stats.nseFoFanoutStalls << std::endl;
+    }
+    if (config.enableNSECM) std::cout << "NSECM " << stats.nseCmSequence << std::endl;
+
+    udp.stop();
+    return 0;
+}
@@ -16,7 +16,6 @@ namespace nsefo {
 
 UDPStats::UDPStats() {
     startTime = std::chrono::steady_clock::now();
-    lastGapLogTime = startTime;
 }
 
 void UDPStats::update(uint16_t code, int compressedSize, int rawSize, bool error) {
@@ -43,26 +42,6 @@ void UDPStats::recordPacket() {
     totalPackets++;
 }
 
-void UDPStats::recordSequenceGap(uint32_t expected, uint32_t actual) {
-    sequenceGaps++;
-    if (actual > expected) {
-        droppedMessages += (actual - expected);
-    }
-    
-    // Throttle logging: only log every 100 gaps OR every 10 seconds
-    auto now = std::chrono::steady_clock::now();
-    bool shouldLog = (sequenceGaps - lastLoggedGapCount >= 100) ||
-                     (std::chrono::duration_cast<std::chrono::seconds>(now - lastGapLogTime).count() >= 10);
-    
-    if (shouldLog) {
-        uint64_t gapsSinceLastLog = sequenceGaps - lastLoggedGapCount;
-        std::cerr << "[SeqGap] " << gapsSinceLastLog << " gaps detected (total: " 
-                  << sequenceGaps << ", dropped≈" << droppedMessages << ")" << std::endl;
-        lastLoggedGapCount = sequenceGaps;
-        lastGapLogTime = now;
-    }
-}
-
 void UDPStats::print() {
     auto now = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::seconds>(now - startTime).count();
@@ -73,8 +52,7 @@ void UDPStats::print() {
     std::cout << "Runtime: " << duration << "s" << std::endl;
     std::cout << "Total Packets: " << totalPackets << std::endl;
     std::cout << "Total Bytes: " << totalBytes / 1024.0 / 1024.0 << " MB" << std::endl;
-    std::cout << "Sequence Gaps: " << sequenceGaps
-              << " | Estimated Dropped Messages: " << droppedMessages << std::endl;
+    std::cout << sequence.counters() << std::endl;
     
     std::cout << "\nCode   Name                            Count       Comp(KB)    Raw(KB)" << std::endl;
     std::cout << "--------------------------------------------------------------------------------" << std::endl;
@@ -91,7 +69,37 @@ void UDPStats::print() {
     std::cout << std::endl;
 }
 
+UDPStatsSnapshot UDPStats::snapshot() const {
+    UDPStatsSnapshot s;
+    s.add(*this);
+    s.sequence = sequence.counters();
+    s.startTime = startTime;
+    return s;
+}
+
+void UDPStatsSnapshot::add(const UDPStats& stats) {
+    totalPackets += stats.totalPackets;
+    totalBytes += stats.totalBytes;
+    compressedPackets += stats.compressedPackets;
+    decompressedPackets += stats.decompressedPackets;
+    decompressionFailures += stats.decompressionFailures;
+    recvCalls += stats.recvCalls.load(std::memory_order_relaxed);
+    datagramsReceived += stats.datagramsReceived.load(std::memory_order_relaxed);
+    truncatedDatagrams += stats.truncatedDatagrams.load(std::memory_order_relaxed);
+    for (const auto& pair : stats.messageStats) {
+        auto& stat = messageStats[pair.first];
+        stat.transactionCode = pair.first;
+        stat.count += pair.second.count;
+        stat.totalCompressedSize += pair.second.totalCompressedSize;
+        stat.totalRawSize += pair.second.totalRawSize;
+    }
+}
+
 std::ostream& operator<<(std::ostream& os, const UDPStats& stats) {
+    return os << stats.snapshot();
+}
+
+std::ostream& operator<<(std::ostream& os, const UDPStatsSnapshot& stats) {
     auto now = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::seconds>(now - stats.startTime).count();
 
@@ -103,8 +111,14 @@ std::ostream& operator<<(std::ostream& os, const UDPStats& stats) {
     os << "Compressed: " << stats.compressedPackets << " | Decompressed: " << stats.decompressedPackets 
        << " | Failures: " << stats.decompressionFailures << std::endl;
     os << "Total Bytes: " << stats.totalBytes / 1024.0 / 1024.0 << " MB" << std::endl;
-    os << "Sequence Gaps: " << stats.sequenceGaps
-       << " | Estimated Dropped Messages: " << stats.droppedMessages << std::endl;
+    if (stats.recvCalls > 0) {
+        os << "Receive Calls: " << stats.recvCalls << " | Packets/syscall: "
+           << std::fixed << std::setprecision(2) << stats.packetsPerSyscall() << std::endl;
+    }
+    if (stats.truncatedDatagrams > 0) {
+        os << "Truncated datagrams (dropped): " << stats.truncatedDatagrams << std::endl;
+    }
+    os << stats.sequence << std::endl;
     
     if (!stats.messageStats.empty()) {
         os << "\nCode   Name                            Count       Comp(KB)    Raw(KB)" << std::endl;
@@ -4,14 +4,16 @@
 #include "protocol.h"
 #include "constants.h"
 #include "nse_parsers.h"
+#include "parse_shard.h"
 #include <iostream>
 #include <iomanip>
-#include <vector>
+#include <algorithm>
 #include <atomic>
 
 namespace nsefo {
 
-void parse_compressed_message(const char* data, int16_t length, UDPStats& stats) {
+void parse_compressed_message(const char* data, int16_t length, UDPStats* stats,
+                              common::SequenceGapTracker* sequence) {
     // Decompression error counters – use atomics so this function is safe
     // even if called from multiple threads in a future multi-feed scenario.
     static std::atomic<int> total_messages{0};
@@ -20,26 +22,22 @@ void parse_compressed_message(const char* data, int16_t length, UDPStats& stats)
     static std::atomic<int> lookbehind_errors{0};
     static std::atomic<int> other_errors{0};
 
-    // Per-feed sequence tracking to detect dropped messages.
-    // Key: bcSeqNo from BCAST_HEADER (offset 14 within the header).
-    // We track the last seen sequence number and flag gaps.
-    static std::atomic<uint32_t> lastSeqNo{0};
-    static std::atomic<bool> seqNoInitialized{false};
-
-    int msgCount = ++total_messages;
-    
-    // Decompress using official LZO library
-    std::vector<uint8_t> input(data, data + length);
-    std::vector<uint8_t> output(65535);  // Large output buffer for decompressed data
+    // With sharded parsing every worker decodes every message; only shard 0
+    // keeps the decompression statistics
+    const bool reporting = shard::ownsShared();
+    int msgCount = reporting ? ++total_messages : 0;
     
-    int result;
-    try {
-        result = common::LzoDecompressor::decompressWithLibrary(input, output);
-        ++successful_decompressions;
-    } catch (const std::exception& e) {
+    // Decompress straight from the packet buffer into the per-thread scratch
+    // arena - no heap allocation and no exceptions on the receive thread
+    uint8_t* output = common::LzoDecompressor::scratch();
+    int result = common::LzoDecompressor::decompressInto(
+        reinterpret_cast<const uint8_t*>(data), length > 0 ? static_cast<size_t>(length) : 0,
+        output, common::LzoDecompressor::kScratchSize);
+
+    if (result < 0) {
+        if (!reporting) return;
         ++failed_decompressions;
-        std::string error_msg = e.what();
-        if (error_msg.find("lookbehind") != std::string::npos) {
+        if (result == static_cast<int>(common::LzoError::LOOKBEHIND_OVERRUN)) {
             ++lookbehind_errors;
         } else {
             ++other_errors;
@@ -49,7 +47,8 @@ void parse_compressed_message(const char* data, int16_t length, UDPStats& stats)
         static std::atomic<int> error_count{0};
         int ec = ++error_count;
         if (ec <= 10) {
-            std::cout << "\n[Decompression Error #" << ec << "] " << error_msg << std::endl;
+            std::cout << "\n[Decompression Error #" << ec << "] LZO: "
+                      << common::LzoDecompressor::errorString(result) << std::endl;
             std::cout << "Input length: " << length << " bytes" << std::endl;
             std::cout << "First 16 bytes: ";
             for (int i = 0; i < std::min((int)length, 16); i++) {
@@ -74,66 +73,29 @@ void parse_compressed_message(const char* data, int16_t length, UDPStats& stats)
         }
         return;
     }
+    if (reporting) ++successful_decompressions;
     
-    if (result <= 0) {
-        // std::cout << "  [Error] Decompression failed with result: " << result << std::endl;
+    if (result == 0) {
         return;
     }
-    
-    // Resize output to actual decompressed size
-    output.resize(result);
 
     // Skip first 8 bytes of the decompressed data (magic offset)
     size_t header_offset = CommonConfig::COMPRESSED_HEADER_OFFSET;
     
-    if (result < header_offset + sizeof(BCAST_HEADER)) { 
+    if (static_cast<size_t>(result) < header_offset + sizeof(BCAST_HEADER)) { 
         return;
     }
 
     // Pointer to start of BCAST_HEADER
-    const uint8_t* message_data = output.data() + header_offset;
+    const uint8_t* message_data = output + header_offset;
     size_t message_size = result - header_offset;
     
     // Extract Transaction Code from offset 10 of the BCAST_HEADER
     uint16_t txCode = be16toh_func(*((uint16_t*)(message_data + CommonConfig::BCAST_HEADER_TXCODE_OFFSET)));
 
-    // -------------------------------------------------------
-    // DISABLED: Sequence gap detection via bcSeqNo (offset 14 of BCAST_HEADER).
-    // 
-    // NSE FO multicast sends MULTIPLE INDEPENDENT STREAMS (different instruments,
-    // transaction codes, segments) each with their own sequence counter. Tracking
-    // a single global lastSeqNo produces billions of false "dropped packets".
-    // 
-    // Example: Packet from NIFTY stream (seqNo=7146537) followed by packet from
-    // BANKNIFTY stream (seqNo=1008990) falsely reports 6M+ dropped packets.
-    // 
-    // Proper fix would require tracking per-stream sequences (alphaChar+transCode
-    // combinations), which adds complexity with minimal benefit for application use.
-    // 
-    // For now, gap detection is DISABLED. Market data processing is unaffected.
-    // -------------------------------------------------------
-    #if 0  // Disabled - see explanation above
-    {
-        // BCAST_HEADER layout: reserved1(2)+reserved2(2)+logTime(4)+alphaChar(2)+transCode(2)+errorCode(2)+bcSeqNo(4)
-        // Offset of bcSeqNo = 2+2+4+2+2+2 = 14
-        constexpr size_t BCAST_HEADER_SEQNO_OFFSET = 14;
-        if (message_size >= BCAST_HEADER_SEQNO_OFFSET + sizeof(uint32_t)) {
-            uint32_t currentSeqNo = be32toh_func(
-                *reinterpret_cast<const uint32_t*>(message_data + BCAST_HEADER_SEQNO_OFFSET));
-
-            if (!seqNoInitialized.exchange(true)) {
-                lastSeqNo.store(currentSeqNo);
-            } else {
-                uint32_t expected = lastSeqNo.load() + 1;
-                // Allow wrapping (uint32 overflow)
-                if (currentSeqNo != expected && currentSeqNo != lastSeqNo.load()) {
-                    stats.recordSequenceGap(expected, currentSeqNo);
-                }
-                lastSeqNo.store(currentSeqNo);
-            }
-        }
-    }
-    #endif
+    // Sequence gap detection: NSE interleaves independent streams, each with
+    // its own bcSeqNo, so gaps are tracked per (alphaChar, transactionCode)
+    if (sequence) sequence->observeHeader(message_data);
 
     if (txCode != 7208 and txCode != 17202 and txCode != 7220 and txCode != 7211)
     {
@@ -143,7 +105,7 @@ void parse_compressed_message(const char* data, int16_t length, UDPStats& stats)
     }
     // UPDATE STATISTICS: Track this message by transaction code
     // compressedSize = input length, rawSize = decompressed output size
-    stats.update(txCode, length, output.size(), false);
+    if (stats) stats->update(txCode, length, result, false);
     
     switch (txCode) {
         case TxCodes::BCAST_MBO_MBP_UPDATE:
@@ -186,7 +148,7 @@ void parse_compressed_message(const char* data, int16_t length, UDPStats& stats)
             break;
             
         case TxCodes::BCAST_SPD_MBP_DELTA:
-            if (message_size >= sizeof(MS_SPD_MKT_INFO)) {
+            if (shard::ownsShared() && message_size >= sizeof(MS_SPD_MKT_INFO)) {
                 parse_spd_mbp_delta(reinterpret_cast<const MS_SPD_MKT_INFO*>(message_data));
             }
             break;
@@ -199,14 +161,14 @@ void parse_compressed_message(const char* data, int16_t length, UDPStats& stats)
             
         case TxCodes::BCAST_INDICES:
             // std::cout << "  [Received] " << txCode << " (BCAST_INDICES)" << std::endl;
-            if (message_size >= sizeof(MS_BCAST_INDICES)) {
+            if (shard::ownsShared() && message_size >= sizeof(MS_BCAST_INDICES)) {
                 parse_bcast_indices(reinterpret_cast<const MS_BCAST_INDICES*>(message_data));
             }
             break;
             
         case TxCodes::BCAST_INDUSTRY_INDEX_UPDATE:
             // std::cout << "  [Received] " << txCode << " (BCAST_INDUSTRY_INDEX_UPDATE)" << std::endl;
-            if (message_size >= sizeof(MS_BCAST_INDUSTRY_INDICES)) {
+            if (shard::ownsShared() && message_size >= sizeof(MS_BCAST_INDUSTRY_INDICES)) {
                 parse_bcast_industry_indices(reinterpret_cast<const MS_BCAST_INDUSTRY_INDICES*>(message_data));
             }
             break;
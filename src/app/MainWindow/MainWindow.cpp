@@ -40,7 +40,7 @@ MainWindow::MainWindow(QWidget *parent)
       m_workspaceManager(nullptr), m_xtsMarketDataClient(nullptr),
       m_xtsInteractiveClient(nullptr), m_tradingDataService(nullptr),
       m_configLoader(nullptr), m_indicesDock(nullptr), m_indicesView(nullptr),
-      m_allIndicesWindow(nullptr) {
+      m_allIndicesWindow(nullptr), m_latencyDumpTimer(nullptr) {
   setTitle("Trading Terminal");
   resize(1600, 900);
   setMinimumSize(800, 600);
@@ -313,11 +313,35 @@ void MainWindow::startBroadcastReceiver() {
   if (config.bseCmPort == 0)
     config.bseCmPort = 26001;
 
+  config.batchedIngest = m_configLoader->getUDPBatchedIngest();
+  config.ingestBatchSize = m_configLoader->getUDPIngestBatchSize();
+  config.mainThreadPump = m_configLoader->getUDPMainThreadPump();
+  config.pumpIntervalMs = m_configLoader->getUDPPumpIntervalMs();
+  config.tickRingCapacity = m_configLoader->getUDPTickRingCapacity();
+  config.captureDir = m_configLoader->getUDPCaptureDir().toStdString();
+  config.nseFoParseWorkers = m_configLoader->getUDPNseFoParseWorkers();
+  config.nseFoReceiveCore = m_configLoader->getUDPNseFoReceiveCore();
+  for (int core : m_configLoader->getUDPNseFoParseCores())
+    config.nseFoParseCores.push_back(core);
+  config.interestFilter = m_configLoader->getUDPInterestFilter();
+  config.fullMarketStore = m_configLoader->getUDPFullMarketStore();
+
   // TODO: Add NSE CM methods to ConfigLoader if they don't exist
   // For now we start with what we have
 
   UdpBroadcastService::instance().start(config);
 
+  // Periodic latency dump (receive → model percentiles per segment)
+  if (!m_configLoader->getUDPLatencyDumpDir().isEmpty()) {
+    if (!m_latencyDumpTimer) {
+      m_latencyDumpTimer = new QTimer(this);
+      connect(m_latencyDumpTimer, &QTimer::timeout, this,
+              &MainWindow::dumpLatencyHistograms);
+    }
+    m_latencyDumpTimer->start(
+        qMax(1, m_configLoader->getUDPLatencyDumpIntervalSec()) * 1000);
+  }
+
   if (m_statusBar) {
     m_statusBar->showMessage("Market Data Receivers: INITIALIZING...", 3000);
   }
@@ -325,10 +349,20 @@ void MainWindow::startBroadcastReceiver() {
 
 void MainWindow::stopBroadcastReceiver() {
   UdpBroadcastService::instance().stop();
+  if (m_latencyDumpTimer && m_latencyDumpTimer->isActive()) {
+    m_latencyDumpTimer->stop();
+    dumpLatencyHistograms(); // Last interval
+  }
   if (m_statusBar)
     m_statusBar->showMessage("Market Data Receivers: STOPPED");
 }
 
+void MainWindow::dumpLatencyHistograms() {
+  if (m_configLoader)
+    LatencyTracker::writeDump(m_configLoader->getUDPLatencyDumpDir(),
+                              /*interval=*/true);
+}
+
 #include "views/PreferenceDialog.h"
 
 // ... (existing includes)
@@ -2,6 +2,7 @@
 #include "app/ScripBar.h"
 #include "ui/ConnectionBarWidget.h"
 #include "ui/BroadcastSettingsDialog.h"
+#include "ui/LatencyDiagnosticsDialog.h"
 #include "core/widgets/CustomMDIArea.h"
 #include "core/widgets/CustomMDISubWindow.h" // Needed for window iteration
 #include "core/widgets/InfoBar.h"
@@ -295,6 +296,9 @@ void MainWindow::createMenuBar() {
           &QAction::triggered, this, &MainWindow::startBroadcastReceiver);
   connect(dataMenu->addAction("St&op NSE Broadcast Receiver"),
           &QAction::triggered, this, &MainWindow::stopBroadcastReceiver);
+  dataMenu->addSeparator();
+  connect(dataMenu->addAction("&Latency Diagnostics..."), &QAction::triggered,
+          this, &MainWindow::showLatencyDiagnostics);
 
   // Help Menu
   QMenu *helpMenu = m_menuBar->addMenu("&Help");
@@ -360,6 +364,14 @@ void MainWindow::onConnectionSettingsRequested() {
   dialog->activateWindow();
 }
 
+void MainWindow::showLatencyDiagnostics() {
+  auto *dialog = new LatencyDiagnosticsDialog(this);
+  dialog->setAttribute(Qt::WA_DeleteOnClose);
+  dialog->show();
+  dialog->raise();
+  dialog->activateWindow();
+}
+
 void MainWindow::createStatusBar() {
   m_statusBar = new QStatusBar(this);
   // Light theme style
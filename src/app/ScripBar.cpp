@@ -1078,64 +1078,6 @@ QString ScripBar::getCurrentSegment() const { return m_currentSegment; }
 // RepositoryManager::getExchangeSegmentID() ✅ REMOVED: mapInstrumentToSeries()
 // - now using RepositoryManager::mapInstrumentToSeries()
 
-void ScripBar::searchInstrumentsAsync(const QString &searchText) {
-  if (!m_xtsClient || !m_xtsClient->isLoggedIn()) {
-    qWarning() << "Cannot search: XTS client not available or not logged in";
-    return;
-  }
-
-  int exchangeSegment = RepositoryManager::getExchangeSegmentID(
-      getCurrentExchange(), getCurrentSegment());
-
-  // Connect to instruments received signal
-  connect(
-      m_xtsClient, &XTSMarketDataClient::instrumentsReceived, this,
-      [this](bool success, const QVector<XTS::Instrument> &instruments,
-             const QString &error) {
-        if (success) {
-          // Convert XTS instruments to our InstrumentData format
-          QVector<InstrumentData> data;
-          for (const auto &inst : instruments) {
-            InstrumentData item;
-            item.exchangeInstrumentID = inst.exchangeInstrumentID;
-            item.name = inst.instrumentName;
-            item.symbol = inst.instrumentName;
-            item.series = inst.series;
-            item.exchangeSegment = inst.exchangeSegment;
-            // TODO: Parse instrument type, expiry, strike, option type from
-            // name
-            data.append(item);
-          }
-          onInstrumentsReceived(data);
-        } else {
-          qWarning() << "Instrument search failed:" << error;
-        }
-      },
-      Qt::UniqueConnection);
-
-  // Trigger the actual search
-  m_xtsClient->searchInstruments(searchText, exchangeSegment);
-}
-
-void ScripBar::onInstrumentsReceived(
-    const QVector<InstrumentData> &instruments) {
-  m_instrumentCache = instruments;
-
-  // Extract unique symbols and populate symbol combo
-  QStringList symbols;
-  for (const auto &inst : instruments) {
-    if (!symbols.contains(inst.symbol)) {
-      symbols.append(inst.symbol);
-    }
-  }
-
-  m_symbolCombo->clearItems();
-  m_symbolCombo->addItems(symbols);
-
-  qDebug() << "Received" << instruments.size() << "instruments,"
-           << symbols.size() << "unique symbols";
-}
-
 void ScripBar::populateBseScripCodes() {
   m_bseScripCodeCombo->clearItems();
 
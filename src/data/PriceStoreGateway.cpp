@@ -2,19 +2,26 @@
 #include "nsefo_price_store.h"
 #include "nsecm_price_store.h"
 #include "bse_price_store.h"
-#include <QSet>
-#include <mutex>
+#include "token_interest.h"
 
 namespace MarketData {
 
-// Internal notification filter state
-static QSet<int64_t> g_enabledTokens;
-static std::mutex g_filterMutex;
+namespace {
 
-inline int64_t makeKey(int segment, uint32_t token) {
-    return (static_cast<int64_t>(segment) << 32) | token;
+template <typename Block>
+uint64_t changedIn(int segment, uint64_t since, const std::vector<uint32_t>& tokens,
+                   std::vector<VersionedBlock<Block>>& out) {
+    switch (segment) {
+        case 2:  return nsefo::g_nseFoPriceStore.changedSince(since, tokens.data(), tokens.size(), out);
+        case 1:  return nsecm::g_nseCmPriceStore.changedSince(since, tokens.data(), tokens.size(), out);
+        case 11: return bse::g_bseCmPriceStore.changedSince(since, tokens.data(), tokens.size(), out);
+        case 12: return bse::g_bseFoPriceStore.changedSince(since, tokens.data(), tokens.size(), out);
+        default: return 0;
+    }
 }
 
+} // namespace
+
 PriceStoreGateway& PriceStoreGateway::instance() {
     static PriceStoreGateway instance;
     return instance;
@@ -35,16 +42,6 @@ void PriceStoreGateway::initialize(
     qDebug() << "[PriceStoreGateway] All stores initialized from master lists";
 }
 
-const UnifiedState* PriceStoreGateway::getUnifiedState(int segment, uint32_t token) const {
-    switch (segment) {
-        case 2:  return nsefo::g_nseFoPriceStore.getUnifiedState(token);
-        case 1:  return nsecm::g_nseCmPriceStore.getUnifiedState(token);
-        case 11: return bse::g_bseCmPriceStore.getUnifiedState(token);
-        case 12: return bse::g_bseFoPriceStore.getUnifiedState(token);
-        default: return nullptr;
-    }
-}
-
 UnifiedState PriceStoreGateway::getUnifiedSnapshot(int segment, uint32_t token) const {
     switch (segment) {
         case 2:  return nsefo::g_nseFoPriceStore.getUnifiedSnapshot(token);
@@ -55,19 +52,95 @@ UnifiedState PriceStoreGateway::getUnifiedSnapshot(int segment, uint32_t token)
     }
 }
 
+TouchlineState PriceStoreGateway::getTouchline(int segment, uint32_t token) const {
+    switch (segment) {
+        case 2:  return nsefo::g_nseFoPriceStore.getTouchline(token);
+        case 1:  return nsecm::g_nseCmPriceStore.getTouchline(token);
+        case 11: return bse::g_bseCmPriceStore.getTouchline(token);
+        case 12: return bse::g_bseFoPriceStore.getTouchline(token);
+        default: return TouchlineState{};
+    }
+}
+
+DepthState PriceStoreGateway::getDepth(int segment, uint32_t token) const {
+    switch (segment) {
+        case 2:  return nsefo::g_nseFoPriceStore.getDepth(token);
+        case 1:  return nsecm::g_nseCmPriceStore.getDepth(token);
+        case 11: return bse::g_bseCmPriceStore.getDepth(token);
+        case 12: return bse::g_bseFoPriceStore.getDepth(token);
+        default: return DepthState{};
+    }
+}
+
+GreeksState PriceStoreGateway::getGreeks(int segment, uint32_t token) const {
+    switch (segment) {
+        case 2:  return nsefo::g_nseFoPriceStore.getGreeks(token);
+        case 11: return bse::g_bseCmPriceStore.getGreeks(token);
+        case 12: return bse::g_bseFoPriceStore.getGreeks(token);
+        default: return GreeksState{};
+    }
+}
+
+uint64_t PriceStoreGateway::getVersion(int segment) const {
+    switch (segment) {
+        case 2:  return nsefo::g_nseFoPriceStore.getVersion();
+        case 1:  return nsecm::g_nseCmPriceStore.getVersion();
+        case 11: return bse::g_bseCmPriceStore.getVersion();
+        case 12: return bse::g_bseFoPriceStore.getVersion();
+        default: return 0;
+    }
+}
+
+uint64_t PriceStoreGateway::getRowVersion(int segment, uint32_t token) const {
+    switch (segment) {
+        case 2:  return nsefo::g_nseFoPriceStore.getRowVersion(token);
+        case 1:  return nsecm::g_nseCmPriceStore.getRowVersion(token);
+        case 11: return bse::g_bseCmPriceStore.getRowVersion(token);
+        case 12: return bse::g_bseFoPriceStore.getRowVersion(token);
+        default: return 0;
+    }
+}
+
+uint64_t PriceStoreGateway::changedSince(int segment, uint64_t sinceVersion,
+                                         const std::vector<uint32_t>& tokens,
+                                         std::vector<TouchlineChange>& out) const {
+    return changedIn(segment, sinceVersion, tokens, out);
+}
+
+uint64_t PriceStoreGateway::changedSince(int segment, uint64_t sinceVersion,
+                                         const std::vector<uint32_t>& tokens,
+                                         std::vector<DepthChange>& out) const {
+    return changedIn(segment, sinceVersion, tokens, out);
+}
+
+uint64_t PriceStoreGateway::changedSince(int segment, uint64_t sinceVersion,
+                                         const std::vector<uint32_t>& tokens,
+                                         std::vector<GreeksChange>& out) const {
+    return changedIn(segment, sinceVersion, tokens, out);
+}
+
 void PriceStoreGateway::setTokenEnabled(int segment, uint32_t token, bool enabled) {
-    std::lock_guard<std::mutex> lock(g_filterMutex);
-    int64_t key = makeKey(segment, token);
-    if (enabled) {
-        g_enabledTokens.insert(key);
-    } else {
-        g_enabledTokens.remove(key);
+    if (auto* interest = common::segmentInterest(segment)) {
+        interest->tokens.set(token, enabled);
     }
 }
 
 bool PriceStoreGateway::isTokenEnabled(int segment, uint32_t token) const {
-    std::lock_guard<std::mutex> lock(g_filterMutex);
-    return g_enabledTokens.contains(makeKey(segment, token));
+    // Called per record from the receive threads: one relaxed atomic load
+    const auto* interest = common::segmentInterest(segment);
+    return interest && interest->tokens.test(token);
+}
+
+void PriceStoreGateway::setInterestFilter(bool filterRecords, bool fullMarketStore) {
+    for (int segment : {1, 2, 11, 12}) {
+        auto* interest = common::segmentInterest(segment);
+        interest->fullMarketStore.store(fullMarketStore, std::memory_order_relaxed);
+        interest->filterRecords.store(filterRecords, std::memory_order_relaxed);
+    }
+    qDebug() << "[PriceStoreGateway] Interest filter:"
+             << (filterRecords ? (fullMarketStore ? "callbacks only (full-market store)"
+                                                  : "store + callbacks")
+                               : "off");
 }
 
 } // namespace MarketData
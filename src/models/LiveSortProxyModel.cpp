@@ -0,0 +1,636 @@
+#include "models/qt/LiveSortProxyModel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace {
+
+// Above this many rows at once, inserts/removals on a sorted view reset the
+// proxy instead of being placed one by one
+constexpr int kBulkRows = 64;
+
+// Dirty rows beyond this share of the body are re-sorted in one pass
+constexpr int kFullSortDivisor = 4;
+
+bool isNumericType(int type)
+{
+    switch (type) {
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Double:
+    case QMetaType::Float:
+    case QMetaType::Long:
+    case QMetaType::ULong:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Char:
+    case QMetaType::SChar:
+    case QMetaType::UChar:
+    case QMetaType::Bool:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Missing / non-numeric values sort first in ascending order
+double numericKey(const QVariant &value)
+{
+    bool ok = false;
+    const double key = value.toDouble(&ok);
+    return (ok && !std::isnan(key)) ? key : -std::numeric_limits<double>::infinity();
+}
+
+} // namespace
+
+LiveSortProxyModel::LiveSortProxyModel(QObject *parent)
+    : QAbstractProxyModel(parent)
+{
+    m_reorderTimer.setSingleShot(true);
+    connect(&m_reorderTimer, &QTimer::timeout, this, &LiveSortProxyModel::reorder);
+}
+
+void LiveSortProxyModel::setSourceModel(QAbstractItemModel *model)
+{
+    beginResetModel();
+
+    for (const QMetaObject::Connection &connection : m_sourceConnections) {
+        disconnect(connection);
+    }
+    m_sourceConnections.clear();
+
+    QAbstractProxyModel::setSourceModel(model);
+
+    if (model) {
+        m_sourceConnections
+            << connect(model, &QAbstractItemModel::dataChanged, this,
+                       &LiveSortProxyModel::onSourceDataChanged)
+            << connect(model, &QAbstractItemModel::headerDataChanged, this,
+                       &LiveSortProxyModel::onSourceHeaderDataChanged)
+            << connect(model, &QAbstractItemModel::rowsInserted, this,
+                       &LiveSortProxyModel::onSourceRowsInserted)
+            << connect(model, &QAbstractItemModel::rowsAboutToBeRemoved, this,
+                       &LiveSortProxyModel::onSourceRowsAboutToBeRemoved)
+            << connect(model, &QAbstractItemModel::rowsRemoved, this,
+                       &LiveSortProxyModel::onSourceRowsRemoved)
+            << connect(model, &QAbstractItemModel::columnsAboutToBeInserted, this,
+                       &LiveSortProxyModel::onSourceColumnsAboutToBeInserted)
+            << connect(model, &QAbstractItemModel::columnsInserted, this,
+                       &LiveSortProxyModel::onSourceColumnsInserted)
+            << connect(model, &QAbstractItemModel::columnsAboutToBeRemoved, this,
+                       &LiveSortProxyModel::onSourceColumnsAboutToBeRemoved)
+            << connect(model, &QAbstractItemModel::columnsRemoved, this,
+                       &LiveSortProxyModel::onSourceColumnsRemoved)
+            << connect(model, &QAbstractItemModel::modelAboutToBeReset, this,
+                       &LiveSortProxyModel::onSourceAboutToBeReset)
+            << connect(model, &QAbstractItemModel::modelReset, this,
+                       &LiveSortProxyModel::onSourceReset)
+            << connect(model, &QAbstractItemModel::layoutAboutToBeChanged, this,
+                       &LiveSortProxyModel::onSourceLayoutAboutToBeChanged)
+            << connect(model, &QAbstractItemModel::layoutChanged, this,
+                       &LiveSortProxyModel::onSourceLayoutChanged)
+            // A row move only permutes source rows: same as a layout change
+            << connect(model, &QAbstractItemModel::rowsAboutToBeMoved, this,
+                       &LiveSortProxyModel::onSourceLayoutAboutToBeChanged)
+            << connect(model, &QAbstractItemModel::rowsMoved, this,
+                       &LiveSortProxyModel::onSourceLayoutChanged);
+    }
+
+    rebuildMapping();
+    endResetModel();
+}
+
+void LiveSortProxyModel::setSortRole(int role)
+{
+    if (m_sortRole == role) return;
+    m_sortRole = role;
+    if (isSorted()) sort(m_sortColumn, m_sortOrder);
+}
+
+void LiveSortProxyModel::setReorderInterval(int ms)
+{
+    m_reorderIntervalMs = ms;
+    if (ms < 0) {
+        m_reorderTimer.stop();
+    } else if (!m_dirtyRows.empty()) {
+        m_reorderTimer.stop();
+        scheduleReorder();
+    }
+}
+
+// ─── QAbstractItemModel ──────────────────────────────────
+
+QModelIndex LiveSortProxyModel::index(int row, int column, const QModelIndex &parent) const
+{
+    if (parent.isValid() || row < 0 || row >= rowCount() || column < 0 || column >= columnCount()) {
+        return QModelIndex();
+    }
+    return createIndex(row, column);
+}
+
+QModelIndex LiveSortProxyModel::parent(const QModelIndex &) const
+{
+    return QModelIndex();
+}
+
+int LiveSortProxyModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : static_cast<int>(m_rows.size());
+}
+
+int LiveSortProxyModel::columnCount(const QModelIndex &parent) const
+{
+    if (parent.isValid() || !sourceModel()) return 0;
+    return sourceModel()->columnCount();
+}
+
+bool LiveSortProxyModel::hasChildren(const QModelIndex &parent) const
+{
+    return !parent.isValid() && !m_rows.empty();
+}
+
+QModelIndex LiveSortProxyModel::mapToSource(const QModelIndex &proxyIndex) const
+{
+    if (!proxyIndex.isValid() || !sourceModel() || proxyIndex.model() != this) return QModelIndex();
+    const int row = proxyIndex.row();
+    if (row >= static_cast<int>(m_rows.size())) return QModelIndex();
+    return sourceModel()->index(m_rows[row], proxyIndex.column());
+}
+
+QModelIndex LiveSortProxyModel::mapFromSource(const QModelIndex &sourceIndex) const
+{
+    if (!sourceIndex.isValid() || sourceIndex.model() != sourceModel()) return QModelIndex();
+    const int row = sourceIndex.row();
+    if (row >= static_cast<int>(m_proxyRows.size())) return QModelIndex();
+    return index(m_proxyRows[row], sourceIndex.column());
+}
+
+void LiveSortProxyModel::sort(int column, Qt::SortOrder order)
+{
+    beginLayoutChange(QAbstractItemModel::VerticalSortHint);
+    m_sortColumn = column < 0 ? -1 : column;
+    m_sortOrder = order;
+    rebuildMapping();
+    endLayoutChange(QAbstractItemModel::VerticalSortHint);
+}
+
+LiveSortProxyModel::Pin LiveSortProxyModel::pinOf(int sourceRow) const
+{
+    const QString type = sourceModel()->index(sourceRow, 0).data(Qt::UserRole).toString();
+    if (type == QLatin1String("FILTER_ROW")) return Pin::Top;
+    if (type == QLatin1String("SUMMARY_ROW")) return Pin::Bottom;
+    return Pin::None;
+}
+
+// ─── Re-ordering ─────────────────────────────────────────
+
+void LiveSortProxyModel::reorder()
+{
+    m_reorderTimer.stop();
+    if (m_dirtyRows.empty()) return;
+
+    // Fresh keys of the rows that actually moved; the cached keys stay in
+    // place until the layout change below has started
+    struct Move {
+        int row;
+        double key;
+        QString text;
+    };
+    std::vector<Move> moves;
+    moves.reserve(m_dirtyRows.size());
+    for (int row : m_dirtyRows) {
+        m_dirty[row] = 0;
+        if (!isSorted() || m_pins[row] != Pin::None) continue;
+
+        const QVariant value = sortValue(row);
+        if (m_numericKeys) {
+            const double key = numericKey(value);
+            if (key != m_keys[row]) moves.push_back({row, key, QString()});
+        } else {
+            QString text = value.toString();
+            if (text != m_textKeys[row]) moves.push_back({row, 0.0, std::move(text)});
+        }
+    }
+    m_dirtyRows.clear();
+    if (moves.empty()) return;
+
+    beginLayoutChange(QAbstractItemModel::VerticalSortHint);
+    const int body = bodyEnd() - bodyBegin();
+    if (static_cast<int>(moves.size()) > std::max(kBulkRows, body / kFullSortDivisor)) {
+        for (Move &move : moves) {
+            if (m_numericKeys) m_keys[move.row] = move.key;
+            else m_textKeys[move.row] = std::move(move.text);
+        }
+        sortBody();
+        updateProxyRows(bodyBegin(), bodyEnd() - 1);
+    } else {
+        for (Move &move : moves) {
+            if (m_numericKeys) m_keys[move.row] = move.key;
+            else m_textKeys[move.row] = std::move(move.text);
+            repositionRow(move.row);
+        }
+    }
+    endLayoutChange(QAbstractItemModel::VerticalSortHint);
+}
+
+void LiveSortProxyModel::scheduleReorder()
+{
+    if (m_reorderIntervalMs == 0) {
+        reorder();
+    } else if (m_reorderIntervalMs > 0 && !m_reorderTimer.isActive()) {
+        m_reorderTimer.start(m_reorderIntervalMs);
+    }
+}
+
+void LiveSortProxyModel::repositionRow(int sourceRow)
+{
+    // Every other body row is in order, so the row's new place is found by
+    // binary search on the side it moved to; only the rows in between shift
+    auto begin = m_rows.begin();
+    const int from = m_proxyRows[sourceRow];
+    const auto less = [this](int left, int right) { return rowLess(left, right); };
+
+    if (from > bodyBegin() && rowLess(sourceRow, m_rows[from - 1])) {
+        const int to = static_cast<int>(
+            std::lower_bound(begin + bodyBegin(), begin + from, sourceRow, less) - begin);
+        std::rotate(begin + to, begin + from, begin + from + 1);
+        updateProxyRows(to, from);
+    } else if (from + 1 < bodyEnd() && rowLess(m_rows[from + 1], sourceRow)) {
+        const int to = static_cast<int>(
+            std::lower_bound(begin + from + 1, begin + bodyEnd(), sourceRow, less) - begin);
+        std::rotate(begin + from, begin + from + 1, begin + to);
+        updateProxyRows(from, to - 1);
+    }
+}
+
+bool LiveSortProxyModel::rowLess(int left, int right) const
+{
+    const bool ascending = m_sortOrder == Qt::AscendingOrder;
+    if (m_numericKeys) {
+        const double l = m_keys[left];
+        const double r = m_keys[right];
+        if (l < r) return ascending;
+        if (r < l) return !ascending;
+    } else {
+        const int cmp = QString::compare(m_textKeys[left], m_textKeys[right]);
+        if (cmp != 0) return ascending ? cmp < 0 : cmp > 0;
+    }
+    return left < right;
+}
+
+// ─── Mapping ─────────────────────────────────────────────
+
+QVariant LiveSortProxyModel::sortValue(int sourceRow) const
+{
+    return sourceModel()->index(sourceRow, m_sortColumn).data(m_sortRole);
+}
+
+void LiveSortProxyModel::detectKeyType()
+{
+    // The first value present decides for the whole column
+    m_numericKeys = true;
+    m_keyTypeKnown = false;
+    const int rows = static_cast<int>(m_pins.size());
+    for (int row = 0; row < rows; ++row) {
+        if (m_pins[row] != Pin::None) continue;
+        const QVariant value = sortValue(row);
+        if (!value.isValid()) continue;
+        m_numericKeys = isNumericType(value.userType());
+        m_keyTypeKnown = true;
+        return;
+    }
+}
+
+void LiveSortProxyModel::loadKey(int sourceRow)
+{
+    const QVariant value = sortValue(sourceRow);
+    if (m_numericKeys) m_keys[sourceRow] = numericKey(value);
+    else m_textKeys[sourceRow] = value.toString();
+}
+
+void LiveSortProxyModel::rebuildMapping()
+{
+    const int rows = sourceModel() ? sourceModel()->rowCount() : 0;
+    if (isSorted() && m_sortColumn >= columnCount()) m_sortColumn = -1;
+
+    m_rows.resize(rows);
+    m_proxyRows.resize(rows);
+    m_pins.assign(rows, Pin::None);
+    m_keys.assign(rows, 0.0);
+    m_textKeys.assign(rows, QString());
+    m_dirty.assign(rows, 0);
+    m_dirtyRows.clear();
+    m_reorderTimer.stop();
+    m_topCount = m_bottomCount = 0;
+
+    if (!isSorted()) {
+        std::iota(m_rows.begin(), m_rows.end(), 0);
+        updateProxyRows(0, rows - 1);
+        return;
+    }
+
+    for (int row = 0; row < rows; ++row) m_pins[row] = pinOf(row);
+    detectKeyType();
+
+    // Pinned rows keep source order at either end, the body is sorted
+    std::vector<int> bottom;
+    int next = 0;
+    for (int row = 0; row < rows; ++row) {
+        if (m_pins[row] == Pin::Top) m_rows[next++] = row;
+    }
+    m_topCount = next;
+    for (int row = 0; row < rows; ++row) {
+        if (m_pins[row] == Pin::None) {
+            loadKey(row);
+            m_rows[next++] = row;
+        } else if (m_pins[row] == Pin::Bottom) {
+            bottom.push_back(row);
+        }
+    }
+    std::copy(bottom.begin(), bottom.end(), m_rows.begin() + next);
+    m_bottomCount = static_cast<int>(bottom.size());
+
+    sortBody();
+    updateProxyRows(0, rows - 1);
+}
+
+void LiveSortProxyModel::sortBody()
+{
+    std::sort(m_rows.begin() + bodyBegin(), m_rows.begin() + bodyEnd(),
+              [this](int left, int right) { return rowLess(left, right); });
+}
+
+void LiveSortProxyModel::updateProxyRows(int from, int to)
+{
+    for (int proxyRow = from; proxyRow <= to; ++proxyRow) {
+        m_proxyRows[m_rows[proxyRow]] = proxyRow;
+    }
+}
+
+int LiveSortProxyModel::insertPosition(int sourceRow) const
+{
+    const auto begin = m_rows.begin();
+    switch (m_pins[sourceRow]) {
+    case Pin::Top:
+        return static_cast<int>(std::lower_bound(begin, begin + bodyBegin(), sourceRow) - begin);
+    case Pin::Bottom:
+        return static_cast<int>(
+            std::lower_bound(begin + bodyEnd(), m_rows.end(), sourceRow) - begin);
+    case Pin::None:
+        break;
+    }
+    return static_cast<int>(
+        std::lower_bound(begin + bodyBegin(), begin + bodyEnd(), sourceRow,
+                         [this](int left, int right) { return rowLess(left, right); }) -
+        begin);
+}
+
+void LiveSortProxyModel::beginLayoutChange(QAbstractItemModel::LayoutChangeHint hint)
+{
+    emit layoutAboutToBeChanged(QList<QPersistentModelIndex>(), hint);
+
+    // Source persistent indexes follow source-side moves by themselves
+    m_layoutProxyIndexes = persistentIndexList();
+    m_layoutSourceIndexes.clear();
+    m_layoutSourceIndexes.reserve(m_layoutProxyIndexes.size());
+    for (const QModelIndex &proxyIndex : m_layoutProxyIndexes) {
+        m_layoutSourceIndexes.append(QPersistentModelIndex(mapToSource(proxyIndex)));
+    }
+}
+
+void LiveSortProxyModel::endLayoutChange(QAbstractItemModel::LayoutChangeHint hint)
+{
+    QModelIndexList to;
+    to.reserve(m_layoutSourceIndexes.size());
+    for (const QPersistentModelIndex &sourceIndex : m_layoutSourceIndexes) {
+        to.append(mapFromSource(sourceIndex));
+    }
+    changePersistentIndexList(m_layoutProxyIndexes, to);
+    m_layoutProxyIndexes.clear();
+    m_layoutSourceIndexes.clear();
+
+    emit layoutChanged(QList<QPersistentModelIndex>(), hint);
+}
+
+// ─── Source signals ──────────────────────────────────────
+
+void LiveSortProxyModel::onSourceDataChanged(const QModelIndex &topLeft,
+                                             const QModelIndex &bottomRight,
+                                             const QVector<int> &roles)
+{
+    if (!topLeft.isValid() || topLeft.parent().isValid()) return;
+    const int firstRow = topLeft.row();
+    const int lastRow = bottomRight.row();
+    const int firstColumn = topLeft.column();
+    const int lastColumn = bottomRight.column();
+
+    // Repaint in place now, in runs of adjacent proxy rows
+    if (!isSorted()) {
+        emit dataChanged(index(firstRow, firstColumn), index(lastRow, lastColumn), roles);
+    } else if (firstRow == lastRow) {
+        const int proxyRow = m_proxyRows[firstRow];
+        emit dataChanged(index(proxyRow, firstColumn), index(proxyRow, lastColumn), roles);
+    } else {
+        std::vector<int> proxyRows;
+        proxyRows.reserve(lastRow - firstRow + 1);
+        for (int row = firstRow; row <= lastRow; ++row) proxyRows.push_back(m_proxyRows[row]);
+        std::sort(proxyRows.begin(), proxyRows.end());
+        size_t runStart = 0;
+        for (size_t i = 1; i <= proxyRows.size(); ++i) {
+            if (i < proxyRows.size() && proxyRows[i] == proxyRows[i - 1] + 1) continue;
+            emit dataChanged(index(proxyRows[runStart], firstColumn),
+                             index(proxyRows[i - 1], lastColumn), roles);
+            runStart = i;
+        }
+    }
+
+    // Re-order later if the sort key may have moved
+    if (!isSorted() || m_sortColumn < firstColumn || m_sortColumn > lastColumn) return;
+    if (!roles.isEmpty() && !roles.contains(m_sortRole)) return;
+
+    bool dirtied = false;
+    for (int row = firstRow; row <= lastRow; ++row) {
+        if (m_dirty[row] || m_pins[row] != Pin::None) continue;
+        m_dirty[row] = 1;
+        m_dirtyRows.push_back(row);
+        dirtied = true;
+    }
+    if (dirtied) scheduleReorder();
+}
+
+void LiveSortProxyModel::onSourceHeaderDataChanged(Qt::Orientation orientation, int first,
+                                                   int last)
+{
+    if (orientation == Qt::Horizontal) {
+        emit headerDataChanged(orientation, first, last);
+    } else if (!m_rows.empty()) {
+        emit headerDataChanged(orientation, 0, rowCount() - 1);
+    }
+}
+
+void LiveSortProxyModel::onSourceRowsInserted(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) return;
+    const int count = last - first + 1;
+
+    // A sorted view places rows one by one; past a bulk size (or while the
+    // column type is still unknown) a reset is cheaper
+    if (isSorted() && (count > kBulkRows || !m_keyTypeKnown)) {
+        beginResetModel();
+        rebuildMapping();
+        endResetModel();
+        return;
+    }
+
+    // Shift source rows at/after first; existing proxy rows keep their place
+    for (int &row : m_rows) {
+        if (row >= first) row += count;
+    }
+    for (int &row : m_dirtyRows) {
+        if (row >= first) row += count;
+    }
+    m_proxyRows.insert(m_proxyRows.begin() + first, count, 0);
+    m_pins.insert(m_pins.begin() + first, count, Pin::None);
+    m_keys.insert(m_keys.begin() + first, count, 0.0);
+    m_textKeys.insert(m_textKeys.begin() + first, count, QString());
+    m_dirty.insert(m_dirty.begin() + first, count, 0);
+
+    if (!isSorted()) {
+        beginInsertRows(QModelIndex(), first, last);
+        std::vector<int> inserted(count);
+        std::iota(inserted.begin(), inserted.end(), first);
+        m_rows.insert(m_rows.begin() + first, inserted.begin(), inserted.end());
+        updateProxyRows(first, static_cast<int>(m_rows.size()) - 1);
+        endInsertRows();
+        return;
+    }
+
+    for (int row = first; row <= last; ++row) {
+        m_pins[row] = pinOf(row);
+        if (m_pins[row] == Pin::None) loadKey(row);
+        const int proxyRow = insertPosition(row);
+
+        beginInsertRows(QModelIndex(), proxyRow, proxyRow);
+        m_rows.insert(m_rows.begin() + proxyRow, row);
+        if (m_pins[row] == Pin::Top) ++m_topCount;
+        else if (m_pins[row] == Pin::Bottom) ++m_bottomCount;
+        updateProxyRows(proxyRow, static_cast<int>(m_rows.size()) - 1);
+        endInsertRows();
+    }
+}
+
+void LiveSortProxyModel::onSourceRowsAboutToBeRemoved(const QModelIndex &parent, int first,
+                                                      int last)
+{
+    if (parent.isValid()) return;
+
+    if (!isSorted()) {
+        beginRemoveRows(QModelIndex(), first, last);
+        return;
+    }
+    if (last - first + 1 > kBulkRows) {
+        m_resetting = true;
+        beginResetModel();
+        return;
+    }
+
+    // Scattered proxy rows: remove them bottom-up while the source rows still
+    // exist, the source renumbering follows in onSourceRowsRemoved
+    std::vector<int> proxyRows;
+    for (int row = first; row <= last; ++row) proxyRows.push_back(m_proxyRows[row]);
+    std::sort(proxyRows.begin(), proxyRows.end(), std::greater<int>());
+    for (int proxyRow : proxyRows) {
+        beginRemoveRows(QModelIndex(), proxyRow, proxyRow);
+        if (proxyRow < m_topCount) --m_topCount;
+        else if (proxyRow >= bodyEnd()) --m_bottomCount;
+        m_rows.erase(m_rows.begin() + proxyRow);
+        updateProxyRows(proxyRow, static_cast<int>(m_rows.size()) - 1);
+        endRemoveRows();
+    }
+}
+
+void LiveSortProxyModel::onSourceRowsRemoved(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) return;
+    if (m_resetting) {
+        m_resetting = false;
+        rebuildMapping();
+        endResetModel();
+        return;
+    }
+
+    const int count = last - first + 1;
+    if (!isSorted()) m_rows.erase(m_rows.begin() + first, m_rows.begin() + last + 1);
+    for (int &row : m_rows) {
+        if (row > last) row -= count;
+    }
+
+    m_dirtyRows.erase(std::remove_if(m_dirtyRows.begin(), m_dirtyRows.end(),
+                                     [first, last](int row) { return row >= first && row <= last; }),
+                      m_dirtyRows.end());
+    for (int &row : m_dirtyRows) {
+        if (row > last) row -= count;
+    }
+    m_proxyRows.erase(m_proxyRows.begin() + first, m_proxyRows.begin() + last + 1);
+    m_pins.erase(m_pins.begin() + first, m_pins.begin() + last + 1);
+    m_keys.erase(m_keys.begin() + first, m_keys.begin() + last + 1);
+    m_textKeys.erase(m_textKeys.begin() + first, m_textKeys.begin() + last + 1);
+    m_dirty.erase(m_dirty.begin() + first, m_dirty.begin() + last + 1);
+    updateProxyRows(0, static_cast<int>(m_rows.size()) - 1);
+
+    if (!isSorted()) endRemoveRows();
+}
+
+void LiveSortProxyModel::onSourceColumnsAboutToBeInserted(const QModelIndex &parent, int first,
+                                                          int last)
+{
+    if (!parent.isValid()) beginInsertColumns(QModelIndex(), first, last);
+}
+
+void LiveSortProxyModel::onSourceColumnsInserted(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) return;
+    if (isSorted() && m_sortColumn >= first) m_sortColumn += last - first + 1;
+    endInsertColumns();
+}
+
+void LiveSortProxyModel::onSourceColumnsAboutToBeRemoved(const QModelIndex &parent, int first,
+                                                         int last)
+{
+    if (parent.isValid()) return;
+    // Losing the sort column drops back to source order first
+    if (isSorted() && m_sortColumn >= first && m_sortColumn <= last) sort(-1, m_sortOrder);
+    beginRemoveColumns(QModelIndex(), first, last);
+}
+
+void LiveSortProxyModel::onSourceColumnsRemoved(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) return;
+    if (isSorted() && m_sortColumn > last) m_sortColumn -= last - first + 1;
+    endRemoveColumns();
+}
+
+void LiveSortProxyModel::onSourceAboutToBeReset()
+{
+    beginResetModel();
+}
+
+void LiveSortProxyModel::onSourceReset()
+{
+    rebuildMapping();
+    endResetModel();
+}
+
+void LiveSortProxyModel::onSourceLayoutAboutToBeChanged()
+{
+    beginLayoutChange(QAbstractItemModel::NoLayoutChangeHint);
+}
+
+void LiveSortProxyModel::onSourceLayoutChanged()
+{
+    rebuildMapping();
+    endLayoutChange(QAbstractItemModel::NoLayoutChangeHint);
+}
@@ -4,8 +4,11 @@
 #include "utils/LatencyTracker.h"
 #include <QColor>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QFont>
 #include <QSize>
+#include <QVarLengthArray>
+#include <algorithm>
 
 
 MarketWatchModel::MarketWatchModel(QObject *parent)
@@ -18,6 +21,11 @@ MarketWatchModel::MarketWatchModel(QObject *parent)
   m_flashResetTimer.setInterval(350);
   connect(&m_flashResetTimer, &QTimer::timeout, this, &MarketWatchModel::onFlashResetTimeout);
 
+  // Frame coalescing timer: armed by the first dirty cell after a flush
+  m_coalesceTimer.setSingleShot(true);
+  m_coalesceTimer.setTimerType(Qt::PreciseTimer);
+  connect(&m_coalesceTimer, &QTimer::timeout, this, &MarketWatchModel::flushPendingUpdates);
+
   // Connect to Greeks service for live updates
   auto &greeksService = GreeksCalculationService::instance();
   connect(
@@ -37,7 +45,7 @@ MarketWatchModel::MarketWatchModel(QObject *parent)
 }
 
 int MarketWatchModel::rowCount(const QModelIndex &parent) const {
-  return parent.isValid() ? 0 : m_scrips.count();
+  return parent.isValid() ? 0 : m_rows.size();
 }
 
 int MarketWatchModel::columnCount(const QModelIndex &parent) const {
@@ -45,15 +53,15 @@ int MarketWatchModel::columnCount(const QModelIndex &parent) const {
 }
 
 QVariant MarketWatchModel::data(const QModelIndex &index, int role) const {
-  if (!index.isValid() || index.row() >= m_scrips.count())
+  if (!index.isValid() || index.row() >= m_rows.size())
     return QVariant();
 
-  const ScripData &scrip = m_scrips.at(index.row());
+  const int row = index.row();
 
   // Blank rows: just empty data rows (no special visual styling)
   // They have isBlankRow=true and token=-1, so they won't be subscribed/updated,
   // but visually they look identical to regular rows (just show empty cells).
-  if (scrip.isBlankRow) {
+  if (m_rows.isBlankRow[row]) {
     if (role == Qt::DisplayRole) {
       return QString(); // Empty text for all columns
     }
@@ -71,7 +79,7 @@ QVariant MarketWatchModel::data(const QModelIndex &index, int role) const {
 
   // Display role - show formatted data
   if (role == Qt::DisplayRole) {
-    return formatColumnData(scrip, column);
+    return formatColumnData(row, column);
   }
 
   // Text alignment
@@ -82,17 +90,17 @@ QVariant MarketWatchModel::data(const QModelIndex &index, int role) const {
 
   // User role - return raw data for sorting
   else if (role == Qt::UserRole) {
-    return getColumnData(scrip, column);
+    return getColumnData(row, column);
   }
 
   // User role + 1 - return token for lookups
   else if (role == Qt::UserRole + 1) {
-    return (qlonglong)scrip.token;
+    return (qlonglong)m_rows.token[row];
   }
 
   // User role + 2 - return exchange
   else if (role == Qt::UserRole + 2) {
-    return scrip.exchange;
+    return m_rows.text(m_rows.exchange[row]);
   }
 
   // Background coloring for value changes (Ticks) — auto-resets after 300ms
@@ -103,14 +111,14 @@ QVariant MarketWatchModel::data(const QModelIndex &index, int role) const {
       int tick = 0;
       qint64 tickTime = 0;
       if (column == MarketWatchColumn::LAST_TRADED_PRICE) {
-        tick = scrip.ltpTick;
-        tickTime = scrip.ltpTickTime;
+        tick = m_rows.ltpTick[row];
+        tickTime = m_rows.ltpTickTime[row];
       } else if (column == MarketWatchColumn::BUY_PRICE) {
-        tick = scrip.bidTick;
-        tickTime = scrip.bidTickTime;
+        tick = m_rows.bidTick[row];
+        tickTime = m_rows.bidTickTime[row];
       } else if (column == MarketWatchColumn::SELL_PRICE) {
-        tick = scrip.askTick;
-        tickTime = scrip.askTickTime;
+        tick = m_rows.askTick[row];
+        tickTime = m_rows.askTickTime[row];
       }
 
       // Only show flash if within 300ms of the tick
@@ -131,8 +139,8 @@ QVariant MarketWatchModel::data(const QModelIndex &index, int role) const {
     if (column == MarketWatchColumn::NET_CHANGE_RS ||
         column == MarketWatchColumn::PERCENT_CHANGE) {
       double val = (column == MarketWatchColumn::NET_CHANGE_RS)
-                       ? scrip.change
-                       : scrip.changePercent;
+                       ? m_rows.change[row]
+                       : m_rows.changePercent[row];
       if (val > 0)
         return QColor("#16a34a"); // Green for positive
       if (val < 0)
@@ -140,9 +148,9 @@ QVariant MarketWatchModel::data(const QModelIndex &index, int role) const {
     }
     // LTP text color follows change direction
     else if (column == MarketWatchColumn::LAST_TRADED_PRICE) {
-      if (scrip.change > 0)
+      if (m_rows.change[row] > 0)
         return QColor("#16a34a"); // Green
-      if (scrip.change < 0)
+      if (m_rows.change[row] < 0)
         return QColor("#dc2626"); // Red
     }
   }
@@ -186,9 +194,9 @@ void MarketWatchModel::addScrip(const ScripData &scrip) {
     }
   }
 
-  int row = m_scrips.count();
+  int row = m_rows.size();
   beginInsertRows(QModelIndex(), row, row);
-  m_scrips.append(scrip);
+  m_rows.append(scrip);
   endInsertRows();
 
   // Maintain token→row map
@@ -222,11 +230,13 @@ void MarketWatchModel::addScrips(const QList<ScripData> &scrips) {
   if (toAdd.isEmpty())
     return;
 
-  int firstRow = m_scrips.count();
+  int firstRow = m_rows.size();
   int lastRow = firstRow + toAdd.count() - 1;
 
   beginInsertRows(QModelIndex(), firstRow, lastRow);
-  m_scrips.append(toAdd);
+  m_rows.reserve(lastRow + 1);
+  for (const ScripData &scrip : toAdd)
+    m_rows.append(scrip);
   endInsertRows();
 
   for (int i = 0; i < toAdd.count(); ++i) {
@@ -243,9 +253,9 @@ void MarketWatchModel::addScrips(const QList<ScripData> &scrips) {
 void MarketWatchModel::insertScrip(int position, const ScripData &scrip) {
   // Reject duplicates: same exchange + token already exists (blank rows exempt)
   if (!scrip.isBlankRow && scrip.token > 0) {
-    for (const ScripData &existing : m_scrips) {
-      if (!existing.isBlankRow && existing.token == scrip.token &&
-          existing.exchange == scrip.exchange) {
+    for (int i = 0; i < m_rows.size(); ++i) {
+      if (!m_rows.isBlankRow[i] && m_rows.token[i] == scrip.token &&
+          m_rows.text(m_rows.exchange[i]) == scrip.exchange) {
         qDebug() << "[MarketWatchModel] Skipping duplicate scrip (insert):"
                  << scrip.symbol << "Exchange:" << scrip.exchange
                  << "Token:" << scrip.token;
@@ -257,19 +267,16 @@ void MarketWatchModel::insertScrip(int position, const ScripData &scrip) {
   // Validate position
   if (position < 0)
     position = 0;
-  if (position > m_scrips.count())
-    position = m_scrips.count();
+  if (position > m_rows.size())
+    position = m_rows.size();
 
+  flushPendingUpdates(); // Rows at/after position are about to shift
   beginInsertRows(QModelIndex(), position, position);
-  m_scrips.insert(position, scrip);
+  m_rows.insert(position, scrip);
   endInsertRows();
 
   // Re-index token→row map for all rows from position onwards
-  for (int i = position; i < m_scrips.count(); ++i) {
-    if (!m_scrips[i].isBlankRow && m_scrips[i].token > 0) {
-      m_tokenToRow[m_scrips[i].token] = i;
-    }
-  }
+  reindexTokens(position, m_rows.size() - 1);
 
   emit scripAdded(position, scrip);
 
@@ -278,27 +285,25 @@ void MarketWatchModel::insertScrip(int position, const ScripData &scrip) {
 }
 
 void MarketWatchModel::removeScrip(int row) {
-  if (row >= 0 && row < m_scrips.count()) {
+  if (row >= 0 && row < m_rows.size()) {
+    flushPendingUpdates(); // Rows after row are about to shift
     beginRemoveRows(QModelIndex(), row, row);
 
-    const ScripData &scrip = m_scrips.at(row);
-    qDebug() << "[MarketWatchModel] Removing scrip:" << scrip.symbol
-             << "Token:" << scrip.token << "from row" << row;
+    const int token = m_rows.token[row];
+    qDebug() << "[MarketWatchModel] Removing scrip:"
+             << m_rows.text(m_rows.symbol[row]) << "Token:" << token
+             << "from row" << row;
 
     // Remove from token→row map
-    if (!scrip.isBlankRow && scrip.token > 0) {
-      m_tokenToRow.remove(scrip.token);
+    if (!m_rows.isBlankRow[row] && token > 0) {
+      m_tokenToRow.remove(token);
     }
 
-    m_scrips.removeAt(row);
+    m_rows.remove(row);
     endRemoveRows();
 
     // Re-index all rows after the removed row
-    for (int i = row; i < m_scrips.count(); ++i) {
-      if (!m_scrips[i].isBlankRow && m_scrips[i].token > 0) {
-        m_tokenToRow[m_scrips[i].token] = i;
-      }
-    }
+    reindexTokens(row, m_rows.size() - 1);
 
     // Keep flash tracking in sync: remove this row, shift higher rows down
     m_flashingRows.remove(row);
@@ -314,13 +319,15 @@ void MarketWatchModel::removeScrip(int row) {
 }
 
 void MarketWatchModel::moveRow(int sourceRow, int targetRow) {
-  if (sourceRow < 0 || sourceRow >= m_scrips.count())
+  if (sourceRow < 0 || sourceRow >= m_rows.size())
     return;
-  if (targetRow < 0 || targetRow > m_scrips.count())
+  if (targetRow < 0 || targetRow > m_rows.size())
     return;
   if (sourceRow == targetRow)
     return;
 
+  flushPendingUpdates();
+
   // Qt's moveRows expects destination to be the position AFTER the move
   // If moving down, targetRow is already correct
   // If moving up, targetRow should be the position before the item
@@ -338,33 +345,27 @@ void MarketWatchModel::moveRow(int sourceRow, int targetRow) {
   }
 
   // Perform the actual move
-  ScripData scrip = m_scrips.takeAt(sourceRow);
   int insertPos = targetRow;
   if (sourceRow < targetRow) {
     insertPos = targetRow - 1;
   }
-  m_scrips.insert(insertPos, scrip);
+  m_rows.move(sourceRow, insertPos);
 
   endMoveRows();
 
   // Re-index affected range in token→row map
-  int lo = std::min(sourceRow, insertPos);
-  int hi = std::max(sourceRow, insertPos);
-  for (int i = lo; i <= hi; ++i) {
-    if (!m_scrips[i].isBlankRow && m_scrips[i].token > 0) {
-      m_tokenToRow[m_scrips[i].token] = i;
-    }
-  }
+  reindexTokens(std::min(sourceRow, insertPos), std::max(sourceRow, insertPos));
 
   qDebug() << "[MarketWatchModel] Moved row from" << sourceRow << "to"
            << insertPos;
 }
 
 void MarketWatchModel::clearAll() {
+  discardPendingUpdates();
   m_flashResetTimer.stop();
   m_flashingRows.clear();
   beginResetModel();
-  m_scrips.clear();
+  m_rows.clear();
   m_tokenToRow.clear();
   endResetModel();
 
@@ -372,8 +373,8 @@ void MarketWatchModel::clearAll() {
 }
 
 int MarketWatchModel::findScrip(const QString &symbol) const {
-  for (int i = 0; i < m_scrips.count(); ++i) {
-    if (m_scrips.at(i).symbol == symbol && !m_scrips.at(i).isBlankRow)
+  for (int i = 0; i < m_rows.size(); ++i) {
+    if (!m_rows.isBlankRow[i] && m_rows.text(m_rows.symbol[i]) == symbol)
       return i;
   }
   return -1;
@@ -387,84 +388,79 @@ int MarketWatchModel::findScripByToken(int token) const {
   if (it != m_tokenToRow.end()) {
     int row = it.value();
     // Validate the cached row is still correct
-    if (row >= 0 && row < m_scrips.count() && m_scrips.at(row).token == token &&
-        !m_scrips.at(row).isBlankRow) {
+    if (row >= 0 && row < m_rows.size() && m_rows.token[row] == token &&
+        !m_rows.isBlankRow[row]) {
       return row;
     }
   }
 
   // Fallback: linear scan (should not normally happen)
-  for (int i = 0; i < m_scrips.count(); ++i) {
-    if (m_scrips.at(i).token == token && !m_scrips.at(i).isBlankRow)
+  for (int i = 0; i < m_rows.size(); ++i) {
+    if (m_rows.token[i] == token && !m_rows.isBlankRow[i])
       return i;
   }
   return -1;
 }
 
 void MarketWatchModel::insertBlankRow(int position) {
-  if (position < 0 || position > m_scrips.count()) {
-    position = m_scrips.count(); // Append at end
+  if (position < 0 || position > m_rows.size()) {
+    position = m_rows.size(); // Append at end
   }
 
+  flushPendingUpdates();
+
   beginInsertRows(QModelIndex(), position, position);
-  m_scrips.insert(position, ScripData::createBlankRow());
+  m_rows.insert(position, ScripData::createBlankRow());
   endInsertRows();
 
   // Re-index rows after the inserted blank row
-  for (int i = position + 1; i < m_scrips.count(); ++i) {
-    if (!m_scrips[i].isBlankRow && m_scrips[i].token > 0) {
-      m_tokenToRow[m_scrips[i].token] = i;
-    }
-  }
+  reindexTokens(position + 1, m_rows.size() - 1);
 
   qDebug() << "[MarketWatchModel] Inserted blank row at position" << position;
 }
 
 bool MarketWatchModel::isBlankRow(int row) const {
-  if (row >= 0 && row < m_scrips.count()) {
-    return m_scrips.at(row).isBlankRow;
+  if (row >= 0 && row < m_rows.size()) {
+    return m_rows.isBlankRow[row] != 0;
   }
   return false;
 }
 
-const ScripData &MarketWatchModel::getScripAt(int row) const {
-  static const ScripData emptyData;
-  if (row >= 0 && row < m_scrips.count()) {
-    return m_scrips.at(row);
-  }
-  return emptyData;
+bool MarketWatchModel::isLiveRow(int row) const {
+  return row >= 0 && row < m_rows.size() && !m_rows.isBlankRow[row];
 }
 
-ScripData &MarketWatchModel::getScripAt(int row) {
-  if (row >= 0 && row < m_scrips.count()) {
-    return m_scrips[row];
+void MarketWatchModel::reindexTokens(int firstRow, int lastRow) {
+  for (int i = std::max(0, firstRow); i <= lastRow && i < m_rows.size(); ++i) {
+    if (!m_rows.isBlankRow[i] && m_rows.token[i] > 0) {
+      m_tokenToRow[m_rows.token[i]] = i;
+    }
   }
-  // Reset static to default before returning — prevents stale data if a
-  // previous caller accidentally mutated it
-  static ScripData emptyData;
-  emptyData = ScripData{};
-  return emptyData;
+}
+
+ScripData MarketWatchModel::getScripAt(int row) const {
+  return m_rows.at(row); // Default ScripData when out of range
 }
 
 void MarketWatchModel::updatePrice(int row, double ltp, double change,
                                    double changePercent) {
-  if (row >= 0 && row < m_scrips.count() && !m_scrips.at(row).isBlankRow) {
-    ScripData &scrip = m_scrips[row];
+  if (isLiveRow(row)) {
+    const double prevLtp = m_rows.ltp[row];
 
     // Determine tick direction for LTP
-    if (ltp > scrip.ltp && scrip.ltp > 0) {
-      scrip.ltpTick = 1;
-      scrip.ltpTickTime = QDateTime::currentMSecsSinceEpoch();
+    if (ltp > prevLtp && prevLtp > 0) {
+      m_rows.ltpTick[row] = 1;
+      m_rows.ltpTickTime[row] = QDateTime::currentMSecsSinceEpoch();
       scheduleFlashReset(row);
-    } else if (ltp < scrip.ltp && scrip.ltp > 0) {
-      scrip.ltpTick = -1;
-      scrip.ltpTickTime = QDateTime::currentMSecsSinceEpoch();
+    } else if (ltp < prevLtp && prevLtp > 0) {
+      m_rows.ltpTick[row] = -1;
+      m_rows.ltpTickTime[row] = QDateTime::currentMSecsSinceEpoch();
       scheduleFlashReset(row);
     }
 
-    scrip.ltp = ltp;
-    scrip.change = change;
-    scrip.changePercent = changePercent;
+    m_rows.ltp[row] = ltp;
+    m_rows.change[row] = change;
+    m_rows.changePercent[row] = changePercent;
 
     notifyColumnsUpdated(row, {MarketWatchColumn::LAST_TRADED_PRICE,
                                MarketWatchColumn::NET_CHANGE_RS,
@@ -473,43 +469,43 @@ void MarketWatchModel::updatePrice(int row, double ltp, double change,
 }
 
 void MarketWatchModel::updateVolume(int row, qint64 volume) {
-  if (row >= 0 && row < m_scrips.count() && !m_scrips.at(row).isBlankRow) {
-    m_scrips[row].volume = volume;
+  if (isLiveRow(row)) {
+    m_rows.volume[row] = volume;
     notifyColumnsUpdated(row, {MarketWatchColumn::VOLUME});
   }
 }
 
 void MarketWatchModel::updateBidAsk(int row, double bid, double ask) {
-  if (row >= 0 && row < m_scrips.count() && !m_scrips.at(row).isBlankRow) {
-    ScripData &scrip = m_scrips[row];
+  if (isLiveRow(row)) {
+    const double prevBid = m_rows.bid[row];
+    const double prevAsk = m_rows.ask[row];
     qint64 now = QDateTime::currentMSecsSinceEpoch();
 
     // Determine tick direction for Bid
-    if (bid > scrip.bid && scrip.bid > 0) {
-      scrip.bidTick = 1;
-      scrip.bidTickTime = now;
+    if (bid > prevBid && prevBid > 0) {
+      m_rows.bidTick[row] = 1;
+      m_rows.bidTickTime[row] = now;
       scheduleFlashReset(row);
-    } else if (bid < scrip.bid && scrip.bid > 0) {
-      scrip.bidTick = -1;
-      scrip.bidTickTime = now;
+    } else if (bid < prevBid && prevBid > 0) {
+      m_rows.bidTick[row] = -1;
+      m_rows.bidTickTime[row] = now;
       scheduleFlashReset(row);
     }
 
     // Determine tick direction for Ask
-    if (ask > scrip.ask && scrip.ask > 0) {
-      scrip.askTick = 1;
-      scrip.askTickTime = now;
+    if (ask > prevAsk && prevAsk > 0) {
+      m_rows.askTick[row] = 1;
+      m_rows.askTickTime[row] = now;
       scheduleFlashReset(row);
-    } else if (ask < scrip.ask && scrip.ask > 0) {
-      scrip.askTick = -1;
-      scrip.askTickTime = now;
+    } else if (ask < prevAsk && prevAsk > 0) {
+      m_rows.askTick[row] = -1;
+      m_rows.askTickTime[row] = now;
       scheduleFlashReset(row);
     }
 
-    scrip.bid = bid;
-    scrip.ask = ask;
-    scrip.buyPrice = bid;  // Buy Price = Bid
-    scrip.sellPrice = ask; // Sell Price = Ask
+    // One column each: Buy Price = Bid, Sell Price = Ask
+    m_rows.bid[row] = bid;
+    m_rows.ask[row] = ask;
 
     notifyColumnsUpdated(row, {MarketWatchColumn::BUY_PRICE,
                                MarketWatchColumn::SELL_PRICE});
@@ -517,42 +513,41 @@ void MarketWatchModel::updateBidAsk(int row, double bid, double ask) {
 }
 
 void MarketWatchModel::updateLastTradedQuantity(int row, qint64 ltq) {
-  if (row >= 0 && row < m_scrips.count() && !m_scrips.at(row).isBlankRow) {
-    m_scrips[row].ltq = ltq;
+  if (isLiveRow(row)) {
+    m_rows.ltq[row] = ltq;
     notifyColumnsUpdated(row, {MarketWatchColumn::LAST_TRADED_QUANTITY});
   }
 }
 
 void MarketWatchModel::updateHighLow(int row, double high, double low) {
-  if (row >= 0 && row < m_scrips.count() && !m_scrips.at(row).isBlankRow) {
-    m_scrips[row].high = high;
-    m_scrips[row].low = low;
+  if (isLiveRow(row)) {
+    m_rows.high[row] = high;
+    m_rows.low[row] = low;
     notifyColumnsUpdated(row, {MarketWatchColumn::HIGH, MarketWatchColumn::LOW});
   }
 }
 
 void MarketWatchModel::updateOpenInterest(int row, qint64 oi) {
-  if (row >= 0 && row < m_scrips.count() && !m_scrips.at(row).isBlankRow) {
-    m_scrips[row].openInterest = oi;
+  if (isLiveRow(row)) {
+    m_rows.openInterest[row] = oi;
     notifyColumnsUpdated(row, {MarketWatchColumn::OPEN_INTEREST});
   }
 }
 
 void MarketWatchModel::updateAveragePrice(int row, double avgPrice) {
-  if (row >= 0 && row < m_scrips.count() && !m_scrips.at(row).isBlankRow) {
-    m_scrips[row].avgTradedPrice = avgPrice;
+  if (isLiveRow(row)) {
+    m_rows.avgTradedPrice[row] = avgPrice;
     notifyColumnsUpdated(row, {MarketWatchColumn::AVG_TRADED_PRICE});
   }
 }
 
 void MarketWatchModel::updateOHLC(int row, double open, double high, double low,
                                   double close) {
-  if (row >= 0 && row < m_scrips.count() && !m_scrips.at(row).isBlankRow) {
-    ScripData &scrip = m_scrips[row];
-    scrip.open = open;
-    scrip.high = high;
-    scrip.low = low;
-    scrip.close = close;
+  if (isLiveRow(row)) {
+    m_rows.open[row] = open;
+    m_rows.high[row] = high;
+    m_rows.low[row] = low;
+    m_rows.close[row] = close;
 
     notifyColumnsUpdated(row, {MarketWatchColumn::OPEN, MarketWatchColumn::HIGH,
                                MarketWatchColumn::LOW, MarketWatchColumn::CLOSE});
@@ -560,9 +555,9 @@ void MarketWatchModel::updateOHLC(int row, double open, double high, double low,
 }
 
 void MarketWatchModel::updateBidAskQuantities(int row, int bidQty, int askQty) {
-  if (row >= 0 && row < m_scrips.count() && !m_scrips.at(row).isBlankRow) {
-    m_scrips[row].buyQty = bidQty;
-    m_scrips[row].sellQty = askQty;
+  if (isLiveRow(row)) {
+    m_rows.buyQty[row] = bidQty;
+    m_rows.sellQty[row] = askQty;
 
     notifyColumnsUpdated(row, {MarketWatchColumn::BUY_QTY,
                                MarketWatchColumn::SELL_QTY});
@@ -571,9 +566,9 @@ void MarketWatchModel::updateBidAskQuantities(int row, int bidQty, int askQty) {
 
 void MarketWatchModel::updateTotalBuySellQty(int row, int totalBuyQty,
                                              int totalSellQty) {
-  if (row >= 0 && row < m_scrips.count() && !m_scrips.at(row).isBlankRow) {
-    m_scrips[row].totalBuyQty = totalBuyQty;
-    m_scrips[row].totalSellQty = totalSellQty;
+  if (isLiveRow(row)) {
+    m_rows.totalBuyQty[row] = totalBuyQty;
+    m_rows.totalSellQty[row] = totalSellQty;
 
     notifyColumnsUpdated(row, {MarketWatchColumn::TOTAL_BUY_QTY,
                                MarketWatchColumn::TOTAL_SELL_QTY});
@@ -582,9 +577,9 @@ void MarketWatchModel::updateTotalBuySellQty(int row, int totalBuyQty,
 
 void MarketWatchModel::updateOpenInterestWithChange(int row, qint64 oi,
                                                     double oiChangePercent) {
-  if (row >= 0 && row < m_scrips.count() && !m_scrips.at(row).isBlankRow) {
-    m_scrips[row].openInterest = oi;
-    m_scrips[row].oiChangePercent = oiChangePercent;
+  if (isLiveRow(row)) {
+    m_rows.openInterest[row] = oi;
+    m_rows.oiChangePercent[row] = oiChangePercent;
 
     notifyColumnsUpdated(row, {MarketWatchColumn::OPEN_INTEREST,
                                MarketWatchColumn::OI_CHANGE_PERCENT});
@@ -594,15 +589,14 @@ void MarketWatchModel::updateOpenInterestWithChange(int row, qint64 oi,
 void MarketWatchModel::updateGreeks(int row, double iv, double bidIV,
                                     double askIV, double delta, double gamma,
                                     double vega, double theta) {
-  if (row >= 0 && row < m_scrips.count() && !m_scrips.at(row).isBlankRow) {
-    ScripData &scrip = m_scrips[row];
-    scrip.iv = iv;
-    scrip.bidIV = bidIV;
-    scrip.askIV = askIV;
-    scrip.delta = delta;
-    scrip.gamma = gamma;
-    scrip.vega = vega;
-    scrip.theta = theta;
+  if (isLiveRow(row)) {
+    m_rows.iv[row] = iv;
+    m_rows.bidIV[row] = bidIV;
+    m_rows.askIV[row] = askIV;
+    m_rows.delta[row] = delta;
+    m_rows.gamma[row] = gamma;
+    m_rows.vega[row] = vega;
+    m_rows.theta[row] = theta;
 
     // Notify Greeks columns only
     notifyColumnsUpdated(row, {MarketWatchColumn::IMPLIED_VOLATILITY,
@@ -616,108 +610,109 @@ void MarketWatchModel::updateGreeks(int row, double iv, double bidIV,
 }
 
 void MarketWatchModel::updateScripData(int row, const ScripData &scrip) {
-  if (row >= 0 && row < m_scrips.count()) {
-    m_scrips[row] = scrip;
+  if (row >= 0 && row < m_rows.size()) {
+    m_rows.assign(row, scrip);
     notifyRowUpdated(row, 0, columnCount() - 1);
   }
 }
 
 void MarketWatchModel::updateFromUdpTick(int row, const UDP::MarketTick &tick,
                                          double change, double changePercent) {
-  if (row < 0 || row >= m_scrips.count() || m_scrips.at(row).isBlankRow)
+  if (!isLiveRow(row))
     return;
 
-  ScripData &s = m_scrips[row];
+  ScripTable &t = m_rows;
   qint64 now = QDateTime::currentMSecsSinceEpoch();
   bool hasFlash = false;
 
   // Tick direction for LTP
   if (tick.ltp > 0) {
-    if (tick.ltp > s.ltp && s.ltp > 0) {
-      s.ltpTick = 1;
-      s.ltpTickTime = now;
+    const double prevLtp = t.ltp[row];
+    if (tick.ltp > prevLtp && prevLtp > 0) {
+      t.ltpTick[row] = 1;
+      t.ltpTickTime[row] = now;
       hasFlash = true;
-    } else if (tick.ltp < s.ltp && s.ltp > 0) {
-      s.ltpTick = -1;
-      s.ltpTickTime = now;
+    } else if (tick.ltp < prevLtp && prevLtp > 0) {
+      t.ltpTick[row] = -1;
+      t.ltpTickTime[row] = now;
       hasFlash = true;
     }
 
-    s.ltp = tick.ltp;
-    s.change = change;
-    s.changePercent = changePercent;
+    t.ltp[row] = tick.ltp;
+    t.change[row] = change;
+    t.changePercent[row] = changePercent;
   }
 
   // OHLC (only update if values present)
   if (tick.open > 0)
-    s.open = tick.open;
+    t.open[row] = tick.open;
   if (tick.high > 0)
-    s.high = tick.high;
+    t.high[row] = tick.high;
   if (tick.low > 0)
-    s.low = tick.low;
+    t.low[row] = tick.low;
   if (tick.prevClose > 0)
-    s.close = tick.prevClose;
+    t.close[row] = tick.prevClose;
 
   // LTQ
   if (tick.ltq > 0)
-    s.ltq = tick.ltq;
+    t.ltq[row] = tick.ltq;
 
   // Average traded price
   if (tick.atp > 0)
-    s.avgTradedPrice = tick.atp;
+    t.avgTradedPrice[row] = tick.atp;
 
   // Volume
   if (tick.volume > 0)
-    s.volume = tick.volume;
+    t.volume[row] = tick.volume;
 
-  // Bid/Ask with tick direction
+  // Bid/Ask with tick direction (bid/ask columns double as buy/sell price)
   if (tick.bids[0].price > 0 || tick.asks[0].price > 0) {
     double newBid = tick.bids[0].price;
     double newAsk = tick.asks[0].price;
 
     if (newBid > 0) {
-      if (newBid > s.bid && s.bid > 0) {
-        s.bidTick = 1;
-        s.bidTickTime = now;
+      const double prevBid = t.bid[row];
+      if (newBid > prevBid && prevBid > 0) {
+        t.bidTick[row] = 1;
+        t.bidTickTime[row] = now;
         hasFlash = true;
-      } else if (newBid < s.bid && s.bid > 0) {
-        s.bidTick = -1;
-        s.bidTickTime = now;
+      } else if (newBid < prevBid && prevBid > 0) {
+        t.bidTick[row] = -1;
+        t.bidTickTime[row] = now;
         hasFlash = true;
       }
-      s.bid = newBid;
-      s.buyPrice = newBid;
+      t.bid[row] = newBid;
     }
 
     if (newAsk > 0) {
-      if (newAsk > s.ask && s.ask > 0) {
-        s.askTick = 1;
-        s.askTickTime = now;
+      const double prevAsk = t.ask[row];
+      if (newAsk > prevAsk && prevAsk > 0) {
+        t.askTick[row] = 1;
+        t.askTickTime[row] = now;
         hasFlash = true;
-      } else if (newAsk < s.ask && s.ask > 0) {
-        s.askTick = -1;
-        s.askTickTime = now;
+      } else if (newAsk < prevAsk && prevAsk > 0) {
+        t.askTick[row] = -1;
+        t.askTickTime[row] = now;
         hasFlash = true;
       }
-      s.ask = newAsk;
-      s.sellPrice = newAsk;
+      t.ask[row] = newAsk;
     }
 
-    s.buyQty = tick.bids[0].quantity;
-    s.sellQty = tick.asks[0].quantity;
+    t.buyQty[row] = tick.bids[0].quantity;
+    t.sellQty[row] = tick.asks[0].quantity;
   }
 
   // Total buy/sell quantities
   if (tick.totalBidQty > 0 || tick.totalAskQty > 0) {
-    s.totalBuyQty = tick.totalBidQty;
-    s.totalSellQty = tick.totalAskQty;
+    t.totalBuyQty[row] = tick.totalBidQty;
+    t.totalSellQty[row] = tick.totalAskQty;
   }
 
   // Open Interest (derivatives only)
   if (tick.openInterest > 0) {
-    s.openInterest = tick.openInterest;
+    t.openInterest[row] = tick.openInterest;
     if (tick.oiChange != 0) {
-      s.oiChangePercent =
+      t.oiChangePercent[row] =
           (static_cast<double>(tick.oiChange) / tick.openInterest) * 100.0;
     }
   }
@@ -732,14 +727,34 @@ void MarketWatchModel::updateFromUdpTick(int row, const UDP::MarketTick &tick,
 
 int MarketWatchModel::scripCount() const {
   int count = 0;
-  for (const ScripData &scrip : m_scrips) {
-    if (!scrip.isBlankRow) {
+  for (quint8 blank : m_rows.isBlankRow) {
+    if (!blank) {
       ++count;
     }
   }
   return count;
 }
 
+qint64 MarketWatchModel::measureRepaintCost(int firstRow, int rows) const {
+  firstRow = std::clamp(firstRow, 0, m_rows.size());
+  const int lastRow =
+      rows < 0 ? m_rows.size() : std::min(m_rows.size(), firstRow + rows);
+  const int columns = columnCount();
+
+  // The roles a QTableView asks for when it paints a cell
+  QElapsedTimer timer;
+  timer.start();
+  for (int row = firstRow; row < lastRow; ++row) {
+    for (int col = 0; col < columns; ++col) {
+      const QModelIndex idx = index(row, col);
+      data(idx, Qt::DisplayRole);
+      data(idx, Qt::BackgroundRole);
+      data(idx, Qt::ForegroundRole);
+    }
+  }
+  return timer.nsecsElapsed();
+}
+
 void MarketWatchModel::emitCellChanged(int row, int column) {
   QModelIndex idx = index(row, column);
   emit dataChanged(idx, idx);
@@ -759,6 +774,15 @@ int MarketWatchModel::visibleIndexOf(MarketWatchColumn col) const {
   return -1;
 }
 
+bool MarketWatchModel::isLiveColumn(int column) const {
+  QList<int> vis = m_columnProfile.visibleColumns();
+  if (column < 0 || column >= vis.size())
+    return false;
+  const int id = vis[column];
+  return id >= static_cast<int>(MarketWatchColumn::LAST_TRADED_PRICE) &&
+         id <= static_cast<int>(MarketWatchColumn::THETA);
+}
+
 void MarketWatchModel::notifyColumnsUpdated(
     int row, std::initializer_list<MarketWatchColumn> cols) {
   int minIdx = INT_MAX, maxIdx = -1;
@@ -776,16 +800,147 @@ void MarketWatchModel::notifyColumnsUpdated(
 
 void MarketWatchModel::notifyRowUpdated(int row, int firstColumn,
                                         int lastColumn) {
+  if (m_coalesceIntervalMs > 0) {
+    markDirty(row, firstColumn, lastColumn);
+    return;
+  }
+  emitRangeUpdated(row, row, firstColumn, lastColumn);
+}
+
+void MarketWatchModel::emitRangeUpdated(int firstRow, int lastRow,
+                                        int firstColumn, int lastColumn) {
   // ALWAYS emit dataChanged. Proxy models and the view's internal cache
   // rely on this signal to know when to refresh.
-  emit dataChanged(index(row, firstColumn), index(row, lastColumn));
+  emit dataChanged(index(firstRow, firstColumn), index(lastRow, lastColumn));
 
   if (m_viewCallback) {
     // Optional native C++ callback for even faster viewport invalidation
-    m_viewCallback->onRowUpdated(row, firstColumn, lastColumn);
+    for (int row = firstRow; row <= lastRow; ++row)
+      m_viewCallback->onRowUpdated(row, firstColumn, lastColumn);
   }
 }
 
+// ============================================================================
+// Frame Coalescing
+// ============================================================================
+
+void MarketWatchModel::setCoalesceInterval(int intervalMs) {
+  intervalMs = std::max(0, intervalMs);
+  if (intervalMs == m_coalesceIntervalMs)
+    return;
+
+  // Leaving coalesced mode (or changing rate): push out what is queued
+  flushPendingUpdates();
+  m_coalesceIntervalMs = intervalMs;
+  m_coalesceTimer.setInterval(intervalMs);
+}
+
+void MarketWatchModel::markDirty(int row, int firstColumn, int lastColumn) {
+  if (row < 0 || row >= m_rows.size() || firstColumn > lastColumn)
+    return;
+
+  if (m_dirtyWordsPerRow == 0)
+    m_dirtyWordsPerRow = std::max(1, (columnCount() + 63) / 64);
+  const int words = m_dirtyWordsPerRow;
+  lastColumn = std::min(lastColumn, words * 64 - 1);
+
+  const size_t needed = static_cast<size_t>(m_rows.size()) * words;
+  if (m_dirtyColumns.size() < needed)
+    m_dirtyColumns.resize(needed, 0);
+
+  quint64 *mask = &m_dirtyColumns[static_cast<size_t>(row) * words];
+  bool wasClean = true;
+  for (int w = 0; w < words; ++w) {
+    if (mask[w]) {
+      wasClean = false;
+      break;
+    }
+  }
+
+  for (int col = firstColumn; col <= lastColumn;) {
+    // Set the run col..min(lastColumn, end of this word) in one OR
+    const int bit = col & 63;
+    const int span = std::min(lastColumn - col + 1, 64 - bit);
+    const quint64 bits =
+        (span == 64 ? ~quint64(0) : ((quint64(1) << span) - 1)) << bit;
+    mask[col >> 6] |= bits;
+    col += span;
+  }
+
+  if (wasClean)
+    m_dirtyRows.append(row);
+  if (!m_coalesceTimer.isActive())
+    m_coalesceTimer.start();
+}
+
+void MarketWatchModel::flushPendingUpdates() {
+  m_coalesceTimer.stop();
+  if (m_dirtyRows.isEmpty())
+    return;
+
+  // Take the batch first: a dataChanged slot that updates the model again
+  // lands in a fresh m_dirtyRows and is flushed next frame
+  QVector<int> pending;
+  pending.swap(m_dirtyRows);
+  std::sort(pending.begin(), pending.end());
+
+  const int words = m_dirtyWordsPerRow;
+  const int columns = std::min(columnCount(), words * 64);
+  const int rowLimit = m_rows.size();
+  auto maskOf = [this, words](int row) {
+    return &m_dirtyColumns[static_cast<size_t>(row) * words];
+  };
+
+  int i = 0;
+  while (i < pending.size()) {
+    const int firstRow = pending[i];
+
+    // Extend over consecutive rows whose dirty columns are identical
+    int lastRow = firstRow;
+    int j = i + 1;
+    while (j < pending.size() && pending[j] == lastRow + 1 &&
+           std::equal(maskOf(firstRow), maskOf(firstRow) + words,
+                      maskOf(lastRow + 1))) {
+      ++lastRow;
+      ++j;
+    }
+    i = j;
+
+    QVarLengthArray<quint64, 4> mask(words);
+    std::copy_n(maskOf(firstRow), words, mask.data());
+    for (int row = firstRow; row <= lastRow; ++row)
+      std::fill_n(maskOf(row), words, 0);
+
+    if (firstRow >= rowLimit)
+      continue;
+    lastRow = std::min(lastRow, rowLimit - 1);
+
+    // One signal per contiguous column run in the shared mask
+    auto testBit = [&mask](int col) {
+      return (mask[col >> 6] >> (col & 63)) & 1;
+    };
+    int col = 0;
+    while (col < columns) {
+      if (!testBit(col)) {
+        ++col;
+        continue;
+      }
+      int end = col;
+      while (end + 1 < columns && testBit(end + 1))
+        ++end;
+      emitRangeUpdated(firstRow, lastRow, col, end);
+      col = end + 1;
+    }
+  }
+}
+
+void MarketWatchModel::discardPendingUpdates() {
+  m_coalesceTimer.stop();
+  m_dirtyRows.clear();
+  m_dirtyColumns.clear();
+  m_dirtyWordsPerRow = 0; // Recomputed from the (possibly new) column count
+}
+
 // ============================================================================
 // Flash Reset Timer
 // ============================================================================
@@ -803,7 +958,7 @@ void MarketWatchModel::onFlashResetTimeout() {
   rows.swap(m_flashingRows);
 
   for (int row : rows) {
-    if (row >= 0 && row < m_scrips.count()) {
+    if (row >= 0 && row < m_rows.size()) {
       notifyRowUpdated(row, 0, columnCount() - 1);
     }
   }
@@ -814,6 +969,7 @@ void MarketWatchModel::onFlashResetTimeout() {
 // ============================================================================
 
 void MarketWatchModel::setColumnProfile(const GenericTableProfile &profile) {
+  discardPendingUpdates(); // Column indices change; the reset repaints all
   beginResetModel();
   m_columnProfile = profile;
   endResetModel();
@@ -868,117 +1024,119 @@ QStringList MarketWatchModel::getAvailableProfiles() const {
 // Column Data Helpers
 // ============================================================================
 
-QVariant MarketWatchModel::getColumnData(const ScripData &scrip,
+QVariant MarketWatchModel::getColumnData(int row,
                                          MarketWatchColumn column) const {
+  const ScripTable &t = m_rows;
   switch (column) {
   case MarketWatchColumn::CODE:
-    return scrip.code;
+    return t.code[row];
   case MarketWatchColumn::SYMBOL:
-    return scrip.symbol;
+    return t.text(t.symbol[row]);
   case MarketWatchColumn::SCRIP_NAME:
-    return scrip.scripName;
+    return t.text(t.scripName[row]);
   case MarketWatchColumn::INSTRUMENT_NAME:
-    return scrip.instrumentName;
+    return t.text(t.instrumentName[row]);
   case MarketWatchColumn::INSTRUMENT_TYPE:
-    return scrip.instrumentType;
+    return t.text(t.instrumentType[row]);
   case MarketWatchColumn::MARKET_TYPE:
-    return scrip.marketType;
+    return t.text(t.marketType[row]);
   case MarketWatchColumn::EXCHANGE:
-    return scrip.exchange;
+    return t.text(t.exchange[row]);
   case MarketWatchColumn::STRIKE_PRICE:
-    return scrip.strikePrice;
+    return t.strikePrice[row];
   case MarketWatchColumn::OPTION_TYPE:
-    return scrip.optionType;
+    return t.text(t.optionType[row]);
   case MarketWatchColumn::SERIES_EXPIRY:
-    return scrip.seriesExpiry;
+    return t.text(t.seriesExpiry[row]);
   case MarketWatchColumn::ISIN_CODE:
-    return scrip.isinCode;
+    return t.text(t.isinCode[row]);
   case MarketWatchColumn::LAST_TRADED_PRICE:
-    return scrip.ltp;
+    return t.ltp[row];
   case MarketWatchColumn::LAST_TRADED_QUANTITY:
-    return static_cast<qlonglong>(scrip.ltq);
+    return static_cast<qlonglong>(t.ltq[row]);
   case MarketWatchColumn::LAST_TRADED_TIME:
-    return scrip.ltpTime;
+    return t.ltpTime[row];
   case MarketWatchColumn::LAST_UPDATE_TIME:
-    return scrip.lastUpdateTime;
+    return t.lastUpdateTime[row];
   case MarketWatchColumn::OPEN:
-    return scrip.open;
+    return t.open[row];
   case MarketWatchColumn::HIGH:
-    return scrip.high;
+    return t.high[row];
   case MarketWatchColumn::LOW:
-    return scrip.low;
+    return t.low[row];
   case MarketWatchColumn::CLOSE:
-    return scrip.close;
+    return t.close[row];
   case MarketWatchColumn::DPR:
-    return scrip.dpr;
+    return t.text(t.dpr[row]);
   case MarketWatchColumn::NET_CHANGE_RS:
-    return scrip.change;
+    return t.change[row];
   case MarketWatchColumn::PERCENT_CHANGE:
-    return scrip.changePercent;
+    return t.changePercent[row];
   case MarketWatchColumn::TREND_INDICATOR:
-    return scrip.trendIndicator;
+    return t.text(t.trendIndicator[row]);
   case MarketWatchColumn::AVG_TRADED_PRICE:
-    return scrip.avgTradedPrice;
+    return t.avgTradedPrice[row];
   case MarketWatchColumn::VOLUME:
-    return static_cast<qlonglong>(scrip.volume);
+    return static_cast<qlonglong>(t.volume[row]);
   case MarketWatchColumn::VALUE:
-    return scrip.value;
+    return t.value[row];
   case MarketWatchColumn::BUY_PRICE:
-    return scrip.buyPrice;
+    return t.bid[row];
   case MarketWatchColumn::BUY_QTY:
-    return static_cast<qlonglong>(scrip.buyQty);
+    return static_cast<qlonglong>(t.buyQty[row]);
   case MarketWatchColumn::TOTAL_BUY_QTY:
-    return static_cast<qlonglong>(scrip.totalBuyQty);
+    return static_cast<qlonglong>(t.totalBuyQty[row]);
   case MarketWatchColumn::SELL_PRICE:
-    return scrip.sellPrice;
+    return t.ask[row];
   case MarketWatchColumn::SELL_QTY:
-    return static_cast<qlonglong>(scrip.sellQty);
+    return static_cast<qlonglong>(t.sellQty[row]);
   case MarketWatchColumn::TOTAL_SELL_QTY:
-    return static_cast<qlonglong>(scrip.totalSellQty);
+    return static_cast<qlonglong>(t.totalSellQty[row]);
   case MarketWatchColumn::OPEN_INTEREST:
-    return static_cast<qlonglong>(scrip.openInterest);
+    return static_cast<qlonglong>(t.openInterest[row]);
   case MarketWatchColumn::OI_CHANGE_PERCENT:
-    return scrip.oiChangePercent;
+    return t.oiChangePercent[row];
   case MarketWatchColumn::IMPLIED_VOLATILITY:
-    return scrip.iv * 100.0; // Convert to percentage
+    return t.iv[row] * 100.0; // Convert to percentage
   case MarketWatchColumn::BID_IV:
-    return scrip.bidIV * 100.0;
+    return t.bidIV[row] * 100.0;
   case MarketWatchColumn::ASK_IV:
-    return scrip.askIV * 100.0;
+    return t.askIV[row] * 100.0;
   case MarketWatchColumn::DELTA:
-    return scrip.delta;
+    return t.delta[row];
   case MarketWatchColumn::GAMMA:
-    return scrip.gamma;
+    return t.gamma[row];
   case MarketWatchColumn::VEGA:
-    return scrip.vega;
+    return t.vega[row];
   case MarketWatchColumn::THETA:
-    return scrip.theta;
+    return t.theta[row];
   case MarketWatchColumn::WEEK_52_HIGH:
-    return scrip.week52High;
+    return t.week52High[row];
   case MarketWatchColumn::WEEK_52_LOW:
-    return scrip.week52Low;
+    return t.week52Low[row];
   case MarketWatchColumn::LIFETIME_HIGH:
-    return scrip.lifetimeHigh;
+    return t.lifetimeHigh[row];
   case MarketWatchColumn::LIFETIME_LOW:
-    return scrip.lifetimeLow;
+    return t.lifetimeLow[row];
   case MarketWatchColumn::MARKET_CAP:
-    return scrip.marketCap;
+    return t.marketCap[row];
   case MarketWatchColumn::TRADE_EXECUTION_RANGE:
-    return scrip.tradeExecutionRange;
+    return t.text(t.tradeExecutionRange[row]);
   default:
     return QVariant();
   }
 }
 
-QString MarketWatchModel::formatColumnData(const ScripData &scrip,
+QString MarketWatchModel::formatColumnData(int row,
                                            MarketWatchColumn column) const {
+  const ScripTable &t = m_rows;
   ColumnInfo info = MarketWatchColumnProfile::getColumnInfo(column);
   QString format = info.format;
   QString units = info.unit;
 
   switch (column) {
   case MarketWatchColumn::CODE:
-    return QString::number(scrip.code);
+    return QString::number(t.code[row]);
 
   case MarketWatchColumn::SYMBOL:
   case MarketWatchColumn::SCRIP_NAME:
@@ -991,11 +1149,11 @@ QString MarketWatchModel::formatColumnData(const ScripData &scrip,
   case MarketWatchColumn::DPR:
   case MarketWatchColumn::TREND_INDICATOR:
   case MarketWatchColumn::TRADE_EXECUTION_RANGE: {
-    QString val = getColumnData(scrip, column).toString();
+    QString val = getColumnData(row, column).toString();
     if (column == MarketWatchColumn::INSTRUMENT_TYPE ||
         column == MarketWatchColumn::OPTION_TYPE) {
       // qDebug() << "[MarketWatchModel] formatting string col" << (int)column
-      // << "for" << scrip.symbol << "val:" << val;
+      // << "for" << t.text(t.symbol[row]) << "val:" << val;
     }
     return val;
   }
@@ -1003,7 +1161,7 @@ QString MarketWatchModel::formatColumnData(const ScripData &scrip,
   case MarketWatchColumn::SERIES_EXPIRY: {
     // For F&O instruments, show expiry date
     // For equity, show series (EQ, BE, etc.)
-    QString seriesExpiry = getColumnData(scrip, column).toString();
+    QString seriesExpiry = getColumnData(row, column).toString();
     if (seriesExpiry.isEmpty() || seriesExpiry == "N/A")
       return "-";
 
@@ -1012,10 +1170,12 @@ QString MarketWatchModel::formatColumnData(const ScripData &scrip,
     // 2. BSE: exchange is "BSEFO" or series is "IF", "IO", "IS" (Index/Stock
     // Futures/Options)
     // 3. Generic: Has strike price or option type set
-    bool isFO = scrip.instrumentType.contains("FUT") ||
-                scrip.instrumentType.contains("OPT") ||
-                scrip.exchange == "BSEFO" || scrip.exchange == "NSEFO" ||
-                scrip.strikePrice > 0 || !scrip.optionType.isEmpty();
+    const QString &instrumentType = t.text(t.instrumentType[row]);
+    const QString &exchange = t.text(t.exchange[row]);
+    bool isFO = instrumentType.contains("FUT") ||
+                instrumentType.contains("OPT") ||
+                exchange == "BSEFO" || exchange == "NSEFO" ||
+                t.strikePrice[row] > 0 || t.optionType[row] != 0;
 
     if (isFO) {
       return seriesExpiry; // Show full expiry for F&O (e.g., "29JAN2026")
@@ -1039,7 +1199,7 @@ QString MarketWatchModel::formatColumnData(const ScripData &scrip,
   case MarketWatchColumn::WEEK_52_LOW:
   case MarketWatchColumn::LIFETIME_HIGH:
   case MarketWatchColumn::LIFETIME_LOW: {
-    double value = getColumnData(scrip, column).toDouble();
+    double value = getColumnData(row, column).toDouble();
     if (value == 0.0)
       return "-";
     return QString::number(value, 'f', 2) +
@@ -1048,7 +1208,7 @@ QString MarketWatchModel::formatColumnData(const ScripData &scrip,
 
   case MarketWatchColumn::PERCENT_CHANGE:
   case MarketWatchColumn::OI_CHANGE_PERCENT: {
-    double value = getColumnData(scrip, column).toDouble();
+    double value = getColumnData(row, column).toDouble();
     if (value == 0.0)
       return "-";
     QString sign = (value > 0) ? "+" : "";
@@ -1056,21 +1216,21 @@ QString MarketWatchModel::formatColumnData(const ScripData &scrip,
   }
 
   case MarketWatchColumn::VOLUME: {
-    qint64 vol = getColumnData(scrip, column).toLongLong();
+    qint64 vol = getColumnData(row, column).toLongLong();
     if (vol == 0)
       return "-";
     return QString::number(vol / 1000.0, 'f', 2) + " K"; // in 000s
   }
 
   case MarketWatchColumn::VALUE: {
-    double val = getColumnData(scrip, column).toDouble();
+    double val = getColumnData(row, column).toDouble();
     if (val == 0.0)
       return "-";
     return QString::number(val / 100000.0, 'f', 2) + " L"; // in lacs
   }
 
   case MarketWatchColumn::MARKET_CAP: {
-    double cap = getColumnData(scrip, column).toDouble();
+    double cap = getColumnData(row, column).toDouble();
     if (cap == 0.0)
       return "-";
     if (cap >= 10000000.0) {
@@ -1085,7 +1245,7 @@ QString MarketWatchModel::formatColumnData(const ScripData &scrip,
   case MarketWatchColumn::TOTAL_BUY_QTY:
   case MarketWatchColumn::TOTAL_SELL_QTY:
   case MarketWatchColumn::OPEN_INTEREST: {
-    qint64 value = getColumnData(scrip, column).toLongLong();
+    qint64 value = getColumnData(row, column).toLongLong();
     if (value == 0)
       return "-";
     return QString::number(value) + (units.isEmpty() ? "" : " " + units);
@@ -1093,40 +1253,40 @@ QString MarketWatchModel::formatColumnData(const ScripData &scrip,
 
   case MarketWatchColumn::LAST_TRADED_TIME:
   case MarketWatchColumn::LAST_UPDATE_TIME:
-    return getColumnData(scrip, column).toString();
+    return getColumnData(row, column).toString();
 
   // Greeks columns
   case MarketWatchColumn::IMPLIED_VOLATILITY:
   case MarketWatchColumn::BID_IV:
   case MarketWatchColumn::ASK_IV: {
-    double value = getColumnData(scrip, column).toDouble();
+    double value = getColumnData(row, column).toDouble();
     if (value <= 0.0)
       return "-";
     return QString::number(value, 'f', 1) + "%";
   }
 
   case MarketWatchColumn::DELTA: {
-    if (scrip.iv <= 0.0)
+    if (t.iv[row] <= 0.0)
       return "-"; // No Greeks if IV not calculated
-    return QString::number(scrip.delta, 'f', 3);
+    return QString::number(t.delta[row], 'f', 3);
   }
 
   case MarketWatchColumn::GAMMA: {
-    if (scrip.iv <= 0.0)
+    if (t.iv[row] <= 0.0)
       return "-";
-    return QString::number(scrip.gamma, 'f', 5);
+    return QString::number(t.gamma[row], 'f', 5);
   }
 
   case MarketWatchColumn::VEGA: {
-    if (scrip.iv <= 0.0)
+    if (t.iv[row] <= 0.0)
       return "-";
-    return QString::number(scrip.vega, 'f', 2);
+    return QString::number(t.vega[row], 'f', 2);
   }
 
   case MarketWatchColumn::THETA: {
-    if (scrip.iv <= 0.0)
+    if (t.iv[row] <= 0.0)
       return "-";
-    return QString::number(scrip.theta, 'f', 2);
+    return QString::number(t.theta[row], 'f', 2);
   }
 
   default:
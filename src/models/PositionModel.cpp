@@ -133,7 +133,26 @@ QVariant PositionModel::data(const QModelIndex& index, int role) const
             case ProductType: return pos.productType;
             case ClientGroup: return pos.clientGroup;
             case MaturityDate: return pos.maturityDate;
+            case BuyLot: return pos.buyLot;
+            case BuyWeight: return pos.buyWeight;
+            case SellLot: return pos.sellLot;
+            case SellWeight: return pos.sellWeight;
+            case NetLot: return pos.netLot;
+            case NetWeight: return pos.netWeight;
+            case NetVal: return pos.netVal;
+            case DPRRange: return pos.dprRange;
+            case Yield: return pos.yield;
+            case TotalQuantity: return pos.totalQuantity;
+            case TotalLot: return pos.totalLot;
+            case TotalWeight: return pos.totalWeight;
+            case Brokerage: return pos.brokerage;
             case NetMTM: return pos.netMtm;
+            case NetValuePostExp: return pos.netValPostExp;
+            case OptionFlag: return pos.optionFlag;
+            case VarPercent: return pos.varPercent;
+            case VarAmount: return pos.varAmount;
+            case SMCategory: return pos.smCategory;
+            case CfAvgPrice: return pos.cfAvgPrice;
             case ActualMTM: return pos.actualMtm;
             case UnsettledQty: return pos.unsettledQty;
             default: return QVariant();
@@ -0,0 +1,316 @@
+#include "models/qt/ScripTable.h"
+#include <algorithm>
+#include <type_traits>
+
+// ============================================================================
+// ScripStringPool
+// ============================================================================
+
+ScripStringPool &ScripStringPool::instance() {
+  static ScripStringPool pool;
+  return pool;
+}
+
+ScripStringPool::ScripStringPool() {
+  m_strings.emplace_back(); // Id 0 = empty string
+  m_ids.insert(QString(), 0);
+}
+
+ScripStringPool::Id ScripStringPool::intern(const QString &text) {
+  if (text.isEmpty())
+    return 0;
+  auto it = m_ids.constFind(text);
+  if (it != m_ids.constEnd())
+    return it.value();
+
+  Id id = static_cast<Id>(m_strings.size());
+  m_strings.push_back(text);
+  m_ids.insert(text, id);
+  return id;
+}
+
+size_t ScripStringPool::heapBytes(const QString &text) {
+  if (text.isEmpty())
+    return 0;
+  // QArrayData header + UTF-16 payload + terminator
+  return sizeof(QArrayData) + (static_cast<size_t>(text.size()) + 1) * sizeof(QChar);
+}
+
+size_t ScripStringPool::memoryBytes() const {
+  // Each string is held once (the hash key shares the deque's payload)
+  size_t bytes = 0;
+  for (const QString &s : m_strings)
+    bytes += sizeof(QString) + heapBytes(s);
+  bytes += static_cast<size_t>(m_ids.capacity()) *
+           (sizeof(QString) + sizeof(Id) + 2 * sizeof(void *));
+  return bytes;
+}
+
+// ============================================================================
+// ScripTable
+// ============================================================================
+
+namespace {
+
+// Apply fn to every column vector (generic lambda: fn(auto &column)).
+// Keep in step with the column list in ScripTable.h.
+template <typename Table, typename Fn> void forEachColumn(Table &t, Fn &&fn) {
+  fn(t.code);
+  fn(t.token);
+  fn(t.isBlankRow);
+  fn(t.symbol);
+  fn(t.scripName);
+  fn(t.instrumentName);
+  fn(t.instrumentType);
+  fn(t.marketType);
+  fn(t.exchange);
+  fn(t.optionType);
+  fn(t.seriesExpiry);
+  fn(t.isinCode);
+  fn(t.dpr);
+  fn(t.trendIndicator);
+  fn(t.tradeExecutionRange);
+  fn(t.strikePrice);
+
+  fn(t.ltp);
+  fn(t.ltq);
+  fn(t.open);
+  fn(t.high);
+  fn(t.low);
+  fn(t.close);
+  fn(t.change);
+  fn(t.changePercent);
+  fn(t.avgTradedPrice);
+  fn(t.volume);
+  fn(t.value);
+  fn(t.bid);
+  fn(t.ask);
+  fn(t.buyQty);
+  fn(t.sellQty);
+  fn(t.totalBuyQty);
+  fn(t.totalSellQty);
+  fn(t.openInterest);
+  fn(t.oiChangePercent);
+
+  fn(t.iv);
+  fn(t.bidIV);
+  fn(t.askIV);
+  fn(t.delta);
+  fn(t.gamma);
+  fn(t.vega);
+  fn(t.theta);
+
+  fn(t.week52High);
+  fn(t.week52Low);
+  fn(t.lifetimeHigh);
+  fn(t.lifetimeLow);
+  fn(t.marketCap);
+
+  fn(t.ltpTick);
+  fn(t.bidTick);
+  fn(t.askTick);
+  fn(t.ltpTickTime);
+  fn(t.bidTickTime);
+  fn(t.askTickTime);
+
+  fn(t.ltpTime);
+  fn(t.lastUpdateTime);
+}
+
+} // namespace
+
+void ScripTable::insert(int row, const ScripData &scrip) {
+  row = std::clamp(row, 0, size());
+  forEachColumn(*this, [row](auto &column) {
+    column.insert(column.begin() + row, typename std::decay_t<decltype(column)>::value_type{});
+  });
+  assign(row, scrip);
+}
+
+void ScripTable::remove(int row) {
+  if (row < 0 || row >= size())
+    return;
+  forEachColumn(*this, [row](auto &column) { column.erase(column.begin() + row); });
+}
+
+void ScripTable::move(int from, int to) {
+  if (from < 0 || from >= size() || to < 0 || to >= size() || from == to)
+    return;
+  forEachColumn(*this, [from, to](auto &column) {
+    if (from < to)
+      std::rotate(column.begin() + from, column.begin() + from + 1, column.begin() + to + 1);
+    else
+      std::rotate(column.begin() + to, column.begin() + from, column.begin() + from + 1);
+  });
+}
+
+void ScripTable::clear() {
+  forEachColumn(*this, [](auto &column) { column.clear(); });
+}
+
+void ScripTable::reserve(int rows) {
+  forEachColumn(*this, [rows](auto &column) { column.reserve(static_cast<size_t>(rows)); });
+}
+
+void ScripTable::assign(int row, const ScripData &s) {
+  ScripStringPool &pool = ScripStringPool::instance();
+
+  code[row] = s.code;
+  token[row] = s.token;
+  isBlankRow[row] = s.isBlankRow ? 1 : 0;
+  symbol[row] = pool.intern(s.symbol);
+  scripName[row] = pool.intern(s.scripName);
+  instrumentName[row] = pool.intern(s.instrumentName);
+  instrumentType[row] = pool.intern(s.instrumentType);
+  marketType[row] = pool.intern(s.marketType);
+  exchange[row] = pool.intern(s.exchange);
+  optionType[row] = pool.intern(s.optionType);
+  seriesExpiry[row] = pool.intern(s.seriesExpiry);
+  isinCode[row] = pool.intern(s.isinCode);
+  dpr[row] = pool.intern(s.dpr);
+  trendIndicator[row] = pool.intern(s.trendIndicator);
+  tradeExecutionRange[row] = pool.intern(s.tradeExecutionRange);
+  strikePrice[row] = s.strikePrice;
+
+  ltp[row] = s.ltp;
+  ltq[row] = s.ltq;
+  open[row] = s.open;
+  high[row] = s.high;
+  low[row] = s.low;
+  close[row] = s.close;
+  change[row] = s.change;
+  changePercent[row] = s.changePercent;
+  avgTradedPrice[row] = s.avgTradedPrice;
+  volume[row] = s.volume;
+  value[row] = s.value;
+  // Callers fill either the alias or the depth field; prefer the depth one
+  bid[row] = s.buyPrice != 0.0 ? s.buyPrice : s.bid;
+  ask[row] = s.sellPrice != 0.0 ? s.sellPrice : s.ask;
+  buyQty[row] = s.buyQty;
+  sellQty[row] = s.sellQty;
+  totalBuyQty[row] = s.totalBuyQty;
+  totalSellQty[row] = s.totalSellQty;
+  openInterest[row] = s.openInterest;
+  oiChangePercent[row] = s.oiChangePercent;
+
+  iv[row] = s.iv;
+  bidIV[row] = s.bidIV;
+  askIV[row] = s.askIV;
+  delta[row] = s.delta;
+  gamma[row] = s.gamma;
+  vega[row] = s.vega;
+  theta[row] = s.theta;
+
+  week52High[row] = s.week52High;
+  week52Low[row] = s.week52Low;
+  lifetimeHigh[row] = s.lifetimeHigh;
+  lifetimeLow[row] = s.lifetimeLow;
+  marketCap[row] = s.marketCap;
+
+  ltpTick[row] = static_cast<qint8>(s.ltpTick);
+  bidTick[row] = static_cast<qint8>(s.bidTick);
+  askTick[row] = static_cast<qint8>(s.askTick);
+  ltpTickTime[row] = s.ltpTickTime;
+  bidTickTime[row] = s.bidTickTime;
+  askTickTime[row] = s.askTickTime;
+
+  ltpTime[row] = s.ltpTime;
+  lastUpdateTime[row] = s.lastUpdateTime;
+}
+
+ScripData ScripTable::at(int row) const {
+  ScripData s;
+  if (row < 0 || row >= size())
+    return s;
+
+  s.code = code[row];
+  s.token = token[row];
+  s.isBlankRow = isBlankRow[row] != 0;
+  s.symbol = text(symbol[row]);
+  s.scripName = text(scripName[row]);
+  s.instrumentName = text(instrumentName[row]);
+  s.instrumentType = text(instrumentType[row]);
+  s.marketType = text(marketType[row]);
+  s.exchange = text(exchange[row]);
+  s.optionType = text(optionType[row]);
+  s.seriesExpiry = text(seriesExpiry[row]);
+  s.isinCode = text(isinCode[row]);
+  s.dpr = text(dpr[row]);
+  s.trendIndicator = text(trendIndicator[row]);
+  s.tradeExecutionRange = text(tradeExecutionRange[row]);
+  s.strikePrice = strikePrice[row];
+
+  s.ltp = ltp[row];
+  s.ltq = ltq[row];
+  s.open = open[row];
+  s.high = high[row];
+  s.low = low[row];
+  s.close = close[row];
+  s.change = change[row];
+  s.changePercent = changePercent[row];
+  s.avgTradedPrice = avgTradedPrice[row];
+  s.volume = volume[row];
+  s.value = value[row];
+  s.bid = s.buyPrice = bid[row];
+  s.ask = s.sellPrice = ask[row];
+  s.buyQty = buyQty[row];
+  s.sellQty = sellQty[row];
+  s.totalBuyQty = totalBuyQty[row];
+  s.totalSellQty = totalSellQty[row];
+  s.openInterest = openInterest[row];
+  s.oiChangePercent = oiChangePercent[row];
+
+  s.iv = iv[row];
+  s.bidIV = bidIV[row];
+  s.askIV = askIV[row];
+  s.delta = delta[row];
+  s.gamma = gamma[row];
+  s.vega = vega[row];
+  s.theta = theta[row];
+
+  s.week52High = week52High[row];
+  s.week52Low = week52Low[row];
+  s.lifetimeHigh = lifetimeHigh[row];
+  s.lifetimeLow = lifetimeLow[row];
+  s.marketCap = marketCap[row];
+
+  s.ltpTick = ltpTick[row];
+  s.bidTick = bidTick[row];
+  s.askTick = askTick[row];
+  s.ltpTickTime = ltpTickTime[row];
+  s.bidTickTime = bidTickTime[row];
+  s.askTickTime = askTickTime[row];
+
+  s.ltpTime = ltpTime[row];
+  s.lastUpdateTime = lastUpdateTime[row];
+  return s;
+}
+
+size_t ScripTable::memoryBytes() const {
+  size_t bytes = 0;
+  forEachColumn(*this, [&bytes](const auto &column) {
+    bytes += column.capacity() * sizeof(typename std::decay_t<decltype(column)>::value_type);
+  });
+  for (int row = 0; row < size(); ++row) {
+    bytes += ScripStringPool::heapBytes(ltpTime[row]) +
+             ScripStringPool::heapBytes(lastUpdateTime[row]);
+  }
+  return bytes;
+}
+
+size_t ScripTable::legacyLayoutBytes() const {
+  // QList<ScripData>: one pointer slot + one heap node per row, and every
+  // QString field with its own payload
+  size_t bytes = static_cast<size_t>(size()) * (sizeof(void *) + sizeof(ScripData));
+  const std::vector<StringId> *textColumns[] = {
+      &symbol,     &scripName, &instrumentName, &instrumentType,
+      &marketType, &exchange,  &optionType,     &seriesExpiry,
+      &isinCode,   &dpr,       &trendIndicator, &tradeExecutionRange};
+  for (int row = 0; row < size(); ++row) {
+    for (const auto *column : textColumns)
+      bytes += ScripStringPool::heapBytes(text((*column)[row]));
+    bytes += ScripStringPool::heapBytes(ltpTime[row]) +
+             ScripStringPool::heapBytes(lastUpdateTime[row]);
+  }
+  return bytes;
+}
@@ -1,5 +1,26 @@
 #include "models/domain/TokenAddressBook.h"
 #include <QDebug>
+#include <algorithm>
+
+namespace {
+
+template <typename Rows>
+QList<int> toList(const Rows& rows)
+{
+    QList<int> list;
+    list.reserve(static_cast<int>(rows.size()));
+    for (int row : rows) list.append(row);
+    return list;
+}
+
+// Make sure a row-indexed reverse map can be written at row
+template <typename T>
+void ensureRow(std::vector<T>& rowMap, int row)
+{
+    if (static_cast<size_t>(row) >= rowMap.size()) rowMap.resize(static_cast<size_t>(row) + 1);
+}
+
+} // namespace
 
 TokenAddressBook::TokenAddressBook(QObject *parent)
     : QObject(parent)
@@ -15,166 +36,276 @@ void TokenAddressBook::addToken(int token, int row)
 {
     // For simple tokens, we use "token" as the key
     QString key = QString::number(token);
-    
-    if (!m_keyToRows.contains(key)) m_keyToRows[key] = QList<int>();
-    if (!m_keyToRows[key].contains(row)) {
-        m_keyToRows[key].append(row);
-    }
-    m_rowToKey[row] = key;
-    
+    addStringKey(key, row);
     emit tokenAdded(key, row);
 }
 
 void TokenAddressBook::addCompositeToken(const QString& exchange, const QString& client, int token, int row)
 {
     QString key = makeKey(exchange, client, token);
-    
-    if (!m_keyToRows.contains(key)) m_keyToRows[key] = QList<int>();
-    if (!m_keyToRows[key].contains(row)) {
-        m_keyToRows[key].append(row);
-    }
-    m_rowToKey[row] = key;
-    
+    addStringKey(key, row);
     emit tokenAdded(key, row);
 }
 
 void TokenAddressBook::removeToken(int token, int row)
 {
     QString key = QString::number(token);
-    if (m_keyToRows.contains(key)) {
-        m_keyToRows[key].removeAll(row);
-        if (m_keyToRows[key].isEmpty()) m_keyToRows.remove(key);
-    }
-    if (m_rowToKey.value(row) == key) m_rowToKey.remove(row);
+    removeStringKey(key, row);
     emit tokenRemoved(key, row);
 }
 
 void TokenAddressBook::removeCompositeToken(const QString& exchange, const QString& client, int token, int row)
 {
     QString key = makeKey(exchange, client, token);
-    if (m_keyToRows.contains(key)) {
-        m_keyToRows[key].removeAll(row);
-        if (m_keyToRows[key].isEmpty()) m_keyToRows.remove(key);
-    }
-    if (m_rowToKey.value(row) == key) m_rowToKey.remove(row);
+    removeStringKey(key, row);
     emit tokenRemoved(key, row);
 }
 
+void TokenAddressBook::addStringKey(const QString& key, int row)
+{
+    if (row < 0) return;
+    RowList& rows = m_keyToRows[key];
+    if (!rows.contains(row)) rows.append(row);
+    ensureRow(m_rowToKey, row);
+    m_rowToKey[row] = key;
+}
+
+void TokenAddressBook::removeStringKey(const QString& key, int row)
+{
+    auto it = m_keyToRows.find(key);
+    if (it != m_keyToRows.end()) {
+        RowList& rows = it.value();
+        rows.resize(static_cast<int>(std::remove(rows.begin(), rows.end(), row) - rows.begin()));
+        if (rows.isEmpty()) m_keyToRows.erase(it);
+    }
+    if (row >= 0 && static_cast<size_t>(row) < m_rowToKey.size() && m_rowToKey[row] == key) {
+        m_rowToKey[row].clear();
+    }
+}
+
 // === Optimized Int64 Implementation ===
 
+size_t TokenAddressBook::probeStart(int64_t key) const
+{
+    // Fibonacci hashing spreads consecutive tokens across the table
+    uint64_t h = static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ull;
+    h ^= h >> 32;
+    return static_cast<size_t>(h) & (m_intSlots.size() - 1);
+}
+
+const TokenAddressBook::IntSlot* TokenAddressBook::findIntSlot(int64_t key) const
+{
+    if (m_intCount == 0 || key == kEmptyKey) return nullptr;
+    const size_t mask = m_intSlots.size() - 1;
+    for (size_t i = probeStart(key);; i = (i + 1) & mask) {
+        const IntSlot& slot = m_intSlots[i];
+        if (slot.key == key) return &slot;
+        if (slot.key == kEmptyKey) return nullptr;
+    }
+}
+
+TokenAddressBook::IntSlot* TokenAddressBook::findIntSlot(int64_t key)
+{
+    return const_cast<IntSlot*>(static_cast<const TokenAddressBook*>(this)->findIntSlot(key));
+}
+
+TokenAddressBook::IntSlot& TokenAddressBook::insertIntSlot(int64_t key)
+{
+    // Keep load factor <= 1/2 so probe sequences stay short
+    if ((m_intCount + 1) * 2 > m_intSlots.size()) growIntTable();
+
+    const size_t mask = m_intSlots.size() - 1;
+    for (size_t i = probeStart(key);; i = (i + 1) & mask) {
+        IntSlot& slot = m_intSlots[i];
+        if (slot.key == key) return slot;
+        if (slot.key == kEmptyKey) {
+            slot.key = key;
+            ++m_intCount;
+            return slot;
+        }
+    }
+}
+
+void TokenAddressBook::growIntTable()
+{
+    std::vector<IntSlot> old;
+    old.swap(m_intSlots);
+    m_intSlots.resize(std::max<size_t>(16, old.size() * 2));
+    m_intCount = 0;
+    for (IntSlot& slot : old) {
+        if (slot.key != kEmptyKey) insertIntSlot(slot.key).rows = slot.rows;
+    }
+}
+
+void TokenAddressBook::eraseIntSlot(IntSlot* slot)
+{
+    // Backward-shift deletion: pull later members of the probe run into the
+    // hole so lookups never need tombstones
+    const size_t mask = m_intSlots.size() - 1;
+    size_t hole = static_cast<size_t>(slot - m_intSlots.data());
+    for (size_t j = (hole + 1) & mask; m_intSlots[j].key != kEmptyKey; j = (j + 1) & mask) {
+        const size_t home = probeStart(m_intSlots[j].key);
+        // Move j into the hole unless its home lies cyclically in (hole, j]
+        const bool homeBetween = hole <= j ? (home > hole && home <= j)
+                                           : (home > hole || home <= j);
+        if (!homeBetween) {
+            m_intSlots[hole] = m_intSlots[j];
+            hole = j;
+        }
+    }
+    m_intSlots[hole] = IntSlot{};
+    --m_intCount;
+}
+
+void TokenAddressBook::removeIntRow(int64_t key, int row)
+{
+    IntSlot* slot = findIntSlot(key);
+    if (!slot) return;
+    RowList& rows = slot->rows;
+    rows.resize(static_cast<int>(std::remove(rows.begin(), rows.end(), row) - rows.begin()));
+    if (rows.isEmpty()) eraseIntSlot(slot);
+}
+
 void TokenAddressBook::addIntKeyToken(int exchangeSegment, int token, int row)
 {
     int64_t key = makeIntKey(exchangeSegment, token);
-    
-    if (!m_intKeyToRows.contains(key)) m_intKeyToRows[key] = QList<int>();
-    if (!m_intKeyToRows[key].contains(row)) {
-        m_intKeyToRows[key].append(row);
-    }
+    if (key == kEmptyKey || row < 0) return;
+
+    RowList& rows = insertIntSlot(key).rows;
+    if (!rows.contains(row)) rows.append(row);
+    ensureRow(m_rowToIntKey, row);
     m_rowToIntKey[row] = key;
 }
 
 void TokenAddressBook::removeIntKeyToken(int exchangeSegment, int token, int row)
 {
     int64_t key = makeIntKey(exchangeSegment, token);
-    
-    if (m_intKeyToRows.contains(key)) {
-        m_intKeyToRows[key].removeAll(row);
-        if (m_intKeyToRows[key].isEmpty()) m_intKeyToRows.remove(key);
+    removeIntRow(key, row);
+    if (row >= 0 && static_cast<size_t>(row) < m_rowToIntKey.size() && m_rowToIntKey[row] == key) {
+        m_rowToIntKey[row] = kEmptyKey;
     }
-    if (m_rowToIntKey.value(row) == key) m_rowToIntKey.remove(row);
+}
+
+TokenAddressBook::RowSpan TokenAddressBook::rowsForIntKey(int64_t key) const
+{
+    const IntSlot* slot = findIntSlot(key);
+    if (!slot) return {};
+    return RowSpan(slot->rows.constData(), static_cast<size_t>(slot->rows.size()));
 }
 
 QList<int> TokenAddressBook::getRowsForIntKey(int exchangeSegment, int token) const
 {
-    // Direct hash lookup - O(1) / O(log N) for QMap
-    return m_intKeyToRows.value(makeIntKey(exchangeSegment, token));
+    return toList(rowsForIntKey(makeIntKey(exchangeSegment, token)));
 }
 
 QList<int> TokenAddressBook::getRowsForIntKey(int64_t key) const
 {
-    return m_intKeyToRows.value(key);
+    return toList(rowsForIntKey(key));
 }
 
 int64_t TokenAddressBook::getIntKeyForRow(int row) const
 {
-    return m_rowToIntKey.value(row, 0); // 0 is invalid key
+    if (row < 0 || static_cast<size_t>(row) >= m_rowToIntKey.size()) return 0; // 0 is invalid key
+    return m_rowToIntKey[row];
 }
 
 void TokenAddressBook::clear()
 {
     m_keyToRows.clear();
     m_rowToKey.clear();
-    m_intKeyToRows.clear();
+    m_intSlots.clear();
+    m_intCount = 0;
     m_rowToIntKey.clear();
     emit cleared();
 }
 
+void TokenAddressBook::replaceRow(RowList& rows, int oldRow, int newRow)
+{
+    for (int& row : rows) {
+        if (row == oldRow) {
+            row = newRow;
+            return;
+        }
+    }
+}
+
 void TokenAddressBook::onRowMoved(int fromRow, int toRow)
 {
+    if (fromRow < 0 || toRow < 0) return;
+
     // Handle String Keys
-    QString key = m_rowToKey.value(fromRow);
+    QString key = getCompositeKeyForRow(fromRow);
     if (!key.isEmpty()) {
-        m_rowToKey.remove(fromRow);
+        m_rowToKey[fromRow].clear();
+        ensureRow(m_rowToKey, toRow);
         m_rowToKey[toRow] = key;
-        
-        if (m_keyToRows.contains(key)) {
-            int idx = m_keyToRows[key].indexOf(fromRow);
-            if (idx != -1) m_keyToRows[key][idx] = toRow;
-        }
+
+        auto it = m_keyToRows.find(key);
+        if (it != m_keyToRows.end()) replaceRow(it.value(), fromRow, toRow);
     }
-    
+
     // Handle Int64 Keys
-    int64_t intKey = m_rowToIntKey.value(fromRow, 0);
-    if (intKey != 0) {
-        m_rowToIntKey.remove(fromRow);
+    int64_t intKey = getIntKeyForRow(fromRow);
+    if (intKey != kEmptyKey) {
+        m_rowToIntKey[fromRow] = kEmptyKey;
+        ensureRow(m_rowToIntKey, toRow);
         m_rowToIntKey[toRow] = intKey;
-        
-        if (m_intKeyToRows.contains(intKey)) {
-            int idx = m_intKeyToRows[intKey].indexOf(fromRow);
-            if (idx != -1) m_intKeyToRows[intKey][idx] = toRow;
-        }
+
+        if (IntSlot* slot = findIntSlot(intKey)) replaceRow(slot->rows, fromRow, toRow);
     }
 }
 
 void TokenAddressBook::onRowsInserted(int firstRow, int count)
 {
-    updateRowIndices(firstRow, count);
+    if (firstRow < 0 || count <= 0) return;
+
+    // Open a gap in the reverse maps; rows past the end need nothing
+    if (static_cast<size_t>(firstRow) < m_rowToKey.size()) {
+        m_rowToKey.insert(m_rowToKey.begin() + firstRow, static_cast<size_t>(count), QString());
+    }
+    if (static_cast<size_t>(firstRow) < m_rowToIntKey.size()) {
+        m_rowToIntKey.insert(m_rowToIntKey.begin() + firstRow, static_cast<size_t>(count), kEmptyKey);
+    }
+    updateRowIndices(firstRow + count, count);
 }
 
 void TokenAddressBook::onRowsRemoved(int firstRow, int count)
 {
+    if (firstRow < 0 || count <= 0) return;
+
     for (int row = firstRow; row < firstRow + count; ++row) {
-        QString key = m_rowToKey.value(row);
-        if (!key.isEmpty()) {
-            m_keyToRows[key].removeAll(row);
-            if (m_keyToRows[key].isEmpty()) m_keyToRows.remove(key);
-            m_rowToKey.remove(row);
-        }
-        
+        QString key = getCompositeKeyForRow(row);
+        if (!key.isEmpty()) removeStringKey(key, row);
+
         // Remove Int Key
-        int64_t intKey = m_rowToIntKey.value(row, 0);
-        if (intKey != 0) {
-            m_intKeyToRows[intKey].removeAll(row);
-            if (m_intKeyToRows[intKey].isEmpty()) m_intKeyToRows.remove(intKey);
-            m_rowToIntKey.remove(row);
-        }
+        int64_t intKey = getIntKeyForRow(row);
+        if (intKey != kEmptyKey) removeIntRow(intKey, row);
     }
-    updateRowIndices(firstRow + count, -count);
+
+    // Close the gap in the reverse maps
+    auto closeGap = [firstRow, count](auto& rowMap) {
+        if (static_cast<size_t>(firstRow) >= rowMap.size()) return;
+        const size_t last = std::min(rowMap.size(), static_cast<size_t>(firstRow) + count);
+        rowMap.erase(rowMap.begin() + firstRow, rowMap.begin() + last);
+    };
+    closeGap(m_rowToKey);
+    closeGap(m_rowToIntKey);
+    updateRowIndices(firstRow, -count);
 }
 
 QList<int> TokenAddressBook::getRowsForToken(int token) const
 {
-    return m_keyToRows.value(QString::number(token));
+    return toList(m_keyToRows.value(QString::number(token)));
 }
 
 QList<int> TokenAddressBook::getRowsForCompositeToken(const QString& exchange, const QString& client, int token) const
 {
-    return m_keyToRows.value(makeKey(exchange, client, token));
+    return toList(m_keyToRows.value(makeKey(exchange, client, token)));
 }
 
 int TokenAddressBook::getTokenForRow(int row) const
 {
-    QString key = m_rowToKey.value(row);
+    QString key = getCompositeKeyForRow(row);
     if (key.isEmpty()) return -1;
     // If key contains ':', it's a composite key, we extract the last part
     int lastColon = key.lastIndexOf(':');
@@ -186,7 +317,8 @@ int TokenAddressBook::getTokenForRow(int row) const
 
 QString TokenAddressBook::getCompositeKeyForRow(int row) const
 {
-    return m_rowToKey.value(row);
+    if (row < 0 || static_cast<size_t>(row) >= m_rowToKey.size()) return QString();
+    return m_rowToKey[row];
 }
 
 bool TokenAddressBook::hasToken(int token) const
@@ -201,71 +333,33 @@ bool TokenAddressBook::hasCompositeToken(const QString& exchange, const QString&
 
 void TokenAddressBook::updateRowIndices(int startRow, int delta)
 {
-    if (delta == 0) return;
-    
-    // Update String Key Maps
-    QMap<int, QString> newRowToKey;
-    QMap<QString, QList<int>> newKeyToRows;
-    
-    for (auto it = m_rowToKey.constBegin(); it != m_rowToKey.constEnd(); ++it) {
-        int row = it.key();
-        QString key = it.value();
-        if (row >= startRow) {
-            int newRow = row + delta;
-            if (newRow >= 0) newRowToKey[newRow] = key;
-        } else {
-            newRowToKey[row] = key;
-        }
-    }
-    
-    for (auto it = m_keyToRows.constBegin(); it != m_keyToRows.constEnd(); ++it) {
-        QString key = it.key();
-        QList<int> rows = it.value();
-        QList<int> newRows;
-        for (int row : rows) {
-            if (row >= startRow) {
-                int newRow = row + delta;
-                if (newRow >= 0) newRows.append(newRow);
-            } else {
-                newRows.append(row);
-            }
-        }
-        if (!newRows.isEmpty()) newKeyToRows[key] = newRows;
-    }
-    
-    m_rowToKey = newRowToKey;
-    m_keyToRows = newKeyToRows;
-    
-    // Update Int64 Key Maps
-    QMap<int, int64_t> newRowToIntKey;
-    QMap<int64_t, QList<int>> newIntKeyToRows;
-    
-    for (auto it = m_rowToIntKey.constBegin(); it != m_rowToIntKey.constEnd(); ++it) {
-        int row = it.key();
-        int64_t key = it.value();
-        if (row >= startRow) {
-            int newRow = row + delta;
-            if (newRow >= 0) newRowToIntKey[newRow] = key;
-        } else {
-            newRowToIntKey[row] = key;
-        }
-    }
-    
-    for (auto it = m_intKeyToRows.constBegin(); it != m_intKeyToRows.constEnd(); ++it) {
-        int64_t key = it.key();
-        QList<int> rows = it.value();
-        QList<int> newRows;
-        for (int row : rows) {
-            if (row >= startRow) {
-                int newRow = row + delta;
-                if (newRow >= 0) newRows.append(newRow);
-            } else {
-                newRows.append(row);
-            }
+    // The reverse maps are already spliced: every mapped row at index
+    // r >= startRow used to be r - delta. Only those rows' forward entries
+    // change, so this is O(shifted rows) rather than a rebuild of every map.
+    // Walk away from the gap so a rewritten row never collides with an
+    // old value of the same key that is still waiting to be rewritten.
+    if (delta == 0 || startRow < 0) return;
+
+    auto shiftRow = [this, delta](int row) {
+        const QString& key = m_rowToKey[row];
+        if (!key.isEmpty()) {
+            auto it = m_keyToRows.find(key);
+            if (it != m_keyToRows.end()) replaceRow(it.value(), row - delta, row);
         }
-        if (!newRows.isEmpty()) newIntKeyToRows[key] = newRows;
+    };
+    auto shiftIntRow = [this, delta](int row) {
+        const int64_t key = m_rowToIntKey[row];
+        if (key == kEmptyKey) return;
+        if (IntSlot* slot = findIntSlot(key)) replaceRow(slot->rows, row - delta, row);
+    };
+
+    const int keyRows = static_cast<int>(m_rowToKey.size());
+    const int intRows = static_cast<int>(m_rowToIntKey.size());
+    if (delta > 0) {
+        for (int row = keyRows - 1; row >= startRow; --row) shiftRow(row);
+        for (int row = intRows - 1; row >= startRow; --row) shiftIntRow(row);
+    } else {
+        for (int row = startRow; row < keyRows; ++row) shiftRow(row);
+        for (int row = startRow; row < intRows; ++row) shiftIntRow(row);
     }
-    
-    m_rowToIntKey = newRowToIntKey;
-    m_intKeyToRows = newIntKeyToRows;
 }
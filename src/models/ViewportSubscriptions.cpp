@@ -0,0 +1,53 @@
+#include "models/domain/ViewportSubscriptions.h"
+#include <algorithm>
+
+ViewportSubscriptions::ViewportSubscriptions(int prefetchRows)
+    : m_prefetchRows(std::max(0, prefetchRows))
+{
+}
+
+void ViewportSubscriptions::setPrefetchRows(int rows)
+{
+    m_prefetchRows = std::max(0, rows);
+}
+
+std::pair<int, int> ViewportSubscriptions::liveRange(int firstVisible, int lastVisible,
+                                                     int rowCount) const
+{
+    if (rowCount <= 0) return {0, -1};
+
+    int first = std::clamp(firstVisible, 0, rowCount - 1);
+    int last = first;
+    if (firstVisible >= 0) {
+        last = lastVisible < 0 ? rowCount - 1 : std::clamp(lastVisible, first, rowCount - 1);
+    }
+
+    const int from = std::max(0, first - m_prefetchRows);
+    const int to = static_cast<int>(
+        std::min<int64_t>(rowCount - 1, static_cast<int64_t>(last) + m_prefetchRows));
+    return {from, to};
+}
+
+ViewportSubscriptions::Delta ViewportSubscriptions::update(const std::vector<int64_t>& keys)
+{
+    Delta delta;
+    std::unordered_set<int64_t> next;
+    next.reserve(keys.size());
+    for (int64_t key : keys) {
+        if (key == 0 || !next.insert(key).second) continue;
+        if (!m_live.count(key)) delta.added.push_back(key);
+    }
+    for (int64_t key : m_live) {
+        if (!next.count(key)) delta.removed.push_back(key);
+    }
+    m_live.swap(next);
+    return delta;
+}
+
+ViewportSubscriptions::Delta ViewportSubscriptions::clear()
+{
+    Delta delta;
+    delta.removed.assign(m_live.begin(), m_live.end());
+    m_live.clear();
+    return delta;
+}
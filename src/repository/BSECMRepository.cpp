@@ -1,5 +1,7 @@
 #include "repository/BSECMRepository.h"
+#include "repository/MasterDelta.h"
 #include "repository/MasterFileParser.h"
+#include "repository/ParallelMasterParser.h"
 #include <QDebug>
 #include <QFile>
 #include <QTextStream>
@@ -68,56 +70,48 @@ bool BSECMRepository::loadMasterFile(const QString &filename) {
 bool BSECMRepository::loadProcessedCSV(const QString &filename) {
   QWriteLocker locker(&m_mutex);
 
-  QFile file(filename);
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+  ParallelMasterParser parser;
+  if (!parser.open(filename)) {
     return false;
   }
 
-  prepareForLoad();
-  MasterContract contract;
-  QTextStream in(&file);
-  QString header = in.readLine(); // Skip header
-
-  int lineCount = 0;
-  while (!in.atEnd()) {
-    QString qLine = in.readLine();
-    lineCount++;
-    if (lineCount % 1000 == 0)
-      qDebug() << "[BSECM] Loaded lines:" << lineCount;
-
-    // Optimized split without QStringList
-    QVector<QStringRef> fields;
-    int start = 0;
-    int end = 0;
-    while ((end = qLine.indexOf(',', start)) != -1) {
-      fields.append(qLine.midRef(start, end - start));
-      start = end + 1;
-    }
-    fields.append(qLine.midRef(start));
-
-    if (fields.size() < 11)
-      continue;
-
-    contract.exchange = "BSECM";
-    contract.exchangeInstrumentID = fields[0].toLongLong();
-    contract.name = trimQuotes(fields[1]);
-    contract.displayName = trimQuotes(fields[2]);
-    contract.description = trimQuotes(fields[3]);
-    contract.series = trimQuotes(fields[4]);
-    contract.lotSize = fields[5].toInt();
-    contract.tickSize = fields[6].toDouble();
-    contract.priceBandHigh = fields[7].toDouble();
-    contract.priceBandLow = fields[8].toDouble();
-    contract.instrumentType = fields[fields.size() - 1].toInt();
+  using P = ParallelMasterParser;
+  P::Pools pools;
+  const QString exchange = QStringLiteral("BSECM");
+  const auto chunks = parser.parseLines<MasterContract>(
+      [&pools, &exchange](std::string_view line,
+                          std::vector<MasterContract> &out) {
+        std::string_view fields[32];
+        const int count = P::splitFields(line, ',', fields, 32);
+        if (count < 11)
+          return;
+
+        MasterContract contract;
+        contract.exchange = exchange;
+        contract.exchangeInstrumentID = P::int64Field(fields[0]);
+        contract.name = P::internedText(fields[1], pools);
+        contract.displayName = P::text(fields[2]);
+        contract.description = P::text(fields[3]);
+        contract.series = P::internedText(fields[4], pools);
+        contract.lotSize = P::int32Field(fields[5]);
+        contract.tickSize = P::doubleField(fields[6]);
+        contract.priceBandHigh = P::doubleField(fields[7]);
+        contract.priceBandLow = P::doubleField(fields[8]);
+        contract.instrumentType = P::int32Field(fields[count - 1]);
+        out.push_back(std::move(contract));
+      },
+      1); // Skip header
 
-    addContractInternal(contract, [](const QString &s) { return s; });
+  prepareForLoad();
+  for (const auto &chunk : chunks) {
+    for (const MasterContract &contract : chunk)
+      addContractInternal(contract, [](const QString &s) { return s; });
   }
-
-  file.close();
   finalizeLoad();
 
   qDebug() << "BSE CM Repository loaded from CSV:" << filename
-           << m_contractCount << "contracts";
+           << m_contractCount << "contracts,"
+           << parser.lastStats().megabytesPerSecond() << "MB/s";
   return m_loaded;
 }
 
@@ -483,6 +477,40 @@ void BSECMRepository::addContractInternal(
   m_contractCount++;
 }
 
+void BSECMRepository::removeContractInternal(int64_t token) {
+  auto it = m_tokenToIndex.find(token);
+  if (it == m_tokenToIndex.end()) {
+    return;
+  }
+  const int32_t idx = it.value();
+  m_tokenToIndex.erase(it);
+
+  MasterDelta::swapRemove(idx, m_token, m_name, m_displayName, m_description,
+                          m_series, m_lotSize, m_tickSize, m_priceBandHigh,
+                          m_priceBandLow, m_ltp, m_open, m_high, m_low,
+                          m_close, m_prevClose, m_volume);
+  m_contractCount--;
+  if (idx < m_contractCount) {
+    m_tokenToIndex[m_token[idx]] = idx;
+  }
+}
+
+void BSECMRepository::applyDelta(const QVector<MasterContract> &upserts,
+                                 const QVector<int64_t> &removed) {
+  QWriteLocker locker(&m_mutex);
+  for (int64_t token : removed) {
+    removeContractInternal(token);
+  }
+  for (const MasterContract &contract : upserts) {
+    removeContractInternal(contract.exchangeInstrumentID);
+    addContractInternal(contract, [](const QString &s) { return s; });
+  }
+
+  m_symbolsCached = false;
+  m_cachedUniqueSymbols.clear();
+  finalizeLoad();
+}
+
 void BSECMRepository::forEachContract(
     std::function<void(const ContractData &)> callback) const {
   QReadLocker locker(&m_mutex);
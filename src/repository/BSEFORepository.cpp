@@ -1,5 +1,7 @@
 #include "repository/BSEFORepository.h"
+#include "repository/MasterDelta.h"
 #include "repository/MasterFileParser.h"
+#include "repository/ParallelMasterParser.h"
 #include "utils/DateUtils.h"
 #include <QDebug>
 #include <QFile>
@@ -67,95 +69,89 @@ bool BSEFORepository::loadMasterFile(const QString &filename) {
 bool BSEFORepository::loadProcessedCSV(const QString &filename) {
   QWriteLocker locker(&m_mutex);
 
-  QFile file(filename);
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+  ParallelMasterParser parser;
+  if (!parser.open(filename)) {
     return false;
   }
 
-  prepareForLoad();
-  MasterContract contract;
-  QTextStream in(&file);
-  QString header = in.readLine(); // Skip header
-
-  int lineCount = 0;
-  while (!in.atEnd()) {
-    QString qLine = in.readLine();
-    lineCount++;
-    if (lineCount % 1000 == 0)
-      qDebug() << "[BSEFO] Loaded lines:" << lineCount;
-
-    // Optimized split without QStringList
-    QVector<QStringRef> fields;
-    int start = 0;
-    int end = 0;
-    while ((end = qLine.indexOf(',', start)) != -1) {
-      fields.append(qLine.midRef(start, end - start));
-      start = end + 1;
-    }
-    fields.append(qLine.midRef(start));
-
-    if (fields.size() < 16)
-      continue;
-
-    contract.exchange = "BSEFO";
-    contract.exchangeInstrumentID = fields[0].toLongLong();
-    contract.name = trimQuotes(fields[1]);
-    contract.displayName = trimQuotes(fields[2]);
-    contract.description = trimQuotes(fields[3]);
-    contract.series = trimQuotes(fields[4]);
-    contract.lotSize = fields[5].toInt();
-    contract.tickSize = fields[6].toDouble();
-
-    // ✅ Parse expiry date to DDMMMYYYY format + QDate
-    QString rawExpiryDate = trimQuotes(fields[7]);
-    QString parsedDate;
-    QDate parsedQDate;
-    double timeToExpiry;
-
-    if (DateUtils::parseExpiryDate(rawExpiryDate, parsedDate, parsedQDate,
-                                   timeToExpiry)) {
-      contract.expiryDate = parsedDate;     // DDMMMYYYY format
-      contract.expiryDate_dt = parsedQDate; // QDate for sorting
-      contract.timeToExpiry = timeToExpiry; // For Greeks calculation
-    } else {
-      // Parsing failed - use raw value as fallback
-      contract.expiryDate = rawExpiryDate;
-      contract.expiryDate_dt = QDate();
-      contract.timeToExpiry = 0.0;
-    }
-
-    contract.strikePrice = fields[8].toDouble();
-    contract.instrumentType = fields[fields.size() - 1].toInt();
-
-    // Read OptionType from field 9 (CE/PE/FUT/SPD)
-    QString optionTypeStr = trimQuotes(fields[9]);
-    if (optionTypeStr == "CE") {
-      contract.optionType = 3; // CE
-    } else if (optionTypeStr == "PE") {
-      contract.optionType = 4; // PE
-    } else if (optionTypeStr == "FUT") {
-      contract.optionType = 0; // Future
-    } else if (optionTypeStr == "SPD") {
-      contract.optionType = 0; // Spread
-    } else {
-      contract.optionType = 0;
-    }
-
-    if (contract.instrumentType == 2 && contract.optionType == 0) {
-      qWarning()
-          << "[BSEFORepo] Detected corrupted CSV. Forcing reload from master.";
-      file.close();
-      return false;
+  using P = ParallelMasterParser;
+  P::Pools pools;
+  const QString exchange = QStringLiteral("BSEFO");
+  const auto chunks = parser.parseLines<MasterContract>(
+      [&pools, &exchange](std::string_view line,
+                          std::vector<MasterContract> &out) {
+        std::string_view fields[32];
+        const int count = P::splitFields(line, ',', fields, 32);
+        if (count < 16)
+          return;
+
+        MasterContract contract;
+        contract.exchange = exchange;
+        contract.exchangeInstrumentID = P::int64Field(fields[0]);
+        contract.name = P::internedText(fields[1], pools);
+        contract.displayName = P::text(fields[2]);
+        contract.description = P::text(fields[3]);
+        contract.series = P::internedText(fields[4], pools);
+        contract.lotSize = P::int32Field(fields[5]);
+        contract.tickSize = P::doubleField(fields[6]);
+
+        // ✅ Parse expiry date to DDMMMYYYY format + QDate, once per
+        // distinct expiry
+        const std::string_view rawExpiry = P::trimField(fields[7]);
+        const P::Expiry expiry = pools.expiries.intern(
+            rawExpiry, [](std::string_view raw) {
+              P::Expiry parsed;
+              const QString rawText =
+                  QString::fromUtf8(raw.data(), static_cast<int>(raw.size()));
+              if (!DateUtils::parseExpiryDate(rawText, parsed.text, parsed.date,
+                                              parsed.timeToExpiry)) {
+                // Parsing failed - use raw value as fallback
+                parsed.text = rawText;
+                parsed.date = QDate();
+                parsed.timeToExpiry = 0.0;
+              }
+              return parsed;
+            });
+        contract.expiryDate = expiry.text;
+        contract.expiryDate_dt = expiry.date;
+        contract.timeToExpiry = expiry.timeToExpiry;
+
+        contract.strikePrice = P::doubleField(fields[8]);
+        contract.instrumentType = P::int32Field(fields[count - 1]);
+
+        // Read OptionType from field 9 (CE/PE/FUT/SPD)
+        const std::string_view optionType = P::trimField(fields[9]);
+        if (optionType == "CE") {
+          contract.optionType = 3; // CE
+        } else if (optionType == "PE") {
+          contract.optionType = 4; // PE
+        } else {
+          contract.optionType = 0; // FUT / SPD / unknown
+        }
+        out.push_back(std::move(contract));
+      },
+      1); // Skip header
+
+  for (const auto &chunk : chunks) {
+    for (const MasterContract &contract : chunk) {
+      if (contract.instrumentType == 2 && contract.optionType == 0) {
+        qWarning()
+            << "[BSEFORepo] Detected corrupted CSV. Forcing reload from master.";
+        return false;
+      }
     }
-
-    addContractInternal(contract, [](const QString &s) { return s; });
   }
 
-  file.close();
+  prepareForLoad();
+  for (const auto &chunk : chunks) {
+    for (const MasterContract &contract : chunk)
+      addContractInternal(contract, [](const QString &s) { return s; });
+  }
   finalizeLoad();
 
   qDebug() << "BSE FO Repository loaded from CSV:" << filename
-           << m_contractCount << "contracts";
+           << m_contractCount << "contracts,"
+           << parser.lastStats().megabytesPerSecond() << "MB/s";
   return m_loaded;
 }
 
@@ -607,6 +603,12 @@ void BSEFORepository::prepareForLoad() {
   m_bidPrice.clear();
   m_askPrice.clear();
 
+  m_iv.clear();
+  m_delta.clear();
+  m_gamma.clear();
+  m_vega.clear();
+  m_theta.clear();
+
   // Invalidate cached symbols (lazy cache)
   m_symbolsCached = false;
   m_cachedUniqueSymbols.clear();
@@ -680,6 +682,43 @@ void BSEFORepository::addContractInternal(
   m_contractCount++;
 }
 
+void BSEFORepository::removeContractInternal(int64_t token) {
+  auto it = m_tokenToIndex.find(token);
+  if (it == m_tokenToIndex.end()) {
+    return;
+  }
+  const int32_t idx = it.value();
+  m_tokenToIndex.erase(it);
+
+  MasterDelta::swapRemove(idx, m_token, m_name, m_displayName, m_description,
+                          m_series, m_lotSize, m_tickSize, m_expiryDate,
+                          m_strikePrice, m_optionType, m_assetToken,
+                          m_instrumentType, m_priceBandHigh, m_priceBandLow,
+                          m_freezeQty, m_ltp, m_open, m_high, m_low, m_close,
+                          m_prevClose, m_volume, m_bidPrice, m_askPrice, m_iv,
+                          m_delta, m_gamma, m_vega, m_theta);
+  m_contractCount--;
+  if (idx < m_contractCount) {
+    m_tokenToIndex[m_token[idx]] = idx;
+  }
+}
+
+void BSEFORepository::applyDelta(const QVector<MasterContract> &upserts,
+                                 const QVector<int64_t> &removed) {
+  QWriteLocker locker(&m_mutex);
+  for (int64_t token : removed) {
+    removeContractInternal(token);
+  }
+  for (const MasterContract &contract : upserts) {
+    removeContractInternal(contract.exchangeInstrumentID);
+    addContractInternal(contract, [](const QString &s) { return s; });
+  }
+
+  m_symbolsCached = false;
+  m_cachedUniqueSymbols.clear();
+  finalizeLoad();
+}
+
 void BSEFORepository::forEachContract(
     std::function<void(const ContractData &)> callback) const {
   QReadLocker locker(&m_mutex);
@@ -0,0 +1,256 @@
+#include "repository/ContractCatalog.h"
+#include <QDate>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const char *const kMonths[] = {"JAN", "FEB", "MAR", "APR", "MAY", "JUN",
+                               "JUL", "AUG", "SEP", "OCT", "NOV", "DEC"};
+
+// QDate::toJulianDay() of 1970-01-01
+constexpr qint64 kEpochJulianDay = 2440588;
+
+int digitsValue(QStringView text) {
+  int value = 0;
+  for (QChar c : text) {
+    if (!c.isDigit())
+      return -1;
+    value = value * 10 + c.digitValue();
+  }
+  return value;
+}
+
+} // namespace
+
+// ===== KEYS =====
+
+int64_t ContractCatalog::strikeTicks(double strike) {
+  return std::llround(strike * kStrikeTicksPerUnit);
+}
+
+ContractCatalog::ExpiryId ContractCatalog::expiryId(QStringView expiry) {
+  // [D]DMMM(YYYY|YY)
+  const int length = expiry.size();
+  int dayDigits = 0;
+  while (dayDigits < length && dayDigits < 2 && expiry[dayDigits].isDigit())
+    ++dayDigits;
+  const int yearDigits = length - dayDigits - 3;
+  if (dayDigits == 0 || (yearDigits != 4 && yearDigits != 2))
+    return kNoExpiry;
+
+  const int day = digitsValue(expiry.left(dayDigits));
+  int year = digitsValue(expiry.right(yearDigits));
+  if (day < 0 || year < 0)
+    return kNoExpiry;
+  if (yearDigits == 2)
+    year += 2000;
+
+  int month = 0;
+  for (int m = 0; m < 12 && month == 0; ++m) {
+    bool same = true;
+    for (int i = 0; i < 3 && same; ++i)
+      same = expiry[dayDigits + i].toUpper() == QLatin1Char(kMonths[m][i]);
+    if (same)
+      month = m + 1;
+  }
+  if (month == 0)
+    return kNoExpiry;
+
+  const QDate date(year, month, day);
+  if (!date.isValid())
+    return kNoExpiry;
+  return static_cast<ExpiryId>(date.toJulianDay() - kEpochJulianDay);
+}
+
+QString ContractCatalog::expiryText(ExpiryId expiry) {
+  const QDate date = QDate::fromJulianDay(expiry + kEpochJulianDay);
+  if (expiry == kNoExpiry || !date.isValid())
+    return QString();
+  return QString::number(date.day()).rightJustified(2, '0') +
+         QLatin1String(kMonths[date.month() - 1]) +
+         QString::number(date.year());
+}
+
+// ===== BUILD =====
+
+ContractCatalog::SymbolId ContractCatalog::internSymbol(const QString &symbol) {
+  auto it = m_symbolIds.find(symbol);
+  if (it == m_symbolIds.end()) {
+    it = m_symbolIds.insert(symbol, m_symbols.size());
+    m_symbols.append(symbol);
+  }
+  return it.value();
+}
+
+void ContractCatalog::addOption(const QString &symbol, const QString &expiry,
+                                double strike, bool isCall, int64_t token) {
+  const ExpiryId expiryDay = expiryId(expiry);
+  if (expiryDay == kNoExpiry || symbol.isEmpty())
+    return;
+  const SymbolId id = internSymbol(symbol);
+  m_optionRows.push_back(
+      {chainKey(id, expiryDay), strikeTicks(strike), strike, token, isCall});
+}
+
+void ContractCatalog::addFuture(const QString &symbol, const QString &expiry,
+                                int64_t token) {
+  const ExpiryId expiryDay = expiryId(expiry);
+  if (expiryDay == kNoExpiry || symbol.isEmpty())
+    return;
+  m_futureRows.push_back({chainKey(internSymbol(symbol), expiryDay), token});
+}
+
+void ContractCatalog::addListing(const QString &symbol,
+                                 const QString &expiry) {
+  const ExpiryId expiryDay = expiryId(expiry);
+  if (expiryDay == kNoExpiry || symbol.isEmpty())
+    return;
+  m_listings.append((uint64_t(uint32_t(expiryDay)) << 32) |
+                    uint32_t(internSymbol(symbol)));
+}
+
+void ContractCatalog::finalize() {
+  // Rows in chain order, then strike order; stable so that for a duplicated
+  // strike the last CE / PE added wins and for a future the first
+  std::stable_sort(m_optionRows.begin(), m_optionRows.end(),
+                   [](const OptionRow &a, const OptionRow &b) {
+                     return a.chainKey != b.chainKey ? a.chainKey < b.chainKey
+                                                     : a.ticks < b.ticks;
+                   });
+  std::stable_sort(m_futureRows.begin(), m_futureRows.end(),
+                   [](const auto &a, const auto &b) { return a.first < b.first; });
+
+  m_chains.clear();
+  m_chainKeys.clear();
+  auto chainFor = [this](uint64_t key) -> Chain & {
+    if (m_chainKeys.isEmpty() || m_chainKeys.last() != key) {
+      Chain chain;
+      chain.symbol = static_cast<SymbolId>(key >> 32);
+      chain.expiry = static_cast<ExpiryId>(key & 0xffffffffu);
+      m_chains.append(chain);
+      m_chainKeys.append(key);
+    }
+    return m_chains.last();
+  };
+
+  // Merge the two sorted row lists into chains
+  size_t option = 0, future = 0;
+  while (option < m_optionRows.size() || future < m_futureRows.size()) {
+    const uint64_t optionKey =
+        option < m_optionRows.size() ? m_optionRows[option].chainKey : UINT64_MAX;
+    const uint64_t futureKey =
+        future < m_futureRows.size() ? m_futureRows[future].first : UINT64_MAX;
+    const uint64_t key = std::min(optionKey, futureKey);
+    Chain &chain = chainFor(key);
+
+    if (futureKey == key) {
+      chain.futureToken = m_futureRows[future].second;
+      while (future < m_futureRows.size() && m_futureRows[future].first == key)
+        ++future;
+    }
+
+    while (option < m_optionRows.size() && m_optionRows[option].chainKey == key) {
+      const OptionRow &row = m_optionRows[option++];
+      if (chain.strikeTicks.isEmpty() || chain.strikeTicks.last() != row.ticks) {
+        chain.strikes.append(row.strike);
+        chain.strikeTicks.append(row.ticks);
+        chain.callTokens.append(0);
+        chain.putTokens.append(0);
+      }
+      (row.isCall ? chain.callTokens.last() : chain.putTokens.last()) = row.token;
+    }
+  }
+
+  // Every option chain lists its symbol under its expiry
+  for (const Chain &chain : m_chains) {
+    if (!chain.strikes.isEmpty())
+      m_listings.append((uint64_t(uint32_t(chain.expiry)) << 32) |
+                        uint32_t(chain.symbol));
+  }
+  std::sort(m_listings.begin(), m_listings.end());
+  m_listings.erase(std::unique(m_listings.begin(), m_listings.end()),
+                   m_listings.end());
+
+  for (Chain &chain : m_chains) {
+    chain.strikes.squeeze();
+    chain.strikeTicks.squeeze();
+    chain.callTokens.squeeze();
+    chain.putTokens.squeeze();
+  }
+  std::vector<OptionRow>().swap(m_optionRows);
+  std::vector<std::pair<uint64_t, int64_t>>().swap(m_futureRows);
+}
+
+// ===== LOOKUP =====
+
+int ContractCatalog::Chain::indexOfStrike(double strike) const {
+  const int64_t ticks = ContractCatalog::strikeTicks(strike);
+  auto it = std::lower_bound(strikeTicks.begin(), strikeTicks.end(), ticks);
+  return it != strikeTicks.end() && *it == ticks
+             ? static_cast<int>(it - strikeTicks.begin())
+             : -1;
+}
+
+int ContractCatalog::Chain::atmIndex(double price) const {
+  if (strikes.isEmpty())
+    return -1;
+  auto it = std::lower_bound(strikes.begin(), strikes.end(), price);
+  if (it == strikes.end())
+    return strikes.size() - 1;
+  if (it == strikes.begin())
+    return 0;
+  const int higher = static_cast<int>(it - strikes.begin());
+  return (strikes[higher] - price) < (price - strikes[higher - 1]) ? higher
+                                                                   : higher - 1;
+}
+
+ContractCatalog::SymbolId
+ContractCatalog::symbolId(const QString &symbol) const {
+  return m_symbolIds.value(symbol, kNoSymbol);
+}
+
+QString ContractCatalog::symbolName(SymbolId symbol) const {
+  return symbol >= 0 && symbol < m_symbols.size() ? m_symbols[symbol]
+                                                  : QString();
+}
+
+const ContractCatalog::Chain *ContractCatalog::chain(SymbolId symbol,
+                                                     ExpiryId expiry) const {
+  if (symbol == kNoSymbol || expiry == kNoExpiry)
+    return nullptr;
+  const uint64_t key = chainKey(symbol, expiry);
+  auto it = std::lower_bound(m_chainKeys.begin(), m_chainKeys.end(), key);
+  if (it == m_chainKeys.end() || *it != key)
+    return nullptr;
+  return &m_chains[static_cast<int>(it - m_chainKeys.begin())];
+}
+
+const ContractCatalog::Chain *
+ContractCatalog::chain(const QString &symbol, const QString &expiry) const {
+  return chain(symbolId(symbol), expiryId(expiry));
+}
+
+QVector<ContractCatalog::ExpiryId>
+ContractCatalog::expiries(SymbolId symbol) const {
+  QVector<ExpiryId> result;
+  if (symbol == kNoSymbol)
+    return result;
+  auto it = std::lower_bound(m_chainKeys.begin(), m_chainKeys.end(),
+                             chainKey(symbol, 0));
+  for (; it != m_chainKeys.end() && SymbolId(*it >> 32) == symbol; ++it)
+    result.append(static_cast<ExpiryId>(*it & 0xffffffffu));
+  return result;
+}
+
+QVector<QString> ContractCatalog::symbolsForExpiry(ExpiryId expiry) const {
+  QVector<QString> result;
+  if (expiry == kNoExpiry)
+    return result;
+  const uint64_t first = uint64_t(uint32_t(expiry)) << 32;
+  auto it = std::lower_bound(m_listings.begin(), m_listings.end(), first);
+  for (; it != m_listings.end() && (*it >> 32) == uint32_t(expiry); ++it)
+    result.append(m_symbols[static_cast<int>(*it & 0xffffffffu)]);
+  std::sort(result.begin(), result.end());
+  return result;
+}
@@ -0,0 +1,430 @@
+#include "repository/ContractSnapshot.h"
+#include <QDate>
+#include <QDateTime>
+#include <QDebug>
+#include <QSaveFile>
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace {
+
+int segmentSlot(int segment) {
+  for (int i = 0; i < ContractSnapshot::kSegmentCount; ++i) {
+    if (ContractSnapshot::kSegments[i] == segment)
+      return i;
+  }
+  return -1;
+}
+
+const char *segmentName(int segment) {
+  switch (segment) {
+  case 1:
+    return "NSECM";
+  case 2:
+    return "NSEFO";
+  case 11:
+    return "BSECM";
+  case 12:
+    return "BSEFO";
+  }
+  return "";
+}
+
+uint64_t align8(uint64_t offset) { return (offset + 7) & ~uint64_t(7); }
+
+bool fail(QString *error, const QString &reason) {
+  if (error)
+    *error = reason;
+  return false;
+}
+
+} // namespace
+
+// ===== READER =====
+
+ContractSnapshot::~ContractSnapshot() { close(); }
+
+bool ContractSnapshot::open(const QString &path, QString *error) {
+  close();
+
+  m_file.setFileName(path);
+  if (!m_file.open(QIODevice::ReadOnly))
+    return fail(error, "cannot open " + path);
+
+  const qint64 size = m_file.size();
+  if (size < static_cast<qint64>(sizeof(Header))) {
+    close();
+    return fail(error, "truncated header");
+  }
+
+  m_data = m_file.map(0, size);
+  if (!m_data) {
+    close();
+    return fail(error, "mmap failed: " + m_file.errorString());
+  }
+
+  const Header *header = reinterpret_cast<const Header *>(m_data);
+  if (header->magic != kMagic) {
+    close();
+    return fail(error, "not a contract snapshot");
+  }
+  if (header->version != kVersion || header->recordSize != sizeof(Record)) {
+    const uint32_t version = header->version;
+    close();
+    return fail(error, QString("version %1, expected %2").arg(version).arg(kVersion));
+  }
+
+  // Every section must lie inside the file
+  const uint64_t fileSize = static_cast<uint64_t>(size);
+  const uint64_t records = uint64_t(header->recordCount);
+  const uint64_t strings = uint64_t(header->stringCount);
+  if (header->fileSize != fileSize ||
+      header->recordsOffset + records * sizeof(Record) > fileSize ||
+      header->orderOffset + records * sizeof(uint32_t) > fileSize ||
+      header->stringOffsetsOffset + (strings + 1) * sizeof(uint32_t) > fileSize ||
+      header->stringDataOffset > fileSize) {
+    close();
+    return fail(error, "truncated or corrupt sections");
+  }
+  for (const SegmentRange &range : header->segments) {
+    if (uint64_t(range.first) + range.count > records) {
+      close();
+      return fail(error, "corrupt segment table");
+    }
+  }
+
+  const uint32_t *offsets =
+      reinterpret_cast<const uint32_t *>(m_data + header->stringOffsetsOffset);
+  if (header->stringDataOffset + uint64_t(offsets[strings]) * sizeof(char16_t) >
+      fileSize) {
+    close();
+    return fail(error, "truncated string table");
+  }
+  // string() and orderedTokens() index with these unchecked
+  for (uint64_t i = 0; i < strings; ++i) {
+    if (offsets[i] > offsets[i + 1]) {
+      close();
+      return fail(error, "corrupt string offsets");
+    }
+  }
+  const uint32_t *order =
+      reinterpret_cast<const uint32_t *>(m_data + header->orderOffset);
+  for (uint64_t i = 0; i < records; ++i) {
+    if (order[i] >= records) {
+      close();
+      return fail(error, "corrupt order table");
+    }
+  }
+
+  m_header = header;
+  m_records = reinterpret_cast<const Record *>(m_data + header->recordsOffset);
+  m_order = order;
+  m_stringOffsets = offsets;
+  m_stringData = reinterpret_cast<const char16_t *>(m_data + header->stringDataOffset);
+  m_strings.resize(static_cast<int>(strings));
+  m_stringReady.assign(strings, 0);
+  return true;
+}
+
+void ContractSnapshot::close() {
+  if (m_data)
+    m_file.unmap(const_cast<uchar *>(m_data));
+  if (m_file.isOpen())
+    m_file.close();
+  m_data = nullptr;
+  m_header = nullptr;
+  m_records = nullptr;
+  m_order = nullptr;
+  m_stringOffsets = nullptr;
+  m_stringData = nullptr;
+  m_strings.clear();
+  m_stringReady.clear();
+}
+
+const ContractSnapshot::Record *ContractSnapshot::segmentRecords(int segment,
+                                                                 uint32_t *count) const {
+  const int slot = segmentSlot(segment);
+  if (!m_header || slot < 0) {
+    *count = 0;
+    return nullptr;
+  }
+  const SegmentRange &range = m_header->segments[slot];
+  *count = range.count;
+  return m_records + range.first;
+}
+
+const ContractSnapshot::Record *ContractSnapshot::find(int segment,
+                                                       int64_t token) const {
+  uint32_t count = 0;
+  const Record *begin = segmentRecords(segment, &count);
+  const Record *end = begin + count;
+  const Record *it = std::lower_bound(
+      begin, end, token,
+      [](const Record &record, int64_t value) { return record.token < value; });
+  return (it != end && it->token == token) ? it : nullptr;
+}
+
+QVector<int64_t> ContractSnapshot::orderedTokens(int segment) const {
+  QVector<int64_t> tokens;
+  const int slot = segmentSlot(segment);
+  if (!m_header || slot < 0)
+    return tokens;
+
+  const SegmentRange &range = m_header->segments[slot];
+  tokens.reserve(static_cast<int>(range.count));
+  for (uint32_t i = 0; i < range.count; ++i)
+    tokens.append(m_records[m_order[range.first + i]].token);
+  return tokens;
+}
+
+QString ContractSnapshot::string(uint32_t id) const {
+  if (!m_header || id >= m_header->stringCount)
+    return QString();
+
+  if (!m_stringReady[id]) {
+    const uint32_t begin = m_stringOffsets[id];
+    const uint32_t end = m_stringOffsets[id + 1];
+    m_strings[static_cast<int>(id)] =
+        QString(reinterpret_cast<const QChar *>(m_stringData + begin),
+                static_cast<int>(end - begin));
+    m_stringReady[id] = 1;
+  }
+  return m_strings[static_cast<int>(id)];
+}
+
+ContractData ContractSnapshot::toContractData(const Record &record) const {
+  ContractData data;
+  data.exchangeInstrumentID = record.token;
+  data.name = string(record.name);
+  data.displayName = string(record.displayName);
+  data.description = string(record.description);
+  data.series = string(record.series);
+  data.lotSize = record.lotSize;
+  data.freezeQty = record.freezeQty;
+  data.tickSize = record.tickSize;
+  data.priceBandHigh = record.priceBandHigh;
+  data.priceBandLow = record.priceBandLow;
+  data.expiryDate = string(record.expiryDate);
+  if (record.expiryJulianDay > 0)
+    data.expiryDate_dt = QDate::fromJulianDay(record.expiryJulianDay);
+  data.strikePrice = record.strikePrice;
+  data.optionType = string(record.optionType);
+  data.assetToken = record.assetToken;
+  data.instrumentType = record.instrumentType;
+  return data;
+}
+
+void ContractSnapshot::forEachContract(
+    int segment, const std::function<void(const MasterContract &)> &visitor) const {
+  uint32_t count = 0;
+  const Record *records = segmentRecords(segment, &count);
+  const QDate today = QDate::currentDate();
+
+  MasterContract contract;
+  contract.exchange = QString::fromLatin1(segmentName(segment));
+  for (uint32_t i = 0; i < count; ++i) {
+    const Record &record = records[i];
+    contract.exchangeInstrumentID = record.token;
+    contract.name = string(record.name);
+    contract.displayName = string(record.displayName);
+    contract.description = string(record.description);
+    contract.series = string(record.series);
+    contract.lotSize = record.lotSize;
+    contract.freezeQty = record.freezeQty;
+    contract.tickSize = record.tickSize;
+    contract.priceBandHigh = record.priceBandHigh;
+    contract.priceBandLow = record.priceBandLow;
+    contract.expiryDate = string(record.expiryDate);
+    contract.strikePrice = record.strikePrice;
+    contract.assetToken = record.assetToken;
+    contract.instrumentType = record.instrumentType;
+    contract.rowHash = record.rowHash;
+
+    // Same rule as MasterFileParser: (expiry - today) / 365, 0 once expired
+    contract.expiryDate_dt = record.expiryJulianDay > 0
+                                 ? QDate::fromJulianDay(record.expiryJulianDay)
+                                 : QDate();
+    contract.timeToExpiry =
+        (contract.expiryDate_dt.isValid() && contract.expiryDate_dt >= today)
+            ? today.daysTo(contract.expiryDate_dt) / 365.0
+            : 0.0;
+
+    const QString optionType = string(record.optionType);
+    contract.optionType = optionType == QLatin1String("CE")   ? 1
+                          : optionType == QLatin1String("PE") ? 2
+                                                              : 0;
+    visitor(contract);
+  }
+}
+
+int32_t ContractSnapshot::expiryToJulianDay(const QString &expiry) {
+  // DDMMMYYYY, the form every repository stores
+  if (expiry.length() != 9)
+    return 0;
+
+  static const char *kMonths[] = {"JAN", "FEB", "MAR", "APR", "MAY", "JUN",
+                                  "JUL", "AUG", "SEP", "OCT", "NOV", "DEC"};
+  const QStringRef month = expiry.midRef(2, 3);
+  int monthNum = 0;
+  for (int m = 0; m < 12 && monthNum == 0; ++m) {
+    if (month.compare(QLatin1String(kMonths[m]), Qt::CaseInsensitive) == 0)
+      monthNum = m + 1;
+  }
+  if (monthNum == 0)
+    return 0;
+
+  const QDate date(expiry.midRef(5, 4).toInt(), monthNum, expiry.leftRef(2).toInt());
+  return date.isValid() ? static_cast<int32_t>(date.toJulianDay()) : 0;
+}
+
+// ===== WRITER =====
+
+uint32_t ContractSnapshotWriter::intern(const QString &str) {
+  if (str.isEmpty())
+    return ContractSnapshot::kNoString;
+
+  auto it = m_stringIds.constFind(str);
+  if (it != m_stringIds.constEnd())
+    return it.value();
+
+  const uint32_t id = static_cast<uint32_t>(m_strings.size());
+  m_strings.append(str);
+  m_stringIds.insert(str, id);
+  return id;
+}
+
+void ContractSnapshotWriter::add(int segment, const ContractData &contract,
+                                 uint64_t rowHash) {
+  const int slot = segmentSlot(segment);
+  if (slot < 0)
+    return;
+
+  ContractSnapshot::Record record;
+  std::memset(&record, 0, sizeof(record));
+  record.token = contract.exchangeInstrumentID;
+  record.assetToken = contract.assetToken;
+  record.tickSize = contract.tickSize;
+  record.priceBandHigh = contract.priceBandHigh;
+  record.priceBandLow = contract.priceBandLow;
+  record.strikePrice = contract.strikePrice;
+  record.name = intern(contract.name);
+  record.displayName = intern(contract.displayName);
+  record.description = intern(contract.description);
+  record.series = intern(contract.series);
+  record.expiryDate = intern(contract.expiryDate);
+  record.optionType = intern(contract.optionType);
+  record.lotSize = contract.lotSize;
+  record.freezeQty = contract.freezeQty;
+  record.instrumentType = contract.instrumentType;
+  record.expiryJulianDay = ContractSnapshot::expiryToJulianDay(contract.expiryDate);
+  record.rowHash = rowHash;
+  m_records[slot].push_back(record);
+}
+
+int ContractSnapshotWriter::count() const {
+  size_t total = 0;
+  for (const auto &records : m_records)
+    total += records.size();
+  return static_cast<int>(total);
+}
+
+bool ContractSnapshotWriter::write(const QString &path, QString *error) const {
+  using Record = ContractSnapshot::Record;
+
+  ContractSnapshot::Header header;
+  std::memset(&header, 0, sizeof(header));
+  header.magic = ContractSnapshot::kMagic;
+  header.version = ContractSnapshot::kVersion;
+  header.recordSize = sizeof(Record);
+  header.stringCount = static_cast<uint32_t>(m_strings.size());
+  header.createdMsecs = QDateTime::currentMSecsSinceEpoch();
+
+  // Records: segment by segment, token-sorted; order: per segment, indices
+  // sorted for the pre-sorted repository indexes
+  std::vector<Record> records;
+  std::vector<uint32_t> order;
+  records.reserve(static_cast<size_t>(count()));
+  order.reserve(static_cast<size_t>(count()));
+
+  for (int slot = 0; slot < ContractSnapshot::kSegmentCount; ++slot) {
+    std::vector<Record> segment = m_records[slot];
+    std::sort(segment.begin(), segment.end(),
+              [](const Record &a, const Record &b) { return a.token < b.token; });
+    segment.erase(std::unique(segment.begin(), segment.end(),
+                              [](const Record &a, const Record &b) {
+                                return a.token == b.token;
+                              }),
+                  segment.end());
+
+    const uint32_t first = static_cast<uint32_t>(records.size());
+    header.segments[slot] = {ContractSnapshot::kSegments[slot], first,
+                             static_cast<uint32_t>(segment.size()), 0};
+
+    std::vector<uint32_t> segmentOrder(segment.size());
+    std::iota(segmentOrder.begin(), segmentOrder.end(), 0u);
+    const auto &strings = m_strings;
+    auto text = [&strings](uint32_t id) {
+      return id == ContractSnapshot::kNoString ? QString() : strings[static_cast<int>(id)];
+    };
+    std::stable_sort(segmentOrder.begin(), segmentOrder.end(),
+                     [&](uint32_t ia, uint32_t ib) {
+                       const Record &a = segment[ia];
+                       const Record &b = segment[ib];
+                       if (a.expiryJulianDay != b.expiryJulianDay)
+                         return a.expiryJulianDay < b.expiryJulianDay;
+                       if (a.name != b.name)
+                         return text(a.name) < text(b.name);
+                       if (a.instrumentType != b.instrumentType)
+                         return a.instrumentType < b.instrumentType;
+                       if (qAbs(a.strikePrice - b.strikePrice) > 0.001)
+                         return a.strikePrice < b.strikePrice;
+                       return text(a.optionType) < text(b.optionType);
+                     });
+    for (uint32_t index : segmentOrder)
+      order.push_back(first + index);
+    records.insert(records.end(), segment.begin(), segment.end());
+  }
+  header.recordCount = static_cast<uint32_t>(records.size());
+
+  // String table
+  std::vector<uint32_t> stringOffsets;
+  stringOffsets.reserve(m_strings.size() + 1);
+  uint32_t units = 0;
+  for (const QString &str : m_strings) {
+    stringOffsets.push_back(units);
+    units += static_cast<uint32_t>(str.size());
+  }
+  stringOffsets.push_back(units);
+
+  header.recordsOffset = align8(sizeof(header));
+  header.orderOffset = align8(header.recordsOffset + records.size() * sizeof(Record));
+  header.stringOffsetsOffset = align8(header.orderOffset + order.size() * sizeof(uint32_t));
+  header.stringDataOffset =
+      align8(header.stringOffsetsOffset + stringOffsets.size() * sizeof(uint32_t));
+  header.fileSize = header.stringDataOffset + uint64_t(units) * sizeof(char16_t);
+
+  QByteArray image(static_cast<int>(header.fileSize), '\0');
+  char *out = image.data();
+  std::memcpy(out, &header, sizeof(header));
+  std::memcpy(out + header.recordsOffset, records.data(), records.size() * sizeof(Record));
+  std::memcpy(out + header.orderOffset, order.data(), order.size() * sizeof(uint32_t));
+  std::memcpy(out + header.stringOffsetsOffset, stringOffsets.data(),
+              stringOffsets.size() * sizeof(uint32_t));
+  char *data = out + header.stringDataOffset;
+  for (const QString &str : m_strings) {
+    std::memcpy(data, str.utf16(), str.size() * sizeof(char16_t));
+    data += str.size() * sizeof(char16_t);
+  }
+
+  QSaveFile file(path);
+  if (!file.open(QIODevice::WriteOnly))
+    return fail(error, "cannot write " + path);
+  if (file.write(image) != image.size() || !file.commit())
+    return fail(error, "write failed: " + file.errorString());
+
+  qDebug() << "[ContractSnapshot] Wrote" << header.recordCount << "contracts,"
+           << header.stringCount << "strings," << header.fileSize / 1024 << "KB to"
+           << path;
+  return true;
+}
@@ -0,0 +1,192 @@
+#include "repository/MasterDelta.h"
+#include "repository/ParallelMasterParser.h"
+#include <QElapsedTimer>
+#include <algorithm>
+#include <memory>
+
+namespace {
+
+constexpr uint64_t kFnvOffset = 14695981039346656037ull;
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+bool keyLess(int32_t segmentA, int64_t tokenA, int32_t segmentB,
+             int64_t tokenB) {
+  return segmentA != segmentB ? segmentA < segmentB : tokenA < tokenB;
+}
+
+// One download row as seen by compute(): unchanged rows carry no contract
+struct DeltaRow {
+  int32_t segment = 0;
+  int64_t token = 0;
+  uint64_t hash = 0;
+  uint64_t previous = 0; // Hash of the loaded row, 0 = not loaded
+  std::unique_ptr<MasterContract> contract;
+};
+
+} // namespace
+
+// ===== HASHES =====
+
+uint64_t MasterDelta::hashRow(std::string_view line) {
+  uint64_t hash = kFnvOffset;
+  for (char c : line) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= kFnvPrime;
+  }
+  return hash ? hash : 1;
+}
+
+bool MasterDelta::rowKey(std::string_view line, int32_t &segment,
+                         int64_t &token) {
+  using P = ParallelMasterParser;
+  std::string_view fields[3];
+  if (P::splitFields(line, '|', fields, 3) < 2)
+    return false;
+
+  const std::string_view name = P::trimField(fields[0]);
+  segment = name == "NSECM"   ? 1
+            : name == "NSEFO" ? 2
+            : name == "BSECM" ? 11
+            : name == "BSEFO" ? 12
+                              : 0;
+  return segment != 0 && P::toInt64(fields[1], token);
+}
+
+int32_t MasterDelta::segmentId(const QString &exchange) {
+  if (exchange == QLatin1String("NSECM"))
+    return 1;
+  if (exchange == QLatin1String("NSEFO"))
+    return 2;
+  if (exchange == QLatin1String("BSECM"))
+    return 11;
+  if (exchange == QLatin1String("BSEFO"))
+    return 12;
+  return 0;
+}
+
+void MasterDelta::sortHashes(RowHashes &hashes) {
+  std::stable_sort(hashes.begin(), hashes.end(),
+                   [](const RowHash &a, const RowHash &b) {
+                     return keyLess(a.segment, a.token, b.segment, b.token);
+                   });
+
+  // Keep the last entry of each key
+  size_t out = 0;
+  for (size_t i = 0; i < hashes.size(); ++i) {
+    const bool lastOfKey = i + 1 == hashes.size() ||
+                           hashes[i + 1].segment != hashes[i].segment ||
+                           hashes[i + 1].token != hashes[i].token;
+    if (lastOfKey)
+      hashes[out++] = hashes[i];
+  }
+  hashes.resize(out);
+}
+
+uint64_t MasterDelta::findHash(const RowHashes &hashes, int32_t segment,
+                               int64_t token) {
+  auto it = std::lower_bound(hashes.begin(), hashes.end(),
+                             std::make_pair(segment, token),
+                             [](const RowHash &entry, const auto &key) {
+                               return keyLess(entry.segment, entry.token,
+                                              key.first, key.second);
+                             });
+  return it != hashes.end() && it->segment == segment && it->token == token
+             ? it->hash
+             : 0;
+}
+
+// ===== DIFF =====
+
+int MasterDelta::slot(int32_t segment) {
+  for (int i = 0; i < kSegmentCount; ++i) {
+    if (kSegments[i] == segment)
+      return i;
+  }
+  return -1;
+}
+
+void MasterDelta::compute(ParallelMasterParser &parser,
+                          const RowHashes &current) {
+  QElapsedTimer timer;
+  timer.start();
+
+  for (SegmentDelta &segment : m_segments)
+    segment = SegmentDelta();
+  m_hashes.clear();
+  m_stats = Stats();
+
+  ParallelMasterParser::Pools pools;
+  auto chunks = parser.parseLines<DeltaRow>(
+      [&pools, &current](std::string_view line, std::vector<DeltaRow> &out) {
+        DeltaRow row;
+        if (!rowKey(line, row.segment, row.token))
+          return;
+        row.hash = hashRow(line);
+        row.previous = findHash(current, row.segment, row.token);
+        if (row.hash != row.previous) {
+          auto contract = std::make_unique<MasterContract>();
+          if (!ParallelMasterParser::parseMasterLine(line, *contract, pools))
+            return;
+          contract->rowHash = row.hash;
+          row.contract = std::move(contract);
+        }
+        out.push_back(std::move(row));
+      });
+
+  // Key order, file order within a key: the last row of a key wins
+  std::vector<DeltaRow *> rows;
+  for (std::vector<DeltaRow> &chunk : chunks) {
+    for (DeltaRow &row : chunk)
+      rows.push_back(&row);
+  }
+  std::stable_sort(rows.begin(), rows.end(),
+                   [](const DeltaRow *a, const DeltaRow *b) {
+                     return keyLess(a->segment, a->token, b->segment, b->token);
+                   });
+
+  m_hashes.reserve(rows.size());
+  for (size_t i = 0; i < rows.size(); ++i) {
+    DeltaRow &row = *rows[i];
+    if (i + 1 < rows.size() && rows[i + 1]->segment == row.segment &&
+        rows[i + 1]->token == row.token)
+      continue;
+
+    m_hashes.push_back({row.segment, row.token, row.hash});
+    if (!row.contract) {
+      m_stats.unchanged++;
+      continue;
+    }
+    (row.previous ? m_stats.modified : m_stats.inserted)++;
+    m_segments[slot(row.segment)].upserts.append(std::move(*row.contract));
+  }
+  m_stats.rows = static_cast<int>(m_hashes.size());
+
+  // Loaded keys the download no longer lists
+  auto next = m_hashes.cbegin();
+  for (const RowHash &loaded : current) {
+    while (next != m_hashes.cend() &&
+           keyLess(next->segment, next->token, loaded.segment, loaded.token))
+      ++next;
+    const bool listed = next != m_hashes.cend() &&
+                        next->segment == loaded.segment &&
+                        next->token == loaded.token;
+    const int index = slot(loaded.segment);
+    if (!listed && index >= 0) {
+      m_segments[index].removed.append(loaded.token);
+      m_stats.removed++;
+    }
+  }
+
+  m_stats.elapsedUs = timer.nsecsElapsed() / 1000;
+}
+
+const MasterDelta::SegmentDelta &MasterDelta::segment(int32_t segment) const {
+  static const SegmentDelta kEmpty;
+  const int index = slot(segment);
+  return index >= 0 ? m_segments[index] : kEmpty;
+}
+
+bool MasterDelta::segmentChanged(int32_t segment) const {
+  const SegmentDelta &delta = this->segment(segment);
+  return !delta.upserts.isEmpty() || !delta.removed.isEmpty();
+}
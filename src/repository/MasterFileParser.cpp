@@ -259,11 +259,12 @@ bool MasterFileParser::parseNSEFO(const QVector<QStringRef> &fields,
 
     // Convert to DDMMMYYYY
     if (!year.isEmpty() && !month.isEmpty() && !day.isEmpty()) {
-      QStringList months = {"",    "JAN", "FEB", "MAR", "APR", "MAY", "JUN",
-                            "JUL", "AUG", "SEP", "OCT", "NOV", "DEC"};
+      static const char *const months[] = {
+          "",    "JAN", "FEB", "MAR", "APR", "MAY", "JUN",
+          "JUL", "AUG", "SEP", "OCT", "NOV", "DEC"};
       int monthNum = month.toInt();
       if (monthNum >= 1 && monthNum <= 12) {
-        contract.expiryDate = day + months[monthNum] + year;
+        contract.expiryDate = day + QLatin1String(months[monthNum]) + year;
         contract.expiryDate_dt = QDate(year.toInt(), monthNum, day.toInt());
 
         // Calculate timeToExpiry: (expiry_date - trade_date) / 365.0
@@ -493,11 +494,12 @@ bool MasterFileParser::parseBSEFO(const QVector<QStringRef> &fields,
 
     // Convert to DDMMMYYYY
     if (!year.isEmpty() && !month.isEmpty() && !day.isEmpty()) {
-      QStringList months = {"",    "JAN", "FEB", "MAR", "APR", "MAY", "JUN",
-                            "JUL", "AUG", "SEP", "OCT", "NOV", "DEC"};
+      static const char *const months[] = {
+          "",    "JAN", "FEB", "MAR", "APR", "MAY", "JUN",
+          "JUL", "AUG", "SEP", "OCT", "NOV", "DEC"};
       int monthNum = month.toInt();
       if (monthNum >= 1 && monthNum <= 12) {
-        contract.expiryDate = day + months[monthNum] + year;
+        contract.expiryDate = day + QLatin1String(months[monthNum]) + year;
         contract.expiryDate_dt = QDate(year.toInt(), monthNum, day.toInt());
 
         // Calculate timeToExpiry: (expiry_date - trade_date) / 365.0
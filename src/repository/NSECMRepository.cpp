@@ -1,5 +1,7 @@
 #include "repository/NSECMRepository.h"
+#include "repository/MasterDelta.h"
 #include "repository/MasterFileParser.h"
+#include "repository/ParallelMasterParser.h"
 #include <QCoreApplication>
 #include <QDebug>
 #include <QFile>
@@ -137,94 +139,59 @@ bool NSECMRepository::loadMasterFile(const QString &filename) {
 }
 
 bool NSECMRepository::loadProcessedCSV(const QString &filename) {
-  // Native C++ file I/O (10x faster than QFile/QTextStream)
-  std::ifstream file(filename.toStdString(), std::ios::binary);
-  if (!file.is_open()) {
+  // Memory-mapped, parsed on several threads (see ParallelMasterParser)
+  ParallelMasterParser parser;
+  if (!parser.open(filename)) {
     std::cerr << "Failed to open NSECM CSV file: " << filename.toStdString()
               << std::endl;
     return false;
   }
 
+  using P = ParallelMasterParser;
+  P::Pools pools;
+  const QString exchange = QStringLiteral("NSECM");
+  const auto chunks = parser.parseLines<MasterContract>(
+      [&pools, &exchange](std::string_view line,
+                          std::vector<MasterContract> &out) {
+        std::string_view fields[32];
+        const int count = P::splitFields(line, ',', fields, 32);
+        if (count < 17) {
+          return;
+        }
+
+        MasterContract contract;
+        if (!P::toInt64(fields[0], contract.exchangeInstrumentID)) {
+          return;
+        }
+        contract.exchange = exchange;
+        contract.name = P::internedText(fields[1], pools);
+        contract.displayName = P::text(fields[2]);
+        contract.description = P::text(fields[3]);
+        contract.series = P::internedText(fields[4], pools);
+        contract.lotSize = P::int32Field(fields[5]);
+        contract.tickSize = P::doubleField(fields[6]);
+        contract.priceBandHigh = P::doubleField(fields[8]);
+        contract.priceBandLow = P::doubleField(fields[9]);
+        contract.instrumentType = P::int32Field(fields[count - 1]);
+        out.push_back(std::move(contract));
+      },
+      1); // Skip header line
+
   {
     QWriteLocker locker(&m_mutex);
     prepareForLoad();
-  }
-
-  std::string line;
-  line.reserve(2048);
-  MasterContract contract;
-  QString qLine;
-
-  // Skip header line
-  std::getline(file, line);
-
-  int lineCount = 0;
-  while (std::getline(file, line)) {
-    lineCount++;
-
-    // Progress update every 1000 lines WITHOUT holding lock
-    if (lineCount % 1000 == 0) {
-      qDebug() << "[NSECM] Loaded lines:" << lineCount;
-      // Process events to allow UI updates and signals
-      QCoreApplication::processEvents();
-    }
-
-    if (line.empty()) {
-      continue;
-    }
-
-    qLine = QString::fromStdString(line);
-
-    // Optimized split without QStringList
-    QVector<QStringRef> fields;
-    int start = 0;
-    int end = 0;
-    while ((end = qLine.indexOf(',', start)) != -1) {
-      fields.append(qLine.midRef(start, end - start));
-      start = end + 1;
-    }
-    fields.append(qLine.midRef(start));
-
-    if (fields.size() < 17) {
-      continue;
-    }
-
-    bool ok;
-    int64_t token = fields[0].toLongLong(&ok);
-    if (!ok) {
-      continue;
-    }
-
-    contract.exchange = "NSECM";
-    contract.exchangeInstrumentID = token;
-    contract.name = trimQuotes(fields[1]);
-    contract.displayName = trimQuotes(fields[2]);
-    contract.description = trimQuotes(fields[3]);
-    contract.series = trimQuotes(fields[4]);
-    contract.lotSize = fields[5].toInt();
-    contract.tickSize = fields[6].toDouble();
-    contract.priceBandHigh = fields[8].toDouble();
-    contract.priceBandLow = fields[9].toDouble();
-    contract.instrumentType = fields[fields.size() - 1].toInt();
-
-    // Lock only for adding contract (minimal critical section)
-    {
-      QWriteLocker locker(&m_mutex);
-      addContractInternal(contract, [](const QString &s) { return s; });
+    for (const auto &chunk : chunks) {
+      for (const MasterContract &contract : chunk) {
+        addContractInternal(contract, [](const QString &s) { return s; });
+      }
     }
   }
 
-  file.close();
-
-  qDebug() << "[NSECM] CSV reading complete. Total lines processed:"
-           << lineCount;
-  qDebug() << "[NSECM] Contracts added during parsing:" << m_contractCount;
+  qDebug() << "[NSECM] CSV parsed:" << parser.lastStats().lines << "lines on"
+           << parser.lastStats().threads << "threads,"
+           << parser.lastStats().megabytesPerSecond() << "MB/s";
 
-  qDebug() << "[NSECM] Before finalizeLoad, m_contractCount ="
-           << m_contractCount;
   finalizeLoad();
-  qDebug() << "[NSECM] After finalizeLoad, m_contractCount ="
-           << m_contractCount;
 
   qDebug() << "[NSECM] Repository loaded from CSV:" << m_contractCount
            << "contracts";
@@ -644,6 +611,45 @@ void NSECMRepository::addContract(
   addContractInternal(contract, intern);
 }
 
+void NSECMRepository::removeContractInternal(int64_t token) {
+  auto it = m_tokenToIndex.find(token);
+  if (it == m_tokenToIndex.end()) {
+    return;
+  }
+  const int32_t idx = it.value();
+  m_tokenToIndex.erase(it);
+
+  MasterDelta::swapRemove(idx, m_token, m_name, m_displayName, m_description,
+                          m_series, m_lotSize, m_tickSize, m_freezeQty,
+                          m_priceBandHigh, m_priceBandLow, m_ltp, m_open,
+                          m_high, m_low, m_close, m_prevClose, m_volume,
+                          m_bidPrice, m_askPrice);
+  m_contractCount--;
+  if (idx < m_contractCount) {
+    m_tokenToIndex[m_token[idx]] = idx;
+  }
+}
+
+void NSECMRepository::applyDelta(const QVector<MasterContract> &upserts,
+                                 const QVector<int64_t> &removed) {
+  {
+    QWriteLocker locker(&m_mutex);
+    for (int64_t token : removed) {
+      removeContractInternal(token);
+    }
+    for (const MasterContract &contract : upserts) {
+      removeContractInternal(contract.exchangeInstrumentID);
+      addContractInternal(contract, [](const QString &s) { return s; });
+    }
+
+    m_symbolsCached = false;
+    m_cachedUniqueSymbols.clear();
+  }
+
+  // Rebuilds the index name map (takes the lock itself)
+  finalizeLoad();
+}
+
 void NSECMRepository::appendContracts(const QVector<ContractData> &contracts) {
   QWriteLocker lock(&m_mutex);
 
@@ -1,5 +1,6 @@
 #include "repository/NSEFORepository.h"
 #include "repository/MasterFileParser.h"
+#include "repository/ParallelMasterParser.h"
 #include <QCoreApplication>
 #include <QDebug>
 #include <QFile>
@@ -258,128 +259,82 @@ bool NSEFORepository::loadMasterFile(const QString &filename) {
 }
 
 bool NSEFORepository::loadProcessedCSV(const QString &filename) {
-  // Native C++ file I/O (10x faster than QFile/QTextStream)
-  std::ifstream file(filename.toStdString(), std::ios::binary);
-  if (!file.is_open()) {
+  // Memory-mapped, parsed on several threads (see ParallelMasterParser)
+  ParallelMasterParser parser;
+  if (!parser.open(filename)) {
     std::cerr << "Failed to open NSEFO CSV file: " << filename.toStdString()
               << std::endl;
     return false;
   }
 
-  std::string line;
-  line.reserve(2048); // CSV lines are longer
-
-  // Skip header line
-  std::getline(file, line);
-
-  int32_t loadedCount = 0;
-  int32_t spreadLoadedCount = 0;
-
-  // String Interning Pool - DISABLED for CSV loading (causes O(n²) slowdown)
-  auto internString = [](const QString &str) -> QString {
-    return str; // No interning - just return the string as-is
-  };
-
   // --- PHASE 1: Parse the entire CSV outside the lock ---
-  // All parsed data is accumulated in local buffers. Only the final
-  // commit into the shared arrays requires the write lock, avoiding
-  // the fragile unlock/relock-inside-loop pattern that was previously used.
+  // All parsed data is accumulated in per-chunk buffers. Only the final
+  // commit into the shared arrays requires the write lock.
 
   struct ParsedRow {
     int64_t token;
     QString name, displayName, description, series;
     int32_t lotSize, freezeQty, instrumentType;
-    double tickSize, strikePrice, assetToken_d;
+    double tickSize, strikePrice;
     int64_t assetToken;
     double priceBandHigh, priceBandLow;
     QString expiryDate, optionType;
   };
 
-  QVector<ParsedRow> regularRows;
-  regularRows.reserve(120000);
-
-  // Spread contracts accumulated outside lock too
-  QHash<int64_t, std::shared_ptr<ContractData>> newSpreads;
-
-  QString qLine;
-  int lineCount = 0;
-  while (std::getline(file, line)) {
-    lineCount++;
-    if (lineCount % 20000 == 0) {
-      qDebug() << "[NSEFO] Parsed lines:" << lineCount;
-      // processEvents without any lock held – safe
-      QCoreApplication::processEvents();
-    }
-    if (line.empty() || line[0] == '\r') {
-      continue;
-    }
-
-    qLine = QString::fromStdString(line);
-
-    // Optimized manual split using midRef to avoid heap allocations
-    QVector<QStringRef> fields;
-    int start = 0;
-    int end = 0;
-    while ((end = qLine.indexOf(',', start)) != -1) {
-      fields.append(qLine.midRef(start, end - start));
-      start = end + 1;
-    }
-    fields.append(qLine.midRef(start));
+  using P = ParallelMasterParser;
+  P::Pools pools;
+  const auto chunks = parser.parseLines<ParsedRow>(
+      [this, &pools](std::string_view line, std::vector<ParsedRow> &out) {
+        std::string_view fields[32];
+        if (P::splitFields(line, ',', fields, 32) < 28) {
+          return;
+        }
 
-    if (fields.size() < 28) {
-      continue;
-    }
+        ParsedRow row;
+        if (!P::toInt64(fields[0], row.token)) {
+          return;
+        }
+        if (!isRegularContract(row.token) && row.token < SPREAD_THRESHOLD) {
+          return;
+        }
 
-    bool ok;
-    int64_t token = fields[0].toLongLong(&ok);
-    if (!ok) {
-      continue;
-    }
+        row.name           = P::internedText(fields[1], pools);
+        row.displayName    = P::text(fields[2]);
+        row.description    = P::text(fields[3]);
+        row.series         = P::internedText(fields[4], pools);
+        row.lotSize        = P::int32Field(fields[5]);
+        row.tickSize       = P::doubleField(fields[6]);
+        row.expiryDate     = P::internedText(fields[7], pools);
+        row.strikePrice    = P::doubleField(fields[8]);
+        row.optionType     = P::internedText(fields[9], pools);
+        row.assetToken     = P::int64Field(fields[11]);
+        row.freezeQty      = P::int32Field(fields[12]);
+        row.priceBandHigh  = P::doubleField(fields[13]);
+        row.priceBandLow   = P::doubleField(fields[14]);
+        row.instrumentType = P::int32Field(fields[27]);
+        if (isRegularContract(row.token)) {
+          row.assetToken = getUnderlyingAssetToken(row.name, row.assetToken);
+        }
+        out.push_back(std::move(row));
+      },
+      1); // Skip header line
 
-    if (isRegularContract(token)) {
-      ParsedRow row;
-      row.token = token;
-      row.name        = internString(trimQuotes(fields[1]));
-      row.displayName = trimQuotes(fields[2]);
-      row.description = trimQuotes(fields[3]);
-      row.series      = internString(trimQuotes(fields[4]));
-      row.lotSize     = fields[5].toInt();
-      row.tickSize    = fields[6].toDouble();
-      row.expiryDate  = internString(trimQuotes(fields[7]));
-      row.strikePrice = fields[8].toDouble();
-      row.optionType  = internString(trimQuotes(fields[9]));
-      row.assetToken  = getUnderlyingAssetToken(row.name, fields[11].toLongLong());
-      row.freezeQty       = fields[12].toInt();
-      row.priceBandHigh   = fields[13].toDouble();
-      row.priceBandLow    = fields[14].toDouble();
-      row.instrumentType  = fields[27].toInt();
-      regularRows.append(std::move(row));
-      loadedCount++;
-    } else if (token >= SPREAD_THRESHOLD) {
-      auto contractData = std::make_shared<ContractData>();
-      contractData->exchangeInstrumentID = token;
-      contractData->name        = internString(trimQuotes(fields[1]));
-      contractData->displayName = trimQuotes(fields[2]);
-      contractData->description = trimQuotes(fields[3]);
-      contractData->series      = internString(trimQuotes(fields[4]));
-      contractData->lotSize     = fields[5].toInt();
-      contractData->tickSize    = fields[6].toDouble();
-      contractData->expiryDate  = internString(trimQuotes(fields[7]));
-      contractData->strikePrice = fields[8].toDouble();
-      contractData->optionType  = internString(trimQuotes(fields[9]));
-      contractData->assetToken  = fields[11].toLongLong();
-      contractData->freezeQty      = fields[12].toInt();
-      contractData->priceBandHigh  = fields[13].toDouble();
-      contractData->priceBandLow   = fields[14].toDouble();
-      contractData->instrumentType = fields[27].toInt();
-      newSpreads[token] = contractData;
-      spreadLoadedCount++;
+  int32_t loadedCount = 0;
+  int32_t spreadLoadedCount = 0;
+  for (const auto &chunk : chunks) {
+    for (const ParsedRow &row : chunk) {
+      if (isRegularContract(row.token)) {
+        loadedCount++;
+      } else {
+        spreadLoadedCount++;
+      }
     }
   }
 
-  qDebug() << "[NSEFO] Parsed" << lineCount << "lines,"
-           << loadedCount << "regular," << spreadLoadedCount << "spreads";
-  file.close();
+  const P::Stats &stats = parser.lastStats();
+  qDebug() << "[NSEFO] Parsed" << stats.lines << "lines on" << stats.threads
+           << "threads," << loadedCount << "regular," << spreadLoadedCount
+           << "spreads," << stats.megabytesPerSecond() << "MB/s";
 
   // Return false if nothing was parsed
   if (loadedCount == 0 && spreadLoadedCount == 0) {
@@ -395,32 +350,50 @@ bool NSEFORepository::loadProcessedCSV(const QString &filename) {
     // is correct regardless of startup ordering.
     QWriteLocker locker(&m_mutexes[0]); // stripe 0 covers spreads + guards start
 
-    for (const auto &row : regularRows) {
-      int32_t idx = getArrayIndex(row.token);
-      m_valid[idx] = true;
-      m_name[idx]        = row.name;
-      m_displayName[idx] = row.displayName;
-      m_description[idx] = row.description;
-      m_series[idx]      = row.series;
-      m_lotSize[idx]     = row.lotSize;
-      m_tickSize[idx]    = row.tickSize;
-      m_expiryDate[idx]  = row.expiryDate;
-      m_strikePrice[idx] = row.strikePrice;
-      m_optionType[idx]  = row.optionType;
-      m_assetToken[idx]  = row.assetToken;
-      m_freezeQty[idx]       = row.freezeQty;
-      m_priceBandHigh[idx]   = row.priceBandHigh;
-      m_priceBandLow[idx]    = row.priceBandLow;
-      m_instrumentType[idx]  = row.instrumentType;
-
-      if (!m_symbolToAssetToken.contains(row.name)) {
-        m_symbolToAssetToken[row.name] = row.assetToken;
-      }
-    }
+    for (const auto &chunk : chunks) {
+      for (const ParsedRow &row : chunk) {
+        if (!isRegularContract(row.token)) {
+          auto contractData = std::make_shared<ContractData>();
+          contractData->exchangeInstrumentID = row.token;
+          contractData->name           = row.name;
+          contractData->displayName    = row.displayName;
+          contractData->description    = row.description;
+          contractData->series         = row.series;
+          contractData->lotSize        = row.lotSize;
+          contractData->tickSize       = row.tickSize;
+          contractData->expiryDate     = row.expiryDate;
+          contractData->strikePrice    = row.strikePrice;
+          contractData->optionType     = row.optionType;
+          contractData->assetToken     = row.assetToken;
+          contractData->freezeQty      = row.freezeQty;
+          contractData->priceBandHigh  = row.priceBandHigh;
+          contractData->priceBandLow   = row.priceBandLow;
+          contractData->instrumentType = row.instrumentType;
+          m_spreadContracts[row.token] = contractData;
+          continue;
+        }
 
-    // Merge spread contracts
-    for (auto it = newSpreads.begin(); it != newSpreads.end(); ++it) {
-      m_spreadContracts[it.key()] = it.value();
+        int32_t idx = getArrayIndex(row.token);
+        m_valid[idx] = true;
+        m_name[idx]        = row.name;
+        m_displayName[idx] = row.displayName;
+        m_description[idx] = row.description;
+        m_series[idx]      = row.series;
+        m_lotSize[idx]     = row.lotSize;
+        m_tickSize[idx]    = row.tickSize;
+        m_expiryDate[idx]  = row.expiryDate;
+        m_strikePrice[idx] = row.strikePrice;
+        m_optionType[idx]  = row.optionType;
+        m_assetToken[idx]  = row.assetToken;
+        m_freezeQty[idx]       = row.freezeQty;
+        m_priceBandHigh[idx]   = row.priceBandHigh;
+        m_priceBandLow[idx]    = row.priceBandLow;
+        m_instrumentType[idx]  = row.instrumentType;
+
+        if (!m_symbolToAssetToken.contains(row.name)) {
+          m_symbolToAssetToken[row.name] = row.assetToken;
+        }
+      }
     }
 
     m_regularCount = loadedCount;
@@ -1090,6 +1063,67 @@ void NSEFORepository::addContract(
   }
 }
 
+bool NSEFORepository::removeContract(int64_t token, QString *symbol) {
+  if (isRegularContract(token)) {
+    int32_t idx = getArrayIndex(token);
+    QWriteLocker locker(&m_mutexes[getStripeIndex(idx)]);
+    if (!m_valid[idx]) {
+      return false;
+    }
+    m_valid[idx] = false;
+    m_regularCount--;
+    if (symbol) {
+      *symbol = m_name[idx];
+    }
+    return true;
+  }
+
+  QWriteLocker locker(&m_mutexes[0]);
+  if (m_spreadContracts.remove(token) == 0) {
+    return false;
+  }
+  m_spreadCount--;
+  return true;
+}
+
+void NSEFORepository::dropEmptySymbols(QSet<QString> symbols) {
+  if (symbols.isEmpty()) {
+    return;
+  }
+  // One pass over the slots instead of one per removed contract
+  for (int32_t idx = 0; idx < ARRAY_SIZE && !symbols.isEmpty(); ++idx) {
+    QReadLocker locker(&m_mutexes[getStripeIndex(idx)]);
+    if (m_valid[idx]) {
+      symbols.remove(m_name[idx]);
+    }
+  }
+
+  QWriteLocker locker(&m_mutexes[0]);
+  for (const QString &symbol : symbols) {
+    m_symbolToAssetToken.remove(symbol);
+  }
+}
+
+void NSEFORepository::applyDelta(const QVector<MasterContract> &upserts,
+                                 const QVector<int64_t> &removed) {
+  QSet<QString> touched;
+  QString symbol;
+  for (int64_t token : removed) {
+    if (removeContract(token, &symbol)) {
+      touched.insert(symbol);
+    }
+  }
+  // addContract() counts every call: drop a changed contract first
+  for (const MasterContract &contract : upserts) {
+    if (removeContract(contract.exchangeInstrumentID, &symbol)) {
+      touched.insert(symbol);
+    }
+    addContract(contract, nullptr);
+  }
+  dropEmptySymbols(std::move(touched));
+  finalizeLoad();
+}
+
 int64_t NSEFORepository::getAssetToken(const QString &symbol) const {
   // Lock stripe 0 for symbol map
   QReadLocker locker(&m_mutexes[0]);
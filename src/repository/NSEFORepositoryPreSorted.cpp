@@ -47,6 +47,11 @@ void NSEFORepositoryPreSorted::finalizeLoad() {
   buildIndexes();
 }
 
+void NSEFORepositoryPreSorted::setContractOrder(
+    const QVector<int64_t> &orderedTokens) {
+  m_presetOrder = orderedTokens;
+}
+
 // Helper: Convert expiry string to QDate for proper chronological comparison
 static QDate expiryToDate(const QString &expiry) {
   // Format: "27JAN2026" -> QDate(2026, 1, 27)
@@ -80,6 +85,21 @@ void NSEFORepositoryPreSorted::buildIndexes() {
   m_symbolIndex.reserve(500); // ~200-300 unique symbols
   m_expiryIndex.reserve(100); // ~50-80 unique expiries
 
+  // Snapshot load: tokens arrive in index order, appending keeps every
+  // bucket sorted
+  if (!m_presetOrder.isEmpty()) {
+    for (int64_t token : m_presetOrder) {
+      const ContractData *contract = getContract(token);
+      if (!contract)
+        continue;
+      m_seriesIndex[contract->series].append(token);
+      m_symbolIndex[contract->name].append(token);
+      m_expiryIndex[contract->expiryDate].append(token);
+    }
+    m_presetOrder.clear();
+    return;
+  }
+
   // Build indexes using zero-copy iteration (avoids copying 100K contracts)
   NSEFORepository::forEachContract([this](const ContractData &contract) {
     int64_t token = contract.exchangeInstrumentID;
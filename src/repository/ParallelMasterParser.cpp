@@ -0,0 +1,373 @@
+#include "repository/ParallelMasterParser.h"
+#include <algorithm>
+#include <charconv>
+
+namespace {
+
+constexpr int kMaxMasterFields = 32;
+
+const char *const kMonths[] = {"JAN", "FEB", "MAR", "APR", "MAY", "JUN",
+                               "JUL", "AUG", "SEP", "OCT", "NOV", "DEC"};
+
+bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+// Shared segment names: every contract of a segment points at one QString
+const QString &segmentName(int index) {
+  static const QString names[] = {QStringLiteral("NSECM"), QStringLiteral("NSEFO"),
+                                  QStringLiteral("BSECM"), QStringLiteral("BSEFO")};
+  return names[index];
+}
+
+// Fields 0-13, common to every segment
+bool parseCommonFields(const std::string_view *fields, int segment,
+                       MasterContract &contract, ParallelMasterParser::Pools &pools) {
+  using P = ParallelMasterParser;
+  contract.exchange = segmentName(segment);
+  if (!P::toInt64(fields[1], contract.exchangeInstrumentID))
+    return false;
+
+  contract.instrumentType = P::int32Field(fields[2]);
+  contract.name = P::internedText(fields[3], pools);
+  contract.description = P::text(fields[4]);
+  contract.series = P::internedText(fields[5], pools);
+  contract.nameWithSeries = P::text(fields[6]);
+  contract.instrumentID = P::text(fields[7]);
+  contract.priceBandHigh = P::doubleField(fields[8]);
+  contract.priceBandLow = P::doubleField(fields[9]);
+  contract.freezeQty = P::int32Field(fields[10]);
+  contract.tickSize = P::doubleField(fields[11]);
+  contract.lotSize = P::int32Field(fields[12]);
+  contract.multiplier = P::int32Field(fields[13]);
+  return true;
+}
+
+// NSECM / BSECM
+bool parseCash(const std::string_view *fields, int count, int segment,
+               MasterContract &contract, ParallelMasterParser::Pools &pools) {
+  using P = ParallelMasterParser;
+  if (count < 16 || !parseCommonFields(fields, segment, contract, pools))
+    return false;
+
+  // Field 19 (index 18), when present, is the full display name
+  contract.displayName = P::text(count >= 19 ? fields[18] : fields[14]);
+  contract.isin = P::text(fields[15]);
+  contract.priceNumerator = count >= 17 ? P::int32Field(fields[16]) : 0;
+  contract.priceDenominator = count >= 18 ? P::int32Field(fields[17]) : 0;
+
+  contract.assetToken = 0;
+  contract.underlyingIndexName.clear();
+  contract.expiryDate.clear();
+  contract.expiryDate_dt = QDate();
+  contract.timeToExpiry = 0.0;
+  contract.strikePrice = 0.0;
+  contract.optionType = 0;
+  return true;
+}
+
+// NSEFO / BSEFO: options carry StrikePrice and OptionType, futures and
+// spreads omit both and shift the remaining fields left
+bool parseDerivative(const std::string_view *fields, int count, int segment,
+                     MasterContract &contract, ParallelMasterParser::Pools &pools) {
+  using P = ParallelMasterParser;
+  if (count < 17 || !parseCommonFields(fields, segment, contract, pools))
+    return false;
+
+  // -1 = index underlying (resolved from the index master later),
+  // 11001000xxxxx = composite, else a direct token
+  const int64_t underlying = P::int64Field(fields[14]);
+  if (underlying == -1)
+    contract.assetToken = 0;
+  else if (underlying > 10000000000LL)
+    contract.assetToken = underlying % 100000;
+  else
+    contract.assetToken = underlying;
+
+  contract.underlyingIndexName = P::internedText(fields[15], pools);
+
+  const ParallelMasterParser::Expiry expiry = P::expiry(fields[16], pools);
+  contract.expiryDate = expiry.text;
+  contract.expiryDate_dt = expiry.date;
+  contract.timeToExpiry = expiry.timeToExpiry;
+
+  contract.priceNumerator = 0;
+  contract.priceDenominator = 0;
+  contract.isin.clear();
+
+  if (contract.instrumentType == 2 && count >= 20) {
+    contract.strikePrice = P::doubleField(fields[17]);
+
+    // Numeric code, or CE / PE text
+    const std::string_view option = P::trimField(fields[18]);
+    int32_t code = 0;
+    if (P::toInt32(option, code)) {
+      contract.optionType = code;
+    } else if (option.size() == 2 && (option[1] == 'E' || option[1] == 'e')) {
+      contract.optionType = (option[0] == 'C' || option[0] == 'c')   ? 3
+                            : (option[0] == 'P' || option[0] == 'p') ? 4
+                                                                     : 0;
+    } else {
+      contract.optionType = 0;
+    }
+    contract.displayName = P::text(fields[19]);
+
+    if (count >= 22) {
+      contract.priceNumerator = P::int32Field(fields[20]);
+      contract.priceDenominator = P::int32Field(fields[21]);
+    }
+    if (count >= 23)
+      contract.isin = P::text(fields[22]);
+  } else {
+    contract.strikePrice = 0.0;
+    contract.optionType = 0;
+    contract.displayName = P::text(fields[17]);
+
+    if (count >= 20) {
+      contract.priceNumerator = P::int32Field(fields[18]);
+      contract.priceDenominator = P::int32Field(fields[19]);
+    }
+    if (count >= 21)
+      contract.isin = P::text(fields[20]);
+  }
+  return true;
+}
+
+} // namespace
+
+ParallelMasterParser::ParallelMasterParser()
+    : m_threadCount(defaultThreadCount()) {}
+
+ParallelMasterParser::~ParallelMasterParser() { close(); }
+
+int ParallelMasterParser::defaultThreadCount() {
+  const unsigned hardware = std::thread::hardware_concurrency();
+  return static_cast<int>(std::clamp(hardware, 1u, 8u));
+}
+
+bool ParallelMasterParser::open(const QString &path, QString *error) {
+  close();
+
+  m_file.setFileName(path);
+  if (!m_file.open(QIODevice::ReadOnly)) {
+    if (error)
+      *error = m_file.errorString();
+    return false;
+  }
+
+  const qint64 size = m_file.size();
+  if (size == 0) {
+    m_data = std::string_view();
+    return true;
+  }
+
+  m_mapped = m_file.map(0, size);
+  if (!m_mapped) {
+    // Mapping unavailable (e.g. some network shares): read it instead
+    m_buffer = m_file.readAll();
+    m_data = std::string_view(m_buffer.constData(), static_cast<size_t>(m_buffer.size()));
+    return true;
+  }
+
+  m_data = std::string_view(reinterpret_cast<const char *>(m_mapped),
+                            static_cast<size_t>(size));
+  return true;
+}
+
+void ParallelMasterParser::setData(const QByteArray &data) {
+  close();
+  m_buffer = data;
+  m_data = std::string_view(m_buffer.constData(), static_cast<size_t>(m_buffer.size()));
+}
+
+void ParallelMasterParser::close() {
+  if (m_mapped)
+    m_file.unmap(m_mapped);
+  if (m_file.isOpen())
+    m_file.close();
+  m_mapped = nullptr;
+  m_buffer.clear();
+  m_data = std::string_view();
+}
+
+std::vector<std::string_view> ParallelMasterParser::splitChunks(std::string_view data,
+                                                                int chunkCount) {
+  std::vector<std::string_view> chunks;
+  if (data.empty())
+    return chunks;
+
+  const size_t target = std::max<size_t>(1, data.size() / std::max(chunkCount, 1));
+  size_t begin = 0;
+  while (begin < data.size()) {
+    size_t end = begin + target;
+    if (static_cast<int>(chunks.size()) == chunkCount - 1 || end >= data.size()) {
+      end = data.size();
+    } else {
+      // Extend to just past the next newline
+      const size_t newline = data.find('\n', end - 1);
+      end = newline == std::string_view::npos ? data.size() : newline + 1;
+    }
+    chunks.push_back(data.substr(begin, end - begin));
+    begin = end;
+  }
+  return chunks;
+}
+
+int ParallelMasterParser::splitFields(std::string_view line, char delimiter,
+                                      std::string_view *fields, int maxFields) {
+  int count = 0;
+  size_t start = 0;
+  while (count < maxFields - 1) {
+    const size_t end = line.find(delimiter, start);
+    if (end == std::string_view::npos)
+      break;
+    fields[count++] = line.substr(start, end - start);
+    start = end + 1;
+  }
+  fields[count++] = line.substr(start);
+  return count;
+}
+
+std::string_view ParallelMasterParser::trimField(std::string_view field) {
+  while (!field.empty() && isBlank(field.front()))
+    field.remove_prefix(1);
+  while (!field.empty() && isBlank(field.back()))
+    field.remove_suffix(1);
+  if (field.size() >= 2 && field.front() == '"' && field.back() == '"')
+    field = field.substr(1, field.size() - 2);
+  return field;
+}
+
+bool ParallelMasterParser::toInt64(std::string_view field, int64_t &out) {
+  field = trimField(field);
+  if (!field.empty() && field.front() == '+')
+    field.remove_prefix(1);
+  out = 0;
+  const auto result = std::from_chars(field.data(), field.data() + field.size(), out);
+  if (field.empty() || result.ec != std::errc() ||
+      result.ptr != field.data() + field.size()) {
+    out = 0;
+    return false;
+  }
+  return true;
+}
+
+bool ParallelMasterParser::toInt32(std::string_view field, int32_t &out) {
+  field = trimField(field);
+  if (!field.empty() && field.front() == '+')
+    field.remove_prefix(1);
+  out = 0;
+  const auto result = std::from_chars(field.data(), field.data() + field.size(), out);
+  if (field.empty() || result.ec != std::errc() ||
+      result.ptr != field.data() + field.size()) {
+    out = 0;
+    return false;
+  }
+  return true;
+}
+
+bool ParallelMasterParser::toDouble(std::string_view field, double &out) {
+  field = trimField(field);
+  if (!field.empty() && field.front() == '+')
+    field.remove_prefix(1);
+  out = 0.0;
+  const auto result = std::from_chars(field.data(), field.data() + field.size(), out);
+  if (field.empty() || result.ec != std::errc() ||
+      result.ptr != field.data() + field.size()) {
+    out = 0.0;
+    return false;
+  }
+  return true;
+}
+
+int64_t ParallelMasterParser::int64Field(std::string_view field) {
+  int64_t value;
+  toInt64(field, value);
+  return value;
+}
+
+int32_t ParallelMasterParser::int32Field(std::string_view field) {
+  int32_t value;
+  toInt32(field, value);
+  return value;
+}
+
+double ParallelMasterParser::doubleField(std::string_view field) {
+  double value;
+  toDouble(field, value);
+  return value;
+}
+
+QString ParallelMasterParser::text(std::string_view field) {
+  field = trimField(field);
+  return QString::fromUtf8(field.data(), static_cast<int>(field.size()));
+}
+
+QString ParallelMasterParser::internedText(std::string_view field, Pools &pools) {
+  field = trimField(field);
+  if (field.empty())
+    return QString();
+  return pools.strings.intern(field, [](std::string_view key) {
+    return QString::fromUtf8(key.data(), static_cast<int>(key.size()));
+  });
+}
+
+ParallelMasterParser::Expiry ParallelMasterParser::expiry(std::string_view field,
+                                                          Pools &pools) {
+  field = trimField(field);
+  if (field.empty())
+    return Expiry();
+
+  return pools.expiries.intern(field, [&pools](std::string_view raw) {
+    Expiry result;
+    result.text = QString::fromUtf8(raw.data(), static_cast<int>(raw.size()));
+
+    std::string_view year, month, day;
+    const size_t t = raw.find('T');
+    if (t != std::string_view::npos) {
+      const size_t d1 = raw.find('-');
+      const size_t d2 = d1 == std::string_view::npos ? d1 : raw.find('-', d1 + 1);
+      if (d1 != std::string_view::npos && d2 != std::string_view::npos && d2 < t) {
+        year = raw.substr(0, d1);
+        month = raw.substr(d1 + 1, d2 - d1 - 1);
+        day = raw.substr(d2 + 1, t - d2 - 1);
+      }
+    } else if (raw.size() == 8 && raw[0] >= '0' && raw[0] <= '9') {
+      year = raw.substr(0, 4);
+      month = raw.substr(4, 2);
+      day = raw.substr(6, 2);
+    }
+    if (year.empty() || month.empty() || day.empty())
+      return result;
+
+    const int32_t monthNum = int32Field(month);
+    if (monthNum < 1 || monthNum > 12)
+      return result;
+
+    result.text = QString::fromLatin1(day.data(), static_cast<int>(day.size())) +
+                  QLatin1String(kMonths[monthNum - 1]) +
+                  QString::fromLatin1(year.data(), static_cast<int>(year.size()));
+    result.date = QDate(int32Field(year), monthNum, int32Field(day));
+    if (result.date.isValid() && result.date >= pools.today)
+      result.timeToExpiry = pools.today.daysTo(result.date) / 365.0;
+    return result;
+  });
+}
+
+bool ParallelMasterParser::parseMasterLine(std::string_view line,
+                                           MasterContract &contract,
+                                           Pools &pools) {
+  std::string_view fields[kMaxMasterFields];
+  const int count = splitFields(line, '|', fields, kMaxMasterFields);
+  if (count < 2)
+    return false;
+
+  const std::string_view segment = trimField(fields[0]);
+  if (segment == "NSECM")
+    return parseCash(fields, count, 0, contract, pools);
+  if (segment == "NSEFO")
+    return parseDerivative(fields, count, 1, contract, pools);
+  if (segment == "BSECM")
+    return parseCash(fields, count, 2, contract, pools);
+  if (segment == "BSEFO")
+    return parseDerivative(fields, count, 3, contract, pools);
+  return false;
+}
@@ -1,6 +1,9 @@
 #include "repository/RepositoryManager.h"
 #include "core/ExchangeSegment.h"
+#include "repository/ContractSnapshot.h"
+#include "repository/MasterDelta.h"
 #include "repository/MasterFileParser.h"
+#include "repository/ParallelMasterParser.h"
 #include <QCoreApplication>
 #include <QDate>
 #include <QDebug>
@@ -14,6 +17,7 @@
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <thread>
 #include <vector>
 
 // Include distributed price stores
@@ -22,8 +26,6 @@
 #include "nsefo_price_store.h"
 #include "repository/NSEFORepositoryPreSorted.h"
 #include "utils/MemoryProfiler.h"
-// Tokenizer for flexible multi-token queries
-#include "search/SearchTokenizer.h"
 
 // Initialize singleton
 RepositoryManager *RepositoryManager::s_instance = nullptr;
@@ -116,6 +118,9 @@ bool RepositoryManager::loadAll(const QString &mastersPath) {
   qDebug() << "[RepositoryManager] Starting Master File Loading";
   qDebug() << "[RepositoryManager] ========================================";
 
+  QElapsedTimer loadTimer;
+  loadTimer.start();
+
   QString mastersDir = mastersPath;
   if (mastersDir == "Masters") {
     mastersDir = getMastersDirectory();
@@ -157,49 +162,27 @@ bool RepositoryManager::loadAll(const QString &mastersPath) {
     // We continue, but some functionality might be limited (no indices)
   }
 
-  // PHASE 2: Load NSE CM (Stocks) - Fallback from CSV to Master File
-  qDebug() << "[RepositoryManager] [2/5] Loading NSE CM (Stocks)...";
-  if (!loadNSECM(mastersDir, true)) {
-    emit loadingError("Failed to load NSE CM",
-                      {"nsecm_processed.csv", "contract_nsecm_latest.txt"});
-    return false;
-  }
-
-  // Append index master contracts to NSECM repository
-  if (!m_indexContracts.isEmpty()) {
-    qDebug() << "[RepositoryManager] Appending" << m_indexContracts.size()
-             << "index contracts to NSECM repository";
-    m_nsecm->appendContracts(m_indexContracts);
-  }
-
-  // PHASE 3: Load NSE FO (Futures & Options) - Fallback from CSV to Master File
-  qDebug() << "[RepositoryManager] [3/5] Loading NSE F&O...";
-  if (!loadNSEFO(mastersDir, true)) {
-    emit loadingError("Failed to load NSE F&O",
-                      {"nsefo_processed.csv", "contract_nsefo_latest.txt"});
-    return false;
+  // PHASES 2-5: the binary snapshot when it is current (it already holds the
+  // appended index contracts and resolved asset tokens), else CSV / masters.
+  // Both set the row hashes an intraday refresh diffs against.
+  m_rowHashes.clear();
+  m_rowHashesDate = QDate();
+  m_loadedFromSnapshot = loadFromSnapshot(mastersDir);
+  if (!m_loadedFromSnapshot) {
+    if (!loadSegmentsFromFiles(mastersDir)) {
+      return false;
+    }
+    loadRowHashesFromMaster(mastersDir);
   }
 
-  // Update asset tokens in NSEFO from index master
-  updateIndexAssetTokens();
-
-  // Resolve index asset tokens (for contracts with assetToken = 0 or -1)
-  resolveIndexAssetTokens();
-
-  // PHASE 4: Load BSE segments (optional)
-  qDebug() << "[RepositoryManager] [4/5] Loading BSE CM (optional)...";
-  loadBSECM(mastersDir, true);
-
-  qDebug() << "[RepositoryManager] [5/5] Loading BSE F&O (optional)...";
-  loadBSEFO(mastersDir, true);
-
   // PHASE 6: Initialize distributed price stores
   qDebug() << "[RepositoryManager] Initializing distributed price stores...";
   initializeDistributedStores();
 
-  // PHASE 7: Build expiry cache
+  // PHASE 7: Build expiry cache and search index
   qDebug() << "[RepositoryManager] Building expiry cache for ATM Watch...";
   buildExpiryCache();
+  buildSearchIndex();
 
   // PHASE 8: Log summary
   SegmentStats stats = getSegmentStats();
@@ -211,6 +194,8 @@ bool RepositoryManager::loadAll(const QString &mastersPath) {
   qDebug() << "[RepositoryManager] BSE F&O:   " << stats.bsefo << "contracts";
   qDebug() << "[RepositoryManager] Total:     " << getTotalContractCount()
            << "contracts";
+  qDebug() << "[RepositoryManager] Loaded in" << loadTimer.elapsed() << "ms"
+           << (m_loadedFromSnapshot ? "(snapshot)" : "(CSV / master files)");
   qDebug() << "[RepositoryManager] ========================================";
 
   m_loaded = true;
@@ -224,6 +209,110 @@ bool RepositoryManager::loadAll(const QString &mastersPath) {
   return true;
 }
 
+bool RepositoryManager::loadSegmentsFromFiles(const QString &mastersDir) {
+  // PHASES 2-5: each segment has its own repository and files, so NSE CM,
+  // NSE F&O and both BSE segments (optional) load at once - CSV first, master
+  // file as fallback. Cross-segment fixups wait for all four.
+  qDebug() << "[RepositoryManager] [2-5/5] Loading NSE CM, NSE F&O, BSE CM and "
+              "BSE F&O...";
+  QElapsedTimer segmentTimer;
+  segmentTimer.start();
+
+  bool nsecmLoaded = false;
+  bool nsefoLoaded = false;
+  std::thread nsefoThread([&] { nsefoLoaded = loadNSEFO(mastersDir, true); });
+  std::thread bsefoThread([&] { loadBSEFO(mastersDir, true); });
+  std::thread bsecmThread([&] { loadBSECM(mastersDir, true); });
+  nsecmLoaded = loadNSECM(mastersDir, true);
+  nsefoThread.join();
+  bsefoThread.join();
+  bsecmThread.join();
+
+  qDebug() << "[RepositoryManager] Segments loaded in" << segmentTimer.elapsed()
+           << "ms";
+
+  if (!nsecmLoaded) {
+    emit loadingError("Failed to load NSE CM",
+                      {"nsecm_processed.csv", "contract_nsecm_latest.txt"});
+    return false;
+  }
+  if (!nsefoLoaded) {
+    emit loadingError("Failed to load NSE F&O",
+                      {"nsefo_processed.csv", "contract_nsefo_latest.txt"});
+    return false;
+  }
+
+  // Append index master contracts to NSECM repository
+  if (!m_indexContracts.isEmpty()) {
+    qDebug() << "[RepositoryManager] Appending" << m_indexContracts.size()
+             << "index contracts to NSECM repository";
+    m_nsecm->appendContracts(m_indexContracts);
+  }
+
+  // Update asset tokens in NSEFO from index master
+  updateIndexAssetTokens();
+
+  // Resolve index asset tokens (for contracts with assetToken = 0 or -1)
+  resolveIndexAssetTokens();
+
+  return true;
+}
+
+void RepositoryManager::loadRowHashesFromMaster(const QString &mastersDir) {
+  const QFileInfo master(mastersDir + "/master_contracts_latest.txt");
+  if (!master.exists()) {
+    return;
+  }
+
+  // CSVs older than the master were not written from it
+  for (const QString &name : {"nsecm", "nsefo", "bsecm", "bsefo"}) {
+    QFileInfo csv(mastersDir + "/processed_csv/" + name + "_processed.csv");
+    if (!csv.exists()) {
+      csv.setFile(mastersDir + "/" + name + "_processed.csv");
+    }
+    if (csv.exists() && csv.lastModified() < master.lastModified()) {
+      qDebug() << "[RepositoryManager]" << csv.fileName()
+               << "predates the master - no row hashes, next refresh is a "
+                  "full reload";
+      return;
+    }
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+
+  ParallelMasterParser parser;
+  QString error;
+  if (!parser.open(master.filePath(), &error)) {
+    qWarning() << "[RepositoryManager] Cannot hash master rows:" << error;
+    return;
+  }
+  const auto chunks = parser.parseLines<MasterDelta::RowHash>(
+      [](std::string_view line, std::vector<MasterDelta::RowHash> &out) {
+        MasterDelta::RowHash row;
+        if (MasterDelta::rowKey(line, row.segment, row.token)) {
+          row.hash = MasterDelta::hashRow(line);
+          out.push_back(row);
+        }
+      });
+
+  // Only rows that made it into a repository count as loaded
+  MasterDelta::RowHashes hashes;
+  for (const std::vector<MasterDelta::RowHash> &chunk : chunks) {
+    for (const MasterDelta::RowHash &row : chunk) {
+      if (getContractByToken(row.segment, row.token)) {
+        hashes.push_back(row);
+      }
+    }
+  }
+  MasterDelta::sortHashes(hashes);
+  m_rowHashes = std::move(hashes);
+  m_rowHashesDate = QDate::currentDate();
+
+  qDebug() << "[RepositoryManager] Hashed" << m_rowHashes.size()
+           << "master rows in" << timer.elapsed() << "ms";
+}
+
 bool RepositoryManager::loadNSEFO(const QString &mastersPath, bool preferCSV) {
   // Try processed_csv subdirectory first (where SaveProcessedCSVs writes)
   QString csvFile = mastersPath + "/processed_csv/nsefo_processed.csv";
@@ -642,134 +731,22 @@ void RepositoryManager::resolveIndexAssetTokens() {
 }
 
 bool RepositoryManager::loadCombinedMasterFile(const QString &filePath) {
-  qDebug() << "[RepositoryManager] Loading combined master file (STREAMING):"
+  qDebug() << "[RepositoryManager] Loading combined master file (PARALLEL):"
            << filePath;
 
-  // Native C++ file I/O (fast)
-  std::ifstream file(filePath.toStdString(), std::ios::binary);
-  if (!file.is_open()) {
-    qWarning() << "[RepositoryManager] Failed to open combined master file";
+  ParallelMasterParser parser;
+  QString error;
+  if (!parser.open(filePath, &error)) {
+    qWarning() << "[RepositoryManager] Failed to open combined master file:"
+               << error;
     return false;
   }
 
-  // GLOBAL STRING POOL for deduplication
-  // This ensures we share underlying QString data for identical strings
-  // (e.g. "OPTIDX", "29-Jan-2026", "RELIANCE") across all repositories
-  QSet<QString> stringPool;
-  // NOTE: Reduced reserve from 100,000 to avoid excessive memory allocation
-  // Strings will be added dynamically as needed
-  stringPool.reserve(
-      10000); // Reserve for typical unique strings (~5-10K expected)
-
-  // Helper lambda for interning
-  auto intern = [&](const QString &str) -> QString {
-    // QSet::insert returns iterator to existing item if found, or new item if
-    // inserted Dereferencing gives us the canonical instance from the pool
-    return *stringPool.insert(str);
-  };
-
-  // Prepare repositories for load (clears old data)
-  if (m_nsefo)
-    m_nsefo->prepareForLoad();
-  if (m_nsecm)
-    m_nsecm->prepareForLoad();
-  if (m_bsefo)
-    m_bsefo->prepareForLoad();
-  if (m_bsecm)
-    m_bsecm->prepareForLoad();
-
-  std::string line;
-  line.reserve(1024);
-
-  int lineCount = 0;
-  int nsefoCount = 0;
-  int nsecmCount = 0;
-  int bsefoCount = 0;
-  int bsecmCount = 0;
-
-  MasterContract contract;
-  QString qLine;
-
-  while (std::getline(file, line)) {
-    lineCount++;
-
-    if (line.empty())
-      continue;
-
-    // Remove trailing whitespace
-    while (!line.empty() &&
-           (line.back() == ' ' || line.back() == '\r' || line.back() == '\n')) {
-      line.pop_back();
-    }
-
-    if (line.empty())
-      continue;
-
-    // Create QString once per line and use QStringRef for parsing
-    qLine = QString::fromStdString(line);
-    QStringRef qLineRef(&qLine);
-
-    // Check segment prefix (first field before |) using QStringRef
-    int pipeIdx = qLineRef.indexOf('|');
-    if (pipeIdx == -1)
-      continue;
-
-    QStringRef segment = qLineRef.left(pipeIdx);
-    bool parsed = false;
-
-    if (segment == "NSEFO") {
-      parsed = MasterFileParser::parseLine(qLineRef, "NSEFO", contract);
-      if (parsed && m_nsefo) {
-        m_nsefo->addContract(contract, intern);
-        nsefoCount++;
-      }
-    } else if (segment == "NSECM") {
-      parsed = MasterFileParser::parseLine(qLineRef, "NSECM", contract);
-      if (parsed && m_nsecm) {
-        m_nsecm->addContract(contract, intern);
-        nsecmCount++;
-      }
-    } else if (segment == "BSEFO") {
-      parsed = MasterFileParser::parseLine(qLineRef, "BSEFO", contract);
-      if (parsed && m_bsefo) {
-        m_bsefo->addContract(contract, intern);
-        bsefoCount++;
-      }
-    } else if (segment == "BSECM") {
-      parsed = MasterFileParser::parseLine(qLineRef, "BSECM", contract);
-      if (parsed && m_bsecm) {
-        m_bsecm->addContract(contract, intern);
-        bsecmCount++;
-      }
-    }
-  }
-
-  file.close();
-
-  qDebug() << "[RepositoryManager] Streaming Load Complete. Lines processed:"
-           << lineCount;
-  qDebug() << "  NSE FO:" << nsefoCount;
-  qDebug() << "  NSE CM:" << nsecmCount;
-  qDebug() << "  BSE FO:" << bsefoCount;
-  qDebug() << "  BSE CM:" << bsecmCount;
-  qDebug() << "  Unique Strings in Pool:" << stringPool.size();
-
-  // Finalize loading for each repository (marks as loaded)
-  if (m_nsefo)
-    m_nsefo->finalizeLoad();
-  if (m_nsecm)
-    m_nsecm->finalizeLoad();
-  if (m_bsefo)
-    m_bsefo->finalizeLoad();
-  if (m_bsecm)
-    m_bsecm->finalizeLoad();
+  const bool anyLoaded = loadCombinedMaster(parser);
 
   // Build expiry cache for ATM Watch optimization
   buildExpiryCache();
-
-  // Mark as loaded if we got any data
-  bool anyLoaded =
-      (nsefoCount > 0 || nsecmCount > 0 || bsefoCount > 0 || bsecmCount > 0);
+  buildSearchIndex();
 
   if (anyLoaded) {
     m_loaded = true;
@@ -781,143 +758,103 @@ bool RepositoryManager::loadCombinedMasterFile(const QString &filePath) {
   return anyLoaded;
 }
 
-bool RepositoryManager::loadFromMemory(const QString &csvData) {
-  qDebug() << "[RepositoryManager] Loading masters from in-memory CSV data "
-              "(STREAMING, size:"
-           << csvData.size() << "bytes)";
-
-  // Global String Pool for deduplication
-  QSet<QString> stringPool;
-  // NOTE: Reduced reserve from 100,000 to avoid excessive memory allocation
-  // Strings will be added dynamically as needed
-  stringPool.reserve(
-      10000); // Reserve for typical unique strings (~5-10K expected)
+bool RepositoryManager::loadCombinedMaster(ParallelMasterParser &parser) {
+  // Shared across parser threads: identical symbols, series and expiries
+  // end up as one QString in every repository
+  ParallelMasterParser::Pools pools;
+
+  const auto chunks = parser.parseLines<MasterContract>(
+      [&pools](std::string_view line, std::vector<MasterContract> &out) {
+        MasterContract contract;
+        if (ParallelMasterParser::parseMasterLine(line, contract, pools)) {
+          contract.rowHash = MasterDelta::hashRow(line);
+          out.push_back(std::move(contract));
+        }
+      });
+  const ParallelMasterParser::Stats parseStats = parser.lastStats();
+
+  // Each segment has its own repository: fill all four at once
+  QElapsedTimer populateTimer;
+  populateTimer.start();
+
+  auto populate = [&chunks](auto *repo, const QString &exchange, int &count) {
+    // One pool per repository (one thread each): strings the repositories
+    // build themselves, like option types, are shared instead of allocated
+    // per row; parsed fields are already shared through the parser pools
+    QSet<QString> stringPool;
+    const std::function<QString(const QString &)> intern =
+        [&stringPool](const QString &str) -> QString {
+      auto it = stringPool.constFind(str);
+      if (it != stringPool.constEnd()) {
+        return *it;
+      }
+      stringPool.insert(str);
+      return str;
+    };
 
-  auto intern = [&](const QString &str) -> QString {
-    return *stringPool.insert(str);
+    repo->prepareForLoad();
+    for (const std::vector<MasterContract> &chunk : chunks) {
+      for (const MasterContract &contract : chunk) {
+        if (contract.exchange == exchange) {
+          repo->addContract(contract, intern);
+          count++;
+        }
+      }
+    }
+    repo->finalizeLoad();
   };
 
-  // Prepare repositories
-  if (m_nsefo)
-    m_nsefo->prepareForLoad();
-  if (m_nsecm)
-    m_nsecm->prepareForLoad();
-  if (m_bsefo)
-    m_bsefo->prepareForLoad();
-  if (m_bsecm)
-    m_bsecm->prepareForLoad();
-
-  // Parse CSV data directly from memory
-  int start = 0;
-  int end = 0;
-  int lineCount = 0;
   int nsefoCount = 0;
   int nsecmCount = 0;
   int bsefoCount = 0;
   int bsecmCount = 0;
-
-  MasterContract contract;
-
-  while ((end = csvData.indexOf('\n', start)) != -1) {
-    lineCount++;
-    QStringRef lineRef = csvData.midRef(start, end - start);
-    start = end + 1;
-
-    QStringRef trimmedLine = lineRef.trimmed();
-    if (trimmedLine.isEmpty())
-      continue;
-
-    // Fast segment detection without creating a new QString
-    int pipeIdx = trimmedLine.indexOf('|');
-    if (pipeIdx == -1)
-      continue;
-
-    QStringRef segment = trimmedLine.left(pipeIdx);
-    bool parsed = false;
-
-    if (segment == "NSEFO") {
-      parsed = MasterFileParser::parseLine(trimmedLine, "NSEFO", contract);
-      if (parsed && m_nsefo) {
-        m_nsefo->addContract(contract, intern);
-        nsefoCount++;
-      }
-    } else if (segment == "NSECM") {
-      parsed = MasterFileParser::parseLine(trimmedLine, "NSECM", contract);
-      if (parsed && m_nsecm) {
-        m_nsecm->addContract(contract, intern);
-        nsecmCount++;
-      }
-    } else if (segment == "BSEFO") {
-      parsed = MasterFileParser::parseLine(trimmedLine, "BSEFO", contract);
-      if (parsed && m_bsefo) {
-        m_bsefo->addContract(contract, intern);
-        bsefoCount++;
-      }
-    } else if (segment == "BSECM") {
-      parsed = MasterFileParser::parseLine(trimmedLine, "BSECM", contract);
-      if (parsed && m_bsecm) {
-        m_bsecm->addContract(contract, intern);
-        bsecmCount++;
-      }
-    }
-  }
-
-  // Handle last line if no newline at end
-  if (start < csvData.length()) {
-    QStringRef lineRef = csvData.midRef(start);
-    QStringRef trimmedLine = lineRef.trimmed();
-    if (!trimmedLine.isEmpty()) {
-      lineCount++;
-      int pipeIdx = trimmedLine.indexOf('|');
-      if (pipeIdx != -1) {
-        QStringRef segment = trimmedLine.left(pipeIdx);
-        bool parsed = false;
-        if (segment == "NSEFO") {
-          parsed = MasterFileParser::parseLine(trimmedLine, "NSEFO", contract);
-          if (parsed && m_nsefo) {
-            m_nsefo->addContract(contract, intern);
-            nsefoCount++;
-          }
-        } else if (segment == "NSECM") {
-          parsed = MasterFileParser::parseLine(trimmedLine, "NSECM", contract);
-          if (parsed && m_nsecm) {
-            m_nsecm->addContract(contract, intern);
-            nsecmCount++;
-          }
-        } else if (segment == "BSEFO") {
-          parsed = MasterFileParser::parseLine(trimmedLine, "BSEFO", contract);
-          if (parsed && m_bsefo) {
-            m_bsefo->addContract(contract, intern);
-            bsefoCount++;
-          }
-        } else if (segment == "BSECM") {
-          parsed = MasterFileParser::parseLine(trimmedLine, "BSECM", contract);
-          if (parsed && m_bsecm) {
-            m_bsecm->addContract(contract, intern);
-            bsecmCount++;
-          }
-        }
-      }
-    }
-  }
-
-  qDebug() << "[RepositoryManager] In-memory Load Complete. Lines processed:"
-           << lineCount;
+  std::thread nsefoThread(
+      [&] { populate(m_nsefo.get(), QStringLiteral("NSEFO"), nsefoCount); });
+  std::thread bsefoThread(
+      [&] { populate(m_bsefo.get(), QStringLiteral("BSEFO"), bsefoCount); });
+  std::thread bsecmThread(
+      [&] { populate(m_bsecm.get(), QStringLiteral("BSECM"), bsecmCount); });
+  populate(m_nsecm.get(), QStringLiteral("NSECM"), nsecmCount);
+  nsefoThread.join();
+  bsefoThread.join();
+  bsecmThread.join();
+
+  qDebug() << "[RepositoryManager] Parsed" << parseStats.lines << "lines ("
+           << parseStats.bytes / 1024 << "KB) on" << parseStats.threads
+           << "threads in" << parseStats.elapsedUs / 1000 << "ms,"
+           << parseStats.megabytesPerSecond() << "MB/s; repositories filled in"
+           << populateTimer.elapsed() << "ms";
   qDebug() << "  NSE FO:" << nsefoCount;
   qDebug() << "  NSE CM:" << nsecmCount;
   qDebug() << "  BSE FO:" << bsefoCount;
   qDebug() << "  BSE CM:" << bsecmCount;
-  qDebug() << "  Unique Strings in Pool:" << stringPool.size();
-
-  // Finalize loading for each repository (marks as loaded)
-  if (m_nsefo)
-    m_nsefo->finalizeLoad();
-  if (m_nsecm)
-    m_nsecm->finalizeLoad();
-  if (m_bsefo)
-    m_bsefo->finalizeLoad();
-  if (m_bsecm)
-    m_bsecm->finalizeLoad();
+  qDebug() << "  Unique Strings in Pool:" << pools.strings.size();
+
+  // Row hashes for the next intraday refresh
+  MasterDelta::RowHashes hashes;
+  hashes.reserve(parseStats.lines);
+  for (const std::vector<MasterContract> &chunk : chunks) {
+    for (const MasterContract &contract : chunk) {
+      hashes.push_back({MasterDelta::segmentId(contract.exchange),
+                        contract.exchangeInstrumentID, contract.rowHash});
+    }
+  }
+  MasterDelta::sortHashes(hashes);
+  m_rowHashes = std::move(hashes);
+  m_rowHashesDate = QDate::currentDate();
+
+  return nsefoCount > 0 || nsecmCount > 0 || bsefoCount > 0 || bsecmCount > 0;
+}
+
+bool RepositoryManager::loadFromMemory(const QString &csvData) {
+  qDebug() << "[RepositoryManager] Loading masters from in-memory CSV data "
+              "(PARALLEL, size:"
+           << csvData.size() << "bytes)";
+
+  ParallelMasterParser parser;
+  parser.setData(csvData.toUtf8());
+  const bool anyLoaded = loadCombinedMaster(parser);
+  parser.close();
 
   // NEW: Integrate Index Master Data (Crucial for Download Master flow)
   QString mastersDir = getMastersDirectory();
@@ -939,17 +876,107 @@ bool RepositoryManager::loadFromMemory(const QString &csvData) {
 
   // Build expiry cache for ATM Watch optimization
   buildExpiryCache();
-
-  bool anyLoaded =
-      (nsefoCount > 0 || nsecmCount > 0 || bsefoCount > 0 || bsecmCount > 0);
+  buildSearchIndex();
 
   if (anyLoaded) {
     m_loaded = true;
   }
 
+  MemoryProfiler::logSnapshot("Master full reload");
   return anyLoaded;
 }
 
+bool RepositoryManager::refreshFromMemory(const QString &csvData,
+                                          MasterDelta::Stats *stats) {
+  if (!m_loaded || m_rowHashes.empty() ||
+      m_rowHashesDate != QDate::currentDate()) {
+    qDebug() << "[RepositoryManager] No row hashes for today's masters - "
+                "refresh needs a full reload";
+    return false;
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+
+  MasterDelta delta;
+  {
+    ParallelMasterParser parser;
+    parser.setData(csvData.toUtf8());
+    delta.compute(parser, m_rowHashes);
+  }
+
+  // An empty download would read as "everything removed"
+  if (delta.stats().rows == 0) {
+    qWarning() << "[RepositoryManager] Downloaded master has no contract "
+                  "rows - refresh needs a full reload";
+    return false;
+  }
+
+  const qint64 diffMs = timer.elapsed();
+  applyMasterDelta(delta);
+  const MasterDelta::Stats result = delta.stats();
+  m_rowHashes = delta.takeHashes();
+
+  qDebug() << "[RepositoryManager] Master refresh:" << result.inserted
+           << "inserted," << result.modified << "modified," << result.removed
+           << "removed," << result.unchanged << "unchanged; diff in"
+           << diffMs << "ms, applied in" << timer.elapsed() - diffMs << "ms";
+  MemoryProfiler::logSnapshot("Master refresh");
+
+  if (stats) {
+    *stats = result;
+  }
+  return true;
+}
+
+void RepositoryManager::applyMasterDelta(const MasterDelta &delta) {
+  if (delta.isEmpty()) {
+    return;
+  }
+
+  {
+    QWriteLocker lock(&m_repositoryLock);
+    auto apply = [&delta](auto *repo, int segment) {
+      if (delta.segmentChanged(segment)) {
+        const MasterDelta::SegmentDelta &changes = delta.segment(segment);
+        repo->applyDelta(changes.upserts, changes.removed);
+      }
+    };
+    apply(m_nsecm.get(), 1);
+    apply(m_nsefo.get(), 2);
+    apply(m_bsecm.get(), 11);
+    apply(m_bsefo.get(), 12);
+  }
+
+  // New index derivatives arrive with assetToken 0
+  if (delta.segmentChanged(2)) {
+    resolveIndexAssetTokens();
+  }
+
+  // Price stores: only the changed rows. Unchanged rows keep their live
+  // data, so subscriptions and open windows carry on undisturbed.
+  for (int segment : MasterDelta::kSegments) {
+    const MasterDelta::SegmentDelta &changes = delta.segment(segment);
+    for (int64_t token : changes.removed) {
+      removeStoreToken(segment, token);
+    }
+    for (const MasterContract &contract : changes.upserts) {
+      const ContractData *stored =
+          getContractByToken(segment, contract.exchangeInstrumentID);
+      if (stored) {
+        initializeStoreToken(segment, *stored);
+      }
+    }
+  }
+
+  // Derived lookups are rebuilt from the repositories; the catalog only
+  // reads the F&O segments
+  if (delta.segmentChanged(2) || delta.segmentChanged(12)) {
+    buildExpiryCache();
+  }
+  buildSearchIndex();
+}
+
 QVector<ContractData> RepositoryManager::searchScrips(const QString &exchange,
                                                       const QString &segment,
                                                       const QString &series,
@@ -1000,139 +1027,101 @@ QVector<ContractData> RepositoryManager::searchScripsGlobal(
   QElapsedTimer timer;
   timer.start();
 
-  QString searchStripped = searchText.trimmed();
-  if (searchStripped.isEmpty())
+  if (searchText.trimmed().isEmpty())
     return {};
 
-  // Use flexible tokenizer for pinning fields (Strike, OptionType)
-  auto parsed = SearchTokenizer::parse(searchStripped);
-  QStringList queryTokens = searchStripped.toUpper().split(
-      QRegularExpression("\\s+"), Qt::SkipEmptyParts);
-
-  // Normalize filters to handle TradingView defaults
-  QString exNormalized = exchangeFilter.toUpper();
-  if (exNormalized == "ALL")
-    exNormalized = "";
-
-  QString segNormalized = segmentFilter.toUpper();
-  // "ALL" means search both CM and FO - keep empty!
-  if (segNormalized == "ALL") {
-    segNormalized = ""; // Search both CM and FO
-  } else if (segNormalized == "STOCKS" || segNormalized == "STOCK") {
-    segNormalized = "CM";
-  } else if (segNormalized == "OPTIONS" || segNormalized == "FUTURES") {
-    segNormalized = "FO";
+  QVector<InstrumentSearchIndex::Hit> hits;
+  {
+    std::shared_lock indexLock(m_searchIndexMutex);
+    hits = m_searchIndex.search(
+        searchText,
+        InstrumentSearchIndex::segmentMask(exchangeFilter, segmentFilter),
+        expiryFilter, maxResults);
   }
 
-  QVector<ContractData> results;
-  results.reserve(maxResults);
-
-  QReadLocker lock(&m_repositoryLock);
+  const QVector<ContractData> results = resolveSearchHits(hits);
 
-  auto searchRepo = [&](auto *repo, const char *name) {
-    if (!repo)
-      return;
-    if (!repo->isLoaded()) {
-      qDebug() << "[RepositoryManager] Skip" << name << " - NOT LOADED";
-      return;
-    }
+  qDebug() << "[RepositoryManager] Global search found" << results.size()
+           << "results for query:" << searchText << "in"
+           << timer.nsecsElapsed() / 1000 << "us";
 
-    int repoMatchCount = 0;
-    repo->forEachContract([&](const ContractData &contract) {
-      if (results.size() >= maxResults)
-        return;
+  return results;
+}
 
-      // 1. Explicit UI expiry filter
-      if (!expiryFilter.isEmpty() && contract.expiryDate != expiryFilter)
-        return;
+QVector<ContractData> RepositoryManager::searchScripsGlobal(
+    InstrumentSearchIndex::Session *session, const QString &searchText,
+    const QString &exchangeFilter, const QString &segmentFilter,
+    const QString &expiryFilter, int maxResults,
+    const std::atomic_bool *cancelled) const {
+
+  QVector<InstrumentSearchIndex::Hit> hits;
+  {
+    std::shared_lock indexLock(m_searchIndexMutex);
+    hits = m_searchIndex.search(
+        session, searchText,
+        InstrumentSearchIndex::segmentMask(exchangeFilter, segmentFilter),
+        expiryFilter, maxResults, cancelled);
+  }
+  if (cancelled && cancelled->load())
+    return {};
 
-      // 2. High-confidence pinned matches from Tokenizer
-      // Strike match (if user typed something that looks like a strike)
-      if (parsed.strike > 0.0) {
-        if (contract.strikePrice <= 0.0)
-          return;
-        double diff = qAbs(contract.strikePrice - parsed.strike);
-        // Match approximate strike
-        if (!(diff < 0.01 || diff <= contract.strikePrice * 0.05))
-          return;
-      }
+  return resolveSearchHits(hits);
+}
 
-      // Option type match (if user typed CE/PE etc)
-      if (parsed.optionType > 0) {
-        QString typeStr = (parsed.optionType == 3) ? "CE" : "PE";
-        if (contract.optionType != typeStr)
-          return;
-      }
+QVector<ContractData> RepositoryManager::resolveSearchHits(
+    const QVector<InstrumentSearchIndex::Hit> &hits) const {
+  QVector<ContractData> results;
+  results.reserve(hits.size());
 
-      // 3. General Multi-token match: EVERY word in query must match SOME field
-      // Priority scoring: check if first token is exact match for name
-      bool isPriority = false;
-      if (!queryTokens.isEmpty() &&
-          contract.name.compare(queryTokens[0], Qt::CaseInsensitive) == 0) {
-        isPriority = true;
-      }
+  QReadLocker lock(&m_repositoryLock);
+  for (const InstrumentSearchIndex::Hit &hit : hits) {
+    const ContractData *contract = nullptr;
+    if (hit.exchangeSegment == 1 && m_nsecm->isLoaded())
+      contract = m_nsecm->getContract(hit.token);
+    else if (hit.exchangeSegment == 2 && m_nsefo->isLoaded())
+      contract = m_nsefo->getContract(hit.token);
+    else if (hit.exchangeSegment == 11 && m_bsecm->isLoaded())
+      contract = m_bsecm->getContract(hit.token);
+    else if (hit.exchangeSegment == 12 && m_bsefo->isLoaded())
+      contract = m_bsefo->getContract(hit.token);
+    if (contract)
+      results.append(*contract);
+  }
+  return results;
+}
 
-      for (const QString &token : queryTokens) {
-        bool tokenMatched = false;
-
-        // Symbol match (Prefix)
-        if (contract.name.startsWith(token, Qt::CaseInsensitive))
-          tokenMatched = true;
-        // Display Name / Description match (Contains)
-        else if (contract.displayName.contains(token, Qt::CaseInsensitive))
-          tokenMatched = true;
-        else if (contract.description.contains(token, Qt::CaseInsensitive))
-          tokenMatched = true;
-        // Expiry match (Special: match "26" to "2026")
-        else if (!contract.expiryDate.isEmpty()) {
-          if (contract.expiryDate.contains(token, Qt::CaseInsensitive)) {
-            tokenMatched = true;
-          } else if (token.length() == 2 && token.at(0).isDigit() &&
-                     contract.expiryDate.contains("20" + token)) {
-            tokenMatched = true;
-          }
-        }
-        // Strike match (as string)
-        else if (contract.strikePrice > 0 &&
-                 QString::number(contract.strikePrice, 'f', 2)
-                     .startsWith(token))
-          tokenMatched = true;
-
-        if (!tokenMatched)
-          return;
-      }
+void RepositoryManager::buildSearchIndex() {
+  QElapsedTimer timer;
+  timer.start();
 
-      if (isPriority) {
-        results.insert(0, contract); // Prioritize exact name matches
-      } else {
-        results.append(contract);
-      }
-      repoMatchCount++;
-    });
-    qDebug() << "[RepositoryManager] Search" << name << "found"
-             << repoMatchCount << "matches";
-  };
+  InstrumentSearchIndex index;
+  {
+    QReadLocker lock(&m_repositoryLock);
 
-  // Search relevant repositories
-  bool searchNSE = (exNormalized.isEmpty() || exNormalized == "NSE");
-  bool searchBSE = (exNormalized.isEmpty() || exNormalized == "BSE");
-  bool searchFO = (segNormalized.isEmpty() || segNormalized == "FO");
-  bool searchCM = (segNormalized.isEmpty() || segNormalized == "CM");
-
-  if (searchNSE && searchFO)
-    searchRepo(m_nsefo.get(), "NSE_FO");
-  if (results.size() < maxResults && searchNSE && searchCM)
-    searchRepo(m_nsecm.get(), "NSE_CM");
-  if (results.size() < maxResults && searchBSE && searchFO)
-    searchRepo(m_bsefo.get(), "BSE_FO");
-  if (results.size() < maxResults && searchBSE && searchCM)
-    searchRepo(m_bsecm.get(), "BSE_CM");
+    // Add order is the rank order: cash before F&O, NSE before BSE
+    auto addRepo = [&index](auto *repo, int exchangeSegment) {
+      if (!repo || !repo->isLoaded())
+        return;
+      repo->forEachContract([&](const ContractData &contract) {
+        index.add(exchangeSegment, contract);
+      });
+    };
+    addRepo(m_nsecm.get(), 1);
+    addRepo(m_nsefo.get(), 2);
+    addRepo(m_bsecm.get(), 11);
+    addRepo(m_bsefo.get(), 12);
+  }
+  index.finalize();
 
-  qDebug() << "[RepositoryManager] Global search found" << results.size()
-           << "total results for query:" << searchText << "in"
-           << timer.elapsed() << "ms";
+  const int documents = index.size();
+  const int terms = index.termCount();
+  {
+    std::unique_lock lock(m_searchIndexMutex);
+    m_searchIndex = std::move(index);
+  }
 
-  return results;
+  qDebug() << "[RepositoryManager] Search index:" << documents << "contracts,"
+           << terms << "terms, built in" << timer.elapsed() << "ms";
 }
 
 const ContractData *RepositoryManager::getContractByToken(int exchangeSegmentID,
@@ -1462,11 +1451,143 @@ bool RepositoryManager::saveProcessedCSVs(const QString &mastersPath) {
 
   if (anySaved) {
     qDebug() << "[RepositoryManager] Processed CSVs saved to:" << csvDir;
+    saveSnapshot(mastersPath);
   }
 
   return anySaved;
 }
 
+QString RepositoryManager::snapshotPath(const QString &mastersPath) {
+  return mastersPath + "/processed_csv/contract_master.bin";
+}
+
+bool RepositoryManager::loadFromSnapshot(const QString &mastersPath) {
+  const QString path = snapshotPath(mastersPath);
+  QFileInfo snapshotInfo(path);
+  if (!snapshotInfo.exists()) {
+    return false;
+  }
+
+  // A master downloaded after the snapshot was written makes it stale
+  const QStringList masterFiles = {
+      "master_contracts_latest.txt", "contract_nsecm_latest.txt",
+      "contract_nsefo_latest.txt", "contract_bsecm_latest.txt",
+      "contract_bsefo_latest.txt"};
+  for (const QString &name : masterFiles) {
+    QFileInfo master(mastersPath + "/" + name);
+    if (master.exists() && master.lastModified() > snapshotInfo.lastModified()) {
+      qDebug() << "[RepositoryManager] Snapshot older than" << name
+               << "- loading from CSV";
+      return false;
+    }
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+
+  ContractSnapshot snapshot;
+  QString error;
+  if (!snapshot.open(path, &error)) {
+    qWarning() << "[RepositoryManager] Snapshot unusable (" << error
+               << ") - loading from CSV";
+    return false;
+  }
+
+  MasterDelta::RowHashes hashes;
+  hashes.reserve(snapshot.recordCount());
+  auto keepHash = [&hashes](int segment, const MasterContract &contract) {
+    if (contract.rowHash) {
+      hashes.push_back(
+          {segment, contract.exchangeInstrumentID, contract.rowHash});
+    }
+  };
+
+  m_nsecm->prepareForLoad();
+  snapshot.forEachContract(1, [this, &keepHash](const MasterContract &contract) {
+    keepHash(1, contract);
+    m_nsecm->addContract(contract, nullptr);
+  });
+  m_nsecm->finalizeLoad();
+
+  m_nsefo->prepareForLoad();
+  snapshot.forEachContract(2, [this, &keepHash](const MasterContract &contract) {
+    keepHash(2, contract);
+    m_nsefo->addContract(contract, nullptr);
+  });
+  // The snapshot carries the index order, so the pre-sorted indexes are
+  // built by appending instead of sorting
+  if (auto *preSorted = dynamic_cast<NSEFORepositoryPreSorted *>(m_nsefo.get())) {
+    preSorted->setContractOrder(snapshot.orderedTokens(2));
+  }
+  m_nsefo->finalizeLoad();
+
+  // BSE segments are optional: leave them unloaded when the snapshot has none
+  uint32_t bseCount = 0;
+  snapshot.segmentRecords(11, &bseCount);
+  if (bseCount > 0) {
+    m_bsecm->prepareForLoad();
+    snapshot.forEachContract(11, [this, &keepHash](const MasterContract &contract) {
+      keepHash(11, contract);
+      m_bsecm->addContract(contract, nullptr);
+    });
+    m_bsecm->finalizeLoad();
+  }
+
+  snapshot.segmentRecords(12, &bseCount);
+  if (bseCount > 0) {
+    m_bsefo->prepareForLoad();
+    snapshot.forEachContract(12, [this, &keepHash](const MasterContract &contract) {
+      keepHash(12, contract);
+      m_bsefo->addContract(contract, nullptr);
+    });
+    m_bsefo->finalizeLoad();
+  }
+
+  // Contracts are recomputed for today, so the hashes count as today's
+  MasterDelta::sortHashes(hashes);
+  m_rowHashes = std::move(hashes);
+  m_rowHashesDate = QDate::currentDate();
+
+  qDebug() << "[RepositoryManager] Loaded" << snapshot.recordCount()
+           << "contracts from snapshot in" << timer.elapsed() << "ms";
+  return true;
+}
+
+bool RepositoryManager::saveSnapshot(const QString &mastersPath) {
+  QElapsedTimer timer;
+  timer.start();
+
+  ContractSnapshotWriter writer;
+  auto add = [this, &writer](int segment, const ContractData &contract) {
+    writer.add(segment, contract,
+               MasterDelta::findHash(m_rowHashes, segment,
+                                     contract.exchangeInstrumentID));
+  };
+  m_nsecm->forEachContract(
+      [&add](const ContractData &contract) { add(1, contract); });
+  m_nsefo->forEachContract(
+      [&add](const ContractData &contract) { add(2, contract); });
+  m_bsecm->forEachContract(
+      [&add](const ContractData &contract) { add(11, contract); });
+  m_bsefo->forEachContract(
+      [&add](const ContractData &contract) { add(12, contract); });
+
+  if (writer.count() == 0) {
+    return false;
+  }
+
+  QDir().mkpath(mastersPath + "/processed_csv");
+  QString error;
+  if (!writer.write(snapshotPath(mastersPath), &error)) {
+    qWarning() << "[RepositoryManager] Failed to write snapshot:" << error;
+    return false;
+  }
+
+  qDebug() << "[RepositoryManager] Snapshot saved in" << timer.elapsed()
+           << "ms";
+  return true;
+}
+
 void RepositoryManager::initializeDistributedStores() {
   qDebug() << "[RepositoryManager] Initializing distributed price stores with "
               "contract master...";
@@ -1483,18 +1604,11 @@ void RepositoryManager::initializeDistributedStores() {
   if (m_nsefo && m_nsefo->isLoaded()) {
     std::vector<uint32_t> tokens;
     tokens.reserve(m_nsefo->getTotalCount());
+    nsefo::g_nseFoPriceStore.reserve(m_nsefo->getTotalCount());  // One slab, no regrowth
 
     m_nsefo->forEachContract([&](const ContractData &contract) {
-      uint32_t token = static_cast<uint32_t>(contract.exchangeInstrumentID);
-      tokens.push_back(token);
-
-      // Initialize token with contract master metadata
-      nsefo::g_nseFoPriceStore.initializeToken(
-          token, contract.name.toUtf8().constData(),
-          contract.displayName.toUtf8().constData(), contract.lotSize,
-          contract.strikePrice, contract.optionType.toUtf8().constData(),
-          contract.expiryDate.toUtf8().constData(), contract.assetToken,
-          contract.instrumentType, contract.tickSize);
+      tokens.push_back(static_cast<uint32_t>(contract.exchangeInstrumentID));
+      initializeStoreToken(2, contract);
     });
 
     // Mark valid tokens in store
@@ -1516,17 +1630,11 @@ void RepositoryManager::initializeDistributedStores() {
 
     std::vector<uint32_t> tokens;
     tokens.reserve(m_nsecm->getTotalCount());
+    nsecm::g_nseCmPriceStore.reserve(m_nsecm->getTotalCount());
 
     m_nsecm->forEachContract([&](const ContractData &contract) {
-      uint32_t token = static_cast<uint32_t>(contract.exchangeInstrumentID);
-      tokens.push_back(token);
-
-      // Initialize token with contract master metadata
-      nsecm::g_nseCmPriceStore.initializeToken(
-          token, contract.name.toUtf8().constData(),
-          contract.series.toUtf8().constData(),
-          contract.displayName.toUtf8().constData(), contract.lotSize,
-          contract.tickSize, contract.priceBandHigh, contract.priceBandLow);
+      tokens.push_back(static_cast<uint32_t>(contract.exchangeInstrumentID));
+      initializeStoreToken(1, contract);
     });
 
     nsecm::g_nseCmPriceStore.initializeFromMaster(tokens);
@@ -1537,20 +1645,11 @@ void RepositoryManager::initializeDistributedStores() {
   if (m_bsefo && m_bsefo->isLoaded()) {
     std::vector<uint32_t> tokens;
     tokens.reserve(m_bsefo->getTotalCount());
+    bse::g_bseFoPriceStore.reserve(m_bsefo->getTotalCount());
 
     m_bsefo->forEachContract([&](const ContractData &contract) {
-      uint32_t token = static_cast<uint32_t>(contract.exchangeInstrumentID);
-      tokens.push_back(token);
-
-      // Initialize token with contract master metadata
-      bse::g_bseFoPriceStore.initializeToken(
-          token, contract.name.toUtf8().constData(),
-          contract.displayName.toUtf8().constData(),
-          contract.scripCode.toUtf8().constData(),
-          contract.series.toUtf8().constData(), contract.lotSize,
-          contract.strikePrice, contract.optionType.toUtf8().constData(),
-          contract.expiryDate.toUtf8().constData(), contract.assetToken,
-          contract.instrumentType, contract.tickSize);
+      tokens.push_back(static_cast<uint32_t>(contract.exchangeInstrumentID));
+      initializeStoreToken(12, contract);
     });
 
     bse::g_bseFoPriceStore.initializeFromMaster(tokens);
@@ -1561,20 +1660,11 @@ void RepositoryManager::initializeDistributedStores() {
   if (m_bsecm && m_bsecm->isLoaded()) {
     std::vector<uint32_t> tokens;
     tokens.reserve(m_bsecm->getTotalCount());
+    bse::g_bseCmPriceStore.reserve(m_bsecm->getTotalCount());
 
     m_bsecm->forEachContract([&](const ContractData &contract) {
-      uint32_t token = static_cast<uint32_t>(contract.exchangeInstrumentID);
-      tokens.push_back(token);
-
-      // Initialize token with contract master metadata
-      bse::g_bseCmPriceStore.initializeToken(
-          token, contract.name.toUtf8().constData(),
-          contract.displayName.toUtf8().constData(),
-          contract.scripCode.toUtf8().constData(),
-          contract.series.toUtf8().constData(), contract.lotSize,
-          contract.strikePrice, contract.optionType.toUtf8().constData(),
-          contract.expiryDate.toUtf8().constData(), contract.assetToken,
-          contract.instrumentType, contract.tickSize);
+      tokens.push_back(static_cast<uint32_t>(contract.exchangeInstrumentID));
+      initializeStoreToken(11, contract);
     });
 
     bse::g_bseCmPriceStore.initializeFromMaster(tokens);
@@ -1585,6 +1675,63 @@ void RepositoryManager::initializeDistributedStores() {
               "contract master data";
 }
 
+void RepositoryManager::initializeStoreToken(int exchangeSegmentID,
+                                             const ContractData &contract) {
+  const uint32_t token = static_cast<uint32_t>(contract.exchangeInstrumentID);
+
+  // Initialize token with contract master metadata
+  switch (exchangeSegmentID) {
+  case 1:
+    nsecm::g_nseCmPriceStore.initializeToken(
+        token, contract.name.toUtf8().constData(),
+        contract.series.toUtf8().constData(),
+        contract.displayName.toUtf8().constData(), contract.lotSize,
+        contract.tickSize, contract.priceBandHigh, contract.priceBandLow);
+    break;
+  case 2:
+    nsefo::g_nseFoPriceStore.initializeToken(
+        token, contract.name.toUtf8().constData(),
+        contract.displayName.toUtf8().constData(), contract.lotSize,
+        contract.strikePrice, contract.optionType.toUtf8().constData(),
+        contract.expiryDate.toUtf8().constData(), contract.assetToken,
+        contract.instrumentType, contract.tickSize);
+    break;
+  case 11:
+  case 12: {
+    bse::PriceStore &store = exchangeSegmentID == 11 ? bse::g_bseCmPriceStore
+                                                     : bse::g_bseFoPriceStore;
+    store.initializeToken(
+        token, contract.name.toUtf8().constData(),
+        contract.displayName.toUtf8().constData(),
+        contract.scripCode.toUtf8().constData(),
+        contract.series.toUtf8().constData(), contract.lotSize,
+        contract.strikePrice, contract.optionType.toUtf8().constData(),
+        contract.expiryDate.toUtf8().constData(), contract.assetToken,
+        contract.instrumentType, contract.tickSize);
+    break;
+  }
+  }
+}
+
+void RepositoryManager::removeStoreToken(int exchangeSegmentID,
+                                         int64_t token) {
+  const uint32_t storeToken = static_cast<uint32_t>(token);
+  switch (exchangeSegmentID) {
+  case 1:
+    nsecm::g_nseCmPriceStore.removeToken(storeToken);
+    break;
+  case 2:
+    nsefo::g_nseFoPriceStore.removeToken(storeToken);
+    break;
+  case 11:
+    bse::g_bseCmPriceStore.removeToken(storeToken);
+    break;
+  case 12:
+    bse::g_bseFoPriceStore.removeToken(storeToken);
+    break;
+  }
+}
+
 // ===== ATM WATCH CACHE OPTIMIZATION =====
 // This implementation pre-processes ~100K contracts into O(1) lookup tables.
 // Total processing time: ~30-50ms (one-time during startup).
@@ -1593,7 +1740,6 @@ void RepositoryManager::initializeDistributedStores() {
 void RepositoryManager::buildExpiryCache() {
   std::unique_lock lock(m_expiryCacheMutex);
 
-  m_expiryToSymbols.clear();
   m_symbolToCurrentExpiry.clear();
   m_optionSymbols.clear();
   // m_optionExpiries was removed as a member
@@ -1601,11 +1747,9 @@ void RepositoryManager::buildExpiryCache() {
   // Don't clear m_indexNameTokenMap here, it's loaded separately
 
   // NEW: Clear ATM optimization caches
-  m_symbolExpiryStrikes.clear();
-  m_strikeToTokens.clear();
   m_symbolToAssetToken.clear();
-  m_symbolExpiryFutureToken.clear();
 
+  ContractCatalog catalog;
   QHash<QString, QVector<QString>> symbolToExpiries;
   QSet<QString> optionExpiries; // Local set for uniqueness tracking
 
@@ -1613,20 +1757,17 @@ void RepositoryManager::buildExpiryCache() {
     QElapsedTimer timer;
     timer.start();
 
-    m_nsefo->forEachContract([this, &symbolToExpiries,
+    m_nsefo->forEachContract([this, &catalog, &symbolToExpiries,
                               &optionExpiries](const ContractData &contract) {
       // Futures: FUTSTK (stock futures) and FUTIDX (index futures)
       // instrumentType 1 = Future
       if (contract.series == "FUTSTK" || contract.series == "FUTIDX") {
-        QString symbolExpiryKey = contract.name + "|" + contract.expiryDate;
-        // Store future token for this symbol+expiry
-        if (!m_symbolExpiryFutureToken.contains(symbolExpiryKey)) {
-          m_symbolExpiryFutureToken[symbolExpiryKey] =
-              contract.exchangeInstrumentID;
-
-          // Reverse mapping for debugging/lookup
-          m_futureTokenToSymbol[contract.exchangeInstrumentID] = contract.name;
-        }
+        // Store future token for this symbol+expiry (first one wins)
+        catalog.addFuture(contract.name, contract.expiryDate,
+                          contract.exchangeInstrumentID);
+
+        // Reverse mapping for debugging/lookup
+        m_futureTokenToSymbol[contract.exchangeInstrumentID] = contract.name;
       }
 
       // Options: OPTSTK (stock options) and OPTIDX (index options)
@@ -1640,33 +1781,17 @@ void RepositoryManager::buildExpiryCache() {
           m_optionSymbols.insert(contract.name);
         }
 
-        // Add symbol to expiry mapping
-        if (!m_expiryToSymbols[contract.expiryDate].contains(contract.name)) {
-          m_expiryToSymbols[contract.expiryDate].append(contract.name);
-        }
-
         // Collect all expiries for this symbol
         if (!symbolToExpiries[contract.name].contains(contract.expiryDate)) {
           symbolToExpiries[contract.name].append(contract.expiryDate);
         }
 
-        // Build strike list for symbol+expiry
-        QString symbolExpiryKey = contract.name + "|" + contract.expiryDate;
-        // Optimization: PreSorted repo already provides strikes in order, but
-        // we're iterating all contracts. Still, avoiding .contains() check with
-        // a Set could be better, but for now we'll stick to verified logic.
-        if (!m_symbolExpiryStrikes[symbolExpiryKey].contains(
-                contract.strikePrice)) {
-          m_symbolExpiryStrikes[symbolExpiryKey].append(contract.strikePrice);
-        }
-
-        // Map strike to CE/PE tokens
-        QString strikeKey = symbolExpiryKey + "|" +
-                            QString::number(contract.strikePrice, 'f', 2);
-        if (contract.optionType == "CE") {
-          m_strikeToTokens[strikeKey].first = contract.exchangeInstrumentID;
-        } else if (contract.optionType == "PE") {
-          m_strikeToTokens[strikeKey].second = contract.exchangeInstrumentID;
+        // Strike and CE/PE token columns of the symbol+expiry chain (also
+        // lists the symbol under the expiry)
+        if (contract.optionType == "CE" || contract.optionType == "PE") {
+          catalog.addOption(contract.name, contract.expiryDate,
+                            contract.strikePrice, contract.optionType == "CE",
+                            contract.exchangeInstrumentID);
         }
 
         // NEW: Store asset token (once per symbol)
@@ -1690,33 +1815,20 @@ void RepositoryManager::buildExpiryCache() {
     addIndex("MIDCPNIFTY", 26074);
     addIndex("NIFTYNXT50", 26013);
 
-    // Sort all strike lists (only necessary if repo wasn't pre-sorted,
-    // but since we're using a visitor on the full set, visit order might not be
-    // strike order)
-    for (auto it = m_symbolExpiryStrikes.begin();
-         it != m_symbolExpiryStrikes.end(); ++it) {
-      std::sort(it.value().begin(), it.value().end());
-    }
-
     std::cout << "NSE FO: build expiry cache time taken " << timer.elapsed()
-              << " ms, strikes cached: " << m_symbolExpiryStrikes.size()
-              << ", tokens cached: " << m_strikeToTokens.size()
-              << ", futures cached: " << m_symbolExpiryFutureToken.size()
-              << std::endl;
+              << " ms" << std::endl;
   }
 
   if (m_bsefo) {
     QElapsedTimer timer;
     timer.start();
-    m_bsefo->forEachContract([this,
+    m_bsefo->forEachContract([this, &catalog,
                               &symbolToExpiries](const ContractData &contract) {
       if (contract.series == "OPTSTK") { // OPTSTK (Options)
         m_optionSymbols.insert(contract.name);
 
         // Add symbol to expiry mapping
-        if (!m_expiryToSymbols[contract.expiryDate].contains(contract.name)) {
-          m_expiryToSymbols[contract.expiryDate].append(contract.name);
-        }
+        catalog.addListing(contract.name, contract.expiryDate);
 
         // Collect all expiries for this symbol
         if (!symbolToExpiries[contract.name].contains(contract.expiryDate)) {
@@ -1728,6 +1840,23 @@ void RepositoryManager::buildExpiryCache() {
               << " ms" << std::endl;
   }
 
+  {
+    QElapsedTimer timer;
+    timer.start();
+    catalog.finalize();
+    int strikes = 0;
+    int futures = 0;
+    for (const ContractCatalog::Chain &chain : catalog.chains()) {
+      strikes += chain.strikes.size();
+      futures += chain.futureToken > 0 ? 1 : 0;
+    }
+    std::cout << "Contract catalog: " << catalog.chains().size()
+              << " chains, " << catalog.symbolCount() << " symbols, "
+              << strikes << " strikes, " << futures << " futures, built in "
+              << timer.elapsed() << " ms" << std::endl;
+  }
+  m_catalog = std::make_shared<const ContractCatalog>(std::move(catalog));
+
   // --- Map Indices from Loaded Index Master ---
   // If m_indexNameTokenMap is populated, map known Future Symbols to Index
   // Tokens
@@ -1798,13 +1927,6 @@ void RepositoryManager::buildExpiryCache() {
     }
   }
 
-  // Pre-sort all symbol vectors in m_expiryToSymbols so that
-  // getSymbolsForExpiry() is O(1) read without sorting.
-  for (auto it = m_expiryToSymbols.begin(); it != m_expiryToSymbols.end();
-       ++it) {
-    std::sort(it.value().begin(), it.value().end());
-  }
-
   // Populate sorted expiries cache
   m_sortedExpiries.reserve(optionExpiries.size());
   for (const QString &expiry : optionExpiries) {
@@ -1822,22 +1944,17 @@ void RepositoryManager::buildExpiryCache() {
   // Calculate memory overhead (approximate)
   int memoryKB = 0;
   memoryKB += m_optionSymbols.size() * 20;         // ~20 bytes per symbol
-  memoryKB += m_expiryToSymbols.size() * 30;       // ~30 bytes per expiry entry
+  memoryKB += m_catalog->chains().size() * 100;    // ~100 bytes per chain
   memoryKB += m_symbolToCurrentExpiry.size() * 40; // ~40 bytes per mapping
   memoryKB += m_symbolToCurrentExpiry.size() * 40; // ~40 bytes per mapping
   qDebug() << "  - Estimated memory:" << (memoryKB / 1024.0) << "KB";
 
-  // Auto-dump debug file as requested
-  // Note: dumpFutureTokenMap uses its own locking or is safe here?
-  // Since we hold the unique_lock, we should ensure dumpFutureTokenMap doesn't
-  // deadlock or that we release it. dumpFutureTokenMap is const and reads
-  // m_symbolExpiryFutureToken which is also being written to? Wait,
-  // m_symbolExpiryFutureToken is written in this loop. It is safe to call
-  // dumpFutureTokenMap IF it doesn't acquire the MAIN lock again. Actually,
-  // dumpFutureTokenMap isn't using the mutex yet, but we should verify. For
-  // now, let's keep it safe.
-
-  // Note: The original code called this at the end.
+  // No future token dump here: dumpFutureTokenMap() takes m_expiryCacheMutex
+  // shared, and this function still holds it exclusively. Call it (see
+  // dumpFutureTokenMapWRAPPER) after buildExpiryCache() returns. The catalog
+  // itself is immutable once published: m_catalog is only replaced under the
+  // exclusive lock above, and readers copy the pointer under the shared lock
+  // (contractCatalog()), so they keep the catalog they started with.
 }
 
 // Separate dump call to avoid complex locking logic inside buildExpiryCache
@@ -1853,8 +1970,9 @@ QVector<QString> RepositoryManager::getOptionSymbols() const {
 QVector<QString>
 RepositoryManager::getSymbolsForExpiry(const QString &expiry) const {
   std::shared_lock lock(m_expiryCacheMutex);
-  // Return pre-sorted vector - O(1) lookup + copy overhead
-  return m_expiryToSymbols.value(expiry);
+  if (!m_catalog)
+    return {};
+  return m_catalog->symbolsForExpiry(ContractCatalog::expiryId(expiry));
 }
 
 QString RepositoryManager::getCurrentExpiry(const QString &symbol) const {
@@ -1866,7 +1984,7 @@ QString RepositoryManager::getCurrentExpiry(const QString &symbol) const {
 QVector<QString>
 RepositoryManager::getExpiriesForSymbol(const QString &symbol) const {
   // Logic requires iterating contracts, so checking loaded repos is enough.
-  // However, if we wanted to use the m_expiryToSymbols map reverse lookup?
+  // However, if we wanted to use the catalog's expiry listing?
   // Current logic iterates loaded repos.
   // Let's stick to current logic as it doesn't touch the caches directly except
   // m_nsefo usage. Wait, the original code used
@@ -1998,7 +2116,14 @@ RepositoryManager::getNearestExpiry(const QVector<QString> &expiryList) const {
   return dates.last().toString("ddMMMyyyy").toUpper();
 }
 
-// ===== ATM WATCH OPTIMIZATION: O(1) LOOKUPS =====
+// ===== ATM WATCH OPTIMIZATION: CATALOG LOOKUPS =====
+
+std::shared_ptr<const ContractCatalog>
+RepositoryManager::contractCatalog() const {
+  static const auto emptyCatalog = std::make_shared<const ContractCatalog>();
+  std::shared_lock lock(m_expiryCacheMutex);
+  return m_catalog ? m_catalog : emptyCatalog;
+}
 
 const QVector<double> &
 RepositoryManager::getStrikesForSymbolExpiry(const QString &symbol,
@@ -2006,19 +2131,20 @@ RepositoryManager::getStrikesForSymbolExpiry(const QString &symbol,
   static const QVector<double>
       emptyVector; // Static empty vector for invalid lookups
   std::shared_lock lock(m_expiryCacheMutex);
-  QString key = symbol + "|" + expiry;
-  auto it = m_symbolExpiryStrikes.find(key);
-  if (it != m_symbolExpiryStrikes.end()) {
-    return it.value();
-  }
-  return emptyVector;
+  const ContractCatalog::Chain *chain =
+      m_catalog ? m_catalog->chain(symbol, expiry) : nullptr;
+  return chain ? chain->strikes : emptyVector;
 }
 
 QPair<int64_t, int64_t> RepositoryManager::getTokensForStrike(
     const QString &symbol, const QString &expiry, double strike) const {
   std::shared_lock lock(m_expiryCacheMutex);
-  QString key = symbol + "|" + expiry + "|" + QString::number(strike, 'f', 2);
-  return m_strikeToTokens.value(key, qMakePair(0LL, 0LL));
+  const ContractCatalog::Chain *chain =
+      m_catalog ? m_catalog->chain(symbol, expiry) : nullptr;
+  const int index = chain ? chain->indexOfStrike(strike) : -1;
+  if (index < 0)
+    return qMakePair(int64_t(0), int64_t(0));
+  return qMakePair(chain->callTokens[index], chain->putTokens[index]);
 }
 
 int64_t RepositoryManager::getAssetTokenForSymbol(const QString &symbol) const {
@@ -2030,8 +2156,9 @@ int64_t
 RepositoryManager::getFutureTokenForSymbolExpiry(const QString &symbol,
                                                  const QString &expiry) const {
   std::shared_lock lock(m_expiryCacheMutex);
-  QString key = symbol + "|" + expiry;
-  return m_symbolExpiryFutureToken.value(key, 0);
+  const ContractCatalog::Chain *chain =
+      m_catalog ? m_catalog->chain(symbol, expiry) : nullptr;
+  return chain ? chain->futureToken : 0;
 }
 
 uint32_t
@@ -2059,8 +2186,9 @@ double RepositoryManager::getUnderlyingPrice(const QString &symbol,
 
   // Step 2: Fallback to Futures Price if Cash Price is missing
   if (price <= 0.0) {
-    QString key = symbol + "|" + expiry;
-    int64_t futureToken = m_symbolExpiryFutureToken.value(key, 0);
+    const ContractCatalog::Chain *chain =
+        m_catalog ? m_catalog->chain(symbol, expiry) : nullptr;
+    int64_t futureToken = chain ? chain->futureToken : 0;
 
     if (futureToken > 0) {
       auto state = nsefo::g_nseFoPriceStore.getUnifiedSnapshot(
@@ -2095,9 +2223,13 @@ void RepositoryManager::dumpFutureTokenMap(const QString &filepath) const {
   // Let's iterate the forward map since it has all keys
 
   QMap<QString, int64_t> sortedMap; // Sort by key for readable output
-  for (auto it = m_symbolExpiryFutureToken.begin();
-       it != m_symbolExpiryFutureToken.end(); ++it) {
-    sortedMap.insert(it.key(), it.value());
+  if (m_catalog) {
+    for (const ContractCatalog::Chain &chain : m_catalog->chains()) {
+      if (chain.futureToken > 0)
+        sortedMap.insert(m_catalog->symbolName(chain.symbol) + "|" +
+                             ContractCatalog::expiryText(chain.expiry),
+                         chain.futureToken);
+    }
   }
 
   for (auto it = sortedMap.begin(); it != sortedMap.end(); ++it) {
@@ -0,0 +1,76 @@
+#include "repository/ScripSearchSession.h"
+#include "repository/RepositoryManager.h"
+#include <QtConcurrent/QtConcurrent>
+
+ScripSearchSession::ScripSearchSession(QObject *parent)
+    : QObject(parent), m_cancelled(std::make_shared<std::atomic_bool>(false)) {
+  connect(&m_watcher, &QFutureWatcher<Result>::finished, this,
+          &ScripSearchSession::onQueryFinished);
+}
+
+ScripSearchSession::~ScripSearchSession() {
+  // The running query writes m_session; let it stop before it goes away
+  m_hasPending = false;
+  m_cancelled->store(true);
+  m_watcher.waitForFinished();
+}
+
+quint64 ScripSearchSession::search(const QString &text,
+                                   const QString &exchangeFilter,
+                                   const QString &segmentFilter,
+                                   const QString &expiryFilter,
+                                   int maxResults) {
+  Query query;
+  query.generation = ++m_generation;
+  query.text = text;
+  query.exchangeFilter = exchangeFilter;
+  query.segmentFilter = segmentFilter;
+  query.expiryFilter = expiryFilter;
+  query.maxResults = maxResults;
+
+  if (m_watcher.isRunning()) {
+    // Stale: stop matching and run only the newest query once it returns
+    m_cancelled->store(true);
+    m_pending = query;
+    m_hasPending = true;
+  } else {
+    start(query);
+  }
+  return query.generation;
+}
+
+void ScripSearchSession::cancel() {
+  ++m_generation;
+  m_hasPending = false;
+  m_cancelled->store(true);
+}
+
+void ScripSearchSession::start(const Query &query) {
+  // A fresh flag per query, so cancelling this one cannot hit the next
+  m_cancelled = std::make_shared<std::atomic_bool>(false);
+  auto cancelled = m_cancelled;
+  InstrumentSearchIndex::Session *session = &m_session;
+
+  m_watcher.setFuture(QtConcurrent::run([query, cancelled, session]() {
+    Result result;
+    result.generation = query.generation;
+    result.text = query.text;
+    result.contracts = RepositoryManager::getInstance()->searchScripsGlobal(
+        session, query.text, query.exchangeFilter, query.segmentFilter,
+        query.expiryFilter, query.maxResults, cancelled.get());
+    return result;
+  }));
+}
+
+void ScripSearchSession::onQueryFinished() {
+  const Result result = m_watcher.result();
+
+  if (m_hasPending) {
+    m_hasPending = false;
+    start(m_pending);
+    return;
+  }
+
+  if (result.generation == m_generation)
+    emit resultsReady(result.generation, result.text, result.contracts);
+}
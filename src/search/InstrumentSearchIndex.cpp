@@ -0,0 +1,681 @@
+#include "search/InstrumentSearchIndex.h"
+#include "search/SearchTokenizer.h"
+
+#include <QHash>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+struct InstrumentSearchIndex::Plan {
+    int segmentMask = AllSegments;
+    QString expiryFilter;        // Exact expiry filter, as given
+    int expiryId = -1;           // ...and its id
+    double strike = 0.0;         // Pinned strike (0 = none)
+    int optionType = 0;          // Pinned CE/PE (0 = none)
+    int expiryFrom = 0;          // Pinned expiry window (0 = none)
+    int expiryTo = 0;
+    QVector<TermRange> words;    // Every query word must prefix-match a term
+    bool noMatch = false;        // A word or the expiry filter matches nothing
+
+    QStringList tokens;          // Query tokens, as typed
+    QVector<bool> wordTokens;    // Per token, whether it is one of words
+    int symbolTerm = -1;         // Exact term of the first non-numeric word
+    int codeTerm = -1;           // Exact term of a lone number, looked up as a token
+    qint64 code = 0;
+};
+
+namespace {
+
+const char *const kMonths[] = {"JAN", "FEB", "MAR", "APR", "MAY", "JUN",
+                               "JUL", "AUG", "SEP", "OCT", "NOV", "DEC"};
+
+bool isOptionWord(const QString &token) {
+    return token == "CE" || token == "CALL" || token == "C" ||
+           token == "PE" || token == "PUT" || token == "P";
+}
+
+bool isSeparator(QChar c) {
+    return c.isSpace() || c == '-' || c == '_' || c == '/' || c == ',' || c == '(' ||
+           c == ')';
+}
+
+// Strike window matching the pinned-strike rule: |strike - s| < 0.01 or
+// |strike - s| <= 5% of strike
+std::pair<double, double> strikeWindow(double strike) {
+    return {std::min(strike - 0.01, strike / 1.05), std::max(strike + 0.01, strike / 0.95)};
+}
+
+bool strikeMatches(double contractStrike, double pinned) {
+    if (contractStrike <= 0.0) return false;
+    const double diff = std::fabs(contractStrike - pinned);
+    return diff < 0.01 || diff <= contractStrike * 0.05;
+}
+
+bool isCancelled(const std::atomic_bool *cancelled) {
+    return cancelled && cancelled->load(std::memory_order_relaxed);
+}
+
+std::atomic<quint64> s_nextIndexId{1};
+
+} // namespace
+
+int InstrumentSearchIndex::segmentBit(int exchangeSegment) {
+    switch (exchangeSegment) {
+    case 1: return NSECM;
+    case 2: return NSEFO;
+    case 11: return BSECM;
+    case 12: return BSEFO;
+    default: return 0;
+    }
+}
+
+int InstrumentSearchIndex::segmentMask(const QString &exchangeFilter,
+                                       const QString &segmentFilter) {
+    const QString ex = exchangeFilter.toUpper();
+    const QString seg = segmentFilter.toUpper();
+
+    int exchanges = NSECM | NSEFO | BSECM | BSEFO;
+    if (ex == "NSE") exchanges = NSECM | NSEFO;
+    else if (ex == "BSE") exchanges = BSECM | BSEFO;
+
+    int segments = NSECM | NSEFO | BSECM | BSEFO;
+    if (seg == "CM" || seg == "STOCK" || seg == "STOCKS") segments = NSECM | BSECM;
+    else if (seg == "FO" || seg == "OPTIONS" || seg == "FUTURES") segments = NSEFO | BSEFO;
+
+    return exchanges & segments;
+}
+
+QStringList InstrumentSearchIndex::words(const QString &field) {
+    QStringList out;
+    const QString upper = field.toUpper();
+    int start = -1;
+    for (int i = 0; i <= upper.size(); ++i) {
+        const bool sep = i == upper.size() || isSeparator(upper.at(i));
+        if (sep) {
+            if (start >= 0) out.append(upper.mid(start, i - start));
+            start = -1;
+        } else if (start < 0) {
+            start = i;
+        }
+    }
+    return out;
+}
+
+int InstrumentSearchIndex::expiryDay(const QString &expiry) {
+    // DDMMMYYYY
+    if (expiry.size() != 9) return 0;
+    bool dayOk = false, yearOk = false;
+    const int day = expiry.leftRef(2).toInt(&dayOk);
+    const int year = expiry.rightRef(4).toInt(&yearOk);
+    const QString month = expiry.mid(2, 3).toUpper();
+    for (int m = 0; m < 12; ++m) {
+        if (month == QLatin1String(kMonths[m])) {
+            const QDate date(year, m + 1, day);
+            return dayOk && yearOk && date.isValid() ? static_cast<int>(date.toJulianDay()) : 0;
+        }
+    }
+    return 0;
+}
+
+// ─── Build ───────────────────────────────────────────────
+
+void InstrumentSearchIndex::clear() {
+    m_termIds.clear();
+    m_expiryIds.clear();
+    m_groupOfSegment.clear();
+    m_docs.clear();
+    m_terms.clear();
+    m_docTerms.clear();
+    m_postingOffsets.clear();
+    m_postings.clear();
+    m_expiries.clear();
+    m_strikeIndex.clear();
+    m_expiryIndex.clear();
+    m_id = 0;
+}
+
+int InstrumentSearchIndex::internTerm(const QString &term) {
+    auto it = m_termIds.find(term);
+    if (it == m_termIds.end()) {
+        it = m_termIds.insert(term, m_terms.size());
+        m_terms.append(term);
+    }
+    return it.value();
+}
+
+void InstrumentSearchIndex::add(int exchangeSegment, const ContractData &contract) {
+    int group = m_groupOfSegment.indexOf(exchangeSegment);
+    if (group < 0) {
+        group = m_groupOfSegment.size();
+        m_groupOfSegment.append(exchangeSegment);
+    }
+
+    Doc doc;
+    doc.token = contract.exchangeInstrumentID;
+    doc.strike = contract.strikePrice;
+    doc.expiryDay = contract.expiryDate_dt.isValid()
+                        ? static_cast<int>(contract.expiryDate_dt.toJulianDay())
+                        : expiryDay(contract.expiryDate);
+    doc.segment = static_cast<int8_t>(exchangeSegment);
+    doc.group = static_cast<int8_t>(group);
+    if (contract.optionType == "CE") doc.optionType = 3;
+    else if (contract.optionType == "PE") doc.optionType = 4;
+
+    if (!contract.expiryDate.isEmpty()) {
+        auto it = m_expiryIds.find(contract.expiryDate);
+        if (it == m_expiryIds.end()) {
+            it = m_expiryIds.insert(contract.expiryDate, m_expiries.size());
+            m_expiries.append(contract.expiryDate);
+        }
+        doc.expiryId = it.value();
+    }
+
+    QStringList terms;
+    terms += words(contract.name);
+    terms += words(contract.displayName);
+    terms += words(contract.description);
+    terms.append(QString::number(contract.exchangeInstrumentID));
+    if (!contract.scripCode.isEmpty()) terms.append(contract.scripCode.trimmed());
+
+    const QString expiry = contract.expiryDate.toUpper();
+    if (expiry.size() == 9) {
+        terms.append(expiry);            // 27FEB2026
+        terms.append(expiry.mid(2));     // FEB2026
+        terms.append(expiry.left(2));    // 27
+        terms.append(expiry.mid(2, 3));  // FEB
+        terms.append(expiry.right(4));   // 2026
+        terms.append(expiry.right(2));   // 26
+    }
+    if (contract.strikePrice > 0.0)
+        terms.append(QString::number(contract.strikePrice, 'f', 2));
+    if (doc.optionType == 3) terms.append(QStringLiteral("CE"));
+    else if (doc.optionType == 4) terms.append(QStringLiteral("PE"));
+
+    // Ids are provisional (insertion order) until finalize()
+    doc.nameTerm = internTerm(contract.name.toUpper());
+    doc.termBegin = m_docTerms.size();
+    m_docTerms.append(doc.nameTerm);
+    for (const QString &term : terms)
+        if (!term.isEmpty()) m_docTerms.append(internTerm(term));
+    doc.termEnd = m_docTerms.size();
+
+    m_docs.append(doc);
+}
+
+void InstrumentSearchIndex::finalize() {
+    m_id = s_nextIndexId.fetch_add(1, std::memory_order_relaxed);
+
+    // Dictionary: sort the terms so a prefix is a contiguous id range
+    QVector<int> termOrder(m_terms.size());
+    for (int i = 0; i < termOrder.size(); ++i) termOrder[i] = i;
+    std::sort(termOrder.begin(), termOrder.end(),
+              [this](int a, int b) { return m_terms[a] < m_terms[b]; });
+    QVector<int> termRemap(m_terms.size());
+    QStringList sortedTerms;
+    sortedTerms.reserve(m_terms.size());
+    for (int i = 0; i < termOrder.size(); ++i) {
+        termRemap[termOrder[i]] = i;
+        sortedTerms.append(m_terms[termOrder[i]]);
+    }
+    m_terms = sortedTerms;
+    m_termIds.clear();
+    m_expiryIds.clear();
+    m_groupOfSegment.clear();
+
+    // Rank order: segment add order, symbol, expiry, strike, option type
+    for (Doc &doc : m_docs) doc.nameTerm = termRemap[doc.nameTerm];
+    QVector<int> docOrder(m_docs.size());
+    for (int i = 0; i < docOrder.size(); ++i) docOrder[i] = i;
+    std::stable_sort(docOrder.begin(), docOrder.end(), [this](int ia, int ib) {
+        const Doc &a = m_docs[ia];
+        const Doc &b = m_docs[ib];
+        if (a.group != b.group) return a.group < b.group;
+        if (a.nameTerm != b.nameTerm) return a.nameTerm < b.nameTerm;
+        if (a.expiryDay != b.expiryDay) return a.expiryDay < b.expiryDay;
+        if (a.strike != b.strike) return a.strike < b.strike;
+        return a.optionType < b.optionType;
+    });
+
+    // Renumber documents; each keeps its term ids sorted and unique
+    QVector<Doc> docs;
+    QVector<int> docTerms;
+    docs.reserve(m_docs.size());
+    docTerms.reserve(m_docTerms.size());
+    QVector<int> postingCounts(m_terms.size(), 0);
+    for (int old : docOrder) {
+        Doc doc = m_docs[old];
+        const int begin = docTerms.size();
+        for (int i = doc.termBegin; i < doc.termEnd; ++i)
+            docTerms.append(termRemap[m_docTerms[i]]);
+        std::sort(docTerms.begin() + begin, docTerms.end());
+        docTerms.erase(std::unique(docTerms.begin() + begin, docTerms.end()), docTerms.end());
+        doc.termBegin = begin;
+        doc.termEnd = docTerms.size();
+        for (int i = doc.termBegin; i < doc.termEnd; ++i)
+            ++postingCounts[docTerms[i]];
+        docs.append(doc);
+    }
+    m_docs = docs;
+    m_docTerms = docTerms;
+
+    // Postings (CSR); documents are visited in id order, so each list is sorted
+    m_postingOffsets.resize(m_terms.size() + 1);
+    m_postingOffsets[0] = 0;
+    for (int t = 0; t < m_terms.size(); ++t)
+        m_postingOffsets[t + 1] = m_postingOffsets[t] + postingCounts[t];
+    m_postings.resize(m_postingOffsets.last());
+    QVector<int> fill = m_postingOffsets;
+    for (int d = 0; d < m_docs.size(); ++d) {
+        const Doc &doc = m_docs[d];
+        for (int i = doc.termBegin; i < doc.termEnd; ++i)
+            m_postings[fill[m_docTerms[i]]++] = d;
+    }
+
+    // Numeric side indexes
+    m_strikeIndex.clear();
+    m_expiryIndex.clear();
+    for (int d = 0; d < m_docs.size(); ++d) {
+        if (m_docs[d].strike > 0.0) m_strikeIndex.append({m_docs[d].strike, d});
+        if (m_docs[d].expiryDay > 0) m_expiryIndex.append({m_docs[d].expiryDay, d});
+    }
+    std::sort(m_strikeIndex.begin(), m_strikeIndex.end());
+    std::sort(m_expiryIndex.begin(), m_expiryIndex.end());
+}
+
+// ─── Query ───────────────────────────────────────────────
+
+InstrumentSearchIndex::TermRange
+InstrumentSearchIndex::prefixRange(const QString &prefix) const {
+    auto lo = std::lower_bound(m_terms.begin(), m_terms.end(), prefix);
+    auto hi = std::partition_point(lo, m_terms.end(), [&prefix](const QString &term) {
+        return term.startsWith(prefix);
+    });
+    return {static_cast<int>(lo - m_terms.begin()), static_cast<int>(hi - m_terms.begin())};
+}
+
+int InstrumentSearchIndex::exactTerm(const QString &term) const {
+    auto it = std::lower_bound(m_terms.begin(), m_terms.end(), term);
+    return it != m_terms.end() && *it == term ? static_cast<int>(it - m_terms.begin()) : -1;
+}
+
+int InstrumentSearchIndex::postingCount(const TermRange &range) const {
+    return m_postingOffsets[range.end] - m_postingOffsets[range.begin];
+}
+
+bool InstrumentSearchIndex::docHasTerm(const Doc &doc, const TermRange &range) const {
+    const int *begin = m_docTerms.constData() + doc.termBegin;
+    const int *end = m_docTerms.constData() + doc.termEnd;
+    const int *it = std::lower_bound(begin, end, range.begin);
+    return it != end && *it < range.end;
+}
+
+bool InstrumentSearchIndex::matches(const Doc &doc, const Plan &plan) const {
+    if (!(segmentBit(doc.segment) & plan.segmentMask)) return false;
+    if (plan.expiryId >= 0 && doc.expiryId != plan.expiryId) return false;
+    if (plan.strike > 0.0 && !strikeMatches(doc.strike, plan.strike)) return false;
+    if (plan.optionType > 0 && doc.optionType != plan.optionType) return false;
+    if (plan.expiryFrom > 0 && (doc.expiryDay < plan.expiryFrom || doc.expiryDay > plan.expiryTo))
+        return false;
+    for (const TermRange &range : plan.words)
+        if (!docHasTerm(doc, range)) return false;
+    return true;
+}
+
+bool InstrumentSearchIndex::isCodeDoc(const Doc &doc, const Plan &plan) const {
+    return plan.codeTerm >= 0 && doc.token == plan.code &&
+           (segmentBit(doc.segment) & plan.segmentMask) &&
+           (plan.expiryId < 0 || doc.expiryId == plan.expiryId);
+}
+
+bool InstrumentSearchIndex::candidates(const Plan &plan, QVector<quint64> *bitmap) const {
+    // Pick the most selective source: a word's postings or a side index window
+    enum Source { Scan, Word, Strike, Expiry };
+    Source source = Scan;
+    int best = m_docs.size();
+    TermRange bestWord;
+
+    for (const TermRange &range : plan.words) {
+        const int count = postingCount(range);
+        if (count < best) {
+            best = count;
+            source = Word;
+            bestWord = range;
+        }
+    }
+
+    auto strikeLo = m_strikeIndex.end(), strikeHi = m_strikeIndex.end();
+    if (plan.strike > 0.0) {
+        const auto window = strikeWindow(plan.strike);
+        strikeLo = std::lower_bound(m_strikeIndex.begin(), m_strikeIndex.end(),
+                                    std::make_pair(window.first, -1));
+        strikeHi = std::upper_bound(strikeLo, m_strikeIndex.end(),
+                                    std::make_pair(window.second, m_docs.size()));
+        if (strikeHi - strikeLo < best) {
+            best = static_cast<int>(strikeHi - strikeLo);
+            source = Strike;
+        }
+    }
+
+    auto expiryLo = m_expiryIndex.end(), expiryHi = m_expiryIndex.end();
+    if (plan.expiryFrom > 0) {
+        expiryLo = std::lower_bound(m_expiryIndex.begin(), m_expiryIndex.end(),
+                                    std::make_pair(plan.expiryFrom, -1));
+        expiryHi = std::upper_bound(expiryLo, m_expiryIndex.end(),
+                                    std::make_pair(plan.expiryTo, m_docs.size()));
+        if (expiryHi - expiryLo < best) {
+            best = static_cast<int>(expiryHi - expiryLo);
+            source = Expiry;
+        }
+    }
+
+    // A dense source is cheaper to walk in id order, and the walk stops as
+    // soon as maxResults are found
+    if (source == Scan || best > m_docs.size() / 4) return false;
+
+    // Otherwise mark the candidates in a bitmap, which also puts them back in
+    // rank order without a sort
+    bitmap->fill(0, (m_docs.size() + 63) / 64);
+    auto mark = [bitmap](int d) { (*bitmap)[d >> 6] |= quint64(1) << (d & 63); };
+    if (source == Word) {
+        for (int i = m_postingOffsets[bestWord.begin]; i < m_postingOffsets[bestWord.end]; ++i)
+            mark(m_postings[i]);
+    } else if (source == Strike) {
+        for (auto it = strikeLo; it != strikeHi; ++it) mark(it->second);
+    } else {
+        for (auto it = expiryLo; it != expiryHi; ++it) mark(it->second);
+    }
+    return true;
+}
+
+void InstrumentSearchIndex::makePlan(const QString &text, int segmentMask,
+                                     const QString &expiryFilter, Plan *plan) const {
+    const QString query = text.simplified().toUpper();
+    plan->segmentMask = segmentMask;
+    plan->expiryFilter = expiryFilter;
+    plan->tokens = query.split(' ', Qt::SkipEmptyParts);
+    plan->wordTokens.fill(false, plan->tokens.size());
+    if (plan->tokens.isEmpty()) {
+        plan->noMatch = true;
+        return;
+    }
+
+    // Pinned fields from the tokenizer
+    const SearchTokenizer::ParsedTokens parsed = SearchTokenizer::parse(query);
+    plan->strike = parsed.strike;
+    plan->optionType = parsed.optionType;
+    if (!expiryFilter.isEmpty()) {
+        plan->expiryId = m_expiries.indexOf(expiryFilter);
+        if (plan->expiryId < 0) plan->noMatch = true;
+    }
+
+    // The tokenizer takes any word starting with a month name as the month
+    // ("MARUTI"): only pin an expiry whose month was typed as a month
+    const QString month = parsed.expiry.mid(2, 3);
+    bool monthTyped = false;
+    for (const QString &token : plan->tokens) {
+        if (!month.isEmpty() && (token == month || (token.at(0).isDigit() && token.contains(month))))
+            monthTyped = true;
+    }
+    const int pinnedDay = monthTyped ? expiryDay(parsed.expiry) : 0;
+    if (pinnedDay > 0) {
+        // "FEB 2026" parses as 01FEB2026: pin the month instead of the day
+        const QDate date = QDate::fromJulianDay(pinnedDay);
+        if (date.day() == 1) {
+            plan->expiryFrom = pinnedDay;
+            plan->expiryTo = pinnedDay + date.daysInMonth() - 1;
+        } else {
+            plan->expiryFrom = plan->expiryTo = pinnedDay;
+        }
+    }
+    // The tokenizer also takes the expiry year ("FEB 2026") as the strike
+    if (!parsed.expiry.isEmpty() && plan->strike == parsed.expiry.right(4).toInt())
+        plan->strike = 0.0;
+    // An exact UI expiry filter narrows through the same side index
+    const int filterDay = expiryDay(expiryFilter);
+    if (filterDay > 0 && plan->expiryFrom == 0) plan->expiryFrom = plan->expiryTo = filterDay;
+
+    // Every other word must prefix-match a term
+    QString firstWord;
+    for (int i = 0; i < plan->tokens.size(); ++i) {
+        const QString &token = plan->tokens[i];
+        if (plan->optionType > 0 && isOptionWord(token)) continue;  // Pinned
+        const TermRange range = prefixRange(token);
+        if (range.isEmpty()) plan->noMatch = true;
+        plan->words.append(range);
+        plan->wordTokens[i] = true;
+        bool isNumber = false;
+        token.toDouble(&isNumber);
+        if (firstWord.isEmpty() && !isNumber) firstWord = token;
+    }
+    if (plan->noMatch) return;
+
+    plan->symbolTerm = firstWord.isEmpty() ? -1 : exactTerm(firstWord);
+
+    // A lone number is also looked up as a token / scrip code
+    bool isCode = false;
+    const qint64 code = plan->tokens.size() == 1 ? plan->tokens[0].toLongLong(&isCode) : 0;
+    if (isCode) {
+        plan->codeTerm = exactTerm(plan->tokens[0]);
+        plan->code = code;
+    }
+}
+
+QVector<InstrumentSearchIndex::Hit>
+InstrumentSearchIndex::search(const QString &text, int segmentMask,
+                              const QString &expiryFilter, int maxResults) const {
+    QVector<Hit> results;
+    if (m_docs.isEmpty() || maxResults <= 0) return results;
+
+    Plan plan;
+    makePlan(text, segmentMask, expiryFilter, &plan);
+    if (plan.noMatch) return results;
+
+    results.reserve(maxResults);
+    auto addHit = [&](int d) {
+        results.append({m_docs[d].segment, m_docs[d].token});
+        return results.size() >= maxResults;
+    };
+
+    // Tier 0: a lone number is looked up as a token / scrip code first
+    QVector<int> exactCodeDocs;
+    if (plan.codeTerm >= 0) {
+        for (int i = m_postingOffsets[plan.codeTerm]; i < m_postingOffsets[plan.codeTerm + 1]; ++i) {
+            const int d = m_postings[i];
+            if (!isCodeDoc(m_docs[d], plan)) continue;
+            exactCodeDocs.append(d);
+            if (addHit(d)) return results;
+        }
+    }
+
+    // Tier 1: exact symbol ("NIFTY" before "NIFTYNXT50")
+    const int symbolTerm = plan.symbolTerm;
+    if (symbolTerm >= 0) {
+        for (int i = m_postingOffsets[symbolTerm]; i < m_postingOffsets[symbolTerm + 1]; ++i) {
+            const int d = m_postings[i];
+            if (m_docs[d].nameTerm != symbolTerm || exactCodeDocs.contains(d)) continue;
+            if (matches(m_docs[d], plan) && addHit(d)) return results;
+        }
+    }
+
+    // Tier 2: everything else, in rank order
+    auto consider = [&](int d) {
+        const Doc &doc = m_docs[d];
+        if (symbolTerm >= 0 && doc.nameTerm == symbolTerm) return false;
+        if (!exactCodeDocs.isEmpty() && exactCodeDocs.contains(d)) return false;
+        return matches(doc, plan) && addHit(d);
+    };
+
+    QVector<quint64> bitmap;
+    if (candidates(plan, &bitmap)) {
+        for (int w = 0; w < bitmap.size(); ++w) {
+            for (quint64 bits = bitmap[w]; bits; bits &= bits - 1) {
+                if (consider(w * 64 + std::countr_zero(bits))) return results;
+            }
+        }
+    } else {
+        for (int d = 0; d < m_docs.size(); ++d)
+            if (consider(d)) break;
+    }
+    return results;
+}
+
+// ─── Sessions ────────────────────────────────────────────
+
+void InstrumentSearchIndex::Session::reset() {
+    m_valid = false;
+    m_refined = false;
+    m_tokens.clear();
+    m_wordTokens.clear();
+    m_matches.clear();
+}
+
+bool InstrumentSearchIndex::refines(const Session &session, const Plan &plan) const {
+    if (!session.m_valid || session.m_indexId != m_id) return false;
+    if (session.m_segmentMask != plan.segmentMask || session.m_expiryFilter != plan.expiryFilter)
+        return false;
+
+    // Every match of the new query must have matched the old one: each old
+    // word constraint is implied by a longer word at the same position...
+    if (plan.tokens.size() < session.m_tokens.size()) return false;
+    for (int i = 0; i < session.m_tokens.size(); ++i) {
+        if (!plan.tokens[i].startsWith(session.m_tokens[i])) return false;
+        // "CAL" -> "CALL" turns a word into a pinned CE, which is wider
+        if (session.m_wordTokens[i] && !plan.wordTokens[i]) return false;
+    }
+
+    // ...and no pinned field is dropped, moved or widened
+    if (session.m_strike > 0.0 && plan.strike != session.m_strike) return false;
+    if (session.m_optionType > 0 && plan.optionType != session.m_optionType) return false;
+    if (session.m_expiryFrom > 0 &&
+        (plan.expiryFrom < session.m_expiryFrom || plan.expiryTo > session.m_expiryTo ||
+         plan.expiryFrom == 0))
+        return false;
+    return true;
+}
+
+bool InstrumentSearchIndex::gather(const Plan &plan, const std::atomic_bool *cancelled,
+                                   QVector<int> *docs) const {
+    auto accept = [&](int d) {
+        const Doc &doc = m_docs[d];
+        if (!matches(doc, plan) && !isCodeDoc(doc, plan)) return true;
+        docs->append(d);
+        return docs->size() <= kMaxSessionMatches;
+    };
+
+    QVector<quint64> bitmap;
+    if (candidates(plan, &bitmap)) {
+        // Exact code hits bypass the word constraints, so may be outside the source
+        if (plan.codeTerm >= 0) {
+            for (int i = m_postingOffsets[plan.codeTerm]; i < m_postingOffsets[plan.codeTerm + 1];
+                 ++i)
+                bitmap[m_postings[i] >> 6] |= quint64(1) << (m_postings[i] & 63);
+        }
+        for (int w = 0; w < bitmap.size(); ++w) {
+            if ((w & 63) == 0 && isCancelled(cancelled)) return false;
+            for (quint64 bits = bitmap[w]; bits; bits &= bits - 1) {
+                if (!accept(w * 64 + std::countr_zero(bits))) return false;
+            }
+        }
+    } else {
+        for (int d = 0; d < m_docs.size(); ++d) {
+            if ((d & 4095) == 0 && isCancelled(cancelled)) return false;
+            if (!accept(d)) return false;
+        }
+    }
+    return true;
+}
+
+QVector<InstrumentSearchIndex::Hit>
+InstrumentSearchIndex::rank(const Plan &plan, const QVector<int> &docs, int maxResults) const {
+    // Same tiers as the top-K search, from a complete ascending match set
+    QVector<Hit> tiers[3];
+    for (int d : docs) {
+        const Doc &doc = m_docs[d];
+        const int tier = isCodeDoc(doc, plan)                                          ? 0
+                         : plan.symbolTerm >= 0 && doc.nameTerm == plan.symbolTerm ? 1
+                                                                                     : 2;
+        if (tiers[tier].size() < maxResults) tiers[tier].append({doc.segment, doc.token});
+    }
+    QVector<Hit> results = std::move(tiers[0]);
+    for (int tier = 1; tier < 3; ++tier) {
+        for (const Hit &hit : tiers[tier]) {
+            if (results.size() >= maxResults) return results;
+            results.append(hit);
+        }
+    }
+    return results;
+}
+
+QVector<InstrumentSearchIndex::Hit>
+InstrumentSearchIndex::search(Session *session, const QString &text, int segmentMask,
+                              const QString &expiryFilter, int maxResults,
+                              const std::atomic_bool *cancelled) const {
+    if (!session) return search(text, segmentMask, expiryFilter, maxResults);
+    if (m_docs.isEmpty() || maxResults <= 0) return {};
+
+    Plan plan;
+    makePlan(text, segmentMask, expiryFilter, &plan);
+    if (plan.tokens.isEmpty()) {
+        session->reset();
+        return {};
+    }
+
+    QVector<int> docs;
+    bool refined = false;
+    if (plan.noMatch) {
+        // Nothing matches, and no extension of this query will either
+    } else if (refines(*session, plan)) {
+        // The previous matches already satisfy the unchanged words and pins;
+        // only check what this keystroke added. An exact code hit may have
+        // skipped the pins, so then check everything.
+        Plan delta;
+        const Plan *check = &plan;
+        if (!session->m_hadCode) {
+            delta.strike = plan.strike != session->m_strike ? plan.strike : 0.0;
+            delta.optionType = plan.optionType != session->m_optionType ? plan.optionType : 0;
+            if (plan.expiryFrom != session->m_expiryFrom || plan.expiryTo != session->m_expiryTo) {
+                delta.expiryFrom = plan.expiryFrom;
+                delta.expiryTo = plan.expiryTo;
+            }
+            int word = 0;
+            for (int i = 0; i < plan.tokens.size(); ++i) {
+                if (!plan.wordTokens[i]) continue;
+                const bool unchanged = i < session->m_tokens.size() &&
+                                       session->m_wordTokens[i] &&
+                                       plan.tokens[i] == session->m_tokens[i];
+                if (!unchanged) delta.words.append(plan.words[word]);
+                ++word;
+            }
+            check = &delta;
+        }
+
+        docs.reserve(session->m_matches.size());
+        for (int i = 0; i < session->m_matches.size(); ++i) {
+            if ((i & 4095) == 0 && isCancelled(cancelled)) return {};
+            const int d = session->m_matches[i];
+            if (matches(m_docs[d], *check) || isCodeDoc(m_docs[d], plan)) docs.append(d);
+        }
+        refined = true;
+    } else if (!gather(plan, cancelled, &docs)) {
+        if (isCancelled(cancelled)) return {};
+        // Too broad to keep: answer top-K and start afresh next time
+        session->reset();
+        session->m_indexId = m_id;
+        return search(text, segmentMask, expiryFilter, maxResults);
+    }
+
+    session->m_indexId = m_id;
+    session->m_valid = true;
+    session->m_refined = refined;
+    session->m_segmentMask = plan.segmentMask;
+    session->m_expiryFilter = plan.expiryFilter;
+    session->m_strike = plan.strike;
+    session->m_optionType = plan.optionType;
+    session->m_expiryFrom = plan.expiryFrom;
+    session->m_expiryTo = plan.expiryTo;
+    session->m_hadCode = plan.codeTerm >= 0;
+    session->m_tokens = plan.tokens;
+    session->m_wordTokens = plan.wordTokens;
+    session->m_matches = std::move(docs);
+    return rank(plan, session->m_matches, maxResults);
+}
@@ -9,7 +9,8 @@ SearchTokenizer::ParsedTokens SearchTokenizer::parse(const QString& query) {
     if (query.simplified().isEmpty()) return result;
 
     // Normalize and split tokens (uppercased)
-    QStringList raw = query.simplified().toUpper().split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
+    // simplified() leaves single spaces; no regex needed on the per-keystroke path
+    QStringList raw = query.simplified().toUpper().split(' ', Qt::SkipEmptyParts);
     result.rawTokens = raw;
 
     QVector<ClassifiedToken> classified = classifyTokens(raw);
@@ -94,7 +95,7 @@ QVector<SearchTokenizer::ClassifiedToken> SearchTokenizer::classifyTokens(const
         }
 
         // Compact expiry like 17FEB2026 or 17-FEB-2026
-        QRegularExpression compactRe("^(\\d{1,2})\\D*([A-Z]{3})\\D*(\\d{4})$");
+        static const QRegularExpression compactRe("^(\\d{1,2})\\D*([A-Z]{3})\\D*(\\d{4})$");
         QRegularExpressionMatch m = compactRe.match(t);
         if (m.hasMatch()) {
             // Convert to a sequence of classified tokens: day, month, year
@@ -8,6 +8,7 @@
 #include <QDebug>
 #include <QSet>
 #include <QtConcurrent>
+#include <algorithm>
 #include <atomic>
 
 ATMWatchManager &ATMWatchManager::getInstance() {
@@ -188,6 +189,9 @@ void ATMWatchManager::calculateAll() {
 
   qDebug() << "[ATMWatch] Starting calculation for" << m_configs.size() << "symbols...";
 
+  // One catalog for the whole pass: every lookup below is an integer search
+  const auto catalog = repo->contractCatalog();
+
   int successCount = 0;
   int failCount = 0;
   QVector<ATMInfo> failedSymbols;
@@ -205,6 +209,10 @@ void ATMWatchManager::calculateAll() {
     info.status = ATMInfo::Status::Valid;
     info.errorMessage.clear();
 
+    // Symbol + expiry chain: strikes, CE/PE tokens and the future token
+    const ContractCatalog::Chain *chain =
+        catalog->chain(config.symbol, config.expiry);
+
     // Unified Step 1 & 2: Get Underlying Price (Cash -> Future Fallback)
     double basePrice = 0.0;
     int64_t underlyingToken = 0;
@@ -218,13 +226,7 @@ void ATMWatchManager::calculateAll() {
       basePrice = repo->getUnderlyingPrice(config.symbol, config.expiry);
     } else {
       // Future
-      auto contracts = repo->getOptionChain("NSE", config.symbol);
-      for (const auto &c : contracts) {
-        if (c.instrumentType == 1 && c.expiryDate == config.expiry) {
-          underlyingToken = c.exchangeInstrumentID;
-          break;
-        }
-      }
+      underlyingToken = chain ? chain->futureToken : 0;
       basePrice = repo->getUnderlyingPrice(config.symbol, config.expiry);
     }
 
@@ -235,11 +237,8 @@ void ATMWatchManager::calculateAll() {
                << "BasePrice:" << basePrice;
     }
 
-    // Step 3: Get sorted strikes from cache (O(1) lookup)
-    const QVector<double> &strikeList =
-        repo->getStrikesForSymbolExpiry(config.symbol, config.expiry);
-
-    if (strikeList.isEmpty()) {
+    // Step 3: Sorted strikes of the chain
+    if (!chain || chain->strikes.isEmpty()) {
       info.status = ATMInfo::Status::StrikesNotFound;
       info.errorMessage = "No strikes found for " + config.expiry;
       failedSymbols.append(info);
@@ -260,41 +259,45 @@ void ATMWatchManager::calculateAll() {
       continue;
     }
 
-    // Step 4: Calculate ATM strike (pure math, no DB access)
-    auto result = ATMCalculator::calculateFromActualStrikes(
-        basePrice, strikeList, config.rangeCount);
+    // Step 4: ATM strike = nearest listed strike (binary search on the chain)
+    const int atmIndex = chain->atmIndex(basePrice);
 
-    if (result.isValid) {
-      // Step 5: Get CE/PE tokens for ATM strike (O(1) lookup)
-      auto tokens = repo->getTokensForStrike(config.symbol, config.expiry,
-                                             result.atmStrike);
+    if (atmIndex >= 0) {
+      const double atmStrike = chain->strikes[atmIndex];
 
+      // Step 5: CE/PE tokens are the parallel columns at the same index
       info.basePrice = basePrice;
-      info.atmStrike = result.atmStrike;
-      info.callToken = tokens.first;
-      info.putToken = tokens.second;
+      info.atmStrike = atmStrike;
+      info.callToken = chain->callTokens[atmIndex];
+      info.putToken = chain->putTokens[atmIndex];
       info.underlyingToken = underlyingToken;
       info.lastUpdated = QDateTime::currentDateTime();
       info.isValid = true;
 
-      // P3: Store strike range and fetch tokens for all strikes
-      info.strikes = result.strikes;
+      // P3: Store strike range (ATM ± rangeCount) and its tokens
+      const int first = config.rangeCount > 0
+                            ? std::max(0, atmIndex - config.rangeCount)
+                            : atmIndex;
+      const int last =
+          config.rangeCount > 0
+              ? std::min<int>(chain->strikes.size() - 1,
+                              atmIndex + config.rangeCount)
+              : atmIndex;
+      info.strikes.clear();
       info.strikeTokens.clear();
-      for (const double strike : result.strikes) {
-        auto strikeTokenPair =
-            repo->getTokensForStrike(config.symbol, config.expiry, strike);
-        info.strikeTokens.append(strikeTokenPair);
+      for (int i = first; i <= last; ++i) {
+        info.strikes.append(chain->strikes[i]);
+        info.strikeTokens.append({chain->callTokens[i], chain->putTokens[i]});
       }
 
       // P3: Detect ATM strike changes
       double previousStrike = m_previousATMStrike.value(config.symbol, 0.0);
-      if (previousStrike > 0 && previousStrike != result.atmStrike) {
-        atmChanges.append({config.symbol, {previousStrike, result.atmStrike}});
+      if (previousStrike > 0 && previousStrike != atmStrike) {
+        atmChanges.append({config.symbol, {previousStrike, atmStrike}});
         qDebug() << "[ATMWatch]" << config.symbol
-                 << "ATM changed:" << previousStrike << "->"
-                 << result.atmStrike;
+                 << "ATM changed:" << previousStrike << "->" << atmStrike;
       }
-      m_previousATMStrike[config.symbol] = result.atmStrike;
+      m_previousATMStrike[config.symbol] = atmStrike;
 
       successCount++;
     } else {
@@ -351,15 +354,13 @@ double ATMWatchManager::fetchBasePrice(const ATMConfig &config) {
     return 0.0;
   } else {
     // Find Future LTP
-    auto contracts =
-        RepositoryManager::getInstance()->getOptionChain("NSE", config.symbol);
-    for (const auto &c : contracts) {
-      // instrumentType 1 = Future
-      if (c.instrumentType == 1 && c.expiryDate == config.expiry) {
-        auto state = nsefo::g_nseFoPriceStore.getUnifiedSnapshot(
-            static_cast<uint32_t>(c.exchangeInstrumentID));
-        return (state.token != 0) ? state.ltp : 0.0;
-      }
+    const auto catalog = RepositoryManager::getInstance()->contractCatalog();
+    const ContractCatalog::Chain *chain =
+        catalog->chain(config.symbol, config.expiry);
+    if (chain && chain->futureToken > 0) {
+      auto state = nsefo::g_nseFoPriceStore.getUnifiedSnapshot(
+          static_cast<uint32_t>(chain->futureToken));
+      return (state.token != 0) ? state.ltp : 0.0;
     }
 
     // Fallback: If requested expiry future not found, try the nearest future?
@@ -377,6 +378,7 @@ void ATMWatchManager::subscribeToUnderlyingPrices() {
     return;
 
   FeedHandler &feed = FeedHandler::instance();
+  const auto catalog = repo->contractCatalog();
 
   for (auto it = m_configs.begin(); it != m_configs.end(); ++it) {
     const auto &config = it.value();
@@ -401,26 +403,24 @@ void ATMWatchManager::subscribeToUnderlyingPrices() {
                  << "token:" << underlyingToken << "threshold:" << threshold;
       }
     } else {
-      // Future - find the contract
-      auto contracts = repo->getOptionChain("NSE", config.symbol);
-      for (const auto &c : contracts) {
-        if (c.instrumentType == 1 && c.expiryDate == config.expiry) {
-          underlyingToken = c.exchangeInstrumentID;
-          m_tokenToSymbol[underlyingToken] = config.symbol;
-          // Subscribe to NSEFO (exchange segment 2)
-          feed.subscribe(2, underlyingToken, this,
-                         &ATMWatchManager::onUnderlyingPriceUpdate);
-
-          double threshold = calculateThreshold(config.symbol, config.expiry);
-          m_threshold[config.symbol] = threshold;
-          auto state = nsefo::g_nseFoPriceStore.getUnifiedSnapshot(
-              static_cast<uint32_t>(underlyingToken));
-          m_lastTriggerPrice[config.symbol] = state.ltp;
-
-          qDebug() << "[ATMWatch] Subscribed to" << config.symbol << "Future"
-                   << "token:" << underlyingToken << "threshold:" << threshold;
-          break;
-        }
+      // Future - the chain's future contract
+      const ContractCatalog::Chain *chain =
+          catalog->chain(config.symbol, config.expiry);
+      if (chain && chain->futureToken > 0) {
+        underlyingToken = chain->futureToken;
+        m_tokenToSymbol[underlyingToken] = config.symbol;
+        // Subscribe to NSEFO (exchange segment 2)
+        feed.subscribe(2, underlyingToken, this,
+                       &ATMWatchManager::onUnderlyingPriceUpdate);
+
+        double threshold = calculateThreshold(config.symbol, config.expiry);
+        m_threshold[config.symbol] = threshold;
+        auto state = nsefo::g_nseFoPriceStore.getUnifiedSnapshot(
+            static_cast<uint32_t>(underlyingToken));
+        m_lastTriggerPrice[config.symbol] = state.ltp;
+
+        qDebug() << "[ATMWatch] Subscribed to" << config.symbol << "Future"
+                 << "token:" << underlyingToken << "threshold:" << threshold;
       }
     }
   }
@@ -429,16 +429,15 @@ void ATMWatchManager::subscribeToUnderlyingPrices() {
 // P2: Calculate threshold (half of strike interval)
 double ATMWatchManager::calculateThreshold(const QString &symbol,
                                            const QString &expiry) {
-  auto repo = RepositoryManager::getInstance();
-  const QVector<double> &strikes =
-      repo->getStrikesForSymbolExpiry(symbol, expiry);
+  const auto catalog = RepositoryManager::getInstance()->contractCatalog();
+  const ContractCatalog::Chain *chain = catalog->chain(symbol, expiry);
 
-  if (strikes.size() < 2) {
+  if (!chain || chain->strikes.size() < 2) {
     return 50.0; // Default fallback
   }
 
   // Calculate strike interval from first two strikes
-  double strikeInterval = strikes[1] - strikes[0];
+  double strikeInterval = chain->strikes[1] - chain->strikes[0];
 
   // P3: Threshold = multiplier * strike_interval (default 0.5 = half)
   return strikeInterval * m_thresholdMultiplier;
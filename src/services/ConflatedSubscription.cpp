@@ -0,0 +1,119 @@
+#include "services/ConflatedSubscription.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+ConflatedSubscription::ConflatedSubscription(FeedDispatcher& dispatcher, int maxRateHz,
+                                             BatchCallback callback, uint32_t typeMask,
+                                             KeyRegistrar registrar, QObject* parent)
+    : QObject(parent),
+      m_dispatcher(dispatcher),
+      m_callback(std::move(callback)),
+      m_typeMask(typeMask),
+      m_registrar(std::move(registrar)),
+      m_state(std::make_shared<State>()),
+      m_timer(this) {
+    setMaxRate(maxRateHz);
+    connect(&m_timer, &QTimer::timeout, this, &ConflatedSubscription::flush);
+}
+
+ConflatedSubscription::~ConflatedSubscription() {
+    // Each handle waits out an in-flight callback before it returns
+    m_subscriptions.clear();
+}
+
+// ============================================================================
+// Key set
+// ============================================================================
+
+void ConflatedSubscription::addKey(int64_t key) {
+    if (m_subscriptions.count(key)) return;
+
+    // Runs on the publishing thread: overwrite in place, no allocation once
+    // the key has a slot for this interval
+    std::shared_ptr<State> state = m_state;
+    auto onTick = [state, key](const UDP::MarketTick& tick) {
+        state->ticks.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(state->mutex);
+        auto it = state->slot.find(key);
+        if (it != state->slot.end()) {
+            state->latest[it->second] = tick;
+        } else {
+            state->slot.emplace(key, state->latest.size());
+            state->latest.push_back(tick);
+        }
+    };
+
+    if (m_registrar) m_registrar(key);
+    m_subscriptions.emplace(key, m_dispatcher.subscribe(key, nullptr, std::move(onTick),
+                                                        m_typeMask));
+    updateTimer();
+}
+
+void ConflatedSubscription::removeKey(int64_t key) {
+    auto it = m_subscriptions.find(key);
+    if (it == m_subscriptions.end()) return;
+    m_subscriptions.erase(it); // No further writes for key after this
+
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    auto slot = m_state->slot.find(key);
+    if (slot != m_state->slot.end()) {
+        // Drop the pending value; keep the others in order
+        const size_t index = slot->second;
+        m_state->slot.erase(slot);
+        m_state->latest.erase(m_state->latest.begin() + static_cast<std::ptrdiff_t>(index));
+        for (auto& entry : m_state->slot) {
+            if (entry.second > index) --entry.second;
+        }
+    }
+    updateTimer();
+}
+
+void ConflatedSubscription::setKeys(const std::vector<int64_t>& keys) {
+    const std::unordered_set<int64_t> wanted(keys.begin(), keys.end());
+    std::vector<int64_t> stale;
+    for (const auto& entry : m_subscriptions) {
+        if (!wanted.count(entry.first)) stale.push_back(entry.first);
+    }
+    for (int64_t key : stale) removeKey(key);
+    for (int64_t key : keys) addKey(key);
+}
+
+void ConflatedSubscription::clearKeys() {
+    m_subscriptions.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        m_state->slot.clear();
+        m_state->latest.clear();
+    }
+    updateTimer();
+}
+
+// ============================================================================
+// Delivery
+// ============================================================================
+
+void ConflatedSubscription::setMaxRate(int maxRateHz) {
+    const int hz = std::clamp(maxRateHz, 1, 1000);
+    m_timer.setInterval(1000 / hz);
+}
+
+void ConflatedSubscription::updateTimer() {
+    // No keys, nothing can change: don't wake the owner's thread
+    if (m_subscriptions.empty()) m_timer.stop();
+    else if (!m_timer.isActive()) m_timer.start();
+}
+
+void ConflatedSubscription::flush() {
+    std::vector<UDP::MarketTick> batch;
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        if (m_state->latest.empty()) return;
+        batch.swap(m_state->latest);
+        m_state->latest.reserve(batch.size());
+        m_state->slot.clear();
+    }
+    ++m_batches;
+    // The callback may change the key set or flush again
+    if (m_callback) m_callback(batch);
+}
@@ -518,6 +518,7 @@ void ConnectionStatusManager::recordActivity(ConnectionId id, uint64_t packetsDe
 // ═══════════════════════════════════════════════════════════════════════
 
 void ConnectionStatusManager::refreshStats() {
+    const auto udpStats = UdpBroadcastService::instance().getStats();
     {
         QMutexLocker lock(&m_mutex);
         for (int i = 0; i < NUM_CONNECTIONS; ++i) {
@@ -532,6 +533,17 @@ void ConnectionStatusManager::refreshStats() {
             it->totalPackets = current;
             it->packetsPerSec = static_cast<double>(delta);
         }
+
+        auto applySequence = [this](ConnectionId cid, const common::SequenceGapCounters& seq) {
+            auto it = m_connections.find(cid);
+            if (it == m_connections.end()) return;
+            it->seqGaps = seq.gaps;
+            it->seqLost = seq.netLost();
+            it->seqMaxGap = seq.maxGap;
+            it->seqOutOfOrder = seq.outOfOrder;
+        };
+        applySequence(ConnectionId::UDP_NSEFO, udpStats.nseFoSequence);
+        applySequence(ConnectionId::UDP_NSECM, udpStats.nseCmSequence);
     }
     emit statsUpdated();
 }
@@ -0,0 +1,217 @@
+#include "services/FeedDispatcher.h"
+
+#include <QMetaObject>
+#include <QThread>
+#include <algorithm>
+#include <thread>
+
+namespace {
+
+// Number of dispatcher callbacks running on this thread. Unsubscribing from
+// inside one does not wait for other publishers (see class doc).
+thread_local int t_callbackDepth = 0;
+
+} // namespace
+
+// ============================================================================
+// Subscription
+// ============================================================================
+
+void FeedDispatcher::Subscription::reset() {
+    if (m_dispatcher && m_sub) {
+        m_dispatcher->remove(m_sub);
+    }
+    m_dispatcher = nullptr;
+    m_sub.reset();
+}
+
+// ============================================================================
+// Management
+// ============================================================================
+
+FeedDispatcher::FeedDispatcher()
+    : m_buckets(new std::atomic<BucketPtr>[kBuckets]) {}
+
+FeedDispatcher::ListPtr FeedDispatcher::find(int64_t key) const {
+    if (key == kAllTokens) return m_allTokens.load(std::memory_order_acquire);
+    BucketPtr bucket = m_buckets[bucketOf(key)].load(std::memory_order_acquire);
+    if (bucket) {
+        for (const auto& entry : *bucket) {
+            if (entry.first == key) return entry.second;
+        }
+    }
+    return nullptr;
+}
+
+void FeedDispatcher::store(int64_t key, ListPtr list) {
+    if (key == kAllTokens) {
+        m_allTokens.store(std::move(list), std::memory_order_release);
+        return;
+    }
+
+    std::atomic<BucketPtr>& slot = m_buckets[bucketOf(key)];
+    BucketPtr current = slot.load(std::memory_order_relaxed);
+    auto next = std::make_shared<Bucket>();
+    next->reserve((current ? current->size() : 0) + 1);
+    if (current) {
+        for (const auto& entry : *current) {
+            if (entry.first != key) next->push_back(entry);
+        }
+    }
+    if (list) next->emplace_back(key, std::move(list));
+    slot.store(next->empty() ? nullptr : BucketPtr(std::move(next)),
+               std::memory_order_release);
+}
+
+template <typename Pred>
+void FeedDispatcher::strip(int64_t key, const ListPtr& list, Pred&& pred,
+                           SubscriberList& removed) {
+    if (!list || std::none_of(list->begin(), list->end(), pred)) return;
+    auto next = std::make_shared<SubscriberList>();
+    for (const auto& s : *list) {
+        if (pred(s)) removed.push_back(s);
+        else next->push_back(s);
+    }
+    store(key, next->empty() ? nullptr : ListPtr(std::move(next)));
+}
+
+FeedDispatcher::Subscription FeedDispatcher::subscribe(int64_t key, QObject* context,
+                                                       TickCallback callback,
+                                                       uint32_t typeMask) {
+    auto sub = std::make_shared<Subscriber>();
+    sub->key = key;
+    sub->context = context;
+    sub->callback = std::move(callback);
+    sub->typeMask = typeMask;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ListPtr current = find(key);
+        auto next = current ? std::make_shared<SubscriberList>(*current)
+                            : std::make_shared<SubscriberList>();
+        next->push_back(sub);
+        store(key, std::move(next));
+        m_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    return Subscription(this, std::move(sub));
+}
+
+void FeedDispatcher::remove(const SubscriberPtr& sub) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        SubscriberList removed;
+        strip(sub->key, find(sub->key),
+              [&sub](const SubscriberPtr& s) { return s == sub; }, removed);
+        m_count.fetch_sub(removed.size(), std::memory_order_relaxed);
+    }
+    deactivate(sub);
+}
+
+void FeedDispatcher::deactivate(const SubscriberPtr& sub) {
+    // Pairs with deliver(): a publisher either sees the flag cleared or is
+    // counted in flight here
+    sub->active.store(false, std::memory_order_seq_cst);
+    if (t_callbackDepth > 0) return;
+    while (sub->inFlight.load(std::memory_order_seq_cst) != 0) {
+        std::this_thread::yield();
+    }
+}
+
+void FeedDispatcher::unsubscribe(int64_t key, const QObject* context) {
+    SubscriberList removed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        strip(key, find(key),
+              [context](const SubscriberPtr& s) { return s->context == context; }, removed);
+        m_count.fetch_sub(removed.size(), std::memory_order_relaxed);
+    }
+    for (const auto& s : removed) deactivate(s);
+}
+
+void FeedDispatcher::unsubscribeAll(const QObject* context) {
+    if (!context) return;
+
+    SubscriberList removed;
+    auto matches = [context](const SubscriberPtr& s) { return s->context == context; };
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        strip(kAllTokens, find(kAllTokens), matches, removed);
+        for (size_t b = 0; b < kBuckets; ++b) {
+            // Our reference keeps the entries alive while strip() swaps the bucket
+            BucketPtr bucket = m_buckets[b].load(std::memory_order_relaxed);
+            if (!bucket) continue;
+            for (const auto& entry : *bucket) strip(entry.first, entry.second, matches, removed);
+        }
+        m_count.fetch_sub(removed.size(), std::memory_order_relaxed);
+    }
+    for (const auto& s : removed) deactivate(s);
+}
+
+// ============================================================================
+// Publish
+// ============================================================================
+
+void FeedDispatcher::deliver(const SubscriberPtr& sub, const UDP::MarketTick& tick) {
+    struct InFlight {
+        std::atomic<uint32_t>& count;
+        explicit InFlight(std::atomic<uint32_t>& c) : count(c) {
+            count.fetch_add(1, std::memory_order_seq_cst);
+        }
+        ~InFlight() { count.fetch_sub(1, std::memory_order_release); }
+    } inFlight(sub->inFlight);
+    if (!sub->active.load(std::memory_order_seq_cst)) return;
+
+    QObject* context = sub->context;
+    if (!context || context->thread() == QThread::currentThread()) {
+        struct Depth {
+            Depth() { ++t_callbackDepth; }
+            ~Depth() { --t_callbackDepth; }
+        } depth;
+        sub->callback(tick);
+        return;
+    }
+
+    // Cross-thread: hop to the context's event loop. Qt drops the call if
+    // the context is destroyed first; 'active' covers unsubscribe.
+    QMetaObject::invokeMethod(
+        context,
+        [sub, tick]() {
+            if (sub->active.load(std::memory_order_acquire)) sub->callback(tick);
+        },
+        Qt::QueuedConnection);
+}
+
+FeedDispatcher::Route FeedDispatcher::route(int64_t key) const {
+    Route r;
+    if (key != kAllTokens) r.m_subscribers = find(key);
+    r.m_allTokens = m_allTokens.load(std::memory_order_acquire);
+    return r;
+}
+
+size_t FeedDispatcher::Route::deliver(const UDP::MarketTick& tick) const {
+    const uint32_t bit = maskFor(tick.updateType);
+    size_t delivered = 0;
+    for (const ListPtr* list : {&m_subscribers, &m_allTokens}) {
+        if (!*list) continue;
+        for (const SubscriberPtr& sub : **list) {
+            if (!(sub->typeMask & bit)) continue;
+            FeedDispatcher::deliver(sub, tick);
+            ++delivered;
+        }
+    }
+    return delivered;
+}
+
+size_t FeedDispatcher::publish(const UDP::MarketTick& tick) {
+    const int64_t key = (static_cast<int64_t>(tick.exchangeSegment) << 32) |
+                        static_cast<uint32_t>(tick.token);
+    return route(key).deliver(tick);
+}
+
+bool FeedDispatcher::hasSubscribers(int64_t key) const {
+    return key != kAllTokens && find(key) != nullptr;
+}
+
+size_t FeedDispatcher::subscriberCount() const {
+    return m_count.load(std::memory_order_relaxed);
+}
@@ -24,34 +24,47 @@ void FeedHandler::registerTokenWithUdpService(uint32_t token, int segment) {
     XTSFeedBridge::instance().requestSubscribe(token, segment);
 }
 
-FeedHandler::~FeedHandler() {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    for (auto& pair : m_publishers) {
-        delete pair.second;
+FeedHandler::~FeedHandler() = default;
+
+void FeedHandler::registerKey(int exchangeSegment, int token) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_activeKeys.insert(makeKey(exchangeSegment, token));
     }
-    m_publishers.clear();
+    // Notify UDP service to enable filtering for this token
+    registerTokenWithUdpService(token, exchangeSegment);
+    emit subscriptionCountChanged(token, 1);
 }
 
-TokenPublisher* FeedHandler::getOrCreatePublisher(int64_t compositeKey) {
-    auto it = m_publishers.find(compositeKey);
-    if (it != m_publishers.end()) {
-        return it->second;
+void FeedHandler::watchReceiver(QObject* receiver) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_watchedReceivers.insert(receiver).second) return;
     }
+    // Qt used to drop the connections of a destroyed receiver; do the same
+    connect(receiver, &QObject::destroyed, this, [this, receiver]() {
+        m_dispatcher.unsubscribeAll(receiver);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_watchedReceivers.erase(receiver);
+    }, Qt::DirectConnection);
+}
 
-    TokenPublisher* pub = new TokenPublisher(compositeKey);
-    m_publishers[compositeKey] = pub;
-    return pub;
+ConflatedSubscription* FeedHandler::subscribeConflated(
+    QObject* context, const std::vector<int64_t>& keys, int maxRateHz,
+    ConflatedSubscription::BatchCallback callback, uint32_t typeMask) {
+    auto* subscription = new ConflatedSubscription(
+        m_dispatcher, maxRateHz, std::move(callback), typeMask,
+        [this](int64_t key) {
+            registerKey(static_cast<int>(key >> 32), static_cast<int>(key & 0xFFFFFFFF));
+        },
+        context);
+    subscription->setKeys(keys);
+    return subscription;
 }
 
 void FeedHandler::unsubscribe(int exchangeSegment, int token, QObject* receiver) {
     if (!receiver) return;
-    
-    int64_t key = makeKey(exchangeSegment, token);
-    std::lock_guard<std::mutex> lock(m_mutex);
-    auto it = m_publishers.find(key);
-    if (it != m_publishers.end()) {
-        disconnect(it->second, &TokenPublisher::udpTickUpdated, receiver, nullptr);
-    }
+    m_dispatcher.unsubscribe(makeKey(exchangeSegment, token), receiver);
 }
 
 void FeedHandler::unsubscribe(int token, QObject* receiver) {
@@ -59,31 +72,22 @@ void FeedHandler::unsubscribe(int token, QObject* receiver) {
     
     // Unsubscribe from all common segments
     static const int segments[] = {1, 2, 11, 12};
-    std::lock_guard<std::mutex> lock(m_mutex);
-    
     for (int seg : segments) {
-        int64_t key = makeKey(seg, token);
-        auto it = m_publishers.find(key);
-        if (it != m_publishers.end()) {
-            disconnect(it->second, &TokenPublisher::udpTickUpdated, receiver, nullptr);
-        }
+        m_dispatcher.unsubscribe(makeKey(seg, token), receiver);
     }
 }
 
 void FeedHandler::unsubscribeAll(QObject* receiver) {
     if (!receiver) return;
     
-    std::lock_guard<std::mutex> lock(m_mutex);
-    for (auto& pair : m_publishers) {
-        disconnect(pair.second, &TokenPublisher::udpTickUpdated, receiver, nullptr);
-    }
+    m_dispatcher.unsubscribeAll(receiver);
     qDebug() << "[FeedHandler] Disconnected all subscriptions for receiver" << receiver;
 }
 
 
 size_t FeedHandler::totalSubscriptions() const {
     std::lock_guard<std::mutex> lock(m_mutex);
-    return m_publishers.size();
+    return m_activeKeys.size();
 }
 
 void FeedHandler::reRegisterAllTokens() {
@@ -103,9 +107,9 @@ void FeedHandler::reRegisterAllTokens() {
 std::vector<std::pair<int, uint32_t>> FeedHandler::getActiveTokens() const {
     std::lock_guard<std::mutex> lock(m_mutex);
     std::vector<std::pair<int, uint32_t>> result;
-    result.reserve(m_publishers.size());
+    result.reserve(m_activeKeys.size());
 
-    for (const auto& [compositeKey, publisher] : m_publishers) {
+    for (int64_t compositeKey : m_activeKeys) {
         // Decompose composite key: (segment << 32) | token
         int segment = static_cast<int>(compositeKey >> 32);
         uint32_t token = static_cast<uint32_t>(compositeKey & 0xFFFFFFFF);
@@ -116,63 +120,21 @@ std::vector<std::pair<int, uint32_t>> FeedHandler::getActiveTokens() const {
 }
 
 void FeedHandler::onUdpTickReceived(const UDP::MarketTick& tick) {
-    int exchangeSegment = static_cast<int>(tick.exchangeSegment);
-    int token = tick.token;
-    int64_t key = makeKey(exchangeSegment, token);
-    
-    // 1. Mark FeedHandler processing timestamp
+    // Most ticks on the wire are for tokens nobody here watches; skip the
+    // copy below for those (subscribeAllTokens listeners still see them)
+    const int64_t key = makeKey(static_cast<int>(tick.exchangeSegment), tick.token);
+    const FeedDispatcher::Route route = m_dispatcher.route(key);
+    if (route.empty())
+        return;
+
+    // Mark FeedHandler processing timestamp
     UDP::MarketTick trackedTick = tick;
     trackedTick.timestampFeedHandler = LatencyTracker::now();
-    // If using zero-copy, tick is already complete (no back-propagation needed)
-    
-    // Debug logging for BSE tokens
-    if (exchangeSegment == 12 || exchangeSegment == 11) {
-        static int bseTickCount = 0;
-        if (bseTickCount++ < 20) {
-            // qDebug() << "[FeedHandler] BSE UDP Tick - Segment:" << exchangeSegment 
-            //          << "Token:" << token << "Key:" << key << "LTP:" << tick.ltp;
-        }
-    }
-    
-    TokenPublisher* pub = nullptr;
-    {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        auto it = m_publishers.find(key);
-        if (it != m_publishers.end()) {
-            pub = it->second;
-        } else {
-            // Log missing subscription for BSE tokens
-            if (exchangeSegment == 12 || exchangeSegment == 11) {
-                static int missingSubCount = 0;
-                if (missingSubCount++ < 10) {
-                    // qDebug() << "[FeedHandler] ⚠ No UDP subscriber for BSE - Segment:" << exchangeSegment
-                    //          << "Token:" << token << "Key:" << key;
-                }
-            }
-        }
-    }
+    LatencyTracker::recordFeedStages(static_cast<int>(tick.exchangeSegment),
+                                     tick.timestampUdpRecv, tick.timestampParsed,
+                                     tick.timestampEmitted,
+                                     trackedTick.timestampFeedHandler);
 
-    if (pub) {
-        pub->publish(trackedTick);
-    }
-    
-    // Emit type-specific signals for granular UI optimization
-    switch (trackedTick.updateType) {
-        case UDP::UpdateType::DEPTH_UPDATE:
-            emit depthUpdateReceived(trackedTick);
-            break;
-        case UDP::UpdateType::TRADE_TICK:
-            emit tradeUpdateReceived(trackedTick);
-            break;
-        case UDP::UpdateType::TOUCHLINE:
-            emit touchlineUpdateReceived(trackedTick);
-            break;
-        case UDP::UpdateType::MARKET_WATCH:
-            emit marketWatchReceived(trackedTick);
-            break;
-        default:
-            // For FULL_SNAPSHOT or UNKNOWN, also emit touchline as fallback
-            emit touchlineUpdateReceived(trackedTick);
-            break;
-    }
+    // Each subscriber filters on its update-type mask
+    route.deliver(trackedTick);
 }
@@ -14,6 +14,27 @@
 #include <QTime>
 #include <cmath>
 
+namespace {
+
+// Version of a row in the store this service reads it from (0 = untracked)
+uint64_t storeRowVersion(int exchangeSegment, uint32_t token) {
+  switch (exchangeSegment) {
+  case 1:
+    return nsecm::g_nseCmPriceStore.getRowVersion(token);
+  case 2:
+    return nsefo::g_nseFoPriceStore.getRowVersion(token);
+  case 11:
+    return bse::g_bseCmPriceStore.getRowVersion(token);
+  case 4:
+  case 12:
+    return bse::g_bseFoPriceStore.getRowVersion(token);
+  default:
+    return 0;
+  }
+}
+
+} // namespace
+
 // ============================================================================
 // SINGLETON INSTANCE
 // ============================================================================
@@ -175,20 +196,22 @@ GreeksResult GreeksCalculationService::calculateForToken(uint32_t token,
   int64_t lastTradeTime = 0;
 
   if (exchangeSegment == 2) { // NSEFO
-    auto state = nsefo::g_nseFoPriceStore.getUnifiedSnapshot(token);
-    if (state.token != 0) {
-      optionPrice = state.ltp;
-      bidPrice = state.bids[0].price;
-      askPrice = state.asks[0].price;
-      lastTradeTime = state.lastTradeTime;
+    auto tick = nsefo::g_nseFoPriceStore.getTouchline(token);
+    if (tick.token != 0) {
+      auto depth = nsefo::g_nseFoPriceStore.getDepth(token);
+      optionPrice = tick.ltp;
+      bidPrice = depth.bids[0].price;
+      askPrice = depth.asks[0].price;
+      lastTradeTime = tick.lastTradeTime;
     }
   } else if (exchangeSegment == 12) { // BSEFO
-    auto state = bse::g_bseFoPriceStore.getUnifiedSnapshot(token);
-    if (state.token != 0) {
-      optionPrice = state.ltp;
-      bidPrice = state.bids[0].price;
-      askPrice = state.asks[0].price;
-      lastTradeTime = state.lastTradeTime;
+    auto tick = bse::g_bseFoPriceStore.getTouchline(token);
+    if (tick.token != 0) {
+      auto depth = bse::g_bseFoPriceStore.getDepth(token);
+      optionPrice = tick.ltp;
+      bidPrice = depth.bids[0].price;
+      askPrice = depth.asks[0].price;
+      lastTradeTime = tick.lastTradeTime;
     }
   }
 
@@ -211,6 +234,9 @@ GreeksResult GreeksCalculationService::calculateForToken(uint32_t token,
 
   // Step 6: Get underlying price
   double underlyingPrice = 0.0;
+  int underlyingSegment = 0; // Tracked for the illiquid sweep (cash path)
+  uint32_t underlyingRowToken = 0;
+  uint64_t underlyingVersion = 0;
 
   // Try future-based pricing if configured
   if (m_config.basePriceMode == "future") {
@@ -240,6 +266,10 @@ GreeksResult GreeksCalculationService::calculateForToken(uint32_t token,
 
     // Fetch underlying price directly from cash market
     if (underlyingToken > 0 && exchangeSegment == 2) { // NSE FO
+      // Version before price: a write in between shows up as a change later
+      underlyingSegment = 1;
+      underlyingRowToken = underlyingToken;
+      underlyingVersion = storeRowVersion(1, underlyingToken);
       underlyingPrice = nsecm::getGenericLtp(underlyingToken);
 
       if (shouldLog) {
@@ -248,8 +278,10 @@ GreeksResult GreeksCalculationService::calculateForToken(uint32_t token,
                  << "Price:" << underlyingPrice;
       }
     } else if (underlyingToken > 0 && exchangeSegment == 4) { // BSE FO
-      auto spotState =
-          bse::g_bseCmPriceStore.getUnifiedSnapshot(underlyingToken);
+      underlyingSegment = 11;
+      underlyingRowToken = underlyingToken;
+      underlyingVersion = storeRowVersion(11, underlyingToken);
+      auto spotState = bse::g_bseCmPriceStore.getTouchline(underlyingToken);
       underlyingPrice = spotState.ltp;
 
       if (shouldLog) {
@@ -410,6 +442,9 @@ GreeksResult GreeksCalculationService::calculateForToken(uint32_t token,
   entry.lastPrice = optionPrice;
   entry.lastUnderlyingPrice = underlyingPrice;
   entry.lastTradeTimestamp = QDateTime::currentMSecsSinceEpoch();
+  entry.underlyingSegment = underlyingSegment;
+  entry.underlyingToken = underlyingRowToken;
+  entry.underlyingVersion = underlyingVersion;
 
   m_cache[token] = entry;
 
@@ -418,6 +453,12 @@ GreeksResult GreeksCalculationService::calculateForToken(uint32_t token,
   //          << "IV:" << result.impliedVolatility << "Delta:" << result.delta;
   emit greeksCalculated(token, exchangeSegment, result);
 
+  // Taken after the (direct) persistence slot wrote the Greeks into the
+  // option's row, so that write does not count as a change
+  auto cached = m_cache.find(token);
+  if (cached != m_cache.end())
+    cached.value().optionVersion = storeRowVersion(exchangeSegment, token);
+
   return result;
 }
 
@@ -544,13 +585,21 @@ void GreeksCalculationService::processIlliquidUpdates() {
 
     // Process only if ILLIQUID (> 30s since last option trade)
     if ((now - lastTradeTime) > cutoff) {
-
-      // Check if underlying moved significantly since last calc to avoid
-      // useless work (Optional optimization: reusing shouldRecalculate logic
-      // implicitly via calculateForToken)
+      const CacheEntry &entry = it.value();
+
+      // Neither the option row nor its underlying row written since the last
+      // calculation: the cached result still holds (two atomic loads, no
+      // snapshot copies). Time decay is onTimeTick's job.
+      bool unchanged =
+          entry.optionVersion != 0 && entry.underlyingSegment != 0 &&
+          storeRowVersion(entry.result.exchangeSegment, it.key()) ==
+              entry.optionVersion &&
+          storeRowVersion(entry.underlyingSegment, entry.underlyingToken) ==
+              entry.underlyingVersion;
 
       // Force calculation (using Cached IV + Current Spot)
-      calculateForToken(it.key(), it.value().result.exchangeSegment);
+      if (!unchanged)
+        calculateForToken(it.key(), entry.result.exchangeSegment);
     }
     ++it;
   }
@@ -606,7 +655,7 @@ double GreeksCalculationService::getUnderlyingPrice(uint32_t optionToken,
 
   if (exchangeSegment == 2) { // NSEFO
     // Try futures price first
-    auto futureState = nsefo::g_nseFoPriceStore.getUnifiedSnapshot(
+    auto futureState = nsefo::g_nseFoPriceStore.getTouchline(
         static_cast<uint32_t>(underlyingToken));
 
     if (shouldLog) {
@@ -633,14 +682,14 @@ double GreeksCalculationService::getUnderlyingPrice(uint32_t optionToken,
     }
   } else if (exchangeSegment == 12) { // BSEFO
     // Try futures first
-    auto futureState = bse::g_bseFoPriceStore.getUnifiedSnapshot(
+    auto futureState = bse::g_bseFoPriceStore.getTouchline(
         static_cast<uint32_t>(underlyingToken));
     if (futureState.token != 0 && futureState.ltp > 0) {
       return futureState.ltp;
     }
 
     // Fallback to cash market
-    auto cashState = bse::g_bseCmPriceStore.getUnifiedSnapshot(
+    auto cashState = bse::g_bseCmPriceStore.getTouchline(
         static_cast<uint32_t>(underlyingToken));
     if (cashState.token != 0 && cashState.ltp > 0) {
       return cashState.ltp;
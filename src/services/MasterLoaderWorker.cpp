@@ -154,6 +154,11 @@ void MasterLoaderWorker::run()
             }
             
             if (success) {
+                // No usable snapshot this time: write one for the next start
+                if (!repo->loadedFromSnapshot()) {
+                    repo->saveSnapshot(mastersDir);
+                }
+
                 int count = repo->getTotalContractCount();
                 qDebug() << "[MasterLoaderWorker] Successfully loaded" << count << "contracts from cache";
                 emit loadingProgress(100, "Cache loaded successfully");
@@ -188,8 +193,9 @@ void MasterLoaderWorker::run()
             emit loadingProgress(30, "Loading master contracts...");
             qDebug() << "[MasterLoaderWorker] Loading masters into RepositoryManager...";
             
-            // Load the saved file (thread-safe operation)
-            bool success = repo->loadAll(mastersDir);
+            // Intraday re-login: apply only the changed rows when the loaded
+            // masters allow it, else load the saved file (thread-safe operation)
+            bool success = repo->refreshFromMemory(csvData) || repo->loadAll(mastersDir);
             
             if (isCancelled()) {
                 emit loadingFailed("Operation cancelled");
@@ -232,8 +238,9 @@ void MasterLoaderWorker::run()
                 return;
             }
             
-            // Load directly from memory into RepositoryManager (no file I/O)
-            bool success = repo->loadFromMemory(csvData);
+            // Load directly from memory into RepositoryManager (no file I/O):
+            // only the changed rows when the loaded masters allow a refresh
+            bool success = repo->refreshFromMemory(csvData) || repo->loadFromMemory(csvData);
             
             if (isCancelled()) {
                 emit loadingFailed("Operation cancelled");
@@ -5,11 +5,16 @@
 #include "nsecm_price_store.h"
 #include "nsefo_callback.h"
 #include "nsefo_price_store.h"
+#include "parse_shard.h"
 #include "services/FeedHandler.h"
 #include "services/GreeksCalculationService.h"
 #include "utils/LatencyTracker.h"
+#include <QDateTime>
 #include <QDebug>
+#include <QDir>
 #include <QMetaObject>
+#include <QTimer>
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 #include <thread>
@@ -18,9 +23,11 @@
 
 namespace {
 
-// Convert NSE FO Unified State to UDP::MarketTick
+// Convert NSE FO touchline + depth blocks to UDP::MarketTick. parsedAt is
+// taken by the callback, which the parser calls once the store is updated.
 UDP::MarketTick convertNseFoUnified(
-    const nsefo::UnifiedTokenState &data,
+    const MarketData::TouchlineState &data, const MarketData::DepthState &depth,
+    int64_t parsedAt,
     UDP::UpdateType updateType = UDP::UpdateType::FULL_SNAPSHOT) {
   UDP::MarketTick tick(UDP::ExchangeSegment::NSEFO, data.token);
   tick.ltp = data.ltp;
@@ -34,20 +41,20 @@ UDP::MarketTick convertNseFoUnified(
 
   // Depth
   for (int i = 0; i < 5; i++) {
-    tick.bids[i] = UDP::DepthLevel(data.bids[i].price, data.bids[i].quantity,
-                                   data.bids[i].orders);
-    tick.asks[i] = UDP::DepthLevel(data.asks[i].price, data.asks[i].quantity,
-                                   data.asks[i].orders);
+    tick.bids[i] = UDP::DepthLevel(depth.bids[i].price, depth.bids[i].quantity,
+                                   depth.bids[i].orders);
+    tick.asks[i] = UDP::DepthLevel(depth.asks[i].price, depth.asks[i].quantity,
+                                   depth.asks[i].orders);
   }
 
-  tick.totalBidQty = data.totalBuyQty;
-  tick.totalAskQty = data.totalSellQty;
+  tick.totalBidQty = depth.totalBuyQty;
+  tick.totalAskQty = depth.totalSellQty;
 
   tick.openInterest = data.openInterest;
 
   tick.refNo = 0;
   tick.timestampUdpRecv = data.lastPacketTimestamp;
-  tick.timestampParsed = data.lastPacketTimestamp;
+  tick.timestampParsed = parsedAt;
   tick.timestampEmitted = LatencyTracker::now();
   tick.messageType = 7200;
 
@@ -80,9 +87,11 @@ UDP::MarketTick convertNseFoDepth(const nsefo::MarketDepthData &data) {
   return tick;
 }
 
-// Convert NSE CM Unified State to UDP::MarketTick
+// Convert NSE CM touchline + depth blocks to UDP::MarketTick (parsedAt as
+// for convertNseFoUnified)
 UDP::MarketTick convertNseCmUnified(
-    const nsecm::UnifiedTokenState &data,
+    const MarketData::TouchlineState &data, const MarketData::DepthState &depth,
+    int64_t parsedAt,
     UDP::UpdateType updateType = UDP::UpdateType::FULL_SNAPSHOT) {
   UDP::MarketTick tick(UDP::ExchangeSegment::NSECM, data.token);
   tick.ltp = data.ltp;
@@ -96,18 +105,18 @@ UDP::MarketTick convertNseCmUnified(
 
   // Depth
   for (int i = 0; i < 5; i++) {
-    tick.bids[i] = UDP::DepthLevel(data.bids[i].price, data.bids[i].quantity,
-                                   data.bids[i].orders);
-    tick.asks[i] = UDP::DepthLevel(data.asks[i].price, data.asks[i].quantity,
-                                   data.asks[i].orders);
+    tick.bids[i] = UDP::DepthLevel(depth.bids[i].price, depth.bids[i].quantity,
+                                   depth.bids[i].orders);
+    tick.asks[i] = UDP::DepthLevel(depth.asks[i].price, depth.asks[i].quantity,
+                                   depth.asks[i].orders);
   }
 
-  tick.totalBidQty = data.totalBuyQty;
-  tick.totalAskQty = data.totalSellQty;
+  tick.totalBidQty = depth.totalBuyQty;
+  tick.totalAskQty = depth.totalSellQty;
 
   tick.refNo = 0;
   tick.timestampUdpRecv = data.lastPacketTimestamp;
-  tick.timestampParsed = data.lastPacketTimestamp;
+  tick.timestampParsed = parsedAt;
   tick.timestampEmitted = LatencyTracker::now();
   tick.messageType = 7200;
 
@@ -158,10 +167,12 @@ UDP::MarketTick convertNseCmDepth(const nsecm::MarketDepthData &data) {
   return tick;
 }
 
-// Convert BSE Unified State to UDP::MarketTick
+// Convert BSE touchline + depth blocks to UDP::MarketTick (parsedAt as for
+// convertNseFoUnified)
 UDP::MarketTick
-convertBseUnified(const bse::UnifiedTokenState &data,
-                  UDP::ExchangeSegment segment,
+convertBseUnified(const MarketData::TouchlineState &data,
+                  const MarketData::DepthState &depth,
+                  UDP::ExchangeSegment segment, int64_t parsedAt,
                   UDP::UpdateType updateType = UDP::UpdateType::FULL_SNAPSHOT) {
   UDP::MarketTick tick(segment, data.token);
   tick.ltp = data.ltp;
@@ -175,14 +186,14 @@ convertBseUnified(const bse::UnifiedTokenState &data,
 
   // Depth
   for (int i = 0; i < 5; i++) {
-    tick.bids[i] = UDP::DepthLevel(data.bids[i].price, data.bids[i].quantity,
-                                   data.bids[i].orders);
-    tick.asks[i] = UDP::DepthLevel(data.asks[i].price, data.asks[i].quantity,
-                                   data.asks[i].orders);
+    tick.bids[i] = UDP::DepthLevel(depth.bids[i].price, depth.bids[i].quantity,
+                                   depth.bids[i].orders);
+    tick.asks[i] = UDP::DepthLevel(depth.asks[i].price, depth.asks[i].quantity,
+                                   depth.asks[i].orders);
   }
 
-  tick.totalBidQty = data.totalBuyQty;
-  tick.totalAskQty = data.totalSellQty;
+  tick.totalBidQty = depth.totalBuyQty;
+  tick.totalAskQty = depth.totalSellQty;
 
   tick.openInterest = data.openInterest;
   tick.oiChange = data.openInterestChange;
@@ -191,7 +202,7 @@ convertBseUnified(const bse::UnifiedTokenState &data,
 
   tick.refNo = 0;
   tick.timestampUdpRecv = data.lastPacketTimestamp;
-  tick.timestampParsed = data.lastPacketTimestamp;
+  tick.timestampParsed = parsedAt;
   tick.timestampEmitted = LatencyTracker::now();
   tick.messageType = 2020; // Generic Market Picture logic
 
@@ -439,6 +450,104 @@ void UdpBroadcastService::setSubscriptionFilterEnabled(bool enabled) {
   }
 }
 
+// ========== TICK HAND-OFF (receiver thread → GUI thread) ==========
+
+size_t UdpBroadcastService::ringIndex(ExchangeReceiver source) {
+  switch (source) {
+  case ExchangeReceiver::NSEFO:
+    return 0;
+  case ExchangeReceiver::NSECM:
+    return 1;
+  case ExchangeReceiver::BSEFO:
+    return 2;
+  case ExchangeReceiver::BSECM:
+    return 3;
+  default:
+    return 4;
+  }
+}
+
+void UdpBroadcastService::publishTick(ExchangeReceiver source,
+                                      const UDP::MarketTick &tick) {
+  const size_t idx = ringIndex(source);
+  TickRing *ring = idx < m_tickRings.size() ? m_tickRings[idx].get() : nullptr;
+  if (idx == 0 && !m_nseFoShardRings.empty()) {
+    // Sharded NSE FO parsing: each parse worker has its own ring
+    const uint32_t shard = nsefo::shard::current().index;
+    if (shard > 0 && shard <= m_nseFoShardRings.size())
+      ring = m_nseFoShardRings[shard - 1].get();
+  }
+  if (!ring) {
+    deliverTick(tick);
+    return;
+  }
+  // Full ring: drop rather than block the socket. The price store already
+  // holds the latest state, so the row catches up on its next tick.
+  if (!ring->tryPush(tick)) {
+    m_tickDrops[idx].fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void UdpBroadcastService::deliverTick(const UDP::MarketTick &tick) {
+  FeedHandler::instance().onUdpTickReceived(tick);
+
+  if (shouldEmitSignal(tick.token)) {
+    emit udpTickReceived(tick);
+  }
+}
+
+void UdpBroadcastService::startTickPump() {
+  QMetaObject::invokeMethod(this, [this]() {
+    if (!m_pumpTimer) {
+      m_pumpTimer = new QTimer(this);
+      m_pumpTimer->setTimerType(Qt::PreciseTimer);
+      connect(m_pumpTimer, &QTimer::timeout, this,
+              &UdpBroadcastService::pumpTicks);
+    }
+    m_pumpTimer->setInterval(std::max(1, m_lastConfig.pumpIntervalMs));
+    if (!m_pumpTimer->isActive())
+      m_pumpTimer->start();
+  });
+}
+
+void UdpBroadcastService::pumpTicks() {
+  // 1. Drain every ring, keeping only the latest tick per (segment, token).
+  //    Ticks carry the full merged row, so the newest one is the state;
+  //    validFlags are OR-ed so a depth tick superseded by a trade tick
+  //    still reports depth as valid.
+  //    A token always comes from the same ring, so per-token order holds
+  //    across the NSE FO shard rings too.
+  auto coalesce = [this](const UDP::MarketTick &tick) {
+    const int64_t key =
+        (static_cast<int64_t>(tick.exchangeSegment) << 32) | tick.token;
+    auto [it, inserted] =
+        m_pendingIndex.try_emplace(key, m_pendingTicks.size());
+    if (inserted) {
+      m_pendingTicks.push_back(tick);
+      return;
+    }
+    UDP::MarketTick &latest = m_pendingTicks[it->second];
+    const uint32_t flags = latest.validFlags | tick.validFlags;
+    latest = tick;
+    latest.validFlags = flags;
+    m_coalescedTicks.fetch_add(1, std::memory_order_relaxed);
+  };
+  for (auto &ring : m_tickRings) {
+    if (ring)
+      ring->drain(coalesce);
+  }
+  for (auto &ring : m_nseFoShardRings) {
+    ring->drain(coalesce);
+  }
+
+  // 2. Fan out on the GUI thread: direct calls, no queued-signal copies
+  for (const auto &tick : m_pendingTicks) {
+    deliverTick(tick);
+  }
+  m_pendingTicks.clear();
+  m_pendingIndex.clear();
+}
+
 // ========== CALLBACK SETUP ==========
 
 void UdpBroadcastService::setupNseFoCallbacks() {
@@ -451,146 +560,118 @@ void UdpBroadcastService::setupNseFoCallbacks() {
 
   // ========== TYPE-SPECIFIC CALLBACKS FOR GRANULAR EVENTS ==========
 
-  // Touchline Callback (7200) - BBO + basic stats
-  auto touchlineCallback = [this](int32_t token, int exchangeSegment,
-                                  uint16_t messageType) {
-    auto data = nsefo::g_nseFoPriceStore.getUnifiedSnapshot(token);
-    if (data.token == 0)
-      return;
-
-    // Convert with TOUCHLINE update type
-    UDP::MarketTick udpTick =
-        convertNseFoUnified(data, UDP::UpdateType::TOUCHLINE);
-    udpTick.messageType = messageType;
-    udpTick.validFlags = UDP::VALID_LTP | UDP::VALID_BID_TOP |
-                         UDP::VALID_ASK_TOP | UDP::VALID_OHLC |
-                         UDP::VALID_VOLUME | UDP::VALID_PREV_CLOSE;
+  // Parse-once tick callback (7200, 7208, 7202, 17202). The parser has
+  // already applied the delta and copied the merged row out in the same
+  // seqlock write, so there is no snapshot read here.
+  auto tickDeltaCallback = [this](const nsefo::TickDelta &delta,
+                                  const MarketData::TouchlineState &data,
+                                  const MarketData::DepthState &depth) {
+    const int64_t parsedAt = LatencyTracker::now();
+    const int exchangeSegment = 2;
+    const bool isTouchline = delta.has(nsefo::TickDelta::TOUCHLINE);
+
+    // TOUCHLINE for 7200/7208 (BBO + basic stats), TRADE_TICK for 7202/17202
+    UDP::MarketTick udpTick = convertNseFoUnified(
+        data, depth, parsedAt,
+        isTouchline ? UDP::UpdateType::TOUCHLINE : UDP::UpdateType::TRADE_TICK);
+    udpTick.messageType = delta.messageType;
+    udpTick.validFlags =
+        isTouchline ? (UDP::VALID_LTP | UDP::VALID_BID_TOP | UDP::VALID_ASK_TOP |
+                       UDP::VALID_OHLC | UDP::VALID_VOLUME |
+                       UDP::VALID_PREV_CLOSE)
+                    : (UDP::VALID_LTP | UDP::VALID_VOLUME | UDP::VALID_OI);
     m_totalTicks++;
 
-    FeedHandler::instance().onUdpTickReceived(udpTick);
+    publishTick(ExchangeReceiver::NSEFO, udpTick);
 
     // Greeks calculation for every feed update (including zero-premium options)
     auto &greeksService = GreeksCalculationService::instance();
     if (greeksService.isEnabled()) {
-      greeksService.onPriceUpdate(token, data.ltp, exchangeSegment);
-      greeksService.onUnderlyingPriceUpdate(token, data.ltp, exchangeSegment);
-    }
-
-    if (shouldEmitSignal(token)) {
-      emit udpTickReceived(udpTick);
+      std::lock_guard<std::mutex> lock(m_nseFoGreeksMutex);
+      greeksService.onPriceUpdate(delta.token, data.ltp, exchangeSegment);
+      greeksService.onUnderlyingPriceUpdate(delta.token, data.ltp,
+                                            exchangeSegment);
     }
   };
 
   // Depth Callback (7208) - Order book depth only
   auto depthCallback = [this](int32_t token, int exchangeSegment,
                               uint16_t messageType) {
-    auto data = nsefo::g_nseFoPriceStore.getUnifiedSnapshot(token);
+    const int64_t parsedAt = LatencyTracker::now();
+    auto data = nsefo::g_nseFoPriceStore.getTouchline(token);
     if (data.token == 0)
       return;
+    auto depth = nsefo::g_nseFoPriceStore.getDepth(token);
 
     // Convert with DEPTH_UPDATE type
     UDP::MarketTick udpTick =
-        convertNseFoUnified(data, UDP::UpdateType::DEPTH_UPDATE);
+        convertNseFoUnified(data, depth, parsedAt,
+                            UDP::UpdateType::DEPTH_UPDATE);
     udpTick.messageType = messageType;
     udpTick.validFlags =
         UDP::VALID_DEPTH | UDP::VALID_BID_TOP | UDP::VALID_ASK_TOP;
     m_totalTicks++;
 
-    FeedHandler::instance().onUdpTickReceived(udpTick);
+    publishTick(ExchangeReceiver::NSEFO, udpTick);
 
     // Note: Depth-only updates should NOT trigger Greeks (LTP unchanged)
-
-    if (shouldEmitSignal(token)) {
-      emit udpTickReceived(udpTick);
-    }
-  };
-
-  // Ticker Callback (7202, 17202) - LTP, volume, OI updates
-  auto tickerCallback = [this](int32_t token, int exchangeSegment,
-                               uint16_t messageType) {
-    auto data = nsefo::g_nseFoPriceStore.getUnifiedSnapshot(token);
-    if (data.token == 0)
-      return;
-
-    // Convert with TRADE_TICK type
-    UDP::MarketTick udpTick =
-        convertNseFoUnified(data, UDP::UpdateType::TRADE_TICK);
-    udpTick.messageType = messageType;
-    udpTick.validFlags = UDP::VALID_LTP | UDP::VALID_VOLUME | UDP::VALID_OI;
-    m_totalTicks++;
-
-    FeedHandler::instance().onUdpTickReceived(udpTick);
-
-    // Ticker updates trigger Greeks (price changed, including zero-premium)
-    auto &greeksService = GreeksCalculationService::instance();
-    if (greeksService.isEnabled()) {
-      greeksService.onPriceUpdate(token, data.ltp, exchangeSegment);
-      greeksService.onUnderlyingPriceUpdate(token, data.ltp, exchangeSegment);
-    }
-
-    if (shouldEmitSignal(token)) {
-      emit udpTickReceived(udpTick);
-    }
   };
 
   // Register type-specific callbacks
-  nsefo::MarketDataCallbackRegistry::instance().registerTouchlineCallback(
-      touchlineCallback);
+  nsefo::MarketDataCallbackRegistry::instance().registerTickDeltaCallback(
+      tickDeltaCallback);
   nsefo::MarketDataCallbackRegistry::instance().registerMarketDepthCallback(
       depthCallback);
-  nsefo::MarketDataCallbackRegistry::instance().registerTickerCallback(
-      tickerCallback);
 
   // Market Watch (7201, 17201) - Enhanced market watch callback
   // Note: Enhanced market watch (17201) provides 3-level depth data
   nsefo::MarketDataCallbackRegistry::instance().registerMarketWatchCallback(
       [this](const nsefo::MarketWatchData &data) {
+        const int64_t parsedAt = LatencyTracker::now();
         int32_t token = data.token;
-        auto stateData = nsefo::g_nseFoPriceStore.getUnifiedSnapshot(token);
+        auto stateData = nsefo::g_nseFoPriceStore.getTouchline(token);
         if (stateData.token == 0)
           return;
+        auto depth = nsefo::g_nseFoPriceStore.getDepth(token);
 
         // Convert with MARKET_WATCH type
         UDP::MarketTick udpTick =
-            convertNseFoUnified(stateData, UDP::UpdateType::MARKET_WATCH);
+            convertNseFoUnified(stateData, depth, parsedAt,
+                                UDP::UpdateType::MARKET_WATCH);
         udpTick.messageType = 7201;
         udpTick.validFlags =
             UDP::VALID_ALL; // Market watch has comprehensive data
         m_totalTicks++;
 
-        FeedHandler::instance().onUdpTickReceived(udpTick);
+        publishTick(ExchangeReceiver::NSEFO, udpTick);
 
         // Market watch triggers Greeks for comprehensive data updates
         auto &greeksService = GreeksCalculationService::instance();
         if (greeksService.isEnabled()) {
+          std::lock_guard<std::mutex> lock(m_nseFoGreeksMutex);
           greeksService.onPriceUpdate(token, stateData.ltp, 2 /*NSEFO*/);
           greeksService.onUnderlyingPriceUpdate(token, stateData.ltp,
                                                 2 /*NSEFO*/);
         }
-
-        if (shouldEmitSignal(token)) {
-          emit udpTickReceived(udpTick);
-        }
       });
 
   // Circuit Limit (7220) - Circuit limit updates
   auto circuitCallback = [this](int32_t token, int exchangeSegment,
                                 uint16_t messageType) {
-    auto data = nsefo::g_nseFoPriceStore.getUnifiedSnapshot(token);
+    const int64_t parsedAt = LatencyTracker::now();
+    auto data = nsefo::g_nseFoPriceStore.getTouchline(token);
     if (data.token == 0)
       return;
+    auto depth = nsefo::g_nseFoPriceStore.getDepth(token);
 
     UDP::MarketTick udpTick =
-        convertNseFoUnified(data, UDP::UpdateType::CIRCUIT_LIMIT);
+        convertNseFoUnified(data, depth, parsedAt,
+                            UDP::UpdateType::CIRCUIT_LIMIT);
     udpTick.messageType = messageType;
     udpTick.validFlags = UDP::VALID_LTP;
     m_totalTicks++;
 
-    FeedHandler::instance().onUdpTickReceived(udpTick);
-
-    if (shouldEmitSignal(token)) {
-      emit udpTickReceived(udpTick);
-    }
+    publishTick(ExchangeReceiver::NSEFO, udpTick);
   };
 
   nsefo::MarketDataCallbackRegistry::instance().registerCircuitLimitCallback(
@@ -628,12 +709,13 @@ void UdpBroadcastService::setupNseCmCallbacks() {
   auto unifiedCallback = [this](int32_t token, int exchangeSegment, uint16_t
   messageType) {
     // 1. Fetch thread-safe snapshot from global CM store
-    auto data = nsecm::g_nseCmPriceStore.getUnifiedSnapshot(token);
+    auto data = nsecm::g_nseCmPriceStore.getTouchline(token);
     if (data.token == 0)
       return;
+    auto depth = nsecm::g_nseCmPriceStore.getDepth(token);
 
     // 2. Convert to UDP::MarketTick
-    UDP::MarketTick udpTick = convertNseCmUnified(data);
+    UDP::MarketTick udpTick = convertNseCmUnified(data, depth);
     udpTick.messageType = messageType;
     m_totalTicks++;
 
@@ -670,78 +752,73 @@ void UdpBroadcastService::setupNseCmCallbacks() {
   // Touchline Callback (7200) - BBO + basic stats
   auto touchlineCallback = [this](int32_t token, int exchangeSegment,
                                   uint16_t messageType) {
-    auto data = nsecm::g_nseCmPriceStore.getUnifiedSnapshot(token);
+    const int64_t parsedAt = LatencyTracker::now();
+    auto data = nsecm::g_nseCmPriceStore.getTouchline(token);
     if (data.token == 0)
       return;
+    auto depth = nsecm::g_nseCmPriceStore.getDepth(token);
 
     UDP::MarketTick udpTick =
-        convertNseCmUnified(data, UDP::UpdateType::TOUCHLINE);
+        convertNseCmUnified(data, depth, parsedAt, UDP::UpdateType::TOUCHLINE);
     udpTick.messageType = messageType;
     udpTick.validFlags = UDP::VALID_LTP | UDP::VALID_BID_TOP |
                          UDP::VALID_ASK_TOP | UDP::VALID_OHLC |
                          UDP::VALID_VOLUME | UDP::VALID_PREV_CLOSE;
     m_totalTicks++;
 
-    FeedHandler::instance().onUdpTickReceived(udpTick);
+    publishTick(ExchangeReceiver::NSECM, udpTick);
 
     // Greeks for underlyings in cash market
     auto &greeksService = GreeksCalculationService::instance();
     if (greeksService.isEnabled()) {
       greeksService.onUnderlyingPriceUpdate(token, data.ltp, exchangeSegment);
     }
-
-    if (shouldEmitSignal(token)) {
-      emit udpTickReceived(udpTick);
-    }
   };
 
   // Depth Callback (7208) - Order book depth only
   auto depthCallback = [this](int32_t token, int exchangeSegment,
                               uint16_t messageType) {
-    auto data = nsecm::g_nseCmPriceStore.getUnifiedSnapshot(token);
+    const int64_t parsedAt = LatencyTracker::now();
+    auto data = nsecm::g_nseCmPriceStore.getTouchline(token);
     if (data.token == 0)
       return;
+    auto depth = nsecm::g_nseCmPriceStore.getDepth(token);
 
     UDP::MarketTick udpTick =
-        convertNseCmUnified(data, UDP::UpdateType::DEPTH_UPDATE);
+        convertNseCmUnified(data, depth, parsedAt,
+                            UDP::UpdateType::DEPTH_UPDATE);
     udpTick.messageType = messageType;
     udpTick.validFlags =
         UDP::VALID_DEPTH | UDP::VALID_BID_TOP | UDP::VALID_ASK_TOP;
     m_totalTicks++;
 
-    FeedHandler::instance().onUdpTickReceived(udpTick);
+    publishTick(ExchangeReceiver::NSECM, udpTick);
 
     // No Greeks trigger for depth-only updates
-
-    if (shouldEmitSignal(token)) {
-      emit udpTickReceived(udpTick);
-    }
   };
 
   // Ticker Callback (18703) - LTP, volume updates
   auto tickerCallback = [this](int32_t token, int exchangeSegment,
                                uint16_t messageType) {
-    auto data = nsecm::g_nseCmPriceStore.getUnifiedSnapshot(token);
+    const int64_t parsedAt = LatencyTracker::now();
+    auto data = nsecm::g_nseCmPriceStore.getTouchline(token);
     if (data.token == 0)
       return;
+    auto depth = nsecm::g_nseCmPriceStore.getDepth(token);
 
     UDP::MarketTick udpTick =
-        convertNseCmUnified(data, UDP::UpdateType::TRADE_TICK);
+        convertNseCmUnified(data, depth, parsedAt, UDP::UpdateType::TRADE_TICK);
     udpTick.messageType = messageType;
     udpTick.validFlags = UDP::VALID_LTP | UDP::VALID_VOLUME;
     m_totalTicks++;
 
-    FeedHandler::instance().onUdpTickReceived(udpTick);
+    publishTick(ExchangeReceiver::NSECM, udpTick);
 
     // Ticker updates trigger Greeks for underlyings
     auto &greeksService = GreeksCalculationService::instance();
     if (greeksService.isEnabled()) {
       greeksService.onUnderlyingPriceUpdate(token, data.ltp, exchangeSegment);
     }
-
-    if (shouldEmitSignal(token)) {
-      emit udpTickReceived(udpTick);
-    }
   };
 
   // Register type-specific callbacks
@@ -829,7 +906,7 @@ void UdpBroadcastService::setupNseCmCallbacks() {
             mTick.prevClose = tick.prevClose;
             mTick.volume = 0; // Indices don't have volume in 7207
 
-            FeedHandler::instance().onUdpTickReceived(mTick);
+            publishTick(ExchangeReceiver::NSECM, mTick);
           }
         }
       });
@@ -913,16 +990,18 @@ void UdpBroadcastService::setupBseFoCallbacks() {
 
   auto unifiedCallback = [this](uint32_t token, int exchangeSegment,
                                 uint16_t messageType) {
-    auto data = bse::g_bseFoPriceStore.getUnifiedSnapshot(token);
+    const int64_t parsedAt = LatencyTracker::now();
+    auto data = bse::g_bseFoPriceStore.getTouchline(token);
     if (data.token == 0)
       return;
+    auto depth = bse::g_bseFoPriceStore.getDepth(token);
 
     UDP::MarketTick udpTick =
-        convertBseUnified(data, UDP::ExchangeSegment::BSEFO);
+        convertBseUnified(data, depth, UDP::ExchangeSegment::BSEFO, parsedAt);
     udpTick.messageType = messageType;
     m_totalTicks++;
 
-    FeedHandler::instance().onUdpTickReceived(udpTick);
+    publishTick(ExchangeReceiver::BSEFO, udpTick);
 
     // Greeks Calculation for option contracts (including zero-premium)
     auto &greeksService = GreeksCalculationService::instance();
@@ -933,8 +1012,6 @@ void UdpBroadcastService::setupBseFoCallbacks() {
     }
 
     if (shouldEmitSignal(token)) {
-      emit udpTickReceived(udpTick);
-
       // Check Circuit Limits from Unified Data
       if (data.upperCircuit > 0 || data.lowerCircuit > 0) {
         UDP::CircuitLimitTick limitTick;
@@ -966,16 +1043,18 @@ void UdpBroadcastService::setupBseCmCallbacks() {
 
   auto unifiedCallback = [this](uint32_t token, int exchangeSegment,
                                 uint16_t messageType) {
-    auto data = bse::g_bseCmPriceStore.getUnifiedSnapshot(token);
+    const int64_t parsedAt = LatencyTracker::now();
+    auto data = bse::g_bseCmPriceStore.getTouchline(token);
     if (data.token == 0)
       return;
+    auto depth = bse::g_bseCmPriceStore.getDepth(token);
 
     UDP::MarketTick udpTick =
-        convertBseUnified(data, UDP::ExchangeSegment::BSECM);
+        convertBseUnified(data, depth, UDP::ExchangeSegment::BSECM, parsedAt);
     udpTick.messageType = messageType;
     m_totalTicks++;
 
-    FeedHandler::instance().onUdpTickReceived(udpTick);
+    publishTick(ExchangeReceiver::BSECM, udpTick);
 
     // Greeks Calculation for underlyings in Cash Market
     auto &greeksService = GreeksCalculationService::instance();
@@ -984,8 +1063,6 @@ void UdpBroadcastService::setupBseCmCallbacks() {
     }
 
     if (shouldEmitSignal(token)) {
-      emit udpTickReceived(udpTick);
-
       if (data.upperCircuit > 0 || data.lowerCircuit > 0) {
         UDP::CircuitLimitTick limitTick;
         limitTick.token = token;
@@ -1024,6 +1101,8 @@ void UdpBroadcastService::start(const Config &config) {
 
   m_lastConfig = config;
   qDebug() << "[UdpBroadcastService] Initializing broadcast segments...";
+  MarketData::PriceStoreGateway::instance().setInterestFilter(
+      config.interestFilter, config.fullMarketStore);
 
   try {
     bool anyEnabled = false;
@@ -1084,6 +1163,10 @@ void UdpBroadcastService::start(const Config &config) {
 bool UdpBroadcastService::startReceiver(ExchangeReceiver receiver,
                                         const std::string &ip, int port) {
   try {
+    // The ring must exist before the receiver thread starts producing
+    prepareTickRing(receiver);
+    const std::string capture = capturePath(receiver);
+
     switch (receiver) {
     case ExchangeReceiver::NSEFO: {
       if (m_nseFoActive) {
@@ -1091,6 +1174,14 @@ bool UdpBroadcastService::startReceiver(ExchangeReceiver receiver,
         return true;
       }
       m_nseFoReceiver = std::make_unique<nsefo::MulticastReceiver>(ip, port);
+      m_nseFoReceiver->setBatchedIngest(
+          m_lastConfig.batchedIngest,
+          static_cast<size_t>(std::max(1, m_lastConfig.ingestBatchSize)));
+      m_nseFoReceiver->setParseWorkers(
+          static_cast<size_t>(std::max(0, m_lastConfig.nseFoParseWorkers)),
+          m_lastConfig.nseFoParseCores, m_lastConfig.nseFoReceiveCore);
+      if (!capture.empty())
+        m_nseFoReceiver->startCapture(capture);
       if (m_nseFoReceiver->isValid()) {
         setupNseFoCallbacks();
         m_nseFoThread = std::thread([this]() {
@@ -1118,6 +1209,11 @@ bool UdpBroadcastService::startReceiver(ExchangeReceiver receiver,
         return true;
       }
       m_nseCmReceiver = std::make_unique<nsecm::MulticastReceiver>(ip, port);
+      m_nseCmReceiver->setBatchedIngest(
+          m_lastConfig.batchedIngest,
+          static_cast<size_t>(std::max(1, m_lastConfig.ingestBatchSize)));
+      if (!capture.empty())
+        m_nseCmReceiver->startCapture(capture);
       if (m_nseCmReceiver->isValid()) {
         setupNseCmCallbacks();
         m_nseCmThread = std::thread([this]() {
@@ -1145,6 +1241,11 @@ bool UdpBroadcastService::startReceiver(ExchangeReceiver receiver,
         return true;
       }
       m_bseFoReceiver = std::make_unique<bse::BSEReceiver>(ip, port, "BSEFO");
+      m_bseFoReceiver->setBatchedIngest(
+          m_lastConfig.batchedIngest,
+          static_cast<size_t>(std::max(1, m_lastConfig.ingestBatchSize)));
+      if (!capture.empty())
+        m_bseFoReceiver->startCapture(capture);
       setupBseFoCallbacks();
       m_bseFoThread = std::thread([this]() {
         try {
@@ -1169,6 +1270,11 @@ bool UdpBroadcastService::startReceiver(ExchangeReceiver receiver,
         return true;
       }
       m_bseCmReceiver = std::make_unique<bse::BSEReceiver>(ip, port, "BSECM");
+      m_bseCmReceiver->setBatchedIngest(
+          m_lastConfig.batchedIngest,
+          static_cast<size_t>(std::max(1, m_lastConfig.ingestBatchSize)));
+      if (!capture.empty())
+        m_bseCmReceiver->startCapture(capture);
       setupBseCmCallbacks();
       m_bseCmThread = std::thread([this]() {
         try {
@@ -1198,6 +1304,110 @@ bool UdpBroadcastService::startReceiver(ExchangeReceiver receiver,
   return false;
 }
 
+void UdpBroadcastService::prepareTickRing(ExchangeReceiver source) {
+  const size_t ringIdx = ringIndex(source);
+  if (!m_lastConfig.mainThreadPump || ringIdx >= m_tickRings.size())
+    return;
+  if (!m_tickRings[ringIdx]) {
+    m_tickRings[ringIdx] = std::make_unique<TickRing>(
+        static_cast<size_t>(std::max(2, m_lastConfig.tickRingCapacity)));
+  }
+  if (source == ExchangeReceiver::NSEFO) {
+    const size_t extraShards =
+        static_cast<size_t>(std::max(1, m_lastConfig.nseFoParseWorkers)) - 1;
+    while (m_nseFoShardRings.size() < extraShards) {
+      m_nseFoShardRings.push_back(std::make_unique<TickRing>(
+          static_cast<size_t>(std::max(2, m_lastConfig.tickRingCapacity))));
+    }
+  }
+  startTickPump();
+}
+
+std::string UdpBroadcastService::capturePath(ExchangeReceiver source) const {
+  if (m_lastConfig.captureDir.empty())
+    return {};
+  QDir dir(QString::fromStdString(m_lastConfig.captureDir));
+  if (!dir.mkpath(".")) {
+    qWarning() << "[UdpBroadcastService] Cannot create capture dir"
+               << dir.path();
+    return {};
+  }
+  const QString name =
+      QString("%1_%2.pcap")
+          .arg(ExchangeSegmentUtil::toString(source))
+          .arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss"));
+  return dir.filePath(name).toStdString();
+}
+
+bool UdpBroadcastService::startReplay(const Config &config) {
+  if (m_active)
+    return false;
+
+  m_lastConfig = config;
+  MarketData::PriceStoreGateway::instance().setInterestFilter(
+      config.interestFilter, config.fullMarketStore);
+  if (config.enableNSEFO) {
+    prepareTickRing(ExchangeReceiver::NSEFO);
+    m_nseFoReceiver = std::make_unique<nsefo::MulticastReceiver>();
+    m_nseFoReceiver->setParseWorkers(
+        static_cast<size_t>(std::max(0, config.nseFoParseWorkers)),
+        config.nseFoParseCores);
+    setupNseFoCallbacks();
+    m_nseFoActive = true;
+  }
+  if (config.enableNSECM) {
+    prepareTickRing(ExchangeReceiver::NSECM);
+    m_nseCmReceiver = std::make_unique<nsecm::MulticastReceiver>();
+    setupNseCmCallbacks();
+    m_nseCmActive = true;
+  }
+  if (config.enableBSEFO) {
+    prepareTickRing(ExchangeReceiver::BSEFO);
+    m_bseFoReceiver = std::make_unique<bse::BSEReceiver>("BSEFO");
+    setupBseFoCallbacks();
+    m_bseFoActive = true;
+  }
+  if (config.enableBSECM) {
+    prepareTickRing(ExchangeReceiver::BSECM);
+    m_bseCmReceiver = std::make_unique<bse::BSEReceiver>("BSECM");
+    setupBseCmCallbacks();
+    m_bseCmActive = true;
+  }
+
+  m_active = m_nseFoActive || m_nseCmActive || m_bseFoActive || m_bseCmActive;
+  emit statusChanged(m_active);
+  return m_active;
+}
+
+void UdpBroadcastService::replayDatagram(ExchangeReceiver receiver,
+                                         const uint8_t *data, size_t length) {
+  switch (receiver) {
+  case ExchangeReceiver::NSEFO:
+    if (m_nseFoReceiver)
+      m_nseFoReceiver->injectDatagram(data, length);
+    break;
+  case ExchangeReceiver::NSECM:
+    if (m_nseCmReceiver)
+      m_nseCmReceiver->injectDatagram(data, length);
+    break;
+  case ExchangeReceiver::BSEFO:
+    if (m_bseFoReceiver)
+      m_bseFoReceiver->injectDatagram(data, length);
+    break;
+  case ExchangeReceiver::BSECM:
+    if (m_bseCmReceiver)
+      m_bseCmReceiver->injectDatagram(data, length);
+    break;
+  default:
+    break;
+  }
+}
+
+void UdpBroadcastService::finishReplay() {
+  if (m_nseFoReceiver)
+    m_nseFoReceiver->waitForParseWorkers();
+}
+
 void UdpBroadcastService::stopReceiver(ExchangeReceiver receiver) {
   switch (receiver) {
   case ExchangeReceiver::NSEFO:
@@ -1317,6 +1527,15 @@ void UdpBroadcastService::stop() {
   m_bseFoReceiver.reset();
   m_bseCmReceiver.reset();
 
+  // All producers have joined: stop the pump and drop undelivered ticks
+  if (m_pumpTimer)
+    m_pumpTimer->stop();
+  for (auto &ring : m_tickRings)
+    ring.reset();
+  m_nseFoShardRings.clear();
+  m_pendingTicks.clear();
+  m_pendingIndex.clear();
+
   // Update status
   m_nseFoActive = false;
   m_nseCmActive = false;
@@ -1332,8 +1551,10 @@ bool UdpBroadcastService::isActive() const { return m_active; }
 
 UdpBroadcastService::Stats UdpBroadcastService::getStats() const {
   Stats s;
-  s.nseFoPackets =
-      m_nseFoReceiver ? m_nseFoReceiver->getStats().totalPackets : 0;
+  // Summed over the NSE FO parse shards
+  const nsefo::UDPStatsSnapshot nseFo =
+      m_nseFoReceiver ? m_nseFoReceiver->getStats() : nsefo::UDPStatsSnapshot{};
+  s.nseFoPackets = nseFo.totalPackets;
   s.nseCmPackets =
       m_nseCmReceiver ? m_nseCmReceiver->getStats().totalPackets : 0;
   s.bseFoPackets =
@@ -1345,6 +1566,37 @@ UdpBroadcastService::Stats UdpBroadcastService::getStats() const {
   s.nseCmActive = m_nseCmActive;
   s.bseFoActive = m_bseFoActive;
   s.bseCmActive = m_bseCmActive;
+  s.nseFoPacketsPerSyscall = nseFo.packetsPerSyscall();
+  s.nseCmPacketsPerSyscall =
+      m_nseCmReceiver ? m_nseCmReceiver->getStats().packetsPerSyscall() : 0.0;
+  s.bseFoPacketsPerSyscall =
+      m_bseFoReceiver ? m_bseFoReceiver->getStats().packetsPerSyscall() : 0.0;
+  s.bseCmPacketsPerSyscall =
+      m_bseCmReceiver ? m_bseCmReceiver->getStats().packetsPerSyscall() : 0.0;
+
+  Stats::TickQueue *queues[] = {&s.nseFoQueue, &s.nseCmQueue, &s.bseFoQueue,
+                                &s.bseCmQueue};
+  for (size_t i = 0; i < m_tickRings.size(); ++i) {
+    if (m_tickRings[i]) {
+      queues[i]->depth = m_tickRings[i]->size();
+      queues[i]->highWater = m_tickRings[i]->highWater();
+    }
+    queues[i]->drops = m_tickDrops[i].load(std::memory_order_relaxed);
+  }
+  for (const auto &ring : m_nseFoShardRings) {
+    s.nseFoQueue.depth += ring->size();
+    s.nseFoQueue.highWater =
+        std::max<uint64_t>(s.nseFoQueue.highWater, ring->highWater());
+  }
+  s.coalescedTicks = m_coalescedTicks.load(std::memory_order_relaxed);
+
+  if (m_nseFoReceiver) {
+    s.nseFoSequence = nseFo.sequence;
+    s.nseFoParseWorkers = m_nseFoReceiver->parseWorkers();
+    s.nseFoFanoutStalls = m_nseFoReceiver->fanoutStalls();
+  }
+  if (m_nseCmReceiver)
+    s.nseCmSequence = m_nseCmReceiver->getStats().sequence.counters();
   return s;
 }
 
@@ -1,12 +1,11 @@
 #include "strategy/runtime/OptionsExecutionEngine.h"
-#include "quant/ATMCalculator.h"
 #include "repository/RepositoryManager.h"
 #include <QDebug>
 #include <QDate>
 
 // ═══════════════════════════════════════════════════════════
 // ✅ REUSE: ATM Strike Resolution (POC Task 3.1)
-// Uses existing ATMCalculator + RepositoryManager
+// Uses the RepositoryManager contract catalog (nearest-strike search)
 // See: 08_BACKEND_AUDIT_FINDINGS.md
 // ═══════════════════════════════════════════════════════════
 
@@ -14,31 +13,27 @@ int OptionsExecutionEngine::resolveATMStrike(const QString& symbol,
                                              const QString& expiry,
                                              double spotPrice,
                                              int offset) {
-  auto* repo = RepositoryManager::getInstance();
+  const auto catalog = RepositoryManager::getInstance()->contractCatalog();
   
-  // Step 1: Get sorted strikes from cache (O(1) hash lookup)
-  const QVector<double>& strikes = 
-      repo->getStrikesForSymbolExpiry(symbol, expiry);
+  // Step 1: Get the (symbol, expiry) chain (integer binary search)
+  const ContractCatalog::Chain* chain = catalog->chain(symbol, expiry);
   
-  if (strikes.isEmpty()) {
+  if (!chain || chain->strikes.isEmpty()) {
     qCritical() << "[OptionsEngine] No strikes found for" << symbol << expiry;
     return 0;
   }
   
-  // Step 2: Find nearest strike (O(log n) binary search)
-  auto result = ATMCalculator::calculateFromActualStrikes(spotPrice, strikes, 0);
-  
-  if (!result.isValid) {
+  if (spotPrice <= 0) {
     qCritical() << "[OptionsEngine] ATM calculation failed for spot:" << spotPrice;
     return 0;
   }
   
-  double atmStrike = result.atmStrike;
+  // Step 2: Find nearest strike (O(log n) binary search)
+  const int atmIndex = chain->atmIndex(spotPrice);
   
-  // Step 3: Apply offset (ATM+1, ATM-2, etc.)
-  if (offset != 0) {
-    atmStrike = applyStrikeOffset(strikes, atmStrike, offset);
-  }
+  // Step 3: Apply offset (ATM+1, ATM-2, etc.) by index within the chain
+  const double atmStrike =
+      chain->strikes[applyStrikeOffset(chain->strikeTicks, atmIndex, offset)];
   
   qDebug() << "[OptionsEngine] ATM Resolution:"
            << "Spot=" << spotPrice
@@ -48,30 +43,22 @@ int OptionsExecutionEngine::resolveATMStrike(const QString& symbol,
   return static_cast<int>(atmStrike);
 }
 
-double OptionsExecutionEngine::applyStrikeOffset(const QVector<double>& strikes,
-                                                 double atmStrike,
-                                                 int offset) {
-  // Find current ATM index
-  int currentIdx = strikes.indexOf(atmStrike);
-  if (currentIdx == -1) {
-    qWarning() << "[OptionsEngine] ATM strike" << atmStrike << "not found in array";
-    return atmStrike;
-  }
-  
-  // Apply offset
-  int targetIdx = currentIdx + offset;
+int OptionsExecutionEngine::applyStrikeOffset(const QVector<int64_t>& strikeTicks,
+                                              int atmIndex,
+                                              int offset) {
+  const int targetIdx = atmIndex + offset;
   
   // Boundary check
   if (targetIdx < 0) {
     qWarning() << "[OptionsEngine] Strike offset" << offset << "below range, using first strike";
-    return strikes.first();
+    return 0;
   }
-  if (targetIdx >= strikes.size()) {
+  if (targetIdx >= strikeTicks.size()) {
     qWarning() << "[OptionsEngine] Strike offset" << offset << "above range, using last strike";
-    return strikes.last();
+    return strikeTicks.size() - 1;
   }
   
-  return strikes[targetIdx];
+  return targetIdx;
 }
 
 // ═══════════════════════════════════════════════════════════
@@ -101,16 +88,19 @@ int64_t OptionsExecutionEngine::getContractToken(const QString& symbol,
                                                  const QString& expiry,
                                                  double strike,
                                                  const QString& optionType) {
-  auto* repo = RepositoryManager::getInstance();
+  const auto catalog = RepositoryManager::getInstance()->contractCatalog();
   
-  // Get CE/PE token pair from cache (O(1) hash lookup)
-  auto tokens = repo->getTokensForStrike(symbol, expiry, strike);
+  // CE/PE tokens are parallel to the chain's strikes (integer tick search)
+  const ContractCatalog::Chain* chain = catalog->chain(symbol, expiry);
+  const int idx = chain ? chain->indexOfStrike(strike) : -1;
   
   int64_t token = 0;
-  if (optionType.toUpper() == "CE") {
-    token = tokens.first;   // Call token
-  } else if (optionType.toUpper() == "PE") {
-    token = tokens.second;  // Put token
+  if (idx >= 0) {
+    if (optionType.toUpper() == "CE") {
+      token = chain->callTokens[idx];  // Call token
+    } else if (optionType.toUpper() == "PE") {
+      token = chain->putTokens[idx];   // Put token
+    }
   }
   
   if (token == 0) {
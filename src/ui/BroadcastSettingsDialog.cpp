@@ -702,6 +702,14 @@ void BroadcastSettingsDialog::refreshStats()
             } else {
                 row.ppsLabel->setText("—");
             }
+            if (info.id == ConnectionId::UDP_NSEFO || info.id == ConnectionId::UDP_NSECM) {
+                row.ppsLabel->setToolTip(
+                    QString("Seq gaps: %1  |  Lost: %2  |  Max gap: %3  |  Out of order: %4")
+                        .arg(info.seqGaps)
+                        .arg(info.seqLost)
+                        .arg(info.seqMaxGap)
+                        .arg(info.seqOutOfOrder));
+            }
         }
     }
 
@@ -1,7 +1,7 @@
 #include "ui/GlobalSearchWidget.h"
 #include "ui_GlobalSearchWidget.h"
 #include "api/xts/XTSTypes.h"
-#include "repository/RepositoryManager.h"
+#include "repository/ScripSearchSession.h"
 #include <QComboBox>
 #include <QDebug>
 #include <QHeaderView>
@@ -9,7 +9,8 @@
 #include <QTableWidget>
 
 GlobalSearchWidget::GlobalSearchWidget(QWidget *parent)
-    : QWidget(parent), ui(new Ui::GlobalSearchWidget) {
+    : QWidget(parent), ui(new Ui::GlobalSearchWidget),
+      m_search(new ScripSearchSession(this)) {
   ui->setupUi(this);
 
   // Table header stretch
@@ -29,6 +30,8 @@ GlobalSearchWidget::GlobalSearchWidget(QWidget *parent)
           this, &GlobalSearchWidget::onFilterChanged);
   connect(ui->resultsTable, &QTableWidget::cellDoubleClicked, this,
           &GlobalSearchWidget::onResultDoubleClicked);
+  connect(m_search, &ScripSearchSession::resultsReady, this,
+          &GlobalSearchWidget::onResultsReady);
 
   // Initial population
   ui->exchangeCombo->addItems({"All Exchanges", "NSE", "BSE"});
@@ -41,7 +44,7 @@ GlobalSearchWidget::GlobalSearchWidget(QWidget *parent)
 GlobalSearchWidget::~GlobalSearchWidget() { delete ui; }
 
 void GlobalSearchWidget::onSearchTextChanged(const QString &text) {
-  // Debounce or simple timer could be added if results are too slow
+  // Runs off the GUI thread; each keystroke supersedes the previous query
   updateResults();
 }
 
@@ -50,6 +53,8 @@ void GlobalSearchWidget::onFilterChanged() { updateResults(); }
 void GlobalSearchWidget::updateResults() {
   QString query = ui->searchEdit->text();
   if (query.length() < 2) {
+    m_search->cancel();
+    m_currentResults.clear();
     ui->resultsTable->setRowCount(0);
     return;
   }
@@ -66,8 +71,15 @@ void GlobalSearchWidget::updateResults() {
   if (seg == "F&O")
     seg = "FO";
 
-  auto *repo = RepositoryManager::getInstance();
-  m_currentResults = repo->searchScripsGlobal(query, ex, seg, exp, 100);
+  // Results arrive in onResultsReady()
+  m_search->search(query, ex, seg, exp, 100);
+}
+
+void GlobalSearchWidget::onResultsReady(quint64 generation, const QString &text,
+                                        const QVector<ContractData> &results) {
+  Q_UNUSED(generation);
+  Q_UNUSED(text);
+  m_currentResults = results;
 
   ui->resultsTable->setRowCount(0);
   ui->resultsTable->setRowCount(m_currentResults.size());
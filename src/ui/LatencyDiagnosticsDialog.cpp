@@ -0,0 +1,214 @@
+#include "ui/LatencyDiagnosticsDialog.h"
+#include "utils/LatencyTracker.h"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QPushButton>
+#include <QTableWidget>
+#include <QHeaderView>
+#include <QColor>
+#include <QTimer>
+#include <QFileDialog>
+#include <QMessageBox>
+
+namespace {
+
+enum Column {
+    ColSegment, ColStage, ColCount, ColP50, ColP90, ColP99, ColP999, ColMax, ColMean,
+    ColOutOfOrder, ColumnCount
+};
+
+// Stage latency above which a row is highlighted (p99, µs)
+constexpr int64_t kSlowP99Micros = 5000;
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════════════
+// Constructor
+// ═══════════════════════════════════════════════════════════════════════
+
+LatencyDiagnosticsDialog::LatencyDiagnosticsDialog(QWidget *parent)
+    : QDialog(parent)
+{
+    setWindowTitle("Latency Diagnostics");
+    setMinimumSize(640, 320);
+    resize(760, 420);
+    setModal(false);
+
+    buildUI();
+    applyStyleSheet();
+
+    // Stats refresh timer (1 second)
+    m_refreshTimer = new QTimer(this);
+    m_refreshTimer->setInterval(1000);
+    connect(m_refreshTimer, &QTimer::timeout, this, &LatencyDiagnosticsDialog::refreshStats);
+    m_refreshTimer->start();
+
+    refreshStats();
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Build UI
+// ═══════════════════════════════════════════════════════════════════════
+
+void LatencyDiagnosticsDialog::buildUI()
+{
+    QVBoxLayout* mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(8, 8, 8, 8);
+    mainLayout->setSpacing(6);
+
+    QLabel* titleLabel = new QLabel("Tick Latency (µs, monotonic clock)", this);
+    titleLabel->setObjectName("dialogTitle");
+    mainLayout->addWidget(titleLabel);
+
+    QLabel* helpLabel = new QLabel(
+        "Parse: UDP receive → parsed · Publish: → emitted · Dispatch: → FeedHandler · "
+        "Model: FeedHandler → model updated · EndToEnd: receive → model", this);
+    helpLabel->setObjectName("helpLabel");
+    helpLabel->setWordWrap(true);
+    mainLayout->addWidget(helpLabel);
+
+    m_table = new QTableWidget(0, ColumnCount, this);
+    m_table->setHorizontalHeaderLabels({"Segment", "Stage", "Count", "p50", "p90", "p99",
+                                        "p99.9", "Max", "Mean", "Out of order"});
+    m_table->verticalHeader()->setVisible(false);
+    m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    m_table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    mainLayout->addWidget(m_table, 1);
+
+    m_summaryLabel = new QLabel(this);
+    m_summaryLabel->setObjectName("helpLabel");
+    mainLayout->addWidget(m_summaryLabel);
+
+    // ── Bottom buttons ───────────────────────────────────────────────
+    QHBoxLayout* btnLayout = new QHBoxLayout();
+    m_resetBtn = new QPushButton("Reset", this);
+    m_exportBtn = new QPushButton("Export...", this);
+    m_closeBtn = new QPushButton("Close", this);
+    btnLayout->addWidget(m_resetBtn);
+    btnLayout->addWidget(m_exportBtn);
+    btnLayout->addStretch();
+    btnLayout->addWidget(m_closeBtn);
+    mainLayout->addLayout(btnLayout);
+
+    connect(m_resetBtn, &QPushButton::clicked, this, &LatencyDiagnosticsDialog::onReset);
+    connect(m_exportBtn, &QPushButton::clicked, this, &LatencyDiagnosticsDialog::onExport);
+    connect(m_closeBtn, &QPushButton::clicked, this, &QDialog::close);
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Slots
+// ═══════════════════════════════════════════════════════════════════════
+
+void LatencyDiagnosticsDialog::refreshStats()
+{
+    const auto rows = LatencyTracker::report();
+    m_table->setRowCount(static_cast<int>(rows.size()));
+
+    uint64_t endToEndCount = 0;
+    int row = 0;
+    for (const auto& r : rows) {
+        const auto& s = r.stats;
+        const QString cells[ColumnCount] = {
+            LatencyTracker::segmentName(r.segment),
+            LatencyTracker::stageName(r.stage),
+            QString::number(s.count),
+            QString::number(s.p50),
+            QString::number(s.p90),
+            QString::number(s.p99),
+            QString::number(s.p999),
+            QString::number(s.max),
+            QString::number(s.mean, 'f', 1),
+            QString::number(s.negative),
+        };
+        const bool slow = s.p99 > kSlowP99Micros;
+        for (int col = 0; col < ColumnCount; ++col) {
+            QTableWidgetItem* item = m_table->item(row, col);
+            if (!item) {
+                item = new QTableWidgetItem;
+                m_table->setItem(row, col, item);
+            }
+            item->setText(cells[col]);
+            item->setTextAlignment(col <= ColStage ? Qt::AlignLeft | Qt::AlignVCenter
+                                                   : Qt::AlignRight | Qt::AlignVCenter);
+            item->setForeground(slow ? QColor("#dc2626") : QColor("#1e293b"));
+        }
+        if (r.stage == LatencyTracker::Stage::EndToEnd) endToEndCount += s.count;
+        ++row;
+    }
+
+    m_summaryLabel->setText(rows.empty()
+        ? QString("No ticks recorded yet — start the broadcast receivers.")
+        : QString("%1 ticks measured end to end. Rows with p99 above %2 ms are red.")
+              .arg(endToEndCount).arg(kSlowP99Micros / 1000));
+}
+
+void LatencyDiagnosticsDialog::onReset()
+{
+    LatencyTracker::resetHistograms();
+    refreshStats();
+}
+
+void LatencyDiagnosticsDialog::onExport()
+{
+    const QString dir = QFileDialog::getExistingDirectory(this, "Export Latency Histograms");
+    if (dir.isEmpty()) return;
+
+    if (LatencyTracker::writeDump(dir)) {
+        QMessageBox::information(this, "Latency Diagnostics",
+                                 QString("Histograms written to %1").arg(dir));
+    } else {
+        QMessageBox::warning(this, "Latency Diagnostics",
+                             QString("Could not write to %1").arg(dir));
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+// Style
+// ═══════════════════════════════════════════════════════════════════════
+
+void LatencyDiagnosticsDialog::applyStyleSheet()
+{
+    setStyleSheet(
+        "LatencyDiagnosticsDialog {"
+        "  background-color: #ffffff;"
+        "}"
+        "QLabel#dialogTitle {"
+        "  color: #1e293b;"
+        "  font-size: 13px;"
+        "  font-weight: 700;"
+        "  padding-bottom: 2px;"
+        "}"
+        "QLabel#helpLabel {"
+        "  color: #475569;"
+        "  font-size: 11px;"
+        "}"
+        "QTableWidget {"
+        "  background: #ffffff;"
+        "  border: 1px solid #e2e8f0;"
+        "  gridline-color: #f1f5f9;"
+        "  font-size: 11px;"
+        "}"
+        "QHeaderView::section {"
+        "  background-color: #f8fafc;"
+        "  color: #475569;"
+        "  border: none;"
+        "  border-bottom: 1px solid #e2e8f0;"
+        "  padding: 3px;"
+        "  font-size: 11px;"
+        "}"
+        "QPushButton {"
+        "  background: #f8fafc;"
+        "  border: 1px solid #e2e8f0;"
+        "  border-radius: 3px;"
+        "  padding: 3px 12px;"
+        "  color: #1e293b;"
+        "  font-size: 11px;"
+        "}"
+        "QPushButton:hover {"
+        "  background: #e2e8f0;"
+        "}"
+    );
+}
@@ -210,6 +210,80 @@ int ConfigLoader::getBSECMPort() const
     return getInt("UDP", "bse_cm_port", 26001);
 }
 
+bool ConfigLoader::getUDPBatchedIngest() const
+{
+    return getBool("UDP", "batched_ingest", false);
+}
+
+int ConfigLoader::getUDPIngestBatchSize() const
+{
+    return getInt("UDP", "ingest_batch_size", 64);
+}
+
+bool ConfigLoader::getUDPMainThreadPump() const
+{
+    return getBool("UDP", "main_thread_pump", true);
+}
+
+int ConfigLoader::getUDPPumpIntervalMs() const
+{
+    return getInt("UDP", "pump_interval_ms", 16);
+}
+
+int ConfigLoader::getUDPTickRingCapacity() const
+{
+    return getInt("UDP", "tick_ring_capacity", 8192);
+}
+
+QString ConfigLoader::getUDPCaptureDir() const
+{
+    return getValue("UDP", "capture_dir", "");
+}
+
+int ConfigLoader::getUDPNseFoParseWorkers() const
+{
+    return getInt("UDP", "nse_fo_parse_workers", 0);
+}
+
+int ConfigLoader::getUDPNseFoReceiveCore() const
+{
+    return getInt("UDP", "nse_fo_receive_core", -1);
+}
+
+bool ConfigLoader::getUDPInterestFilter() const
+{
+    return getBool("UDP", "interest_filter", false);
+}
+
+bool ConfigLoader::getUDPFullMarketStore() const
+{
+    return getBool("UDP", "full_market_store", false);
+}
+
+QString ConfigLoader::getUDPLatencyDumpDir() const
+{
+    return getValue("UDP", "latency_dump_dir", "");
+}
+
+int ConfigLoader::getUDPLatencyDumpIntervalSec() const
+{
+    return getInt("UDP", "latency_dump_interval_sec", 60);
+}
+
+QVector<int> ConfigLoader::getUDPNseFoParseCores() const
+{
+    // Comma-separated, e.g. "2,3,4,5"; -1 leaves that worker unpinned
+    QVector<int> cores;
+    const QStringList parts =
+        getValue("UDP", "nse_fo_parse_cores", "").split(',', Qt::SkipEmptyParts);
+    for (const QString &part : parts) {
+        bool ok = false;
+        const int core = part.trimmed().toInt(&ok);
+        cores.append(ok ? core : -1);
+    }
+    return cores;
+}
+
 QJsonObject ConfigLoader::getUDPConfig() const
 {
     QJsonObject config;
@@ -0,0 +1,94 @@
+#include "utils/LatencyHistogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+using Counts = std::array<uint64_t, LatencyHistogram::kBucketCount>;
+
+// Percentile = upper bound of the bucket holding the ceil(q * count)-th
+// sample, never above max
+void fillPercentiles(const Counts &counts, LatencyHistogram::Snapshot &snap)
+{
+    const double quantiles[] = {0.50, 0.90, 0.99, 0.999};
+    int64_t *targets[] = {&snap.p50, &snap.p90, &snap.p99, &snap.p999};
+    int next = 0;
+    uint64_t seen = 0;
+    for (int i = 0; i < LatencyHistogram::kBucketCount && next < 4; ++i) {
+        seen += counts[i];
+        while (next < 4 &&
+               seen >= static_cast<uint64_t>(std::ceil(quantiles[next] * snap.count))) {
+            *targets[next] = std::min(LatencyHistogram::bucketUpperBound(i), snap.max);
+            ++next;
+        }
+    }
+    // Buckets read while writers were running can add up to less than count
+    for (; next < 4; ++next) *targets[next] = snap.max;
+}
+
+} // namespace
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const
+{
+    Snapshot snap;
+    Counts counts;
+    for (int i = 0; i < kBucketCount; ++i) {
+        counts[i] = m_counts[i].load(std::memory_order_relaxed);
+        snap.count += counts[i];
+    }
+    snap.negative = m_negative.load(std::memory_order_relaxed);
+    if (snap.count == 0) return snap;
+
+    snap.min = m_min.load(std::memory_order_relaxed);
+    snap.max = m_max.load(std::memory_order_relaxed);
+    snap.mean = static_cast<double>(m_sum.load(std::memory_order_relaxed)) /
+                static_cast<double>(snap.count);
+    fillPercentiles(counts, snap);
+
+    if (snap.min > snap.max) snap.min = snap.max;
+    return snap;
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshotSince(Totals &since) const
+{
+    Totals now;
+    bool wasReset = false;
+    for (int i = 0; i < kBucketCount; ++i) {
+        now.counts[i] = m_counts[i].load(std::memory_order_relaxed);
+        wasReset |= now.counts[i] < since.counts[i];
+    }
+    now.sum = m_sum.load(std::memory_order_relaxed);
+    now.negative = m_negative.load(std::memory_order_relaxed);
+    wasReset |= now.sum < since.sum || now.negative < since.negative;
+    if (wasReset) since = Totals();
+
+    Snapshot snap;
+    Counts counts;
+    int first = -1, last = -1;
+    for (int i = 0; i < kBucketCount; ++i) {
+        counts[i] = now.counts[i] - since.counts[i];
+        snap.count += counts[i];
+        if (counts[i] == 0) continue;
+        if (first < 0) first = i;
+        last = i;
+    }
+    snap.negative = now.negative - since.negative;
+    const uint64_t sum = now.sum - since.sum;
+    since = now;
+    if (snap.count == 0) return snap;
+
+    snap.max = std::min(bucketUpperBound(last), m_max.load(std::memory_order_relaxed));
+    snap.min = std::min(bucketLowerBound(first), snap.max);
+    snap.mean = static_cast<double>(sum) / static_cast<double>(snap.count);
+    fillPercentiles(counts, snap);
+    return snap;
+}
+
+void LatencyHistogram::reset()
+{
+    for (auto &count : m_counts) count.store(0, std::memory_order_relaxed);
+    m_sum.store(0, std::memory_order_relaxed);
+    m_negative.store(0, std::memory_order_relaxed);
+    m_min.store(std::numeric_limits<int64_t>::max(), std::memory_order_relaxed);
+    m_max.store(0, std::memory_order_relaxed);
+}
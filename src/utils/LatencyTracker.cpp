@@ -0,0 +1,182 @@
+#include "utils/LatencyTracker.h"
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QTextStream>
+
+LatencyHistogram LatencyTracker::s_histograms[LatencyTracker::kSegmentSlots * LatencyTracker::kStageCount];
+LatencyHistogram::Totals LatencyTracker::s_intervalStart[LatencyTracker::kSegmentSlots * LatencyTracker::kStageCount];
+
+namespace {
+
+// Slot order of segmentSlot()
+constexpr int kSlotSegments[LatencyTracker::kSegmentSlots] = {1, 2, 11, 12, 0};
+
+constexpr const char *kCsvHeader =
+    "time,segment,stage,count,out_of_order,min_us,p50_us,p90_us,p99_us,p999_us,max_us,mean_us";
+
+} // namespace
+
+void LatencyTracker::resetHistograms()
+{
+    for (auto &histogram : s_histograms) histogram.reset();
+}
+
+std::vector<LatencyTracker::StageReport> LatencyTracker::report()
+{
+    std::vector<StageReport> rows;
+    for (int slot = 0; slot < kSegmentSlots; ++slot) {
+        for (int s = 0; s < kStageCount; ++s) {
+            const auto snap = s_histograms[slot * kStageCount + s].snapshot();
+            if (snap.count == 0 && snap.negative == 0) continue;
+            rows.push_back({kSlotSegments[slot], static_cast<Stage>(s), snap});
+        }
+    }
+    return rows;
+}
+
+std::vector<LatencyTracker::StageReport> LatencyTracker::intervalReport()
+{
+    std::vector<StageReport> rows;
+    for (int slot = 0; slot < kSegmentSlots; ++slot) {
+        for (int s = 0; s < kStageCount; ++s) {
+            const int index = slot * kStageCount + s;
+            const auto snap = s_histograms[index].snapshotSince(s_intervalStart[index]);
+            if (snap.count == 0 && snap.negative == 0) continue;
+            rows.push_back({kSlotSegments[slot], static_cast<Stage>(s), snap});
+        }
+    }
+    return rows;
+}
+
+const char *LatencyTracker::stageName(Stage stage)
+{
+    switch (stage) {
+        case Stage::Parse:    return "Parse";
+        case Stage::Publish:  return "Publish";
+        case Stage::Dispatch: return "Dispatch";
+        case Stage::Model:    return "Model";
+        case Stage::EndToEnd: return "EndToEnd";
+        default:              return "?";
+    }
+}
+
+const char *LatencyTracker::segmentName(int segment)
+{
+    switch (segment) {
+        case 1:  return "NSECM";
+        case 2:  return "NSEFO";
+        case 11: return "BSECM";
+        case 12: return "BSEFO";
+        default: return "OTHER";
+    }
+}
+
+QString LatencyTracker::toCsv(bool withHeader)
+{
+    return toCsv(report(), withHeader);
+}
+
+QString LatencyTracker::toCsv(const std::vector<StageReport> &rows, bool withHeader)
+{
+    QString csv;
+    QTextStream out(&csv);
+    if (withHeader) out << kCsvHeader << '\n';
+
+    const QString time = QDateTime::currentDateTime().toString(Qt::ISODate);
+    for (const auto &row : rows) {
+        const auto &s = row.stats;
+        out << time << ',' << segmentName(row.segment) << ',' << stageName(row.stage) << ','
+            << s.count << ',' << s.negative << ',' << s.min << ',' << s.p50 << ','
+            << s.p90 << ',' << s.p99 << ',' << s.p999 << ',' << s.max << ','
+            << QString::number(s.mean, 'f', 1) << '\n';
+    }
+    return csv;
+}
+
+QByteArray LatencyTracker::toJson()
+{
+    return toJson(report(), "cumulative");
+}
+
+QByteArray LatencyTracker::toJson(const std::vector<StageReport> &rows, const char *window)
+{
+    QJsonArray stages;
+    for (const auto &row : rows) {
+        const auto &s = row.stats;
+        QJsonObject obj;
+        obj["segment"] = segmentName(row.segment);
+        obj["stage"] = stageName(row.stage);
+        obj["count"] = static_cast<qint64>(s.count);
+        obj["out_of_order"] = static_cast<qint64>(s.negative);
+        obj["min_us"] = static_cast<qint64>(s.min);
+        obj["p50_us"] = static_cast<qint64>(s.p50);
+        obj["p90_us"] = static_cast<qint64>(s.p90);
+        obj["p99_us"] = static_cast<qint64>(s.p99);
+        obj["p999_us"] = static_cast<qint64>(s.p999);
+        obj["max_us"] = static_cast<qint64>(s.max);
+        obj["mean_us"] = s.mean;
+        stages.append(obj);
+    }
+
+    QJsonObject root;
+    root["time"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    root["clock"] = "steady_us";
+    root["window"] = window;
+    root["stages"] = stages;
+    return QJsonDocument(root).toJson(QJsonDocument::Indented);
+}
+
+bool LatencyTracker::writeDump(const QString &dir, bool interval)
+{
+    if (!QDir().mkpath(dir)) {
+        qWarning() << "[LatencyTracker] Cannot create dump directory" << dir;
+        return false;
+    }
+    QDir dumpDir(dir);
+
+    // Daily CSV: one block of rows per dump, header once per file
+    QFile csv(dumpDir.filePath(
+        QString("latency_%1.csv").arg(QDate::currentDate().toString("yyyyMMdd"))));
+    const bool newFile = !csv.exists() || csv.size() == 0;
+    if (!csv.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        qWarning() << "[LatencyTracker] Cannot write" << csv.fileName();
+        return false;
+    }
+    const auto rows = interval ? intervalReport() : report();
+    csv.write(toCsv(rows, newFile).toUtf8());
+    csv.close();
+
+    // Latest snapshot, replaced atomically so readers never see half a file
+    QSaveFile json(dumpDir.filePath("latency_latest.json"));
+    if (!json.open(QIODevice::WriteOnly)) {
+        qWarning() << "[LatencyTracker] Cannot write" << json.fileName();
+        return false;
+    }
+    json.write(toJson(rows, interval ? "interval" : "cumulative"));
+    return json.commit();
+}
+
+void LatencyTracker::printAggregateStats()
+{
+    const auto rows = report();
+    if (rows.empty()) return;
+
+    qDebug() << "╔═══════════════════════════════════════════════════════════════╗";
+    qDebug() << "║                 LATENCY PERCENTILES (µs)                      ║";
+    qDebug() << "╠═══════════════════════════════════════════════════════════════╣";
+    for (const auto &row : rows) {
+        const auto &s = row.stats;
+        qDebug().nospace().noquote()
+            << "║ " << QString(segmentName(row.segment)).leftJustified(6)
+            << QString(stageName(row.stage)).leftJustified(9)
+            << " n=" << s.count << " p50=" << s.p50 << " p99=" << s.p99
+            << " p99.9=" << s.p999 << " max=" << s.max
+            << (s.negative ? QString(" out-of-order=%1").arg(s.negative) : QString());
+    }
+    qDebug() << "╚═══════════════════════════════════════════════════════════════╝";
+}
@@ -40,11 +40,35 @@ MemoryProfiler::MemoryStats MemoryProfiler::getCurrentUsage() {
         stats.physicalMemory = rss * pageSize;
         stats.virtualMemory = virt * pageSize;
     }
+
+    // Peak RSS ("VmHWM:   123456 kB") from /proc/self/status
+    std::ifstream status("/proc/self/status");
+    std::string key;
+    while (status >> key) {
+        if (key == "VmHWM:") {
+            size_t kb = 0;
+            if (status >> kb) stats.peakPhysical = kb * 1024;
+            break;
+        }
+        status.ignore(4096, '\n');
+    }
 #endif
 
     return stats;
 }
 
+bool MemoryProfiler::resetPeak() {
+#if defined(_WIN32) || defined(__APPLE__) || defined(__MACH__)
+    return false;
+#else
+    // "5" resets the peak RSS to the current RSS (Linux 4.0+)
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+    clearRefs.flush();
+    return clearRefs.good();
+#endif
+}
+
 QString MemoryProfiler::formatBytes(size_t bytes) {
     double size = static_cast<double>(bytes);
     QStringList units = {"B", "KB", "MB", "GB", "TB"};
@@ -66,3 +90,25 @@ void MemoryProfiler::logSnapshot(const QString& label) {
                           .arg(formatBytes(stats.virtualMemory).rightJustified(10, ' '))
                           .arg(formatBytes(stats.peakPhysical).rightJustified(10, ' '));
 }
+
+void MemoryProfiler::logFootprint(const QString& label, size_t bytes,
+                                  size_t baselineBytes, size_t items) {
+    const double saved = baselineBytes > 0
+        ? 100.0 * (static_cast<double>(baselineBytes) - static_cast<double>(bytes)) / baselineBytes
+        : 0.0;
+    qDebug().noquote() << QString("[RAM] [%1] Size: %2 | Previous: %3 | Saved: %4% | %5 B/item (%6 items)")
+                          .arg(label.leftJustified(20, ' '))
+                          .arg(formatBytes(bytes).rightJustified(10, ' '))
+                          .arg(formatBytes(baselineBytes).rightJustified(10, ' '))
+                          .arg(saved, 0, 'f', 1)
+                          .arg(items > 0 ? bytes / items : 0)
+                          .arg(items);
+}
+
+void MemoryProfiler::logCost(const QString& label, qint64 nanoseconds, size_t operations) {
+    qDebug().noquote() << QString("[RAM] [%1] Time: %2 us | %3 ns/op (%4 ops)")
+                          .arg(label.leftJustified(20, ' '))
+                          .arg(nanoseconds / 1000.0, 0, 'f', 1)
+                          .arg(operations > 0 ? static_cast<double>(nanoseconds) / operations : 0.0, 0, 'f', 1)
+                          .arg(operations);
+}
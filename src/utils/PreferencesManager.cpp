@@ -152,6 +152,31 @@ void PreferencesManager::setUseLegacyPriceCache(bool useLegacy) {
   emit preferencesChanged("pricecache/use_legacy_mode");
 }
 
+// ============================================================================
+// Market Watch Repaint Coalescing
+// ============================================================================
+
+int PreferencesManager::getMarketWatchFlushInterval() const {
+  // Default 16ms ≈ one 60 Hz frame. 0 = emit dataChanged on every tick.
+  int ms = m_settings.value("marketwatch/flush_interval_ms", 16).toInt();
+  return qBound(0, ms, 1000);
+}
+
+void PreferencesManager::setMarketWatchFlushInterval(int intervalMs) {
+  m_settings.setValue("marketwatch/flush_interval_ms", qBound(0, intervalMs, 1000));
+  emit preferencesChanged("marketwatch/flush_interval_ms");
+}
+
+bool PreferencesManager::getMarketWatchViewportMode() const {
+  // Default on: rows outside the viewport are filled from the price store
+  return m_settings.value("marketwatch/viewport_mode", true).toBool();
+}
+
+void PreferencesManager::setMarketWatchViewportMode(bool enabled) {
+  m_settings.setValue("marketwatch/viewport_mode", enabled);
+  emit preferencesChanged("marketwatch/viewport_mode");
+}
+
 // ============================================================================
 // Order Window Focus Field Preferences
 // ============================================================================
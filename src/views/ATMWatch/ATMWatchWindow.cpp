@@ -41,6 +41,16 @@ ATMWatchWindow::ATMWatchWindow(QWidget *parent) : QWidget(parent) {
           &ATMWatchWindow::onBasePriceUpdate);
   m_basePriceTimer->start();
 
+  // Option and underlying ticks: the window only shows the latest values,
+  // so take them as one batch per 200 ms (depth-only updates never matter)
+  m_tickFeed = FeedHandler::instance().subscribeConflated(
+      this, {}, 5,
+      [this](const std::vector<UDP::MarketTick> &changed) {
+        for (const UDP::MarketTick &tick : changed)
+          onTickUpdate(tick);
+      },
+      FeedDispatcher::AllUpdates & ~FeedDispatcher::DepthUpdates);
+
   // Initialize generic profile managers for all three tables
   initProfileManagers();
 
@@ -60,7 +70,7 @@ ATMWatchWindow::ATMWatchWindow(QWidget *parent) : QWidget(parent) {
 }
 
 ATMWatchWindow::~ATMWatchWindow() {
-  FeedHandler::instance().unsubscribeAll(this);
+  delete m_tickFeed; // Stop ticks before the maps they index go away
   delete ui;
 }
 
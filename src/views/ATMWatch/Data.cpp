@@ -41,7 +41,7 @@ void ATMWatchWindow::updateItemWithColor(QStandardItemModel *model, int row,
 }
 
 void ATMWatchWindow::refreshData() {
-  FeedHandler::instance().unsubscribeAll(this);
+  m_tickFeed->clearKeys();
   m_tokenToInfo.clear();
   m_symbolToRow.clear();
   m_underlyingToRow.clear();
@@ -54,7 +54,6 @@ void ATMWatchWindow::refreshData() {
 
   auto atmList = ATMWatchManager::getInstance().getATMWatchArray();
   sortATMList(atmList); // Apply sorting
-  FeedHandler &feed = FeedHandler::instance();
 
   int row = 0;
   for (const auto &info : atmList) {
@@ -82,7 +81,7 @@ void ATMWatchWindow::refreshData() {
       m_tokenToInfo[token] = {info.symbol, isCall};
 
       // Subscribe to live feed
-      feed.subscribe(2, token, this, &ATMWatchWindow::onTickUpdate);
+      m_tickFeed->addKey(FeedHandler::makeKey(2, token));
 
       // Fetch current price from cache using thread-safe snapshot
       auto state = MarketData::PriceStoreGateway::instance().getUnifiedSnapshot(
@@ -134,10 +133,8 @@ void ATMWatchWindow::refreshData() {
     // Subscribe to Underlying Token for Real-Time "Spot/Fut" updates
     if (info.underlyingToken > 0) {
       m_underlyingTokenToSymbol[info.underlyingToken] = info.symbol;
-      feed.subscribe(1, info.underlyingToken, this,
-                     &ATMWatchWindow::onTickUpdate);
-      feed.subscribe(2, info.underlyingToken, this,
-                     &ATMWatchWindow::onTickUpdate);
+      m_tickFeed->addKey(FeedHandler::makeKey(1, info.underlyingToken));
+      m_tickFeed->addKey(FeedHandler::makeKey(2, info.underlyingToken));
     }
 
     row++;
@@ -155,7 +152,6 @@ void ATMWatchWindow::refreshData() {
 void ATMWatchWindow::updateDataIncrementally() {
   // P2: Incremental updates - only change what's different, no flicker
   auto atmList = ATMWatchManager::getInstance().getATMWatchArray();
-  FeedHandler &feed = FeedHandler::instance();
 
   // Build map of new ATM info for quick lookup
   QMap<QString, ATMWatchManager::ATMInfo> newATMData;
@@ -174,11 +170,11 @@ void ATMWatchWindow::updateDataIncrementally() {
       if (m_previousATMData.contains(symbol)) {
         const auto &oldInfo = m_previousATMData[symbol];
         if (oldInfo.callToken > 0) {
-          feed.unsubscribe(2, oldInfo.callToken, this);
+          m_tickFeed->removeKey(FeedHandler::makeKey(2, oldInfo.callToken));
           m_tokenToInfo.remove(oldInfo.callToken);
         }
         if (oldInfo.putToken > 0) {
-          feed.unsubscribe(2, oldInfo.putToken, this);
+          m_tickFeed->removeKey(FeedHandler::makeKey(2, oldInfo.putToken));
           m_tokenToInfo.remove(oldInfo.putToken);
         }
       }
@@ -204,11 +200,11 @@ void ATMWatchWindow::updateDataIncrementally() {
     // Handle token changes (ATM strike moved)
     if (atmStrikeChanged && m_previousATMData.contains(symbol)) {
       if (oldInfo.callToken > 0) {
-        feed.unsubscribe(2, oldInfo.callToken, this);
+        m_tickFeed->removeKey(FeedHandler::makeKey(2, oldInfo.callToken));
         m_tokenToInfo.remove(oldInfo.callToken);
       }
       if (oldInfo.putToken > 0) {
-        feed.unsubscribe(2, oldInfo.putToken, this);
+        m_tickFeed->removeKey(FeedHandler::makeKey(2, oldInfo.putToken));
         m_tokenToInfo.remove(oldInfo.putToken);
       }
 
@@ -217,7 +213,7 @@ void ATMWatchWindow::updateDataIncrementally() {
           return;
 
         m_tokenToInfo[token] = {symbol, isCall};
-        feed.subscribe(2, token, this, &ATMWatchWindow::onTickUpdate);
+        m_tickFeed->addKey(FeedHandler::makeKey(2, token));
 
         auto state =
             MarketData::PriceStoreGateway::instance().getUnifiedSnapshot(2,
@@ -265,8 +261,8 @@ void ATMWatchWindow::updateDataIncrementally() {
     if (underlyingChanged && m_previousATMData.contains(symbol)) {
       if (oldInfo.underlyingToken > 0) {
         m_underlyingTokenToSymbol.remove(oldInfo.underlyingToken);
-        feed.unsubscribe(1, oldInfo.underlyingToken, this);
-        feed.unsubscribe(2, oldInfo.underlyingToken, this);
+        m_tickFeed->removeKey(FeedHandler::makeKey(1, oldInfo.underlyingToken));
+        m_tickFeed->removeKey(FeedHandler::makeKey(2, oldInfo.underlyingToken));
       }
     }
   }
@@ -297,7 +293,7 @@ void ATMWatchWindow::updateDataIncrementally() {
         if (token <= 0)
           return;
         m_tokenToInfo[token] = {newInfo.symbol, isCall};
-        feed.subscribe(2, token, this, &ATMWatchWindow::onTickUpdate);
+        m_tickFeed->addKey(FeedHandler::makeKey(2, token));
 
         auto state =
             MarketData::PriceStoreGateway::instance().getUnifiedSnapshot(2,
@@ -358,8 +354,8 @@ void ATMWatchWindow::updateDataIncrementally() {
 
   for (int64_t token : tokensToRemove) {
     m_underlyingTokenToSymbol.remove(token);
-    feed.unsubscribe(1, token, this);
-    feed.unsubscribe(2, token, this);
+    m_tickFeed->removeKey(FeedHandler::makeKey(1, token));
+    m_tickFeed->removeKey(FeedHandler::makeKey(2, token));
   }
 
   for (auto it = desiredMap.begin(); it != desiredMap.end(); ++it) {
@@ -368,8 +364,8 @@ void ATMWatchWindow::updateDataIncrementally() {
 
     if (!m_underlyingTokenToSymbol.contains(token)) {
       m_underlyingTokenToSymbol[token] = symbol;
-      feed.subscribe(1, token, this, &ATMWatchWindow::onTickUpdate);
-      feed.subscribe(2, token, this, &ATMWatchWindow::onTickUpdate);
+      m_tickFeed->addKey(FeedHandler::makeKey(1, token));
+      m_tickFeed->addKey(FeedHandler::makeKey(2, token));
 
       auto state = MarketData::PriceStoreGateway::instance().getUnifiedSnapshot(
           1, token);
@@ -47,7 +47,7 @@ void BaseBookWindow::toggleFilterRow(QAbstractItemModel* model, QTableView* tabl
         m_filterWidgets.clear();
         
         QAbstractItemModel* viewModel = tableView->model();
-        QSortFilterProxyModel* proxy = qobject_cast<QSortFilterProxyModel*>(viewModel);
+        QAbstractProxyModel* proxy = qobject_cast<QAbstractProxyModel*>(viewModel);
 
         for (int i = 0; i < model->columnCount(); ++i) {
             GenericTableFilter* fw = new GenericTableFilter(i, model, tableView, GenericTableFilter::CombinedMode, tableView);
@@ -75,7 +75,7 @@ void BaseBookWindow::toggleFilterRow(QAbstractItemModel* model, QTableView* tabl
         }
     } else {
         QAbstractItemModel* viewModel = tableView->model();
-        QSortFilterProxyModel* proxy = qobject_cast<QSortFilterProxyModel*>(viewModel);
+        QAbstractProxyModel* proxy = qobject_cast<QAbstractProxyModel*>(viewModel);
 
         for (int i = 0; i < model->columnCount(); ++i) {
              QModelIndex sourceIdx = model->index(0, i);
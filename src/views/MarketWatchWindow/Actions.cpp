@@ -115,41 +115,13 @@ bool MarketWatchWindow::addScrip(const QString &symbol, const QString &exchange,
 
   TokenSubscriptionManager::instance()->subscribe(exchange, token);
 
-  // Subscribe to UDP ticks
   UDP::ExchangeSegment segment = exchangeToSegment(exchange);
-  FeedHandler::instance().subscribeUDP(segment, token, this,
-                                       &MarketWatchWindow::onUdpTickUpdate);
-
-  // Initial Load from Distributed Store (thread-safe snapshot)
-  if (m_useZeroCopyPriceCache) {
-    auto data = MarketData::PriceStoreGateway::instance().getUnifiedSnapshot(
-        static_cast<int>(segment), token);
-    if (data.token != 0 && data.ltp > 0) {
-      // Update via onUdpTickUpdate for consistency
-      UDP::MarketTick udpTick;
-      udpTick.exchangeSegment = segment;
-      udpTick.token = token;
-      udpTick.ltp = data.ltp;
-      udpTick.open = data.open;
-      udpTick.high = data.high;
-      udpTick.low = data.low;
-      udpTick.prevClose = data.close;
-      udpTick.volume = data.volume;
-      udpTick.atp = data.avgPrice;
-
-      // Copy best depth
-      udpTick.bids[0].price = data.bids[0].price;
-      udpTick.bids[0].quantity = data.bids[0].quantity;
-      udpTick.asks[0].price = data.asks[0].price;
-      udpTick.asks[0].quantity = data.asks[0].quantity;
-
-      onUdpTickUpdate(udpTick);
-    }
-  }
-
   m_tokenAddressBook->addCompositeToken(exchange, "", token, newRow);
   m_tokenAddressBook->addIntKeyToken(static_cast<int>(segment), token, newRow);
 
+  // Subscribe to UDP ticks + initial load (the row must be mapped first)
+  startRowFeed(segment, token);
+
   emit scripAdded(scrip.symbol, exchange, token);
   return true;
 }
@@ -201,34 +173,11 @@ void MarketWatchWindow::addScrips(const QList<ScripData> &scrips) {
                                                     scrip.token);
 
     UDP::ExchangeSegment segment = exchangeToSegment(scrip.exchange);
-    FeedHandler::instance().subscribeUDP(segment, scrip.token, this,
-                                         &MarketWatchWindow::onUdpTickUpdate);
-
-    if (m_useZeroCopyPriceCache) {
-      auto data = MarketData::PriceStoreGateway::instance().getUnifiedSnapshot(
-          static_cast<int>(segment), scrip.token);
-      if (data.token != 0 && data.ltp > 0) {
-        UDP::MarketTick udpTick;
-        udpTick.exchangeSegment = segment;
-        udpTick.token = scrip.token;
-        udpTick.ltp = data.ltp;
-        udpTick.open = data.open;
-        udpTick.high = data.high;
-        udpTick.low = data.low;
-        udpTick.prevClose = data.close;
-        udpTick.volume = data.volume;
-        udpTick.atp = data.avgPrice;
-        udpTick.bids[0].price = data.bids[0].price;
-        udpTick.bids[0].quantity = data.bids[0].quantity;
-        udpTick.asks[0].price = data.asks[0].price;
-        udpTick.asks[0].quantity = data.asks[0].quantity;
-        onUdpTickUpdate(udpTick);
-      }
-    }
-
     m_tokenAddressBook->addCompositeToken(scrip.exchange, "", scrip.token, row);
     m_tokenAddressBook->addIntKeyToken(static_cast<int>(segment), scrip.token,
                                        row);
+    // Viewport mode: only the rows that end up on screen get a callback
+    startRowFeed(segment, scrip.token);
     emit scripAdded(scrip.symbol, scrip.exchange, scrip.token);
   }
 }
@@ -282,42 +231,15 @@ bool MarketWatchWindow::addScripFromContract(const ScripData &contractData) {
 
   TokenSubscriptionManager::instance()->subscribe(scrip.exchange, scrip.token);
 
-  // Subscribe to UDP ticks
   UDP::ExchangeSegment segment = exchangeToSegment(scrip.exchange);
-  FeedHandler::instance().subscribeUDP(segment, scrip.token, this,
-                                       &MarketWatchWindow::onUdpTickUpdate);
-
-  // Initial Load from Distributed Store (thread-safe snapshot)
-  if (m_useZeroCopyPriceCache) {
-    auto data = MarketData::PriceStoreGateway::instance().getUnifiedSnapshot(
-        static_cast<int>(segment), scrip.token);
-    if (data.token != 0 && data.ltp > 0) {
-      UDP::MarketTick udpTick;
-      udpTick.exchangeSegment = segment;
-      udpTick.token = scrip.token;
-      udpTick.ltp = data.ltp;
-      udpTick.open = data.open;
-      udpTick.high = data.high;
-      udpTick.low = data.low;
-      udpTick.prevClose = data.close;
-      udpTick.volume = data.volume;
-      udpTick.atp = data.avgPrice;
-
-      // Copy best depth
-      udpTick.bids[0].price = data.bids[0].price;
-      udpTick.bids[0].quantity = data.bids[0].quantity;
-      udpTick.asks[0].price = data.asks[0].price;
-      udpTick.asks[0].quantity = data.asks[0].quantity;
-
-      onUdpTickUpdate(udpTick);
-    }
-  }
-
   m_tokenAddressBook->addCompositeToken(scrip.exchange, "", scrip.token,
                                         newRow);
   m_tokenAddressBook->addIntKeyToken(static_cast<int>(segment), scrip.token,
                                      newRow);
 
+  // Subscribe to UDP ticks + initial load (the row must be mapped first)
+  startRowFeed(segment, scrip.token);
+
   emit scripAdded(scrip.symbol, scrip.exchange, scrip.token);
 
   // Set focus to the newly added scrip
@@ -344,8 +266,7 @@ void MarketWatchWindow::removeScrip(int row) {
 
     // Unsubscribe from UDP ticks
     UDP::ExchangeSegment segment = exchangeToSegment(scrip.exchange);
-    FeedHandler::instance().unsubscribe(static_cast<int>(segment), scrip.token,
-                                        this);
+    stopRowFeed(segment, scrip.token);
 
     m_tokenAddressBook->removeCompositeToken(scrip.exchange, "", scrip.token,
                                              row);
@@ -358,6 +279,7 @@ void MarketWatchWindow::removeScrip(int row) {
 
 void MarketWatchWindow::clearAll() {
   FeedHandler::instance().unsubscribeAll(this);
+  m_viewport.clear();
   for (int row = 0; row < m_model->rowCount(); ++row) {
     const ScripData &scrip = m_model->getScripAt(row);
     if (scrip.isValid()) {
@@ -456,15 +378,14 @@ void MarketWatchWindow::pasteFromClipboard() {
       TokenSubscriptionManager::instance()->subscribe(scrip.exchange,
                                                       scrip.token);
 
-      // Subscribe to UDP ticks
       UDP::ExchangeSegment segment = exchangeToSegment(scrip.exchange);
-      FeedHandler::instance().subscribeUDP(segment, scrip.token, this,
-                                           &MarketWatchWindow::onUdpTickUpdate);
-
       m_tokenAddressBook->addCompositeToken(scrip.exchange, "", scrip.token,
                                             currentInsertPos);
       m_tokenAddressBook->addIntKeyToken(static_cast<int>(segment), scrip.token,
                                          currentInsertPos);
+
+      // Subscribe to UDP ticks + initial load
+      startRowFeed(segment, scrip.token);
       emit scripAdded(scrip.symbol, scrip.exchange, scrip.token);
       currentInsertPos++;
     }
@@ -696,9 +617,7 @@ void MarketWatchWindow::performRowMoveByTokens(const QList<int> &tokens,
       if (scrips[i].isValid()) {
         TokenSubscriptionManager::instance()->subscribe(scrips[i].exchange,
                                                         scrips[i].token);
-        UDP::ExchangeSegment udpSeg = exchangeToSegment(scrips[i].exchange);
-        FeedHandler::instance().subscribeUDP(
-            udpSeg, scrips[i].token, this, &MarketWatchWindow::onUdpTickUpdate);
+        startRowFeed(exchangeToSegment(scrips[i].exchange), scrips[i].token);
       }
     }
   }
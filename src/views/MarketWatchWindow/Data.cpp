@@ -1,7 +1,9 @@
+#include "data/PriceStoreGateway.h"
 #include "models/domain/TokenAddressBook.h"
 #include "repository/RepositoryManager.h"
 #include "utils/LatencyTracker.h"
 #include "views/MarketWatchWindow.h"
+#include "views/helpers/MarketWatchHelpers.h"
 #include <QDateTime>
 #include <QDebug>
 #include <QElapsedTimer>
@@ -71,7 +73,6 @@ void MarketWatchWindow::updateLastTradedQuantity(int token, qint64 ltq) {
 
 void MarketWatchWindow::onTickUpdate(const XTS::Tick &tick) {
   int token = (int)tick.exchangeInstrumentID;
-  int64_t timestampModelStart = LatencyTracker::now();
 
   // Use optimized int64 composite key lookup
   QList<int> rows =
@@ -112,7 +113,7 @@ void MarketWatchWindow::onTickUpdate(const XTS::Tick &tick) {
     if (closePrice <= 0) {
       // Use the first row to get the close price (assuming close is same for
       // all duplicates of same exchange contract)
-      closePrice = m_model->getScripAt(rows.first()).close;
+      closePrice = m_model->closePriceAt(rows.first());
     }
 
     if (closePrice > 0) {
@@ -178,24 +179,25 @@ void MarketWatchWindow::onTickUpdate(const XTS::Tick &tick) {
   int64_t timestampModelEnd = LatencyTracker::now();
 
   if (tick.refNo > 0 && tick.timestampUdpRecv > 0) {
-    LatencyTracker::recordLatency(tick.timestampUdpRecv, tick.timestampParsed,
-                                  tick.timestampQueued, tick.timestampDequeued,
-                                  tick.timestampFeedHandler,
-                                  timestampModelStart, timestampModelEnd);
+    LatencyTracker::recordModelUpdate(tick.exchangeSegment,
+                                      tick.timestampUdpRecv,
+                                      tick.timestampFeedHandler,
+                                      timestampModelEnd);
   }
 }
 
 // NEW: UDP-specific tick handler with cleaner semantics
-// Optimized: uses batch updateFromUdpTick() — ONE dataChanged per row per tick
+// Optimized: uses batch updateFromUdpTick() — at most ONE dataChanged per row
+// per tick; with coalescing on, dirty rows are flushed once per frame instead
 void MarketWatchWindow::onUdpTickUpdate(const UDP::MarketTick &tick) {
   int token = tick.token;
-  int64_t timestampModelStart = LatencyTracker::now();
 
-  // Use optimized int64 composite key lookup
-  QList<int> rows = m_tokenAddressBook->getRowsForIntKey(
+  // Flat-hash int64 key lookup; the span views the address book's own
+  // storage (no QList copy) and stays valid — nothing below edits rows
+  TokenAddressBook::RowSpan rows = m_tokenAddressBook->rowsForIntKey(
       static_cast<int>(tick.exchangeSegment), token);
 
-  if (rows.isEmpty())
+  if (rows.empty())
     return;
 
   // Pre-calculate change values once (shared across all rows for same token)
@@ -204,7 +206,7 @@ void MarketWatchWindow::onUdpTickUpdate(const UDP::MarketTick &tick) {
   if (tick.ltp > 0) {
     double closePrice = tick.prevClose;
     if (closePrice <= 0) {
-      closePrice = m_model->getScripAt(rows.first()).close;
+      closePrice = m_model->closePriceAt(rows.front());
     }
     if (closePrice > 0) {
       change = tick.ltp - closePrice;
@@ -219,12 +221,43 @@ void MarketWatchWindow::onUdpTickUpdate(const UDP::MarketTick &tick) {
 
   int64_t timestampModelEnd = LatencyTracker::now();
 
-  // Latency tracking
-  if (tick.refNo > 0 && tick.timestampUdpRecv > 0) {
-    LatencyTracker::recordLatency(
-        tick.timestampUdpRecv, tick.timestampParsed, tick.timestampEmitted,
-        0, tick.timestampFeedHandler, timestampModelStart, timestampModelEnd);
+  // Latency histograms (feed-side stages were recorded in FeedHandler)
+  if (tick.timestampUdpRecv > 0) {
+    LatencyTracker::recordModelUpdate(static_cast<int>(tick.exchangeSegment),
+                                      tick.timestampUdpRecv,
+                                      tick.timestampFeedHandler,
+                                      timestampModelEnd);
+  }
+}
+
+void MarketWatchWindow::startRowFeed(UDP::ExchangeSegment segment, int token) {
+  if (m_viewportMode) {
+    // Keep the store row current (snapshots, re-rank); the per-tick
+    // callback follows the viewport
+    FeedHandler::instance().subscribe(static_cast<int>(segment), token);
+    scheduleViewportSync();
+  } else {
+    FeedHandler::instance().subscribeUDP(segment, token, this,
+                                         &MarketWatchWindow::onUdpTickUpdate);
   }
+
+  // Initial load from the distributed store (thread-safe snapshot)
+  if (m_useZeroCopyPriceCache)
+    seedRowFromStore(static_cast<int>(segment), token);
+}
+
+void MarketWatchWindow::stopRowFeed(UDP::ExchangeSegment segment, int token) {
+  FeedHandler::instance().unsubscribe(static_cast<int>(segment), token, this);
+  m_viewport.forget(FeedHandler::makeKey(static_cast<int>(segment), token));
+}
+
+void MarketWatchWindow::seedRowFromStore(int segment, int token) {
+  auto data =
+      MarketData::PriceStoreGateway::instance().getUnifiedSnapshot(segment, token);
+  if (data.token == 0 || data.ltp <= 0)
+    return;
+  // Through onUdpTickUpdate for consistency (change %, flash, every row)
+  onUdpTickUpdate(MarketWatchHelpers::tickFromStore(segment, data.token, data, data));
 }
 
 int MarketWatchWindow::findTokenRow(int token) const {
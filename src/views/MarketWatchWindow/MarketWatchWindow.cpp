@@ -31,6 +31,8 @@
 // PERFORMANCE OPTIMIZATION: Cache preference to avoid 50ms disk I/O per window
 static bool s_useZeroCopyPriceCache_Cached = false;
 static bool s_preferenceCached = false;
+static int s_flushIntervalMs_Cached = 16;
+static bool s_viewportMode_Cached = true;
 
 MarketWatchWindow::MarketWatchWindow(QWidget *parent)
     : CustomMarketWatch(parent), m_model(nullptr), m_tokenAddressBook(nullptr),
@@ -102,6 +104,8 @@ MarketWatchWindow::MarketWatchWindow(QWidget *parent)
   if (!s_preferenceCached) {
     PreferencesManager &prefs = PreferencesManager::instance();
     s_useZeroCopyPriceCache_Cached = !prefs.getUseLegacyPriceCache();
+    s_flushIntervalMs_Cached = prefs.getMarketWatchFlushInterval();
+    s_viewportMode_Cached = prefs.getMarketWatchViewportMode();
     s_preferenceCached = true;
     qDebug() << "[PERF] [MARKETWATCH_CONSTRUCT] First window - loaded "
                 "preference from disk";
@@ -115,6 +119,27 @@ MarketWatchWindow::MarketWatchWindow(QWidget *parent)
   qDebug() << "[MarketWatch] PriceCache mode:"
            << (m_useZeroCopyPriceCache ? "ZERO-COPY (New)" : "LEGACY (Old)");
 
+  // Frame-coalesced repaints: ticks mark cells dirty, one flush per interval
+  m_model->setCoalesceInterval(s_flushIntervalMs_Cached);
+
+  // Live feed only for the rows on screen (see Viewport.cpp)
+  setupViewport();
+  setViewportMode(s_viewportMode_Cached);
+
+  connect(&PreferencesManager::instance(),
+          &PreferencesManager::preferencesChanged, this,
+          [this](const QString &key) {
+            if (key == "marketwatch/flush_interval_ms") {
+              s_flushIntervalMs_Cached =
+                  PreferencesManager::instance().getMarketWatchFlushInterval();
+              m_model->setCoalesceInterval(s_flushIntervalMs_Cached);
+            } else if (key == "marketwatch/viewport_mode") {
+              s_viewportMode_Cached =
+                  PreferencesManager::instance().getMarketWatchViewportMode();
+              setViewportMode(s_viewportMode_Cached);
+            }
+          });
+
   // OPTIMIZATION: Defer shortcuts and settings to after window is visible
   QTimer::singleShot(0, this, [this]() {
     QElapsedTimer deferredTimer;
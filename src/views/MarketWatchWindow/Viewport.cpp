@@ -0,0 +1,209 @@
+#include "data/PriceStoreGateway.h"
+#include "models/domain/TokenAddressBook.h"
+#include "views/MarketWatchWindow.h"
+#include "views/helpers/MarketWatchHelpers.h"
+#include <QDebug>
+#include <QResizeEvent>
+#include <QScrollBar>
+#include <QtConcurrent>
+#include <algorithm>
+
+// ============================================================================
+// VIEWPORT MODE
+// ============================================================================
+// A whole-segment watch (every NIFTY option) holds thousands of rows while
+// ~40 are painted. Per-tick callbacks are kept only for the visible rows plus
+// a prefetch margin (ViewportSubscriptions). Every row stays enabled at the
+// feed sources, so the price store keeps it current:
+// - rows scrolling in are filled from a store snapshot
+// - a background re-rank collects the off-screen rows that changed in the
+//   store since its last pass and applies them, then re-sorts when the view
+//   is sorted on a live column
+// ============================================================================
+
+namespace {
+
+constexpr int kRerankIntervalMs = 1000;
+
+int segmentOf(int64_t key) { return static_cast<int>(key >> 32); }
+int tokenOf(int64_t key) { return static_cast<int>(key & 0xFFFFFFFF); }
+
+} // namespace
+
+void MarketWatchWindow::setupViewport() {
+  // Scroll steps, resizes and model changes of one event loop pass resync once
+  m_viewportSyncTimer.setSingleShot(true);
+  m_viewportSyncTimer.setInterval(0);
+  connect(&m_viewportSyncTimer, &QTimer::timeout, this,
+          &MarketWatchWindow::syncViewport);
+
+  connect(verticalScrollBar(), &QScrollBar::valueChanged, this,
+          &MarketWatchWindow::scheduleViewportSync);
+  QAbstractItemModel *proxy = proxyModel();
+  connect(proxy, &QAbstractItemModel::rowsInserted, this,
+          &MarketWatchWindow::scheduleViewportSync);
+  connect(proxy, &QAbstractItemModel::rowsRemoved, this,
+          &MarketWatchWindow::scheduleViewportSync);
+  connect(proxy, &QAbstractItemModel::rowsMoved, this,
+          &MarketWatchWindow::scheduleViewportSync);
+  connect(proxy, &QAbstractItemModel::layoutChanged, this,
+          &MarketWatchWindow::scheduleViewportSync);
+  connect(proxy, &QAbstractItemModel::modelReset, this,
+          &MarketWatchWindow::scheduleViewportSync);
+
+  m_rerankTimer.setInterval(kRerankIntervalMs);
+  connect(&m_rerankTimer, &QTimer::timeout, this,
+          &MarketWatchWindow::startRerank);
+  connect(&m_rerankWatcher, &QFutureWatcher<RerankBatch>::finished, this,
+          &MarketWatchWindow::applyRerank);
+}
+
+void MarketWatchWindow::setViewportMode(bool enabled) {
+  enabled = enabled && m_useZeroCopyPriceCache; // Rows are filled from the store
+  if (enabled == m_viewportMode)
+    return;
+  m_viewportMode = enabled;
+
+  // Rebuild the per-tick subscriptions for the new mode
+  FeedHandler &feed = FeedHandler::instance();
+  feed.unsubscribeAll(this);
+  m_viewport.clear();
+
+  if (enabled) {
+    m_rerankTimer.start();
+    syncViewport();
+    return;
+  }
+
+  m_rerankTimer.stop();
+  m_viewportSyncTimer.stop();
+  for (int row = 0; row < m_model->rowCount(); ++row) {
+    const int64_t key = m_tokenAddressBook->getIntKeyForRow(row);
+    if (key == 0)
+      continue;
+    feed.subscribe(segmentOf(key), tokenOf(key), this,
+                   &MarketWatchWindow::onUdpTickUpdate);
+    seedRowFromStore(segmentOf(key), tokenOf(key)); // Off-screen rows lag
+  }
+}
+
+size_t MarketWatchWindow::liveRowCount() const {
+  return m_viewportMode ? m_viewport.liveCount()
+                        : static_cast<size_t>(m_model->scripCount());
+}
+
+void MarketWatchWindow::resizeEvent(QResizeEvent *event) {
+  CustomMarketWatch::resizeEvent(event);
+  scheduleViewportSync();
+}
+
+void MarketWatchWindow::scheduleViewportSync() {
+  if (m_viewportMode && !m_viewportSyncTimer.isActive())
+    m_viewportSyncTimer.start();
+}
+
+void MarketWatchWindow::syncViewport() {
+  if (!m_viewportMode)
+    return;
+
+  const auto range = m_viewport.liveRange(
+      rowAt(0), rowAt(viewport()->height() - 1), proxyModel()->rowCount());
+
+  std::vector<int64_t> keys;
+  keys.reserve(static_cast<size_t>(std::max(0, range.second - range.first + 1)));
+  for (int proxyRow = range.first; proxyRow <= range.second; ++proxyRow) {
+    const int64_t key =
+        m_tokenAddressBook->getIntKeyForRow(mapToSource(proxyRow));
+    if (key != 0)
+      keys.push_back(key);
+  }
+
+  const ViewportSubscriptions::Delta delta = m_viewport.update(keys);
+  FeedHandler &feed = FeedHandler::instance();
+  for (int64_t key : delta.removed)
+    feed.unsubscribe(segmentOf(key), tokenOf(key), this);
+  for (int64_t key : delta.added) {
+    feed.subscribe(segmentOf(key), tokenOf(key), this,
+                   &MarketWatchWindow::onUdpTickUpdate);
+    // Missed ticks while off screen: catch up before the next paint
+    seedRowFromStore(segmentOf(key), tokenOf(key));
+  }
+}
+
+// ============================================================================
+// Background re-rank
+// ============================================================================
+
+void MarketWatchWindow::startRerank() {
+  if (!m_viewportMode || m_rerankWatcher.isRunning())
+    return;
+
+  // Off-screen rows, per segment (live rows are already current)
+  std::unordered_map<int, std::vector<uint32_t>> tokens;
+  const int rows = m_model->rowCount();
+  for (int row = 0; row < rows; ++row) {
+    const int64_t key = m_tokenAddressBook->getIntKeyForRow(row);
+    if (key == 0 || m_viewport.isLive(key))
+      continue;
+    tokens[segmentOf(key)].push_back(static_cast<uint32_t>(tokenOf(key)));
+  }
+  if (tokens.empty())
+    return;
+
+  // Lock-free store reads on a pool thread; only changed rows are copied
+  m_rerankWatcher.setFuture(QtConcurrent::run(
+      [tokens = std::move(tokens), since = m_rerankWatermarks]() {
+        return collectStoreChanges(tokens, since);
+      }));
+}
+
+MarketWatchWindow::RerankBatch MarketWatchWindow::collectStoreChanges(
+    const std::unordered_map<int, std::vector<uint32_t>> &tokens,
+    const std::unordered_map<int, uint64_t> &since) {
+  RerankBatch batch;
+  auto &gateway = MarketData::PriceStoreGateway::instance();
+  std::vector<MarketData::TouchlineChange> changes;
+
+  for (const auto &entry : tokens) {
+    const int segment = entry.first;
+    auto last = since.find(segment);
+    changes.clear();
+    batch.watermarks[segment] = gateway.changedSince(
+        segment, last == since.end() ? 0 : last->second, entry.second, changes);
+
+    for (const MarketData::TouchlineChange &change : changes) {
+      batch.ticks.push_back(MarketWatchHelpers::tickFromStore(
+          segment, change.token, change.block,
+          gateway.getDepth(segment, change.token)));
+    }
+  }
+  return batch;
+}
+
+void MarketWatchWindow::applyRerank() {
+  RerankBatch batch = m_rerankWatcher.result();
+  for (const auto &entry : batch.watermarks)
+    m_rerankWatermarks[entry.first] = entry.second;
+  if (!m_viewportMode)
+    return;
+
+  int applied = 0;
+  for (const UDP::MarketTick &tick : batch.ticks) {
+    // Rows that became live meanwhile already have newer ticks; rows removed
+    // meanwhile are ignored by onUdpTickUpdate
+    if (m_viewport.isLive(FeedHandler::makeKey(
+            static_cast<int>(tick.exchangeSegment), tick.token)))
+      continue;
+    onUdpTickUpdate(tick);
+    ++applied;
+  }
+  if (applied == 0)
+    return;
+
+  // Header sorting is not dynamic (see CustomMarketWatch::setSourceModel):
+  // re-apply a sort on a live column so off-screen movers take their place
+  QSortFilterProxyModel *proxy = proxyModel();
+  const int column = proxy->sortColumn();
+  if (column >= 0 && m_model->isLiveColumn(column))
+    proxy->sort(column, proxy->sortOrder());
+}
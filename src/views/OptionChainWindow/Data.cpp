@@ -182,37 +182,55 @@ void OptionChainWindow::refreshData() {
 
   RepositoryManager *repo = RepositoryManager::getInstance();
 
+  // Strikes ascending with parallel CE / PE tokens (0 = not listed)
   int exchangeSegment = 2; // NSEFO
-  QVector<ContractData> contracts = repo->getOptionChain("NSE", symbol);
-  if (contracts.isEmpty()) {
-    contracts = repo->getOptionChain("BSE", symbol);
-    exchangeSegment = 12; // BSEFO
-  }
-
-  m_exchangeSegment = exchangeSegment;
-
-  QMap<double, ContractData> callContracts;
-  QMap<double, ContractData> putContracts;
-  QSet<double> strikes;
+  QList<double> sortedStrikes;
+  QVector<int64_t> callTokens;
+  QVector<int64_t> putTokens;
+
+  const auto catalog = repo->contractCatalog();
+  const ContractCatalog::Chain *chain =
+      expiry.isEmpty() ? nullptr : catalog->chain(symbol, expiry);
+  if (chain) {
+    // NSE chain: already sorted and columnar
+    sortedStrikes.reserve(chain->strikes.size());
+    for (double strike : chain->strikes)
+      sortedStrikes.append(strike);
+    callTokens = chain->callTokens;
+    putTokens = chain->putTokens;
+  } else {
+    // BSE (or all expiries): build from the contract list
+    QVector<ContractData> contracts = repo->getOptionChain("NSE", symbol);
+    if (contracts.isEmpty()) {
+      contracts = repo->getOptionChain("BSE", symbol);
+      exchangeSegment = 12; // BSEFO
+    }
 
-  for (const auto &contract : contracts) {
-    if (!expiry.isEmpty() && contract.expiryDate != expiry)
-      continue;
-
-    strikes.insert(contract.strikePrice);
-    if (contract.optionType == "CE") {
-      callContracts[contract.strikePrice] = contract;
-    } else if (contract.optionType == "PE") {
-      putContracts[contract.strikePrice] = contract;
+    QMap<double, QPair<int64_t, int64_t>> strikeTokens;
+    for (const auto &contract : contracts) {
+      if (!expiry.isEmpty() && contract.expiryDate != expiry)
+        continue;
+      if (contract.optionType == "CE") {
+        strikeTokens[contract.strikePrice].first =
+            contract.exchangeInstrumentID;
+      } else if (contract.optionType == "PE") {
+        strikeTokens[contract.strikePrice].second =
+            contract.exchangeInstrumentID;
+      }
+    }
+    for (auto it = strikeTokens.cbegin(); it != strikeTokens.cend(); ++it) {
+      sortedStrikes.append(it.key());
+      callTokens.append(it.value().first);
+      putTokens.append(it.value().second);
     }
   }
 
-  if (strikes.isEmpty()) {
+  m_exchangeSegment = exchangeSegment;
+
+  if (sortedStrikes.isEmpty()) {
     return;
   }
 
-  QList<double> sortedStrikes = strikes.values();
-  std::sort(sortedStrikes.begin(), sortedStrikes.end());
   m_strikes = sortedStrikes;
 
   QList<QList<QStandardItem *>> callRows;
@@ -220,87 +238,89 @@ void OptionChainWindow::refreshData() {
   QList<QStandardItem *> strikeRows;
 
   FeedHandler &feed = FeedHandler::instance();
+  auto &gateway = MarketData::PriceStoreGateway::instance();
 
-  for (double strike : sortedStrikes) {
+  for (int i = 0; i < sortedStrikes.size(); ++i) {
+    const double strike = sortedStrikes[i];
     OptionStrikeData data;
     data.strikePrice = strike;
 
-    if (callContracts.contains(strike)) {
-      data.callToken = callContracts[strike].exchangeInstrumentID;
+    if (callTokens[i] > 0) {
+      data.callToken = callTokens[i];
 
       feed.subscribe(exchangeSegment, data.callToken, this,
                      &OptionChainWindow::onTickUpdate);
 
       m_tokenToStrike[data.callToken] = strike;
 
-      auto unifiedState =
-          MarketData::PriceStoreGateway::instance().getUnifiedSnapshot(
-              exchangeSegment, data.callToken);
-      if (unifiedState.token != 0) {
-        if (unifiedState.ltp > 0) {
-          data.callLTP = unifiedState.ltp;
-          if (unifiedState.close > 0)
-            data.callChng = unifiedState.ltp - unifiedState.close;
+      auto tick = gateway.getTouchline(exchangeSegment, data.callToken);
+      if (tick.token != 0) {
+        auto depth = gateway.getDepth(exchangeSegment, data.callToken);
+        auto greeks = gateway.getGreeks(exchangeSegment, data.callToken);
+        if (tick.ltp > 0) {
+          data.callLTP = tick.ltp;
+          if (tick.close > 0)
+            data.callChng = tick.ltp - tick.close;
         }
-        if (unifiedState.bids[0].price > 0)
-          data.callBid = unifiedState.bids[0].price;
-        if (unifiedState.asks[0].price > 0)
-          data.callAsk = unifiedState.asks[0].price;
-        if (unifiedState.bids[0].quantity > 0)
-          data.callBidQty = unifiedState.bids[0].quantity;
-        if (unifiedState.asks[0].quantity > 0)
-          data.callAskQty = unifiedState.asks[0].quantity;
-        if (unifiedState.volume > 0)
-          data.callVolume = unifiedState.volume;
-        if (unifiedState.openInterest > 0)
-          data.callOI = (int)unifiedState.openInterest;
-
-        if (unifiedState.greeksCalculated) {
-          data.callIV = unifiedState.impliedVolatility;
-          data.callDelta = unifiedState.delta;
-          data.callGamma = unifiedState.gamma;
-          data.callVega = unifiedState.vega;
-          data.callTheta = unifiedState.theta;
+        if (depth.bids[0].price > 0)
+          data.callBid = depth.bids[0].price;
+        if (depth.asks[0].price > 0)
+          data.callAsk = depth.asks[0].price;
+        if (depth.bids[0].quantity > 0)
+          data.callBidQty = depth.bids[0].quantity;
+        if (depth.asks[0].quantity > 0)
+          data.callAskQty = depth.asks[0].quantity;
+        if (tick.volume > 0)
+          data.callVolume = tick.volume;
+        if (tick.openInterest > 0)
+          data.callOI = (int)tick.openInterest;
+
+        if (greeks.greeksCalculated) {
+          data.callIV = greeks.impliedVolatility;
+          data.callDelta = greeks.delta;
+          data.callGamma = greeks.gamma;
+          data.callVega = greeks.vega;
+          data.callTheta = greeks.theta;
         }
       }
     }
 
-    if (putContracts.contains(strike)) {
-      data.putToken = putContracts[strike].exchangeInstrumentID;
+    if (putTokens[i] > 0) {
+      data.putToken = putTokens[i];
 
       feed.subscribe(exchangeSegment, data.putToken, this,
                      &OptionChainWindow::onTickUpdate);
 
       m_tokenToStrike[data.putToken] = strike;
 
-      auto unifiedState =
-          MarketData::PriceStoreGateway::instance().getUnifiedSnapshot(
-              exchangeSegment, data.putToken);
-      if (unifiedState.token != 0) {
-        if (unifiedState.ltp > 0) {
-          data.putLTP = unifiedState.ltp;
-          if (unifiedState.close > 0)
-            data.putChng = unifiedState.ltp - unifiedState.close;
+      auto tick = gateway.getTouchline(exchangeSegment, data.putToken);
+      if (tick.token != 0) {
+        auto depth = gateway.getDepth(exchangeSegment, data.putToken);
+        auto greeks = gateway.getGreeks(exchangeSegment, data.putToken);
+        if (tick.ltp > 0) {
+          data.putLTP = tick.ltp;
+          if (tick.close > 0)
+            data.putChng = tick.ltp - tick.close;
         }
-        if (unifiedState.bids[0].price > 0)
-          data.putBid = unifiedState.bids[0].price;
-        if (unifiedState.asks[0].price > 0)
-          data.putAsk = unifiedState.asks[0].price;
-        if (unifiedState.bids[0].quantity > 0)
-          data.putBidQty = (int)unifiedState.bids[0].quantity;
-        if (unifiedState.asks[0].quantity > 0)
-          data.putAskQty = (int)unifiedState.asks[0].quantity;
-        if (unifiedState.volume > 0)
-          data.putVolume = (int)unifiedState.volume;
-        if (unifiedState.openInterest > 0)
-          data.putOI = (int)unifiedState.openInterest;
-
-        if (unifiedState.greeksCalculated) {
-          data.putIV = unifiedState.impliedVolatility;
-          data.putDelta = unifiedState.delta;
-          data.putGamma = unifiedState.gamma;
-          data.putVega = unifiedState.vega;
-          data.putTheta = unifiedState.theta;
+        if (depth.bids[0].price > 0)
+          data.putBid = depth.bids[0].price;
+        if (depth.asks[0].price > 0)
+          data.putAsk = depth.asks[0].price;
+        if (depth.bids[0].quantity > 0)
+          data.putBidQty = (int)depth.bids[0].quantity;
+        if (depth.asks[0].quantity > 0)
+          data.putAskQty = (int)depth.asks[0].quantity;
+        if (tick.volume > 0)
+          data.putVolume = (int)tick.volume;
+        if (tick.openInterest > 0)
+          data.putOI = (int)tick.openInterest;
+
+        if (greeks.greeksCalculated) {
+          data.putIV = greeks.impliedVolatility;
+          data.putDelta = greeks.delta;
+          data.putGamma = greeks.gamma;
+          data.putVega = greeks.vega;
+          data.putTheta = greeks.theta;
         }
       }
     }
@@ -560,6 +580,37 @@ void OptionChainWindow::recalculateATMStrike() {
   }
 }
 
+// Future of the symbol for the expiry, else its first listed future
+static int64_t findFutureToken(RepositoryManager *repo, int exchangeSegment,
+                               const QString &symbol, const QString &expiry) {
+  if (exchangeSegment != 12) {
+    // NSE: the catalog chain carries the pair's future
+    const auto catalog = repo->contractCatalog();
+    if (const auto *chain = catalog->chain(symbol, expiry)) {
+      if (chain->futureToken > 0)
+        return chain->futureToken;
+    }
+    const ContractCatalog::SymbolId id = catalog->symbolId(symbol);
+    for (ContractCatalog::ExpiryId day : catalog->expiries(id)) {
+      const auto *chain = catalog->chain(id, day);
+      if (chain->futureToken > 0)
+        return chain->futureToken;
+    }
+    return 0;
+  }
+
+  QVector<ContractData> contracts = repo->getOptionChain("BSE", symbol);
+  for (const auto &c : contracts) {
+    if (c.instrumentType == 1 && c.expiryDate == expiry)
+      return c.exchangeInstrumentID;
+  }
+  for (const auto &c : contracts) {
+    if (c.instrumentType == 1)
+      return c.exchangeInstrumentID;
+  }
+  return 0;
+}
+
 void OptionChainWindow::subscribeToUnderlying() {
   if (m_currentSymbol.isEmpty())
     return;
@@ -574,32 +625,15 @@ void OptionChainWindow::subscribeToUnderlying() {
 
   if (priceSource == "future") {
     // ── FUTURE MODE: subscribe to nearest future contract ──
-    QVector<ContractData> contracts = repo->getOptionChain(
-        (m_exchangeSegment == 12) ? "BSE" : "NSE", m_currentSymbol);
-    
-    int64_t futureToken = 0;
-    for (const auto &c : contracts) {
-      if (c.instrumentType == 1 && c.expiryDate == m_currentExpiry) {
-        futureToken = c.exchangeInstrumentID;
-        break;
-      }
-    }
-    // Fallback: first available future
-    if (futureToken == 0) {
-      for (const auto &c : contracts) {
-        if (c.instrumentType == 1) {
-          futureToken = c.exchangeInstrumentID;
-          break;
-        }
-      }
-    }
+    int64_t futureToken =
+        findFutureToken(repo, m_exchangeSegment, m_currentSymbol, m_currentExpiry);
     
     if (futureToken > 0) {
       m_underlyingToken = static_cast<int>(futureToken);
       FeedHandler::instance().subscribe(m_exchangeSegment, m_underlyingToken, this,
                                        &OptionChainWindow::onTickUpdate);
       
-      auto state = MarketData::PriceStoreGateway::instance().getUnifiedSnapshot(
+      auto state = MarketData::PriceStoreGateway::instance().getTouchline(
           m_exchangeSegment, m_underlyingToken);
       if (state.ltp > 0) {
         m_underlyingPrice = state.ltp;
@@ -633,31 +667,15 @@ void OptionChainWindow::subscribeToUnderlying() {
                  << "finalPrice:" << m_underlyingPrice;
     } else {
       // Fallback to future if no cash token available
-      QVector<ContractData> contracts = repo->getOptionChain(
-          (m_exchangeSegment == 12) ? "BSE" : "NSE", m_currentSymbol);
-      
-      int64_t futureToken = 0;
-      for (const auto &c : contracts) {
-        if (c.instrumentType == 1 && c.expiryDate == m_currentExpiry) {
-          futureToken = c.exchangeInstrumentID;
-          break;
-        }
-      }
-      if (futureToken == 0) {
-        for (const auto &c : contracts) {
-          if (c.instrumentType == 1) {
-            futureToken = c.exchangeInstrumentID;
-            break;
-          }
-        }
-      }
+      int64_t futureToken = findFutureToken(repo, m_exchangeSegment,
+                                            m_currentSymbol, m_currentExpiry);
       
       if (futureToken > 0) {
         m_underlyingToken = static_cast<int>(futureToken);
         FeedHandler::instance().subscribe(m_exchangeSegment, m_underlyingToken, this,
                                          &OptionChainWindow::onTickUpdate);
         
-        auto state = MarketData::PriceStoreGateway::instance().getUnifiedSnapshot(
+        auto state = MarketData::PriceStoreGateway::instance().getTouchline(
             m_exchangeSegment, m_underlyingToken);
         if (state.ltp > 0) {
           m_underlyingPrice = state.ltp;
@@ -5,7 +5,7 @@
 #include "services/TradingDataService.h"
 #include "utils/WindowSettingsHelper.h"
 
-#include "models/qt/PinnedRowProxyModel.h"
+#include "models/qt/LiveSortProxyModel.h"
 #include <QComboBox>
 #include <QDebug>
 #include <QLabel>
@@ -17,18 +17,27 @@
 #include <QVector>
 
 #include "data/PriceStoreGateway.h"
+#include "services/FeedHandler.h"
 #include <QMutexLocker>
-#include <QTimer>
 
 
 PositionWindow::PositionWindow(TradingDataService *tradingDataService,
                                QWidget *parent)
     : BaseBookWindow("PositionBook", parent),
       ui(new Ui::PositionWindow),
-      m_tradingDataService(tradingDataService), m_isUpdating(false) {
+      m_tradingDataService(tradingDataService), m_priceFeed(nullptr) {
   setupUI();
   loadInitialProfile();
 
+  // Market prices: latest LTP of each position's token, at most 4 batches/s
+  // (keys are filled in by resyncPriceFeed() whenever positions change)
+  m_priceFeed = FeedHandler::instance().subscribeConflated(
+      this, {}, 4,
+      [this](const std::vector<UDP::MarketTick> &changed) {
+        onPriceBatch(changed);
+      },
+      FeedDispatcher::AllUpdates & ~FeedDispatcher::DepthUpdates);
+
   if (m_tradingDataService) {
     // Connect to real-time position updates from socket events
     connect(m_tradingDataService, &TradingDataService::positionsUpdated, this,
@@ -41,12 +50,6 @@ PositionWindow::PositionWindow(TradingDataService *tradingDataService,
             [this]() { this->toggleFilterRow(); });
   }
 
-  // Initialize 500ms refresh timer for market prices
-  m_priceUpdateTimer = new QTimer(this);
-  connect(m_priceUpdateTimer, &QTimer::timeout, this,
-          &PositionWindow::updateMarketPrices);
-  m_priceUpdateTimer->start(500);
-
   // Restore saved runtime state (combo selections, geometry)
   WindowSettingsHelper::loadAndApplyWindowSettings(this, "PositionBook");
 }
@@ -113,7 +116,8 @@ void PositionWindow::setupTable() {
 
   PositionModel *model = new PositionModel(this);
   m_model = model;
-  m_proxyModel = new PinnedRowProxyModel(this);
+  // MTM / market price columns tick: re-position movers, not a full re-sort
+  m_proxyModel = new LiveSortProxyModel(this);
   m_proxyModel->setSourceModel(m_model);
   m_tableView->setModel(m_proxyModel);
 }
@@ -265,6 +269,7 @@ void PositionWindow::onPositionsUpdated(
   }
   qDebug() << "[PositionWindow] Processed" << m_allPositions.size()
            << "positions. Applying filters...";
+  resyncPriceFeed();
   applyFilters();
 }
 
@@ -620,22 +625,33 @@ void PositionWindow::showPositionContextMenu(const QPoint &pos) {
     menu.exec(m_tableView->viewport()->mapToGlobal(pos));
 }
 
-void PositionWindow::updateMarketPrices() {
-  // Prevent concurrent updates - skip if already updating
-  if (m_isUpdating)
-    return;
+bool PositionWindow::applyMarketPrice(PositionData &pd, double ltp) {
+  if (ltp <= 0 || ltp == pd.marketPrice)
+    return false;
+  pd.marketPrice = ltp;
+
+  // MTM = (Sell Value - Buy Value) + (Net Qty * Current Market Price)
+  // XTS buy/sell values are positive amounts:
+  // Sell 100 @ 100, LTP 90 -> 10000 - 0 + (-100 * 90) = 1000 profit.
+  // Buy 100 @ 100, LTP 110 -> 0 - 10000 + (100 * 110) = 1000 profit.
+  if (pd.netQty != 0) {
+    pd.mtm = pd.sellVal - pd.buyVal + (pd.netQty * ltp);
+  }
 
-  QMutexLocker locker(&m_updateMutex);
-  m_isUpdating = true;
+  pd.netVal = pd.netQty * ltp;
+  pd.totalValue = std::abs(pd.buyVal) + std::abs(pd.sellVal);
+  return true;
+}
 
-  auto &gateway = MarketData::PriceStoreGateway::instance();
-  bool anyChanged = false;
+void PositionWindow::resyncPriceFeed() {
+  // Caller holds m_updateMutex (or runs before any batch can arrive)
+  auto repo = RepositoryManager::getInstance();
+  m_positionsByKey.clear();
 
-  // We iterate over m_allPositions directly
   for (int i = 0; i < m_allPositions.size(); ++i) {
-    PositionData &pd = m_allPositions[i];
+    const PositionData &pd = m_allPositions[i];
 
-    // Construct segment ID logic
+    // CM before FO, the order the price lookup has always used
     int segIds[2] = {0, 0};
     if (pd.exchange == "NSE") {
       segIds[0] = 1;
@@ -644,82 +660,78 @@ void PositionWindow::updateMarketPrices() {
       segIds[0] = 11;
       segIds[1] = 12;
     }
-
-    MarketData::UnifiedState snapshot;
-    bool found = false;
-
-    // Try getting price from first segment candidate
-    if (segIds[0] > 0) {
-      snapshot = gateway.getUnifiedSnapshot(segIds[0], pd.scripCode);
-      if (snapshot.token != 0)
-        found = true;
-
-      // If not found, try second candidate (e.g., if we didn't differentiate CM
-      // vs FO correctly)
-      if (!found && segIds[1] > 0) {
-        snapshot = gateway.getUnifiedSnapshot(segIds[1], pd.scripCode);
-        if (snapshot.token != 0)
-          found = true;
+    if (segIds[0] == 0 || pd.scripCode <= 0)
+      continue;
+
+    // The segment whose master knows the code; both if neither does
+    bool resolved = false;
+    for (int seg : segIds) {
+      if (repo && repo->getContractByToken(seg, pd.scripCode)) {
+        m_positionsByKey[FeedHandler::makeKey(seg, pd.scripCode)].append(i);
+        resolved = true;
+        break;
       }
     }
+    if (!resolved) {
+      for (int seg : segIds)
+        m_positionsByKey[FeedHandler::makeKey(seg, pd.scripCode)].append(i);
+    }
+  }
 
-    if (found) {
-      double ltp = snapshot.ltp;
-      if (ltp > 0 && ltp != pd.marketPrice) {
-        pd.marketPrice = ltp;
-
-        // Recalculate MTM
-        double buyVal = pd.buyVal;   // from API (usually absolute cost)
-        double sellVal = pd.sellVal; // from API (usually absolute revenue)
-
-        // MTM = (Sell Value - Buy Value) + (Net Qty * Current Market Price)
-        // Note: Val fields from XTS might be negative/positive depending on
-        // side. Assuming standard P&L calc: Realized + Unrealized Unrealized =
-        // (Net Qty * LTP) - (Net Qty * Avg Price) Total MTM = Realized +
-        // Unrealized
-
-        // Simplified view update logic:
-        // pd.mtm = currentVal;
-
-        // For now preserving original logic:
-        // double currentVal = sellVal - buyVal + (pd.netQty * ltp);
-        // pd.mtm = currentVal;
-
-        // Actually recalculating MTM based on average price is more standard?
-        // MTM = (Net Qty * LTP) - (Net Invested Value)
-        // For Position Window usually we show Total MTM.
+  std::vector<int64_t> keys;
+  keys.reserve(m_positionsByKey.size());
+  for (auto it = m_positionsByKey.constBegin(); it != m_positionsByKey.constEnd();
+       ++it)
+    keys.push_back(it.key());
+  if (m_priceFeed)
+    m_priceFeed->setKeys(keys);
 
-        // Let's stick to the previous implementation logic:
-        // double currentVal = sellVal - buyVal + (pd.netQty * ltp);
-        // But wait, sellVal/buyVal in XTS are usually positive numbers.
-        // If I Sell 100 @ 100 -> SellVal = 10000. Buy 0. Net Qty = -100.
-        // MTM = 10000 - 0 + (-100 * 90) = 10000 - 9000 = 1000 Profit. Correct.
+  seedMarketPrices();
+}
 
-        // If I Buy 100 @ 100 -> BuyVal = 10000. Sell 0. Net Qty = 100.
-        // MTM = 0 - 10000 + (100 * 110) = -10000 + 11000 = 1000 Profit.
-        // Correct.
+void PositionWindow::seedMarketPrices() {
+  // Once per position refresh: the feed only reports changes from here on.
+  // One batched touchline read per segment, skipping rows never written.
+  QHash<int, std::vector<uint32_t>> tokensBySegment;
+  for (auto it = m_positionsByKey.constBegin(); it != m_positionsByKey.constEnd();
+       ++it)
+    tokensBySegment[static_cast<int>(it.key() >> 32)].push_back(
+        static_cast<uint32_t>(it.key() & 0xFFFFFFFF));
 
-        if (pd.netQty != 0) {
-          pd.mtm = pd.sellVal - pd.buyVal + (pd.netQty * ltp);
-        }
+  auto &gateway = MarketData::PriceStoreGateway::instance();
+  std::vector<MarketData::TouchlineChange> rows;
+  for (auto it = tokensBySegment.constBegin(); it != tokensBySegment.constEnd();
+       ++it) {
+    rows.clear();
+    gateway.changedSince(it.key(), 0, it.value(), rows);
+    for (const MarketData::TouchlineChange &row : rows) {
+      for (int index : m_positionsByKey.value(FeedHandler::makeKey(it.key(), row.token)))
+        applyMarketPrice(m_allPositions[index], row.block.ltp);
+    }
+  }
+}
 
-        pd.netVal = pd.netQty * ltp;
-        pd.totalValue = std::abs(pd.buyVal) + std::abs(pd.sellVal);
+void PositionWindow::onPriceBatch(const std::vector<UDP::MarketTick> &changed) {
+  QMutexLocker locker(&m_updateMutex);
 
-        anyChanged = true;
-      }
-    }
+  bool anyChanged = false;
+  for (const UDP::MarketTick &tick : changed) {
+    auto it = m_positionsByKey.constFind(FeedHandler::makeKey(
+        static_cast<int>(tick.exchangeSegment), static_cast<int>(tick.token)));
+    if (it == m_positionsByKey.constEnd())
+      continue;
+    for (int row : it.value())
+      anyChanged |= applyMarketPrice(m_allPositions[row], tick.ltp);
   }
 
   if (anyChanged) {
     applyFilters(); // Refreshes the model with updated data
   }
-
-  m_isUpdating = false;
 }
 
 void PositionWindow::addPosition(const PositionData &p) {
   m_allPositions.append(p);
+  resyncPriceFeed();
   applyFilters();
 }
 void PositionWindow::updatePosition(const QString &s, const PositionData &p) {
@@ -728,6 +740,7 @@ void PositionWindow::updatePosition(const QString &s, const PositionData &p) {
       m_allPositions[i] = p;
       break;
     }
+  resyncPriceFeed();
   applyFilters();
 }
 
@@ -793,5 +806,6 @@ WindowContext PositionWindow::getSelectedContext() const {
 }
 void PositionWindow::clearPositions() {
   m_allPositions.clear();
+  resyncPriceFeed();
   applyFilters();
 }
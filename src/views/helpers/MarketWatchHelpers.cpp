@@ -256,3 +256,29 @@ ScripData MarketWatchHelpers::scripFromJson(const QJsonObject &obj)
     
     return scrip;
 }
+
+UDP::MarketTick MarketWatchHelpers::tickFromStore(int segment, uint32_t token,
+                                                  const MarketData::TouchlineState &touchline,
+                                                  const MarketData::DepthState &depth)
+{
+    UDP::MarketTick tick(static_cast<UDP::ExchangeSegment>(segment), token);
+    tick.ltp = touchline.ltp;
+    tick.open = touchline.open;
+    tick.high = touchline.high;
+    tick.low = touchline.low;
+    tick.prevClose = touchline.close;
+    tick.atp = touchline.avgPrice;
+    tick.volume = touchline.volume;
+    tick.ltq = touchline.lastTradeQty;
+    tick.openInterest = touchline.openInterest;
+
+    for (int level = 0; level < 5; ++level) {
+        const MarketData::DepthLevel &bid = depth.bids[level];
+        const MarketData::DepthLevel &ask = depth.asks[level];
+        tick.bids[level] = UDP::DepthLevel(bid.price, bid.quantity, bid.orders);
+        tick.asks[level] = UDP::DepthLevel(ask.price, ask.quantity, ask.orders);
+    }
+    tick.totalBidQty = depth.totalBuyQty;
+    tick.totalAskQty = depth.totalSellQty;
+    return tick;
+}
@@ -0,0 +1,309 @@
+/**
+ * @file test_conflated_subscription.cpp
+ * @brief Unit tests for ConflatedSubscription — latest-value batched ticks
+ *
+ * Tests:
+ *  - One batch per flush with only the keys that changed, latest tick each
+ *  - No callback when nothing changed
+ *  - Update-type mask decides what counts as a change
+ *  - Key set: add/remove/setKeys, registrar per new key, pending values of
+ *    a removed key dropped
+ *  - Timer: batches arrive on the owner's thread at the configured rate
+ *  - Benchmark: view work for 50 tokens at 1/10/100 ticks per token per
+ *    interval, per-tick callbacks vs one conflated batch per interval
+ *
+ * Build: Requires Qt5::Core, Qt5::Test
+ */
+
+#include <QtTest/QtTest>
+#include <QElapsedTimer>
+#include <QThread>
+#include <map>
+#include <memory>
+#include "services/ConflatedSubscription.h"
+
+namespace {
+
+int64_t keyOf(int segment, uint32_t token) {
+    return (static_cast<int64_t>(segment) << 32) | token;
+}
+
+UDP::MarketTick makeTick(int segment, uint32_t token, double ltp,
+                         UDP::UpdateType type = UDP::UpdateType::TOUCHLINE) {
+    UDP::MarketTick tick(static_cast<UDP::ExchangeSegment>(segment), token);
+    tick.ltp = ltp;
+    tick.updateType = type;
+    return tick;
+}
+
+// What a view does per row update (PositionWindow/ATMWatch: format the price)
+qint64 renderRow(const UDP::MarketTick& tick) {
+    return QString::number(tick.ltp, 'f', 2).size();
+}
+
+} // namespace
+
+class TestConflatedSubscription : public QObject {
+    Q_OBJECT
+
+private slots:
+    // ─── Batching ───
+    void testBatchHoldsLatestOfChangedKeys();
+    void testNoCallbackWithoutChanges();
+    void testTypeMask();
+
+    // ─── Key set ───
+    void testAddRemoveKeys();
+    void testSetKeysAndRegistrar();
+
+    // ─── Timer ───
+    void testTimerDeliversOnOwnerThread();
+
+    // ─── Benchmarks ───
+    void benchmarkViewWork_data();
+    void benchmarkViewWork();
+};
+
+// ─── Batching ────────────────────────────────────────────
+
+void TestConflatedSubscription::testBatchHoldsLatestOfChangedKeys()
+{
+    FeedDispatcher dispatcher;
+    std::vector<std::vector<UDP::MarketTick>> batches;
+    ConflatedSubscription sub(dispatcher, 10, [&batches](const std::vector<UDP::MarketTick>& b) {
+        batches.push_back(b);
+    });
+    sub.setKeys({keyOf(2, 1), keyOf(2, 2), keyOf(2, 3)});
+
+    dispatcher.publish(makeTick(2, 2, 10.0));
+    dispatcher.publish(makeTick(2, 1, 20.0));
+    dispatcher.publish(makeTick(2, 2, 11.0));
+    dispatcher.publish(makeTick(2, 2, 12.0));
+    dispatcher.publish(makeTick(2, 9, 99.0));   // Not watched
+    sub.flush();
+
+    QCOMPARE(batches.size(), size_t(1));
+    const auto& batch = batches.front();
+    QCOMPARE(batch.size(), size_t(2));          // Token 3 never ticked
+    QCOMPARE(batch[0].token, 2u);               // First-changed order
+    QCOMPARE(batch[0].ltp, 12.0);               // Latest value only
+    QCOMPARE(batch[1].token, 1u);
+    QCOMPARE(batch[1].ltp, 20.0);
+    QCOMPARE(sub.ticksReceived(), uint64_t(4));
+
+    // Next interval starts empty
+    dispatcher.publish(makeTick(2, 3, 30.0));
+    sub.flush();
+    QCOMPARE(batches.size(), size_t(2));
+    QCOMPARE(batches[1].size(), size_t(1));
+    QCOMPARE(batches[1][0].token, 3u);
+    QCOMPARE(sub.batchesDelivered(), uint64_t(2));
+}
+
+void TestConflatedSubscription::testNoCallbackWithoutChanges()
+{
+    FeedDispatcher dispatcher;
+    int calls = 0;
+    ConflatedSubscription sub(dispatcher, 10, [&calls](const std::vector<UDP::MarketTick>&) {
+        ++calls;
+    });
+    sub.addKey(keyOf(1, 2885));
+
+    sub.flush();
+    QCOMPARE(calls, 0);
+
+    dispatcher.publish(makeTick(1, 2885, 1500.0));
+    sub.flush();
+    sub.flush();
+    QCOMPARE(calls, 1);
+}
+
+void TestConflatedSubscription::testTypeMask()
+{
+    FeedDispatcher dispatcher;
+    std::vector<UDP::MarketTick> last;
+    ConflatedSubscription sub(
+        dispatcher, 10, [&last](const std::vector<UDP::MarketTick>& b) { last = b; },
+        FeedDispatcher::AllUpdates & ~FeedDispatcher::DepthUpdates);
+    sub.addKey(keyOf(2, 5));
+
+    dispatcher.publish(makeTick(2, 5, 100.0, UDP::UpdateType::TRADE_TICK));
+    dispatcher.publish(makeTick(2, 5, 0.0, UDP::UpdateType::DEPTH_UPDATE));   // Ignored
+    sub.flush();
+    QCOMPARE(last.size(), size_t(1));
+    QCOMPARE(last[0].ltp, 100.0);
+
+    last.clear();
+    dispatcher.publish(makeTick(2, 5, 0.0, UDP::UpdateType::DEPTH_UPDATE));
+    sub.flush();
+    QVERIFY(last.empty());
+}
+
+// ─── Key set ─────────────────────────────────────────────
+
+void TestConflatedSubscription::testAddRemoveKeys()
+{
+    FeedDispatcher dispatcher;
+    std::vector<UDP::MarketTick> last;
+    ConflatedSubscription sub(dispatcher, 10,
+                              [&last](const std::vector<UDP::MarketTick>& b) { last = b; });
+    sub.addKey(keyOf(2, 1));
+    sub.addKey(keyOf(2, 2));
+    sub.addKey(keyOf(2, 2));   // Duplicate is a no-op
+    QCOMPARE(sub.keyCount(), size_t(2));
+    QCOMPARE(dispatcher.subscriberCount(), size_t(2));
+
+    dispatcher.publish(makeTick(2, 1, 1.0));
+    dispatcher.publish(makeTick(2, 2, 2.0));
+    sub.removeKey(keyOf(2, 1));   // Pending value goes too
+    sub.flush();
+    QCOMPARE(last.size(), size_t(1));
+    QCOMPARE(last[0].token, 2u);
+
+    dispatcher.publish(makeTick(2, 1, 1.5));
+    last.clear();
+    sub.flush();
+    QVERIFY(last.empty());
+    QVERIFY(!sub.containsKey(keyOf(2, 1)));
+
+    sub.clearKeys();
+    QCOMPARE(dispatcher.subscriberCount(), size_t(0));
+}
+
+void TestConflatedSubscription::testSetKeysAndRegistrar()
+{
+    FeedDispatcher dispatcher;
+    std::vector<int64_t> registered;
+    ConflatedSubscription sub(
+        dispatcher, 10, [](const std::vector<UDP::MarketTick>&) {},
+        FeedDispatcher::AllUpdates,
+        [&registered](int64_t key) { registered.push_back(key); });
+
+    sub.setKeys({keyOf(1, 10), keyOf(2, 20)});
+    sub.setKeys({keyOf(2, 20), keyOf(12, 30)});
+    QCOMPARE(sub.keyCount(), size_t(2));
+    QVERIFY(!sub.containsKey(keyOf(1, 10)));
+    QVERIFY(sub.containsKey(keyOf(12, 30)));
+    QCOMPARE(registered, (std::vector<int64_t>{keyOf(1, 10), keyOf(2, 20), keyOf(12, 30)}));
+
+    // Deleting the subscription unsubscribes every key
+    {
+        ConflatedSubscription scoped(dispatcher, 10, [](const std::vector<UDP::MarketTick>&) {});
+        scoped.addKey(keyOf(2, 40));
+        QCOMPARE(dispatcher.subscriberCount(), size_t(3));
+    }
+    QCOMPARE(dispatcher.subscriberCount(), size_t(2));
+}
+
+// ─── Timer ───────────────────────────────────────────────
+
+void TestConflatedSubscription::testTimerDeliversOnOwnerThread()
+{
+    FeedDispatcher dispatcher;
+    int batches = 0;
+    QThread* batchThread = nullptr;
+    std::map<uint32_t, double> latest;
+    ConflatedSubscription sub(dispatcher, 20, [&](const std::vector<UDP::MarketTick>& b) {
+        ++batches;
+        batchThread = QThread::currentThread();
+        for (const UDP::MarketTick& tick : b) latest[tick.token] = tick.ltp;
+    });
+    QCOMPARE(sub.intervalMs(), 50);
+    sub.setKeys({keyOf(2, 1), keyOf(2, 2)});
+
+    // 2000 ticks from an IO thread
+    std::unique_ptr<QThread> io(QThread::create([&dispatcher]() {
+        for (int i = 0; i < 2000; ++i) dispatcher.publish(makeTick(2, 1 + i % 2, 100.0 + i));
+    }));
+    io->start();
+    QVERIFY(io->wait(5000));
+
+    QTRY_COMPARE_WITH_TIMEOUT(latest[2], 2099.0, 5000);
+    QCOMPARE(latest[1], 2098.0);
+    QCOMPARE(batchThread, QThread::currentThread());
+    QVERIFY(batches < 100);   // Bounded by intervals, not by ticks
+}
+
+// ─── Benchmarks ──────────────────────────────────────────
+
+void TestConflatedSubscription::benchmarkViewWork_data()
+{
+    QTest::addColumn<bool>("conflated");
+    QTest::addColumn<int>("ticksPerInterval");
+    for (int n : {1, 10, 100}) {
+        QTest::newRow(qPrintable(QString("per-tick %1/token").arg(n))) << false << n;
+        QTest::newRow(qPrintable(QString("conflated %1/token").arg(n))) << true << n;
+    }
+}
+
+void TestConflatedSubscription::benchmarkViewWork()
+{
+    QFETCH(bool, conflated);
+    QFETCH(int, ticksPerInterval);
+
+    // 50 watched tokens (a position book / ATM watch), 20 intervals; each
+    // token ticks ticksPerInterval times per interval. Measures publish plus
+    // view-side work; the per-tick path is a plain subscriber per token.
+    constexpr int kTokens = 50;
+    constexpr int kIntervals = 20;
+
+    FeedDispatcher dispatcher;
+    qint64 callbacks = 0, rows = 0, sink = 0;
+    std::vector<FeedDispatcher::Subscription> perTick;
+    std::unique_ptr<ConflatedSubscription> batched;
+
+    if (conflated) {
+        batched = std::make_unique<ConflatedSubscription>(
+            dispatcher, 4, [&](const std::vector<UDP::MarketTick>& changed) {
+                ++callbacks;
+                for (const UDP::MarketTick& tick : changed) {
+                    sink += renderRow(tick);
+                    ++rows;
+                }
+            });
+    }
+    for (uint32_t token = 1; token <= kTokens; ++token) {
+        if (conflated) {
+            batched->addKey(keyOf(2, token));
+        } else {
+            perTick.push_back(dispatcher.subscribe(keyOf(2, token), nullptr,
+                                                   [&](const UDP::MarketTick& tick) {
+                                                       ++callbacks;
+                                                       sink += renderRow(tick);
+                                                       ++rows;
+                                                   }));
+        }
+    }
+
+    std::vector<UDP::MarketTick> interval;
+    for (int i = 0; i < kTokens * ticksPerInterval; ++i)
+        interval.push_back(makeTick(2, 1 + (i * 7) % kTokens, 100.0 + i * 0.05));
+
+    QElapsedTimer timer;
+    qint64 elapsedNs = 0;
+    QBENCHMARK {
+        callbacks = rows = 0;
+        timer.start();
+        for (int n = 0; n < kIntervals; ++n) {
+            for (const UDP::MarketTick& tick : interval) dispatcher.publish(tick);
+            if (batched) batched->flush();
+        }
+        elapsedNs = timer.nsecsElapsed();
+    }
+
+    qDebug().nospace() << (conflated ? "conflated" : "per-tick") << " ticks/token/interval="
+                       << ticksPerInterval << " callbacks=" << callbacks << " rows=" << rows
+                       << " us/interval=" << double(elapsedNs) / kIntervals / 1000.0;
+
+    const qint64 ticks = qint64(kIntervals) * kTokens * ticksPerInterval;
+    QVERIFY(sink > 0);
+    if (conflated) {
+        QCOMPARE(callbacks, qint64(kIntervals));
+        QCOMPARE(rows, qint64(kIntervals) * kTokens);
+    } else {
+        QCOMPARE(callbacks, ticks);
+    }
+}
+
+QTEST_MAIN(TestConflatedSubscription)
+#include "test_conflated_subscription.moc"
@@ -0,0 +1,352 @@
+/**
+ * @file test_contract_catalog.cpp
+ * @brief Unit tests for ContractCatalog (integer-keyed option chains)
+ *
+ * Tests:
+ *  - Expiry ids: days since epoch, 4- and 2-digit years, case, bad input,
+ *    round trip through expiryText()
+ *  - Strike ticks
+ *  - Chains: sorted strikes with parallel CE / PE columns, one side missing,
+ *    duplicate strike (last wins), first future wins, future-only chain
+ *  - indexOfStrike() and atmIndex() against ATMCalculator
+ *  - Expiries per symbol, symbols per expiry (with listings)
+ *  - Benchmark: chain + strike lookup vs "SYMBOL|EXPIRY|STRIKE" hashing
+ *
+ * Build: Requires Qt5::Core, Qt5::Test
+ */
+
+#include <QtTest/QtTest>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include "quant/ATMCalculator.h"
+#include "repository/ContractCatalog.h"
+
+class TestContractCatalog : public QObject {
+    Q_OBJECT
+
+private slots:
+    // ─── Keys ───
+    void expiryIdIsDaysSinceEpoch();
+    void expiryIdAcceptsShortYearAndLowerCase();
+    void expiryIdRejectsBadInput();
+    void expiryTextRoundTrip();
+    void strikeTicks();
+
+    // ─── Chains ───
+    void chainColumnsAreParallel();
+    void duplicateStrikeLastWins();
+    void firstFutureWins();
+    void missingChain();
+
+    // ─── Strike search ───
+    void indexOfStrike();
+    void atmIndexMatchesATMCalculator();
+
+    // ─── Expiry / symbol lists ───
+    void expiriesAreAscending();
+    void symbolsForExpiry();
+
+    // ─── Benchmark ───
+    void benchmarkLookup();
+};
+
+// ═══════════════════════════════════════════════════════════
+// Keys
+// ═══════════════════════════════════════════════════════════
+
+void TestContractCatalog::expiryIdIsDaysSinceEpoch()
+{
+    QCOMPARE(ContractCatalog::expiryId(u"01JAN1970"), ContractCatalog::ExpiryId(ContractCatalog::kNoExpiry));
+    QCOMPARE(ContractCatalog::expiryId(u"02JAN1970"), 1);
+    QCOMPARE(ContractCatalog::expiryId(u"27FEB2026"),
+             ContractCatalog::ExpiryId(QDate(1970, 1, 1).daysTo(QDate(2026, 2, 27))));
+
+    // Ids order like dates, not like text
+    QVERIFY(ContractCatalog::expiryId(u"30JAN2026") < ContractCatalog::expiryId(u"05FEB2026"));
+    QVERIFY(ContractCatalog::expiryId(u"31DEC2025") < ContractCatalog::expiryId(u"01JAN2026"));
+}
+
+void TestContractCatalog::expiryIdAcceptsShortYearAndLowerCase()
+{
+    const auto id = ContractCatalog::expiryId(u"30JAN2026");
+    QCOMPARE(ContractCatalog::expiryId(u"30JAN26"), id);
+    QCOMPARE(ContractCatalog::expiryId(u"30jan2026"), id);
+    QCOMPARE(ContractCatalog::expiryId(u"5FEB2026"), ContractCatalog::expiryId(u"05FEB2026"));
+}
+
+void TestContractCatalog::expiryIdRejectsBadInput()
+{
+    const auto none = ContractCatalog::ExpiryId(ContractCatalog::kNoExpiry);
+    QCOMPARE(ContractCatalog::expiryId(u""), none);
+    QCOMPARE(ContractCatalog::expiryId(u"JAN2026"), none);
+    QCOMPARE(ContractCatalog::expiryId(u"30XYZ2026"), none);
+    QCOMPARE(ContractCatalog::expiryId(u"30FEB2026"), none);
+    QCOMPARE(ContractCatalog::expiryId(u"30JAN202"), none);
+    QCOMPARE(ContractCatalog::expiryId(u"3AJAN2026"), none);
+}
+
+void TestContractCatalog::expiryTextRoundTrip()
+{
+    QCOMPARE(ContractCatalog::expiryText(ContractCatalog::expiryId(u"27FEB2026")), QString("27FEB2026"));
+    QCOMPARE(ContractCatalog::expiryText(ContractCatalog::expiryId(u"5mar26")), QString("05MAR2026"));
+    QVERIFY(ContractCatalog::expiryText(ContractCatalog::kNoExpiry).isEmpty());
+}
+
+void TestContractCatalog::strikeTicks()
+{
+    QCOMPARE(ContractCatalog::strikeTicks(24550.0), int64_t(2455000));
+    QCOMPARE(ContractCatalog::strikeTicks(102.5), int64_t(10250));
+    // Binary noise in the double does not split a strike
+    QCOMPARE(ContractCatalog::strikeTicks(0.1 + 0.2), ContractCatalog::strikeTicks(0.3));
+}
+
+// ═══════════════════════════════════════════════════════════
+// Chains
+// ═══════════════════════════════════════════════════════════
+
+void TestContractCatalog::chainColumnsAreParallel()
+{
+    ContractCatalog catalog;
+    // Added out of order, one strike without a PE
+    catalog.addOption("NIFTY", "30JAN2026", 24600, true, 106);
+    catalog.addOption("NIFTY", "30JAN2026", 24500, false, 102);
+    catalog.addOption("NIFTY", "30JAN2026", 24500, true, 101);
+    catalog.addOption("NIFTY", "30JAN2026", 24550, true, 103);
+    catalog.addOption("NIFTY", "30JAN2026", 24550, false, 104);
+    catalog.addOption("NIFTY", "30JAN2026", 24600, false, 107);
+    catalog.addOption("NIFTY", "30JAN2026", 24650, true, 109);
+    catalog.addFuture("NIFTY", "30JAN2026", 50);
+    catalog.finalize();
+
+    const ContractCatalog::Chain *chain = catalog.chain("NIFTY", "30JAN2026");
+    QVERIFY(chain);
+    QCOMPARE(chain->symbol, catalog.symbolId("NIFTY"));
+    QCOMPARE(chain->expiry, ContractCatalog::expiryId(u"30JAN2026"));
+    QCOMPARE(chain->futureToken, int64_t(50));
+    QCOMPARE(chain->strikes, QVector<double>({24500, 24550, 24600, 24650}));
+    QCOMPARE(chain->strikeTicks, QVector<int64_t>({2450000, 2455000, 2460000, 2465000}));
+    QCOMPARE(chain->callTokens, QVector<int64_t>({101, 103, 106, 109}));
+    QCOMPARE(chain->putTokens, QVector<int64_t>({102, 104, 107, 0}));
+
+    // Same chain through the ids and through a 2-digit year
+    QCOMPARE(catalog.chain(catalog.symbolId("NIFTY"), ContractCatalog::expiryId(u"30JAN2026")), chain);
+    QCOMPARE(catalog.chain("NIFTY", "30JAN26"), chain);
+}
+
+void TestContractCatalog::duplicateStrikeLastWins()
+{
+    ContractCatalog catalog;
+    catalog.addOption("BANKNIFTY", "27JAN2026", 51000, true, 1);
+    catalog.addOption("BANKNIFTY", "27JAN2026", 51000, true, 2);
+    catalog.addOption("BANKNIFTY", "27JAN2026", 51000, false, 3);
+    catalog.finalize();
+
+    const auto *chain = catalog.chain("BANKNIFTY", "27JAN2026");
+    QVERIFY(chain);
+    QCOMPARE(chain->strikes.size(), 1);
+    QCOMPARE(chain->callTokens[0], int64_t(2));
+    QCOMPARE(chain->putTokens[0], int64_t(3));
+}
+
+void TestContractCatalog::firstFutureWins()
+{
+    ContractCatalog catalog;
+    catalog.addFuture("RELIANCE", "29JAN2026", 7);
+    catalog.addFuture("RELIANCE", "29JAN2026", 8);
+    catalog.addFuture("RELIANCE", "26FEB2026", 9);
+    catalog.finalize();
+
+    // Future-only chains exist, with no strikes
+    const auto *jan = catalog.chain("RELIANCE", "29JAN2026");
+    QVERIFY(jan);
+    QCOMPARE(jan->futureToken, int64_t(7));
+    QVERIFY(jan->strikes.isEmpty());
+    QCOMPARE(catalog.chain("RELIANCE", "26FEB2026")->futureToken, int64_t(9));
+}
+
+void TestContractCatalog::missingChain()
+{
+    ContractCatalog catalog;
+    catalog.addOption("NIFTY", "30JAN2026", 24500, true, 1);
+    catalog.addOption("", "30JAN2026", 24500, true, 2);
+    catalog.addOption("NIFTY", "", 24500, true, 3);
+    catalog.finalize();
+
+    QCOMPARE(catalog.chains().size(), 1);
+    QVERIFY(!catalog.chain("NIFTY", "06FEB2026"));
+    QVERIFY(!catalog.chain("FINNIFTY", "30JAN2026"));
+    QVERIFY(!catalog.chain("NIFTY", "garbage"));
+    QCOMPARE(catalog.symbolId("FINNIFTY"), ContractCatalog::SymbolId(ContractCatalog::kNoSymbol));
+    QVERIFY(catalog.symbolName(ContractCatalog::kNoSymbol).isEmpty());
+    QCOMPARE(catalog.symbolName(catalog.symbolId("NIFTY")), QString("NIFTY"));
+
+    // Empty catalog
+    ContractCatalog empty;
+    empty.finalize();
+    QVERIFY(!empty.chain("NIFTY", "30JAN2026"));
+    QVERIFY(empty.symbolsForExpiry(ContractCatalog::expiryId(u"30JAN2026")).isEmpty());
+}
+
+// ═══════════════════════════════════════════════════════════
+// Strike search
+// ═══════════════════════════════════════════════════════════
+
+void TestContractCatalog::indexOfStrike()
+{
+    ContractCatalog catalog;
+    for (int i = 0; i < 5; ++i)
+        catalog.addOption("SBIN", "29JAN2026", 800 + 2.5 * i, true, 10 + i);
+    catalog.finalize();
+
+    const auto *chain = catalog.chain("SBIN", "29JAN2026");
+    QVERIFY(chain);
+    QCOMPARE(chain->indexOfStrike(800.0), 0);
+    QCOMPARE(chain->indexOfStrike(805.0), 2);
+    QCOMPARE(chain->indexOfStrike(810.0), 4);
+    QCOMPARE(chain->indexOfStrike(802.5000000001), 1);
+    QCOMPARE(chain->indexOfStrike(801.0), -1);
+    QCOMPARE(chain->indexOfStrike(790.0), -1);
+    QCOMPARE(chain->indexOfStrike(900.0), -1);
+}
+
+void TestContractCatalog::atmIndexMatchesATMCalculator()
+{
+    ContractCatalog catalog;
+    for (int i = 0; i < 40; ++i)
+        catalog.addOption("NIFTY", "30JAN2026", 24000 + 50 * i, true, i + 1);
+    catalog.finalize();
+
+    const auto *chain = catalog.chain("NIFTY", "30JAN2026");
+    QVERIFY(chain);
+
+    // Exact ties go to the lower strike, as in ATMCalculator
+    QCOMPARE(chain->strikes[chain->atmIndex(24525.0)], 24500.0);
+    QCOMPARE(chain->strikes[chain->atmIndex(24525.01)], 24550.0);
+    QCOMPARE(chain->atmIndex(1.0), 0);
+    QCOMPARE(chain->atmIndex(99999.0), chain->strikes.size() - 1);
+
+    QRandomGenerator rng(24);
+    for (int i = 0; i < 2000; ++i) {
+        const double price = 23900 + rng.bounded(2200.0);
+        const auto expected = ATMCalculator::calculateFromActualStrikes(price, chain->strikes, 0);
+        QVERIFY(expected.isValid);
+        QCOMPARE(chain->strikes[chain->atmIndex(price)], expected.atmStrike);
+    }
+
+    ContractCatalog::Chain empty;
+    QCOMPARE(empty.atmIndex(24500.0), -1);
+}
+
+// ═══════════════════════════════════════════════════════════
+// Expiry / symbol lists
+// ═══════════════════════════════════════════════════════════
+
+void TestContractCatalog::expiriesAreAscending()
+{
+    ContractCatalog catalog;
+    catalog.addOption("NIFTY", "26MAR2026", 24500, true, 1);
+    catalog.addOption("NIFTY", "05FEB2026", 24500, true, 2);
+    catalog.addFuture("NIFTY", "26FEB2026", 3);
+    catalog.addOption("NIFTY", "30JAN2026", 24500, true, 4);
+    catalog.addOption("BANKNIFTY", "27JAN2026", 51000, true, 5);
+    catalog.finalize();
+
+    QVector<QString> texts;
+    for (ContractCatalog::ExpiryId expiry : catalog.expiries(catalog.symbolId("NIFTY")))
+        texts.append(ContractCatalog::expiryText(expiry));
+    QCOMPARE(texts, QVector<QString>({"30JAN2026", "05FEB2026", "26FEB2026", "26MAR2026"}));
+    QVERIFY(catalog.expiries(ContractCatalog::kNoSymbol).isEmpty());
+}
+
+void TestContractCatalog::symbolsForExpiry()
+{
+    ContractCatalog catalog;
+    catalog.addOption("TCS", "29JAN2026", 4000, true, 1);
+    catalog.addOption("NIFTY", "29JAN2026", 24500, false, 2);
+    catalog.addOption("NIFTY", "29JAN2026", 24550, false, 3);
+    catalog.addFuture("INFY", "29JAN2026", 4);      // Future only: not listed
+    catalog.addListing("SENSEX", "29JAN2026");      // Listing without a chain
+    catalog.addListing("TCS", "29JAN2026");         // Already listed by its chain
+    catalog.addOption("TCS", "26FEB2026", 4000, true, 5);
+    catalog.finalize();
+
+    QCOMPARE(catalog.symbolsForExpiry(ContractCatalog::expiryId(u"29JAN2026")),
+             QVector<QString>({"NIFTY", "SENSEX", "TCS"}));
+    QCOMPARE(catalog.symbolsForExpiry(ContractCatalog::expiryId(u"26FEB2026")),
+             QVector<QString>({"TCS"}));
+    QVERIFY(catalog.symbolsForExpiry(ContractCatalog::expiryId(u"26MAR2026")).isEmpty());
+    QVERIFY(!catalog.chain("SENSEX", "29JAN2026"));
+}
+
+// ═══════════════════════════════════════════════════════════
+// Benchmark
+// ═══════════════════════════════════════════════════════════
+
+void TestContractCatalog::benchmarkLookup()
+{
+    // ~200 symbols x 4 expiries x 60 strikes, like the NSE F&O master
+    const QStringList expiries = {"29JAN2026", "26FEB2026", "26MAR2026", "30APR2026"};
+    ContractCatalog catalog;
+    QHash<QString, QPair<int64_t, int64_t>> strikeToTokens;
+    QStringList symbols;
+    int64_t token = 1;
+    for (int s = 0; s < 200; ++s) {
+        const QString symbol = QString("SYM%1").arg(s);
+        symbols.append(symbol);
+        for (const QString &expiry : expiries) {
+            for (int k = 0; k < 60; ++k) {
+                const double strike = 1000 + 10 * k;
+                catalog.addOption(symbol, expiry, strike, true, token);
+                catalog.addOption(symbol, expiry, strike, false, token + 1);
+                strikeToTokens[symbol + "|" + expiry + "|" + QString::number(strike, 'f', 2)] =
+                    qMakePair(token, token + 1);
+                token += 2;
+            }
+        }
+    }
+    catalog.finalize();
+
+    // Queries as ATM Watch issues them: symbol + expiry text, then a strike
+    struct Query {
+        QString symbol;
+        QString expiry;
+        double strike;
+    };
+    QVector<Query> queries;
+    QRandomGenerator rng(7);
+    for (int i = 0; i < 100000; ++i)
+        queries.append({symbols[rng.bounded(symbols.size())], expiries[rng.bounded(expiries.size())],
+                        1000.0 + 10 * rng.bounded(60)});
+
+    int64_t catalogSum = 0;
+    int64_t hashSum = 0;
+    qint64 catalogNs = 0;
+    qint64 hashNs = 0;
+    QBENCHMARK_ONCE {
+        QElapsedTimer timer;
+        timer.start();
+        for (const Query &q : queries) {
+            const auto *chain = catalog.chain(q.symbol, q.expiry);
+            const int idx = chain ? chain->indexOfStrike(q.strike) : -1;
+            if (idx >= 0)
+                catalogSum += chain->callTokens[idx] + chain->putTokens[idx];
+        }
+        catalogNs = timer.nsecsElapsed();
+
+        timer.restart();
+        for (const Query &q : queries) {
+            const auto tokens =
+                strikeToTokens.value(q.symbol + "|" + q.expiry + "|" + QString::number(q.strike, 'f', 2));
+            hashSum += tokens.first + tokens.second;
+        }
+        hashNs = timer.nsecsElapsed();
+    }
+
+    QCOMPARE(catalogSum, hashSum);
+    qDebug().nospace() << "Catalog chain+strike lookup: " << catalogNs / queries.size()
+                       << " ns/op, string-key hash: " << hashNs / queries.size() << " ns/op ("
+                       << catalog.chains().size() << " chains)";
+}
+
+QTEST_MAIN(TestContractCatalog)
+#include "test_contract_catalog.moc"
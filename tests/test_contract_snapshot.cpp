@@ -0,0 +1,450 @@
+/**
+ * @file test_contract_snapshot.cpp
+ * @brief Unit tests for the binary contract master snapshot
+ *
+ * Tests:
+ *  - Write / map round trip of every stored field, per segment
+ *  - find() by binary search, unknown token and segment
+ *  - Identical strings stored once and shared after loading
+ *  - Pre-sorted order: expiry date → symbol → strike → option type
+ *  - forEachContract(): CE/PE mapped back to master codes, expiry date set
+ *  - Master row hashes survive the round trip (0 when not given)
+ *  - Files with another version, truncated, or with out-of-range order /
+ *    string offset tables are rejected
+ *  - NSEFORepositoryPreSorted populated from the snapshot keeps its index order
+ *  - Benchmark: ~130K contract startup, snapshot vs processed CSV
+ *
+ * Build: Requires Qt5::Core, Qt5::Test
+ */
+
+#include <QtTest/QtTest>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <cstddef>
+#include "repository/ContractSnapshot.h"
+#include "repository/NSEFORepositoryPreSorted.h"
+
+namespace {
+
+ContractData makeOption(int64_t token, const QString &symbol,
+                        const QString &expiry, double strike,
+                        const QString &optionType) {
+    ContractData c;
+    c.exchangeInstrumentID = token;
+    c.name = symbol;
+    c.displayName = QString("%1 %2 %3 %4").arg(symbol, expiry).arg(strike).arg(optionType);
+    c.description = symbol + expiry + optionType;
+    c.series = "OPTIDX";
+    c.lotSize = 75;
+    c.freezeQty = 1800;
+    c.tickSize = 0.05;
+    c.priceBandHigh = 1000.0;
+    c.priceBandLow = 0.05;
+    c.expiryDate = expiry;
+    c.strikePrice = strike;
+    c.optionType = optionType;
+    c.assetToken = 26000;
+    c.instrumentType = 2;
+    return c;
+}
+
+// ~130K NSE F&O style contracts: symbols × expiries × strikes × CE/PE
+QVector<ContractData> syntheticMaster(int count) {
+    static const char *kExpiries[] = {"30JAN2099", "27FEB2099", "27MAR2099",
+                                      "24APR2099", "29MAY2099"};
+    QVector<ContractData> contracts;
+    contracts.reserve(count);
+    int64_t token = 35000;
+    for (int symbol = 0; contracts.size() < count; ++symbol) {
+        const QString name = QString("SYM%1").arg(symbol, 3, 10, QChar('0'));
+        for (const char *expiry : kExpiries) {
+            for (int strike = 0; strike < 64 && contracts.size() < count; ++strike) {
+                contracts.append(makeOption(token++, name, expiry, 1000 + strike * 10, "CE"));
+                if (contracts.size() < count)
+                    contracts.append(makeOption(token++, name, expiry, 1000 + strike * 10, "PE"));
+            }
+        }
+    }
+    return contracts;
+}
+
+bool writeSnapshot(const QString &path, int segment, const QVector<ContractData> &contracts) {
+    ContractSnapshotWriter writer;
+    for (const ContractData &c : contracts)
+        writer.add(segment, c);
+    return writer.write(path);
+}
+
+void loadFromSnapshot(const ContractSnapshot &snapshot, NSEFORepositoryPreSorted &repo) {
+    repo.prepareForLoad();
+    snapshot.forEachContract(2, [&repo](const MasterContract &c) {
+        repo.addContract(c, nullptr);
+    });
+    repo.setContractOrder(snapshot.orderedTokens(2));
+    repo.finalizeLoad();
+}
+
+} // namespace
+
+class TestContractSnapshot : public QObject {
+    Q_OBJECT
+
+private slots:
+    // ─── Format ───
+    void testRoundTrip();
+    void testFind();
+    void testSharedStrings();
+    void testOrder();
+    void testForEachContract();
+    void testRowHashRoundTrip();
+
+    // ─── Validation ───
+    void testRejectsVersionMismatch();
+    void testRejectsTruncated();
+    void testRejectsCorruptTables();
+
+    // ─── Repository ───
+    void testPreSortedRepository();
+
+    // ─── Benchmark ───
+    void benchmarkStartup();
+
+private:
+    QTemporaryDir m_dir;
+};
+
+// ─── Format ──────────────────────────────────────────────
+
+void TestContractSnapshot::testRoundTrip()
+{
+    ContractData equity;
+    equity.exchangeInstrumentID = 2885;
+    equity.name = "RELIANCE";
+    equity.displayName = "RELIANCE";
+    equity.series = "EQ";
+    equity.lotSize = 1;
+    equity.tickSize = 0.05;
+    equity.priceBandHigh = 3100.5;
+    equity.priceBandLow = 2536.9;
+    equity.optionType = "EQ";
+    equity.instrumentType = 8;
+
+    const ContractData option = makeOption(40001, "NIFTY", "30JAN2099", 23500, "PE");
+
+    ContractSnapshotWriter writer;
+    writer.add(1, equity);
+    writer.add(2, option);
+    QCOMPARE(writer.count(), 2);
+
+    const QString path = m_dir.filePath("roundtrip.bin");
+    QVERIFY(writer.write(path));
+
+    ContractSnapshot snapshot;
+    QString error;
+    QVERIFY2(snapshot.open(path, &error), qPrintable(error));
+    QCOMPARE(snapshot.recordCount(), 2u);
+
+    const ContractSnapshot::Record *record = snapshot.find(1, 2885);
+    QVERIFY(record);
+    ContractData loaded = snapshot.toContractData(*record);
+    QCOMPARE(loaded.name, equity.name);
+    QCOMPARE(loaded.series, equity.series);
+    QCOMPARE(loaded.priceBandHigh, equity.priceBandHigh);
+    QCOMPARE(loaded.instrumentType, equity.instrumentType);
+    QVERIFY(loaded.description.isEmpty());
+    QVERIFY(!loaded.expiryDate_dt.isValid());
+
+    record = snapshot.find(2, 40001);
+    QVERIFY(record);
+    loaded = snapshot.toContractData(*record);
+    QCOMPARE(loaded.displayName, option.displayName);
+    QCOMPARE(loaded.expiryDate, option.expiryDate);
+    QCOMPARE(loaded.expiryDate_dt, QDate(2099, 1, 30));
+    QCOMPARE(loaded.strikePrice, option.strikePrice);
+    QCOMPARE(loaded.optionType, option.optionType);
+    QCOMPARE(loaded.assetToken, option.assetToken);
+    QCOMPARE(loaded.lotSize, option.lotSize);
+    QCOMPARE(loaded.freezeQty, option.freezeQty);
+}
+
+void TestContractSnapshot::testFind()
+{
+    QVector<ContractData> contracts;
+    for (int64_t token : {50005, 35001, 42000, 35000})
+        contracts.append(makeOption(token, "BANKNIFTY", "27FEB2099", 50000, "CE"));
+
+    const QString path = m_dir.filePath("find.bin");
+    QVERIFY(writeSnapshot(path, 2, contracts));
+
+    ContractSnapshot snapshot;
+    QVERIFY(snapshot.open(path));
+
+    uint32_t count = 0;
+    const ContractSnapshot::Record *records = snapshot.segmentRecords(2, &count);
+    QCOMPARE(count, 4u);
+    for (uint32_t i = 1; i < count; ++i)
+        QVERIFY(records[i - 1].token < records[i].token);
+
+    for (int64_t token : {50005, 35001, 42000, 35000}) {
+        const ContractSnapshot::Record *record = snapshot.find(2, token);
+        QVERIFY(record);
+        QCOMPARE(record->token, token);
+    }
+    QVERIFY(!snapshot.find(2, 35002));
+    QVERIFY(!snapshot.find(1, 35000));
+    QVERIFY(!snapshot.find(7, 35000));
+}
+
+void TestContractSnapshot::testSharedStrings()
+{
+    QVector<ContractData> contracts = {
+        makeOption(35000, "NIFTY", "30JAN2099", 23000, "CE"),
+        makeOption(35001, "NIFTY", "30JAN2099", 23000, "PE"),
+    };
+    const QString path = m_dir.filePath("strings.bin");
+    QVERIFY(writeSnapshot(path, 2, contracts));
+
+    ContractSnapshot snapshot;
+    QVERIFY(snapshot.open(path));
+
+    const ContractSnapshot::Record *a = snapshot.find(2, 35000);
+    const ContractSnapshot::Record *b = snapshot.find(2, 35001);
+    QCOMPARE(a->name, b->name);
+    QCOMPARE(a->expiryDate, b->expiryDate);
+    QVERIFY(a->optionType != b->optionType);
+
+    // NIFTY, OPTIDX, 30JAN2099, CE, PE + two display names, two descriptions
+    QCOMPARE(snapshot.stringCount(), 9u);
+
+    const ContractData ca = snapshot.toContractData(*a);
+    const ContractData cb = snapshot.toContractData(*b);
+    QCOMPARE(ca.name.constData(), cb.name.constData());
+    QCOMPARE(ca.series.constData(), cb.series.constData());
+}
+
+void TestContractSnapshot::testOrder()
+{
+    QVector<ContractData> contracts = {
+        makeOption(35000, "NIFTY", "27FEB2099", 23000, "CE"),
+        makeOption(35001, "BANKNIFTY", "30JAN2099", 50000, "PE"),
+        makeOption(35002, "NIFTY", "30JAN2099", 23100, "CE"),
+        makeOption(35003, "NIFTY", "30JAN2099", 23000, "PE"),
+        makeOption(35004, "NIFTY", "30JAN2099", 23000, "CE"),
+        makeOption(35005, "BANKNIFTY", "30JAN2099", 50000, "CE"),
+    };
+    // String order would put FEB before JAN; the order must follow the date
+    const QString path = m_dir.filePath("order.bin");
+    QVERIFY(writeSnapshot(path, 2, contracts));
+
+    ContractSnapshot snapshot;
+    QVERIFY(snapshot.open(path));
+    const QVector<int64_t> expected = {35005, 35001, 35004, 35003, 35002, 35000};
+    QCOMPARE(snapshot.orderedTokens(2), expected);
+    QVERIFY(snapshot.orderedTokens(1).isEmpty());
+}
+
+void TestContractSnapshot::testForEachContract()
+{
+    QVector<ContractData> contracts = {
+        makeOption(35000, "NIFTY", "30JAN2099", 23000, "CE"),
+        makeOption(35001, "NIFTY", "30JAN2099", 23000, "PE"),
+        makeOption(35002, "NIFTY", "30JAN2099", 0, "XX"),
+    };
+    contracts[2].instrumentType = 1;
+    contracts[2].series = "FUTIDX";
+
+    const QString path = m_dir.filePath("visit.bin");
+    QVERIFY(writeSnapshot(path, 2, contracts));
+
+    ContractSnapshot snapshot;
+    QVERIFY(snapshot.open(path));
+
+    QVector<MasterContract> seen;
+    snapshot.forEachContract(2, [&seen](const MasterContract &c) { seen.append(c); });
+    QCOMPARE(seen.size(), 3);
+    QCOMPARE(seen[0].exchange, QString("NSEFO"));
+    QCOMPARE(seen[0].optionType, 1);
+    QCOMPARE(seen[1].optionType, 2);
+    QCOMPARE(seen[2].optionType, 0);
+    QCOMPARE(seen[0].expiryDate_dt, QDate(2099, 1, 30));
+    QVERIFY(seen[0].timeToExpiry > 70.0);
+
+    // Round trip through the repository's own option type decoding
+    NSEFORepository repo;
+    repo.prepareForLoad();
+    for (const MasterContract &c : seen)
+        repo.addContract(c, nullptr);
+    repo.finalizeLoad();
+    QCOMPARE(repo.getContract(35000)->optionType, QString("CE"));
+    QCOMPARE(repo.getContract(35001)->optionType, QString("PE"));
+    QCOMPARE(repo.getContract(35002)->instrumentType, 1);
+}
+
+void TestContractSnapshot::testRowHashRoundTrip()
+{
+    ContractSnapshotWriter writer;
+    writer.add(2, makeOption(35000, "NIFTY", "30JAN2099", 23000, "CE"), 0x1234abcdULL);
+    writer.add(2, makeOption(35001, "NIFTY", "30JAN2099", 23000, "PE"));
+
+    const QString path = m_dir.filePath("hashes.bin");
+    QVERIFY(writer.write(path));
+
+    ContractSnapshot snapshot;
+    QVERIFY(snapshot.open(path));
+    QCOMPARE(snapshot.find(2, 35000)->rowHash, uint64_t(0x1234abcdULL));
+    QCOMPARE(snapshot.find(2, 35001)->rowHash, uint64_t(0));
+
+    QVector<uint64_t> hashes;
+    snapshot.forEachContract(2, [&hashes](const MasterContract &c) { hashes.append(c.rowHash); });
+    QCOMPARE(hashes, (QVector<uint64_t>{0x1234abcdULL, 0}));
+}
+
+// ─── Validation ──────────────────────────────────────────
+
+void TestContractSnapshot::testRejectsVersionMismatch()
+{
+    const QString path = m_dir.filePath("version.bin");
+    QVERIFY(writeSnapshot(path, 2, {makeOption(35000, "NIFTY", "30JAN2099", 23000, "CE")}));
+
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    const uint32_t future = ContractSnapshot::kVersion + 1;
+    file.seek(offsetof(ContractSnapshot::Header, version));
+    file.write(reinterpret_cast<const char *>(&future), sizeof(future));
+    file.close();
+
+    ContractSnapshot snapshot;
+    QString error;
+    QVERIFY(!snapshot.open(path, &error));
+    QVERIFY(error.contains("version"));
+    QVERIFY(!snapshot.isOpen());
+    QVERIFY(!snapshot.find(2, 35000));
+
+    QVERIFY(!snapshot.open(m_dir.filePath("missing.bin")));
+}
+
+void TestContractSnapshot::testRejectsTruncated()
+{
+    const QString path = m_dir.filePath("truncated.bin");
+    QVERIFY(writeSnapshot(path, 2, syntheticMaster(100)));
+
+    QFile file(path);
+    QVERIFY(file.resize(file.size() - 16));
+
+    ContractSnapshot snapshot;
+    QVERIFY(!snapshot.open(path));
+
+    QVERIFY(file.resize(sizeof(ContractSnapshot::Header) / 2));
+    QVERIFY(!snapshot.open(path));
+}
+
+void TestContractSnapshot::testRejectsCorruptTables()
+{
+    const QString path = m_dir.filePath("corrupt.bin");
+    auto patch = [&path](qint64 offset, uint32_t value) {
+        QFile file(path);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        file.seek(offset);
+        file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    };
+    auto headerField = [&path](size_t offset) {
+        QFile file(path);
+        file.open(QIODevice::ReadOnly);
+        file.seek(qint64(offset));
+        uint64_t value = 0;
+        file.read(reinterpret_cast<char *>(&value), sizeof(value));
+        return qint64(value);
+    };
+
+    // Order entry past the record table
+    QVERIFY(writeSnapshot(path, 2, syntheticMaster(10)));
+    patch(headerField(offsetof(ContractSnapshot::Header, orderOffset)), 10);
+    ContractSnapshot snapshot;
+    QString error;
+    QVERIFY(!snapshot.open(path, &error));
+    QVERIFY(error.contains("order"));
+
+    // String offsets out of order (the last one still in range)
+    QVERIFY(writeSnapshot(path, 2, syntheticMaster(10)));
+    patch(headerField(offsetof(ContractSnapshot::Header, stringOffsetsOffset)) +
+              qint64(sizeof(uint32_t)),
+          0xffffff00u);
+    QVERIFY(!snapshot.open(path, &error));
+    QVERIFY(error.contains("string"));
+    QVERIFY(!snapshot.isOpen());
+}
+
+// ─── Repository ──────────────────────────────────────────
+
+void TestContractSnapshot::testPreSortedRepository()
+{
+    const QVector<ContractData> contracts = syntheticMaster(2000);
+    const QString path = m_dir.filePath("repo.bin");
+    QVERIFY(writeSnapshot(path, 2, contracts));
+
+    ContractSnapshot snapshot;
+    QVERIFY(snapshot.open(path));
+
+    NSEFORepositoryPreSorted repo;
+    loadFromSnapshot(snapshot, repo);
+    QCOMPARE(repo.getTotalCount(), contracts.size());
+
+    // Per symbol: expiry date, then strike, CE before PE
+    const QVector<ContractData> bySymbol = repo.getContractsBySymbol("SYM001");
+    QVERIFY(!bySymbol.isEmpty());
+    for (int i = 1; i < bySymbol.size(); ++i) {
+        const ContractData &a = bySymbol[i - 1];
+        const ContractData &b = bySymbol[i];
+        const int32_t da = ContractSnapshot::expiryToJulianDay(a.expiryDate);
+        const int32_t db = ContractSnapshot::expiryToJulianDay(b.expiryDate);
+        QVERIFY(da < db || (da == db && (a.strikePrice < b.strikePrice ||
+                                         (a.strikePrice == b.strikePrice &&
+                                          a.optionType < b.optionType))));
+    }
+}
+
+// ─── Benchmark ───────────────────────────────────────────
+
+void TestContractSnapshot::benchmarkStartup()
+{
+    const int kContracts = 130000;
+    const QVector<ContractData> contracts = syntheticMaster(kContracts);
+    const QString binPath = m_dir.filePath("bench.bin");
+    const QString csvPath = m_dir.filePath("bench.csv");
+
+    QVERIFY(writeSnapshot(binPath, 2, contracts));
+    {
+        ContractSnapshot snapshot;
+        QVERIFY(snapshot.open(binPath));
+        NSEFORepositoryPreSorted repo;
+        loadFromSnapshot(snapshot, repo);
+        QVERIFY(repo.saveProcessedCSV(csvPath));
+    }
+
+    qint64 snapshotMs = 0;
+    QBENCHMARK_ONCE {
+        QElapsedTimer timer;
+        timer.start();
+        ContractSnapshot snapshot;
+        QVERIFY(snapshot.open(binPath));
+        NSEFORepositoryPreSorted repo;
+        loadFromSnapshot(snapshot, repo);
+        snapshotMs = timer.elapsed();
+        QCOMPARE(repo.getTotalCount(), kContracts);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    NSEFORepositoryPreSorted csvRepo;
+    QVERIFY(csvRepo.loadProcessedCSV(csvPath));
+    const qint64 csvMs = timer.elapsed();
+    QCOMPARE(csvRepo.getTotalCount(), kContracts);
+
+    qDebug().nospace() << "Startup, " << kContracts << " contracts: snapshot "
+                       << snapshotMs << " ms (" << QFileInfo(binPath).size() / 1024
+                       << " KB), processed CSV " << csvMs << " ms ("
+                       << QFileInfo(csvPath).size() / 1024 << " KB)";
+}
+
+QTEST_MAIN(TestContractSnapshot)
+#include "test_contract_snapshot.moc"
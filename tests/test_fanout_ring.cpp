@@ -0,0 +1,195 @@
+/**
+ * @file test_fanout_ring.cpp
+ * @brief Unit tests for sharded NSE FO parsing building blocks
+ *
+ * Tests:
+ *  - Every consumer sees every record, in publish order, with its timestamp
+ *  - Records wrap around the buffer end intact
+ *  - The slowest consumer holds back the producer; catching up frees space
+ *  - One producer + three consumer threads: each gets the full stream in order
+ *  - Token shards partition tokens: exactly one owner per token, balanced
+ *
+ * Build: Requires Qt5::Core, Qt5::Test
+ */
+
+#include <QtTest/QtTest>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "udp_fanout_ring.h"
+#include "parse_shard.h"
+
+using udp_ingest::FanoutRing;
+
+class TestFanoutRing : public QObject {
+    Q_OBJECT
+
+private slots:
+    // ─── Single thread ───
+    void testBroadcastOrder();
+    void testWrapAround();
+    void testSlowestConsumerBackpressure();
+
+    // ─── Producer / consumers ───
+    void testConcurrentConsumers();
+
+    // ─── Token shards ───
+    void testShardPartition();
+};
+
+namespace {
+
+std::vector<uint32_t> drainValues(FanoutRing& ring, size_t consumer)
+{
+    std::vector<uint32_t> out;
+    ring.consume(consumer, [&](const uint8_t* data, uint32_t length, int64_t) {
+        uint32_t v = 0;
+        if (length >= sizeof(v)) std::memcpy(&v, data, sizeof(v));
+        out.push_back(v);
+    }, SIZE_MAX);
+    return out;
+}
+
+} // namespace
+
+// ─── Single thread ───────────────────────────────────────
+
+void TestFanoutRing::testBroadcastOrder()
+{
+    FanoutRing ring(0, 2);
+    for (uint32_t i = 0; i < 10; ++i) {
+        QVERIFY(ring.tryPublish(&i, sizeof(i), 1000 + i));
+    }
+
+    std::vector<int64_t> stamps;
+    ring.consume(0, [&](const uint8_t*, uint32_t, int64_t ts) { stamps.push_back(ts); }, 3);
+    QCOMPARE(stamps, (std::vector<int64_t>{1000, 1001, 1002}));
+
+    // Consumer 1 is independent of consumer 0
+    const auto all = drainValues(ring, 1);
+    QCOMPARE(all.size(), size_t(10));
+    for (uint32_t i = 0; i < 10; ++i) QCOMPARE(all[i], i);
+    QVERIFY(ring.drained(1));
+    QVERIFY(!ring.drained(0));
+}
+
+void TestFanoutRing::testWrapAround()
+{
+    FanoutRing ring(0, 1);
+    std::vector<uint8_t> payload(1400);
+
+    // Push several capacities' worth through, draining as we go
+    const size_t rounds = ring.capacity() / payload.size() * 3;
+    size_t seen = 0;
+    bool intact = true;
+    for (size_t i = 0; i < rounds; ++i) {
+        std::memset(payload.data(), static_cast<int>(i & 0xFF), payload.size());
+        QVERIFY(ring.tryPublish(payload.data(), payload.size(), 0));
+        ring.consume(0, [&](const uint8_t* data, uint32_t length, int64_t) {
+            intact = intact && length == payload.size() &&
+                     data[0] == (seen & 0xFF) && data[length - 1] == (seen & 0xFF);
+            ++seen;
+        });
+    }
+    QVERIFY(intact);
+    QCOMPARE(seen, rounds);
+}
+
+void TestFanoutRing::testSlowestConsumerBackpressure()
+{
+    FanoutRing ring(0, 2);
+    std::vector<uint8_t> payload(4096);
+
+    size_t published = 0;
+    while (ring.tryPublish(payload.data(), payload.size(), 0)) {
+        ++published;
+        drainValues(ring, 0);   // Consumer 0 keeps up, consumer 1 does not
+    }
+    QVERIFY(published > 0);
+    QVERIFY(ring.backlog(1) > ring.capacity() - 2 * payload.size());
+
+    QCOMPARE(drainValues(ring, 1).size(), published);
+    QVERIFY(ring.tryPublish(payload.data(), payload.size(), 0));
+}
+
+// ─── Producer / consumers ────────────────────────────────
+
+void TestFanoutRing::testConcurrentConsumers()
+{
+    constexpr uint32_t kCount = 100000;
+    constexpr size_t kConsumers = 3;
+    FanoutRing ring(64 * 1024, kConsumers);
+    std::atomic<bool> done{false};
+
+    std::vector<uint32_t> received(kConsumers, 0);
+    std::vector<bool> ordered(kConsumers, true);
+    std::vector<std::thread> consumers;
+    for (size_t c = 0; c < kConsumers; ++c) {
+        consumers.emplace_back([&, c] {
+            auto check = [&](const uint8_t* data, uint32_t, int64_t ts) {
+                uint32_t v;
+                std::memcpy(&v, data, sizeof(v));
+                if (v != received[c] || ts != int64_t(v)) ordered[c] = false;
+                ++received[c];
+            };
+            for (;;) {
+                if (ring.consume(c, check) > 0) continue;
+                if (done.load() && ring.drained(c)) break;
+                std::this_thread::yield();
+            }
+        });
+    }
+
+    for (uint32_t i = 0; i < kCount; ++i) {
+        // Variable sizes exercise the wrap marker
+        uint8_t buf[256] = {};
+        std::memcpy(buf, &i, sizeof(i));
+        const size_t len = sizeof(i) + (i % 200);
+        while (!ring.tryPublish(buf, len, int64_t(i))) std::this_thread::yield();
+    }
+    done = true;
+    for (auto& t : consumers) t.join();
+
+    for (size_t c = 0; c < kConsumers; ++c) {
+        QVERIFY(ordered[c]);
+        QCOMPARE(received[c], kCount);
+    }
+}
+
+// ─── Token shards ────────────────────────────────────────
+
+void TestFanoutRing::testShardPartition()
+{
+    constexpr uint32_t kShards = 4;
+    std::vector<uint32_t> perShard(kShards, 0);
+    bool exactlyOne = true;
+
+    for (uint32_t token = 35000; token < 75000; ++token) {
+        int owners = 0;
+        for (uint32_t s = 0; s < kShards; ++s) {
+            nsefo::shard::assign(s, kShards);
+            if (nsefo::shard::ownsToken(token)) {
+                ++owners;
+                ++perShard[s];
+            }
+        }
+        exactlyOne = exactlyOne && owners == 1;
+    }
+    QVERIFY(exactlyOne);
+
+    // Consecutive tokens spread within 5% of an even split
+    for (uint32_t count : perShard) {
+        QVERIFY(count > 9500 && count < 10500);
+    }
+
+    // Shard 0 owns shared messages; an unassigned thread owns everything
+    nsefo::shard::assign(0, kShards);
+    QVERIFY(nsefo::shard::ownsShared());
+    nsefo::shard::assign(0, 1);
+    QVERIFY(nsefo::shard::ownsToken(12345));
+}
+
+QTEST_MAIN(TestFanoutRing)
+#include "test_fanout_ring.moc"
@@ -0,0 +1,428 @@
+/**
+ * @file test_feed_dispatcher.cpp
+ * @brief Unit tests for FeedDispatcher — native (segment, token) tick fan-out
+ *
+ * Tests:
+ *  - Per-key delivery, other keys untouched
+ *  - Update-type masks (trade/depth/touchline..., unknown types)
+ *  - RAII handles: scope exit, reset, move, release
+ *  - Unsubscribe by context / all keys of a context
+ *  - subscribeAll() sees every token of the requested types
+ *  - A callback may drop its own subscription
+ *  - Cross-thread publish lands on the receiver's thread; unsubscribe
+ *    drops calls that are already queued
+ *  - Several publisher threads: no call starts after unsubscribe returns,
+ *    and callbacks on two publisher threads may drop each other
+ *  - Benchmark: publish with 1/10/100 subscribers per token, dispatcher vs
+ *    the previous per-token TokenPublisher QObject + Qt connections
+ *
+ * Build: Requires Qt5::Core, Qt5::Test
+ */
+
+#include <QtTest/QtTest>
+#include <QElapsedTimer>
+#include <QThread>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "services/FeedDispatcher.h"
+
+namespace {
+
+int64_t keyOf(int segment, uint32_t token) {
+    return (static_cast<int64_t>(segment) << 32) | token;
+}
+
+UDP::MarketTick makeTick(int segment, uint32_t token,
+                         UDP::UpdateType type = UDP::UpdateType::TOUCHLINE) {
+    UDP::MarketTick tick(static_cast<UDP::ExchangeSegment>(segment), token);
+    tick.ltp = 100.0;
+    tick.updateType = type;
+    return tick;
+}
+
+} // namespace
+
+// Receiver for the Qt-signal baseline and the thread-affinity tests
+class TickSink : public QObject {
+    Q_OBJECT
+public:
+    qint64 count = 0;
+    QThread* lastThread = nullptr;
+public slots:
+    void onTick(const UDP::MarketTick&) {
+        ++count;
+        lastThread = QThread::currentThread();
+    }
+};
+
+// The per-token publisher FeedHandler used before the dispatcher
+class LegacyTokenPublisher : public QObject {
+    Q_OBJECT
+public:
+    void publish(const UDP::MarketTick& tick) { emit udpTickUpdated(tick); }
+signals:
+    void udpTickUpdated(const UDP::MarketTick& tick);
+};
+
+class TestFeedDispatcher : public QObject {
+    Q_OBJECT
+
+private slots:
+    // ─── Delivery ───
+    void testDeliversToKeyOnly();
+    void testTypeMask();
+    void testSubscribeAll();
+
+    // ─── Lifetime ───
+    void testHandleScope();
+    void testHandleMoveAndRelease();
+    void testUnsubscribeByContext();
+    void testCallbackDropsItself();
+
+    // ─── Threads ───
+    void testCrossThreadRunsOnReceiverThread();
+    void testUnsubscribeDropsQueuedCalls();
+    void testUnsubscribeWaitsForPublishers();
+    void testCallbacksOnTwoThreadsDropEachOther();
+
+    // ─── Benchmarks ───
+    void benchmarkPublish_data();
+    void benchmarkPublish();
+};
+
+// ─── Delivery ────────────────────────────────────────────
+
+void TestFeedDispatcher::testDeliversToKeyOnly()
+{
+    FeedDispatcher dispatcher;
+    int hits = 0;
+    auto sub = dispatcher.subscribe(keyOf(2, 49508), nullptr,
+                                    [&hits](const UDP::MarketTick& t) {
+                                        QCOMPARE(t.token, 49508u);
+                                        ++hits;
+                                    });
+
+    QCOMPARE(dispatcher.publish(makeTick(2, 49508)), size_t(1));
+    QCOMPARE(dispatcher.publish(makeTick(1, 49508)), size_t(0));   // Other segment
+    QCOMPARE(dispatcher.publish(makeTick(2, 49509)), size_t(0));
+    QCOMPARE(hits, 1);
+
+    QVERIFY(dispatcher.hasSubscribers(keyOf(2, 49508)));
+    QVERIFY(dispatcher.route(keyOf(2, 49509)).empty());
+    QCOMPARE(dispatcher.subscriberCount(), size_t(1));
+}
+
+void TestFeedDispatcher::testTypeMask()
+{
+    FeedDispatcher dispatcher;
+    int trades = 0, depthOrTouch = 0, all = 0, other = 0;
+    const int64_t key = keyOf(2, 35001);
+    auto a = dispatcher.subscribe(key, nullptr, [&](const UDP::MarketTick&) { ++trades; },
+                                  FeedDispatcher::TradeUpdates);
+    auto b = dispatcher.subscribe(key, nullptr, [&](const UDP::MarketTick&) { ++depthOrTouch; },
+                                  FeedDispatcher::DepthUpdates | FeedDispatcher::TouchlineUpdates);
+    auto c = dispatcher.subscribe(key, nullptr, [&](const UDP::MarketTick&) { ++all; });
+    auto d = dispatcher.subscribe(key, nullptr, [&](const UDP::MarketTick&) { ++other; },
+                                  FeedDispatcher::OtherUpdates);
+
+    dispatcher.publish(makeTick(2, 35001, UDP::UpdateType::TRADE_TICK));
+    dispatcher.publish(makeTick(2, 35001, UDP::UpdateType::DEPTH_UPDATE));
+    dispatcher.publish(makeTick(2, 35001, UDP::UpdateType::TOUCHLINE));
+    dispatcher.publish(makeTick(2, 35001, UDP::UpdateType::MARKET_WATCH));
+    dispatcher.publish(makeTick(2, 35001, UDP::UpdateType::UNKNOWN));
+
+    QCOMPARE(trades, 1);
+    QCOMPARE(depthOrTouch, 2);
+    QCOMPARE(all, 5);
+    QCOMPARE(other, 1);
+}
+
+void TestFeedDispatcher::testSubscribeAll()
+{
+    FeedDispatcher dispatcher;
+    int depth = 0, perKey = 0;
+    auto wide = dispatcher.subscribeAll(nullptr, [&](const UDP::MarketTick&) { ++depth; },
+                                        FeedDispatcher::DepthUpdates);
+    auto one = dispatcher.subscribe(keyOf(1, 2885), nullptr,
+                                    [&](const UDP::MarketTick&) { ++perKey; });
+
+    QVERIFY(!dispatcher.route(keyOf(12, 500325)).empty());   // Wildcard reaches any key
+    dispatcher.publish(makeTick(12, 500325, UDP::UpdateType::DEPTH_UPDATE));
+    dispatcher.publish(makeTick(1, 2885, UDP::UpdateType::DEPTH_UPDATE));
+    dispatcher.publish(makeTick(1, 2885, UDP::UpdateType::TOUCHLINE));
+
+    QCOMPARE(depth, 2);
+    QCOMPARE(perKey, 2);
+    QVERIFY(!dispatcher.hasSubscribers(keyOf(12, 500325)));
+}
+
+// ─── Lifetime ────────────────────────────────────────────
+
+void TestFeedDispatcher::testHandleScope()
+{
+    FeedDispatcher dispatcher;
+    int hits = 0;
+    {
+        auto sub = dispatcher.subscribe(keyOf(2, 1), nullptr,
+                                        [&hits](const UDP::MarketTick&) { ++hits; });
+        QVERIFY(sub.isActive());
+        dispatcher.publish(makeTick(2, 1));
+    }
+    dispatcher.publish(makeTick(2, 1));
+    QCOMPARE(hits, 1);
+    QCOMPARE(dispatcher.subscriberCount(), size_t(0));
+    QVERIFY(!dispatcher.hasSubscribers(keyOf(2, 1)));
+
+    auto sub = dispatcher.subscribe(keyOf(2, 1), nullptr,
+                                    [&hits](const UDP::MarketTick&) { ++hits; });
+    sub.reset();
+    QVERIFY(!sub.isActive());
+    dispatcher.publish(makeTick(2, 1));
+    QCOMPARE(hits, 1);
+}
+
+void TestFeedDispatcher::testHandleMoveAndRelease()
+{
+    FeedDispatcher dispatcher;
+    QObject owner;
+    int hits = 0;
+
+    FeedDispatcher::Subscription kept;
+    {
+        auto sub = dispatcher.subscribe(keyOf(2, 7), &owner,
+                                        [&hits](const UDP::MarketTick&) { ++hits; });
+        kept = std::move(sub);
+        QVERIFY(!sub.isActive());   // Moved-from handle owns nothing
+    }
+    dispatcher.publish(makeTick(2, 7));
+    QCOMPARE(hits, 1);
+
+    // Assigning over a live handle drops its subscription
+    kept = dispatcher.subscribe(keyOf(2, 8), &owner,
+                                [&hits](const UDP::MarketTick&) { hits += 10; });
+    dispatcher.publish(makeTick(2, 7));
+    dispatcher.publish(makeTick(2, 8));
+    QCOMPARE(hits, 11);
+
+    // Released subscriptions outlive the handle until unsubscribed by context
+    kept.release();
+    dispatcher.publish(makeTick(2, 8));
+    QCOMPARE(hits, 21);
+    dispatcher.unsubscribeAll(&owner);
+    dispatcher.publish(makeTick(2, 8));
+    QCOMPARE(hits, 21);
+}
+
+void TestFeedDispatcher::testUnsubscribeByContext()
+{
+    FeedDispatcher dispatcher;
+    QObject a, b;
+    int hitsA = 0, hitsB = 0;
+    for (uint32_t token = 1; token <= 3; ++token) {
+        dispatcher.subscribe(keyOf(2, token), &a, [&hitsA](const UDP::MarketTick&) { ++hitsA; }).release();
+        dispatcher.subscribe(keyOf(2, token), &b, [&hitsB](const UDP::MarketTick&) { ++hitsB; }).release();
+    }
+    QCOMPARE(dispatcher.subscriberCount(), size_t(6));
+
+    dispatcher.unsubscribe(keyOf(2, 1), &a);
+    dispatcher.publish(makeTick(2, 1));
+    QCOMPARE(hitsA, 0);
+    QCOMPARE(hitsB, 1);
+
+    dispatcher.unsubscribeAll(&b);
+    for (uint32_t token = 1; token <= 3; ++token) dispatcher.publish(makeTick(2, token));
+    QCOMPARE(hitsA, 2);
+    QCOMPARE(hitsB, 1);
+    QCOMPARE(dispatcher.subscriberCount(), size_t(2));
+}
+
+void TestFeedDispatcher::testCallbackDropsItself()
+{
+    FeedDispatcher dispatcher;
+    int hits = 0;
+    FeedDispatcher::Subscription sub;
+    sub = dispatcher.subscribe(keyOf(2, 9), nullptr, [&](const UDP::MarketTick&) {
+        ++hits;
+        sub.reset();   // Does not wait for its own in-flight call
+    });
+    dispatcher.publish(makeTick(2, 9));
+    dispatcher.publish(makeTick(2, 9));
+    QCOMPARE(hits, 1);
+    QCOMPARE(dispatcher.subscriberCount(), size_t(0));
+}
+
+// ─── Threads ─────────────────────────────────────────────
+
+void TestFeedDispatcher::testCrossThreadRunsOnReceiverThread()
+{
+    FeedDispatcher dispatcher;
+    TickSink sink;   // Lives on the test (GUI) thread
+    auto sub = dispatcher.subscribe(keyOf(2, 42), &sink,
+                                    [&sink](const UDP::MarketTick& t) { sink.onTick(t); });
+
+    std::unique_ptr<QThread> io(QThread::create([&dispatcher]() {
+        for (int i = 0; i < 100; ++i) dispatcher.publish(makeTick(2, 42));
+    }));
+    io->start();
+    QVERIFY(io->wait(5000));
+
+    QTRY_COMPARE_WITH_TIMEOUT(sink.count, qint64(100), 5000);
+    QCOMPARE(sink.lastThread, QThread::currentThread());
+}
+
+void TestFeedDispatcher::testUnsubscribeDropsQueuedCalls()
+{
+    FeedDispatcher dispatcher;
+    TickSink sink;
+    auto sub = dispatcher.subscribe(keyOf(2, 43), &sink,
+                                    [&sink](const UDP::MarketTick& t) { sink.onTick(t); });
+
+    std::unique_ptr<QThread> io(QThread::create([&dispatcher]() {
+        for (int i = 0; i < 50; ++i) dispatcher.publish(makeTick(2, 43));
+    }));
+    io->start();
+    QVERIFY(io->wait(5000));
+
+    // 50 calls are queued on this thread; none may run after unsubscribe
+    sub.reset();
+    QCoreApplication::processEvents();
+    QCOMPARE(sink.count, qint64(0));
+}
+
+void TestFeedDispatcher::testUnsubscribeWaitsForPublishers()
+{
+    FeedDispatcher dispatcher;
+    std::atomic<int> calls{0};
+    std::atomic<bool> stop{false};
+    auto sub = dispatcher.subscribe(keyOf(2, 44), nullptr,
+                                    [&calls](const UDP::MarketTick&) { ++calls; });
+
+    std::vector<std::unique_ptr<QThread>> publishers;
+    for (int i = 0; i < 3; ++i) {
+        publishers.emplace_back(QThread::create([&dispatcher, &stop]() {
+            while (!stop.load()) dispatcher.publish(makeTick(2, 44));
+        }));
+        publishers.back()->start();
+    }
+    QTRY_VERIFY(calls.load() >= 1000);
+
+    sub.reset();
+    const int after = calls.load();
+    QThread::msleep(20);
+    QCOMPARE(calls.load(), after);
+
+    stop = true;
+    for (auto& t : publishers) QVERIFY(t->wait(5000));
+}
+
+void TestFeedDispatcher::testCallbacksOnTwoThreadsDropEachOther()
+{
+    // Each callback waits until both are running, then drops the other's
+    // subscription: must not wait on the other (still running) callback
+    FeedDispatcher dispatcher;
+    std::atomic<int> running{0};
+    FeedDispatcher::Subscription first, second;
+    first = dispatcher.subscribe(keyOf(2, 45), nullptr, [&](const UDP::MarketTick&) {
+        ++running;
+        while (running.load() < 2) QThread::yieldCurrentThread();
+        second.reset();
+    });
+    second = dispatcher.subscribe(keyOf(2, 46), nullptr, [&](const UDP::MarketTick&) {
+        ++running;
+        while (running.load() < 2) QThread::yieldCurrentThread();
+        first.reset();
+    });
+
+    std::unique_ptr<QThread> a(QThread::create([&]() { dispatcher.publish(makeTick(2, 45)); }));
+    std::unique_ptr<QThread> b(QThread::create([&]() { dispatcher.publish(makeTick(2, 46)); }));
+    a->start();
+    b->start();
+    QVERIFY(a->wait(5000));
+    QVERIFY(b->wait(5000));
+    QCOMPARE(dispatcher.subscriberCount(), size_t(0));
+}
+
+// ─── Benchmarks ──────────────────────────────────────────
+
+void TestFeedDispatcher::benchmarkPublish_data()
+{
+    QTest::addColumn<bool>("native");
+    QTest::addColumn<int>("subscribersPerToken");
+    for (int n : {1, 10, 100}) {
+        QTest::newRow(qPrintable(QString("dispatcher %1/token").arg(n))) << true << n;
+        QTest::newRow(qPrintable(QString("TokenPublisher %1/token").arg(n))) << false << n;
+    }
+}
+
+void TestFeedDispatcher::benchmarkPublish()
+{
+    QFETCH(bool, native);
+    QFETCH(int, subscribersPerToken);
+
+    // 200 watched tokens; 20k ticks, receivers on the publishing thread
+    // (direct calls on both paths, so this measures fan-out cost only)
+    constexpr int kTokens = 200;
+    constexpr int kTicks = 20000;
+    std::vector<std::unique_ptr<TickSink>> sinks;
+    for (int i = 0; i < subscribersPerToken; ++i) sinks.push_back(std::make_unique<TickSink>());
+
+    FeedDispatcher dispatcher;
+    std::vector<FeedDispatcher::Subscription> handles;
+
+    // Previous FeedHandler layout: mutex + map of heap QObject publishers
+    std::mutex legacyMutex;
+    std::unordered_map<int64_t, std::unique_ptr<LegacyTokenPublisher>> legacy;
+
+    for (uint32_t token = 1; token <= kTokens; ++token) {
+        const int64_t key = keyOf(2, token);
+        for (auto& sink : sinks) {
+            TickSink* s = sink.get();
+            if (native) {
+                handles.push_back(dispatcher.subscribe(
+                    key, s, [s](const UDP::MarketTick& t) { s->onTick(t); }));
+            } else {
+                auto& pub = legacy[key];
+                if (!pub) pub = std::make_unique<LegacyTokenPublisher>();
+                connect(pub.get(), &LegacyTokenPublisher::udpTickUpdated, s, &TickSink::onTick);
+            }
+        }
+    }
+
+    std::vector<UDP::MarketTick> ticks;
+    for (int i = 0; i < kTicks; ++i) ticks.push_back(makeTick(2, 1 + (i * 7919) % kTokens));
+
+    QElapsedTimer timer;
+    qint64 elapsedNs = 0;
+    QBENCHMARK {
+        timer.start();
+        for (const UDP::MarketTick& tick : ticks) {
+            if (native) {
+                dispatcher.publish(tick);
+            } else {
+                LegacyTokenPublisher* pub = nullptr;
+                {
+                    std::lock_guard<std::mutex> lock(legacyMutex);
+                    auto it = legacy.find(keyOf(2, tick.token));
+                    if (it != legacy.end()) pub = it->second.get();
+                }
+                if (pub) pub->publish(tick);
+            }
+        }
+        elapsedNs = timer.nsecsElapsed();
+    }
+
+    const double nsPerTick = double(elapsedNs) / kTicks;
+    qint64 delivered = 0;
+    for (auto& sink : sinks) delivered += sink->count;
+    qDebug().nospace() << (native ? "dispatcher" : "TokenPublisher") << " subs/token="
+                       << subscribersPerToken << " ns/tick=" << nsPerTick
+                       << " ns/delivery=" << nsPerTick / subscribersPerToken;
+
+    QVERIFY(delivered >= qint64(kTicks) * subscribersPerToken);
+}
+
+QTEST_MAIN(TestFeedDispatcher)
+#include "test_feed_dispatcher.moc"
@@ -0,0 +1,625 @@
+/**
+ * @file test_instrument_search_index.cpp
+ * @brief Unit tests for InstrumentSearchIndex (inverted-index scrip search)
+ *
+ * Tests:
+ *  - Field word splitting
+ *  - Prefix matching on symbol / display name / expiry / strike words
+ *  - Ranking: exact scrip code, exact symbol, then rank order
+ *  - Pinned strike and CE/PE, expiry pin from the tokenizer (and the year
+ *    not taken as a strike), month-like symbols not pinned
+ *  - Segment mask and exact expiry filter
+ *  - Same result set as a linear scan over a ~120K contract universe
+ *  - Sessions: same results as search() while typing and deleting, refine
+ *    only when the query extends the last one, cancellation
+ *  - Benchmark: keystroke-by-keystroke latency vs the linear scan
+ *  - Benchmark: keystroke latency with and without a session
+ *
+ * Build: Requires Qt5::Core, Qt5::Test
+ */
+
+#include <QtTest/QtTest>
+#include <QElapsedTimer>
+#include <QLocale>
+#include <algorithm>
+#include "search/InstrumentSearchIndex.h"
+#include "search/SearchTokenizer.h"
+
+namespace {
+
+struct Entry {
+    int segment;
+    ContractData contract;
+};
+
+QString expiryText(const QDate &date) {
+    return date.toString("dd") + QLocale::c().monthName(date.month(), QLocale::ShortFormat).toUpper() +
+           date.toString("yyyy");
+}
+
+ContractData equity(int64_t token, const QString &name) {
+    ContractData c;
+    c.exchangeInstrumentID = token;
+    c.name = name;
+    c.displayName = name + " EQ";
+    c.description = name + "-EQ";
+    c.series = "EQ";
+    c.optionType = "EQ";
+    return c;
+}
+
+ContractData future(int64_t token, const QString &name, const QDate &expiry) {
+    ContractData c;
+    c.exchangeInstrumentID = token;
+    c.name = name;
+    c.expiryDate = expiryText(expiry);
+    c.expiryDate_dt = expiry;
+    c.instrumentType = 1;
+    c.optionType = "FUT";
+    c.series = "FUTSTK";
+    c.displayName = name + " " + c.expiryDate + " FUT";
+    c.description = name + c.expiryDate.mid(7) + c.expiryDate.mid(2, 3) + "FUT";
+    return c;
+}
+
+ContractData option(int64_t token, const QString &name, const QDate &expiry, double strike,
+                    const QString &type) {
+    ContractData c = future(token, name, expiry);
+    c.instrumentType = 2;
+    c.strikePrice = strike;
+    c.optionType = type;
+    c.series = "OPTSTK";
+    const QString strikeText = QString::number(strike, 'g', 10);
+    c.displayName = name + " " + c.expiryDate + " " + type + " " + strikeText;
+    c.description = name + c.expiryDate.mid(7) + c.expiryDate.mid(2, 3) + strikeText + type;
+    return c;
+}
+
+// Shape of the real masters: ~180 underlyings x 3 expiries x 110 strikes
+// x CE/PE in NSE F&O, plus equities, BSE cash and SENSEX options
+QVector<Entry> universe() {
+    QVector<Entry> out;
+    QStringList symbols = {"NIFTY", "BANKNIFTY", "FINNIFTY", "NIFTYNXT50", "RELIANCE",
+                           "TCS",   "INFY",      "HDFCBANK", "ICICIBANK",  "MARUTI"};
+    for (int i = 0; i < 170; ++i) {
+        QString symbol = "STK";
+        for (int k = 0, v = i; k < 3; ++k, v /= 26)
+            symbol += QChar('A' + v % 26);
+        symbols << symbol;
+    }
+    const QDate expiries[] = {QDate(2026, 10, 27), QDate(2026, 11, 24), QDate(2026, 12, 29)};
+
+    int64_t token = 35000;
+    for (int s = 0; s < symbols.size(); ++s) {
+        const QString &name = symbols[s];
+        out.append({1, equity(1000 + s, name)});
+        ContractData bse = equity(500000 + s, name);
+        bse.scripCode = QString::number(500000 + s);
+        out.append({11, bse});
+
+        const double base = s == 0 ? 25000 : s == 1 ? 55000 : 100 + s * 10;
+        const double step = s < 2 ? 50 : 1;
+        for (const QDate &expiry : expiries) {
+            out.append({2, future(token++, name, expiry)});
+            for (int k = -55; k < 55; ++k) {
+                out.append({2, option(token++, name, expiry, base + k * step, "CE")});
+                out.append({2, option(token++, name, expiry, base + k * step, "PE")});
+            }
+        }
+    }
+    for (int i = 0; i < 3000; ++i) {
+        out.append({12, option(1100000 + i, "SENSEX", expiries[i % 3], 70000 + (i / 6) * 100,
+                               i % 2 ? "PE" : "CE")});
+    }
+    return out;
+}
+
+InstrumentSearchIndex buildIndex(const QVector<Entry> &entries) {
+    InstrumentSearchIndex index;
+    for (int segment : {1, 2, 11, 12})
+        for (const Entry &e : entries)
+            if (e.segment == segment) index.add(segment, e.contract);
+    index.finalize();
+    return index;
+}
+
+// Reference: the same rules as the index, checked contract by contract
+bool referenceMatch(const Entry &e, const QString &query, int mask, const QString &expiryFilter) {
+    const ContractData &c = e.contract;
+    if (!(InstrumentSearchIndex::segmentBit(e.segment) & mask)) return false;
+    if (!expiryFilter.isEmpty() && c.expiryDate != expiryFilter) return false;
+
+    const SearchTokenizer::ParsedTokens parsed = SearchTokenizer::parse(query);
+    const QStringList tokens = query.toUpper().split(' ', Qt::SkipEmptyParts);
+    if (tokens.size() == 1 && tokens[0] == QString::number(c.exchangeInstrumentID))
+        return true; // Token / scrip code lookup
+    double strike = parsed.strike;
+    if (!parsed.expiry.isEmpty() && strike == parsed.expiry.right(4).toInt()) strike = 0.0;
+    if (strike > 0.0) {
+        const double diff = qAbs(c.strikePrice - strike);
+        if (c.strikePrice <= 0.0 || !(diff < 0.01 || diff <= c.strikePrice * 0.05)) return false;
+    }
+    if (parsed.optionType > 0 && c.optionType != (parsed.optionType == 3 ? "CE" : "PE"))
+        return false;
+
+    QStringList terms = QStringList(c.name.toUpper()) + InstrumentSearchIndex::words(c.name) +
+                        InstrumentSearchIndex::words(c.displayName) +
+                        InstrumentSearchIndex::words(c.description);
+    terms << QString::number(c.exchangeInstrumentID) << c.scripCode;
+    if (c.expiryDate.size() == 9) {
+        terms << c.expiryDate << c.expiryDate.mid(2) << c.expiryDate.left(2)
+              << c.expiryDate.mid(2, 3) << c.expiryDate.right(4) << c.expiryDate.right(2);
+    }
+    if (c.strikePrice > 0.0) terms << QString::number(c.strikePrice, 'f', 2);
+    if (c.optionType == "CE" || c.optionType == "PE") terms << c.optionType;
+
+    for (const QString &token : tokens) {
+        if (parsed.optionType > 0 && (token == "CE" || token == "PE" || token == "C" ||
+                                      token == "P" || token == "CALL" || token == "PUT"))
+            continue;
+        bool found = false;
+        for (const QString &term : terms) {
+            if (!term.isEmpty() && term.startsWith(token)) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) return false;
+    }
+    return true;
+}
+
+// The pre-index global search: every contract, substring matching
+bool linearScanMatch(const ContractData &c, const QStringList &queryTokens,
+                     const SearchTokenizer::ParsedTokens &parsed) {
+    if (parsed.strike > 0.0) {
+        if (c.strikePrice <= 0.0) return false;
+        const double diff = qAbs(c.strikePrice - parsed.strike);
+        if (!(diff < 0.01 || diff <= c.strikePrice * 0.05)) return false;
+    }
+    if (parsed.optionType > 0 && c.optionType != (parsed.optionType == 3 ? "CE" : "PE"))
+        return false;
+    for (const QString &token : queryTokens) {
+        if (c.name.startsWith(token, Qt::CaseInsensitive)) continue;
+        if (c.displayName.contains(token, Qt::CaseInsensitive)) continue;
+        if (c.description.contains(token, Qt::CaseInsensitive)) continue;
+        if (!c.expiryDate.isEmpty() && c.expiryDate.contains(token, Qt::CaseInsensitive)) continue;
+        if (c.strikePrice > 0 && QString::number(c.strikePrice, 'f', 2).startsWith(token)) continue;
+        return false;
+    }
+    return true;
+}
+
+QString label(const InstrumentSearchIndex::Hit &hit, const QVector<Entry> &entries) {
+    for (const Entry &e : entries)
+        if (e.segment == hit.exchangeSegment && e.contract.exchangeInstrumentID == hit.token)
+            return e.contract.displayName;
+    return QString();
+}
+
+} // namespace
+
+class TestInstrumentSearchIndex : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    // ─── Matching ───
+    void testWords();
+    void testPrefixMatching();
+    void testRanking();
+    void testPinnedFields();
+    void testExpiryPin();
+    void testFilters();
+    void testMatchesLinearScan_data();
+    void testMatchesLinearScan();
+
+    // ─── Sessions ───
+    void testSessionMatchesSearch_data();
+    void testSessionMatchesSearch();
+    void testSessionRefinement();
+    void testSessionCancelled();
+
+    // ─── Benchmark ───
+    void benchmarkKeystrokeLatency();
+    void benchmarkSessionKeystrokes();
+
+private:
+    QVector<Entry> m_entries;
+    InstrumentSearchIndex m_index;
+};
+
+void TestInstrumentSearchIndex::initTestCase()
+{
+    m_entries = universe();
+    QElapsedTimer timer;
+    timer.start();
+    m_index = buildIndex(m_entries);
+    qDebug().nospace() << "Index: " << m_index.size() << " contracts, " << m_index.termCount()
+                       << " terms, built in " << timer.elapsed() << " ms";
+    QCOMPARE(m_index.size(), m_entries.size());
+}
+
+// ─── Matching ────────────────────────────────────────────
+
+void TestInstrumentSearchIndex::testWords()
+{
+    QCOMPARE(InstrumentSearchIndex::words("Nifty 27JAN2026 CE 23000"),
+             QStringList({"NIFTY", "27JAN2026", "CE", "23000"}));
+    QCOMPARE(InstrumentSearchIndex::words(" RELIANCE-EQ  (NSE)/x_y,"),
+             QStringList({"RELIANCE", "EQ", "NSE", "X", "Y"}));
+    QCOMPARE(InstrumentSearchIndex::words("M&M"), QStringList({"M&M"}));
+    QVERIFY(InstrumentSearchIndex::words("  ").isEmpty());
+}
+
+void TestInstrumentSearchIndex::testPrefixMatching()
+{
+    // Symbol prefix
+    const auto nif = m_index.search("nif", InstrumentSearchIndex::AllSegments, QString(), 1000);
+    QVERIFY(!nif.isEmpty());
+    for (const auto &hit : nif)
+        QVERIFY(label(hit, m_entries).startsWith("NIFTY"));
+
+    // Words of the display name, expiry and strike
+    const auto hits = m_index.search("stkbaa 27oct 15", InstrumentSearchIndex::NSEFO);
+    QVERIFY(!hits.isEmpty());
+    for (const auto &hit : hits) {
+        const QString name = label(hit, m_entries);
+        QVERIFY2(name.startsWith("STKBAA 27OCT2026") && name.contains(" 15"), qPrintable(name));
+    }
+
+    QVERIFY(m_index.search("zzzz").isEmpty());
+    QVERIFY(m_index.search("   ").isEmpty());
+    QVERIFY(m_index.search("nifty", InstrumentSearchIndex::AllSegments, QString(), 0).isEmpty());
+}
+
+void TestInstrumentSearchIndex::testRanking()
+{
+    // Exact symbol ahead of longer symbols, cash ahead of F&O, futures
+    // ahead of options within an expiry
+    const auto nifty = m_index.search("nifty", InstrumentSearchIndex::AllSegments, QString(), 3);
+    QCOMPARE(nifty.size(), 3);
+    QCOMPARE(label(nifty[0], m_entries), QString("NIFTY EQ"));
+    QCOMPARE(label(nifty[1], m_entries), QString("NIFTY 27OCT2026 FUT"));
+    QCOMPARE(label(nifty[2], m_entries), QString("NIFTY 27OCT2026 CE 22250"));
+
+    const auto nif = m_index.search("nif", InstrumentSearchIndex::AllSegments, QString(), 2);
+    QCOMPARE(label(nif[0], m_entries), QString("NIFTY EQ"));
+    QCOMPARE(label(nif[1], m_entries), QString("NIFTYNXT50 EQ"));
+
+    // A lone number is a token / scrip code first
+    const auto code = m_index.search("1004");
+    QVERIFY(!code.isEmpty());
+    QCOMPARE(code[0].exchangeSegment, 1);
+    QCOMPARE(code[0].token, int64_t(1004));
+
+    const auto scrip = m_index.search("500004");
+    QCOMPARE(scrip.size(), 1);
+    QCOMPARE(scrip[0].exchangeSegment, 11);
+}
+
+void TestInstrumentSearchIndex::testPinnedFields()
+{
+    const auto calls = m_index.search("nifty 25000 ce", InstrumentSearchIndex::AllSegments,
+                                      QString(), 100);
+    QCOMPARE(calls.size(), 3); // One per expiry
+    for (const auto &hit : calls)
+        QVERIFY(label(hit, m_entries).endsWith("CE 25000"));
+
+    const auto puts = m_index.search("nifty put 25100");
+    QCOMPARE(puts.size(), 3);
+    for (const auto &hit : puts)
+        QVERIFY(label(hit, m_entries).endsWith("PE 25100"));
+}
+
+void TestInstrumentSearchIndex::testExpiryPin()
+{
+    // Day + month + year; 2026 is the year, not a strike
+    const auto day = m_index.search("finnifty 27oct2026", InstrumentSearchIndex::AllSegments,
+                                    QString(), 1000);
+    QCOMPARE(day.size(), 1 + 220);
+    for (const auto &hit : day)
+        QVERIFY(label(hit, m_entries).startsWith("FINNIFTY 27OCT2026"));
+
+    // Month + year pins the month
+    const auto month = m_index.search("finnifty nov 2026", InstrumentSearchIndex::AllSegments,
+                                      QString(), 1000);
+    QCOMPARE(month.size(), 1 + 220);
+    for (const auto &hit : month)
+        QVERIFY(label(hit, m_entries).startsWith("FINNIFTY 24NOV2026"));
+
+    // "MARUTI" is not the month MAR
+    const auto maruti = m_index.search("maruti dec 2026", InstrumentSearchIndex::AllSegments,
+                                       QString(), 1000);
+    QCOMPARE(maruti.size(), 1 + 220);
+    for (const auto &hit : maruti)
+        QVERIFY(label(hit, m_entries).startsWith("MARUTI 29DEC2026"));
+}
+
+void TestInstrumentSearchIndex::testFilters()
+{
+    const int fo = InstrumentSearchIndex::segmentMask("NSE", "FO");
+    QCOMPARE(fo, int(InstrumentSearchIndex::NSEFO));
+    QCOMPARE(InstrumentSearchIndex::segmentMask("ALL", "STOCKS"),
+             InstrumentSearchIndex::NSECM | InstrumentSearchIndex::BSECM);
+    QCOMPARE(InstrumentSearchIndex::segmentMask("", ""), int(InstrumentSearchIndex::AllSegments));
+
+    const auto cash = m_index.search("reliance", InstrumentSearchIndex::segmentMask("BSE", "CM"));
+    QCOMPARE(cash.size(), 1);
+    QCOMPARE(cash[0].exchangeSegment, 11);
+
+    const auto nov = m_index.search("reliance", fo, "24NOV2026", 1000);
+    QCOMPARE(nov.size(), 1 + 220);
+    for (const auto &hit : nov)
+        QVERIFY(label(hit, m_entries).startsWith("RELIANCE 24NOV2026"));
+
+    QVERIFY(m_index.search("reliance", fo, "01JAN2020").isEmpty());
+}
+
+void TestInstrumentSearchIndex::testMatchesLinearScan_data()
+{
+    QTest::addColumn<QString>("query");
+    QTest::addColumn<int>("mask");
+    QTest::addColumn<QString>("expiry");
+
+    const int all = InstrumentSearchIndex::AllSegments;
+    QTest::newRow("symbol") << "bank" << all << "";
+    QTest::newRow("symbol + expiry") << "stkc 24nov" << all << "";
+    QTest::newRow("strike pin") << "sensex 71000" << all << "";
+    QTest::newRow("strike + type") << "banknifty 55000 pe" << all << "";
+    QTest::newRow("strike prefix") << "finnifty 12" << all << "";
+    QTest::newRow("short year") << "tcs 26 fut" << all << "";
+    QTest::newRow("option word") << "infy call" << all << "";
+    QTest::newRow("masked") << "s" << int(InstrumentSearchIndex::BSEFO) << "";
+    QTest::newRow("expiry filter") << "stk" << all << "29DEC2026";
+    QTest::newRow("token") << "35010" << all << "";
+}
+
+void TestInstrumentSearchIndex::testMatchesLinearScan()
+{
+    QFETCH(QString, query);
+    QFETCH(int, mask);
+    QFETCH(QString, expiry);
+
+    QSet<QPair<int, qint64>> expected;
+    for (const Entry &e : m_entries)
+        if (referenceMatch(e, query, mask, expiry))
+            expected.insert({e.segment, e.contract.exchangeInstrumentID});
+
+    QSet<QPair<int, qint64>> actual;
+    for (const auto &hit : m_index.search(query, mask, expiry, m_entries.size()))
+        actual.insert({hit.exchangeSegment, hit.token});
+
+    QVERIFY(!expected.isEmpty());
+    QCOMPARE(actual.size(), expected.size());
+    QCOMPARE(actual, expected);
+}
+
+// ─── Sessions ────────────────────────────────────────────
+
+void TestInstrumentSearchIndex::testSessionMatchesSearch_data()
+{
+    QTest::addColumn<QString>("query");
+    QTest::addColumn<int>("mask");
+    QTest::addColumn<QString>("expiry");
+
+    const int all = InstrumentSearchIndex::AllSegments;
+    QTest::newRow("strike and type") << "nifty 25000 ce" << all << "";
+    QTest::newRow("expiry and strike") << "banknifty 27oct2026 55000 pe" << all << "";
+    QTest::newRow("month and year") << "finnifty dec 2026" << all << "";
+    QTest::newRow("word becomes type") << "infy call" << all << "";
+    QTest::newRow("month-like symbol") << "maruti mar" << all << "";
+    QTest::newRow("day then month") << "nifty 2 nov 2026" << all << "";
+    QTest::newRow("token") << "35010" << all << "";
+    QTest::newRow("segment") << "sensex 71000 p" << int(InstrumentSearchIndex::BSEFO) << "";
+    QTest::newRow("expiry filter") << "stkc 10" << all << "24NOV2026";
+}
+
+void TestInstrumentSearchIndex::testSessionMatchesSearch()
+{
+    QFETCH(QString, query);
+    QFETCH(int, mask);
+    QFETCH(QString, expiry);
+
+    auto same = [](const QVector<InstrumentSearchIndex::Hit> &a,
+                   const QVector<InstrumentSearchIndex::Hit> &b) {
+        if (a.size() != b.size()) return false;
+        for (int i = 0; i < a.size(); ++i)
+            if (a[i].exchangeSegment != b[i].exchangeSegment || a[i].token != b[i].token)
+                return false;
+        return true;
+    };
+
+    // Type the query, then delete it again, through one session
+    InstrumentSearchIndex::Session session;
+    QStringList keystrokes;
+    for (int length = 1; length <= query.size(); ++length) keystrokes << query.left(length);
+    for (int length = query.size() - 1; length >= 1; --length) keystrokes << query.left(length);
+
+    int refined = 0;
+    for (const QString &typed : keystrokes) {
+        const auto expected = m_index.search(typed, mask, expiry, 100);
+        const auto actual = m_index.search(&session, typed, mask, expiry, 100);
+        if (!same(actual, expected))
+            QFAIL(qPrintable(QString("'%1': %2 results, search() has %3")
+                                 .arg(typed).arg(actual.size()).arg(expected.size())));
+        if (session.wasRefined()) ++refined;
+    }
+    QVERIFY(refined > 0);
+}
+
+void TestInstrumentSearchIndex::testSessionRefinement()
+{
+    InstrumentSearchIndex::Session session;
+    auto type = [&](const QString &text, const QString &expiry = QString()) {
+        m_index.search(&session, text, InstrumentSearchIndex::AllSegments, expiry, 50);
+        return session.wasRefined();
+    };
+
+    QVERIFY(!type("banknifty"));
+    QVERIFY(session.isValid());
+    const int all = session.candidateCount();
+    QVERIFY(type("banknifty "));
+    QVERIFY(type("banknifty 5"));
+    QVERIFY(type("banknifty 55"));
+    QVERIFY(session.candidateCount() < all);
+
+    // A new strike pin is not a narrowing of the old one
+    QVERIFY(type("banknifty 550"));
+    QVERIFY(!type("banknifty 5500"));
+    QVERIFY(!type("banknifty 55000"));
+    QVERIFY(type("banknifty 55000 p"));
+    QVERIFY(type("banknifty 55000 pe"));
+    QCOMPARE(session.candidateCount(), 3);
+
+    // Deleting widens: search afresh
+    QVERIFY(!type("banknifty 55000 "));
+
+    // "CAL" -> "CALL" turns a word into a pinned CE
+    QVERIFY(!type("infy cal"));
+    QVERIFY(!type("infy call"));
+
+    // Changing a filter starts afresh
+    QVERIFY(!type("nifty 25000"));
+    QVERIFY(!type("nifty 25000", "27OCT2026"));
+    QVERIFY(type("nifty 25000 c", "27OCT2026"));
+
+    // A query matching too much is not kept
+    QVERIFY(!type("s"));
+    QVERIFY(!session.isValid());
+    QVERIFY(!type("st"));
+    QVERIFY(!session.isValid());
+
+    // A rebuilt index invalidates the session
+    InstrumentSearchIndex other = buildIndex(m_entries);
+    QVERIFY(!type("reliance"));
+    other.search(&session, "reliance ", InstrumentSearchIndex::AllSegments, QString(), 50);
+    QVERIFY(!session.wasRefined());
+}
+
+void TestInstrumentSearchIndex::testSessionCancelled()
+{
+    InstrumentSearchIndex::Session session;
+    m_index.search(&session, "nifty", InstrumentSearchIndex::AllSegments, QString(), 50);
+    const int candidates = session.candidateCount();
+    QVERIFY(candidates > 0);
+
+    std::atomic_bool cancelled(true);
+    QVERIFY(m_index.search(&session, "nifty 25000", InstrumentSearchIndex::AllSegments,
+                           QString(), 50, &cancelled)
+                .isEmpty());
+    QVERIFY(m_index.search(&session, "sensex", InstrumentSearchIndex::AllSegments,
+                           QString(), 50, &cancelled)
+                .isEmpty());
+
+    // Untouched: the next query still refines the last completed one
+    QCOMPARE(session.candidateCount(), candidates);
+    cancelled = false;
+    QVERIFY(!m_index.search(&session, "nifty 25000", InstrumentSearchIndex::AllSegments,
+                            QString(), 50, &cancelled)
+                 .isEmpty());
+    QVERIFY(session.wasRefined());
+}
+
+// ─── Benchmark ───────────────────────────────────────────
+
+void TestInstrumentSearchIndex::benchmarkKeystrokeLatency()
+{
+    const QStringList queries = {"nifty 25000 ce", "banknifty 27oct 55000 pe", "reliance",
+                                 "sensex 71000", "stkbaa nov", "500004"};
+    const int kResults = 50;
+    const int kRepeats = 20;
+
+    qint64 indexTotalNs = 0, indexWorstNs = 0;
+    qint64 scanTotalNs = 0, scanWorstNs = 0;
+    int keystrokes = 0;
+
+    QBENCHMARK_ONCE {
+        for (const QString &query : queries) {
+            for (int length = 1; length <= query.size(); ++length) {
+                const QString typed = query.left(length);
+
+                QElapsedTimer timer;
+                timer.start();
+                for (int r = 0; r < kRepeats; ++r)
+                    m_index.search(typed, InstrumentSearchIndex::AllSegments, QString(), kResults);
+                const qint64 indexNs = timer.nsecsElapsed() / kRepeats;
+
+                // Pre-index path: tokenize, then test every contract
+                timer.restart();
+                const SearchTokenizer::ParsedTokens parsed = SearchTokenizer::parse(typed);
+                const QStringList tokens = typed.toUpper().split(' ', Qt::SkipEmptyParts);
+                int found = 0;
+                for (const Entry &e : m_entries) {
+                    if (found < kResults && linearScanMatch(e.contract, tokens, parsed))
+                        ++found;
+                }
+                const qint64 scanNs = timer.nsecsElapsed();
+
+                indexTotalNs += indexNs;
+                indexWorstNs = qMax(indexWorstNs, indexNs);
+                scanTotalNs += scanNs;
+                scanWorstNs = qMax(scanWorstNs, scanNs);
+                ++keystrokes;
+            }
+        }
+    }
+
+    qDebug().nospace() << keystrokes << " keystrokes over " << m_entries.size()
+                       << " contracts: index avg " << indexTotalNs / keystrokes / 1000.0
+                       << " us, worst " << indexWorstNs / 1000.0 << " us; linear scan avg "
+                       << scanTotalNs / keystrokes / 1000.0 << " us, worst "
+                       << scanWorstNs / 1000.0 << " us";
+    QVERIFY(indexTotalNs < scanTotalNs);
+}
+
+void TestInstrumentSearchIndex::benchmarkSessionKeystrokes()
+{
+    const QStringList queries = {"nifty 25000 ce", "banknifty 27oct 55000 pe", "reliance",
+                                 "sensex 71000", "stkbaa nov", "finnifty dec 2026 20"};
+    const int kResults = 50;
+    const int kRepeats = 20;
+
+    qint64 searchTotalNs = 0, searchWorstNs = 0;
+    qint64 sessionTotalNs = 0, sessionWorstNs = 0;
+    int keystrokes = 0, refined = 0;
+
+    QBENCHMARK_ONCE {
+        for (const QString &query : queries) {
+            for (int r = 0; r < kRepeats; ++r) {
+                InstrumentSearchIndex::Session session;
+                for (int length = 2; length <= query.size(); ++length) {
+                    const QString typed = query.left(length);
+
+                    QElapsedTimer timer;
+                    timer.start();
+                    m_index.search(typed, InstrumentSearchIndex::AllSegments, QString(), kResults);
+                    const qint64 searchNs = timer.nsecsElapsed();
+
+                    timer.restart();
+                    m_index.search(&session, typed, InstrumentSearchIndex::AllSegments, QString(),
+                                   kResults);
+                    const qint64 sessionNs = timer.nsecsElapsed();
+
+                    searchTotalNs += searchNs;
+                    searchWorstNs = qMax(searchWorstNs, searchNs);
+                    sessionTotalNs += sessionNs;
+                    sessionWorstNs = qMax(sessionWorstNs, sessionNs);
+                    ++keystrokes;
+                    if (session.wasRefined()) ++refined;
+                }
+            }
+        }
+    }
+
+    qDebug().nospace() << keystrokes << " keystrokes, " << refined
+                       << " refined: search avg " << searchTotalNs / keystrokes / 1000.0
+                       << " us, worst " << searchWorstNs / 1000.0 << " us; session avg "
+                       << sessionTotalNs / keystrokes / 1000.0 << " us, worst "
+                       << sessionWorstNs / 1000.0 << " us";
+    QVERIFY(refined > 0);
+}
+
+QTEST_MAIN(TestInstrumentSearchIndex)
+#include "test_instrument_search_index.moc"
@@ -0,0 +1,356 @@
+/**
+ * @file test_latency_histogram.cpp
+ * @brief Unit tests for LatencyHistogram and the LatencyTracker stage report
+ *
+ * Tests:
+ *  - Bucket bounds: every value lands in a bucket whose bounds contain it,
+ *    buckets are contiguous and at most ~3% wide
+ *  - Percentiles of known distributions within the bucket error
+ *  - Concurrent record() from several threads loses no samples
+ *  - Negative (out-of-order) samples counted, not bucketed; reset
+ *  - snapshotSince(): only the samples of the current interval, restarted
+ *    by a reset
+ *  - Stage report: per segment / stage rows, missing timestamps skipped,
+ *    CSV and JSON output, interval dumps
+ *  - Benchmark: record() cost
+ *
+ * Build: Requires Qt5::Core, Qt5::Test
+ */
+
+#include <QtTest/QtTest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+#include "utils/LatencyTracker.h"
+
+class TestLatencyHistogram : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init() { LatencyTracker::resetHistograms(); }
+
+    // ─── Buckets ───
+    void testBucketBounds();
+
+    // ─── Percentiles ───
+    void testPercentiles_data();
+    void testPercentiles();
+    void testSingleValueAndEmpty();
+
+    // ─── Recording ───
+    void testConcurrentRecord();
+    void testNegativeSamplesAndReset();
+    void testIntervalSnapshot();
+
+    // ─── Stage report ───
+    void testStageRecording();
+    void testCsvAndJson();
+    void testWriteDump();
+    void testWriteIntervalDump();
+
+    // ─── Benchmark ───
+    void benchmarkRecord();
+};
+
+// ─── Buckets ─────────────────────────────────────────────
+
+void TestLatencyHistogram::testBucketBounds()
+{
+    // Contiguous: each bucket starts right after the previous one ends
+    for (int i = 1; i < LatencyHistogram::kBucketCount; ++i)
+        QCOMPARE(LatencyHistogram::bucketLowerBound(i),
+                 LatencyHistogram::bucketUpperBound(i - 1) + 1);
+    QCOMPARE(LatencyHistogram::bucketUpperBound(LatencyHistogram::kBucketCount - 1),
+             LatencyHistogram::kMaxValue);
+
+    const int64_t samples[] = {0, 1, 31, 32, 33, 63, 64, 65, 100, 999, 1000, 4097,
+                               123456, 9999999, LatencyHistogram::kMaxValue};
+    for (int64_t v : samples) {
+        const int index = LatencyHistogram::bucketIndex(v);
+        QVERIFY2(index >= 0 && index < LatencyHistogram::kBucketCount, qPrintable(QString::number(v)));
+        QVERIFY(LatencyHistogram::bucketLowerBound(index) <= v);
+        QVERIFY(LatencyHistogram::bucketUpperBound(index) >= v);
+
+        // Relative width bounds the percentile error
+        const double width = LatencyHistogram::bucketUpperBound(index) -
+                             LatencyHistogram::bucketLowerBound(index);
+        QVERIFY(v < LatencyHistogram::kSubBuckets || width / v <= 1.0 / 32);
+    }
+}
+
+// ─── Percentiles ─────────────────────────────────────────
+
+void TestLatencyHistogram::testPercentiles_data()
+{
+    QTest::addColumn<QString>("distribution");
+    QTest::newRow("uniform 1..100000") << "uniform";
+    QTest::newRow("exponential mean 500") << "exponential";
+}
+
+void TestLatencyHistogram::testPercentiles()
+{
+    QFETCH(QString, distribution);
+
+    std::mt19937_64 rng(42);
+    std::vector<int64_t> values(200000);
+    if (distribution == "uniform") {
+        std::uniform_int_distribution<int64_t> dist(1, 100000);
+        for (auto& v : values) v = dist(rng);
+    } else {
+        std::exponential_distribution<double> dist(1.0 / 500);
+        for (auto& v : values) v = static_cast<int64_t>(dist(rng));
+    }
+
+    LatencyHistogram histogram;
+    for (int64_t v : values) histogram.record(v);
+    const auto snap = histogram.snapshot();
+
+    std::sort(values.begin(), values.end());
+    auto exact = [&](double q) {
+        return values[static_cast<size_t>(std::ceil(q * values.size())) - 1];
+    };
+    auto within = [](int64_t reported, int64_t expected) {
+        return std::abs(reported - expected) <= std::max<int64_t>(1, expected * 0.035);
+    };
+
+    QCOMPARE(snap.count, uint64_t(values.size()));
+    QCOMPARE(snap.min, values.front());
+    QCOMPARE(snap.max, values.back());
+    QVERIFY2(within(snap.p50, exact(0.50)), qPrintable(QString::number(snap.p50)));
+    QVERIFY2(within(snap.p90, exact(0.90)), qPrintable(QString::number(snap.p90)));
+    QVERIFY2(within(snap.p99, exact(0.99)), qPrintable(QString::number(snap.p99)));
+    QVERIFY2(within(snap.p999, exact(0.999)), qPrintable(QString::number(snap.p999)));
+
+    const double mean = std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+    QVERIFY(std::abs(snap.mean - mean) < 0.01);
+}
+
+void TestLatencyHistogram::testSingleValueAndEmpty()
+{
+    LatencyHistogram histogram;
+    auto snap = histogram.snapshot();
+    QCOMPARE(snap.count, uint64_t(0));
+    QCOMPARE(snap.p99, int64_t(0));
+
+    // Percentiles never exceed the recorded max
+    histogram.record(1000);
+    snap = histogram.snapshot();
+    QCOMPARE(snap.p50, int64_t(1000));
+    QCOMPARE(snap.p999, int64_t(1000));
+    QCOMPARE(snap.min, int64_t(1000));
+
+    // Clamped at kMaxValue
+    histogram.record(LatencyHistogram::kMaxValue * 4);
+    QCOMPARE(histogram.snapshot().max, LatencyHistogram::kMaxValue);
+}
+
+// ─── Recording ───────────────────────────────────────────
+
+void TestLatencyHistogram::testConcurrentRecord()
+{
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 100000;
+
+    LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&histogram, t] {
+            for (int i = 0; i < kPerThread; ++i)
+                histogram.record(t * 1000 + i % 1000);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    const auto snap = histogram.snapshot();
+    QCOMPARE(snap.count, uint64_t(kThreads * kPerThread));
+    QCOMPARE(snap.min, int64_t(0));
+    QCOMPARE(snap.max, int64_t((kThreads - 1) * 1000 + 999));
+}
+
+void TestLatencyHistogram::testNegativeSamplesAndReset()
+{
+    LatencyHistogram histogram;
+    histogram.record(-5);
+    histogram.record(-1);
+    histogram.record(10);
+
+    auto snap = histogram.snapshot();
+    QCOMPARE(snap.negative, uint64_t(2));
+    QCOMPARE(snap.count, uint64_t(1));
+    QCOMPARE(snap.min, int64_t(10));
+
+    histogram.reset();
+    snap = histogram.snapshot();
+    QCOMPARE(snap.negative, uint64_t(0));
+    QCOMPARE(snap.count, uint64_t(0));
+    QCOMPARE(snap.max, int64_t(0));
+}
+
+void TestLatencyHistogram::testIntervalSnapshot()
+{
+    LatencyHistogram histogram;
+    LatencyHistogram::Totals since;
+    for (int i = 0; i < 100; ++i) histogram.record(5000);
+
+    auto snap = histogram.snapshotSince(since);
+    QCOMPARE(snap.count, uint64_t(100));
+    QVERIFY(std::abs(snap.p50 - 5000) <= 5000 * 0.04);
+
+    // Next interval: only the new, faster samples
+    for (int i = 0; i < 10; ++i) histogram.record(20);
+    histogram.record(-3);
+    snap = histogram.snapshotSince(since);
+    QCOMPARE(snap.count, uint64_t(10));
+    QCOMPARE(snap.negative, uint64_t(1));
+    QCOMPARE(snap.min, int64_t(20));
+    QCOMPARE(snap.max, int64_t(20));
+    QCOMPARE(snap.p99, int64_t(20));
+    QCOMPARE(snap.mean, 20.0);
+    QCOMPARE(histogram.snapshot().count, uint64_t(110));
+
+    QCOMPARE(histogram.snapshotSince(since).count, uint64_t(0));
+
+    // A reset restarts the interval
+    histogram.reset();
+    histogram.record(7);
+    snap = histogram.snapshotSince(since);
+    QCOMPARE(snap.count, uint64_t(1));
+    QCOMPARE(snap.p50, int64_t(7));
+}
+
+// ─── Stage report ────────────────────────────────────────
+
+void TestLatencyHistogram::testStageRecording()
+{
+    using Stage = LatencyTracker::Stage;
+
+    // NSEFO tick: recv 1000, parsed 1010, emitted 1030, FeedHandler 1100
+    LatencyTracker::recordFeedStages(2, 1000, 1010, 1030, 1100);
+    LatencyTracker::recordModelUpdate(2, 1000, 1100, 1500);
+    // BSEFO tick without parse/emit stamps: only the stages it has
+    LatencyTracker::recordFeedStages(12, 0, 0, 0, 2000);
+    LatencyTracker::recordModelUpdate(12, 1900, 2000, 2050);
+
+    QCOMPARE(LatencyTracker::histogram(2, Stage::Parse).snapshot().max, int64_t(10));
+    QCOMPARE(LatencyTracker::histogram(2, Stage::Publish).snapshot().max, int64_t(20));
+    QCOMPARE(LatencyTracker::histogram(2, Stage::Dispatch).snapshot().max, int64_t(70));
+    QCOMPARE(LatencyTracker::histogram(2, Stage::Model).snapshot().max, int64_t(400));
+    QCOMPARE(LatencyTracker::histogram(2, Stage::EndToEnd).snapshot().max, int64_t(500));
+    QCOMPARE(LatencyTracker::histogram(12, Stage::Parse).snapshot().count, uint64_t(0));
+    QCOMPARE(LatencyTracker::histogram(12, Stage::EndToEnd).snapshot().max, int64_t(150));
+
+    // Report lists only stages with samples, segment order then stage order
+    const auto rows = LatencyTracker::report();
+    QCOMPARE(rows.size(), size_t(7));
+    QCOMPARE(rows.front().segment, 2);
+    QCOMPARE(rows.front().stage, Stage::Parse);
+    QCOMPARE(rows.back().segment, 12);
+    QCOMPARE(rows.back().stage, Stage::EndToEnd);
+}
+
+void TestLatencyHistogram::testCsvAndJson()
+{
+    LatencyTracker::recordModelUpdate(1, 100, 150, 400);
+
+    const QStringList lines = LatencyTracker::toCsv().split('\n', QString::SkipEmptyParts);
+    QCOMPARE(lines.size(), 3);  // Header + Model + EndToEnd
+    QVERIFY(lines[0].startsWith("time,segment,stage,count"));
+    const QStringList fields = lines[2].split(',');
+    QCOMPARE(fields[1], QString("NSECM"));
+    QCOMPARE(fields[2], QString("EndToEnd"));
+    QCOMPARE(fields[3], QString("1"));
+    QCOMPARE(fields[10], QString("300"));  // max_us
+    QCOMPARE(LatencyTracker::toCsv(false).split('\n', QString::SkipEmptyParts).size(), 2);
+
+    const QJsonObject root = QJsonDocument::fromJson(LatencyTracker::toJson()).object();
+    QCOMPARE(root["clock"].toString(), QString("steady_us"));
+    const QJsonArray stages = root["stages"].toArray();
+    QCOMPARE(stages.size(), 2);
+    QCOMPARE(stages[0].toObject()["stage"].toString(), QString("Model"));
+    QCOMPARE(stages[0].toObject()["p50_us"].toInt(), 250);
+}
+
+void TestLatencyHistogram::testWriteDump()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    LatencyTracker::recordModelUpdate(2, 100, 150, 400);
+
+    // Two dumps: CSV gets one header and two blocks of rows
+    QVERIFY(LatencyTracker::writeDump(dir.path() + "/latency"));
+    QVERIFY(LatencyTracker::writeDump(dir.path() + "/latency"));
+
+    QDir dumpDir(dir.path() + "/latency");
+    const QStringList csvFiles = dumpDir.entryList({"latency_*.csv"}, QDir::Files);
+    QCOMPARE(csvFiles.size(), 1);
+    QFile csv(dumpDir.filePath(csvFiles.first()));
+    QVERIFY(csv.open(QIODevice::ReadOnly | QIODevice::Text));
+    const QStringList lines = QString::fromUtf8(csv.readAll()).split('\n', QString::SkipEmptyParts);
+    QCOMPARE(lines.size(), 1 + 2 * 2);
+    QCOMPARE(lines.filter("time,segment").size(), 1);
+
+    QVERIFY(dumpDir.exists("latency_latest.json"));
+}
+
+void TestLatencyHistogram::testWriteIntervalDump()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    LatencyTracker::intervalReport(); // Start the interval here
+    LatencyTracker::recordModelUpdate(2, 100, 150, 400);
+
+    // The second dump has nothing new: header + one block of two rows
+    QVERIFY(LatencyTracker::writeDump(dir.path(), true));
+    QVERIFY(LatencyTracker::writeDump(dir.path(), true));
+
+    QDir dumpDir(dir.path());
+    const QStringList csvFiles = dumpDir.entryList({"latency_*.csv"}, QDir::Files);
+    QCOMPARE(csvFiles.size(), 1);
+    QFile csv(dumpDir.filePath(csvFiles.first()));
+    QVERIFY(csv.open(QIODevice::ReadOnly | QIODevice::Text));
+    const QStringList lines = QString::fromUtf8(csv.readAll()).split('\n', QString::SkipEmptyParts);
+    QCOMPARE(lines.size(), 1 + 2);
+
+    QFile json(dumpDir.filePath("latency_latest.json"));
+    QVERIFY(json.open(QIODevice::ReadOnly));
+    const QJsonObject root = QJsonDocument::fromJson(json.readAll()).object();
+    QCOMPARE(root["window"].toString(), QString("interval"));
+    QVERIFY(root["stages"].toArray().isEmpty());
+
+    // Cumulative report still has every sample
+    QCOMPARE(LatencyTracker::report().size(), size_t(2));
+}
+
+// ─── Benchmark ───────────────────────────────────────────
+
+void TestLatencyHistogram::benchmarkRecord()
+{
+    constexpr int kSamples = 1000000;
+    std::vector<int64_t> values(kSamples);
+    std::mt19937_64 rng(7);
+    std::exponential_distribution<double> dist(1.0 / 300);
+    for (auto& v : values) v = static_cast<int64_t>(dist(rng));
+
+    LatencyHistogram histogram;
+    QElapsedTimer timer;
+    qint64 nanos = 0;
+    QBENCHMARK {
+        timer.start();
+        for (int64_t v : values) histogram.record(v);
+        nanos = timer.nsecsElapsed();
+    }
+
+    qDebug().nospace() << "record(): " << kSamples << " samples in " << nanos / 1000
+                       << " us (" << double(nanos) / kSamples << " ns/sample)";
+    QVERIFY(histogram.snapshot().count >= uint64_t(kSamples));
+}
+
+QTEST_MAIN(TestLatencyHistogram)
+#include "test_latency_histogram.moc"
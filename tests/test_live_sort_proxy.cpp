@@ -0,0 +1,397 @@
+/**
+ * @file test_live_sort_proxy.cpp
+ * @brief Unit tests for LiveSortProxyModel — incremental re-sort of live rows
+ *
+ * Tests:
+ *  - Order matches a full stable sort (numeric / text column, both orders)
+ *  - Filter / summary rows stay first / last in either order
+ *  - A tick that does not move its row causes no layout change; a mover is
+ *    re-positioned and persistent indexes follow it
+ *  - Re-ordering is rate-limited to the reorder interval; 0 is immediate
+ *  - Rows inserted / removed on a sorted view land in / leave sorted order
+ *  - Benchmark: 1k / 5k rows, 200 price ticks per interval,
+ *    PinnedRowProxyModel (dynamic QSortFilterProxyModel) vs LiveSortProxyModel
+ *
+ * Build: Requires Qt5::Core, Qt5::Test
+ */
+
+#include <QtTest/QtTest>
+#include <QAbstractTableModel>
+#include <QElapsedTimer>
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "models/qt/LiveSortProxyModel.h"
+#include "models/qt/PinnedRowProxyModel.h"
+
+namespace {
+
+// Symbol / LTP table; optional filter row on top and summary row at the end,
+// tagged through UserRole like PositionModel
+class TickModel : public QAbstractTableModel
+{
+public:
+    enum Column { Symbol = 0, Ltp, ColumnCount };
+
+    explicit TickModel(int rows, bool pinned = false, unsigned seed = 1)
+        : m_pinned(pinned)
+    {
+        std::mt19937 rng(seed);
+        for (int i = 0; i < rows; ++i) {
+            m_symbols.push_back(QString("SYM%1").arg(rng() % 1000, 4, 10, QChar('0')));
+            m_ltps.push_back(100.0 + (rng() % 100000) / 100.0);
+        }
+    }
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : static_cast<int>(m_ltps.size()) + (m_pinned ? 2 : 0);
+    }
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : ColumnCount;
+    }
+
+    QVariant data(const QModelIndex &index, int role) const override
+    {
+        if (!index.isValid()) return QVariant();
+        if (m_pinned && index.row() == 0)
+            return role == Qt::UserRole ? QVariant("FILTER_ROW") : QVariant();
+        if (m_pinned && index.row() == rowCount() - 1)
+            return role == Qt::UserRole ? QVariant("SUMMARY_ROW") : QVariant();
+
+        const int i = dataRow(index.row());
+        if (role == Qt::UserRole)
+            return index.column() == Symbol ? QVariant(m_symbols[i]) : QVariant(m_ltps[i]);
+        if (role == Qt::DisplayRole)
+            return index.column() == Symbol ? m_symbols[i] : QString::number(m_ltps[i], 'f', 2);
+        return QVariant();
+    }
+
+    double ltp(int row) const { return m_ltps[dataRow(row)]; }
+    QString symbol(int row) const { return m_symbols[dataRow(row)]; }
+
+    void setLtp(int row, double ltp)
+    {
+        m_ltps[dataRow(row)] = ltp;
+        emit dataChanged(index(row, Ltp), index(row, Ltp));
+    }
+
+    void insertTicks(int row, const std::vector<double> &ltps)
+    {
+        const int count = static_cast<int>(ltps.size());
+        beginInsertRows(QModelIndex(), row, row + count - 1);
+        for (int k = 0; k < count; ++k) {
+            m_ltps.insert(m_ltps.begin() + dataRow(row) + k, ltps[k]);
+            m_symbols.insert(m_symbols.begin() + dataRow(row) + k, QString("NEW%1").arg(k));
+        }
+        endInsertRows();
+    }
+
+    void removeTicks(int row, int count)
+    {
+        beginRemoveRows(QModelIndex(), row, row + count - 1);
+        m_ltps.erase(m_ltps.begin() + dataRow(row), m_ltps.begin() + dataRow(row) + count);
+        m_symbols.erase(m_symbols.begin() + dataRow(row), m_symbols.begin() + dataRow(row) + count);
+        endRemoveRows();
+    }
+
+private:
+    int dataRow(int row) const { return m_pinned ? row - 1 : row; }
+
+    bool m_pinned;
+    std::vector<QString> m_symbols;
+    std::vector<double> m_ltps;
+};
+
+// Source rows in proxy order
+std::vector<int> proxyOrder(const QAbstractProxyModel &proxy)
+{
+    std::vector<int> rows;
+    for (int row = 0; row < proxy.rowCount(); ++row)
+        rows.push_back(proxy.mapToSource(proxy.index(row, 0)).row());
+    return rows;
+}
+
+// Full stable sort of the unpinned rows, ties by source row
+std::vector<int> expectedOrder(const TickModel &model, int column, Qt::SortOrder order,
+                               bool pinned)
+{
+    const int rows = model.rowCount();
+    std::vector<int> body;
+    for (int row = pinned ? 1 : 0; row < (pinned ? rows - 1 : rows); ++row) body.push_back(row);
+    std::stable_sort(body.begin(), body.end(), [&](int l, int r) {
+        if (column == TickModel::Ltp) {
+            return order == Qt::AscendingOrder ? model.ltp(l) < model.ltp(r)
+                                               : model.ltp(l) > model.ltp(r);
+        }
+        const int cmp = QString::compare(model.symbol(l), model.symbol(r));
+        return order == Qt::AscendingOrder ? cmp < 0 : cmp > 0;
+    });
+    if (pinned) {
+        body.insert(body.begin(), 0);
+        body.push_back(rows - 1);
+    }
+    return body;
+}
+
+} // namespace
+
+class TestLiveSortProxy : public QObject {
+    Q_OBJECT
+
+private slots:
+    // ─── Ordering ───
+    void testSortMatchesFullSort_data();
+    void testSortMatchesFullSort();
+    void testPinnedRowsStayFixed();
+
+    // ─── Live updates ───
+    void testOnlyMoversReposition();
+    void testReorderIsRateLimited();
+    void testInsertRemoveWhileSorted();
+
+    // ─── Benchmarks ───
+    void benchmarkTickReorder_data();
+    void benchmarkTickReorder();
+};
+
+// ─── Ordering ────────────────────────────────────────────
+
+void TestLiveSortProxy::testSortMatchesFullSort_data()
+{
+    QTest::addColumn<int>("column");
+    QTest::addColumn<int>("order");
+
+    QTest::newRow("ltp ascending") << int(TickModel::Ltp) << int(Qt::AscendingOrder);
+    QTest::newRow("ltp descending") << int(TickModel::Ltp) << int(Qt::DescendingOrder);
+    QTest::newRow("symbol ascending") << int(TickModel::Symbol) << int(Qt::AscendingOrder);
+    QTest::newRow("symbol descending") << int(TickModel::Symbol) << int(Qt::DescendingOrder);
+}
+
+void TestLiveSortProxy::testSortMatchesFullSort()
+{
+    QFETCH(int, column);
+    QFETCH(int, order);
+
+    TickModel model(500);
+    LiveSortProxyModel proxy;
+    proxy.setSourceModel(&model);
+
+    // Unsorted: source order
+    std::vector<int> identity(500);
+    std::iota(identity.begin(), identity.end(), 0);
+    QCOMPARE(proxyOrder(proxy), identity);
+
+    proxy.sort(column, Qt::SortOrder(order));
+    QCOMPARE(proxyOrder(proxy), expectedOrder(model, column, Qt::SortOrder(order), false));
+
+    // mapFromSource is the inverse
+    for (int row = 0; row < model.rowCount(); ++row)
+        QCOMPARE(proxy.mapToSource(proxy.mapFromSource(model.index(row, 1))).row(), row);
+
+    proxy.sort(-1);
+    QCOMPARE(proxyOrder(proxy), identity);
+}
+
+void TestLiveSortProxy::testPinnedRowsStayFixed()
+{
+    TickModel model(100, true);
+    LiveSortProxyModel proxy;
+    proxy.setReorderInterval(0);
+    proxy.setSourceModel(&model);
+
+    for (Qt::SortOrder order : {Qt::AscendingOrder, Qt::DescendingOrder}) {
+        proxy.sort(TickModel::Ltp, order);
+        QCOMPARE(proxyOrder(proxy), expectedOrder(model, TickModel::Ltp, order, true));
+        QCOMPARE(proxy.index(0, 0).data(Qt::UserRole).toString(), QString("FILTER_ROW"));
+        QCOMPARE(proxy.index(proxy.rowCount() - 1, 0).data(Qt::UserRole).toString(),
+                 QString("SUMMARY_ROW"));
+
+        // Extreme ticks move to the body's edges, not past the pinned rows
+        model.setLtp(5, 1e9);
+        model.setLtp(6, -1e9);
+        QCOMPARE(proxyOrder(proxy), expectedOrder(model, TickModel::Ltp, order, true));
+        QCOMPARE(proxyOrder(proxy).front(), 0);
+        QCOMPARE(proxyOrder(proxy).back(), model.rowCount() - 1);
+    }
+}
+
+// ─── Live updates ────────────────────────────────────────
+
+void TestLiveSortProxy::testOnlyMoversReposition()
+{
+    TickModel model(200);
+    LiveSortProxyModel proxy;
+    proxy.setReorderInterval(-1); // Manual reorder()
+    proxy.setSourceModel(&model);
+    proxy.sort(TickModel::Ltp, Qt::AscendingOrder);
+
+    QSignalSpy layouts(&proxy, &QAbstractItemModel::layoutChanged);
+    QSignalSpy resets(&proxy, &QAbstractItemModel::modelReset);
+    QSignalSpy changes(&proxy, &QAbstractItemModel::dataChanged);
+
+    // Same key: repainted, not moved
+    const int source = 42;
+    model.setLtp(source, model.ltp(source));
+    QCOMPARE(changes.count(), 1);
+    QCOMPARE(proxy.pendingRows(), 1);
+    proxy.reorder();
+    QCOMPARE(layouts.count(), 0);
+    QCOMPARE(proxy.pendingRows(), 0);
+
+    // Mover: one layout change, persistent index follows the row
+    QPersistentModelIndex tracked = proxy.mapFromSource(model.index(source, TickModel::Ltp));
+    QVERIFY(tracked.isValid());
+    model.setLtp(source, 1e6);
+    QCOMPARE(changes.last().at(0).value<QModelIndex>().row(), tracked.row()); // Painted in place
+    proxy.reorder();
+    QCOMPARE(layouts.count(), 1);
+    QCOMPARE(resets.count(), 0);
+    QCOMPARE(tracked.row(), proxy.rowCount() - 1);
+    QCOMPARE(proxy.mapToSource(tracked).row(), source);
+    QCOMPARE(proxyOrder(proxy), expectedOrder(model, TickModel::Ltp, Qt::AscendingOrder, false));
+
+    // A burst over much of the table still ends in sorted order
+    std::mt19937 rng(3);
+    for (int i = 0; i < 150; ++i) model.setLtp(int(rng() % 200), 100.0 + rng() % 1000);
+    proxy.reorder();
+    QCOMPARE(proxyOrder(proxy), expectedOrder(model, TickModel::Ltp, Qt::AscendingOrder, false));
+    QCOMPARE(proxy.mapToSource(tracked).row(), source);
+
+    // Ticks on another column never dirty the sort
+    proxy.sort(TickModel::Symbol, Qt::AscendingOrder);
+    model.setLtp(7, 1.0);
+    QCOMPARE(proxy.pendingRows(), 0);
+}
+
+void TestLiveSortProxy::testReorderIsRateLimited()
+{
+    TickModel model(50);
+    LiveSortProxyModel proxy;
+    proxy.setSourceModel(&model);
+    proxy.setReorderInterval(30);
+    proxy.sort(TickModel::Ltp, Qt::DescendingOrder);
+
+    QSignalSpy layouts(&proxy, &QAbstractItemModel::layoutChanged);
+    for (int i = 0; i < 10; ++i) model.setLtp(i, 5000.0 + i);
+
+    // Values visible now, order only after the interval, in one pass
+    QCOMPARE(proxy.pendingRows(), 10);
+    QCOMPARE(layouts.count(), 0);
+    QTRY_COMPARE_WITH_TIMEOUT(proxy.pendingRows(), 0, 2000);
+    QCOMPARE(layouts.count(), 1);
+    QCOMPARE(proxyOrder(proxy), expectedOrder(model, TickModel::Ltp, Qt::DescendingOrder, false));
+
+    proxy.setReorderInterval(0);
+    model.setLtp(20, -1.0);
+    QCOMPARE(proxy.pendingRows(), 0);
+    QCOMPARE(proxyOrder(proxy).back(), 20);
+}
+
+void TestLiveSortProxy::testInsertRemoveWhileSorted()
+{
+    TickModel model(100, true);
+    LiveSortProxyModel proxy;
+    proxy.setReorderInterval(0);
+    proxy.setSourceModel(&model);
+    proxy.sort(TickModel::Ltp, Qt::AscendingOrder);
+
+    QSignalSpy inserted(&proxy, &QAbstractItemModel::rowsInserted);
+    QSignalSpy resets(&proxy, &QAbstractItemModel::modelReset);
+
+    model.insertTicks(10, {1.0, 99999.0, 550.0});
+    QCOMPARE(proxy.rowCount(), model.rowCount());
+    QCOMPARE(inserted.count(), 3); // Each in its own sorted place
+    QCOMPARE(resets.count(), 0);
+    QCOMPARE(proxyOrder(proxy), expectedOrder(model, TickModel::Ltp, Qt::AscendingOrder, true));
+    QCOMPARE(proxy.index(1, TickModel::Ltp).data(Qt::UserRole).toDouble(), 1.0);
+
+    model.removeTicks(20, 5);
+    QCOMPARE(proxy.rowCount(), model.rowCount());
+    QCOMPARE(proxyOrder(proxy), expectedOrder(model, TickModel::Ltp, Qt::AscendingOrder, true));
+
+    // Live updates keep working on the renumbered rows
+    model.setLtp(50, 0.5);
+    QCOMPARE(proxyOrder(proxy)[1], 50);
+
+    // Bulk insert: one reset instead of row-by-row placement
+    model.insertTicks(1, std::vector<double>(200, 42.0));
+    QCOMPARE(resets.count(), 1);
+    QCOMPARE(proxyOrder(proxy), expectedOrder(model, TickModel::Ltp, Qt::AscendingOrder, true));
+}
+
+// ─── Benchmarks ──────────────────────────────────────────
+
+void TestLiveSortProxy::benchmarkTickReorder_data()
+{
+    QTest::addColumn<int>("rows");
+    QTest::addColumn<bool>("live");
+    for (int rows : {1000, 5000}) {
+        QTest::newRow(qPrintable(QString("PinnedRowProxyModel %1 rows").arg(rows))) << rows << false;
+        QTest::newRow(qPrintable(QString("LiveSortProxyModel %1 rows").arg(rows))) << rows << true;
+    }
+}
+
+void TestLiveSortProxy::benchmarkTickReorder()
+{
+    QFETCH(int, rows);
+    QFETCH(bool, live);
+
+    // A position book sorted on LTP with a filter and a summary row; 200
+    // rows tick per interval (one reorder interval for the live proxy, which
+    // the dynamic QSortFilterProxyModel re-sorts per tick)
+    constexpr int kTicksPerInterval = 200;
+    constexpr int kIntervals = 20;
+
+    TickModel model(rows, true);
+    std::unique_ptr<QAbstractProxyModel> proxy;
+    LiveSortProxyModel *liveProxy = nullptr;
+    if (live) {
+        liveProxy = new LiveSortProxyModel;
+        liveProxy->setReorderInterval(-1); // The timer's pass, driven below
+        proxy.reset(liveProxy);
+    } else {
+        auto *pinned = new PinnedRowProxyModel;
+        pinned->setSortRole(Qt::UserRole);
+        proxy.reset(pinned);
+    }
+    proxy->setSourceModel(&model);
+    proxy->sort(TickModel::Ltp, Qt::DescendingOrder);
+
+    std::mt19937 rng(11);
+    std::vector<std::pair<int, double>> ticks;
+    for (int i = 0; i < kTicksPerInterval * kIntervals; ++i) {
+        const int row = 1 + int(rng() % rows);
+        ticks.emplace_back(row, model.ltp(row) * (0.99 + (rng() % 200) / 10000.0));
+    }
+
+    QElapsedTimer timer;
+    qint64 elapsedNs = 0;
+    QBENCHMARK {
+        timer.start();
+        size_t next = 0;
+        for (int n = 0; n < kIntervals; ++n) {
+            for (int i = 0; i < kTicksPerInterval; ++i, ++next)
+                model.setLtp(ticks[next].first, ticks[next].second);
+            if (liveProxy) liveProxy->reorder();
+        }
+        elapsedNs = timer.nsecsElapsed();
+    }
+
+    qDebug().nospace() << (live ? "LiveSortProxyModel" : "PinnedRowProxyModel")
+                       << " rows=" << rows << " ticks/interval=" << kTicksPerInterval
+                       << " us/interval=" << double(elapsedNs) / kIntervals / 1000.0;
+
+    // Both end sorted (tie order differs: QSortFilterProxyModel reverses it)
+    const std::vector<int> order = proxyOrder(*proxy);
+    QCOMPARE(order.front(), 0);
+    QCOMPARE(order.back(), model.rowCount() - 1);
+    for (size_t i = 2; i + 1 < order.size(); ++i)
+        QVERIFY(model.ltp(order[i - 1]) >= model.ltp(order[i]));
+}
+
+QTEST_MAIN(TestLiveSortProxy)
+#include "test_live_sort_proxy.moc"
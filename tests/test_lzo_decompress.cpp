@@ -0,0 +1,240 @@
+/**
+ * @file test_lzo_decompress.cpp
+ * @brief Unit tests + microbenchmark for common::LzoDecompressor
+ *
+ * Tests:
+ *  - decompressInto round-trip on NSE-shaped compressed payloads
+ *  - Error codes (truncated input, small output buffer, bad arguments)
+ *  - Per-thread scratch arena (alignment, reuse, isolation)
+ *  - Parity with the vector/exception based decompressWithLibrary
+ *
+ * Benchmarks (run with -tickcounter or -iterations N):
+ *  - benchmarkVectorPath:    old parse_compressed_message path (vector copy
+ *                            of input + 64 KB output vector per message)
+ *  - benchmarkDecompressInto: span API into the thread-local scratch arena
+ *
+ * Payloads are produced with lzo1z_999_compress (the encoder NSE uses) from
+ * synthetic 7200/7208-sized broadcast messages: 8-byte compression prefix,
+ * BCAST_HEADER and mostly-repeating price/quantity fields.
+ *
+ * Build: Requires Qt5::Core, Qt5::Test, common_lzo
+ */
+
+#include <QtTest/QtTest>
+#include <QThread>
+#include <lzo/lzo1z.h>
+#include <cstring>
+#include <vector>
+#include "lzo_decompress.h"
+
+using common::LzoDecompressor;
+using common::LzoError;
+
+// ─── Payload helpers ─────────────────────────────────────
+
+namespace {
+
+std::vector<uint8_t> makeBroadcastMessage(size_t size, uint32_t seed)
+{
+    std::vector<uint8_t> msg(size, 0);
+    // BCAST_HEADER transaction code (offset 8 + 10), big-endian 7208
+    msg[18] = 0x1C;
+    msg[19] = 0x28;
+    // Token + price ladder: repeating 4-byte fields with small deltas
+    for (size_t off = 48; off + 4 <= size; off += 12) {
+        uint32_t v = seed + static_cast<uint32_t>(off / 12) * 5;
+        std::memcpy(msg.data() + off, &v, sizeof(v));
+    }
+    return msg;
+}
+
+std::vector<uint8_t> compressLzo1z(const std::vector<uint8_t>& raw)
+{
+    std::vector<uint8_t> out(raw.size() + raw.size() / 16 + 64 + 3);
+    std::vector<uint8_t> wrkmem(LZO1Z_999_MEM_COMPRESS);
+    lzo_uint outLen = out.size();
+    if (lzo_init() != LZO_E_OK ||
+        lzo1z_999_compress(raw.data(), raw.size(), out.data(), &outLen, wrkmem.data()) != LZO_E_OK) {
+        return {};
+    }
+    out.resize(outLen);
+    return out;
+}
+
+} // namespace
+
+// ─── Test Class ──────────────────────────────────────────
+
+class TestLzoDecompress : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    // Correctness
+    void testRoundTrip();
+    void testMatchesLibraryPath();
+    void testTruncatedInput_returnsError();
+    void testOutputTooSmall_returnsOverrun();
+    void testInvalidArguments();
+    void testErrorString();
+
+    // Scratch arena
+    void testScratchAlignedAndReused();
+    void testScratchPerThread();
+
+    // Benchmarks
+    void benchmarkVectorPath();
+    void benchmarkDecompressInto();
+
+private:
+    std::vector<std::vector<uint8_t>> m_raw;
+    std::vector<std::vector<uint8_t>> m_compressed;
+};
+
+void TestLzoDecompress::initTestCase()
+{
+    // Mix of 7208 (2 records), 7200 and 7202-sized messages
+    const size_t sizes[] = { 8 + 40 + 428, 8 + 40 + 396, 8 + 40 + 172 };
+    for (uint32_t i = 0; i < 256; ++i) {
+        auto raw = makeBroadcastMessage(sizes[i % 3], 2450000 + i * 5);
+        auto comp = compressLzo1z(raw);
+        QVERIFY(!comp.empty());
+        m_raw.push_back(std::move(raw));
+        m_compressed.push_back(std::move(comp));
+    }
+}
+
+// ─── Correctness ─────────────────────────────────────────
+
+void TestLzoDecompress::testRoundTrip()
+{
+    uint8_t* out = LzoDecompressor::scratch();
+    for (size_t i = 0; i < m_compressed.size(); ++i) {
+        const auto& comp = m_compressed[i];
+        int n = LzoDecompressor::decompressInto(comp.data(), comp.size(),
+                                                out, LzoDecompressor::kScratchSize);
+        QCOMPARE(n, static_cast<int>(m_raw[i].size()));
+        QVERIFY(std::memcmp(out, m_raw[i].data(), n) == 0);
+    }
+}
+
+void TestLzoDecompress::testMatchesLibraryPath()
+{
+    const auto& comp = m_compressed.front();
+    std::vector<uint8_t> legacyOut(65535);
+    int legacy = LzoDecompressor::decompressWithLibrary(comp, legacyOut);
+
+    uint8_t* out = LzoDecompressor::scratch();
+    int n = LzoDecompressor::decompressInto(comp.data(), comp.size(),
+                                            out, LzoDecompressor::kScratchSize);
+    QCOMPARE(n, legacy);
+    QVERIFY(std::memcmp(out, legacyOut.data(), n) == 0);
+}
+
+void TestLzoDecompress::testTruncatedInput_returnsError()
+{
+    const auto& comp = m_compressed.front();
+    uint8_t* out = LzoDecompressor::scratch();
+    int n = LzoDecompressor::decompressInto(comp.data(), comp.size() / 2,
+                                            out, LzoDecompressor::kScratchSize);
+    QVERIFY(n < 0);
+
+    // The legacy path still throws for the same input
+    std::vector<uint8_t> src(comp.begin(), comp.begin() + comp.size() / 2);
+    std::vector<uint8_t> dst(65535);
+    QVERIFY_EXCEPTION_THROWN(LzoDecompressor::decompressWithLibrary(src, dst), std::runtime_error);
+}
+
+void TestLzoDecompress::testOutputTooSmall_returnsOverrun()
+{
+    const auto& comp = m_compressed.front();
+    uint8_t small[64];
+    int n = LzoDecompressor::decompressInto(comp.data(), comp.size(), small, sizeof(small));
+    QCOMPARE(n, static_cast<int>(LzoError::OUTPUT_OVERRUN));
+}
+
+void TestLzoDecompress::testInvalidArguments()
+{
+    uint8_t* out = LzoDecompressor::scratch();
+    const auto& comp = m_compressed.front();
+    QCOMPARE(LzoDecompressor::decompressInto(nullptr, 10, out, 100),
+             static_cast<int>(LzoError::INVALID_ARGUMENT));
+    QCOMPARE(LzoDecompressor::decompressInto(comp.data(), 0, out, 100),
+             static_cast<int>(LzoError::INVALID_ARGUMENT));
+    QCOMPARE(LzoDecompressor::decompressInto(comp.data(), comp.size(), nullptr, 100),
+             static_cast<int>(LzoError::INVALID_ARGUMENT));
+    QCOMPARE(LzoDecompressor::decompressInto(comp.data(), comp.size(), out, 0),
+             static_cast<int>(LzoError::INVALID_ARGUMENT));
+}
+
+void TestLzoDecompress::testErrorString()
+{
+    QCOMPARE(QString(LzoDecompressor::errorString(0)), QString("OK"));
+    QVERIFY(QString(LzoDecompressor::errorString(
+        static_cast<int>(LzoError::LOOKBEHIND_OVERRUN))).contains("Lookbehind"));
+    QCOMPARE(QString(LzoDecompressor::errorString(-1000)), QString("Unknown error"));
+}
+
+// ─── Scratch arena ───────────────────────────────────────
+
+void TestLzoDecompress::testScratchAlignedAndReused()
+{
+    uint8_t* a = LzoDecompressor::scratch();
+    uint8_t* b = LzoDecompressor::scratch();
+    QCOMPARE(a, b);
+    QCOMPARE(reinterpret_cast<uintptr_t>(a) % 64, uintptr_t(0));
+}
+
+void TestLzoDecompress::testScratchPerThread()
+{
+    uint8_t* mainScratch = LzoDecompressor::scratch();
+    uint8_t* workerScratch = nullptr;
+    QThread* worker = QThread::create([&workerScratch]() {
+        workerScratch = LzoDecompressor::scratch();
+    });
+    worker->start();
+    QVERIFY(worker->wait(5000));
+    delete worker;
+
+    QVERIFY(workerScratch != nullptr);
+    QVERIFY(workerScratch != mainScratch);
+}
+
+// ─── Benchmarks ──────────────────────────────────────────
+
+void TestLzoDecompress::benchmarkVectorPath()
+{
+    size_t total = 0;
+    QBENCHMARK {
+        for (const auto& comp : m_compressed) {
+            // Mirrors the pre-decompressInto parse_compressed_message path
+            std::vector<uint8_t> input(comp.begin(), comp.end());
+            std::vector<uint8_t> output(65535);
+            try {
+                total += LzoDecompressor::decompressWithLibrary(input, output);
+            } catch (const std::exception&) {
+            }
+        }
+    }
+    QVERIFY(total > 0);
+}
+
+void TestLzoDecompress::benchmarkDecompressInto()
+{
+    size_t total = 0;
+    QBENCHMARK {
+        for (const auto& comp : m_compressed) {
+            uint8_t* out = LzoDecompressor::scratch();
+            int n = LzoDecompressor::decompressInto(comp.data(), comp.size(),
+                                                    out, LzoDecompressor::kScratchSize);
+            if (n > 0) total += n;
+        }
+    }
+    QVERIFY(total > 0);
+}
+
+// ─── Main ────────────────────────────────────────────────
+
+QTEST_MAIN(TestLzoDecompress)
+#include "test_lzo_decompress.moc"
@@ -13,9 +13,15 @@
  *  - Column profile switching
  *  - Signal emission
  *  - clearAll / overwrite
+ *  - Frame coalescing: merged dataChanged ranges, flush before row shifts
+ *  - Benchmark: ticks/s absorbed and signals emitted per flush interval
+ *  - Columnar storage: ScripData round trip, interned text, footprint vs
+ *    the previous QList<ScripData> layout
+ *  - Benchmark: data() cost of repainting one 50-row screen
  *
  * Build: Requires Qt5::Core, Qt5::Test, Qt5::Gui (for QColor in data())
- *        Compiles MarketWatchModel.cpp + MarketWatchColumnProfile.cpp
+ *        Compiles MarketWatchModel.cpp + ScripTable.cpp +
+ *        MarketWatchColumnProfile.cpp
  *        Provides a stub GreeksCalculationService singleton
  */
 
@@ -71,8 +77,10 @@ void GreeksCalculationService::loadNSEHolidays() {}
 // ─── Now the actual test ─────────────────────────────────
 
 #include <QtTest/QtTest>
+#include <QElapsedTimer>
 #include <QSignalSpy>
 #include "models/qt/MarketWatchModel.h"
+#include "utils/MemoryProfiler.h"
 
 // ─── Helpers ─────────────────────────────────────────────
 
@@ -100,6 +108,17 @@ ScripData makeFOScrip(const QString& symbol, int token, double strike,
     return s;
 }
 
+UDP::MarketTick makeTick(uint32_t token, double ltp) {
+    UDP::MarketTick tick;
+    tick.exchangeSegment = UDP::ExchangeSegment::NSECM;
+    tick.token = token;
+    tick.ltp = ltp;
+    tick.volume = 1000;
+    tick.bids[0].price = ltp - 0.05;
+    tick.asks[0].price = ltp + 0.05;
+    return tick;
+}
+
 } // anonymous namespace
 
 // ─── Test Class ──────────────────────────────────────────
@@ -180,6 +199,21 @@ private slots:
     // Scrip count
     void testScripCount_excludesBlanks();
 
+    // Frame coalescing
+    void testCoalesce_mergesRowsIntoRanges();
+    void testCoalesce_splitsColumnRuns();
+    void testCoalesce_flushesBeforeRowShift();
+    void testCoalesce_disableFlushesPending();
+    void benchmarkCoalescedTicks_data();
+    void benchmarkCoalescedTicks();
+
+    // Columnar storage
+    void testColumnar_roundTrip();
+    void testColumnar_internsSharedText();
+    void testColumnar_footprintBelowLegacy();
+    void benchmarkRepaintCost_data();
+    void benchmarkRepaintCost();
+
 private:
     MarketWatchModel* m_model = nullptr;
 };
@@ -664,6 +698,338 @@ void TestMarketWatchModel::testScripCount_excludesBlanks() {
     QCOMPARE(m_model->totalRowCount(), 5);
 }
 
+// ─── Frame Coalescing ────────────────────────────────────
+
+void TestMarketWatchModel::testCoalesce_mergesRowsIntoRanges() {
+    for (int i = 1; i <= 10; ++i)
+        m_model->addScrip(makeScrip(QString("S%1").arg(i), i));
+    m_model->setCoalesceInterval(16);
+
+    QSignalSpy spy(m_model, &QAbstractTableModel::dataChanged);
+
+    // 3 ticks each on rows 2..5, one on row 8 — nothing emitted yet
+    for (int round = 0; round < 3; ++round) {
+        for (int row = 2; row <= 5; ++row)
+            m_model->updateFromUdpTick(row, makeTick(row + 1, 100.0 + round), 1.0, 1.0);
+    }
+    m_model->updateFromUdpTick(8, makeTick(9, 50.0), 0.5, 1.0);
+    QCOMPARE(spy.count(), 0);
+    QCOMPARE(m_model->pendingRowCount(), 5);
+
+    // Data is already current; only the notification is deferred
+    QCOMPARE(m_model->getScripAt(3).ltp, 102.0);
+
+    m_model->flushPendingUpdates();
+    QCOMPARE(spy.count(), 2);   // rows 2..5 as one range, row 8 alone
+    const int lastCol = m_model->columnCount() - 1;
+    auto first = spy.at(0);
+    QCOMPARE(first.at(0).toModelIndex().row(), 2);
+    QCOMPARE(first.at(1).toModelIndex().row(), 5);
+    QCOMPARE(first.at(0).toModelIndex().column(), 0);
+    QCOMPARE(first.at(1).toModelIndex().column(), lastCol);
+    QCOMPARE(spy.at(1).at(0).toModelIndex().row(), 8);
+    QCOMPARE(m_model->pendingRowCount(), 0);
+
+    // Nothing dirty: flush is a no-op
+    m_model->flushPendingUpdates();
+    QCOMPARE(spy.count(), 2);
+}
+
+void TestMarketWatchModel::testCoalesce_splitsColumnRuns() {
+    m_model->loadProfile("Detailed");
+    auto visibleIndex = [this](MarketWatchColumn col) {
+        const QString name = MarketWatchColumnProfile::getColumnInfo(col).name;
+        for (int i = 0; i < m_model->columnCount(); ++i) {
+            if (m_model->headerData(i, Qt::Horizontal).toString() == name)
+                return i;
+        }
+        return -1;
+    };
+    const int volumeCol = visibleIndex(MarketWatchColumn::VOLUME);
+    const int oiCol = visibleIndex(MarketWatchColumn::OPEN_INTEREST);
+    QVERIFY(volumeCol >= 0 && oiCol >= 0);
+    QVERIFY(qAbs(volumeCol - oiCol) > 1);   // Two separate runs
+
+    m_model->addScrip(makeScrip("A", 1));
+    m_model->addScrip(makeScrip("B", 2));
+    m_model->setCoalesceInterval(50);
+
+    QSignalSpy spy(m_model, &QAbstractTableModel::dataChanged);
+    m_model->updateVolume(0, 500);
+    m_model->updateOpenInterest(0, 1200);
+    m_model->updateVolume(0, 600);          // Same cell again: no extra signal
+    m_model->updateVolume(1, 700);
+    m_model->flushPendingUpdates();
+
+    // Row 0 {volume, oi} and row 1 {volume} differ, so no row merge:
+    // one single-cell signal per run
+    QCOMPARE(spy.count(), 3);
+    QSet<QPair<int, int>> cells;
+    for (const auto& args : spy) {
+        QModelIndex tl = args.at(0).toModelIndex();
+        QModelIndex br = args.at(1).toModelIndex();
+        QCOMPARE(tl, br);
+        cells.insert({tl.row(), tl.column()});
+    }
+    QVERIFY(cells.contains({0, volumeCol}));
+    QVERIFY(cells.contains({0, oiCol}));
+    QVERIFY(cells.contains({1, volumeCol}));
+}
+
+void TestMarketWatchModel::testCoalesce_flushesBeforeRowShift() {
+    m_model->addScrip(makeScrip("A", 1));
+    m_model->addScrip(makeScrip("B", 2));
+    m_model->addScrip(makeScrip("C", 3));
+    m_model->setCoalesceInterval(100);
+
+    QSignalSpy spy(m_model, &QAbstractTableModel::dataChanged);
+    m_model->updateFromUdpTick(2, makeTick(3, 10.0), 0.0, 0.0);
+
+    // Removing row 0 shifts C from row 2 to row 1: the pending
+    // range must be emitted against the old index first
+    m_model->removeScrip(0);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(0).toModelIndex().row(), 2);
+    QCOMPARE(m_model->pendingRowCount(), 0);
+
+    // clearAll drops pending work without emitting
+    m_model->updateFromUdpTick(1, makeTick(3, 11.0), 0.0, 0.0);
+    m_model->clearAll();
+    QCOMPARE(m_model->pendingRowCount(), 0);
+    QCOMPARE(spy.count(), 1);
+}
+
+void TestMarketWatchModel::testCoalesce_disableFlushesPending() {
+    m_model->addScrip(makeScrip("A", 1));
+    m_model->setCoalesceInterval(16);
+
+    QSignalSpy spy(m_model, &QAbstractTableModel::dataChanged);
+    m_model->updatePrice(0, 100.0, 1.0, 1.0);
+    QCOMPARE(spy.count(), 0);
+
+    m_model->setCoalesceInterval(0);
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(m_model->coalesceInterval(), 0);
+
+    // Immediate mode again: every update emits
+    m_model->updatePrice(0, 101.0, 2.0, 2.0);
+    QCOMPARE(spy.count(), 2);
+
+    // The timer drives the flush in coalesced mode
+    m_model->setCoalesceInterval(16);
+    m_model->updatePrice(0, 102.0, 3.0, 3.0);
+    QTRY_COMPARE_WITH_TIMEOUT(spy.count(), 3, 1000);
+}
+
+void TestMarketWatchModel::benchmarkCoalescedTicks_data() {
+    QTest::addColumn<int>("intervalMs");
+    QTest::newRow("per tick") << 0;
+    QTest::newRow("16 ms") << 16;
+    QTest::newRow("50 ms") << 50;
+    QTest::newRow("100 ms") << 100;
+}
+
+void TestMarketWatchModel::benchmarkCoalescedTicks() {
+    QFETCH(int, intervalMs);
+
+    // 500-row watch fed at 20k ticks/s: a frame of N ms absorbs 20*N ticks
+    constexpr int kRows = 500;
+    constexpr int kTicks = 100000;
+    constexpr int kTicksPerSecond = 20000;
+    for (int i = 1; i <= kRows; ++i)
+        m_model->addScrip(makeScrip(QString("S%1").arg(i), i));
+    m_model->setCoalesceInterval(intervalMs);
+    const int ticksPerFrame =
+        intervalMs > 0 ? kTicksPerSecond * intervalMs / 1000 : 1;
+
+    // Stand-in for a proxy/view: count signals and the rows they cover
+    qint64 signalCount = 0;
+    qint64 rowsNotified = 0;
+    connect(m_model, &QAbstractTableModel::dataChanged, m_model,
+            [&](const QModelIndex& tl, const QModelIndex& br) {
+                ++signalCount;
+                rowsNotified += br.row() - tl.row() + 1;
+            });
+
+    QElapsedTimer timer;
+    qint64 elapsedNs = 0;
+    QBENCHMARK {
+        signalCount = 0;
+        rowsNotified = 0;
+        timer.start();
+        for (int i = 0; i < kTicks; ++i) {
+            const int row = (i * 7919) % kRows;   // Spread across the watch
+            m_model->updateFromUdpTick(row, makeTick(row + 1, 100.0 + (i & 15) * 0.05),
+                                       0.5, 0.5);
+            if (intervalMs > 0 && (i + 1) % ticksPerFrame == 0)
+                m_model->flushPendingUpdates();   // One frame boundary
+        }
+        m_model->flushPendingUpdates();
+        elapsedNs = timer.nsecsElapsed();
+    }
+
+    const double ticksPerSec = elapsedNs > 0 ? kTicks * 1e9 / elapsedNs : 0.0;
+    qDebug().nospace() << "interval=" << intervalMs << "ms ticks/s="
+                       << qRound64(ticksPerSec) << " signals=" << signalCount
+                       << " rowsNotified=" << rowsNotified;
+
+    if (intervalMs == 0) {
+        QCOMPARE(signalCount, qint64(kTicks));
+    } else {
+        // Each row is notified at most once per frame
+        const qint64 frames = (kTicks + ticksPerFrame - 1) / ticksPerFrame;
+        QVERIFY(rowsNotified <= frames * kRows);
+        QVERIFY(signalCount < kTicks);
+    }
+}
+
+// ─── Columnar Storage ────────────────────────────────────
+
+void TestMarketWatchModel::testColumnar_roundTrip() {
+    ScripData in = makeFOScrip("NIFTY 22000 CE", 49508, 22000, "CE", "27FEB2026");
+    in.exchange = "NSEFO";
+    in.code = 49508;
+    in.isinCode = "INE000000000";
+    in.ltp = 125.5;
+    in.ltq = 75;
+    in.open = 120;
+    in.high = 130;
+    in.low = 118;
+    in.close = 119;
+    in.change = 6.5;
+    in.changePercent = 5.46;
+    in.volume = 1234567;
+    in.buyPrice = 125.45;
+    in.sellPrice = 125.55;
+    in.buyQty = 150;
+    in.totalSellQty = 90000;
+    in.openInterest = 4500000;
+    in.iv = 0.14;
+    in.theta = -4.2;
+    in.week52High = 410;
+    in.ltpTick = -1;
+    in.ltpTickTime = 42;
+    in.ltpTime = "09:15:03";
+    m_model->addScrip(in);
+
+    const ScripData out = m_model->getScripAt(0);
+    QCOMPARE(out.symbol, in.symbol);
+    QCOMPARE(out.exchange, in.exchange);
+    QCOMPARE(out.instrumentType, in.instrumentType);
+    QCOMPARE(out.optionType, in.optionType);
+    QCOMPARE(out.seriesExpiry, in.seriesExpiry);
+    QCOMPARE(out.isinCode, in.isinCode);
+    QCOMPARE(out.strikePrice, in.strikePrice);
+    QCOMPARE(out.code, in.code);
+    QCOMPARE(out.token, in.token);
+    QCOMPARE(out.ltp, in.ltp);
+    QCOMPARE(out.ltq, in.ltq);
+    QCOMPARE(out.open, in.open);
+    QCOMPARE(out.high, in.high);
+    QCOMPARE(out.low, in.low);
+    QCOMPARE(out.close, in.close);
+    QCOMPARE(out.change, in.change);
+    QCOMPARE(out.changePercent, in.changePercent);
+    QCOMPARE(out.volume, in.volume);
+    QCOMPARE(out.buyQty, in.buyQty);
+    QCOMPARE(out.totalSellQty, in.totalSellQty);
+    QCOMPARE(out.openInterest, in.openInterest);
+    QCOMPARE(out.iv, in.iv);
+    QCOMPARE(out.theta, in.theta);
+    QCOMPARE(out.week52High, in.week52High);
+    QCOMPARE(out.ltpTick, in.ltpTick);
+    QCOMPARE(out.ltpTickTime, in.ltpTickTime);
+    QCOMPARE(out.ltpTime, in.ltpTime);
+
+    // bid/buyPrice and ask/sellPrice share one column each
+    QCOMPARE(out.bid, 125.45);
+    QCOMPARE(out.buyPrice, 125.45);
+    QCOMPARE(out.ask, 125.55);
+    QCOMPARE(out.sellPrice, 125.55);
+
+    // Out of range gathers an empty row
+    QCOMPARE(m_model->getScripAt(5).token, ScripData().token);
+    QVERIFY(m_model->getScripAt(-1).symbol.isEmpty());
+}
+
+void TestMarketWatchModel::testColumnar_internsSharedText() {
+    ScripStringPool& pool = ScripStringPool::instance();
+    QCOMPARE(pool.intern(QString()), ScripStringPool::Id(0));
+    QCOMPARE(pool.intern("NSEFO"), pool.intern(QString("NSE") + "FO"));
+
+    m_model->addScrip(makeFOScrip("BANKNIFTY 48000 PE", 35001, 48000, "PE", "26FEB2026"));
+    const int interned = pool.size();
+
+    // A second watch listing the same contract adds no strings
+    MarketWatchModel other;
+    other.addScrip(makeFOScrip("BANKNIFTY 48000 PE", 35001, 48000, "PE", "26FEB2026"));
+    QCOMPARE(pool.size(), interned);
+    QCOMPARE(other.getScripAt(0).symbol, QString("BANKNIFTY 48000 PE"));
+
+    // Text columns still render through data()
+    m_model->loadProfile("Detailed");
+    const QList<int> vis = m_model->getColumnProfile().visibleColumns();
+    const int symbolCol = vis.indexOf(static_cast<int>(MarketWatchColumn::SYMBOL));
+    QVERIFY(symbolCol >= 0);
+    QCOMPARE(m_model->data(m_model->index(0, symbolCol), Qt::DisplayRole).toString(),
+             QString("BANKNIFTY 48000 PE"));
+}
+
+void TestMarketWatchModel::testColumnar_footprintBelowLegacy() {
+    // 1,000 option rows over a handful of underlyings/expiries: the text
+    // repeats heavily, which is what interning and SoA are meant to exploit
+    constexpr int kRows = 1000;
+    QList<ScripData> scrips;
+    for (int i = 0; i < kRows; ++i) {
+        const double strike = 20000 + (i / 2) * 50;
+        ScripData s = makeFOScrip(QString("NIFTY %1 %2").arg(strike).arg(i % 2 ? "PE" : "CE"),
+                                  40000 + i, strike, i % 2 ? "PE" : "CE",
+                                  i % 3 ? "27FEB2026" : "26MAR2026");
+        s.exchange = "NSEFO";
+        scrips.append(s);
+    }
+    m_model->addScrips(scrips);
+    QCOMPARE(m_model->totalRowCount(), kRows);
+
+    const size_t columnar = m_model->memoryFootprint();
+    const size_t legacy = m_model->legacyFootprint();
+    MemoryProfiler::logFootprint("MarketWatch rows", columnar, legacy,
+                                 static_cast<size_t>(kRows));
+    QVERIFY(columnar > 0);
+    QVERIFY(columnar < legacy);
+}
+
+void TestMarketWatchModel::benchmarkRepaintCost_data() {
+    QTest::addColumn<QString>("profile");
+    QTest::newRow("Default") << QString("Default");
+    QTest::newRow("Detailed") << QString("Detailed");
+}
+
+void TestMarketWatchModel::benchmarkRepaintCost() {
+    QFETCH(QString, profile);
+
+    // One 50-row screen of a 2,000-row watch with live prices
+    constexpr int kRows = 2000;
+    constexpr int kScreenRows = 50;
+    QList<ScripData> scrips;
+    for (int i = 1; i <= kRows; ++i)
+        scrips.append(makeScrip(QString("S%1").arg(i), i));
+    m_model->addScrips(scrips);
+    m_model->loadProfile(profile);
+    for (int row = 0; row < kRows; ++row)
+        m_model->updateFromUdpTick(row, makeTick(row + 1, 100.0 + row * 0.05), 0.5, 0.5);
+
+    qint64 elapsedNs = 0;
+    QBENCHMARK {
+        elapsedNs = m_model->measureRepaintCost(kRows / 2, kScreenRows);
+    }
+
+    MemoryProfiler::logCost(
+        QString("Repaint %1 (%2 cols)").arg(profile).arg(m_model->columnCount()),
+        elapsedNs, static_cast<size_t>(kScreenRows) * m_model->columnCount() * 3);
+    QVERIFY(elapsedNs > 0);
+}
+
 // ─── Main ────────────────────────────────────────────────
 
 QTEST_MAIN(TestMarketWatchModel)
@@ -0,0 +1,399 @@
+/**
+ * @file test_master_delta.cpp
+ * @brief Unit tests for MasterDelta (row-hash master refresh)
+ *
+ * Tests:
+ *  - Row hashes are stable and never 0, row keys, hash table sort / lookup
+ *  - compute(): inserts, modifications, removals and unchanged rows,
+ *    index contracts (no row hash) kept, last row of a repeated key wins,
+ *    unparsable rows treated as absent
+ *  - NSECMRepository::applyDelta keeps token -> row lookups after
+ *    swap-removal; NSEFORepository::applyDelta keeps its counts and
+ *    drops a symbol once its last contract is removed
+ *  - Benchmark: full parse vs diff of a synthetic ~130K line combined
+ *    master with ~1% changed rows (time and peak RSS)
+ *
+ * Build: Requires Qt5::Core, Qt5::Test
+ */
+
+#include <QtTest/QtTest>
+#include <QElapsedTimer>
+#include "repository/MasterDelta.h"
+#include "repository/NSECMRepository.h"
+#include "repository/NSEFORepository.h"
+#include "repository/ParallelMasterParser.h"
+#include "utils/MemoryProfiler.h"
+
+namespace {
+
+QByteArray cashLine(int64_t token, const QByteArray &symbol, int lotSize = 1) {
+    const QByteArray t = QByteArray::number(token);
+    return "NSECM|" + t + "|8|" + symbol + "|" + symbol + "-EQ|EQ|" + symbol +
+           "-EQ|11001000" + t + "|3100.5|2536.9|100000|0.05|" +
+           QByteArray::number(lotSize) + "|1|" + symbol + "|INE002A01018|1|1|" +
+           symbol + " LTD";
+}
+
+QByteArray optionLine(int64_t token, const QByteArray &symbol, int strike,
+                      int lotSize = 500) {
+    const QByteArray t = QByteArray::number(token);
+    const QByteArray s = QByteArray::number(strike);
+    return "NSEFO|" + t + "|2|" + symbol + "|" + symbol + s + "CE|OPTSTK|" + symbol +
+           "-OPTSTK|" + t + "|150.5|0.05|10000|0.05|" + QByteArray::number(lotSize) +
+           "|1|1100100010000|" + symbol + "|2099-01-29T14:30:00|" + s + "|3|" +
+           symbol + " " + s + "|1|1|" + symbol;
+}
+
+MasterDelta::RowHashes hashesOf(const QByteArray &master) {
+    MasterDelta::RowHashes hashes;
+    for (const QByteArray &line : master.split('\n')) {
+        int32_t segment = 0;
+        int64_t token = 0;
+        const std::string_view row(line.constData(), size_t(line.size()));
+        if (MasterDelta::rowKey(row, segment, token))
+            hashes.push_back({segment, token, MasterDelta::hashRow(row)});
+    }
+    MasterDelta::sortHashes(hashes);
+    return hashes;
+}
+
+MasterDelta computeDelta(const QByteArray &download,
+                         const MasterDelta::RowHashes &current) {
+    ParallelMasterParser parser;
+    parser.setData(download);
+    MasterDelta delta;
+    delta.compute(parser, current);
+    return delta;
+}
+
+QVector<MasterContract> parseAll(const QByteArray &master) {
+    ParallelMasterParser parser;
+    parser.setData(master);
+    ParallelMasterParser::Pools pools;
+    QVector<MasterContract> contracts;
+    for (auto &chunk : parser.parseLines<MasterContract>(
+             [&pools](std::string_view line, std::vector<MasterContract> &out) {
+                 MasterContract contract;
+                 if (ParallelMasterParser::parseMasterLine(line, contract, pools))
+                     out.push_back(std::move(contract));
+             })) {
+        for (MasterContract &contract : chunk)
+            contracts.append(std::move(contract));
+    }
+    return contracts;
+}
+
+// Synthetic combined master; every changeEvery-th row gets another lot size
+QByteArray syntheticMaster(int lines, int changeEvery = 0) {
+    QByteArray data;
+    data.reserve(lines * 200);
+    for (int i = 0; i < lines; ++i) {
+        const bool changed = changeEvery > 0 && i % changeEvery == 0;
+        data += optionLine(35000 + i, "SYM" + QByteArray::number(i / 640),
+                           1000 + (i % 64) * 10, changed ? 750 : 500);
+        data += '\n';
+    }
+    return data;
+}
+
+QString peakText(bool measured, size_t bytes) {
+    return measured ? MemoryProfiler::formatBytes(bytes) : QStringLiteral("n/a");
+}
+
+} // namespace
+
+class TestMasterDelta : public QObject {
+    Q_OBJECT
+
+private slots:
+    // ─── Hashes ───
+    void testHashRow();
+    void testRowKey();
+    void testSortAndFindHashes();
+
+    // ─── compute ───
+    void testComputeClassifiesRows();
+    void testComputeKeepsHashlessKeys();
+    void testComputeLastRowWins();
+    void testComputeSkipsUnparsableRows();
+
+    // ─── Repositories ───
+    void testNSECMApplyDelta();
+    void testNSEFOApplyDelta();
+    void testNSEFOApplyDeltaDropsEmptySymbols();
+
+    // ─── Benchmark ───
+    void benchmarkRefreshVsFullParse();
+};
+
+// ═══════════════════════════════════════════════════════
+// Hashes
+// ═══════════════════════════════════════════════════════
+
+void TestMasterDelta::testHashRow()
+{
+    const QByteArray line = optionLine(35001, "NIFTY", 23000);
+    const std::string_view row(line.constData(), size_t(line.size()));
+    QCOMPARE(MasterDelta::hashRow(row), MasterDelta::hashRow(row));
+    QVERIFY(MasterDelta::hashRow(row) != 0);
+    QVERIFY(MasterDelta::hashRow("") != 0);
+
+    const QByteArray other = optionLine(35001, "NIFTY", 23000, 75);
+    QVERIFY(MasterDelta::hashRow(row) !=
+            MasterDelta::hashRow(std::string_view(other.constData(), size_t(other.size()))));
+}
+
+void TestMasterDelta::testRowKey()
+{
+    int32_t segment = 0;
+    int64_t token = 0;
+    QVERIFY(MasterDelta::rowKey("NSEFO|35001|2|NIFTY", segment, token));
+    QCOMPARE(segment, int32_t(2));
+    QCOMPARE(token, int64_t(35001));
+    QVERIFY(MasterDelta::rowKey("BSECM|500325", segment, token));
+    QCOMPARE(segment, int32_t(11));
+    QCOMPARE(token, int64_t(500325));
+
+    QVERIFY(!MasterDelta::rowKey("", segment, token));
+    QVERIFY(!MasterDelta::rowKey("MCXFO|1|2", segment, token));
+    QVERIFY(!MasterDelta::rowKey("NSECM|abc|8", segment, token));
+    QVERIFY(!MasterDelta::rowKey("NSECM", segment, token));
+
+    QCOMPARE(MasterDelta::segmentId("BSEFO"), int32_t(12));
+    QCOMPARE(MasterDelta::segmentId("MCXFO"), int32_t(0));
+}
+
+void TestMasterDelta::testSortAndFindHashes()
+{
+    MasterDelta::RowHashes hashes = {
+        {2, 35002, 20}, {1, 2885, 10}, {2, 35001, 30}, {2, 35002, 21}, {12, 1, 40}};
+    MasterDelta::sortHashes(hashes);
+
+    QCOMPARE(int(hashes.size()), 4);
+    QCOMPARE(hashes[0].segment, int32_t(1));
+    QCOMPARE(hashes[1].token, int64_t(35001));
+    QCOMPARE(hashes[3].segment, int32_t(12));
+
+    QCOMPARE(MasterDelta::findHash(hashes, 2, 35002), uint64_t(21));
+    QCOMPARE(MasterDelta::findHash(hashes, 1, 2885), uint64_t(10));
+    QCOMPARE(MasterDelta::findHash(hashes, 1, 35002), uint64_t(0));
+    QCOMPARE(MasterDelta::findHash(MasterDelta::RowHashes(), 1, 2885), uint64_t(0));
+}
+
+// ═══════════════════════════════════════════════════════
+// compute
+// ═══════════════════════════════════════════════════════
+
+void TestMasterDelta::testComputeClassifiesRows()
+{
+    const QByteArray loaded = cashLine(2885, "RELIANCE") + "\n" +
+                              cashLine(11536, "TCS") + "\n" +
+                              optionLine(35001, "NIFTY", 23000) + "\n" +
+                              optionLine(35002, "NIFTY", 23100) + "\n";
+    const QByteArray download = cashLine(2885, "RELIANCE") + "\n" +
+                                optionLine(35001, "NIFTY", 23000, 75) + "\n" +
+                                optionLine(35002, "NIFTY", 23100) + "\n" +
+                                optionLine(35003, "NIFTY", 23200) + "\r\n";
+
+    MasterDelta delta = computeDelta(download, hashesOf(loaded));
+    const MasterDelta::Stats &stats = delta.stats();
+    QCOMPARE(stats.rows, 4);
+    QCOMPARE(stats.unchanged, 2);
+    QCOMPARE(stats.modified, 1);
+    QCOMPARE(stats.inserted, 1);
+    QCOMPARE(stats.removed, 1);
+    QCOMPARE(stats.changed(), 3);
+    QVERIFY(!delta.isEmpty());
+
+    QVERIFY(delta.segmentChanged(1));
+    QVERIFY(delta.segmentChanged(2));
+    QVERIFY(!delta.segmentChanged(11));
+    QCOMPARE(delta.segment(1).removed, QVector<int64_t>{11536});
+    QVERIFY(delta.segment(1).upserts.isEmpty());
+
+    const MasterDelta::SegmentDelta &fo = delta.segment(2);
+    QCOMPARE(fo.upserts.size(), 2);
+    QCOMPARE(fo.upserts[0].exchangeInstrumentID, int64_t(35001));
+    QCOMPARE(fo.upserts[0].lotSize, 75);
+    QCOMPARE(fo.upserts[1].exchangeInstrumentID, int64_t(35003));
+    QVERIFY(fo.upserts[1].rowHash != 0);
+    QCOMPARE(fo.upserts[1].rowHash,
+             MasterDelta::findHash(delta.hashes(), 2, 35003));
+
+    // The new hashes describe the download; applying it again is a no-op
+    const MasterDelta::RowHashes next = delta.takeHashes();
+    QCOMPARE(int(next.size()), 4);
+    QVERIFY(computeDelta(download, next).isEmpty());
+}
+
+void TestMasterDelta::testComputeKeepsHashlessKeys()
+{
+    // Index contracts are appended to NSECM without a master row: they have
+    // no hash, so a download that does not list them leaves them alone
+    const QByteArray master = cashLine(2885, "RELIANCE") + "\n";
+    NSECMRepository repo;
+    QVERIFY(repo.loadFromContracts(parseAll(master)));
+    ContractData index;
+    index.exchangeInstrumentID = 26000;
+    index.name = "NIFTY 50";
+    repo.appendContracts({index});
+
+    MasterDelta delta = computeDelta(master + cashLine(11536, "TCS") + "\n",
+                                     hashesOf(master));
+    QCOMPARE(delta.stats().removed, 0);
+    QCOMPARE(delta.stats().inserted, 1);
+    repo.applyDelta(delta.segment(1).upserts, delta.segment(1).removed);
+
+    QCOMPARE(repo.getTotalCount(), 3);
+    QCOMPARE(repo.getContractCopy(26000).name, QString("NIFTY 50"));
+    QCOMPARE(repo.getContractCopy(11536).name, QString("TCS"));
+}
+
+void TestMasterDelta::testComputeLastRowWins()
+{
+    const QByteArray download = optionLine(35001, "NIFTY", 23000, 50) + "\n" +
+                                optionLine(35001, "NIFTY", 23000, 75) + "\n";
+
+    MasterDelta delta = computeDelta(download, MasterDelta::RowHashes());
+    QCOMPARE(delta.stats().rows, 1);
+    QCOMPARE(delta.stats().inserted, 1);
+    QCOMPARE(delta.segment(2).upserts.size(), 1);
+    QCOMPARE(delta.segment(2).upserts[0].lotSize, 75);
+}
+
+void TestMasterDelta::testComputeSkipsUnparsableRows()
+{
+    const QByteArray loaded = cashLine(2885, "RELIANCE") + "\n" +
+                              cashLine(11536, "TCS") + "\n";
+    // TCS is still keyed but too short to parse: a full load would drop it
+    const QByteArray download = cashLine(2885, "RELIANCE") + "\n" +
+                                "NSECM|11536|8|TCS\n" + "header line\n";
+
+    MasterDelta delta = computeDelta(download, hashesOf(loaded));
+    QCOMPARE(delta.stats().rows, 1);
+    QCOMPARE(delta.stats().removed, 1);
+    QCOMPARE(delta.segment(1).removed, QVector<int64_t>{11536});
+}
+
+// ═══════════════════════════════════════════════════════
+// Repositories
+// ═══════════════════════════════════════════════════════
+
+void TestMasterDelta::testNSECMApplyDelta()
+{
+    const QByteArray loaded = cashLine(2885, "RELIANCE") + "\n" +
+                              cashLine(11536, "TCS") + "\n" +
+                              cashLine(1594, "INFY") + "\n" +
+                              cashLine(1333, "HDFCBANK") + "\n";
+    NSECMRepository repo;
+    QVERIFY(repo.loadFromContracts(parseAll(loaded)));
+    QCOMPARE(repo.getTotalCount(), 4);
+
+    // Remove a middle row (swap-removal moves HDFCBANK into its slot),
+    // change INFY, add SBIN
+    const QByteArray download = cashLine(2885, "RELIANCE") + "\n" +
+                                cashLine(1594, "INFY", 5) + "\n" +
+                                cashLine(1333, "HDFCBANK") + "\n" +
+                                cashLine(3045, "SBIN") + "\n";
+    MasterDelta delta = computeDelta(download, hashesOf(loaded));
+    repo.applyDelta(delta.segment(1).upserts, delta.segment(1).removed);
+
+    QCOMPARE(repo.getTotalCount(), 4);
+    QVERIFY(repo.getContract(11536) == nullptr);
+    QCOMPARE(repo.getContractCopy(2885).name, QString("RELIANCE"));
+    QCOMPARE(repo.getContractCopy(1333).name, QString("HDFCBANK"));
+    QCOMPARE(repo.getContractCopy(1594).lotSize, 5);
+    QCOMPARE(repo.getContractCopy(3045).name, QString("SBIN"));
+    QCOMPARE(repo.getAllContracts().size(), 4);
+}
+
+void TestMasterDelta::testNSEFOApplyDelta()
+{
+    const QByteArray loaded = syntheticMaster(10);
+    NSEFORepository repo;
+    QVERIFY(repo.loadFromContracts(parseAll(loaded)));
+    QCOMPARE(repo.getRegularCount(), 10);
+
+    QByteArray download = syntheticMaster(10, 4); // Rows 0, 4, 8 changed
+    download.replace(optionLine(35005, "SYM0", 1050) + "\n", QByteArray());
+    download += optionLine(35100, "SYM0", 2000) + "\n";
+
+    MasterDelta delta = computeDelta(download, hashesOf(loaded));
+    QCOMPARE(delta.stats().modified, 3);
+    QCOMPARE(delta.stats().removed, 1);
+    QCOMPARE(delta.stats().inserted, 1);
+    repo.applyDelta(delta.segment(2).upserts, delta.segment(2).removed);
+
+    QCOMPARE(repo.getRegularCount(), 10);
+    QCOMPARE(repo.getTotalCount(), 10);
+    QVERIFY(repo.getContract(35005) == nullptr);
+    QCOMPARE(repo.getContractCopy(35004).lotSize, 750);
+    QCOMPARE(repo.getContractCopy(35001).lotSize, 500);
+    QCOMPARE(repo.getContractCopy(35100).strikePrice, 2000.0);
+}
+
+void TestMasterDelta::testNSEFOApplyDeltaDropsEmptySymbols()
+{
+    const QByteArray base = syntheticMaster(4);
+    const QByteArray loaded = base + optionLine(35050, "GONE", 1000) + "\n" +
+                              optionLine(35051, "GONE", 1100) + "\n" +
+                              optionLine(35052, "KEPT", 1000) + "\n" +
+                              optionLine(35053, "KEPT", 1100) + "\n";
+    NSEFORepository repo;
+    QVERIFY(repo.loadFromContracts(parseAll(loaded)));
+    QVERIFY(repo.getAssetToken("GONE") != -1);
+
+    // Every GONE contract expires, one of the two KEPT contracts does
+    const QByteArray download = base + optionLine(35052, "KEPT", 1000) + "\n";
+    MasterDelta delta = computeDelta(download, hashesOf(loaded));
+    QCOMPARE(delta.stats().removed, 3);
+    repo.applyDelta(delta.segment(2).upserts, delta.segment(2).removed);
+
+    QCOMPARE(repo.getAssetToken("GONE"), int64_t(-1));
+    QVERIFY(repo.getAssetToken("KEPT") != -1);
+    QVERIFY(repo.getAssetToken("SYM0") != -1);
+    QCOMPARE(repo.getRegularCount(), 5);
+}
+
+// ═══════════════════════════════════════════════════════
+// Benchmark
+// ═══════════════════════════════════════════════════════
+
+void TestMasterDelta::benchmarkRefreshVsFullParse()
+{
+    const int kLines = 130000;
+    const QByteArray loaded = syntheticMaster(kLines);
+    const QByteArray download = syntheticMaster(kLines, 100); // ~1% changed
+    const MasterDelta::RowHashes current = hashesOf(loaded);
+
+    // Full reload path: every row parsed into a contract
+    const bool fullMeasured = MemoryProfiler::resetPeak();
+    QElapsedTimer timer;
+    timer.start();
+    int parsed = 0;
+    QBENCHMARK_ONCE {
+        parsed = parseAll(download).size();
+    }
+    const qint64 fullNs = timer.nsecsElapsed();
+    const size_t fullPeak = MemoryProfiler::getCurrentUsage().peakPhysical;
+    QCOMPARE(parsed, kLines);
+
+    // Refresh path: hash every row, parse only the changed ones
+    const bool deltaMeasured = MemoryProfiler::resetPeak();
+    timer.restart();
+    MasterDelta delta = computeDelta(download, current);
+    const qint64 deltaNs = timer.nsecsElapsed();
+    const size_t deltaPeak = MemoryProfiler::getCurrentUsage().peakPhysical;
+    QCOMPARE(delta.stats().modified, kLines / 100);
+    QCOMPARE(delta.stats().unchanged, kLines - kLines / 100);
+
+    qDebug().nospace() << "Master refresh, " << kLines << " lines, "
+                       << delta.stats().changed() << " changed: full parse "
+                       << fullNs / 1000000.0 << " ms (peak RSS "
+                       << peakText(fullMeasured, fullPeak) << "), delta "
+                       << deltaNs / 1000000.0 << " ms (peak RSS "
+                       << peakText(deltaMeasured, deltaPeak) << ")";
+}
+
+QTEST_MAIN(TestMasterDelta)
+#include "test_master_delta.moc"
@@ -0,0 +1,393 @@
+/**
+ * @file test_nsefo_tick_pipeline.cpp
+ * @brief Parse-once NSE FO tick pipeline: correctness + latency histogram
+ *
+ * Tests:
+ *  - 7208 through TickDelta leaves the store exactly as the previous
+ *    memset → updateTouchline/updateDepth path did
+ *  - The row handed to the delta callback equals a fresh store snapshot
+ *  - 7202 deltas update OI only and keep the touchline / depth
+ *  - Without a delta callback the token-only touchline / ticker
+ *    callbacks still fire (with the real message type)
+ *
+ * Benchmarks:
+ *  - benchmarkLatencyHistogram: per-message latency of the previous
+ *    parse → store → re-snapshot → convert round trip vs the parse-once
+ *    delta path, printed as a log2 histogram with p50 / p99 / p99.9
+ *
+ * Build: Requires Qt5::Core, Qt5::Test, nsefo_price_store.cpp,
+ *        parse_message_7208.cpp, parse_message_7202.cpp
+ */
+
+#include <QtTest/QtTest>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <vector>
+#include "nse_parsers.h"
+#include "nse_market_data.h"
+#include "nsefo_callback.h"
+#include "nsefo_price_store.h"
+#include "protocol.h"
+#include "udp_batch_receiver.h"
+
+using MarketData::DepthState;
+using MarketData::TouchlineState;
+using MarketData::UnifiedState;
+using nsefo::MarketDataCallbackRegistry;
+using nsefo::TickDelta;
+
+// ─── Helpers ─────────────────────────────────────────────
+
+namespace {
+
+constexpr uint32_t kFirstToken = 40000;
+constexpr uint32_t kTokenCount = 500;
+
+// Byte swap is symmetric, so the parser's decode helpers also encode
+uint32_t be32(uint32_t v) { return be32toh_func(v); }
+uint16_t be16(uint16_t v) { return be16toh_func(v); }
+
+void fillRecord(INTERACTIVE_ONLY_MBP_DATA& d, uint32_t token, uint32_t n)
+{
+    std::memset(&d, 0, sizeof(d));
+    d.token = be32(token);
+    d.bookType = be16(1);
+    d.tradingStatus = be16(2);
+    d.volumeTradedToday = be32(1000 + n);
+    d.lastTradedPrice = be32(10000 + n);
+    d.netChangeIndicator = '+';
+    d.netPriceChangeFromClosingPrice = be32(150);
+    d.lastTradeQuantity = be32(50);
+    d.lastTradeTime = be32(36000 + n);
+    d.averageTradePrice = be32(9950);
+    for (int j = 0; j < 10; ++j) {
+        d.recordBuffer[j].quantity = be32(100 * (j + 1));
+        d.recordBuffer[j].price = be32(j < 5 ? 10000 + n - j * 5 : 10005 + n + (j - 5) * 5);
+        d.recordBuffer[j].numberOfOrders = be16(static_cast<uint16_t>(j + 1));
+    }
+    d.totalBuyQuantity = 1500.0;
+    d.totalSellQuantity = 2500.0;
+    d.closingPrice = be32(9850);
+    d.openPrice = be32(9900);
+    d.highPrice = be32(10100 + n);
+    d.lowPrice = be32(9800);
+}
+
+MS_BCAST_ONLY_MBP make7208(uint32_t token, uint32_t n)
+{
+    MS_BCAST_ONLY_MBP msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.noOfRecords = be16(1);
+    fillRecord(msg.data[0], token, n);
+    return msg;
+}
+
+MS_TICKER_TRADE_DATA make7202(uint32_t token, uint32_t oi)
+{
+    MS_TICKER_TRADE_DATA msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.numberOfRecords = be16(1);
+    msg.records[0].token = be32(token);
+    msg.records[0].fillPrice = be32(12345);
+    msg.records[0].fillVolume = be32(75);
+    msg.records[0].openInterest = be32(oi);
+    return msg;
+}
+
+// Previous 7208 path: zeroed UnifiedState, two store writes, token-only
+// dispatch (the receiver then re-snapshots the row)
+void legacyParse7208(const MS_BCAST_ONLY_MBP* msg)
+{
+    const auto& data = msg->data[0];
+    UnifiedState state;
+    std::memset(&state, 0, sizeof(state));
+    state.token = be32toh_func(data.token);
+    state.lastPacketTimestamp = udp_ingest::packetTimestampOrNow();
+    state.ltp = be32toh_func(data.lastTradedPrice) / 100.0;
+    state.open = be32toh_func(data.openPrice) / 100.0;
+    state.high = be32toh_func(data.highPrice) / 100.0;
+    state.low = be32toh_func(data.lowPrice) / 100.0;
+    state.close = be32toh_func(data.closingPrice) / 100.0;
+    state.volume = be32toh_func(data.volumeTradedToday);
+    state.lastTradeQty = be32toh_func(data.lastTradeQuantity);
+    state.lastTradeTime = be32toh_func(data.lastTradeTime);
+    state.avgPrice = be32toh_func(data.averageTradePrice) / 100.0;
+    state.netChangeIndicator = data.netChangeIndicator;
+    state.netChange = be32toh_func(data.netPriceChangeFromClosingPrice) / 100.0;
+    state.tradingStatus = be16toh_func(data.tradingStatus);
+    state.bookType = be16toh_func(data.bookType);
+    state.totalBuyQty = data.totalBuyQuantity;
+    state.totalSellQty = data.totalSellQuantity;
+    for (int j = 0; j < 5; j++) {
+        state.bids[j].quantity = be32toh_func(data.recordBuffer[j].quantity);
+        state.bids[j].price = be32toh_func(data.recordBuffer[j].price) / 100.0;
+        state.bids[j].orders = be16toh_func(data.recordBuffer[j].numberOfOrders);
+        state.asks[j].quantity = be32toh_func(data.recordBuffer[j + 5].quantity);
+        state.asks[j].price = be32toh_func(data.recordBuffer[j + 5].price) / 100.0;
+        state.asks[j].orders = be16toh_func(data.recordBuffer[j + 5].numberOfOrders);
+    }
+    nsefo::g_nseFoPriceStore.updateTouchline(state);
+    nsefo::g_nseFoPriceStore.updateDepth(state);
+    MarketDataCallbackRegistry::instance().dispatchTouchline(state.token);
+}
+
+// Stand-in for the receiver's MarketTick conversion: touch what it reads
+struct Sink {
+    double ltp = 0.0;
+    double bestBid = 0.0;
+    uint64_t count = 0;
+
+    void consume(const TouchlineState& tick, const DepthState& depth) {
+        ltp += tick.ltp;
+        bestBid += depth.bids[0].price;
+        ++count;
+    }
+};
+
+// Log2 buckets in nanoseconds: bucket b holds [2^b, 2^(b+1))
+class LatencyHistogram {
+public:
+    void record(int64_t ns) {
+        uint64_t v = ns > 0 ? static_cast<uint64_t>(ns) : 0;
+        int b = 0;
+        while (v > 1 && b < kBuckets - 1) { v >>= 1; ++b; }
+        ++buckets_[b];
+        samples_.push_back(ns);
+    }
+
+    int64_t percentile(double p) {
+        if (samples_.empty()) return 0;
+        size_t idx = static_cast<size_t>(p * (samples_.size() - 1));
+        std::nth_element(samples_.begin(), samples_.begin() + idx, samples_.end());
+        return samples_[idx];
+    }
+
+    void print(const char* label) {
+        qInfo().noquote() << QString("%1: p50=%2ns p99=%3ns p99.9=%4ns (n=%5)")
+                                 .arg(label)
+                                 .arg(percentile(0.50))
+                                 .arg(percentile(0.99))
+                                 .arg(percentile(0.999))
+                                 .arg(samples_.size());
+        for (int b = 0; b < kBuckets; ++b) {
+            if (buckets_[b] == 0) continue;
+            qInfo().noquote() << QString("  [%1, %2) ns  %3")
+                                     .arg(1ULL << b, 8)
+                                     .arg(1ULL << (b + 1), 8)
+                                     .arg(buckets_[b]);
+        }
+    }
+
+private:
+    static constexpr int kBuckets = 24;
+    std::array<uint64_t, kBuckets> buckets_{};
+    std::vector<int64_t> samples_;
+};
+
+} // namespace
+
+// ─── Test Class ──────────────────────────────────────────
+
+class TestNseFoTickPipeline : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanup();
+
+    // ─── Delta path ───
+    void testDeltaMatchesLegacyStore();
+    void testCallbackRowMatchesSnapshot();
+    void testTickerUpdatesOiOnly();
+    void testFallbackToTokenCallbacks();
+
+    // ─── Benchmarks ───
+    void benchmarkLatencyHistogram();
+};
+
+void TestNseFoTickPipeline::init()
+{
+    std::vector<uint32_t> tokens;
+    for (uint32_t t = kFirstToken; t < kFirstToken + kTokenCount; ++t) tokens.push_back(t);
+    nsefo::g_nseFoPriceStore.clear();
+    nsefo::g_nseFoPriceStore.initializeFromMaster(tokens);
+    udp_ingest::setCurrentPacketTimestamp(123456);
+}
+
+void TestNseFoTickPipeline::cleanup()
+{
+    auto& registry = MarketDataCallbackRegistry::instance();
+    registry.registerTickDeltaCallback(nullptr);
+    registry.registerTouchlineCallback(nullptr);
+    registry.registerTickerCallback(nullptr);
+    udp_ingest::setCurrentPacketTimestamp(0);
+}
+
+// ─── Delta path ──────────────────────────────────────────
+
+void TestNseFoTickPipeline::testDeltaMatchesLegacyStore()
+{
+    auto msg = make7208(kFirstToken, 7);
+
+    legacyParse7208(&msg);
+    UnifiedState legacy = nsefo::g_nseFoPriceStore.getUnifiedSnapshot(kFirstToken);
+
+    init();
+    nsefo::parse_message_7208(&msg);
+    UnifiedState delta = nsefo::g_nseFoPriceStore.getUnifiedSnapshot(kFirstToken);
+
+    QCOMPARE(delta.token, kFirstToken);
+    QCOMPARE(delta.ltp, legacy.ltp);
+    QCOMPARE(delta.high, legacy.high);
+    QCOMPARE(delta.volume, legacy.volume);
+    QCOMPARE(delta.lastTradeTime, legacy.lastTradeTime);
+    QCOMPARE(delta.netChange, legacy.netChange);
+    QCOMPARE(delta.netChangeIndicator, legacy.netChangeIndicator);
+    QCOMPARE(delta.tradingStatus, legacy.tradingStatus);
+    QCOMPARE(delta.lastPacketTimestamp, legacy.lastPacketTimestamp);
+    for (int i = 0; i < 5; ++i) {
+        QCOMPARE(delta.bids[i].price, legacy.bids[i].price);
+        QCOMPARE(delta.bids[i].quantity, legacy.bids[i].quantity);
+        QCOMPARE(delta.asks[i].orders, legacy.asks[i].orders);
+    }
+    QCOMPARE(delta.totalSellQty, legacy.totalSellQty);
+}
+
+void TestNseFoTickPipeline::testCallbackRowMatchesSnapshot()
+{
+    TickDelta seen;
+    TouchlineState seenTick;
+    DepthState seenDepth;
+    int calls = 0;
+    MarketDataCallbackRegistry::instance().registerTickDeltaCallback(
+        [&](const TickDelta& d, const TouchlineState& tick, const DepthState& depth) {
+            seen = d;
+            seenTick = tick;
+            seenDepth = depth;
+            ++calls;
+        });
+
+    auto msg = make7208(kFirstToken + 1, 3);
+    nsefo::parse_message_7208(&msg);
+
+    QCOMPARE(calls, 1);
+    QCOMPARE(seen.messageType, static_cast<uint16_t>(7208));
+    QVERIFY(seen.has(TickDelta::TOUCHLINE));
+    QVERIFY(seen.has(TickDelta::DEPTH));
+    QCOMPARE(seenTick.ltp, 100.03);
+    QCOMPARE(seenTick.lastPacketTimestamp, int64_t(123456));
+
+    auto tick = nsefo::g_nseFoPriceStore.getTouchline(kFirstToken + 1);
+    auto depth = nsefo::g_nseFoPriceStore.getDepth(kFirstToken + 1);
+    QCOMPARE(seenTick.ltp, tick.ltp);
+    QCOMPARE(seenTick.volume, tick.volume);
+    QCOMPARE(seenTick.updateCount, tick.updateCount);
+    QCOMPARE(seenDepth.bids[0].price, depth.bids[0].price);
+    QCOMPARE(seenDepth.asks[4].quantity, depth.asks[4].quantity);
+
+    // Unknown token: no row, no callback
+    auto unknown = make7208(kFirstToken + kTokenCount + 10, 1);
+    nsefo::parse_message_7208(&unknown);
+    QCOMPARE(calls, 1);
+}
+
+void TestNseFoTickPipeline::testTickerUpdatesOiOnly()
+{
+    auto msg = make7208(kFirstToken + 2, 9);
+    nsefo::parse_message_7208(&msg);
+
+    TickDelta seen;
+    DepthState seenDepth;
+    MarketDataCallbackRegistry::instance().registerTickDeltaCallback(
+        [&](const TickDelta& d, const TouchlineState&, const DepthState& depth) {
+            seen = d;
+            seenDepth = depth;
+        });
+
+    auto ticker = make7202(kFirstToken + 2, 777);
+    nsefo::parse_message_7202(&ticker);
+
+    QCOMPARE(seen.messageType, static_cast<uint16_t>(7202));
+    QVERIFY(seen.has(TickDelta::OI));
+    QVERIFY(!seen.has(TickDelta::TOUCHLINE));
+    QCOMPARE(seenDepth.bids[0].price, 100.09);
+
+    auto tick = nsefo::g_nseFoPriceStore.getTouchline(kFirstToken + 2);
+    QCOMPARE(tick.openInterest, int64_t(777));
+    QCOMPARE(tick.ltp, 100.09);        // Ticker fill price does not own LTP
+    QCOMPARE(tick.volume, uint64_t(1009));
+}
+
+void TestNseFoTickPipeline::testFallbackToTokenCallbacks()
+{
+    int32_t touchToken = 0;
+    uint16_t touchType = 0;
+    uint16_t tickerType = 0;
+    auto& registry = MarketDataCallbackRegistry::instance();
+    registry.registerTouchlineCallback([&](int32_t token, int, uint16_t type) {
+        touchToken = token;
+        touchType = type;
+    });
+    registry.registerTickerCallback([&](int32_t, int, uint16_t type) { tickerType = type; });
+
+    auto msg = make7208(kFirstToken + 3, 1);
+    nsefo::parse_message_7208(&msg);
+    auto ticker = make7202(kFirstToken + 3, 5);
+    nsefo::parse_message_7202(&ticker);
+
+    QCOMPARE(touchToken, static_cast<int32_t>(kFirstToken + 3));
+    QCOMPARE(touchType, static_cast<uint16_t>(7208));
+    QCOMPARE(tickerType, static_cast<uint16_t>(7202));
+}
+
+// ─── Benchmarks ──────────────────────────────────────────
+
+void TestNseFoTickPipeline::benchmarkLatencyHistogram()
+{
+    constexpr int kMessages = 200000;
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<MS_BCAST_ONLY_MBP> msgs;
+    msgs.reserve(kTokenCount);
+    for (uint32_t i = 0; i < kTokenCount; ++i) msgs.push_back(make7208(kFirstToken + i, i));
+
+    Sink sink;
+    auto& registry = MarketDataCallbackRegistry::instance();
+
+    // Before: token-only dispatch, receiver re-reads touchline + depth
+    registry.registerTouchlineCallback([&](int32_t token, int, uint16_t) {
+        auto tick = nsefo::g_nseFoPriceStore.getTouchline(token);
+        if (tick.token == 0) return;
+        auto depth = nsefo::g_nseFoPriceStore.getDepth(token);
+        sink.consume(tick, depth);
+    });
+    LatencyHistogram before;
+    for (int n = 0; n < kMessages; ++n) {
+        const auto* msg = &msgs[n % kTokenCount];
+        auto t0 = Clock::now();
+        legacyParse7208(msg);
+        before.record(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count());
+    }
+
+    // After: parse once, merged row handed over with the delta
+    registry.registerTickDeltaCallback(
+        [&](const TickDelta&, const TouchlineState& tick, const DepthState& depth) {
+            sink.consume(tick, depth);
+        });
+    LatencyHistogram after;
+    for (int n = 0; n < kMessages; ++n) {
+        const auto* msg = &msgs[n % kTokenCount];
+        auto t0 = Clock::now();
+        nsefo::parse_message_7208(msg);
+        after.record(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count());
+    }
+
+    QCOMPARE(sink.count, uint64_t(2 * kMessages));
+    before.print("7208 parse → store → re-snapshot");
+    after.print("7208 parse-once delta");
+}
+
+QTEST_MAIN(TestNseFoTickPipeline)
+#include "test_nsefo_tick_pipeline.moc"
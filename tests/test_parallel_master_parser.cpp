@@ -0,0 +1,432 @@
+/**
+ * @file test_parallel_master_parser.cpp
+ * @brief Unit tests for ParallelMasterParser (mmap + parallel master parsing)
+ *
+ * Tests:
+ *  - Newline-aligned chunking for any thread count
+ *  - Field splitting, quote trimming, from_chars numerics
+ *  - Combined master lines parse to the same MasterContract as
+ *    MasterFileParser::parseLine (options, futures, cash, both expiry forms)
+ *  - parseLines(): identical rows in file order for 1..8 threads, CRLF,
+ *    header skip, interned strings shared across threads
+ *  - Benchmark: MB/s on MasterFiles/*.csv and a synthetic ~130K line
+ *    combined master, parallel parser vs the line-by-line loader
+ *
+ * Build: Requires Qt5::Core, Qt5::Test
+ */
+
+#include <QtTest/QtTest>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <fstream>
+#include <string>
+#include "repository/MasterFileParser.h"
+#include "repository/ParallelMasterParser.h"
+
+#ifndef MASTER_FILES_DIR
+#define MASTER_FILES_DIR "MasterFiles"
+#endif
+
+namespace {
+
+using P = ParallelMasterParser;
+
+const char *kOptionLine =
+    "NSEFO|35001|2|NIFTY|NIFTY26JAN23000CE|OPTIDX|NIFTY-OPTIDX|2800000035001|"
+    "512.5|0.05|1800|0.05|75|1|-1|NIFTY|2026-01-27T14:30:00|23000|3|"
+    "NIFTY 27JAN2026 CE 23000|1|1|NIFTY";
+const char *kTextOptionLine =
+    "BSEFO|1150001|2|SENSEX|SENSEX26JAN80000PE|IO|SENSEX-IO|1150001|"
+    "900|0.05|1000|0.05|20|1|-1|SENSEX|2026-01-29T14:30:00|80000|pe|"
+    "SENSEX 29JAN2026 PE 80000|1|1|SENSEX";
+const char *kFutureLine =
+    "NSEFO|35002|1|RELIANCE|RELIANCE26JANFUT|FUTSTK|RELIANCE-FUTSTK|2800000035002|"
+    "3200|2800|10000|0.1|500|1|1100100002885|RELIANCE|20260127|"
+    "RELIANCE JAN FUT|1|1|RELIANCE";
+const char *kCashLine =
+    "NSECM|2885|8|RELIANCE|RELIANCE-EQ|EQ|RELIANCE-EQ|1100100002885|3100.5|2536.9|"
+    "100000|0.05|1|1|RELIANCE|INE002A01018|1|1|RELIANCE INDUSTRIES LTD";
+
+void compareContracts(const MasterContract &a, const MasterContract &b) {
+    QCOMPARE(a.exchange, b.exchange);
+    QCOMPARE(a.exchangeInstrumentID, b.exchangeInstrumentID);
+    QCOMPARE(a.instrumentType, b.instrumentType);
+    QCOMPARE(a.name, b.name);
+    QCOMPARE(a.description, b.description);
+    QCOMPARE(a.series, b.series);
+    QCOMPARE(a.nameWithSeries, b.nameWithSeries);
+    QCOMPARE(a.instrumentID, b.instrumentID);
+    QCOMPARE(a.priceBandHigh, b.priceBandHigh);
+    QCOMPARE(a.priceBandLow, b.priceBandLow);
+    QCOMPARE(a.freezeQty, b.freezeQty);
+    QCOMPARE(a.tickSize, b.tickSize);
+    QCOMPARE(a.lotSize, b.lotSize);
+    QCOMPARE(a.multiplier, b.multiplier);
+    QCOMPARE(a.displayName, b.displayName);
+    QCOMPARE(a.isin, b.isin);
+    QCOMPARE(a.priceNumerator, b.priceNumerator);
+    QCOMPARE(a.priceDenominator, b.priceDenominator);
+    QCOMPARE(a.expiryDate, b.expiryDate);
+    QCOMPARE(a.expiryDate_dt, b.expiryDate_dt);
+    QCOMPARE(a.timeToExpiry, b.timeToExpiry);
+    QCOMPARE(a.strikePrice, b.strikePrice);
+    QCOMPARE(a.optionType, b.optionType);
+    QCOMPARE(a.underlyingIndexName, b.underlyingIndexName);
+    QCOMPARE(a.assetToken, b.assetToken);
+}
+
+// Synthetic combined master: options and futures in the XTS layout
+QByteArray syntheticCombinedMaster(int lines) {
+    QByteArray data;
+    data.reserve(lines * 200);
+    for (int i = 0; i < lines; ++i) {
+        const int symbol = i / 640;
+        const QByteArray name = "SYM" + QByteArray::number(symbol);
+        const QByteArray token = QByteArray::number(35000 + i);
+        if (i % 64 == 0) {
+            data += "NSEFO|" + token + "|1|" + name + "|" + name + "FUT|FUTSTK|" + name +
+                    "-FUTSTK|" + token + "|1200|900|10000|0.05|500|1|11001000" +
+                    QByteArray::number(10000 + symbol) + "|" + name + "|20990129|" + name +
+                    " FUT|1|1|" + name + "\n";
+        } else {
+            const QByteArray strike = QByteArray::number(1000 + (i % 64) * 10);
+            data += "NSEFO|" + token + "|2|" + name + "|" + name + strike + "CE|OPTSTK|" +
+                    name + "-OPTSTK|" + token + "|150.5|0.05|10000|0.05|500|1|11001000" +
+                    QByteArray::number(10000 + symbol) + "|" + name +
+                    "|2099-01-29T14:30:00|" + strike + "|" + (i % 2 ? "3" : "4") + "|" +
+                    name + " " + strike + "|1|1|" + name + "\n";
+        }
+    }
+    return data;
+}
+
+} // namespace
+
+class TestParallelMasterParser : public QObject {
+    Q_OBJECT
+
+private slots:
+    // ─── Splitting ───
+    void testSplitChunks_data();
+    void testSplitChunks();
+    void testFieldHelpers();
+
+    // ─── Combined master ───
+    void testMatchesMasterFileParser_data();
+    void testMatchesMasterFileParser();
+    void testRejectsBadLines();
+
+    // ─── parseLines ───
+    void testParseLinesThreadCounts();
+    void testParseLinesFromFile();
+
+    // ─── Benchmark ───
+    void benchmarkProcessedCsvs();
+    void benchmarkCombinedMaster();
+};
+
+// ─── Splitting ───────────────────────────────────────────
+
+void TestParallelMasterParser::testSplitChunks_data()
+{
+    QTest::addColumn<int>("chunkCount");
+    for (int n : {1, 2, 3, 4, 7, 8, 64})
+        QTest::newRow(qPrintable(QString("%1 chunks").arg(n))) << n;
+}
+
+void TestParallelMasterParser::testSplitChunks()
+{
+    QFETCH(int, chunkCount);
+    const std::string data = "a\nbb\nccc\n\ndddd\neeeee\nf\ngg";
+
+    const std::vector<std::string_view> chunks = P::splitChunks(data, chunkCount);
+    QVERIFY(!chunks.empty());
+    QVERIFY(static_cast<int>(chunks.size()) <= chunkCount);
+
+    std::string joined;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        QVERIFY(!chunks[i].empty());
+        if (i + 1 < chunks.size())
+            QCOMPARE(chunks[i].back(), '\n');
+        joined += std::string(chunks[i]);
+    }
+    QCOMPARE(joined, data);
+
+    QVERIFY(P::splitChunks(std::string_view(), chunkCount).empty());
+}
+
+void TestParallelMasterParser::testFieldHelpers()
+{
+    std::string_view fields[8];
+    QCOMPARE(P::splitFields("1|2||4", '|', fields, 8), 4);
+    QVERIFY(fields[2].empty());
+    QCOMPARE(std::string(fields[3]), std::string("4"));
+    QCOMPARE(P::splitFields("a,b,c,d", ',', fields, 2), 2);
+    QCOMPARE(std::string(fields[1]), std::string("b,c,d"));
+
+    QCOMPARE(std::string(P::trimField("  \"RELIANCE\" ")), std::string("RELIANCE"));
+    QCOMPARE(std::string(P::trimField("\"")), std::string("\""));
+
+    int64_t i64 = -1;
+    QVERIFY(P::toInt64(" 1100100002885 ", i64));
+    QCOMPARE(i64, int64_t(1100100002885));
+    QVERIFY(P::toInt64("-1", i64));
+    QCOMPARE(i64, int64_t(-1));
+    QVERIFY(!P::toInt64("12x", i64));
+    QCOMPARE(i64, int64_t(0));
+    QVERIFY(!P::toInt64("", i64));
+
+    double d = 0;
+    QVERIFY(P::toDouble("\"0.05\"", d));
+    QCOMPARE(d, 0.05);
+    QVERIFY(P::toDouble("+1e3", d));
+    QCOMPARE(d, 1000.0);
+    QCOMPARE(P::doubleField("n/a"), 0.0);
+    QCOMPARE(P::int32Field("75"), 75);
+}
+
+// ─── Combined master ─────────────────────────────────────
+
+void TestParallelMasterParser::testMatchesMasterFileParser_data()
+{
+    QTest::addColumn<QString>("line");
+    QTest::newRow("NSEFO option, ISO expiry") << QString(kOptionLine);
+    QTest::newRow("BSEFO option, text type") << QString(kTextOptionLine);
+    QTest::newRow("NSEFO future, YYYYMMDD") << QString(kFutureLine);
+    QTest::newRow("NSECM cash") << QString(kCashLine);
+    QTest::newRow("BSECM short cash")
+        << QString("BSECM|500325|8|RELIANCE|RELIANCE|A|RELIANCE-A|500325|3100|2500|"
+                   "100000|0.05|1|1|RELIANCE|INE002A01018");
+}
+
+void TestParallelMasterParser::testMatchesMasterFileParser()
+{
+    QFETCH(QString, line);
+
+    const QString segment = line.left(line.indexOf('|'));
+    MasterContract expected;
+    QVERIFY(MasterFileParser::parseLine(QStringRef(&line), segment, expected));
+
+    const QByteArray utf8 = line.toUtf8();
+    P::Pools pools;
+    MasterContract actual;
+    QVERIFY(P::parseMasterLine(std::string_view(utf8.constData(), utf8.size()), actual, pools));
+    compareContracts(actual, expected);
+}
+
+void TestParallelMasterParser::testRejectsBadLines()
+{
+    P::Pools pools;
+    MasterContract contract;
+    QVERIFY(!P::parseMasterLine("", contract, pools));
+    QVERIFY(!P::parseMasterLine("MCXFO|1|2|3", contract, pools));
+    QVERIFY(!P::parseMasterLine("NSEFO|35001|2|NIFTY", contract, pools));
+    QVERIFY(!P::parseMasterLine(
+        "NSECM|notatoken|8|X|X|EQ|X|1|1|1|1|0.05|1|1|X|INE", contract, pools));
+}
+
+// ─── parseLines ──────────────────────────────────────────
+
+void TestParallelMasterParser::testParseLinesThreadCounts()
+{
+    const QByteArray data = "header|line\r\n" + syntheticCombinedMaster(5000);
+
+    QVector<int64_t> reference;
+    for (int threads : {1, 2, 3, 8}) {
+        P parser;
+        parser.setData(data);
+        parser.setThreadCount(threads);
+        parser.setMinChunkBytes(1);
+
+        P::Pools pools;
+        const auto chunks = parser.parseLines<MasterContract>(
+            [&pools](std::string_view line, std::vector<MasterContract> &out) {
+                MasterContract contract;
+                if (P::parseMasterLine(line, contract, pools))
+                    out.push_back(std::move(contract));
+            },
+            1);
+        QCOMPARE(parser.lastStats().threads, threads);
+        QCOMPARE(parser.lastStats().lines, 5000);
+
+        QVector<int64_t> tokens;
+        const QChar *nameData = nullptr;
+        for (const auto &chunk : chunks) {
+            for (const MasterContract &c : chunk) {
+                tokens.append(c.exchangeInstrumentID);
+                // SYM0 rows may land in different chunks; they share one string
+                if (c.name == "SYM0") {
+                    if (!nameData)
+                        nameData = c.name.constData();
+                    QCOMPARE(c.name.constData(), nameData);
+                }
+            }
+        }
+        QCOMPARE(tokens.size(), 5000);
+        if (reference.isEmpty())
+            reference = tokens;
+        QCOMPARE(tokens, reference);
+        QVERIFY(nameData);
+    }
+    for (int i = 1; i < reference.size(); ++i)
+        QVERIFY(reference[i - 1] < reference[i]);
+}
+
+void TestParallelMasterParser::testParseLinesFromFile()
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath("crlf.csv");
+    {
+        std::ofstream out(path.toStdString(), std::ios::binary);
+        out << "Token,Symbol\r\n1,A\r\n\r\n2,B\r\n3,C";
+    }
+
+    P parser;
+    QVERIFY(parser.open(path));
+    const auto chunks = parser.parseLines<QString>(
+        [](std::string_view line, std::vector<QString> &out) {
+            std::string_view fields[4];
+            P::splitFields(line, ',', fields, 4);
+            out.push_back(P::text(fields[1]));
+        },
+        1);
+    QStringList symbols;
+    for (const auto &chunk : chunks)
+        for (const QString &s : chunk)
+            symbols << s;
+    QCOMPARE(symbols, QStringList({"A", "B", "C"}));
+
+    QVERIFY(!parser.open(dir.filePath("missing.csv")));
+    QCOMPARE(parser.data().size(), size_t(0));
+}
+
+// ─── Benchmark ───────────────────────────────────────────
+
+void TestParallelMasterParser::benchmarkProcessedCsvs()
+{
+    const QDir masters(MASTER_FILES_DIR);
+    const QStringList files = masters.entryList({"*_processed.csv"}, QDir::Files);
+    if (files.isEmpty())
+        QSKIP("No processed CSVs in MasterFiles/");
+
+    for (const QString &name : files) {
+        const QString path = masters.filePath(name);
+
+        // Current loader: getline, QString per line, QStringRef split,
+        // QString per field
+        QElapsedTimer timer;
+        timer.start();
+        int legacyRows = 0;
+        {
+            std::ifstream file(path.toStdString(), std::ios::binary);
+            std::string line;
+            std::getline(file, line);
+            while (std::getline(file, line)) {
+                const QString qLine = QString::fromStdString(line);
+                QVector<QStringRef> fields;
+                int start = 0;
+                int end = 0;
+                while ((end = qLine.indexOf(',', start)) != -1) {
+                    fields.append(qLine.midRef(start, end - start));
+                    start = end + 1;
+                }
+                fields.append(qLine.midRef(start));
+                MasterContract c;
+                c.exchangeInstrumentID = fields[0].toLongLong();
+                c.name = MasterFileParser::trimQuotes(fields.value(1));
+                c.displayName = MasterFileParser::trimQuotes(fields.value(2));
+                c.description = MasterFileParser::trimQuotes(fields.value(3));
+                c.series = MasterFileParser::trimQuotes(fields.value(4));
+                c.lotSize = fields.value(5).toInt();
+                c.tickSize = fields.value(6).toDouble();
+                ++legacyRows;
+            }
+        }
+        const qint64 legacyNs = timer.nsecsElapsed();
+
+        P parser;
+        QVERIFY(parser.open(path));
+        P::Pools pools;
+        const auto chunks = parser.parseLines<MasterContract>(
+            [&pools](std::string_view line, std::vector<MasterContract> &out) {
+                std::string_view fields[32];
+                const int count = P::splitFields(line, ',', fields, 32);
+                MasterContract c;
+                c.exchangeInstrumentID = P::int64Field(fields[0]);
+                if (count > 6) {
+                    c.name = P::internedText(fields[1], pools);
+                    c.displayName = P::text(fields[2]);
+                    c.description = P::text(fields[3]);
+                    c.series = P::internedText(fields[4], pools);
+                    c.lotSize = P::int32Field(fields[5]);
+                    c.tickSize = P::doubleField(fields[6]);
+                }
+                out.push_back(std::move(c));
+            },
+            1);
+        int rows = 0;
+        for (const auto &chunk : chunks)
+            rows += static_cast<int>(chunk.size());
+        QCOMPARE(rows, legacyRows);
+
+        const P::Stats &stats = parser.lastStats();
+        const double legacyMBps =
+            legacyNs > 0 ? (stats.bytes / (1024.0 * 1024.0)) / (legacyNs / 1e9) : 0.0;
+        qDebug().nospace() << name << ": " << stats.bytes / 1024 << " KB, " << rows
+                           << " rows: parallel " << stats.megabytesPerSecond()
+                           << " MB/s (" << stats.threads << " threads), current "
+                           << legacyMBps << " MB/s";
+    }
+}
+
+void TestParallelMasterParser::benchmarkCombinedMaster()
+{
+    const int kLines = 130000;
+    const QByteArray data = syntheticCombinedMaster(kLines);
+
+    // Current path: QString per line, MasterFileParser::parseLine
+    QElapsedTimer timer;
+    timer.start();
+    int legacyParsed = 0;
+    {
+        const QString text = QString::fromUtf8(data);
+        MasterContract contract;
+        int start = 0;
+        int end = 0;
+        while ((end = text.indexOf('\n', start)) != -1) {
+            const QStringRef line = text.midRef(start, end - start);
+            start = end + 1;
+            if (MasterFileParser::parseLine(line, "NSEFO", contract))
+                ++legacyParsed;
+        }
+    }
+    const qint64 legacyNs = timer.nsecsElapsed();
+
+    P parser;
+    parser.setData(data);
+    P::Pools pools;
+    int parsed = 0;
+    QBENCHMARK_ONCE {
+        const auto chunks = parser.parseLines<MasterContract>(
+            [&pools](std::string_view line, std::vector<MasterContract> &out) {
+                MasterContract contract;
+                if (P::parseMasterLine(line, contract, pools))
+                    out.push_back(std::move(contract));
+            });
+        for (const auto &chunk : chunks)
+            parsed += static_cast<int>(chunk.size());
+    }
+    QCOMPARE(parsed, kLines);
+    QCOMPARE(legacyParsed, kLines);
+
+    const P::Stats &stats = parser.lastStats();
+    const double legacyMBps = (data.size() / (1024.0 * 1024.0)) / (legacyNs / 1e9);
+    qDebug().nospace() << "Combined master, " << kLines << " lines ("
+                       << data.size() / 1024 << " KB): parallel "
+                       << stats.megabytesPerSecond() << " MB/s (" << stats.threads
+                       << " threads), MasterFileParser " << legacyMBps << " MB/s";
+}
+
+QTEST_MAIN(TestParallelMasterParser)
+#include "test_parallel_master_parser.moc"
@@ -0,0 +1,626 @@
+/**
+ * @file test_price_store.cpp
+ * @brief Unit tests + contention benchmark for the seqlock price store
+ *
+ * Tests:
+ *  - Initialize / update / snapshot round-trip through nsefo::PriceStore
+ *  - Partial snapshots (getTouchline / getDepth / getGreeks) match the
+ *    corresponding fields of the full snapshot
+ *  - Out-of-range and uninitialised tokens return an empty snapshot
+ *  - Snapshots are never torn while a writer thread hammers the same rows
+ *  - SeqlockPriceSlab growth (rows + token index) keeps existing rows and
+ *    keeps retired storage below the live table's
+ *  - clear() drops rows and allows re-initialisation
+ *  - erase() drops one row and leaves its neighbours untouched
+ *  - Lock-free update() keeps every write while growth adds rows
+ *  - updateGreeks() writes the Greeks block without moving the row version
+ *  - Row versions: every feed write bumps only its row, never the shared
+ *    epoch; changedSince() returns
+ *    exactly the rows written after a watermark, with their latest block
+ *
+ * Benchmarks (1 writer + N readers, N = 1, 2, 4, 8):
+ *  - benchmarkSeqlockReaders:     nsefo::PriceStore::getUnifiedSnapshot()
+ *  - benchmarkSharedMutexReaders: the previous shared_mutex + heap-row
+ *                                 store layout, for comparison
+ *
+ * Benchmarks (bytes copied per read):
+ *  - benchmarkFullSnapshot / benchmarkTouchline: getUnifiedSnapshot() vs
+ *    getTouchline() for an LTP-only reader
+ *
+ * Benchmarks (poll sweep over 2000 rows, 1% of them moved):
+ *  - benchmarkPollSweep: per-token getTouchline() vs changedSince()
+ *
+ * Build: Requires Qt5::Core, Qt5::Test, nsefo_price_store.cpp
+ */
+
+#include <QtTest/QtTest>
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+#include "nsefo_price_store.h"
+#include "data/SeqlockPriceSlab.h"
+
+using MarketData::SeqlockPriceSlab;
+using MarketData::UnifiedState;
+using RowRef = MarketData::SeqlockPriceSlab::RowRef;
+
+// ─── Helpers ─────────────────────────────────────────────
+
+namespace {
+
+constexpr uint32_t kFirstToken = 35000;
+constexpr uint32_t kTokenCount = 2000;
+
+std::vector<uint32_t> makeTokens()
+{
+    std::vector<uint32_t> tokens;
+    for (uint32_t t = kFirstToken; t < kFirstToken + kTokenCount; ++t) tokens.push_back(t);
+    return tokens;
+}
+
+// Writer stamps every field with the same value, so a torn read shows up
+// as a row whose fields disagree
+UnifiedState makeTick(uint32_t token, uint64_t n)
+{
+    UnifiedState s;
+    s.token = token;
+    s.ltp = s.open = s.high = s.low = s.close = static_cast<double>(n);
+    s.volume = n;
+    s.lastPacketTimestamp = static_cast<int64_t>(n);
+    return s;
+}
+
+bool isConsistent(const UnifiedState& s)
+{
+    return s.ltp == s.open && s.ltp == s.high && s.ltp == s.low && s.ltp == s.close &&
+           s.volume == static_cast<uint64_t>(s.ltp) &&
+           s.lastPacketTimestamp == static_cast<int64_t>(s.volume);
+}
+
+// Previous store layout: vector of heap rows behind one shared_mutex
+class SharedMutexStore {
+public:
+    explicit SharedMutexStore(const std::vector<uint32_t>& tokens)
+        : rows_(nsefo::PriceStore::ARRAY_SIZE) {
+        for (uint32_t t : tokens) {
+            rows_[t - nsefo::PriceStore::MIN_TOKEN] = std::make_unique<UnifiedState>();
+            rows_[t - nsefo::PriceStore::MIN_TOKEN]->token = t;
+        }
+    }
+    void updateTouchline(const UnifiedState& d) {
+        std::unique_lock lock(mutex_);
+        auto& row = *rows_[d.token - nsefo::PriceStore::MIN_TOKEN];
+        row.ltp = d.ltp; row.open = d.open; row.high = d.high; row.low = d.low;
+        row.close = d.close; row.volume = d.volume;
+        row.lastPacketTimestamp = d.lastPacketTimestamp;
+    }
+    UnifiedState getUnifiedSnapshot(uint32_t token) const {
+        std::shared_lock lock(mutex_);
+        return *rows_[token - nsefo::PriceStore::MIN_TOKEN];
+    }
+private:
+    std::vector<std::unique_ptr<UnifiedState>> rows_;
+    mutable std::shared_mutex mutex_;
+};
+
+// 1 writer + (readers - 1) background readers; the benchmark thread is the
+// remaining reader
+template <typename Store>
+class ContentionRig {
+public:
+    ContentionRig(Store& store, int readers) : m_store(store) {
+        m_threads.emplace_back([this]() {
+            uint64_t n = 1;
+            while (!m_stop.load(std::memory_order_relaxed)) {
+                m_store.updateTouchline(makeTick(kFirstToken + n % kTokenCount, n));
+                ++n;
+            }
+        });
+        for (int r = 1; r < readers; ++r) {
+            m_threads.emplace_back([this, r]() {
+                uint32_t t = r;
+                while (!m_stop.load(std::memory_order_relaxed)) {
+                    auto s = m_store.getUnifiedSnapshot(kFirstToken + t % kTokenCount);
+                    if (!isConsistent(s)) m_torn.fetch_add(1, std::memory_order_relaxed);
+                    t += 7;
+                }
+            });
+        }
+    }
+    ~ContentionRig() {
+        m_stop = true;
+        for (auto& t : m_threads) t.join();
+    }
+    uint64_t torn() const { return m_torn.load(); }
+
+private:
+    Store& m_store;
+    std::atomic<bool> m_stop{false};
+    std::atomic<uint64_t> m_torn{0};
+    std::vector<std::thread> m_threads;
+};
+
+} // namespace
+
+// ─── Test Class ──────────────────────────────────────────
+
+class TestPriceStore : public QObject {
+    Q_OBJECT
+
+private slots:
+    // nsefo::PriceStore behaviour
+    void testUpdateAndSnapshot();
+    void testUnknownTokens_returnEmpty();
+    void testGreeksAndDepthPartialUpdates();
+    void testPartialSnapshotsMatchFull();
+    void testConcurrentWriter_noTornSnapshots();
+
+    // SeqlockPriceSlab
+    void testSlabGrowthKeepsRows();
+    void testSlabIndexGrowth();
+    void testSlabRetiredStorageBounded();
+    void testSlabClear();
+    void testSlabErase_keepsOtherRows();
+    void testSlabUpdateDuringGrowth();
+    void testSlabGreeksBlock();
+
+    // Versions
+    void testRowVersions();
+    void testChangedSince_returnsOnlyMovedRows();
+
+    // Benchmarks
+    void benchmarkSeqlockReaders_data();
+    void benchmarkSeqlockReaders();
+    void benchmarkSharedMutexReaders_data();
+    void benchmarkSharedMutexReaders();
+    void benchmarkFullSnapshot();
+    void benchmarkTouchline();
+    void benchmarkPollSweep_data();
+    void benchmarkPollSweep();
+};
+
+// ─── nsefo::PriceStore behaviour ─────────────────────────
+
+void TestPriceStore::testUpdateAndSnapshot()
+{
+    nsefo::PriceStore store;
+    store.initializeToken(kFirstToken, "NIFTY", "NIFTY 27FEB 22000 CE", 75, 22000.0,
+                          "CE", "27FEB2025", 26000, 2, 0.05);
+    store.initializeFromMaster({kFirstToken});
+    QCOMPARE(store.getValidTokenCount(), size_t(1));
+
+    store.updateTouchline(makeTick(kFirstToken, 125));
+    auto s = store.getUnifiedSnapshot(kFirstToken);
+    QCOMPARE(s.token, kFirstToken);
+    QCOMPARE(s.ltp, 125.0);
+    QCOMPARE(s.volume, uint64_t(125));
+    QCOMPARE(QString(s.symbol), QString("NIFTY"));
+    QCOMPARE(s.lotSize, 75);
+}
+
+void TestPriceStore::testUnknownTokens_returnEmpty()
+{
+    nsefo::PriceStore store;
+    store.initializeFromMaster({kFirstToken});
+
+    QCOMPARE(store.getUnifiedSnapshot(kFirstToken + 1).token, 0u);
+    QCOMPARE(store.getUnifiedSnapshot(10).token, 0u);
+    QCOMPARE(store.getUnifiedSnapshot(nsefo::PriceStore::MAX_TOKEN + 1).token, 0u);
+
+    // Updates for unknown tokens are dropped
+    store.updateTouchline(makeTick(kFirstToken + 1, 5));
+    QCOMPARE(store.getUnifiedSnapshot(kFirstToken + 1).token, 0u);
+}
+
+void TestPriceStore::testGreeksAndDepthPartialUpdates()
+{
+    nsefo::PriceStore store;
+    store.initializeFromMaster({kFirstToken});
+    store.updateTouchline(makeTick(kFirstToken, 100));
+
+    UnifiedState depth;
+    depth.token = kFirstToken;
+    depth.bids[0] = MarketData::DepthLevel(99.5, 150, 3);
+    depth.asks[0] = MarketData::DepthLevel(100.5, 75, 1);
+    store.updateDepth(depth);
+    store.updateGreeks(kFirstToken, 0.18, 0.17, 0.19, 0.52, 0.001, 12.5, -3.2, 101.0, 42);
+
+    auto s = store.getUnifiedSnapshot(kFirstToken);
+    QCOMPARE(s.ltp, 100.0);                 // Touchline untouched by depth/greeks
+    QCOMPARE(s.bids[0].price, 99.5);
+    QCOMPARE(s.asks[0].quantity, 75u);
+    QCOMPARE(s.delta, 0.52);
+    QVERIFY(s.greeksCalculated);
+}
+
+void TestPriceStore::testConcurrentWriter_noTornSnapshots()
+{
+    nsefo::PriceStore store;
+    store.initializeFromMaster(makeTokens());
+
+    uint64_t torn = 0;
+    {
+        ContentionRig<nsefo::PriceStore> rig(store, 4);
+        for (int i = 0; i < 200000; ++i) {
+            if (!isConsistent(store.getUnifiedSnapshot(kFirstToken + i % kTokenCount))) ++torn;
+        }
+        torn += rig.torn();
+    }
+    QCOMPARE(torn, uint64_t(0));
+}
+
+void TestPriceStore::testPartialSnapshotsMatchFull()
+{
+    nsefo::PriceStore store;
+    store.initializeToken(kFirstToken, "BANKNIFTY", "BANKNIFTY 27FEB 48000 PE", 15,
+                          48000.0, "PE", "27FEB2025", 26009, 2, 0.05);
+    store.initializeFromMaster({kFirstToken});
+    store.updateTouchline(makeTick(kFirstToken, 310));
+
+    UnifiedState depth;
+    depth.token = kFirstToken;
+    depth.bids[2] = MarketData::DepthLevel(308.0, 45, 2);
+    depth.totalSellQty = 9000;
+    store.updateDepth(depth);
+    store.updateGreeks(kFirstToken, 0.21, 0.2, 0.22, -0.41, 0.002, 9.1, -5.5, 309.5, 7);
+
+    auto full = store.getUnifiedSnapshot(kFirstToken);
+    auto tick = store.getTouchline(kFirstToken);
+    auto book = store.getDepth(kFirstToken);
+    auto greeks = store.getGreeks(kFirstToken);
+
+    QCOMPARE(tick.token, kFirstToken);
+    QCOMPARE(tick.ltp, full.ltp);
+    QCOMPARE(tick.volume, full.volume);
+    QCOMPARE(book.bids[2].price, full.bids[2].price);
+    QCOMPARE(book.totalSellQty, uint64_t(9000));
+    QCOMPARE(greeks.delta, full.delta);
+    QCOMPARE(QString(full.symbol), QString("BANKNIFTY"));
+
+    // Unknown tokens give empty blocks
+    QCOMPARE(store.getTouchline(kFirstToken + 5).token, 0u);
+    QVERIFY(!store.getGreeks(kFirstToken + 5).greeksCalculated);
+
+    // The touchline block is what makes per-tick reads cheap
+    QVERIFY(sizeof(MarketData::TouchlineState) * 4 <= sizeof(UnifiedState));
+}
+
+// ─── SeqlockPriceSlab ────────────────────────────────────
+
+void TestPriceStore::testSlabGrowthKeepsRows()
+{
+    SeqlockPriceSlab slab(0, 100);
+    for (uint32_t t = 0; t < 100; ++t) {
+        slab.initialize(t, [t](RowRef r) { r.tick.token = t; r.tick.ltp = t * 2.0; });
+    }
+    QVERIFY(slab.capacity() >= 100);
+
+    slab.reserve(5000);  // Forces a new slab
+    QCOMPARE(slab.size(), size_t(100));
+    for (uint32_t t = 0; t < 100; ++t) {
+        UnifiedState s;
+        QVERIFY(slab.read(t, s));
+        QCOMPARE(s.ltp, t * 2.0);
+    }
+}
+
+void TestPriceStore::testSlabIndexGrowth()
+{
+    SeqlockPriceSlab slab(0, 10);
+    slab.initialize(5, [](RowRef r) { r.tick.token = 5; });
+    slab.initialize(1174262, [](RowRef r) { r.tick.token = 1174262; });
+
+    QVERIFY(slab.indexSize() > 1174262);
+    QVERIFY(slab.contains(5));
+    QVERIFY(slab.contains(1174262));
+    QVERIFY(!slab.contains(6));
+
+    UnifiedState s;
+    QVERIFY(slab.read(1174262, s));
+    QCOMPARE(s.token, 1174262u);
+}
+
+void TestPriceStore::testSlabRetiredStorageBounded()
+{
+    SeqlockPriceSlab slab(0, 10);
+    QCOMPARE(slab.retiredBytes(), size_t(0));
+
+    // Many small reserve steps plus rows / tokens added one at a time
+    for (size_t rows = 1; rows <= 3000; rows += 7) slab.reserve(rows);
+    for (uint32_t t = 0; t < 20000; t += 3) {
+        slab.reserveTokens(t);
+        slab.initialize(t, [t](RowRef r) { r.tick.token = t; });
+    }
+    QCOMPARE(slab.size(), size_t(6667));
+    QVERIFY(slab.retiredBytes() > 0);
+    QVERIFY(slab.retiredBytes() <= slab.liveBytes());
+
+    UnifiedState s;
+    QVERIFY(slab.read(19998, s));
+    QCOMPARE(s.token, 19998u);
+}
+
+void TestPriceStore::testSlabClear()
+{
+    SeqlockPriceSlab slab(0, 10);
+    slab.initialize(3, [](RowRef r) { r.tick.token = 3; r.tick.ltp = 9.0; });
+    slab.clear();
+    QVERIFY(!slab.contains(3));
+    QCOMPARE(slab.size(), size_t(0));
+    QVERIFY(!slab.update(3, [](RowRef r) { r.tick.ltp = 1.0; }));
+
+    slab.initialize(3, [](RowRef r) { r.tick.token = 3; });
+    UnifiedState s;
+    QVERIFY(slab.read(3, s));
+    QCOMPARE(s.ltp, 0.0);   // Old values do not leak through
+}
+
+void TestPriceStore::testSlabErase_keepsOtherRows()
+{
+    SeqlockPriceSlab slab(0, 10);
+    slab.initialize(3, [](RowRef r) { r.tick.token = 3; r.tick.ltp = 9.0; });
+    slab.initialize(4, [](RowRef r) { r.tick.token = 4; r.tick.ltp = 8.0; });
+
+    QVERIFY(slab.erase(3));
+    QVERIFY(!slab.erase(3));
+    QVERIFY(!slab.contains(3));
+    QVERIFY(!slab.update(3, [](RowRef r) { r.tick.ltp = 1.0; }));
+
+    UnifiedState s;
+    QVERIFY(slab.read(4, s));
+    QCOMPARE(s.ltp, 8.0);
+
+    // Re-adding takes a fresh row
+    slab.initialize(3, [](RowRef r) { r.tick.token = 3; });
+    QVERIFY(slab.read(3, s));
+    QCOMPARE(s.ltp, 0.0);
+    QCOMPARE(slab.size(), size_t(3));
+}
+
+void TestPriceStore::testSlabUpdateDuringGrowth()
+{
+    // Lock-free update() races initialize(): growth must not lose writes
+    SeqlockPriceSlab slab(0, 10);
+    constexpr uint32_t kRows = 64;
+    constexpr int kWrites = 20000;
+    for (uint32_t t = 0; t < kRows; ++t) {
+        slab.initialize(t, [t](RowRef r) { r.tick.token = t; });
+    }
+
+    std::thread writer([&slab] {
+        for (int n = 1; n <= kWrites; ++n) {
+            for (uint32_t t = 0; t < kRows; ++t) {
+                slab.update(t, [n](RowRef r) { r.tick.volume = n; });
+            }
+        }
+    });
+    for (uint32_t t = kRows; t < 5 * SeqlockPriceSlab::kChunkRows; ++t) {
+        slab.initialize(t, [t](RowRef r) { r.tick.token = t; });
+    }
+    writer.join();
+
+    QVERIFY(slab.capacity() >= 5 * SeqlockPriceSlab::kChunkRows);
+    for (uint32_t t = 0; t < kRows; ++t) {
+        MarketData::TouchlineState tick;
+        QVERIFY(slab.readTouchline(t, tick));
+        QCOMPARE(tick.volume, uint64_t(kWrites));
+        QCOMPARE(slab.rowVersion(t), uint64_t(2 + kWrites));   // Create + init + updates
+    }
+}
+
+void TestPriceStore::testSlabGreeksBlock()
+{
+    SeqlockPriceSlab slab(0, 10);
+    slab.initialize(3, [](RowRef r) { r.tick.token = 3; r.tick.ltp = 9.0; });
+    const uint64_t version = slab.rowVersion(3);
+
+    QVERIFY(slab.updateGreeks(3, [](MarketData::GreeksState& g) { g.delta = 0.4; }));
+    QVERIFY(!slab.updateGreeks(4, [](MarketData::GreeksState& g) { g.delta = 1.0; }));
+    QCOMPARE(slab.rowVersion(3), version);   // Feed row untouched
+
+    UnifiedState s;
+    QVERIFY(slab.read(3, s));
+    QCOMPARE(s.ltp, 9.0);
+    QCOMPARE(s.delta, 0.4);
+
+    // Removing the row resets its Greeks too
+    QVERIFY(slab.erase(3));
+    slab.initialize(3, [](RowRef r) { r.tick.token = 3; });
+    MarketData::GreeksState greeks;
+    QVERIFY(slab.readGreeks(3, greeks));
+    QCOMPARE(greeks.delta, 0.0);
+}
+
+// ─── Versions ────────────────────────────────────────────
+
+void TestPriceStore::testRowVersions()
+{
+    nsefo::PriceStore store;
+    store.initializeFromMaster({kFirstToken, kFirstToken + 1});
+    const uint64_t epoch = store.getVersion();
+    const uint64_t first = store.getRowVersion(kFirstToken);
+    QVERIFY(first > 0);   // Initialisation is a write
+    QCOMPARE(store.getRowVersion(kFirstToken + 5), uint64_t(0));
+
+    const uint64_t other = store.getRowVersion(kFirstToken + 1);
+    store.updateTouchline(makeTick(kFirstToken, 10));
+    QCOMPARE(store.getRowVersion(kFirstToken), first + 1);
+    QCOMPARE(store.getRowVersion(kFirstToken + 1), other);
+    QCOMPARE(store.getVersion(), epoch);   // Writes never touch the shared epoch
+
+    // Greeks have their own sequence: results keyed on a row version stay valid
+    store.updateGreeks(kFirstToken + 1, 0.2, 0.19, 0.21, 0.5, 0.01, 0.1, -0.05, 12.0, 0);
+    QCOMPARE(store.getRowVersion(kFirstToken + 1), other);
+    QCOMPARE(store.getGreeks(kFirstToken + 1).delta, 0.5);
+
+    // Dropped updates do not create a row
+    store.updateTouchline(makeTick(kFirstToken + 5, 1));
+    QCOMPARE(store.getRowVersion(kFirstToken + 5), uint64_t(0));
+}
+
+void TestPriceStore::testChangedSince_returnsOnlyMovedRows()
+{
+    nsefo::PriceStore store;
+    const std::vector<uint32_t> tokens = makeTokens();
+    store.initializeFromMaster(tokens);
+
+    std::vector<MarketData::TouchlineChange> changes;
+    uint64_t watermark = store.changedSince(0, tokens.data(), tokens.size(), changes);
+    QCOMPARE(changes.size(), tokens.size());   // Everything is new to a first poll
+
+    store.updateTouchline(makeTick(kFirstToken + 7, 1));
+    store.updateTouchline(makeTick(kFirstToken + 42, 2));
+    store.updateTouchline(makeTick(kFirstToken + 7, 3));
+
+    changes.clear();
+    watermark = store.changedSince(watermark, tokens.data(), tokens.size(), changes);
+    QCOMPARE(changes.size(), size_t(2));
+    QCOMPARE(changes[0].token, kFirstToken + 7);
+    QCOMPARE(changes[0].block.ltp, 3.0);                 // Latest value
+    QCOMPARE(changes[0].version, store.getRowVersion(kFirstToken + 7));
+    QCOMPARE(changes[1].token, kFirstToken + 42);
+    QCOMPARE(changes[1].block.ltp, 2.0);
+    QVERIFY(watermark < store.getVersion());   // Each poll advances the epoch
+
+    changes.clear();
+    watermark = store.changedSince(watermark, tokens.data(), tokens.size(), changes);
+    QVERIFY(changes.empty());
+
+    // Other blocks, and tokens outside the store are skipped
+    store.updateGreeks(kFirstToken + 9, 0.2, 0.19, 0.21, 0.5, 0.01, 0.1, -0.05, 12.0, 0);
+    const uint32_t asked[] = {kFirstToken + 9, kFirstToken + 7, 10};
+    std::vector<MarketData::GreeksChange> greeks;
+    store.changedSince(watermark, asked, 3, greeks);
+    QCOMPARE(greeks.size(), size_t(1));
+    QCOMPARE(greeks[0].block.delta, 0.5);
+}
+
+// ─── Benchmarks ──────────────────────────────────────────
+
+void TestPriceStore::benchmarkSeqlockReaders_data()
+{
+    QTest::addColumn<int>("readers");
+    QTest::newRow("1 reader") << 1;
+    QTest::newRow("2 readers") << 2;
+    QTest::newRow("4 readers") << 4;
+    QTest::newRow("8 readers") << 8;
+}
+
+void TestPriceStore::benchmarkSeqlockReaders()
+{
+    QFETCH(int, readers);
+    nsefo::PriceStore store;
+    store.initializeFromMaster(makeTokens());
+    ContentionRig<nsefo::PriceStore> rig(store, readers);
+
+    double sink = 0;
+    QBENCHMARK {
+        for (uint32_t i = 0; i < 10000; ++i) {
+            sink += store.getUnifiedSnapshot(kFirstToken + (i * 13) % kTokenCount).ltp;
+        }
+    }
+    QVERIFY(sink >= 0);
+    QCOMPARE(rig.torn(), uint64_t(0));
+}
+
+void TestPriceStore::benchmarkSharedMutexReaders_data()
+{
+    benchmarkSeqlockReaders_data();
+}
+
+void TestPriceStore::benchmarkSharedMutexReaders()
+{
+    QFETCH(int, readers);
+    SharedMutexStore store(makeTokens());
+    ContentionRig<SharedMutexStore> rig(store, readers);
+
+    double sink = 0;
+    QBENCHMARK {
+        for (uint32_t i = 0; i < 10000; ++i) {
+            sink += store.getUnifiedSnapshot(kFirstToken + (i * 13) % kTokenCount).ltp;
+        }
+    }
+    QVERIFY(sink >= 0);
+}
+
+void TestPriceStore::benchmarkFullSnapshot()
+{
+    nsefo::PriceStore store;
+    store.initializeFromMaster(makeTokens());
+
+    double sink = 0;
+    QBENCHMARK {
+        for (uint32_t i = 0; i < 10000; ++i) {
+            sink += store.getUnifiedSnapshot(kFirstToken + (i * 13) % kTokenCount).ltp;
+        }
+    }
+    QVERIFY(sink >= 0);
+}
+
+void TestPriceStore::benchmarkTouchline()
+{
+    nsefo::PriceStore store;
+    store.initializeFromMaster(makeTokens());
+
+    double sink = 0;
+    QBENCHMARK {
+        for (uint32_t i = 0; i < 10000; ++i) {
+            sink += store.getTouchline(kFirstToken + (i * 13) % kTokenCount).ltp;
+        }
+    }
+    QVERIFY(sink >= 0);
+}
+
+void TestPriceStore::benchmarkPollSweep_data()
+{
+    QTest::addColumn<bool>("versioned");
+    QTest::newRow("getTouchline per token") << false;
+    QTest::newRow("changedSince") << true;
+}
+
+void TestPriceStore::benchmarkPollSweep()
+{
+    QFETCH(bool, versioned);
+    nsefo::PriceStore store;
+    const std::vector<uint32_t> tokens = makeTokens();
+    store.initializeFromMaster(tokens);
+
+    // A poller (Greeks sweep / position book) that only acts on moved rows:
+    // without versions it must copy and compare every row
+    std::vector<double> lastLtp(tokens.size(), -1.0);
+    std::vector<MarketData::TouchlineChange> changes;
+    uint64_t watermark = 0;
+    uint64_t n = 1;
+    int moved = 0;
+
+    QBENCHMARK {
+        for (uint32_t i = 0; i < kTokenCount / 100; ++i, ++n)
+            store.updateTouchline(makeTick(kFirstToken + (n * 37) % kTokenCount, n));
+
+        moved = 0;
+        if (versioned) {
+            changes.clear();
+            watermark = store.changedSince(watermark, tokens.data(), tokens.size(), changes);
+            for (const auto& change : changes) {
+                lastLtp[change.token - kFirstToken] = change.block.ltp;
+                ++moved;
+            }
+        } else {
+            for (size_t i = 0; i < tokens.size(); ++i) {
+                const double ltp = store.getTouchline(tokens[i]).ltp;
+                if (ltp != lastLtp[i]) {
+                    lastLtp[i] = ltp;
+                    ++moved;
+                }
+            }
+        }
+    }
+    QVERIFY(moved > 0);
+}
+
+// ─── Main ────────────────────────────────────────────────
+
+QTEST_MAIN(TestPriceStore)
+#include "test_price_store.moc"
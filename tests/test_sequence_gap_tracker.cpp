@@ -0,0 +1,146 @@
+/**
+ * @file test_sequence_gap_tracker.cpp
+ * @brief Unit tests for per-stream NSE bcSeqNo gap detection
+ *
+ * Tests:
+ *  - In-order stream reports nothing
+ *  - Forward jump counts one gap, its size and the histogram bucket
+ *  - Late arrival inside the window is recovered; a repeat is a duplicate
+ *  - Interleaved streams with unrelated counters report no false gaps
+ *  - Huge jumps (feed restart) reset the stream instead of counting a gap
+ *  - observeHeader() decodes big-endian BCAST_HEADER fields
+ *
+ * Build: Requires Qt5::Core, Qt5::Test
+ */
+
+#include <QtTest/QtTest>
+#include <cstdint>
+#include "sequence_gap_tracker.h"
+
+using common::SequenceGapTracker;
+
+class TestSequenceGapTracker : public QObject {
+    Q_OBJECT
+
+private slots:
+    // ─── Single stream ───
+    void testInOrder();
+    void testGap();
+    void testRecoveredAndDuplicate();
+
+    // ─── Multiple streams ───
+    void testInterleavedStreams();
+    void testReset();
+
+    // ─── Wire format ───
+    void testObserveHeader();
+};
+
+// ─── Single stream ───────────────────────────────────────
+
+void TestSequenceGapTracker::testInOrder()
+{
+    SequenceGapTracker tracker;
+    for (uint32_t seq = 100; seq < 200; ++seq) tracker.observe(1, seq);
+
+    const auto c = tracker.counters();
+    QCOMPARE(c.gaps, uint64_t(0));
+    QCOMPARE(c.outOfOrder, uint64_t(0));
+    QCOMPARE(c.streams, uint64_t(1));
+}
+
+void TestSequenceGapTracker::testGap()
+{
+    SequenceGapTracker tracker;
+    tracker.observe(1, 10);
+    tracker.observe(1, 11);
+    tracker.observe(1, 15);   // 12..14 missing
+    tracker.observe(1, 17);   // 16 missing
+
+    const auto c = tracker.counters();
+    QCOMPARE(c.gaps, uint64_t(2));
+    QCOMPARE(c.missing, uint64_t(4));
+    QCOMPARE(c.maxGap, uint64_t(3));
+    QCOMPARE(c.gapSizes[0], uint64_t(1));
+    QCOMPARE(c.gapSizes[1], uint64_t(1));
+    QCOMPARE(c.netLost(), uint64_t(4));
+}
+
+void TestSequenceGapTracker::testRecoveredAndDuplicate()
+{
+    SequenceGapTracker tracker;
+    tracker.observe(1, 10);
+    tracker.observe(1, 13);   // 11, 12 missing
+    tracker.observe(1, 12);   // late fill
+    tracker.observe(1, 12);   // duplicate
+    tracker.observe(1, 13);   // duplicate of latest
+
+    const auto c = tracker.counters();
+    QCOMPARE(c.missing, uint64_t(2));
+    QCOMPARE(c.recovered, uint64_t(1));
+    QCOMPARE(c.outOfOrder, uint64_t(1));
+    QCOMPARE(c.duplicates, uint64_t(2));
+    QCOMPARE(c.netLost(), uint64_t(1));
+}
+
+// ─── Multiple streams ────────────────────────────────────
+
+void TestSequenceGapTracker::testInterleavedStreams()
+{
+    // Two streams whose counters are millions apart – a single global
+    // "last seq" would report a huge gap on every switch
+    SequenceGapTracker tracker;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        tracker.observe(7200, 7146537 + i);
+        tracker.observe(7208, 1008990 + i);
+    }
+
+    const auto c = tracker.counters();
+    QCOMPARE(c.gaps, uint64_t(0));
+    QCOMPARE(c.resets, uint64_t(0));
+    QCOMPARE(c.streams, uint64_t(2));
+}
+
+void TestSequenceGapTracker::testReset()
+{
+    SequenceGapTracker tracker;
+    tracker.observe(1, 5000000);
+    tracker.observe(1, 1);        // Feed restarted from 1
+    tracker.observe(1, 2);
+
+    const auto c = tracker.counters();
+    QCOMPARE(c.resets, uint64_t(1));
+    QCOMPARE(c.gaps, uint64_t(0));
+    QCOMPARE(c.outOfOrder, uint64_t(0));
+}
+
+// ─── Wire format ─────────────────────────────────────────
+
+void TestSequenceGapTracker::testObserveHeader()
+{
+    uint8_t header[SequenceGapTracker::kMinHeaderSize] = {};
+    auto put = [&](uint32_t txCode, uint32_t seq) {
+        header[SequenceGapTracker::kTxCodeOffset] = uint8_t(txCode >> 8);
+        header[SequenceGapTracker::kTxCodeOffset + 1] = uint8_t(txCode);
+        header[SequenceGapTracker::kSeqNoOffset] = uint8_t(seq >> 24);
+        header[SequenceGapTracker::kSeqNoOffset + 1] = uint8_t(seq >> 16);
+        header[SequenceGapTracker::kSeqNoOffset + 2] = uint8_t(seq >> 8);
+        header[SequenceGapTracker::kSeqNoOffset + 3] = uint8_t(seq);
+    };
+
+    SequenceGapTracker tracker;
+    put(7200, 0x01020300);
+    tracker.observeHeader(header);
+    put(7200, 0x01020305);        // 4 missing
+    tracker.observeHeader(header);
+    put(7202, 42);                // Different stream
+    tracker.observeHeader(header);
+
+    const auto c = tracker.counters();
+    QCOMPARE(c.gaps, uint64_t(1));
+    QCOMPARE(c.missing, uint64_t(4));
+    QCOMPARE(c.streams, uint64_t(2));
+}
+
+QTEST_MAIN(TestSequenceGapTracker)
+#include "test_sequence_gap_tracker.moc"
@@ -0,0 +1,104 @@
+/**
+ * @file test_spsc_ring.cpp
+ * @brief Unit tests for the receiver → GUI thread SPSC tick ring
+ *
+ * Tests:
+ *  - Capacity rounds up to a power of two
+ *  - Push/drain preserves FIFO order; a full ring rejects pushes
+ *  - High-water mark tracks the deepest fill
+ *  - One producer + one consumer thread: every value arrives once, in order
+ *
+ * Build: Requires Qt5::Core, Qt5::Test
+ */
+
+#include <QtTest/QtTest>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "utils/SpscRing.h"
+
+class TestSpscRing : public QObject {
+    Q_OBJECT
+
+private slots:
+    // ─── Single thread ───
+    void testCapacityRoundsUp();
+    void testFifoAndFull();
+    void testHighWater();
+
+    // ─── Producer / consumer ───
+    void testConcurrentOrdering();
+};
+
+// ─── Single thread ───────────────────────────────────────
+
+void TestSpscRing::testCapacityRoundsUp()
+{
+    SpscRing<int> ring(1000);
+    QCOMPARE(ring.capacity(), size_t(1024));
+    QCOMPARE(ring.size(), size_t(0));
+}
+
+void TestSpscRing::testFifoAndFull()
+{
+    SpscRing<int> ring(4);
+    for (int i = 0; i < 4; ++i) QVERIFY(ring.tryPush(i));
+    QVERIFY(!ring.tryPush(99));
+    QCOMPARE(ring.size(), size_t(4));
+
+    std::vector<int> out;
+    QCOMPARE(ring.drain([&](const int& v) { out.push_back(v); }), size_t(4));
+    QCOMPARE(out, (std::vector<int>{0, 1, 2, 3}));
+    QCOMPARE(ring.size(), size_t(0));
+
+    // Slots are reusable after a drain (indices wrap)
+    QVERIFY(ring.tryPush(4));
+    QVERIFY(ring.tryPush(5));
+    out.clear();
+    ring.drain([&](const int& v) { out.push_back(v); });
+    QCOMPARE(out, (std::vector<int>{4, 5}));
+}
+
+void TestSpscRing::testHighWater()
+{
+    SpscRing<int> ring(8);
+    for (int i = 0; i < 5; ++i) ring.tryPush(i);
+    ring.drain([](const int&) {});
+    ring.tryPush(1);
+    QCOMPARE(ring.highWater(), size_t(5));
+}
+
+// ─── Producer / consumer ─────────────────────────────────
+
+void TestSpscRing::testConcurrentOrdering()
+{
+    constexpr int kCount = 200000;
+    SpscRing<int> ring(256);
+    std::atomic<bool> done{false};
+
+    std::thread producer([&] {
+        for (int i = 0; i < kCount; ++i) {
+            while (!ring.tryPush(i)) std::this_thread::yield();
+        }
+        done = true;
+    });
+
+    int expected = 0;
+    bool ordered = true;
+    auto consume = [&](const int& v) {
+        if (v != expected) ordered = false;
+        ++expected;
+    };
+    while (!done.load()) {
+        if (ring.drain(consume) == 0) std::this_thread::yield();
+    }
+    ring.drain(consume);
+    producer.join();
+
+    QVERIFY(ordered);
+    QCOMPARE(expected, kCount);
+    QVERIFY(ring.highWater() <= ring.capacity());
+}
+
+QTEST_MAIN(TestSpscRing)
+#include "test_spsc_ring.moc"
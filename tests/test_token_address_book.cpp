@@ -0,0 +1,276 @@
+/**
+ * @file test_token_address_book.cpp
+ * @brief Unit tests for TokenAddressBook — tick→row routing for market watch
+ *
+ * Tests:
+ *  - Int64 (segment, token) lookups, duplicates listed once per row
+ *  - Span and QList lookups agree
+ *  - Row insert/remove/move renumber only the shifted rows, duplicates included
+ *  - Deleting from the open-addressed table keeps other probe chains reachable
+ *  - Composite string keys: lookup, reverse lookup, removal
+ *  - Benchmark: 100k lookups against a 2,000-row watch with duplicates,
+ *    flat table vs the previous QMap<int64_t, QList<int>> layout
+ *
+ * Build: Requires Qt5::Core, Qt5::Test
+ */
+
+#include <QtTest/QtTest>
+#include <QElapsedTimer>
+#include <QMap>
+#include "models/domain/TokenAddressBook.h"
+
+namespace {
+
+constexpr int kNseFo = 2;
+constexpr int kNseCm = 1;
+
+QList<int> sorted(QList<int> rows)
+{
+    std::sort(rows.begin(), rows.end());
+    return rows;
+}
+
+QList<int> spanToList(TokenAddressBook::RowSpan rows)
+{
+    QList<int> list;
+    for (int row : rows) list.append(row);
+    return sorted(list);
+}
+
+} // namespace
+
+class TestTokenAddressBook : public QObject {
+    Q_OBJECT
+
+private slots:
+    // ─── Int64 keys ───
+    void testIntKeyLookup();
+    void testIntKeyDuplicates();
+    void testIntKeyRemove();
+    void testEraseKeepsProbeChains();
+
+    // ─── Row shifts ───
+    void testRowsInserted();
+    void testRowsRemoved();
+    void testRowMoved();
+
+    // ─── Composite keys ───
+    void testCompositeKeys();
+
+    // ─── Benchmarks ───
+    void benchmarkIntKeyLookup_data();
+    void benchmarkIntKeyLookup();
+};
+
+// ─── Int64 keys ──────────────────────────────────────────
+
+void TestTokenAddressBook::testIntKeyLookup()
+{
+    TokenAddressBook book;
+    book.addIntKeyToken(kNseFo, 35001, 0);
+    book.addIntKeyToken(kNseCm, 35001, 1);   // Same token, other segment
+
+    QCOMPARE(book.getRowsForIntKey(kNseFo, 35001), QList<int>{0});
+    QCOMPARE(book.getRowsForIntKey(kNseCm, 35001), QList<int>{1});
+    QVERIFY(book.getRowsForIntKey(kNseFo, 35002).isEmpty());
+    QVERIFY(book.rowsForIntKey(kNseFo, 35002).empty());
+
+    QCOMPARE(book.getIntKeyForRow(1), TokenAddressBook::makeIntKey(kNseCm, 35001));
+    QCOMPARE(book.getIntKeyForRow(7), int64_t(0));
+    QCOMPARE(book.getRowsForIntKey(TokenAddressBook::makeIntKey(kNseFo, 35001)),
+             QList<int>{0});
+}
+
+void TestTokenAddressBook::testIntKeyDuplicates()
+{
+    TokenAddressBook book;
+    book.addIntKeyToken(kNseFo, 49508, 2);
+    book.addIntKeyToken(kNseFo, 49508, 5);
+    book.addIntKeyToken(kNseFo, 49508, 5);   // Re-adding a row is a no-op
+    book.addIntKeyToken(kNseFo, 49508, 9);
+
+    QCOMPARE(spanToList(book.rowsForIntKey(kNseFo, 49508)), (QList<int>{2, 5, 9}));
+    QCOMPARE(sorted(book.getRowsForIntKey(kNseFo, 49508)), (QList<int>{2, 5, 9}));
+}
+
+void TestTokenAddressBook::testIntKeyRemove()
+{
+    TokenAddressBook book;
+    book.addIntKeyToken(kNseFo, 49508, 2);
+    book.addIntKeyToken(kNseFo, 49508, 5);
+
+    book.removeIntKeyToken(kNseFo, 49508, 2);
+    QCOMPARE(book.getRowsForIntKey(kNseFo, 49508), QList<int>{5});
+    QCOMPARE(book.getIntKeyForRow(2), int64_t(0));
+
+    book.removeIntKeyToken(kNseFo, 49508, 5);
+    QVERIFY(book.rowsForIntKey(kNseFo, 49508).empty());
+
+    book.clear();
+    QVERIFY(book.rowsForIntKey(kNseFo, 49508).empty());
+}
+
+void TestTokenAddressBook::testEraseKeepsProbeChains()
+{
+    TokenAddressBook book;
+    constexpr int kTokens = 5000;
+    for (int i = 0; i < kTokens; ++i) book.addIntKeyToken(kNseFo, 35000 + i, i);
+
+    // Delete every other key; backward shift must keep the rest reachable
+    for (int i = 0; i < kTokens; i += 2) book.removeIntKeyToken(kNseFo, 35000 + i, i);
+
+    bool ok = true;
+    for (int i = 0; i < kTokens; ++i) {
+        auto rows = book.rowsForIntKey(kNseFo, 35000 + i);
+        if (i % 2 == 0) ok = ok && rows.empty();
+        else ok = ok && rows.size() == 1 && rows[0] == i;
+    }
+    QVERIFY(ok);
+}
+
+// ─── Row shifts ──────────────────────────────────────────
+
+void TestTokenAddressBook::testRowsInserted()
+{
+    TokenAddressBook book;
+    // rows: 0=A 1=B 2=A 3=C
+    book.addIntKeyToken(kNseFo, 100, 0);
+    book.addIntKeyToken(kNseFo, 200, 1);
+    book.addIntKeyToken(kNseFo, 100, 2);
+    book.addIntKeyToken(kNseFo, 300, 3);
+
+    // Two rows inserted at 1: B, A, C move down by two; row 0 stays
+    book.onRowsInserted(1, 2);
+    QCOMPARE(spanToList(book.rowsForIntKey(kNseFo, 100)), (QList<int>{0, 4}));
+    QCOMPARE(book.getRowsForIntKey(kNseFo, 200), QList<int>{3});
+    QCOMPARE(book.getRowsForIntKey(kNseFo, 300), QList<int>{5});
+    QCOMPARE(book.getIntKeyForRow(1), int64_t(0));
+    QCOMPARE(book.getIntKeyForRow(5), TokenAddressBook::makeIntKey(kNseFo, 300));
+
+    // Appending past the end shifts nothing
+    book.onRowsInserted(6, 1);
+    QCOMPARE(book.getRowsForIntKey(kNseFo, 300), QList<int>{5});
+}
+
+void TestTokenAddressBook::testRowsRemoved()
+{
+    TokenAddressBook book;
+    // Adjacent duplicates exercise the rewrite order: 0=X 1=A 2=A 3=A 4=B
+    book.addIntKeyToken(kNseFo, 50, 0);
+    for (int row = 1; row <= 3; ++row) book.addIntKeyToken(kNseFo, 100, row);
+    book.addIntKeyToken(kNseFo, 200, 4);
+
+    book.onRowsRemoved(0, 1);
+    QVERIFY(book.rowsForIntKey(kNseFo, 50).empty());
+    QCOMPARE(spanToList(book.rowsForIntKey(kNseFo, 100)), (QList<int>{0, 1, 2}));
+    QCOMPARE(book.getRowsForIntKey(kNseFo, 200), QList<int>{3});
+
+    // Remove the middle duplicate
+    book.onRowsRemoved(1, 1);
+    QCOMPARE(spanToList(book.rowsForIntKey(kNseFo, 100)), (QList<int>{0, 1}));
+    QCOMPARE(book.getRowsForIntKey(kNseFo, 200), QList<int>{2});
+    QCOMPARE(book.getIntKeyForRow(2), TokenAddressBook::makeIntKey(kNseFo, 200));
+    QCOMPARE(book.getIntKeyForRow(3), int64_t(0));
+}
+
+void TestTokenAddressBook::testRowMoved()
+{
+    TokenAddressBook book;
+    book.addIntKeyToken(kNseFo, 100, 0);
+    book.addCompositeToken("NSEFO", "", 100, 0);
+
+    book.onRowMoved(0, 7);
+    QCOMPARE(book.getRowsForIntKey(kNseFo, 100), QList<int>{7});
+    QCOMPARE(book.getRowsForCompositeToken("NSEFO", "", 100), QList<int>{7});
+    QCOMPARE(book.getTokenForRow(7), 100);
+    QCOMPARE(book.getTokenForRow(0), -1);
+}
+
+// ─── Composite keys ──────────────────────────────────────
+
+void TestTokenAddressBook::testCompositeKeys()
+{
+    TokenAddressBook book;
+    QSignalSpy added(&book, &TokenAddressBook::tokenAdded);
+    book.addCompositeToken("NSECM", "", 2885, 0);
+    book.addCompositeToken("NSECM", "", 2885, 3);
+    book.addToken(11536, 1);
+    QCOMPARE(added.count(), 3);
+
+    QVERIFY(book.hasCompositeToken("NSECM", "", 2885));
+    QVERIFY(!book.hasCompositeToken("BSECM", "", 2885));
+    QCOMPARE(sorted(book.getRowsForCompositeToken("NSECM", "", 2885)), (QList<int>{0, 3}));
+    QCOMPARE(book.getCompositeKeyForRow(3), QString("NSECM::2885"));
+    QCOMPARE(book.getTokenForRow(3), 2885);
+    QVERIFY(book.hasToken(11536));
+    QCOMPARE(book.getTokenForRow(1), 11536);
+
+    book.onRowsRemoved(1, 1);
+    QCOMPARE(sorted(book.getRowsForCompositeToken("NSECM", "", 2885)), (QList<int>{0, 2}));
+    QVERIFY(!book.hasToken(11536));
+
+    book.removeCompositeToken("NSECM", "", 2885, 0);
+    QCOMPARE(book.getRowsForCompositeToken("NSECM", "", 2885), QList<int>{2});
+    QVERIFY(book.getCompositeKeyForRow(0).isEmpty());
+}
+
+// ─── Benchmarks ──────────────────────────────────────────
+
+void TestTokenAddressBook::benchmarkIntKeyLookup_data()
+{
+    QTest::addColumn<bool>("flat");
+    QTest::newRow("flat span") << true;
+    QTest::newRow("QMap copy (previous)") << false;
+}
+
+void TestTokenAddressBook::benchmarkIntKeyLookup()
+{
+    QFETCH(bool, flat);
+
+    // 2,000-row watch: 1,600 distinct NSE FO tokens, 400 rows duplicate them
+    constexpr int kRows = 2000;
+    constexpr int kDistinct = 1600;
+    constexpr int kLookups = 100000;
+    TokenAddressBook book;
+    QMap<int64_t, QList<int>> previous;
+    QVector<int64_t> keys;
+    for (int row = 0; row < kRows; ++row) {
+        const int token = 35000 + (row % kDistinct) * 7;
+        book.addIntKeyToken(kNseFo, token, row);
+        previous[TokenAddressBook::makeIntKey(kNseFo, token)].append(row);
+    }
+    // Tick stream: mostly watched tokens, 1 in 8 misses (unwatched tokens)
+    for (int i = 0; i < kLookups; ++i) {
+        const int token = (i % 8 == 7) ? 900000 + i : 35000 + ((i * 7919) % kDistinct) * 7;
+        keys.append(TokenAddressBook::makeIntKey(kNseFo, token));
+    }
+
+    qint64 rowsSeen = 0;
+    QElapsedTimer timer;
+    qint64 elapsedNs = 0;
+    QBENCHMARK {
+        rowsSeen = 0;
+        timer.start();
+        if (flat) {
+            for (int64_t key : keys) {
+                for (int row : book.rowsForIntKey(key)) rowsSeen += row >= 0;
+            }
+        } else {
+            for (int64_t key : keys) {
+                const QList<int> rows = previous.value(key);
+                for (int row : rows) rowsSeen += row >= 0;
+            }
+        }
+        elapsedNs = timer.nsecsElapsed();
+    }
+
+    const double lookupsPerSec = elapsedNs > 0 ? kLookups * 1e9 / elapsedNs : 0.0;
+    qDebug().nospace() << (flat ? "flat" : "QMap") << " lookups/s="
+                       << qRound64(lookupsPerSec) << " rowsRouted=" << rowsSeen;
+
+    // Hits route 1 or 2 rows each (400 tokens are listed twice)
+    QVERIFY(rowsSeen > kLookups * 7 / 8);
+}
+
+QTEST_MAIN(TestTokenAddressBook)
+#include "test_token_address_book.moc"
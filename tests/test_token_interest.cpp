@@ -0,0 +1,105 @@
+/**
+ * @file test_token_interest.cpp
+ * @brief Unit tests for the per-segment token interest bitmap
+ *
+ * Tests:
+ *  - set()/test()/count() on in-range tokens, word boundaries included
+ *  - Tokens beyond capacity go through the overflow set
+ *  - wantsRecord(): filter off / filter on / filter on + full-market store
+ *  - Segment lookup covers 1/2/11/12 only
+ *
+ * Build: Requires Qt5::Core, Qt5::Test
+ */
+
+#include <QtTest/QtTest>
+#include <cstdint>
+#include "token_interest.h"
+
+using common::SegmentInterest;
+using common::TokenInterestBitmap;
+
+class TestTokenInterest : public QObject {
+    Q_OBJECT
+
+private slots:
+    // ─── Bitmap ───
+    void testSetAndTest();
+    void testOverflow();
+
+    // ─── Filter modes ───
+    void testWantsRecord();
+    void testSegmentLookup();
+};
+
+// ─── Bitmap ──────────────────────────────────────────────
+
+void TestTokenInterest::testSetAndTest()
+{
+    TokenInterestBitmap bitmap(1000);
+    QCOMPARE(bitmap.capacity(), uint32_t(1024));   // Rounded up to whole words
+
+    for (uint32_t token : {0u, 63u, 64u, 127u, 999u}) bitmap.set(token, true);
+    QVERIFY(bitmap.test(63));
+    QVERIFY(bitmap.test(64));
+    QVERIFY(!bitmap.test(62));
+    QVERIFY(!bitmap.test(65));
+    QCOMPARE(bitmap.count(), size_t(5));
+
+    bitmap.set(64, false);
+    QVERIFY(!bitmap.test(64));
+    QVERIFY(bitmap.test(127));
+    QCOMPARE(bitmap.count(), size_t(4));
+
+    bitmap.clear();
+    QCOMPARE(bitmap.count(), size_t(0));
+}
+
+void TestTokenInterest::testOverflow()
+{
+    TokenInterestBitmap bitmap(128);
+    QVERIFY(!bitmap.test(5000000));
+
+    bitmap.set(5000000, true);
+    QVERIFY(bitmap.test(5000000));
+    QVERIFY(!bitmap.test(5000001));
+    QCOMPARE(bitmap.count(), size_t(1));
+
+    bitmap.set(5000000, false);
+    QVERIFY(!bitmap.test(5000000));
+}
+
+// ─── Filter modes ────────────────────────────────────────
+
+void TestTokenInterest::testWantsRecord()
+{
+    SegmentInterest interest(1u << 18);
+    interest.tokens.set(42000, true);
+
+    // Filter off: every record is applied
+    QVERIFY(interest.wantsRecord(42000));
+    QVERIFY(interest.wantsRecord(42001));
+
+    // Filter on: only watched tokens
+    interest.filterRecords = true;
+    QVERIFY(interest.wantsRecord(42000));
+    QVERIFY(!interest.wantsRecord(42001));
+
+    // Full-market store: records applied, callbacks filtered by tokens.test()
+    interest.fullMarketStore = true;
+    QVERIFY(interest.wantsRecord(42001));
+    QVERIFY(!interest.tokens.test(42001));
+}
+
+void TestTokenInterest::testSegmentLookup()
+{
+    for (int segment : {1, 2, 11, 12}) QVERIFY(common::segmentInterest(segment) != nullptr);
+    QVERIFY(common::segmentInterest(0) == nullptr);
+    QVERIFY(common::segmentInterest(3) == nullptr);
+    QVERIFY(common::segmentInterest(1) != common::segmentInterest(2));
+
+    // NSE FO tokens (35000..250000) fit the bitmap without overflow
+    QVERIFY(common::segmentInterest(2)->tokens.capacity() > 250000);
+}
+
+QTEST_MAIN(TestTokenInterest)
+#include "test_token_interest.moc"
@@ -0,0 +1,160 @@
+/**
+ * @file test_viewport_subscriptions.cpp
+ * @brief Unit tests for ViewportSubscriptions — live rows of a market watch
+ *
+ * Tests:
+ *  - liveRange: visible rows widened by the prefetch margin, clamped to the
+ *    table; rowAt()-style -1 arguments (past the end / nothing laid out)
+ *  - update: only keys crossing the edge are reported; blank rows (key 0)
+ *    and duplicates ignored
+ *  - Scrolling a 5000-row watch keeps the live set at one screen + margins
+ *  - forget / clear
+ *
+ * Build: Requires Qt5::Core, Qt5::Test
+ */
+
+#include <QtTest/QtTest>
+#include <algorithm>
+#include <vector>
+#include "models/domain/ViewportSubscriptions.h"
+
+namespace {
+
+int64_t keyOf(int segment, uint32_t token) {
+    return (static_cast<int64_t>(segment) << 32) | token;
+}
+
+std::vector<int64_t> sorted(std::vector<int64_t> keys) {
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+// Keys of proxy rows [first, last] of a watch whose row r holds token r + 1
+std::vector<int64_t> rowKeys(std::pair<int, int> range) {
+    std::vector<int64_t> keys;
+    for (int row = range.first; row <= range.second; ++row)
+        keys.push_back(keyOf(2, static_cast<uint32_t>(row + 1)));
+    return keys;
+}
+
+} // namespace
+
+class TestViewportSubscriptions : public QObject {
+    Q_OBJECT
+
+private slots:
+    // ─── Live range ───
+    void testLiveRange_data();
+    void testLiveRange();
+
+    // ─── Key set ───
+    void testUpdateReportsOnlyEdgeCrossings();
+    void testBlankAndDuplicateKeysIgnored();
+    void testScrollKeepsOneScreenLive();
+    void testForgetAndClear();
+};
+
+// ─── Live range ──────────────────────────────────────────
+
+void TestViewportSubscriptions::testLiveRange_data()
+{
+    QTest::addColumn<int>("firstVisible");
+    QTest::addColumn<int>("lastVisible");
+    QTest::addColumn<int>("rowCount");
+    QTest::addColumn<int>("expectedFirst");
+    QTest::addColumn<int>("expectedLast");
+
+    // Prefetch margin 20
+    QTest::newRow("middle") << 100 << 139 << 5000 << 80 << 159;
+    QTest::newRow("top") << 0 << 39 << 5000 << 0 << 59;
+    QTest::newRow("bottom") << 4960 << 4999 << 5000 << 4940 << 4999;
+    QTest::newRow("viewport past last row") << 5 << -1 << 30 << 0 << 29;
+    QTest::newRow("not laid out") << -1 << -1 << 5000 << 0 << 20;
+    QTest::newRow("empty table") << -1 << -1 << 0 << 0 << -1;
+    QTest::newRow("stale range after removal") << 90 << 120 << 50 << 29 << 49;
+}
+
+void TestViewportSubscriptions::testLiveRange()
+{
+    QFETCH(int, firstVisible);
+    QFETCH(int, lastVisible);
+    QFETCH(int, rowCount);
+    QFETCH(int, expectedFirst);
+    QFETCH(int, expectedLast);
+
+    ViewportSubscriptions live(20);
+    const auto range = live.liveRange(firstVisible, lastVisible, rowCount);
+    QCOMPARE(range.first, expectedFirst);
+    QCOMPARE(range.second, expectedLast);
+}
+
+// ─── Key set ─────────────────────────────────────────────
+
+void TestViewportSubscriptions::testUpdateReportsOnlyEdgeCrossings()
+{
+    ViewportSubscriptions live;
+    auto delta = live.update({keyOf(2, 1), keyOf(2, 2), keyOf(2, 3)});
+    QCOMPARE(delta.added, (std::vector<int64_t>{keyOf(2, 1), keyOf(2, 2), keyOf(2, 3)}));
+    QVERIFY(delta.removed.empty());
+
+    // Scroll by one row
+    delta = live.update({keyOf(2, 2), keyOf(2, 3), keyOf(2, 4)});
+    QCOMPARE(delta.added, (std::vector<int64_t>{keyOf(2, 4)}));
+    QCOMPARE(delta.removed, (std::vector<int64_t>{keyOf(2, 1)}));
+    QVERIFY(live.isLive(keyOf(2, 2)));
+    QVERIFY(!live.isLive(keyOf(2, 1)));
+
+    // Same rows again (e.g. a resize that shows nothing new)
+    QVERIFY(live.update({keyOf(2, 4), keyOf(2, 3), keyOf(2, 2)}).empty());
+    QCOMPARE(live.liveCount(), size_t(3));
+}
+
+void TestViewportSubscriptions::testBlankAndDuplicateKeysIgnored()
+{
+    ViewportSubscriptions live;
+    auto delta = live.update({keyOf(1, 10), 0, keyOf(1, 10), keyOf(11, 10)});
+    QCOMPARE(delta.added, (std::vector<int64_t>{keyOf(1, 10), keyOf(11, 10)}));
+    QCOMPARE(live.liveCount(), size_t(2));
+    QVERIFY(!live.isLive(0));
+}
+
+void TestViewportSubscriptions::testScrollKeepsOneScreenLive()
+{
+    constexpr int kRows = 5000;
+    constexpr int kScreen = 40;
+    ViewportSubscriptions live(20);
+
+    size_t subscribes = 0;
+    size_t unsubscribes = 0;
+    for (int top = 0; top + kScreen <= kRows; top += 7) {
+        const auto delta =
+            live.update(rowKeys(live.liveRange(top, top + kScreen - 1, kRows)));
+        subscribes += delta.added.size();
+        unsubscribes += delta.removed.size();
+        QVERIFY(live.liveCount() <= size_t(kScreen + 2 * live.prefetchRows()));
+    }
+
+    // Each row is subscribed once on the way down and dropped once behind
+    QCOMPARE(subscribes, size_t(kRows));
+    QCOMPARE(subscribes - unsubscribes, live.liveCount());
+}
+
+void TestViewportSubscriptions::testForgetAndClear()
+{
+    ViewportSubscriptions live;
+    live.update({keyOf(2, 1), keyOf(2, 2)});
+
+    // A deleted row: the view already unsubscribed it
+    live.forget(keyOf(2, 1));
+    QVERIFY(!live.isLive(keyOf(2, 1)));
+    auto delta = live.update({keyOf(2, 2)});
+    QVERIFY(delta.empty());
+
+    live.update({keyOf(2, 2), keyOf(2, 3)});
+    delta = live.clear();
+    QCOMPARE(sorted(delta.removed), (std::vector<int64_t>{keyOf(2, 2), keyOf(2, 3)}));
+    QCOMPARE(live.liveCount(), size_t(0));
+}
+
+QTEST_MAIN(TestViewportSubscriptions)
+#include "test_viewport_subscriptions.moc"